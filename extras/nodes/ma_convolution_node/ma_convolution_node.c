@@ -0,0 +1,873 @@
+
+#include "ma_convolution_node.h"
+
+/*
+The SIMD paths are only available when this is compiled in the same translation unit as the miniaudio
+implementation. Otherwise everything runs on the scalar path.
+*/
+
+MA_API ma_convolver_config ma_convolver_config_init(ma_uint32 channels, const float* pImpulseResponse, ma_uint64 impulseResponseFrameCount, ma_uint32 impulseResponseChannels)
+{
+    ma_convolver_config config;
+
+    MA_ZERO_OBJECT(&config);
+    config.channels                  = channels;
+    config.blockSizeInFrames         = MA_CONVOLVER_DEFAULT_BLOCK_SIZE;
+    config.pImpulseResponse          = pImpulseResponse;
+    config.impulseResponseFrameCount = impulseResponseFrameCount;
+    config.impulseResponseChannels   = impulseResponseChannels;
+    config.wet                       = 1;
+    config.dry                       = 0;
+
+    return config;
+}
+
+
+/*
+FFT
+
+The complex FFT is an iterative radix-2 decimation in time transform operating on separate arrays for
+the real and imaginary parts so that the butterflies can be done four at a time. The real FFT of
+size N is done with a complex FFT of size N/2 by packing the even samples into the real part and the
+odd samples into the imaginary part, and then untangling the result. The inverse is done with the
+same forward transform by swapping the real and imaginary parts on the way in and out. The inverse
+is not normalized. Instead, the scale is folded into the spectrum of the impulse response.
+*/
+static void ma_convolver_fft_pass__scalar(float* pRe, float* pIm, const float* pTwiddlesRe, const float* pTwiddlesIm, ma_uint32 span)
+{
+    ma_uint32 j;
+
+    for (j = 0; j < span; j += 1) {
+        float br = pRe[j + span];
+        float bi = pIm[j + span];
+        float tr = br*pTwiddlesRe[j] - bi*pTwiddlesIm[j];
+        float ti = br*pTwiddlesIm[j] + bi*pTwiddlesRe[j];
+
+        pRe[j + span] = pRe[j] - tr;
+        pIm[j + span] = pIm[j] - ti;
+        pRe[j]        = pRe[j] + tr;
+        pIm[j]        = pIm[j] + ti;
+    }
+}
+
+#if defined(MA_SUPPORT_SSE2)
+static void ma_convolver_fft_pass__sse2(float* pRe, float* pIm, const float* pTwiddlesRe, const float* pTwiddlesIm, ma_uint32 span)
+{
+    ma_uint32 j;
+
+    MA_ASSERT((span & 3) == 0);
+
+    for (j = 0; j < span; j += 4) {
+        __m128 wr = _mm_loadu_ps(pTwiddlesRe + j);
+        __m128 wi = _mm_loadu_ps(pTwiddlesIm + j);
+        __m128 ar = _mm_loadu_ps(pRe + j);
+        __m128 ai = _mm_loadu_ps(pIm + j);
+        __m128 br = _mm_loadu_ps(pRe + j + span);
+        __m128 bi = _mm_loadu_ps(pIm + j + span);
+        __m128 tr = _mm_sub_ps(_mm_mul_ps(br, wr), _mm_mul_ps(bi, wi));
+        __m128 ti = _mm_add_ps(_mm_mul_ps(br, wi), _mm_mul_ps(bi, wr));
+
+        _mm_storeu_ps(pRe + j + span, _mm_sub_ps(ar, tr));
+        _mm_storeu_ps(pIm + j + span, _mm_sub_ps(ai, ti));
+        _mm_storeu_ps(pRe + j,        _mm_add_ps(ar, tr));
+        _mm_storeu_ps(pIm + j,        _mm_add_ps(ai, ti));
+    }
+}
+#endif
+
+#if defined(MA_SUPPORT_AVX2)
+static void ma_convolver_fft_pass__avx2(float* pRe, float* pIm, const float* pTwiddlesRe, const float* pTwiddlesIm, ma_uint32 span)
+{
+    ma_uint32 j;
+
+    MA_ASSERT((span & 7) == 0);
+
+    for (j = 0; j < span; j += 8) {
+        __m256 wr = _mm256_loadu_ps(pTwiddlesRe + j);
+        __m256 wi = _mm256_loadu_ps(pTwiddlesIm + j);
+        __m256 ar = _mm256_loadu_ps(pRe + j);
+        __m256 ai = _mm256_loadu_ps(pIm + j);
+        __m256 br = _mm256_loadu_ps(pRe + j + span);
+        __m256 bi = _mm256_loadu_ps(pIm + j + span);
+        __m256 tr = _mm256_sub_ps(_mm256_mul_ps(br, wr), _mm256_mul_ps(bi, wi));
+        __m256 ti = _mm256_add_ps(_mm256_mul_ps(br, wi), _mm256_mul_ps(bi, wr));
+
+        _mm256_storeu_ps(pRe + j + span, _mm256_sub_ps(ar, tr));
+        _mm256_storeu_ps(pIm + j + span, _mm256_sub_ps(ai, ti));
+        _mm256_storeu_ps(pRe + j,        _mm256_add_ps(ar, tr));
+        _mm256_storeu_ps(pIm + j,        _mm256_add_ps(ai, ti));
+    }
+}
+#endif
+
+#if defined(MA_SUPPORT_NEON)
+static void ma_convolver_fft_pass__neon(float* pRe, float* pIm, const float* pTwiddlesRe, const float* pTwiddlesIm, ma_uint32 span)
+{
+    ma_uint32 j;
+
+    MA_ASSERT((span & 3) == 0);
+
+    for (j = 0; j < span; j += 4) {
+        float32x4_t wr = vld1q_f32(pTwiddlesRe + j);
+        float32x4_t wi = vld1q_f32(pTwiddlesIm + j);
+        float32x4_t ar = vld1q_f32(pRe + j);
+        float32x4_t ai = vld1q_f32(pIm + j);
+        float32x4_t br = vld1q_f32(pRe + j + span);
+        float32x4_t bi = vld1q_f32(pIm + j + span);
+        float32x4_t tr = vsubq_f32(vmulq_f32(br, wr), vmulq_f32(bi, wi));
+        float32x4_t ti = vaddq_f32(vmulq_f32(br, wi), vmulq_f32(bi, wr));
+
+        vst1q_f32(pRe + j + span, vsubq_f32(ar, tr));
+        vst1q_f32(pIm + j + span, vsubq_f32(ai, ti));
+        vst1q_f32(pRe + j,        vaddq_f32(ar, tr));
+        vst1q_f32(pIm + j,        vaddq_f32(ai, ti));
+    }
+}
+#endif
+
+static void ma_convolver_fft_pass(float* pRe, float* pIm, const float* pTwiddlesRe, const float* pTwiddlesIm, ma_uint32 span)
+{
+    /* The first couple of passes have spans too short for SIMD. */
+#if defined(MA_SUPPORT_AVX2)
+    if (span >= 8 && ma_has_avx2()) {
+        ma_convolver_fft_pass__avx2(pRe, pIm, pTwiddlesRe, pTwiddlesIm, span);
+    } else
+#endif
+#if defined(MA_SUPPORT_SSE2)
+    if (span >= 4 && ma_has_sse2()) {
+        ma_convolver_fft_pass__sse2(pRe, pIm, pTwiddlesRe, pTwiddlesIm, span);
+    } else
+#endif
+#if defined(MA_SUPPORT_NEON)
+    if (span >= 4 && ma_has_neon()) {
+        ma_convolver_fft_pass__neon(pRe, pIm, pTwiddlesRe, pTwiddlesIm, span);
+    } else
+#endif
+    {
+        ma_convolver_fft_pass__scalar(pRe, pIm, pTwiddlesRe, pTwiddlesIm, span);
+    }
+}
+
+static void ma_convolver_fft(const ma_convolver* pConvolver, float* pRe, float* pIm)
+{
+    ma_uint32 fftSize = pConvolver->fftSize;
+    ma_uint32 i;
+    ma_uint32 span;
+
+    for (i = 0; i < fftSize; i += 1) {
+        ma_uint32 j = pConvolver->pBitReversal[i];
+        if (j > i) {
+            float re = pRe[i];
+            float im = pIm[i];
+            pRe[i] = pRe[j];
+            pIm[i] = pIm[j];
+            pRe[j] = re;
+            pIm[j] = im;
+        }
+    }
+
+    for (span = 1; span < fftSize; span *= 2) {
+        for (i = 0; i < fftSize; i += span*2) {
+            ma_convolver_fft_pass(pRe + i, pIm + i, pConvolver->pTwiddlesRe + span, pConvolver->pTwiddlesIm + span, span);
+        }
+    }
+}
+
+static void ma_convolver_rfft(const ma_convolver* pConvolver, const float* pTime, float* pSpectrum)
+{
+    ma_uint32 fftSize = pConvolver->fftSize;
+    float* pZRe = pConvolver->pScratch;
+    float* pZIm = pConvolver->pScratch + fftSize;
+    float* pXRe = pSpectrum;
+    float* pXIm = pSpectrum + pConvolver->binStride;
+    ma_uint32 n;
+    ma_uint32 k;
+
+    for (n = 0; n < fftSize; n += 1) {
+        pZRe[n] = pTime[n*2 + 0];
+        pZIm[n] = pTime[n*2 + 1];
+    }
+
+    ma_convolver_fft(pConvolver, pZRe, pZIm);
+
+    /* X[k] = E[k] + W^k * O[k] where E and O are the spectrums of the even and odd samples. */
+    for (k = 0; k <= fftSize; k += 1) {
+        ma_uint32 a = (k == fftSize) ? 0 : k;
+        ma_uint32 b = (k == 0)       ? 0 : fftSize - k;
+        float eRe = (pZRe[a] + pZRe[b]) * 0.5f;
+        float eIm = (pZIm[a] - pZIm[b]) * 0.5f;
+        float oRe = (pZIm[a] + pZIm[b]) * 0.5f;
+        float oIm = (pZRe[b] - pZRe[a]) * 0.5f;
+        float wRe = pConvolver->pRealTwiddlesRe[k];
+        float wIm = pConvolver->pRealTwiddlesIm[k];
+
+        pXRe[k] = eRe + (oRe*wRe - oIm*wIm);
+        pXIm[k] = eIm + (oRe*wIm + oIm*wRe);
+    }
+}
+
+static void ma_convolver_irfft(const ma_convolver* pConvolver, const float* pSpectrum, float* pTimeOut)
+{
+    /* Only the second half of the output is needed for overlap-save so that's all that's written to pTimeOut. */
+    ma_uint32 fftSize = pConvolver->fftSize;
+    float* pZRe = pConvolver->pScratch;
+    float* pZIm = pConvolver->pScratch + fftSize;
+    const float* pXRe = pSpectrum;
+    const float* pXIm = pSpectrum + pConvolver->binStride;
+    ma_uint32 n;
+    ma_uint32 k;
+
+    for (k = 0; k < fftSize; k += 1) {
+        float eRe = pXRe[k] + pXRe[fftSize - k];
+        float eIm = pXIm[k] - pXIm[fftSize - k];
+        float dRe = pXRe[k] - pXRe[fftSize - k];
+        float dIm = pXIm[k] + pXIm[fftSize - k];
+        float wRe = pConvolver->pRealTwiddlesRe[k];
+        float wIm = pConvolver->pRealTwiddlesIm[k];
+        float oRe = dRe*wRe + dIm*wIm;
+        float oIm = dIm*wRe - dRe*wIm;
+
+        pZRe[k] = eRe - oIm;
+        pZIm[k] = eIm + oRe;
+    }
+
+    ma_convolver_fft(pConvolver, pZIm, pZRe);   /* Swapped for the inverse. */
+
+    for (n = fftSize/2; n < fftSize; n += 1) {
+        pTimeOut[n*2 - fftSize + 0] = pZRe[n];
+        pTimeOut[n*2 - fftSize + 1] = pZIm[n];
+    }
+}
+
+
+static void ma_convolver_multiply_accumulate__scalar(float* pAccumulator, const float* pX, const float* pH, ma_uint32 binStride)
+{
+    ma_uint32 k;
+
+    for (k = 0; k < binStride; k += 1) {
+        float xr = pX[k];
+        float xi = pX[k + binStride];
+        float hr = pH[k];
+        float hi = pH[k + binStride];
+
+        pAccumulator[k]             += xr*hr - xi*hi;
+        pAccumulator[k + binStride] += xr*hi + xi*hr;
+    }
+}
+
+#if defined(MA_SUPPORT_SSE2)
+static void ma_convolver_multiply_accumulate__sse2(float* pAccumulator, const float* pX, const float* pH, ma_uint32 binStride)
+{
+    ma_uint32 k;
+
+    for (k = 0; k < binStride; k += 4) {
+        __m128 xr = _mm_loadu_ps(pX + k);
+        __m128 xi = _mm_loadu_ps(pX + k + binStride);
+        __m128 hr = _mm_loadu_ps(pH + k);
+        __m128 hi = _mm_loadu_ps(pH + k + binStride);
+
+        _mm_storeu_ps(pAccumulator + k,             _mm_add_ps(_mm_loadu_ps(pAccumulator + k),             _mm_sub_ps(_mm_mul_ps(xr, hr), _mm_mul_ps(xi, hi))));
+        _mm_storeu_ps(pAccumulator + k + binStride, _mm_add_ps(_mm_loadu_ps(pAccumulator + k + binStride), _mm_add_ps(_mm_mul_ps(xr, hi), _mm_mul_ps(xi, hr))));
+    }
+}
+#endif
+
+#if defined(MA_SUPPORT_AVX2)
+static void ma_convolver_multiply_accumulate__avx2(float* pAccumulator, const float* pX, const float* pH, ma_uint32 binStride)
+{
+    ma_uint32 k;
+
+    for (k = 0; k < binStride; k += 8) {
+        __m256 xr = _mm256_loadu_ps(pX + k);
+        __m256 xi = _mm256_loadu_ps(pX + k + binStride);
+        __m256 hr = _mm256_loadu_ps(pH + k);
+        __m256 hi = _mm256_loadu_ps(pH + k + binStride);
+
+        _mm256_storeu_ps(pAccumulator + k,             _mm256_add_ps(_mm256_loadu_ps(pAccumulator + k),             _mm256_sub_ps(_mm256_mul_ps(xr, hr), _mm256_mul_ps(xi, hi))));
+        _mm256_storeu_ps(pAccumulator + k + binStride, _mm256_add_ps(_mm256_loadu_ps(pAccumulator + k + binStride), _mm256_add_ps(_mm256_mul_ps(xr, hi), _mm256_mul_ps(xi, hr))));
+    }
+}
+#endif
+
+#if defined(MA_SUPPORT_NEON)
+static void ma_convolver_multiply_accumulate__neon(float* pAccumulator, const float* pX, const float* pH, ma_uint32 binStride)
+{
+    ma_uint32 k;
+
+    for (k = 0; k < binStride; k += 4) {
+        float32x4_t xr = vld1q_f32(pX + k);
+        float32x4_t xi = vld1q_f32(pX + k + binStride);
+        float32x4_t hr = vld1q_f32(pH + k);
+        float32x4_t hi = vld1q_f32(pH + k + binStride);
+
+        vst1q_f32(pAccumulator + k,             vaddq_f32(vld1q_f32(pAccumulator + k),             vsubq_f32(vmulq_f32(xr, hr), vmulq_f32(xi, hi))));
+        vst1q_f32(pAccumulator + k + binStride, vaddq_f32(vld1q_f32(pAccumulator + k + binStride), vaddq_f32(vmulq_f32(xr, hi), vmulq_f32(xi, hr))));
+    }
+}
+#endif
+
+static void ma_convolver_multiply_accumulate(float* pAccumulator, const float* pX, const float* pH, ma_uint32 binStride)
+{
+    /* The bin stride is always a multiple of 8 so there's no need to worry about leftovers. */
+#if defined(MA_SUPPORT_AVX2)
+    if (ma_has_avx2()) {
+        ma_convolver_multiply_accumulate__avx2(pAccumulator, pX, pH, binStride);
+    } else
+#endif
+#if defined(MA_SUPPORT_SSE2)
+    if (ma_has_sse2()) {
+        ma_convolver_multiply_accumulate__sse2(pAccumulator, pX, pH, binStride);
+    } else
+#endif
+#if defined(MA_SUPPORT_NEON)
+    if (ma_has_neon()) {
+        ma_convolver_multiply_accumulate__neon(pAccumulator, pX, pH, binStride);
+    } else
+#endif
+    {
+        ma_convolver_multiply_accumulate__scalar(pAccumulator, pX, pH, binStride);
+    }
+}
+
+
+typedef struct
+{
+    size_t sizeInBytes;
+    size_t bitReversalOffset;
+    size_t twiddlesReOffset;
+    size_t twiddlesImOffset;
+    size_t realTwiddlesReOffset;
+    size_t realTwiddlesImOffset;
+    size_t filtersOffset;
+    size_t delayLineOffset;
+    size_t inputOffset;
+    size_t outputOffset;
+    size_t scratchOffset;
+    ma_uint32 binStride;
+    ma_uint32 partitionCount;
+} ma_convolver_heap_layout;
+
+static ma_result ma_convolver_get_heap_layout(const ma_convolver_config* pConfig, ma_convolver_heap_layout* pHeapLayout)
+{
+    ma_uint32 blockSize;
+    size_t spectrumSizeInBytes;
+
+    MA_ASSERT(pHeapLayout != NULL);
+
+    MA_ZERO_OBJECT(pHeapLayout);
+
+    if (pConfig == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (pConfig->channels == 0 || pConfig->pImpulseResponse == NULL || pConfig->impulseResponseFrameCount == 0) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (pConfig->impulseResponseChannels != 1 && pConfig->impulseResponseChannels != pConfig->channels) {
+        return MA_INVALID_ARGS;
+    }
+
+    /* The block size needs to be a power of two for the FFT. */
+    blockSize = pConfig->blockSizeInFrames;
+    if (blockSize < 16 || (blockSize & (blockSize - 1)) != 0) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (pConfig->impulseResponseFrameCount > 0xFFFFFFFF) {
+        return MA_TOO_BIG;
+    }
+
+    pHeapLayout->partitionCount = (ma_uint32)((pConfig->impulseResponseFrameCount + blockSize - 1) / blockSize);
+    pHeapLayout->binStride      = ((blockSize + 1) + 7) & ~7;  /* blockSize+1 bins, padded to a multiple of 8 for SIMD. */
+
+    spectrumSizeInBytes = sizeof(float) * pHeapLayout->binStride * 2;
+
+    pHeapLayout->sizeInBytes = 0;
+
+    /* Bit reversal table. */
+    pHeapLayout->bitReversalOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(sizeof(ma_uint32) * blockSize);
+
+    /* Twiddles for the complex FFT. */
+    pHeapLayout->twiddlesReOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(sizeof(float) * blockSize);
+
+    pHeapLayout->twiddlesImOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(sizeof(float) * blockSize);
+
+    /* Twiddles for the real FFT. */
+    pHeapLayout->realTwiddlesReOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(sizeof(float) * (blockSize + 1));
+
+    pHeapLayout->realTwiddlesImOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(sizeof(float) * (blockSize + 1));
+
+    /* Impulse response spectrums. */
+    pHeapLayout->filtersOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(spectrumSizeInBytes * pHeapLayout->partitionCount * pConfig->impulseResponseChannels);
+
+    /* Frequency domain delay line. */
+    pHeapLayout->delayLineOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(spectrumSizeInBytes * pHeapLayout->partitionCount * pConfig->channels);
+
+    /* Input. Two blocks per channel. */
+    pHeapLayout->inputOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(sizeof(float) * blockSize * 2 * pConfig->channels);
+
+    /* Output. One block per channel. */
+    pHeapLayout->outputOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(sizeof(float) * blockSize * pConfig->channels);
+
+    /* Scratch. The FFT buffer followed by the accumulated spectrum. */
+    pHeapLayout->scratchOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(sizeof(float) * blockSize * 2 + spectrumSizeInBytes);
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_convolver_get_heap_size(const ma_convolver_config* pConfig, size_t* pHeapSizeInBytes)
+{
+    ma_result result;
+    ma_convolver_heap_layout heapLayout;
+
+    if (pHeapSizeInBytes == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    *pHeapSizeInBytes = 0;
+
+    result = ma_convolver_get_heap_layout(pConfig, &heapLayout);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    *pHeapSizeInBytes = heapLayout.sizeInBytes;
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_convolver_init_preallocated(const ma_convolver_config* pConfig, void* pHeap, ma_convolver* pConvolver)
+{
+    ma_result result;
+    ma_convolver_heap_layout heapLayout;
+    ma_uint32 blockSize;
+    ma_uint32 bitCount;
+    ma_uint32 spectrumSize;
+    ma_uint32 iChannel;
+    ma_uint32 iPartition;
+    ma_uint32 i;
+    ma_uint32 span;
+    float scale;
+    float* pTime;
+
+    if (pConvolver == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    MA_ZERO_OBJECT(pConvolver);
+
+    if (pConfig == NULL || pHeap == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    result = ma_convolver_get_heap_layout(pConfig, &heapLayout);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    pConvolver->_pHeap = pHeap;
+    MA_ZERO_MEMORY(pHeap, heapLayout.sizeInBytes);
+
+    pConvolver->config           = *pConfig;
+    pConvolver->fftSize          = pConfig->blockSizeInFrames;
+    pConvolver->binStride        = heapLayout.binStride;
+    pConvolver->partitionCount   = heapLayout.partitionCount;
+    pConvolver->partitionIndex   = 0;
+    pConvolver->cursor           = 0;
+    pConvolver->pBitReversal     = (ma_uint32*)ma_offset_ptr(pHeap, heapLayout.bitReversalOffset);
+    pConvolver->pTwiddlesRe      = (float*)ma_offset_ptr(pHeap, heapLayout.twiddlesReOffset);
+    pConvolver->pTwiddlesIm      = (float*)ma_offset_ptr(pHeap, heapLayout.twiddlesImOffset);
+    pConvolver->pRealTwiddlesRe  = (float*)ma_offset_ptr(pHeap, heapLayout.realTwiddlesReOffset);
+    pConvolver->pRealTwiddlesIm  = (float*)ma_offset_ptr(pHeap, heapLayout.realTwiddlesImOffset);
+    pConvolver->pFilters         = (float*)ma_offset_ptr(pHeap, heapLayout.filtersOffset);
+    pConvolver->pDelayLine       = (float*)ma_offset_ptr(pHeap, heapLayout.delayLineOffset);
+    pConvolver->pInput           = (float*)ma_offset_ptr(pHeap, heapLayout.inputOffset);
+    pConvolver->pOutput          = (float*)ma_offset_ptr(pHeap, heapLayout.outputOffset);
+    pConvolver->pScratch         = (float*)ma_offset_ptr(pHeap, heapLayout.scratchOffset);
+
+    pConvolver->config.pImpulseResponse = NULL;    /* The impulse response is not referenced after initialization. */
+
+    blockSize    = pConvolver->fftSize;
+    spectrumSize = pConvolver->binStride * 2;
+    scale        = 1.0f / (blockSize * 2);
+
+    /* Bit reversal. */
+    bitCount = 0;
+    while ((1U << bitCount) < blockSize) {
+        bitCount += 1;
+    }
+
+    for (i = 0; i < blockSize; i += 1) {
+        ma_uint32 reversed = 0;
+        ma_uint32 iBit;
+
+        for (iBit = 0; iBit < bitCount; iBit += 1) {
+            reversed |= ((i >> iBit) & 1) << (bitCount - 1 - iBit);
+        }
+
+        pConvolver->pBitReversal[i] = reversed;
+    }
+
+    /* The twiddles for each pass are stored contiguously so they can be loaded with SIMD. */
+    for (span = 1; span < blockSize; span *= 2) {
+        for (i = 0; i < span; i += 1) {
+            pConvolver->pTwiddlesRe[span + i] =  (float)ma_cosd(MA_PI_D * i / span);
+            pConvolver->pTwiddlesIm[span + i] = -(float)ma_sind(MA_PI_D * i / span);
+        }
+    }
+
+    for (i = 0; i <= blockSize; i += 1) {
+        pConvolver->pRealTwiddlesRe[i] =  (float)ma_cosd(MA_PI_D * i / blockSize);
+        pConvolver->pRealTwiddlesIm[i] = -(float)ma_sind(MA_PI_D * i / blockSize);
+    }
+
+    /*
+    Now the impulse response can be split into partitions and transformed. The scale of the inverse
+    transform is applied here so it doesn't need to be done when processing. The input buffer is not
+    in use yet so we can use it as temporary storage.
+    */
+    pTime = pConvolver->pInput;
+
+    for (iChannel = 0; iChannel < pConfig->impulseResponseChannels; iChannel += 1) {
+        for (iPartition = 0; iPartition < pConvolver->partitionCount; iPartition += 1) {
+            float* pSpectrum = pConvolver->pFilters + (iChannel*pConvolver->partitionCount + iPartition) * spectrumSize;
+            ma_uint64 frameOffset = (ma_uint64)iPartition * blockSize;
+            ma_uint32 frameCount  = (ma_uint32)ma_min(blockSize, pConfig->impulseResponseFrameCount - frameOffset);
+
+            MA_ZERO_MEMORY(pTime, sizeof(float) * blockSize * 2);
+            for (i = 0; i < frameCount; i += 1) {
+                pTime[i] = pConfig->pImpulseResponse[(frameOffset + i)*pConfig->impulseResponseChannels + iChannel];
+            }
+
+            ma_convolver_rfft(pConvolver, pTime, pSpectrum);
+
+            for (i = 0; i < spectrumSize; i += 1) {
+                pSpectrum[i] *= scale;
+            }
+        }
+    }
+
+    MA_ZERO_MEMORY(pTime, sizeof(float) * blockSize * 2);
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_convolver_init(const ma_convolver_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_convolver* pConvolver)
+{
+    ma_result result;
+    size_t heapSizeInBytes;
+    void* pHeap;
+
+    result = ma_convolver_get_heap_size(pConfig, &heapSizeInBytes);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    if (heapSizeInBytes > 0) {
+        pHeap = ma_malloc(heapSizeInBytes, pAllocationCallbacks);
+        if (pHeap == NULL) {
+            return MA_OUT_OF_MEMORY;
+        }
+    } else {
+        pHeap = NULL;
+    }
+
+    result = ma_convolver_init_preallocated(pConfig, pHeap, pConvolver);
+    if (result != MA_SUCCESS) {
+        ma_free(pHeap, pAllocationCallbacks);
+        return result;
+    }
+
+    pConvolver->_ownsHeap = MA_TRUE;
+    return MA_SUCCESS;
+}
+
+MA_API void ma_convolver_uninit(ma_convolver* pConvolver, const ma_allocation_callbacks* pAllocationCallbacks)
+{
+    if (pConvolver == NULL) {
+        return;
+    }
+
+    if (pConvolver->_ownsHeap) {
+        ma_free(pConvolver->_pHeap, pAllocationCallbacks);
+    }
+}
+
+static void ma_convolver_process_block(ma_convolver* pConvolver)
+{
+    ma_uint32 blockSize      = pConvolver->fftSize;
+    ma_uint32 binStride      = pConvolver->binStride;
+    ma_uint32 spectrumSize   = binStride * 2;
+    ma_uint32 partitionCount = pConvolver->partitionCount;
+    float* pAccumulator      = pConvolver->pScratch + blockSize*2;
+    ma_uint32 iChannel;
+
+    for (iChannel = 0; iChannel < pConvolver->config.channels; iChannel += 1) {
+        float* pTime = pConvolver->pInput + iChannel*blockSize*2;
+        const float* pFilters = pConvolver->pFilters + ((pConvolver->config.impulseResponseChannels == 1) ? 0 : iChannel*partitionCount) * spectrumSize;
+        float* pDelayLine = pConvolver->pDelayLine + iChannel*partitionCount*spectrumSize;
+        ma_uint32 iSlot = pConvolver->partitionIndex;
+        ma_uint32 iPartition;
+
+        /* The most recent two blocks of input go into the delay line as a single spectrum... */
+        ma_convolver_rfft(pConvolver, pTime, pDelayLine + iSlot*spectrumSize);
+
+        /* ... which is multiplied with the first partition, the previous input with the second partition, and so on. */
+        MA_ZERO_MEMORY(pAccumulator, sizeof(float) * spectrumSize);
+
+        for (iPartition = 0; iPartition < partitionCount; iPartition += 1) {
+            ma_convolver_multiply_accumulate(pAccumulator, pDelayLine + iSlot*spectrumSize, pFilters + iPartition*spectrumSize, binStride);
+            iSlot = (iSlot == 0) ? partitionCount - 1 : iSlot - 1;
+        }
+
+        /* Overlap-save. The first half of the result is aliased and discarded. */
+        ma_convolver_irfft(pConvolver, pAccumulator, pConvolver->pOutput + iChannel*blockSize);
+
+        /* The current block becomes the previous block. */
+        MA_COPY_MEMORY(pTime, pTime + blockSize, sizeof(float) * blockSize);
+    }
+
+    pConvolver->partitionIndex = (pConvolver->partitionIndex + 1) % partitionCount;
+}
+
+MA_API ma_result ma_convolver_process_pcm_frames(ma_convolver* pConvolver, void* pFramesOut, const void* pFramesIn, ma_uint32 frameCount)
+{
+    float* pFramesOutF32 = (float*)pFramesOut;
+    const float* pFramesInF32 = (const float*)pFramesIn;
+    ma_uint32 channels;
+    ma_uint32 blockSize;
+    ma_uint32 totalFramesProcessed = 0;
+
+    if (pConvolver == NULL || pFramesOut == NULL || pFramesIn == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    channels  = pConvolver->config.channels;
+    blockSize = pConvolver->fftSize;
+
+    while (totalFramesProcessed < frameCount) {
+        ma_uint32 framesToProcess = ma_min(frameCount - totalFramesProcessed, blockSize - pConvolver->cursor);
+        ma_uint32 iChannel;
+        ma_uint32 iFrame;
+
+        /*
+        The output for this block was calculated at the end of the previous block. The dry signal comes
+        from the previous block as well so it lines up. This works in-place because each sample is read
+        before it's written.
+        */
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            float* pPrev = pConvolver->pInput + iChannel*blockSize*2 + pConvolver->cursor;
+            float* pCurr = pPrev + blockSize;
+            const float* pWet = pConvolver->pOutput + iChannel*blockSize + pConvolver->cursor;
+            const float* pRunningFramesIn  = pFramesInF32  + totalFramesProcessed*channels + iChannel;
+            float*       pRunningFramesOut = pFramesOutF32 + totalFramesProcessed*channels + iChannel;
+
+            for (iFrame = 0; iFrame < framesToProcess; iFrame += 1) {
+                float x = pRunningFramesIn[iFrame*channels];
+                pRunningFramesOut[iFrame*channels] = pWet[iFrame]*pConvolver->config.wet + pPrev[iFrame]*pConvolver->config.dry;
+                pCurr[iFrame] = x;
+            }
+        }
+
+        pConvolver->cursor   += framesToProcess;
+        totalFramesProcessed += framesToProcess;
+
+        if (pConvolver->cursor == blockSize) {
+            ma_convolver_process_block(pConvolver);
+            pConvolver->cursor = 0;
+        }
+    }
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_uint32 ma_convolver_get_latency(const ma_convolver* pConvolver)
+{
+    if (pConvolver == NULL) {
+        return 0;
+    }
+
+    return pConvolver->fftSize;
+}
+
+MA_API void ma_convolver_set_wet(ma_convolver* pConvolver, float value)
+{
+    if (pConvolver == NULL) {
+        return;
+    }
+
+    pConvolver->config.wet = value;
+}
+
+MA_API float ma_convolver_get_wet(const ma_convolver* pConvolver)
+{
+    if (pConvolver == NULL) {
+        return 0;
+    }
+
+    return pConvolver->config.wet;
+}
+
+MA_API void ma_convolver_set_dry(ma_convolver* pConvolver, float value)
+{
+    if (pConvolver == NULL) {
+        return;
+    }
+
+    pConvolver->config.dry = value;
+}
+
+MA_API float ma_convolver_get_dry(const ma_convolver* pConvolver)
+{
+    if (pConvolver == NULL) {
+        return 0;
+    }
+
+    return pConvolver->config.dry;
+}
+
+
+
+MA_API ma_convolution_node_config ma_convolution_node_config_init(ma_uint32 channels, const float* pImpulseResponse, ma_uint64 impulseResponseFrameCount, ma_uint32 impulseResponseChannels)
+{
+    ma_convolution_node_config config;
+
+    config.nodeConfig = ma_node_config_init();  /* Input and output channels will be set in ma_convolution_node_init(). */
+    config.convolver  = ma_convolver_config_init(channels, pImpulseResponse, impulseResponseFrameCount, impulseResponseChannels);
+    config.convolver.blockSizeInFrames = 0;     /* Derived from the node graph in ma_convolution_node_init(). */
+
+    return config;
+}
+
+
+static void ma_convolution_node_process_pcm_frames(ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut)
+{
+    ma_convolution_node* pConvolutionNode = (ma_convolution_node*)pNode;
+
+    (void)pFrameCountIn;
+
+    ma_convolver_process_pcm_frames(&pConvolutionNode->convolver, ppFramesOut[0], ppFramesIn[0], *pFrameCountOut);
+}
+
+static ma_node_vtable g_ma_convolution_node_vtable =
+{
+    ma_convolution_node_process_pcm_frames,
+    NULL,
+    1,  /* 1 input channel. */
+    1,  /* 1 output channel. */
+    MA_NODE_FLAG_CONTINUOUS_PROCESSING  /* Convolution requires continuous processing to ensure the tail get's processed. */
+};
+
+MA_API ma_result ma_convolution_node_init(ma_node_graph* pNodeGraph, const ma_convolution_node_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_convolution_node* pConvolutionNode)
+{
+    ma_result result;
+    ma_node_config baseConfig;
+    ma_convolver_config convolverConfig;
+
+    if (pConvolutionNode == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    MA_ZERO_OBJECT(pConvolutionNode);
+
+    if (pNodeGraph == NULL || pConfig == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    /*
+    The block size needs to be a power of two for the FFT, but the node cache generally isn't. Using the
+    largest power of two that fits in the node cache means a block is completed on every read, which keeps
+    the cost of each read even. With the default cache of 480 frames this is 256.
+    */
+    convolverConfig = pConfig->convolver;
+    if (convolverConfig.blockSizeInFrames == 0) {
+        convolverConfig.blockSizeInFrames = 16;
+        while (convolverConfig.blockSizeInFrames*2 <= pNodeGraph->nodeCacheCapInFrames) {
+            convolverConfig.blockSizeInFrames *= 2;
+        }
+    }
+
+    result = ma_convolver_init(&convolverConfig, pAllocationCallbacks, &pConvolutionNode->convolver);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    baseConfig = pConfig->nodeConfig;
+    baseConfig.vtable          = &g_ma_convolution_node_vtable;
+    baseConfig.pInputChannels  = &pConfig->convolver.channels;
+    baseConfig.pOutputChannels = &pConfig->convolver.channels;
+
+    /*
+    Unless told otherwise, processing can be skipped once the input has been silent for long enough for everything to
+    have made its way through the delay line. The extra blocks account for the latency and a partially filled block.
+    */
+    if (baseConfig.tailLengthInFrames == MA_NODE_TAIL_LENGTH_INFINITE) {
+        baseConfig.tailLengthInFrames = (pConvolutionNode->convolver.partitionCount + 2) * pConvolutionNode->convolver.fftSize;
+    }
+
+    result = ma_node_init(pNodeGraph, &baseConfig, pAllocationCallbacks, &pConvolutionNode->baseNode);
+    if (result != MA_SUCCESS) {
+        ma_convolver_uninit(&pConvolutionNode->convolver, pAllocationCallbacks);
+        return result;
+    }
+
+    return MA_SUCCESS;
+}
+
+MA_API void ma_convolution_node_uninit(ma_convolution_node* pConvolutionNode, const ma_allocation_callbacks* pAllocationCallbacks)
+{
+    if (pConvolutionNode == NULL) {
+        return;
+    }
+
+    /* The base node is always uninitialized first. */
+    ma_node_uninit(pConvolutionNode, pAllocationCallbacks);
+    ma_convolver_uninit(&pConvolutionNode->convolver, pAllocationCallbacks);
+}
+
+MA_API void ma_convolution_node_set_wet(ma_convolution_node* pConvolutionNode, float value)
+{
+    if (pConvolutionNode == NULL) {
+        return;
+    }
+
+    ma_convolver_set_wet(&pConvolutionNode->convolver, value);
+}
+
+MA_API float ma_convolution_node_get_wet(const ma_convolution_node* pConvolutionNode)
+{
+    if (pConvolutionNode == NULL) {
+        return 0;
+    }
+
+    return ma_convolver_get_wet(&pConvolutionNode->convolver);
+}
+
+MA_API void ma_convolution_node_set_dry(ma_convolution_node* pConvolutionNode, float value)
+{
+    if (pConvolutionNode == NULL) {
+        return;
+    }
+
+    ma_convolver_set_dry(&pConvolutionNode->convolver, value);
+}
+
+MA_API float ma_convolution_node_get_dry(const ma_convolution_node* pConvolutionNode)
+{
+    if (pConvolutionNode == NULL) {
+        return 0;
+    }
+
+    return ma_convolver_get_dry(&pConvolutionNode->convolver);
+}
@@ -0,0 +1,114 @@
+/* Include ma_convolution_node.h after miniaudio.h */
+#ifndef ma_convolution_node_h
+#define ma_convolution_node_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+Convolves its input with an impulse response, such as a room for convolution reverb or a speaker
+cabinet. This is done with uniformly partitioned FFT convolution: the impulse response is split into
+blocks of `blockSizeInFrames`, each of which is transformed to the frequency domain once at init
+time. Each block of input is then transformed once and multiplied with every partition, which keeps
+long impulse responses affordable. The cost per frame grows with the length of the impulse response
+divided by the block size, rather than with the length of the impulse response itself like a direct
+form FIR filter.
+
+The output is delayed by `blockSizeInFrames` frames. Larger blocks are cheaper but add more latency.
+The block size must be a power of two. The dry signal is delayed by the same amount so it lines up
+with the wet signal.
+
+Because the block size must be a power of two, the latency cannot always match the node cache of the
+node graph, which is 480 frames by default. When the block size of a convolution node is left at 0,
+it uses the largest power of two that fits in the node cache, so the latency is the node cache size
+rounded down to a power of two (256 frames by default). A standalone `ma_convolver` defaults to
+`MA_CONVOLVER_DEFAULT_BLOCK_SIZE`.
+
+The impulse response is interleaved f32 and can either have a single channel, in which case it's
+applied to every channel, or the same number of channels as the input. It's copied at init time so
+it does not need to remain valid afterwards.
+*/
+#ifndef MA_CONVOLVER_DEFAULT_BLOCK_SIZE
+#define MA_CONVOLVER_DEFAULT_BLOCK_SIZE 256
+#endif
+
+typedef struct
+{
+    ma_uint32 channels;
+    ma_uint32 blockSizeInFrames;            /* Must be a power of two. This is also the latency. Set to 0 in a convolution node config to derive it from the node graph. */
+    const float* pImpulseResponse;          /* Interleaved. */
+    ma_uint64 impulseResponseFrameCount;
+    ma_uint32 impulseResponseChannels;      /* Either 1 or `channels`. */
+    float wet;
+    float dry;
+} ma_convolver_config;
+
+MA_API ma_convolver_config ma_convolver_config_init(ma_uint32 channels, const float* pImpulseResponse, ma_uint64 impulseResponseFrameCount, ma_uint32 impulseResponseChannels);
+
+
+typedef struct
+{
+    ma_convolver_config config;
+    ma_uint32 fftSize;                      /* The size of the complex FFT, which is half of the size of the real FFT. Equal to the block size. */
+    ma_uint32 binStride;                    /* The number of bins in each spectrum, padded for SIMD. */
+    ma_uint32 partitionCount;
+    ma_uint32 partitionIndex;               /* The slot in the frequency domain delay line holding the most recent input block. */
+    ma_uint32 cursor;                       /* The position in the current block. */
+    ma_uint32* pBitReversal;
+    float* pTwiddlesRe;                     /* For the complex FFT. The twiddles for a butterfly span of N start at index N. */
+    float* pTwiddlesIm;
+    float* pRealTwiddlesRe;                 /* For converting between the complex FFT and the real FFT. */
+    float* pRealTwiddlesIm;
+    float* pFilters;                        /* The spectrum of each partition of each channel of the impulse response. The real parts are followed by the imaginary parts. */
+    float* pDelayLine;                      /* The spectrum of each of the last `partitionCount` input blocks of each channel. */
+    float* pInput;                          /* Two blocks per channel. The previous block followed by the current one. */
+    float* pOutput;                         /* One block per channel. */
+    float* pScratch;                        /* For the FFT and the accumulated spectrum. */
+
+    /* Memory management. */
+    void* _pHeap;
+    ma_bool32 _ownsHeap;
+} ma_convolver;
+
+MA_API ma_result ma_convolver_get_heap_size(const ma_convolver_config* pConfig, size_t* pHeapSizeInBytes);
+MA_API ma_result ma_convolver_init_preallocated(const ma_convolver_config* pConfig, void* pHeap, ma_convolver* pConvolver);
+MA_API ma_result ma_convolver_init(const ma_convolver_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_convolver* pConvolver);
+MA_API void ma_convolver_uninit(ma_convolver* pConvolver, const ma_allocation_callbacks* pAllocationCallbacks);
+MA_API ma_result ma_convolver_process_pcm_frames(ma_convolver* pConvolver, void* pFramesOut, const void* pFramesIn, ma_uint32 frameCount);
+MA_API ma_uint32 ma_convolver_get_latency(const ma_convolver* pConvolver);
+MA_API void ma_convolver_set_wet(ma_convolver* pConvolver, float value);
+MA_API float ma_convolver_get_wet(const ma_convolver* pConvolver);
+MA_API void ma_convolver_set_dry(ma_convolver* pConvolver, float value);
+MA_API float ma_convolver_get_dry(const ma_convolver* pConvolver);
+
+
+/*
+The convolution node has one input and one output.
+*/
+typedef struct
+{
+    ma_node_config nodeConfig;
+    ma_convolver_config convolver;
+} ma_convolution_node_config;
+
+MA_API ma_convolution_node_config ma_convolution_node_config_init(ma_uint32 channels, const float* pImpulseResponse, ma_uint64 impulseResponseFrameCount, ma_uint32 impulseResponseChannels);
+
+
+typedef struct
+{
+    ma_node_base baseNode;
+    ma_convolver convolver;
+} ma_convolution_node;
+
+MA_API ma_result ma_convolution_node_init(ma_node_graph* pNodeGraph, const ma_convolution_node_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_convolution_node* pConvolutionNode);
+MA_API void ma_convolution_node_uninit(ma_convolution_node* pConvolutionNode, const ma_allocation_callbacks* pAllocationCallbacks);
+MA_API void ma_convolution_node_set_wet(ma_convolution_node* pConvolutionNode, float value);
+MA_API float ma_convolution_node_get_wet(const ma_convolution_node* pConvolutionNode);
+MA_API void ma_convolution_node_set_dry(ma_convolution_node* pConvolutionNode, float value);
+MA_API float ma_convolution_node_get_dry(const ma_convolution_node* pConvolutionNode);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* ma_convolution_node_h */
@@ -0,0 +1,128 @@
+#define MINIAUDIO_IMPLEMENTATION
+#include "../../../miniaudio.h"
+#include "ma_convolution_node.c"
+
+#include <stdio.h>
+
+#define DEVICE_FORMAT       ma_format_f32       /* Must always be f32 for this example because the node graph system only works with this. */
+#define DEVICE_CHANNELS     2
+#define DEVICE_SAMPLE_RATE  48000
+
+static ma_audio_buffer_ref   g_dataSupply;      /* The underlying data source of the source node. */
+static ma_data_source_node   g_dataSupplyNode;  /* The node that will sit at the root level. Will be reading data from g_dataSupply. */
+static ma_convolution_node   g_convolutionNode; /* The convolution node. */
+static ma_node_graph         g_nodeGraph;       /* The main node graph that we'll be feeding data through. */
+
+void data_callback(ma_device* pDevice, void* pOutput, const void* pInput, ma_uint32 frameCount)
+{
+    MA_ASSERT(pDevice->capture.format == pDevice->playback.format && pDevice->capture.format == ma_format_f32);
+    MA_ASSERT(pDevice->capture.channels == pDevice->playback.channels);
+
+    /* See the reverb node example for an explanation of how the input is fed into the graph. */
+    ma_audio_buffer_ref_set_data(&g_dataSupply, pInput, frameCount);
+    ma_node_graph_read_pcm_frames(&g_nodeGraph, pOutput, frameCount, NULL);
+}
+
+int main(int argc, char** argv)
+{
+    ma_result result;
+    ma_device_config deviceConfig;
+    ma_device device;
+    ma_node_graph_config nodeGraphConfig;
+    ma_convolution_node_config convolutionNodeConfig;
+    ma_data_source_node_config dataSupplyNodeConfig;
+    ma_decoder_config decoderConfig;
+    float* pImpulseResponse;
+    ma_uint64 impulseResponseFrameCount;
+
+    if (argc < 2) {
+        printf("No impulse response file specified.\n");
+        return -1;
+    }
+
+    /* The impulse response needs to be in the same format as the device. */
+    decoderConfig = ma_decoder_config_init(DEVICE_FORMAT, DEVICE_CHANNELS, DEVICE_SAMPLE_RATE);
+
+    result = ma_decode_file(argv[1], &decoderConfig, &impulseResponseFrameCount, (void**)&pImpulseResponse);
+    if (result != MA_SUCCESS) {
+        printf("Failed to load impulse response.\n");
+        return -1;
+    }
+
+    deviceConfig = ma_device_config_init(ma_device_type_duplex);
+    deviceConfig.capture.pDeviceID  = NULL;
+    deviceConfig.capture.format     = DEVICE_FORMAT;
+    deviceConfig.capture.channels   = DEVICE_CHANNELS;
+    deviceConfig.capture.shareMode  = ma_share_mode_shared;
+    deviceConfig.playback.pDeviceID = NULL;
+    deviceConfig.playback.format    = DEVICE_FORMAT;
+    deviceConfig.playback.channels  = DEVICE_CHANNELS;
+    deviceConfig.sampleRate         = DEVICE_SAMPLE_RATE;
+    deviceConfig.dataCallback       = data_callback;
+    result = ma_device_init(NULL, &deviceConfig, &device);
+    if (result != MA_SUCCESS) {
+        ma_free(pImpulseResponse, NULL);
+        return result;
+    }
+
+
+    /* Node graph. */
+    nodeGraphConfig = ma_node_graph_config_init(device.capture.channels);
+
+    result = ma_node_graph_init(&nodeGraphConfig, NULL, &g_nodeGraph);
+    if (result != MA_SUCCESS) {
+        printf("Failed to initialize node graph.");
+        goto done0;
+    }
+
+
+    /* Convolution. Attached straight to the endpoint. The impulse response is copied so it can be freed afterwards. */
+    convolutionNodeConfig = ma_convolution_node_config_init(device.capture.channels, pImpulseResponse, impulseResponseFrameCount, DEVICE_CHANNELS);
+    convolutionNodeConfig.convolver.dry = 1;
+
+    result = ma_convolution_node_init(&g_nodeGraph, &convolutionNodeConfig, NULL, &g_convolutionNode);
+    if (result != MA_SUCCESS) {
+        printf("Failed to initialize convolution node.");
+        goto done1;
+    }
+
+    ma_node_attach_output_bus(&g_convolutionNode, 0, ma_node_graph_get_endpoint(&g_nodeGraph), 0);
+
+
+    /* Data supply. Attached to input bus 0 of the convolution node. */
+    result = ma_audio_buffer_ref_init(device.capture.format, device.capture.channels, NULL, 0, &g_dataSupply);
+    if (result != MA_SUCCESS) {
+        printf("Failed to initialize audio buffer for source.");
+        goto done2;
+    }
+
+    dataSupplyNodeConfig = ma_data_source_node_config_init(&g_dataSupply);
+
+    result = ma_data_source_node_init(&g_nodeGraph, &dataSupplyNodeConfig, NULL, &g_dataSupplyNode);
+    if (result != MA_SUCCESS) {
+        printf("Failed to initialize source node.");
+        goto done2;
+    }
+
+    ma_node_attach_output_bus(&g_dataSupplyNode, 0, &g_convolutionNode, 0);
+
+
+
+    /* Now we just start the device and wait for the user to terminate the program. */
+    ma_device_start(&device);
+
+    printf("Press Enter to quit...\n");
+    getchar();
+
+    /* It's important that we stop the device first or else we'll uninitialize the graph from under the device. */
+    ma_device_stop(&device);
+
+
+/*done3:*/ ma_data_source_node_uninit(&g_dataSupplyNode, NULL);
+done2: ma_convolution_node_uninit(&g_convolutionNode, NULL);
+done1: ma_node_graph_uninit(&g_nodeGraph, NULL);
+done0: ma_device_uninit(&device);
+    ma_free(pImpulseResponse, NULL);
+
+    return 0;
+}
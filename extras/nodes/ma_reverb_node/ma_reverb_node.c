@@ -63,6 +63,14 @@ MA_API ma_result ma_reverb_node_init(ma_node_graph* pNodeGraph, const ma_reverb_
     baseConfig.pInputChannels  = &pConfig->channels;
     baseConfig.pOutputChannels = &pConfig->channels;
 
+    /* Unless told otherwise, the tail lasts until the reverb has decayed. Freeze mode never decays, which verblib reports as 0. */
+    if (baseConfig.tailLengthInFrames == MA_NODE_TAIL_LENGTH_INFINITE) {
+        unsigned long decayTimeInFrames = verblib_get_decay_time_in_frames(&pReverbNode->reverb);
+        if (decayTimeInFrames > 0 && decayTimeInFrames < MA_NODE_TAIL_LENGTH_INFINITE) {
+            baseConfig.tailLengthInFrames = (ma_uint32)decayTimeInFrames;
+        }
+    }
+
     result = ma_node_init(pNodeGraph, &baseConfig, pAllocationCallbacks, &pReverbNode->baseNode);
     if (result != MA_SUCCESS) {
         return result;
@@ -655,6 +655,7 @@ To run locally, you'll need to use emrun:
     |                                  | ma_sound_init_from_file_w()                                        |
     |                                  | ma_sound_init_copy()                                               |
     |                                  | ma_engine_play_sound_ex()                                          |
+    |                                  | ma_engine_play_sound_with_volume()                                 |
     |                                  | ma_engine_play_sound()                                             |
     |                                  | ```                                                                |
     |                                  |                                                                    |
@@ -1085,6 +1086,35 @@ normally). When not using a device, you need to use `ma_engine_read_pcm_frames()
 data from the engine. This kind of setup is useful if you want to do something like offline
 processing or want to use a different audio system for playback such as SDL.
 
+For offline processing you can have the engine render a fixed number of frames straight to an
+encoder with `ma_engine_render_offline()`. This runs as fast as possible and reports how many times
+faster than realtime it ran:
+
+    ```c
+    ma_offline_render_config renderConfig;
+    ma_offline_render_stats renderStats;
+
+    renderConfig = ma_offline_render_config_init(lengthInFrames);
+    renderConfig.pEncoder = &encoder;  // Must have the same channel count as the engine.
+
+    result = ma_engine_render_offline(&engine, &renderConfig, &renderStats);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    printf("Rendered at %.1fx realtime.\n", renderStats.realtimeMultiple);
+    ```
+
+Instead of, or in addition to, an encoder you can set `onOutput` to receive each block of f32
+frames. By default, output is written on a separate thread while the next block is being rendered.
+Set `noPipelining` to write on the calling thread instead. Frames are rendered in blocks of
+`blockSizeInFrames`, but each node still processes at most `periodSizeInFrames` at a time, so a
+larger period size in the engine config will reduce per-block overhead. Set
+`nodeGraphJobThreadCount` in the engine config to process sounds in parallel. Make sure any sounds
+loaded through the resource manager have finished loading before rendering or else they'll be
+rendered as silence. Use `ma_node_graph_render_offline()` to do the same with a plain node graph,
+in which case `sampleRate` in the config is used for reporting the speed.
+
 When a sound is loaded it goes through a resource manager. By default the engine will initialize a
 resource manager internally, but you can also specify a pre-initialized resource manager:
 
@@ -1179,7 +1209,27 @@ The simplest and least flexible way to play a sound is like so:
     ```
 
 This is a "fire and forget" style of function. The engine will manage the `ma_sound` object
-internally. When the sound finishes playing, it'll be put up for recycling. For more flexibility
+internally. When the sound finishes playing, it'll be put up for recycling. Use
+`ma_engine_play_sound_with_volume()` if you need to set the volume.
+
+By default a new sound object is allocated whenever there are none available for recycling, and
+the list of sounds is protected by a lock. If you're playing a lot of short sounds, such as UI
+clicks or gunshots, you can instead have the engine allocate a fixed number of sounds up front by
+setting `inlinedSoundPoolCapacity` in the engine config. Slots in the pool are claimed and released
+without a lock, and a slot that last played the same file is restarted without being reinitialized
+so repeatedly playing the same sounds doesn't allocate any memory. When every slot is playing,
+`inlinedSoundStealPolicy` decides what happens:
+
+    +-----------------------------------------+------------------------------------------------+
+    | Policy                                  | Description                                    |
+    +-----------------------------------------+------------------------------------------------+
+    | ma_inlined_sound_steal_policy_none      | The new sound is rejected with MA_NO_SPACE.    |
+    | ma_inlined_sound_steal_policy_oldest    | The sound started longest ago is stopped.      |
+    | ma_inlined_sound_steal_policy_quietest  | The sound with the lowest volume is stopped.   |
+    +-----------------------------------------+------------------------------------------------+
+
+Use `ma_engine_get_inlined_sound_pool_stats()` to see how close the pool is to being full and how
+often sounds are being stolen or rejected so you can tune the capacity. For more flexibility
 you'll want to initialize a sound object:
 
     ```c
@@ -1500,6 +1550,142 @@ source, mainly for convenience:
 Sound groups have the same API as sounds, only they are called `ma_sound_group`, and since they do
 not have any notion of a data source, anything relating to a data source is unavailable.
 
+When you have more sounds playing than you can afford to process, the engine can virtualize some of
+them. A virtual sound keeps moving its cursor forward, but none of its effects are run and it
+outputs silence, so when it becomes real again it picks up from where it would have been had it
+been playing the whole time. Set `maxRealSoundCount` in the engine config to limit the number of
+sounds that are processed at once, and `virtualizationThreshold` to virtualize any sound whose
+estimated gain falls below a certain level:
+
+    ```c
+    engineConfig = ma_engine_config_init();
+    engineConfig.maxRealSoundCount       = 64;
+    engineConfig.virtualizationThreshold = ma_volume_db_to_linear(-60);
+    ```
+
+The estimated gain takes into account the volume, fade, distance attenuation and cones, but not the
+content of the sound itself. When the limit is exceeded, sounds are ranked by their priority and
+then by their estimated gain, and the lowest ranked sounds are virtualized. The priority is set with
+`ma_sound_set_priority()` and ranges from 0 to 255, with higher values being more important. It
+defaults to `MA_SOUND_PRIORITY_DEFAULT`. Use `ma_sound_is_virtual()` to check whether or not a sound
+is currently virtual, and `ma_engine_get_real_sound_count()` and
+`ma_engine_get_virtual_sound_count()` to see how many sounds were real and virtual in the last
+update. Decisions are made at the start of each call to `ma_engine_read_pcm_frames()` based on the
+sounds that were processed in the previous call, so a change takes one update to apply. To avoid
+clicks, a sound is faded out before it goes virtual and faded back in when it becomes real again.
+The fade uses `defaultVolumeSmoothTimeInPCMFrames` from the engine config, or the spatialization
+smoothing time if that is 0, and the sound is still processed while it's fading out. Sound
+groups are never virtualized. Note that streamed sounds will still be decoded while virtual.
+
+Every sound does its own sample rate conversion from the rate of its data source to the engine's
+sample rate. When lots of sounds share the same source rate, this can be done once for all of them
+by mixing them in a group that runs at their rate. Set the `sampleRate` member of the group's
+config, and any sound attached to the group will be mixed at that rate, with the mix being
+converted to the engine's rate in one pass:
+
+    ```c
+    groupConfig = ma_sound_group_config_init_2(&engine);
+    groupConfig.sampleRate = 44100;
+
+    ma_sound_group_init_ex(&engine, &groupConfig, &group);
+    ```
+
+This can also be used to save processing on groups that don't need the full bandwidth, such as
+ambience and distant effects. Setting `sampleRate` to half of the engine's rate roughly halves the
+cost of every sound in the group. Groups that are attached to the group without a `sampleRate` of
+their own run at the same rate, as do any effect nodes that sounds are routed through on the way in.
+Use `ma_sound_group_get_sample_rate()` to retrieve the rate when configuring those effects.
+
+The engine can do this for you by setting `groupSoundsBySampleRate` in the engine config. When
+enabled, a sound that would be attached to the endpoint and has a different sample rate to the
+engine will be attached to a group for its rate instead, which is created the first time it's
+needed. Use `ma_engine_get_sample_rate_group()` to retrieve the group for a given rate. Up to
+`MA_ENGINE_MAX_SAMPLE_RATE_GROUPS` groups are created, after which sounds fall back to doing their
+own conversion. Pitch and doppler still work on individual sounds, but if every sound in a group has
+the same pitch, consider setting it on the group instead and using `MA_SOUND_FLAG_NO_PITCH` on the
+sounds, in which case they'll skip resampling entirely. Note that sounds loaded with
+`MA_SOUND_FLAG_DECODE` are converted to the engine's sample rate at load time by default so this
+will not affect them. Fade lengths set in PCM frames on a sound in a group are in terms of the
+group's sample rate.
+
+By default, each spatialized sound is panned directly to the speakers which means the cost of
+spatialization grows with the number of output channels. When there are many spatialized sounds,
+the engine can instead encode each one to an ambisonic bus which is decoded to the speakers once.
+Set `ambisonicOrder` in the engine config to 1, 2 or 3 to enable it:
+
+    ```c
+    engineConfig = ma_engine_config_init();
+    engineConfig.ambisonicOrder = 1;
+    ```
+
+When enabled, spatialized sounds that would be attached to the endpoint output
+`ma_ambisonic_get_channel_count(ambisonicOrder)` channels (4, 9 or 16) of B-format and are
+attached to the bus, which you can retrieve with `ma_engine_get_ambisonic_bus()`. Higher orders
+give a sharper image at the cost of more channels per sound. Sounds that are not spatialized, that
+have an explicit output channel count, or that are attached to a sample rate group are unaffected.
+Panning does not apply to sounds on the bus. The bus is decoded to the channel map of the first
+listener. The encoder and decoder can be used independently of the engine with
+`ma_ambisonic_encode()` and `ma_ambisonic_decoder`, or `ma_ambisonic_decoder_node` in a node
+graph.
+
+With hundreds of spatialized sounds, calculating the attenuation, cones and doppler of each sound
+individually becomes a significant cost of its own. Set `spatializerBatchCapacity` in the engine
+config to have the engine gather the spatial parameters of up to that many sounds into a
+structure-of-arrays batch at the start of each period and calculate them all in a single SIMD pass:
+
+    ```c
+    engineConfig = ma_engine_config_init();
+    engineConfig.spatializerBatchCapacity = 1024;
+    ```
+
+Each sound then only needs to apply the precalculated gain and panning while it's being processed.
+Sounds beyond the capacity are spatialized individually as normal, and the output is the same
+either way. The batch is only ever changed by the audio thread. Sounds that are initialized join the
+batch at the start of the next period and the audio thread never has to wait on a lock for it. The
+batch can be used outside of the engine with `ma_spatializer_batch`: fill in a
+slot for each spatializer with `ma_spatializer_batch_set_source()`, run
+`ma_spatializer_batch_process()` for each listener, and then pass the batch into
+`ma_spatializer_process_pcm_frames_batched()` instead of calling `ma_spatializer_process_pcm_frames()`.
+
+Each call to `ma_sound_set_position()`, `ma_sound_set_direction()` and `ma_sound_set_velocity()`
+writes directly to memory that's read by the audio thread. When updating the transforms of many
+sounds every frame, you can instead write them all to a single block and hand it to the audio
+thread in one go. Set `soundTransformCapacity` in the engine config to the maximum number of
+sounds you'll update at once, and then each frame:
+
+    ```c
+    ma_sound_transform* pTransforms;
+    ma_uint32 capacity;
+
+    ma_engine_acquire_sound_transforms(&engine, &pTransforms, &capacity);
+    {
+        pTransforms[0].pSound    = &sound;
+        pTransforms[0].position  = ma_vec3f_init_3f(x, y, z);
+        pTransforms[0].direction = ma_vec3f_init_3f(0, 0, -1);
+        pTransforms[0].velocity  = ma_vec3f_init_3f(0, 0, 0);
+        ...
+    }
+    ma_engine_commit_sound_transforms(&engine, count);
+    ```
+
+The block is double buffered without any locking on the audio thread. The audio thread applies the most recently committed block at the
+start of the next call to `ma_engine_read_pcm_frames()`, so all of the sounds in a block move at the
+same time. If a block is committed before the audio thread has picked up the previous one, the
+previous one is applied immediately so no updates are lost. Only a single thread should acquire and
+commit transforms at a time. It's safe to uninitialize a sound that's in a committed block, but not
+one that's in a block that's been acquired and not yet committed.
+
+Sounds that are far away or barely audible don't need to be processed with full precision. Set
+`lodReducedDistance` and `lodMinimalDistance` in the engine config to have spatialized sounds past
+those distances from their listener processed at a lower level of detail. You can use
+`lodReducedGain` and `lodMinimalGain` to do the same based on the sound's estimated gain instead.
+At `ma_sound_lod_reduced`, doppler is disabled and small changes in spatialization gain are ignored.
+At `ma_sound_lod_minimal`, sounds with more than one channel are additionally resampled in mono.
+Switching between levels is seamless. Doppler is faded out over 100ms rather than being dropped so
+the pitch doesn't jump, and it's faded back in the same way. A sound needs to come a little way
+back inside a threshold before it goes back up a level so it doesn't flip back and forth. Use
+`ma_sound_get_lod()` to query the level a sound is being processed at.
+
 Internally, sound data is loaded via the `ma_decoder` API which means by default it only supports
 file formats that have built-in support in miniaudio. You can extend this to support any kind of
 file format through the use of custom decoders. To do this you'll need to use a self-managed
@@ -2279,7 +2465,39 @@ and include the following:
     |                                         | the output buffer of the node's processing        |
     |                                         | callback because miniaudio will ignore it anyway. |
     +-----------------------------------------+---------------------------------------------------+
+    | MA_NODE_FLAG_PLANAR                     | Used to tell miniaudio that the processing        |
+    |                                         | callback works with planar (deinterleaved) data.  |
+    |                                         | Each buffer in `ppFramesIn` and `ppFramesOut`     |
+    |                                         | holds each channel one after the other, with      |
+    |                                         | `ma_node_get_planar_stride()` samples between the |
+    |                                         | start of each channel. Cannot be used with        |
+    |                                         | `MA_NODE_FLAG_PASSTHROUGH`.                       |
+    +-----------------------------------------+---------------------------------------------------+
+
+Audio data is interleaved by default. Effects that work on one channel at a time, such as filters
+and delays, can instead set `MA_NODE_FLAG_PLANAR` to have their buffers given to them in planar
+form. Channel `iChannel` of a bus starts `iChannel * ma_node_get_planar_stride(pNode)` samples into
+the buffer for that bus, and the frame counts work the same as they do for interleaved data:
+
+    ```c
+    static void my_planar_node_process_pcm_frames(ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut)
+    {
+        ma_uint32 stride = ma_node_get_planar_stride(pNode);
+        ma_uint32 channels = ma_node_get_output_channels(pNode, 0);
+        ma_uint32 iChannel;
 
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            const float* pChannelIn  = ppFramesIn[0]  + (iChannel * stride);
+            float*       pChannelOut = ppFramesOut[0] + (iChannel * stride);
+
+            // Process *pFrameCountOut contiguous samples of this channel.
+        }
+    }
+    ```
+
+The graph only converts between layouts where a planar node is attached to an interleaved node, or
+the other way around. When a planar node is attached to another planar node, the data is passed
+between them as-is.
 
 If you need to make a copy of an audio stream for effect processing you can use a splitter node
 called `ma_splitter_node`. This takes has 1 input bus and splits the stream into 2 output buses.
@@ -2470,6 +2688,133 @@ used. The same general process applies to detachment. See `ma_node_attach_output
 `ma_node_detach_output_bus()` for the implementation of this mechanism.
 
 
+7.3. Multi-Threaded Processing
+------------------------------
+By default the entire graph is processed on the thread calling `ma_node_graph_read_pcm_frames()`.
+For large graphs this can be spread across multiple threads by setting `jobThreadCount` in the
+config:
+
+    ```c
+    ma_node_graph_config nodeGraphConfig = ma_node_graph_config_init(myChannelCount);
+    nodeGraphConfig.jobThreadCount = 3;
+    ```
+
+When enabled, each attachment on the endpoint is treated as an independent job. Worker threads,
+along with the thread calling `ma_node_graph_read_pcm_frames()`, claim jobs from a shared list and
+process the entire subgraph feeding into them. Once all jobs have been completed, the calling
+thread mixes the results in the same order as single threaded processing would. The output is
+therefore the same either way. To get the most out of this you'll want to structure your graph so
+that the expensive parts are split across multiple attachments to the endpoint. With `ma_engine`,
+this maps naturally onto sound groups. Use the `nodeGraphJobThreadCount` member of
+`ma_engine_config` to enable this for an engine.
+
+The worker threads are created in `ma_node_graph_init()` and all memory is allocated up front so
+no allocations are performed while processing. Jobs are claimed with atomic operations. Once
+there's nothing left to claim, the calling thread spins until any jobs still running on a worker
+thread are complete, and then starts yielding. Idle worker threads spin for a short time before
+parking, and the calling thread only has to wake them when they've parked. Waking a parked thread
+doesn't take a lock on Linux and Android (futex), Windows (semaphore), or macOS and iOS (Mach
+semaphore). Other platforms, such as the BSDs, use a mutex and condition variable, so the calling
+thread takes a lock when it needs to wake a worker thread there. Set `jobThreadPriority` to the
+priority of the thread calling `ma_node_graph_read_pcm_frames()`. `ma_engine` does this for you.
+Nodes with more than one output bus can have their output buses read from different threads at the
+same time and are protected by a spinlock. Because of this, loops are not allowed when this is enabled and
+`ma_node_attach_output_bus()` will return `MA_INVALID_OPERATION` if the attachment would create one. Note
+that your processing callbacks, and any callbacks fired from within them, can be run on any of the worker
+threads when this is enabled.
+
+
+7.4. Render Plans
+-----------------
+Normally the graph is processed by recursively pulling data from the endpoint. For graphs that do
+not change often, the graph can instead be flattened into a list of nodes sorted such that each
+node comes after everything it reads from. This is called a render plan and is enabled with
+`useRenderPlan`:
+
+    ```c
+    ma_node_graph_config nodeGraphConfig = ma_node_graph_config_init(myChannelCount);
+    nodeGraphConfig.useRenderPlan = MA_TRUE;
+    ```
+
+When enabled, the plan is compiled in `ma_node_graph_init()` and recompiled each time a node is
+attached or detached. The audio thread picks up the new plan at the start of the next block. Nodes
+are processed in order, each writing into a scratch buffer which is reused once everything reading
+from it has been processed. This keeps the working set small and avoids walking the attachment
+lists on the audio thread. The output is the same as it would be without a render plan.
+
+Nodes that process input and output at different rates, or that implement
+`onGetRequiredInputFrameCount`, are not expanded by the plan. Instead they pull from their inputs
+the normal way. Render plans are ignored when `jobThreadCount` is non-zero. Compiling is done without
+holding any locks, but it allocates memory and waits for the audio thread to finish any block it
+started with the old plan, so you should avoid attaching and detaching nodes on the audio thread
+when this is enabled.
+
+
+7.5. Silence and Tail Lengths
+-----------------------------
+Each output bus keeps track of whether or not the last block it output was entirely silent. This is
+the case when the node is stopped, when it has nothing to output, or when its output bus volume is
+0. Silent attachments are not mixed into the input bus they're attached to. You can query this with
+`ma_node_is_output_silent()`.
+
+When every input bus of a node is silent, the node can skip its processing callback entirely and
+just output silence, which then propagates further down the graph. Whether or not this is safe
+depends on the node. A filter or reverb will keep outputting audio for some time after its input
+has gone silent. This is called the tail, and you tell miniaudio how long it is with
+`tailLengthInFrames` in the node config, or `ma_node_set_tail_length()` after initialization:
+
+    ```c
+    ma_node_set_tail_length(&myReverbNode, sampleRate * 3);  // The reverb is inaudible 3 seconds after the input goes silent.
+    ```
+
+Once the inputs have been silent for at least the tail length, processing is skipped until the
+inputs become active again. This also applies to nodes with nothing attached to them. The default
+is `MA_NODE_TAIL_LENGTH_INFINITE`, meaning processing is never skipped, since miniaudio has no way
+of knowing what your processing callback does. Splitters have a tail length of 0. The built-in
+filter nodes (biquad, low-pass, high-pass, band-pass, notch, peaking and shelving) work out their
+tail from their coefficients, and the delay node from its delay and decay, and these are updated
+when the node is reinitialized or the decay is changed, unless you've changed the tail yourself.
+Note that a node's internal state is not updated while processing is being skipped. For sound
+groups this means fades will not progress while the group is silent, which is why groups are not
+skipped by default.
+
+
+7.6. Profiling
+--------------
+To find out which nodes are taking the most time, enable profiling on the graph. This can be done
+with `enableProfiling` in the config or at any time with `ma_node_graph_set_profiling_enabled()`.
+When enabled, each node records how many times its processing callback has been fired, how many
+frames it processed and how long it took, not including the time spent processing its inputs.
+Each output bus records how many times it was read from and how many frames were read. These are
+running totals which you can retrieve from any thread:
+
+    ```c
+    ma_node_profile profile;
+    ma_node_get_profile(&myNode, &profile);
+
+    printf("%llu ns over %llu calls\n", profile.processTimeInNanoseconds, profile.processCallCount);
+    ```
+
+Reading a profile never blocks the audio thread. If the audio thread updates the counters part way
+through reading them, the read is simply retried. To get the cost over a period of time, take two
+snapshots and subtract. You can also dump the entire graph along with the profile of every node to
+JSON for analysis with other tools:
+
+    ```c
+    size_t jsonLength;
+    char* pJSON;
+
+    ma_node_graph_get_profile_json(&nodeGraph, NULL, 0, &jsonLength);
+
+    pJSON = (char*)malloc(jsonLength + 1);
+    ma_node_graph_get_profile_json(&nodeGraph, pJSON, jsonLength + 1, NULL);
+    ```
+
+Each node is identified by an index and its address. Nodes are listed after the nodes attached to
+them, with the endpoint last. Timing adds a small amount of overhead to each processing callback so
+you should only enable profiling when you need it.
+
+
 
 8. Decoding
 ===========
@@ -2773,6 +3118,12 @@ frames.
 
 Input and output PCM frames are always interleaved. Deinterleaved layouts are not supported.
 
+When channels need to be blended, the non-zero weights are compiled into a list at initialization
+time so that mostly empty tables, such as a 7.1 to stereo downmix, only cost as much as the weights
+that are actually used. Conversions to stereo and from a single channel have SIMD paths for f32, as
+do conversions to and from mono and simple rearrangements. These give the same output as the scalar
+paths.
+
 
 10.2.1. Channel Mapping
 -----------------------
@@ -2933,12 +3284,13 @@ changed after initialization.
 
 The miniaudio resampler has built-in support for the following algorithms:
 
-    +-----------+------------------------------+
-    | Algorithm | Enum Token                   |
-    +-----------+------------------------------+
-    | Linear    | ma_resample_algorithm_linear |
-    | Custom    | ma_resample_algorithm_custom |
-    +-----------+------------------------------+
+    +-----------+---------------------------------+
+    | Algorithm | Enum Token                      |
+    +-----------+---------------------------------+
+    | Linear    | ma_resample_algorithm_linear    |
+    | Polyphase | ma_resample_algorithm_polyphase |
+    | Custom    | ma_resample_algorithm_custom    |
+    +-----------+---------------------------------+
 
 The algorithm cannot be changed after initialization.
 
@@ -2985,10 +3337,56 @@ via the `lpfOrder` configuration variable. Setting this to 0 will disable filter
 The low-pass filter has a cutoff frequency which defaults to half the sample rate of the lowest of
 the input and output sample rates (Nyquist Frequency).
 
+When both sides of the ratio simplify to `MA_LINEAR_RESAMPLER_MAX_PHASE_COUNT` or less, which is the
+case for common pairs like 44100 to 48000, 22050 to 48000 and 48000 to 16000, the interpolation
+weight and step for every output frame are precomputed when the rate is set. The table is sized for
+the ratio used at initialization time, so changing the rate to something that doesn't fit will fall
+back to calculating each step. Use `ma_linear_resampler_is_fixed_ratio()` or
+`ma_resampler_is_fixed_ratio()` to find out which path is being used.
+
 The API for the linear resampler is the same as the main resampler API, only it's called
 `ma_linear_resampler`.
 
 
+10.3.1.2. Polyphase Resampling
+------------------------------
+The polyphase resampler is a windowed-sinc FIR resampler. It's slower than the linear resampler, but
+has much better quality and is a good choice for offline conversion or anywhere the extra cost per
+channel is acceptable. The filter is split into a table of phases which is built when the rate is
+set, which means the cost of processing each output frame is fixed and known up front. Changing the
+rate rebuilds the table so it's not suited to rapid pitch changes.
+
+The quality is selected with the `quality` configuration variable which is one of the following
+presets:
+
+    +----------------------------------------+------+---------------------------------------+
+    | Quality                                | Taps | Notes                                 |
+    +----------------------------------------+------+---------------------------------------+
+    | ma_polyphase_resampler_quality_low     | 16   |                                       |
+    | ma_polyphase_resampler_quality_medium  | 32   | Default.                              |
+    | ma_polyphase_resampler_quality_high    | 64   |                                       |
+    | ma_polyphase_resampler_quality_best    | 128  | Recommended for offline conversion.   |
+    +----------------------------------------+------+---------------------------------------+
+
+The cost is one multiply-add per tap per channel for each output frame. SSE2, AVX2 and NEON are used
+where available. The tap count does not change with the conversion ratio so heavy downsampling will
+widen the transition band.
+
+When the simplified output rate is no higher than `MA_POLYPHASE_RESAMPLER_MAX_PHASE_COUNT`, which
+covers common pairs like 44100 to 48000, 22050 to 48000 and 48000 to 16000, every output frame uses an
+exact phase from the table. Otherwise the coefficients for each output frame are interpolated from the
+two nearest phases. Use `ma_polyphase_resampler_is_fixed_ratio()` to find out which one is in use. The
+input latency is half the tap count.
+
+The API for the polyphase resampler is the same as the main resampler API, only it's called
+`ma_polyphase_resampler`. When using `ma_resampler`, set the quality with `polyphase.quality`:
+
+    ```c
+    ma_resampler_config config = ma_resampler_config_init(ma_format_f32, channels, sampleRateIn, sampleRateOut, ma_resample_algorithm_polyphase);
+    config.polyphase.quality = ma_polyphase_resampler_quality_high;
+    ```
+
+
 10.3.2. Custom Resamplers
 -------------------------
 You can implement a custom resampler by using the `ma_resample_algorithm_custom` resampling
@@ -3112,6 +3510,27 @@ input buffer in which case it will be treated as an infinitely large
 buffer of zeros. The output buffer can also be NULL, in which case the processing will be treated
 as seek.
 
+When more than one stage is required, data is passed between stages through temporary buffers. By
+default these live on the stack and are only 4KB each, which for something like 8 channel f32 is
+only 128 frames at a time. When converting large buffers, set `scratchBufferSizeInFrames` in the
+config to have the data converter allocate its own scratch buffers as part of its heap so it can
+work on bigger blocks:
+
+    ```c
+    config.scratchBufferSizeInFrames = 4096;
+    ```
+
+These are allocated along with the rest of the data converter's heap so they'll come out of the
+buffer you pass to `ma_data_converter_init_preallocated()` if you're managing memory yourself.
+
+When only sample format conversion is required, the input and output buffers can be the same, in
+which case conversion will be done in place.
+
+Converting s16 to f32 with the linear resampler, where the input is either mono or stereo and the
+output has the same channel count or is stereo from mono, is handled in a single pass rather than
+as separate format conversion, resampling and channel conversion steps. This is the typical setup
+for playing back decoded audio and is selected automatically. The output is identical.
+
 Sometimes it's useful to know exactly how many input frames will be required to output a specific
 number of frames. You can calculate this with `ma_data_converter_get_required_input_frame_count()`.
 Likewise, it's sometimes useful to know exactly how many frames would be output given a certain
@@ -5180,6 +5599,7 @@ typedef struct
     float directionalAttenuationFactor; /* Set to 0 to disable directional attenuation. */
     float minSpatializationChannelGain; /* The minimal scaling factor to apply to channel gains when accounting for the direction of the sound relative to the listener. Must be in the range of 0..1. Smaller values means more aggressive directional panning, larger values means more subtle directional panning. */
     ma_uint32 gainSmoothTimeInFrames;   /* When the gain of a channel changes during spatialization, the transition will be linearly interpolated over this number of frames. */
+    ma_uint32 ambisonicOrder;           /* When set to something other than 0, the output is ambisonic B-format of this order instead of being panned to the listener's channel map. channelsOut must be equal to ma_ambisonic_get_channel_count(ambisonicOrder). */
 } ma_spatializer_config;
 
 MA_API ma_spatializer_config ma_spatializer_config_init(ma_uint32 channelsIn, ma_uint32 channelsOut);
@@ -5204,6 +5624,7 @@ typedef struct
     float dopplerFactor;                /* Set to 0 to disable doppler effect. */
     float directionalAttenuationFactor; /* Set to 0 to disable directional attenuation. */
     ma_uint32 gainSmoothTimeInFrames;   /* When the gain of a channel changes during spatialization, the transition will be linearly interpolated over this number of frames. */
+    ma_uint32 ambisonicOrder;           /* When non-zero, the output is ambisonic B-format rather than speaker channels. */
     ma_atomic_vec3f position;
     ma_atomic_vec3f direction;
     ma_atomic_vec3f velocity;  /* For doppler effect. */
@@ -5211,6 +5632,7 @@ typedef struct
     float minSpatializationChannelGain;
     ma_gainer gainer;   /* For smooth gain transitions. */
     float* pNewChannelGainsOut; /* An offset of _pHeap. Used by ma_spatializer_process_pcm_frames() to store new channel gains. The number of elements in this array is equal to config.channelsOut. */
+    float gainTolerance;        /* When non-zero, channel gains that have changed by less than this fraction are left as they are so the gainer doesn't need to interpolate. Set by the engine for sounds at a reduced level of detail. */
 
     /* Memory management. */
     void* _pHeap;
@@ -5255,6 +5677,111 @@ MA_API ma_vec3f ma_spatializer_get_velocity(const ma_spatializer* pSpatializer);
 MA_API void ma_spatializer_get_relative_position_and_direction(const ma_spatializer* pSpatializer, const ma_spatializer_listener* pListener, ma_vec3f* pRelativePos, ma_vec3f* pRelativeDir);
 
 
+/*
+Batched spatialization. This calculates the distance attenuation, cone attenuation and doppler pitch
+of many sources relative to a listener in a single pass over structure-of-arrays data. Sources are
+loaded into a slot with ma_spatializer_batch_set_source(), or by writing to the arrays directly,
+and the results of a slot are applied to a spatializer with
+ma_spatializer_process_pcm_frames_batched().
+*/
+typedef struct
+{
+    ma_uint32 capacity;                 /* The maximum number of sources in the batch. */
+} ma_spatializer_batch_config;
+
+MA_API ma_spatializer_batch_config ma_spatializer_batch_config_init(ma_uint32 capacity);
+
+
+typedef struct
+{
+    ma_uint32 capacity;
+    ma_uint32 count;                    /* The number of slots that are processed by ma_spatializer_batch_process(). */
+
+    /* Inputs. Positions are in world space, unless the positioning of the source is ma_positioning_relative. */
+    float* pPositionX;
+    float* pPositionY;
+    float* pPositionZ;
+    float* pDirectionX;
+    float* pDirectionY;
+    float* pDirectionZ;
+    float* pVelocityX;
+    float* pVelocityY;
+    float* pVelocityZ;
+    float* pMinDistance;
+    float* pMaxDistance;
+    float* pRolloff;
+    float* pMinGain;
+    float* pMaxGain;
+    float* pConeInnerCos;               /* The cosine of half the inner cone angle. Set to -MA_FLT_MAX to disable the cone. */
+    float* pConeOuterCos;               /* The cosine of half the outer cone angle. */
+    float* pConeOuterGain;
+    float* pDopplerFactor;
+    ma_int32* pAttenuationModel;        /* ma_attenuation_model */
+    ma_int32* pPositioning;             /* ma_positioning */
+    ma_uint32* pListenerIndex;          /* Only slots with a listener index matching the one passed into ma_spatializer_batch_process() are updated. */
+
+    /* Outputs. */
+    float* pGain;                       /* Distance and cone attenuation, clamped to the min and max gain. */
+    float* pDistance;                   /* The distance to the listener, or 0 when the source is right on top of it. */
+    float* pRelativeDirectionX;         /* The normalized position of the source relative to the listener. */
+    float* pRelativeDirectionY;
+    float* pRelativeDirectionZ;
+    float* pDopplerPitch;
+
+    /* Memory management. */
+    void* _pHeap;
+    ma_bool32 _ownsHeap;
+} ma_spatializer_batch;
+
+MA_API ma_result ma_spatializer_batch_get_heap_size(const ma_spatializer_batch_config* pConfig, size_t* pHeapSizeInBytes);
+MA_API ma_result ma_spatializer_batch_init_preallocated(const ma_spatializer_batch_config* pConfig, void* pHeap, ma_spatializer_batch* pBatch);
+MA_API ma_result ma_spatializer_batch_init(const ma_spatializer_batch_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_spatializer_batch* pBatch);
+MA_API void ma_spatializer_batch_uninit(ma_spatializer_batch* pBatch, const ma_allocation_callbacks* pAllocationCallbacks);
+MA_API ma_result ma_spatializer_batch_set_source(ma_spatializer_batch* pBatch, ma_uint32 index, const ma_spatializer* pSpatializer, ma_uint32 listenerIndex);
+MA_API ma_result ma_spatializer_batch_process(ma_spatializer_batch* pBatch, const ma_spatializer_listener* pListener, ma_uint32 listenerIndex);
+MA_API ma_result ma_spatializer_batch_process_range(ma_spatializer_batch* pBatch, const ma_spatializer_listener* pListener, ma_uint32 listenerIndex, ma_uint32 firstIndex, ma_uint32 count);
+MA_API ma_result ma_spatializer_process_pcm_frames_batched(ma_spatializer* pSpatializer, ma_spatializer_listener* pListener, const ma_spatializer_batch* pBatch, ma_uint32 index, void* pFramesOut, const void* pFramesIn, ma_uint64 frameCount);
+
+
+/*
+Ambisonics. Channels are in ACN order with SN3D normalization. Directions are in the same space as
+the listener relative positions used by the spatializer, that is +X is right, +Y is up and -Z is
+forward.
+*/
+#define MA_AMBISONIC_MAX_ORDER      3
+#define MA_AMBISONIC_MAX_CHANNELS   16  /* (MA_AMBISONIC_MAX_ORDER + 1)^2 */
+
+MA_API ma_uint32 ma_ambisonic_get_channel_count(ma_uint32 order);
+MA_API void ma_ambisonic_encode(ma_uint32 order, ma_vec3f direction, float* pGains);
+
+typedef struct
+{
+    ma_uint32 order;
+    ma_uint32 channelsOut;
+    const ma_channel* pChannelMapOut;   /* The speaker layout to decode to. Set to NULL to use the default channel map for channelsOut. */
+} ma_ambisonic_decoder_config;
+
+MA_API ma_ambisonic_decoder_config ma_ambisonic_decoder_config_init(ma_uint32 order, ma_uint32 channelsOut, const ma_channel* pChannelMapOut);
+
+typedef struct
+{
+    ma_uint32 order;
+    ma_uint32 channelsIn;               /* ma_ambisonic_get_channel_count(order) */
+    ma_uint32 channelsOut;
+    float* pMatrix;                     /* channelsOut rows of channelsIn coefficients. An offset of _pHeap. */
+
+    /* Memory management. */
+    void* _pHeap;
+    ma_bool32 _ownsHeap;
+} ma_ambisonic_decoder;
+
+MA_API ma_result ma_ambisonic_decoder_get_heap_size(const ma_ambisonic_decoder_config* pConfig, size_t* pHeapSizeInBytes);
+MA_API ma_result ma_ambisonic_decoder_init_preallocated(const ma_ambisonic_decoder_config* pConfig, void* pHeap, ma_ambisonic_decoder* pDecoder);
+MA_API ma_result ma_ambisonic_decoder_init(const ma_ambisonic_decoder_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_ambisonic_decoder* pDecoder);
+MA_API void ma_ambisonic_decoder_uninit(ma_ambisonic_decoder* pDecoder, const ma_allocation_callbacks* pAllocationCallbacks);
+MA_API ma_result ma_ambisonic_decoder_process_pcm_frames(ma_ambisonic_decoder* pDecoder, float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount);
+
+
 
 /************************************************************************************************************************************************************
 *************************************************************************************************************************************************************
@@ -5284,6 +5811,19 @@ typedef struct
 
 MA_API ma_linear_resampler_config ma_linear_resampler_config_init(ma_format format, ma_uint32 channels, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut);
 
+#define MA_LINEAR_RESAMPLER_MAX_PHASE_COUNT     512     /* Ratios where both sides simplify to this or less use a precomputed phase table. */
+
+typedef struct
+{
+    union
+    {
+        float f32;
+        ma_int32 s16;
+    } alpha;                /* The interpolation weight for this phase. */
+    ma_uint16 inAdvance;    /* The number of input frames to move forward after this phase. */
+    ma_uint16 nextPhase;    /* The phase of the next output frame. */
+} ma_linear_resampler_phase;
+
 typedef struct
 {
     ma_linear_resampler_config config;
@@ -5291,6 +5831,9 @@ typedef struct
     ma_uint32 inAdvanceFrac;
     ma_uint32 inTimeInt;
     ma_uint32 inTimeFrac;
+    ma_uint32 phaseCapacity;            /* The size of the phase table. Set at initialization time from the initial ratio. */
+    ma_bool32 isFixedRatio;             /* When set, pPhases is indexed by inTimeFrac and used instead of calculating each step. */
+    ma_linear_resampler_phase* pPhases;
     union
     {
         float* f32;
@@ -5320,6 +5863,63 @@ MA_API ma_uint64 ma_linear_resampler_get_output_latency(const ma_linear_resample
 MA_API ma_result ma_linear_resampler_get_required_input_frame_count(const ma_linear_resampler* pResampler, ma_uint64 outputFrameCount, ma_uint64* pInputFrameCount);
 MA_API ma_result ma_linear_resampler_get_expected_output_frame_count(const ma_linear_resampler* pResampler, ma_uint64 inputFrameCount, ma_uint64* pOutputFrameCount);
 MA_API ma_result ma_linear_resampler_reset(ma_linear_resampler* pResampler);
+MA_API ma_bool32 ma_linear_resampler_is_fixed_ratio(const ma_linear_resampler* pResampler);
+
+
+typedef enum
+{
+    ma_polyphase_resampler_quality_low = 0,     /* 16 taps. */
+    ma_polyphase_resampler_quality_medium,      /* 32 taps. Default. */
+    ma_polyphase_resampler_quality_high,        /* 64 taps. */
+    ma_polyphase_resampler_quality_best         /* 128 taps. */
+} ma_polyphase_resampler_quality;
+
+#define MA_DEFAULT_POLYPHASE_RESAMPLER_QUALITY      ma_polyphase_resampler_quality_medium
+#define MA_POLYPHASE_RESAMPLER_MAX_PHASE_COUNT      512     /* When the simplified output rate is higher than this, adjacent phases are interpolated. */
+
+typedef struct
+{
+    ma_format format;
+    ma_uint32 channels;
+    ma_uint32 sampleRateIn;
+    ma_uint32 sampleRateOut;
+    ma_polyphase_resampler_quality quality;
+} ma_polyphase_resampler_config;
+
+MA_API ma_polyphase_resampler_config ma_polyphase_resampler_config_init(ma_format format, ma_uint32 channels, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut);
+
+typedef struct
+{
+    ma_polyphase_resampler_config config;   /* The sample rates in here are simplified. */
+    ma_uint32 tapCount;
+    ma_uint32 phaseCount;
+    ma_uint32 inAdvanceInt;
+    ma_uint32 inAdvanceFrac;
+    ma_uint32 inTimeInt;
+    ma_uint32 inTimeFrac;
+    ma_uint32 historyCursor;                /* Index of the oldest frame in the history ring buffer. */
+    float* pCoefficients;                   /* (phaseCount + 1) * tapCount. One row per phase. */
+    float* pCoefficientsInterpolated;       /* tapCount. Used when the phase falls between two rows. */
+    float* pHistory;                        /* channels * tapCount * 2. Each sample is written twice so the window is always contiguous. */
+
+    /* Memory management. */
+    void* _pHeap;
+    ma_bool32 _ownsHeap;
+} ma_polyphase_resampler;
+
+MA_API ma_result ma_polyphase_resampler_get_heap_size(const ma_polyphase_resampler_config* pConfig, size_t* pHeapSizeInBytes);
+MA_API ma_result ma_polyphase_resampler_init_preallocated(const ma_polyphase_resampler_config* pConfig, void* pHeap, ma_polyphase_resampler* pResampler);
+MA_API ma_result ma_polyphase_resampler_init(const ma_polyphase_resampler_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_polyphase_resampler* pResampler);
+MA_API void ma_polyphase_resampler_uninit(ma_polyphase_resampler* pResampler, const ma_allocation_callbacks* pAllocationCallbacks);
+MA_API ma_result ma_polyphase_resampler_process_pcm_frames(ma_polyphase_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut);
+MA_API ma_result ma_polyphase_resampler_set_rate(ma_polyphase_resampler* pResampler, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut);
+MA_API ma_result ma_polyphase_resampler_set_rate_ratio(ma_polyphase_resampler* pResampler, float ratioInOut);
+MA_API ma_uint64 ma_polyphase_resampler_get_input_latency(const ma_polyphase_resampler* pResampler);
+MA_API ma_uint64 ma_polyphase_resampler_get_output_latency(const ma_polyphase_resampler* pResampler);
+MA_API ma_result ma_polyphase_resampler_get_required_input_frame_count(const ma_polyphase_resampler* pResampler, ma_uint64 outputFrameCount, ma_uint64* pInputFrameCount);
+MA_API ma_result ma_polyphase_resampler_get_expected_output_frame_count(const ma_polyphase_resampler* pResampler, ma_uint64 inputFrameCount, ma_uint64* pOutputFrameCount);
+MA_API ma_result ma_polyphase_resampler_reset(ma_polyphase_resampler* pResampler);
+MA_API ma_bool32 ma_polyphase_resampler_is_fixed_ratio(const ma_polyphase_resampler* pResampler);
 
 
 typedef struct ma_resampler_config ma_resampler_config;
@@ -5343,6 +5943,7 @@ typedef enum
 {
     ma_resample_algorithm_linear = 0,    /* Fastest, lowest quality. Optional low-pass filtering. Default. */
     ma_resample_algorithm_custom,
+    ma_resample_algorithm_polyphase      /* Windowed-sinc FIR. Higher quality at a fixed cost per channel, controlled with a quality preset. */
 } ma_resample_algorithm;
 
 struct ma_resampler_config
@@ -5358,6 +5959,10 @@ struct ma_resampler_config
     {
         ma_uint32 lpfOrder;
     } linear;
+    struct
+    {
+        ma_polyphase_resampler_quality quality;
+    } polyphase;
 };
 
 MA_API ma_resampler_config ma_resampler_config_init(ma_format format, ma_uint32 channels, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut, ma_resample_algorithm algorithm);
@@ -5374,6 +5979,7 @@ typedef struct
     union
     {
         ma_linear_resampler linear;
+        ma_polyphase_resampler polyphase;
     } state;    /* State for stock resamplers so we can avoid a malloc. For stock resamplers, pBackend will point here. */
 
     /* Memory management. */
@@ -5461,6 +6067,12 @@ Resets the resampler's timer and clears it's internal cache.
 */
 MA_API ma_result ma_resampler_reset(ma_resampler* pResampler);
 
+/*
+Determines whether or not the resampler is using a precomputed phase table for a fixed ratio. This
+is only supported by the stock resamplers. Custom backends will always return false.
+*/
+MA_API ma_bool32 ma_resampler_is_fixed_ratio(const ma_resampler* pResampler);
+
 
 /**************************************************************************************************************************************************************
 
@@ -5514,6 +6126,16 @@ typedef struct
         float**    f32;
         ma_int32** s16;
     } weights;  /* [in][out] */
+    ma_uint32 sparseWeightCount;
+    ma_uint8* pSparseWeightChannels;    /* [sparseWeightCount][2]. The input and output channel of each non-zero weight, in [in][out] order. */
+    union
+    {
+        float*    f32;
+        ma_int32* s16;
+    } sparseWeights;    /* [sparseWeightCount] */
+    ma_uint32 stereoWeightCount;        /* For f32 to stereo. The number of input channels with a non-zero weight for either output channel. */
+    ma_uint8* pStereoWeightChannels;    /* [stereoWeightCount]. */
+    float* pStereoWeights;              /* [stereoWeightCount][4]. The left and right weights, repeated for two frames. */
 
     /* Memory management. */
     void* _pHeap;
@@ -5549,6 +6171,7 @@ typedef struct
     ma_bool32 calculateLFEFromSpatialChannels;  /* When an output LFE channel is present, but no input LFE, set to true to set the output LFE to the average of all spatial channels (LR, FR, etc.). Ignored when an input LFE is present. */
     float** ppChannelWeights;  /* [in][out]. Only used when mixingMode is set to ma_channel_mix_mode_custom_weights. */
     ma_bool32 allowDynamicSampleRate;
+    ma_uint32 scratchBufferSizeInFrames;    /* When non-zero, intermediary stages are processed in blocks of up to this many frames using scratch buffers allocated on the heap, rather than through small buffers on the stack. */
     ma_resampler_config resampling;
 } ma_data_converter_config;
 
@@ -5563,7 +6186,8 @@ typedef enum
     ma_data_converter_execution_path_channels_only,     /* Only channel conversion. */
     ma_data_converter_execution_path_resample_only,     /* Only resampling. */
     ma_data_converter_execution_path_resample_first,    /* All conversions, but resample as the first step. */
-    ma_data_converter_execution_path_channels_first     /* All conversions, but channels as the first step. */
+    ma_data_converter_execution_path_channels_first,    /* All conversions, but channels as the first step. */
+    ma_data_converter_execution_path_s16_to_f32_fused   /* s16 to f32 with linear resampling and mono or stereo channel mapping in a single pass. */
 } ma_data_converter_execution_path;
 
 typedef struct
@@ -5583,6 +6207,8 @@ typedef struct
     ma_bool8 hasChannelConverter;
     ma_bool8 hasResampler;
     ma_bool8 isPassthrough;
+    void* pScratchBuffer;                   /* Three buffers of scratchBufferSizeInBytes each, placed back to back. NULL when the stack is used instead. */
+    size_t scratchBufferSizeInBytes;
 
     /* Memory management. */
     ma_bool8 _ownsHeap;
@@ -5643,6 +6269,19 @@ Interleaves a group of deinterleaved buffers.
 */
 MA_API void ma_interleave_pcm_frames(ma_format format, ma_uint32 channels, ma_uint64 frameCount, const void** ppDeinterleavedPCMFrames, void* pInterleavedPCMFrames);
 
+/*
+Deinterleaves an interleaved buffer and converts it to a different format in the same pass.
+Conversions between s16 and f32, and channel counts of 2 and 4 or more, have SIMD paths. Everything
+else is converted with `ma_pcm_convert()` in chunks.
+*/
+MA_API void ma_deinterleave_pcm_frames_ex(ma_format formatOut, ma_format formatIn, ma_uint32 channels, ma_uint64 frameCount, const void* pInterleavedPCMFrames, void** ppDeinterleavedPCMFrames, ma_dither_mode ditherMode);
+
+/*
+Interleaves a group of deinterleaved buffers and converts them to a different format in the same
+pass. See `ma_deinterleave_pcm_frames_ex()`.
+*/
+MA_API void ma_interleave_pcm_frames_ex(ma_format formatOut, ma_format formatIn, ma_uint32 channels, ma_uint64 frameCount, const void** ppDeinterleavedPCMFrames, void* pInterleavedPCMFrames, ma_dither_mode ditherMode);
+
 
 /************************************************************************************************************************************************************
 
@@ -6522,6 +7161,14 @@ MA_API ma_result ma_job_queue_post(ma_job_queue* pQueue, const ma_job* pJob);
 MA_API ma_result ma_job_queue_next(ma_job_queue* pQueue, ma_job* pJob); /* Returns MA_CANCELLED if the next job is a quit job. */
 
 
+/* Used for timing. This is used by the device I/O system and the node graph's profiler. */
+typedef union
+{
+    ma_int64 counter;
+    double counterD;
+} ma_timer;
+
+
 
 /************************************************************************************************************************************************************
 *************************************************************************************************************************************************************
@@ -6976,12 +7623,6 @@ typedef enum
     ma_aaudio_allow_capture_by_none                 /* AAUDIO_ALLOW_CAPTURE_BY_NONE */
 } ma_aaudio_allowed_capture_policy;
 
-typedef union
-{
-    ma_int64 counter;
-    double counterD;
-} ma_timer;
-
 typedef union
 {
     ma_wchar_win32 wasapi[64];      /* WASAPI uses a wchar_t string for identification. */
@@ -7737,6 +8378,10 @@ struct ma_device
         {
             ma_uint32 lpfOrder;
         } linear;
+        struct
+        {
+            ma_polyphase_resampler_quality quality;
+        } polyphase;
     } resampling;
     struct
     {
@@ -8650,7 +9295,8 @@ then be set directly on the structure. Below are the members of the `ma_device_c
 
     resampling.algorithm
         The resampling algorithm to use when miniaudio needs to perform resampling between the rate specified by `sampleRate` and the device's native rate. The
-        default value is `ma_resample_algorithm_linear`, and the quality can be configured with `resampling.linear.lpfOrder`.
+        default value is `ma_resample_algorithm_linear`, and the quality can be configured with `resampling.linear.lpfOrder`. When using
+        `ma_resample_algorithm_polyphase`, the quality is configured with `resampling.polyphase.quality`.
 
     resampling.pBackendVTable
         A pointer to an optional vtable that can be used for plugging in a custom resampler.
@@ -8663,6 +9309,10 @@ then be set directly on the structure. Below are the members of the `ma_device_c
         the value, the better the quality, in general. Setting this to 0 will disable low-pass filtering altogether. The maximum value is
         `MA_MAX_FILTER_ORDER`. The default value is `min(4, MA_MAX_FILTER_ORDER)`.
 
+    resampling.polyphase.quality
+        The quality preset to use with the polyphase resampler. This controls the number of filter taps. The default value is
+        `ma_polyphase_resampler_quality_medium`.
+
     playback.pDeviceID
         A pointer to a `ma_device_id` structure containing the ID of the playback device to initialize. Setting this NULL (default) will use the system's
         default playback device. Retrieve the device ID from the `ma_device_info` structure, which can be retrieved using device enumeration.
@@ -9778,6 +10428,15 @@ This will run on an optimized path when the volume is equal to 1.
 */
 MA_API ma_result ma_mix_pcm_frames_f32(float* pDst, const float* pSrc, ma_uint64 frameCount, ma_uint32 channels, float volume);
 
+/*
+Mixes multiple sources into a single destination buffer, with an optional volume factor for each source.
+
+The result is the same as calling `ma_mix_pcm_frames_f32()` once for each source, but the destination buffer is only read
+and written once. Each source must contain `frameCount` frames. `pVolumes` can be NULL in which case a volume of 1 is
+used for each source.
+*/
+MA_API ma_result ma_mix_pcm_frames_multi_f32(float* pDst, const float** ppSrc, const float* pVolumes, ma_uint32 sourceCount, ma_uint64 frameCount, ma_uint32 channels);
+
 
 
 
@@ -10547,6 +11206,24 @@ Node Graph
 /* Use this when the bus count is determined by the node instance rather than the vtable. */
 #define MA_NODE_BUS_COUNT_UNKNOWN   255
 
+/* Use this for the tail length of a node when it's unknown or the node never stops outputting audio. This is the default. */
+#define MA_NODE_TAIL_LENGTH_INFINITE    0xFFFFFFFF
+
+/* The maximum number of worker threads a node graph can use for multi-threaded processing. */
+#ifndef MA_NODE_GRAPH_MAX_JOB_THREAD_COUNT
+#define MA_NODE_GRAPH_MAX_JOB_THREAD_COUNT  16
+#endif
+
+/* The number of times a worker thread checks for a new round of jobs before parking. */
+#ifndef MA_NODE_GRAPH_JOB_SPIN_COUNT
+#define MA_NODE_GRAPH_JOB_SPIN_COUNT        4000
+#endif
+
+/* The default number of endpoint attachments that can be processed in parallel at a time. Must never exceed 65535. */
+#ifndef MA_DEFAULT_NODE_GRAPH_JOB_CAPACITY
+#define MA_DEFAULT_NODE_GRAPH_JOB_CAPACITY  64
+#endif
+
 typedef struct ma_node_graph ma_node_graph;
 typedef void ma_node;
 
@@ -10558,7 +11235,8 @@ typedef enum
     MA_NODE_FLAG_CONTINUOUS_PROCESSING      = 0x00000002,
     MA_NODE_FLAG_ALLOW_NULL_INPUT           = 0x00000004,
     MA_NODE_FLAG_DIFFERENT_PROCESSING_RATES = 0x00000008,
-    MA_NODE_FLAG_SILENT_OUTPUT              = 0x00000010
+    MA_NODE_FLAG_SILENT_OUTPUT              = 0x00000010,
+    MA_NODE_FLAG_PLANAR                     = 0x00000020
 } ma_node_flags;
 
 
@@ -10621,11 +11299,30 @@ typedef struct
     ma_uint32 outputBusCount;           /* Only used if the vtable specifies an output bus count of `MA_NODE_BUS_COUNT_UNKNOWN`, otherwise  be set to `MA_NODE_BUS_COUNT_UNKNOWN` (default). */
     const ma_uint32* pInputChannels;    /* The number of elements are determined by the input bus count as determined by the vtable, or `inputBusCount` if the vtable specifies `MA_NODE_BUS_COUNT_UNKNOWN`. */
     const ma_uint32* pOutputChannels;   /* The number of elements are determined by the output bus count as determined by the vtable, or `outputBusCount` if the vtable specifies `MA_NODE_BUS_COUNT_UNKNOWN`. */
+    ma_uint32 tailLengthInFrames;       /* The number of frames it takes for the output to become silent after the input has become silent. Defaults to `MA_NODE_TAIL_LENGTH_INFINITE` which means processing is never skipped. */
 } ma_node_config;
 
 MA_API ma_node_config ma_node_config_init(void);
 
 
+/* A snapshot of the profiling counters of a node. Retrieve this with ma_node_get_profile(). All values are totals since the node was initialized. */
+typedef struct
+{
+    ma_uint64 processCallCount;             /* The number of times the processing callback has been fired. */
+    ma_uint64 framesProcessedIn;            /* The number of input frames consumed by the processing callback. */
+    ma_uint64 framesProcessedOut;           /* The number of output frames produced by the processing callback. */
+    ma_uint64 processTimeInNanoseconds;     /* The time spent inside the processing callback. This does not include the time spent processing the node's inputs. */
+    ma_uint64 maxProcessTimeInNanoseconds;  /* The longest time spent inside a single call to the processing callback. */
+} ma_node_profile;
+
+/* A snapshot of the profiling counters of an output bus. Retrieve this with ma_node_get_output_bus_profile(). */
+typedef struct
+{
+    ma_uint64 readCount;                    /* The number of times the output bus has been read from. */
+    ma_uint64 framesRead;                   /* The number of frames that have been read from the output bus. */
+} ma_node_output_bus_profile;
+
+
 /*
 A node has multiple output buses. An output bus is attached to an input bus as an item in a linked
 list. Think of the input bus as a linked list, with the output bus being an item in that list.
@@ -10648,6 +11345,10 @@ struct ma_node_output_bus
     MA_ATOMIC(MA_SIZEOF_PTR, ma_node_output_bus*) pNext;    /* If null, it's the tail node or detached. */
     MA_ATOMIC(MA_SIZEOF_PTR, ma_node_output_bus*) pPrev;    /* If null, it's the head node or detached. */
     MA_ATOMIC(MA_SIZEOF_PTR, ma_node*) pInputNode;          /* The node that this output bus is attached to. Required for detaching. */
+
+    /* Profiling. Only updated when profiling is enabled on the node graph. Protected by the owning node's profile sequence. */
+    MA_ATOMIC(8, ma_uint64) profileReadCount;
+    MA_ATOMIC(8, ma_uint64) profileFramesRead;
 };
 
 /*
@@ -10664,6 +11365,9 @@ struct ma_node_input_bus
 
     /* Set once at startup. */
     ma_uint8 channels;                      /* The number of channels in the audio stream for this bus. */
+
+    /* Only used from the audio thread. */
+    ma_bool8 isSilent;                      /* Set after each read. True if everything attached to this bus output silence. */
 };
 
 
@@ -10674,17 +11378,30 @@ struct ma_node_base
     ma_node_graph* pNodeGraph;              /* The graph this node belongs to. */
     const ma_node_vtable* vtable;
     float* pCachedData;                     /* Allocated on the heap. Fixed size. Needs to be stored on the heap because reading from output buses is done in separate function calls. */
+    float* pMixBatchData;                   /* Allocated on the heap. Holds MA_NODE_INPUT_BUS_MIX_BATCH_SIZE attachments while they wait to be mixed into an input bus. NULL if the node has no input buses. */
     ma_uint16 cachedDataCapInFramesPerBus;  /* The capacity of the input data cache in frames, per bus. */
 
     /* These variables are read and written only from the audio thread. */
     ma_uint16 cachedFrameCountOut;
     ma_uint16 cachedFrameCountIn;
     ma_uint16 consumedFrameCountIn;
+    ma_uint32 silentFrameCountIn;           /* The number of frames all input buses have been silent for in a row. Compared against tailLengthInFrames to determine when processing can be skipped. */
 
     /* These variables are read and written between different threads. */
     MA_ATOMIC(4, ma_node_state) state;      /* When set to stopped, nothing will be read, regardless of the times in stateTimes. */
     MA_ATOMIC(8, ma_uint64) stateTimes[2];  /* Indexed by ma_node_state. Specifies the time based on the global clock that a node should be considered to be in the relevant state. */
     MA_ATOMIC(8, ma_uint64) localTime;      /* The node's local clock. This is just a running sum of the number of output frames that have been processed. Can be modified by any thread with `ma_node_set_time()`. */
+    MA_ATOMIC(4, ma_spinlock) readLock;     /* Only used when the graph is processed on multiple threads and the node has more than one output bus, in which case its output buses may be read from different threads. */
+    MA_ATOMIC(4, ma_uint32) tailLengthInFrames; /* The number of frames the node keeps outputting audio after its input has become silent. Set to MA_NODE_TAIL_LENGTH_INFINITE to never skip processing. */
+
+    /* Profiling. Only updated when profiling is enabled on the node graph. Written by the audio thread and read from any thread with ma_node_get_profile(). */
+    MA_ATOMIC(4, ma_uint32) profileSequence;                /* Odd while the audio thread is in the middle of updating the values below. Readers retry until they see the same even value before and after reading. */
+    MA_ATOMIC(8, ma_uint64) profileProcessCallCount;
+    MA_ATOMIC(8, ma_uint64) profileFramesProcessedIn;
+    MA_ATOMIC(8, ma_uint64) profileFramesProcessedOut;
+    MA_ATOMIC(8, ma_uint64) profileProcessTimeInNanoseconds;
+    MA_ATOMIC(8, ma_uint64) profileMaxProcessTimeInNanoseconds;
+
     ma_uint32 inputBusCount;
     ma_uint32 outputBusCount;
     ma_node_input_bus* pInputBuses;
@@ -10706,6 +11423,7 @@ MA_API ma_uint32 ma_node_get_input_bus_count(const ma_node* pNode);
 MA_API ma_uint32 ma_node_get_output_bus_count(const ma_node* pNode);
 MA_API ma_uint32 ma_node_get_input_channels(const ma_node* pNode, ma_uint32 inputBusIndex);
 MA_API ma_uint32 ma_node_get_output_channels(const ma_node* pNode, ma_uint32 outputBusIndex);
+MA_API ma_uint32 ma_node_get_planar_stride(const ma_node* pNode);
 MA_API ma_result ma_node_attach_output_bus(ma_node* pNode, ma_uint32 outputBusIndex, ma_node* pOtherNode, ma_uint32 otherNodeInputBusIndex);
 MA_API ma_result ma_node_detach_output_bus(ma_node* pNode, ma_uint32 outputBusIndex);
 MA_API ma_result ma_node_detach_all_output_buses(ma_node* pNode);
@@ -10719,17 +11437,78 @@ MA_API ma_node_state ma_node_get_state_by_time(const ma_node* pNode, ma_uint64 g
 MA_API ma_node_state ma_node_get_state_by_time_range(const ma_node* pNode, ma_uint64 globalTimeBeg, ma_uint64 globalTimeEnd);
 MA_API ma_uint64 ma_node_get_time(const ma_node* pNode);
 MA_API ma_result ma_node_set_time(ma_node* pNode, ma_uint64 localTime);
+MA_API ma_result ma_node_set_tail_length(ma_node* pNode, ma_uint32 tailLengthInFrames);
+MA_API ma_uint32 ma_node_get_tail_length(const ma_node* pNode);
+MA_API ma_bool32 ma_node_is_output_silent(const ma_node* pNode, ma_uint32 outputBusIndex);
+MA_API ma_result ma_node_get_profile(const ma_node* pNode, ma_node_profile* pProfile);
+MA_API ma_result ma_node_get_output_bus_profile(const ma_node* pNode, ma_uint32 outputBusIndex, ma_node_output_bus_profile* pProfile);
 
 
 typedef struct
 {
     ma_uint32 channels;
     ma_uint16 nodeCacheCapInFrames;
+    ma_uint32 jobThreadCount;           /* The number of worker threads to use for processing the endpoint's attachments in parallel. Defaults to 0 which means everything is processed on the thread calling ma_node_graph_read_pcm_frames(). Cannot exceed MA_NODE_GRAPH_MAX_JOB_THREAD_COUNT. */
+    size_t jobThreadStackSize;
+#ifndef MA_NO_THREADING
+    ma_thread_priority jobThreadPriority;   /* The priority of the worker threads. This should match the priority of the thread calling ma_node_graph_read_pcm_frames() or else that thread can end up waiting on a worker that's been preempted. Defaults to ma_thread_priority_highest which is the default for devices. */
+#endif
+    ma_uint32 jobCapacity;              /* The maximum number of endpoint attachments that are processed in parallel at a time. Any more than this will be processed in subsequent rounds. Defaults to MA_DEFAULT_NODE_GRAPH_JOB_CAPACITY. */
+    ma_bool32 useRenderPlan;            /* When set to true, the graph is compiled into a flat list of nodes whenever an attachment changes and processed in that order. Ignored when jobThreadCount is greater than 0. */
+    ma_bool32 enableProfiling;          /* When set to true, each node records the time spent processing and the number of frames processed. Can be changed later with ma_node_graph_set_profiling_enabled(). */
 } ma_node_graph_config;
 
 MA_API ma_node_graph_config ma_node_graph_config_init(ma_uint32 channels);
 
 
+/* A unit of work for multi-threaded processing. Each job is one of the attachments on the endpoint's input bus. */
+typedef struct
+{
+    ma_node_output_bus* pOutputBus;
+    float* pFrames;                     /* Where the output of the attachment is written. Points into the node graph's job buffer. */
+    ma_bool32 isSilent;                 /* Set by whichever thread processed the job. True if the attachment output nothing but silence. */
+} ma_node_graph_job;
+
+
+/* A link in a render plan. There is one for each attachment between two nodes in the plan. */
+typedef struct
+{
+    ma_node_output_bus* pOutputBus;     /* The output bus of the producing node. */
+    ma_uint32 producerStepIndex;
+    ma_uint32 consumerStepIndex;
+    ma_uint32 consumerInputBusIndex;
+    ma_uint32 slotIndex;                /* The buffer the producer writes to and the consumer reads from. Slots are shared between links whose lifetimes don't overlap. */
+    ma_bool32 isDemanded;               /* Whether or not the consumer will be reading from this link in the current block. Only accessed by the audio thread. */
+    ma_bool32 isSilent;                 /* Whether or not the producer output nothing but silence in the current block. Only accessed by the audio thread. */
+} ma_node_graph_render_plan_link;
+
+/* A step in a render plan. There is one for each node reachable from the endpoint. */
+typedef struct
+{
+    ma_node* pNode;
+    ma_bool32 isExpanded;               /* When true, the inputs of this node are read from the slots of its links. Otherwise the node pulls from its inputs itself. */
+    ma_bool32 isDemanded;               /* Whether or not this step needs to be executed in the current block. Only accessed by the audio thread. */
+    ma_bool32 hasReadInputs;            /* Used for making sure the links of an expanded step are only read once per block. Only accessed by the audio thread. */
+    ma_uint32 firstLink;                /* The links feeding into this step, ordered by input bus and then attachment order. */
+    ma_uint32 linkCount;
+    ma_uint32 firstOutputLink;          /* Index into pOutputLinkIndices of the links this step produces. */
+    ma_uint32 outputLinkCount;
+} ma_node_graph_render_plan_step;
+
+/* A topologically sorted list of the nodes in a graph. The endpoint is always the last step. */
+typedef struct
+{
+    ma_uint32 generation;               /* Used for making sure a plan is never replaced by one that was compiled from an older state of the graph. */
+    ma_uint32 stepCount;
+    ma_uint32 linkCount;
+    ma_uint32 slotCount;
+    ma_uint32 slotSizeInSamples;
+    ma_node_graph_render_plan_step* pSteps;
+    ma_node_graph_render_plan_link* pLinks;
+    ma_uint32* pOutputLinkIndices;
+    float* pSlots;
+} ma_node_graph_render_plan;
+
 struct ma_node_graph
 {
     /* Immutable. */
@@ -10739,6 +11518,42 @@ struct ma_node_graph
 
     /* Read and written by multiple threads. */
     MA_ATOMIC(4, ma_bool32) isReading;
+
+#ifndef MA_NO_THREADING
+    /* Multi-threaded processing. Only used when jobThreadCount is greater than 0. */
+    ma_uint32 jobThreadCount;
+    ma_uint32 jobCapacity;
+    ma_node_graph_job* pJobs;           /* Allocated on the heap. jobCapacity items. */
+    float* pJobFrames;                  /* Allocated on the heap, in the same allocation as pJobs. nodeCacheCapInFrames frames per job. */
+    ma_uint32 jobFrameCount;            /* The number of frames each job in the current round needs to read. */
+    ma_uint64 jobGlobalTime;            /* The global time of the current round. */
+    MA_ATOMIC(4, ma_uint32) jobRange;   /* The job count of the current round in the upper 16 bits, and the index of the next job to claim in the lower 16 bits. */
+    MA_ATOMIC(4, ma_uint32) jobsCompleted;
+    MA_ATOMIC(4, ma_bool32) isJobThreadShuttingDown;
+    MA_ATOMIC(4, ma_uint32) jobParkedThreadCount;   /* The number of worker threads that have stopped spinning and are waiting to be woken up. */
+    MA_ATOMIC(4, ma_uint32) jobSignal;  /* Incremented when parked worker threads are woken up. This is the futex word on Linux. */
+#if defined(MA_APPLE)
+    ma_uint32 jobMachSemaphore;         /* A semaphore_t. For parking worker threads on Apple platforms. */
+#else
+    ma_semaphore jobSemaphore;          /* For parking worker threads on platforms without futexes. */
+#endif
+    ma_thread jobThreads[MA_NODE_GRAPH_MAX_JOB_THREAD_COUNT];
+#endif
+
+    /* Render plan. Only used when useRenderPlan is enabled. */
+    ma_bool32 useRenderPlan;
+    ma_allocation_callbacks allocationCallbacks;                    /* Render plans are compiled when attachments change so we need to keep hold of these. */
+    MA_ATOMIC(MA_SIZEOF_PTR, ma_node_graph_render_plan*) pRenderPlan;
+    MA_ATOMIC(4, ma_uint32) renderPlanEpoch;                        /* Readers register against the current epoch. An old plan can be freed once the epoch has moved on twice since it was replaced. */
+    MA_ATOMIC(4, ma_uint32) renderPlanReaderCounts[2];              /* The number of readers registered against even and odd epochs. */
+    MA_ATOMIC(4, ma_uint32) renderPlanGeneration;                   /* Incremented before each compile. */
+    MA_ATOMIC(4, ma_spinlock) renderPlanLock;                       /* Only held while swapping in a new plan. Never used by the audio thread. */
+    ma_uint32 renderPlanPublishedGeneration;                        /* The generation of the current plan. Only accessed with renderPlanLock held. */
+    ma_node_graph_render_plan* pRenderPlanInUse;                    /* The plan the current block is being processed with. Only accessed by the audio thread. */
+    ma_node_graph_render_plan_step* pRenderPlanStep;                /* The step currently being executed. Only accessed by the audio thread. */
+
+    /* Profiling. */
+    MA_ATOMIC(4, ma_bool32) isProfilingEnabled;
 };
 
 MA_API ma_result ma_node_graph_init(const ma_node_graph_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_node_graph* pNodeGraph);
@@ -10748,6 +11563,42 @@ MA_API ma_result ma_node_graph_read_pcm_frames(ma_node_graph* pNodeGraph, void*
 MA_API ma_uint32 ma_node_graph_get_channels(const ma_node_graph* pNodeGraph);
 MA_API ma_uint64 ma_node_graph_get_time(const ma_node_graph* pNodeGraph);
 MA_API ma_result ma_node_graph_set_time(ma_node_graph* pNodeGraph, ma_uint64 globalTime);
+MA_API ma_result ma_node_graph_set_profiling_enabled(ma_node_graph* pNodeGraph, ma_bool32 isEnabled);
+MA_API ma_bool32 ma_node_graph_is_profiling_enabled(const ma_node_graph* pNodeGraph);
+MA_API ma_result ma_node_graph_get_profile_json(ma_node_graph* pNodeGraph, char* pJSON, size_t jsonCap, size_t* pJSONLength);
+
+
+/* Offline rendering. Renders a node graph or engine as fast as possible to an encoder and/or a callback. */
+#ifndef MA_DEFAULT_OFFLINE_RENDER_BLOCK_SIZE_IN_FRAMES
+#define MA_DEFAULT_OFFLINE_RENDER_BLOCK_SIZE_IN_FRAMES  16384
+#endif
+
+typedef ma_result (* ma_offline_render_proc)(void* pUserData, const float* pFrames, ma_uint64 frameCount);
+
+typedef struct
+{
+    ma_uint64 frameCount;                   /* The total number of PCM frames to render. */
+    ma_uint32 sampleRate;                   /* Only used for reporting render speed relative to realtime. Ignored by ma_engine_render_offline() which always uses the engine's sample rate. */
+    ma_uint32 blockSizeInFrames;            /* The number of frames to render at a time before handing them to the output. Set to 0 to use MA_DEFAULT_OFFLINE_RENDER_BLOCK_SIZE_IN_FRAMES. */
+#ifndef MA_NO_ENCODING
+    ma_encoder* pEncoder;                   /* Can be null. Must have the same channel count as the graph. Frames are converted to the encoder's format if it isn't f32. */
+#endif
+    ma_offline_render_proc onOutput;        /* Can be null. Called with each block of f32 frames. Returning anything other than MA_SUCCESS aborts rendering. */
+    void* pOutputUserData;
+    ma_bool32 noPipelining;                 /* When set to true, output is written on the calling thread between blocks rather than on a separate thread while the next block is rendered. */
+    size_t outputThreadStackSize;
+} ma_offline_render_config;
+
+MA_API ma_offline_render_config ma_offline_render_config_init(ma_uint64 frameCount);
+
+typedef struct
+{
+    ma_uint64 framesRendered;               /* The number of frames that were rendered and handed to the output. */
+    double timeInSeconds;                   /* The wall clock time taken to render and write every frame. */
+    double realtimeMultiple;                /* How many times faster than realtime rendering ran. Set to 0 if the sample rate is unknown or the time was too short to measure. */
+} ma_offline_render_stats;
+
+MA_API ma_result ma_node_graph_render_offline(ma_node_graph* pNodeGraph, const ma_offline_render_config* pConfig, ma_offline_render_stats* pStats);
 
 
 
@@ -11000,6 +11851,25 @@ MA_API void ma_delay_node_set_dry(ma_delay_node* pDelayNode, float value);
 MA_API float ma_delay_node_get_dry(const ma_delay_node* pDelayNode);
 MA_API void ma_delay_node_set_decay(ma_delay_node* pDelayNode, float value);
 MA_API float ma_delay_node_get_decay(const ma_delay_node* pDelayNode);
+
+
+typedef struct
+{
+    ma_node_config nodeConfig;
+    ma_ambisonic_decoder_config decoder;
+} ma_ambisonic_decoder_node_config;
+
+MA_API ma_ambisonic_decoder_node_config ma_ambisonic_decoder_node_config_init(ma_uint32 order, ma_uint32 channelsOut, const ma_channel* pChannelMapOut);
+
+
+typedef struct
+{
+    ma_node_base baseNode;
+    ma_ambisonic_decoder decoder;
+} ma_ambisonic_decoder_node;
+
+MA_API ma_result ma_ambisonic_decoder_node_init(ma_node_graph* pNodeGraph, const ma_ambisonic_decoder_node_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_ambisonic_decoder_node* pDecoderNode);
+MA_API void ma_ambisonic_decoder_node_uninit(ma_ambisonic_decoder_node* pDecoderNode, const ma_allocation_callbacks* pAllocationCallbacks);
 #endif  /* MA_NO_NODE_GRAPH */
 
 
@@ -11034,7 +11904,18 @@ typedef enum
 #define MA_ENGINE_MAX_LISTENERS             4
 #endif
 
+#ifndef MA_ENGINE_MAX_SAMPLE_RATE_GROUPS
+#define MA_ENGINE_MAX_SAMPLE_RATE_GROUPS    8
+#endif
+
+#define MA_SAMPLE_RATE_GROUP_STATE_EMPTY        0
+#define MA_SAMPLE_RATE_GROUP_STATE_INITIALIZING 1
+#define MA_SAMPLE_RATE_GROUP_STATE_READY        2
+
 #define MA_LISTENER_INDEX_CLOSEST           ((ma_uint8)-1)
+#define MA_SPATIALIZER_BATCH_INDEX_NONE     ((ma_uint32)-1)
+
+#define MA_SOUND_PRIORITY_DEFAULT           128     /* Priorities range from 0 to 255. Higher priority sounds are kept real ahead of lower priority ones when the engine's real sound limit is exceeded. */
 
 typedef enum
 {
@@ -11042,18 +11923,29 @@ typedef enum
     ma_engine_node_type_group
 } ma_engine_node_type;
 
+/* The level of detail a spatialized sound is processed at. See lodReducedDistance and lodMinimalDistance in ma_engine_config. */
+typedef enum
+{
+    ma_sound_lod_full = 0,      /* Everything is processed. */
+    ma_sound_lod_reduced,       /* No doppler, and small changes in the spatialization gains are ignored. */
+    ma_sound_lod_minimal        /* As above, and sounds with more than one channel are resampled in mono. */
+} ma_sound_lod;
+
 typedef struct
 {
     ma_engine* pEngine;
     ma_engine_node_type type;
     ma_uint32 channelsIn;
     ma_uint32 channelsOut;
-    ma_uint32 sampleRate;               /* Only used when the type is set to ma_engine_node_type_sound. */
+    ma_uint32 sampleRate;               /* The sample rate of the input. For sounds this is the data source's sample rate. For groups this is the rate attached sounds are mixed at. Set to 0 to use the engine's sample rate. */
+    ma_uint32 sampleRateOut;            /* The sample rate of the node the output is attached to. Set to 0 to use the engine's sample rate. */
     ma_uint32 volumeSmoothTimeInPCMFrames;  /* The number of frames to smooth over volume changes. Defaults to 0 in which case no smoothing is used. */
     ma_mono_expansion_mode monoExpansionMode;
     ma_bool8 isPitchDisabled;           /* Pitching can be explicitly disabled with MA_SOUND_FLAG_NO_PITCH to optimize processing. */
     ma_bool8 isSpatializationDisabled;  /* Spatialization can be explicitly disabled with MA_SOUND_FLAG_NO_SPATIALIZATION. */
     ma_uint8 pinnedListenerIndex;       /* The index of the listener this node should always use for spatialization. If set to MA_LISTENER_INDEX_CLOSEST the engine will use the closest listener. */
+    ma_uint8 priority;                  /* Only used when the type is set to ma_engine_node_type_sound. Defaults to MA_SOUND_PRIORITY_DEFAULT. */
+    ma_uint32 ambisonicOrder;           /* When non-zero, spatialization encodes to ambisonic B-format of this order. channelsOut must be set to ma_ambisonic_get_channel_count(ambisonicOrder). */
 } ma_engine_node_config;
 
 MA_API ma_engine_node_config ma_engine_node_config_init(ma_engine* pEngine, ma_engine_node_type type, ma_uint32 flags);
@@ -11065,6 +11957,7 @@ typedef struct
     ma_node_base baseNode;                              /* Must be the first member for compatiblity with the ma_node API. */
     ma_engine* pEngine;                                 /* A pointer to the engine. Set based on the value from the config. */
     ma_uint32 sampleRate;                               /* The sample rate of the input data. For sounds backed by a data source, this will be the data source's sample rate. Otherwise it'll be the engine's sample rate. */
+    ma_uint32 sampleRateOut;                            /* The sample rate the output is mixed at. This will be the engine's sample rate unless the node was initially attached to a group with a different sample rate. */
     ma_uint32 volumeSmoothTimeInPCMFrames;
     ma_mono_expansion_mode monoExpansionMode;
     ma_fader fader;
@@ -11076,9 +11969,23 @@ typedef struct
     MA_ATOMIC(4, float) pitch;
     float oldPitch;                                     /* For determining whether or not the resampler needs to be updated to reflect the new pitch. The resampler will be updated on the mixing thread. */
     float oldDopplerPitch;                              /* For determining whether or not the resampler needs to be updated to take a new doppler pitch into account. */
+    float dopplerWeight;                                /* How much of the doppler effect to apply. Faded out at reduced levels of detail. Only accessed by the audio thread. */
+    ma_uint64 dopplerWeightTime;                        /* The local time of the node when dopplerWeight was last updated. Only accessed by the audio thread. */
     MA_ATOMIC(4, ma_bool32) isPitchDisabled;            /* When set to true, pitching will be disabled which will allow the resampler to be bypassed to save some computation. */
     MA_ATOMIC(4, ma_bool32) isSpatializationDisabled;   /* Set to false by default. When set to false, will not have spatialisation applied. */
     MA_ATOMIC(4, ma_uint32) pinnedListenerIndex;        /* The index of the listener this node should always use for spatialization. If set to MA_LISTENER_INDEX_CLOSEST the engine will use the closest listener. */
+    MA_ATOMIC(4, ma_uint32) priority;                   /* Only used by sounds. Between 0 and 255. Used for deciding which sounds to virtualize when the engine has a limit on the number of real sounds. */
+    MA_ATOMIC(4, ma_bool32) isVirtual;                  /* Set by the audio thread when the sound is being virtualized. A virtual sound advances its cursor without running any effects. */
+    ma_uint32 virtualizationEpoch;                      /* The engine's virtualization epoch at the time isVirtual was last decided. Only accessed by the audio thread. */
+    float virtualizationGain;                           /* Used for fading out before going virtual, and fading in after becoming real. 1 is fully real, 0 is fully virtual. Only accessed by the audio thread. */
+    ma_uint32 ambisonicOrder;                           /* When non-zero, the output of the node is ambisonic B-format which is rendered to the device by the engine's ambisonic bus. */
+    MA_ATOMIC(4, ma_uint32) spatializerBatchIndex;      /* The slot of this node in the engine's spatializer batch, or MA_SPATIALIZER_BATCH_INDEX_NONE if the node is spatialized on its own. Only changed by whichever thread owns the batch. */
+    MA_ATOMIC(4, ma_uint32) spatializerBatchRequest;    /* A pending MA_SPATIALIZER_BATCH_REQUEST_* for the engine to apply, or 0 if there's nothing pending. */
+    void* pNextSpatializerBatchRequest;                 /* The next ma_engine_node in the engine's list of pending batch requests. */
+    MA_ATOMIC(4, ma_uint32) lod;                        /* A ma_sound_lod value. Set by the audio thread. */
+    ma_uint32 lodEpoch;                                 /* The engine's LOD epoch at the time the level of detail was last decided. Only accessed by the audio thread. */
+    ma_bool32 isMonoResampling;                         /* Whether or not the resampler is currently running in mono. Only accessed by the audio thread. */
+    float monoWidth;                                    /* Used for narrowing the stereo image before switching to mono resampling, and widening it after switching back. 1 is full width, 0 is mono. Only accessed by the audio thread. */
 
     /* When setting a fade, it's not done immediately in ma_sound_set_fade(). It's deferred to the audio thread which means we need to store the settings here. */
     struct
@@ -11117,6 +12024,8 @@ typedef struct
     ma_mono_expansion_mode monoExpansionMode;   /* Controls how the mono channel should be expanded to other channels when spatialization is disabled on a sound. */
     ma_uint32 flags;                            /* A combination of MA_SOUND_FLAG_* flags. */
     ma_uint32 volumeSmoothTimeInPCMFrames;      /* The number of frames to smooth over volume changes. Defaults to 0 in which case no smoothing is used. */
+    ma_uint8 priority;                          /* Between 0 and 255. Used for deciding which sounds to virtualize when the engine's maxRealSoundCount is exceeded. Defaults to MA_SOUND_PRIORITY_DEFAULT. Ignored for groups. */
+    ma_uint32 sampleRate;                       /* Only used for groups. The sample rate that sounds attached to the group are mixed at. The mix is then resampled to the engine's sample rate in one pass. Set to 0 (default) to use the engine's sample rate. */
     ma_uint64 initialSeekPointInPCMFrames;      /* Initializes the sound such that it's seeked to this location by default. */
     ma_uint64 rangeBegInPCMFrames;
     ma_uint64 rangeEndInPCMFrames;
@@ -11160,8 +12069,43 @@ struct ma_sound_inlined
     ma_sound sound;
     ma_sound_inlined* pNext;
     ma_sound_inlined* pPrev;
+
+    /* The members below are only used by sounds in the engine's inlined sound pool. */
+    MA_ATOMIC(4, ma_uint32) poolState;      /* One of the MA_INLINED_SOUND_POOL_STATE_* values. */
+    MA_ATOMIC(4, ma_uint32) poolNameHash;   /* The hash of the file path of the sound that's loaded into this slot. Used for finding a slot that can be restarted without reloading. */
+    MA_ATOMIC(8, ma_uint64) poolPlayOrder;  /* Used for finding the oldest sound when stealing. */
+    ma_bool32 isPoolSoundInitialized;       /* Only accessed by the thread that owns the slot. */
+    char* pPoolFilePath;                    /* Only accessed by the thread that owns the slot. The hash is only a hint so this is what decides whether or not the slot can be restarted. */
 };
 
+/* What to do when ma_engine_play_sound() is called while every sound in the engine's inlined sound pool is playing. */
+typedef enum
+{
+    ma_inlined_sound_steal_policy_none = 0,     /* Don't steal. ma_engine_play_sound() will return MA_NO_SPACE. */
+    ma_inlined_sound_steal_policy_oldest,       /* Stop the sound that was started the longest time ago. */
+    ma_inlined_sound_steal_policy_quietest      /* Stop the sound with the lowest volume. Ties go to the oldest. */
+} ma_inlined_sound_steal_policy;
+
+typedef struct
+{
+    ma_uint32 capacity;                 /* The number of sounds in the pool. */
+    ma_uint32 activeCount;              /* The number of sounds currently playing. */
+    ma_uint32 peakActiveCount;          /* The highest activeCount has been since the engine was initialized. */
+    ma_uint64 playCount;                /* The number of sounds that have been successfully started from the pool. */
+    ma_uint64 reuseCount;               /* The number of times a slot already holding the same sound was restarted without being reinitialized. */
+    ma_uint64 stealCount;               /* The number of playing sounds that were stopped to make room for a new one. */
+    ma_uint64 rejectCount;              /* The number of times ma_engine_play_sound() failed because the pool was full and stealing is disabled. */
+} ma_inlined_sound_pool_stats;
+
+/* The spatial state of a single sound for use with ma_engine_acquire_sound_transforms(). */
+typedef struct
+{
+    ma_sound* pSound;
+    ma_vec3f position;
+    ma_vec3f direction;
+    ma_vec3f velocity;
+} ma_sound_transform;
+
 /* A sound group is just a sound. */
 typedef ma_sound_config ma_sound_group_config;
 typedef ma_sound        ma_sound_group;
@@ -11199,6 +12143,19 @@ typedef struct
     ma_vfs* pResourceManagerVFS;                    /* A pointer to a pre-allocated VFS object to use with the resource manager. This is ignored if pResourceManager is not NULL. */
     ma_engine_process_proc onProcess;               /* Fired at the end of each call to ma_engine_read_pcm_frames(). For engine's that manage their own internal device (the default configuration), this will be fired from the audio thread, and you do not need to call ma_engine_read_pcm_frames() manually in order to trigger this. */
     void* pProcessUserData;                         /* User data that's passed into onProcess. */
+    ma_uint32 nodeGraphJobThreadCount;              /* The number of worker threads to use for processing sounds and groups that are attached directly to the endpoint in parallel. Defaults to 0 which means everything is processed on the audio thread. See ma_node_graph_config. */
+    ma_uint32 inlinedSoundPoolCapacity;             /* When set to something other than 0, sounds played with ma_engine_play_sound() come from a fixed size pool that's allocated in ma_engine_init() rather than being allocated on demand. */
+    ma_inlined_sound_steal_policy inlinedSoundStealPolicy;  /* What to do when every sound in the inlined sound pool is playing. Only used when inlinedSoundPoolCapacity is non-zero. */
+    ma_uint32 maxRealSoundCount;                    /* The maximum number of sounds that are fully processed at a time. Sounds beyond this are made virtual, starting with the lowest priority and quietest. Defaults to 0 which means no limit. */
+    float virtualizationThreshold;                  /* Sounds whose estimated gain is below this linear value are made virtual. Defaults to 0 which disables audibility based virtualization. */
+    ma_bool32 groupSoundsBySampleRate;              /* When set to true, sounds that would be attached to the endpoint and have a different sample rate to the engine are attached to a group running at their sample rate instead, so that sample rate conversion is done once per group rather than once per sound. */
+    ma_uint32 ambisonicOrder;                       /* When set to something other than 0, spatialized sounds are encoded to an ambisonic bus of this order (1 to MA_AMBISONIC_MAX_ORDER) which is decoded to the device's channel map in one pass. Defaults to 0. */
+    ma_uint32 spatializerBatchCapacity;             /* When set to something other than 0, the spatial parameters of up to this many spatialized sounds are calculated together in a single pass at the start of each call to ma_engine_read_pcm_frames(). Sounds beyond this are spatialized individually. Defaults to 0. */
+    ma_uint32 soundTransformCapacity;               /* The maximum number of transforms that can be submitted at once with ma_engine_acquire_sound_transforms(). Defaults to 0 which disables bulk transform updates. */
+    float lodReducedDistance;                       /* Spatialized sounds further than this from their listener are processed at ma_sound_lod_reduced. Defaults to 0 which disables distance based LOD. */
+    float lodMinimalDistance;                       /* Spatialized sounds further than this from their listener are processed at ma_sound_lod_minimal. Defaults to 0. */
+    float lodReducedGain;                           /* Spatialized sounds whose estimated gain is below this linear value are processed at ma_sound_lod_reduced. Defaults to 0 which disables gain based LOD. */
+    float lodMinimalGain;                           /* Spatialized sounds whose estimated gain is below this linear value are processed at ma_sound_lod_minimal. Defaults to 0. */
 } ma_engine_config;
 
 MA_API ma_engine_config ma_engine_config_init(void);
@@ -11223,6 +12180,49 @@ struct ma_engine
     ma_spinlock inlinedSoundLock;               /* For synchronizing access so the inlined sound list. */
     ma_sound_inlined* pInlinedSoundHead;        /* The first inlined sound. Inlined sounds are tracked in a linked list. */
     MA_ATOMIC(4, ma_uint32) inlinedSoundCount;  /* The total number of allocated inlined sound objects. Used for debugging. */
+    ma_sound_inlined* pInlinedSoundPool;        /* Only used when inlinedSoundPoolCapacity is non-zero, in which case inlined sounds come from here rather than the linked list above. */
+    ma_uint32 inlinedSoundPoolCapacity;
+    ma_inlined_sound_steal_policy inlinedSoundStealPolicy;
+    MA_ATOMIC(8, ma_uint64) inlinedSoundPoolPlayCount;
+    MA_ATOMIC(8, ma_uint64) inlinedSoundPoolReuseCount;
+    MA_ATOMIC(8, ma_uint64) inlinedSoundPoolStealCount;
+    MA_ATOMIC(8, ma_uint64) inlinedSoundPoolRejectCount;
+    MA_ATOMIC(4, ma_uint32) inlinedSoundPoolActiveCount;
+    MA_ATOMIC(4, ma_uint32) inlinedSoundPoolPeakActiveCount;
+    ma_uint32 maxRealSoundCount;                /* When non-zero, sounds beyond this count are made virtual. */
+    float virtualizationThreshold;              /* Sounds with an estimated gain below this are made virtual. */
+    ma_uint32* pVirtualizationHistogram;        /* The number of sounds at each priority/audibility key during the current epoch. Only allocated when maxRealSoundCount is non-zero. */
+    MA_ATOMIC(4, ma_uint32) virtualizationEpoch;        /* Incremented at the start of each call to ma_engine_read_pcm_frames(). */
+    MA_ATOMIC(4, ma_uint32) virtualizationThresholdKey; /* Sounds with a key above this are real. Sounds with a key equal to this are real if there's room in the tie budget. */
+    MA_ATOMIC(4, ma_int32)  virtualizationTieBudget;
+    MA_ATOMIC(4, ma_uint32) realSoundCount;             /* The number of real sounds counted so far in the current epoch. */
+    MA_ATOMIC(4, ma_uint32) virtualSoundCount;
+    MA_ATOMIC(4, ma_uint32) lastRealSoundCount;         /* The number of real sounds in the previous epoch. Returned by ma_engine_get_real_sound_count(). */
+    MA_ATOMIC(4, ma_uint32) lastVirtualSoundCount;
+    ma_bool32 groupSoundsBySampleRate;
+    ma_spinlock sampleRateGroupLock;            /* For synchronizing access to the rates and states of the sample rate groups below. Never held while a group is being initialized. */
+    ma_sound_group* pSampleRateGroups;          /* Only allocated when groupSoundsBySampleRate is enabled. Groups are initialized on demand the first time a sound of a given rate is initialized. */
+    ma_uint32 sampleRateGroupRates[MA_ENGINE_MAX_SAMPLE_RATE_GROUPS];   /* The sample rate of each slot in pSampleRateGroups. */
+    ma_uint32 sampleRateGroupStates[MA_ENGINE_MAX_SAMPLE_RATE_GROUPS];  /* A MA_SAMPLE_RATE_GROUP_STATE_* value for each slot in pSampleRateGroups. */
+    ma_uint32 ambisonicOrder;                   /* When non-zero, ambisonicBus is initialized and attached to the endpoint. */
+    ma_ambisonic_decoder_node ambisonicBus;
+    ma_spatializer_batch spatializerBatch;      /* Only initialized when spatializerBatchCapacity is non-zero. Only accessed by whichever thread owns the batch. See spatializerBatchState. */
+    ma_engine_node** ppSpatializerBatchNodes;   /* The node in each slot of the spatializer batch. */
+    MA_ATOMIC(MA_SIZEOF_PTR, void*) pSpatializerBatchRequests; /* A lock-free stack of ma_engine_node objects waiting to be added to or removed from the batch. */
+    MA_ATOMIC(4, ma_uint32) spatializerBatchState;  /* MA_SPATIALIZER_BATCH_STATE_* flags for deciding which thread owns the batch. */
+    ma_bool32 isSpatializerBatchInUse;          /* Whether or not the batch can be used by sounds during the current call to ma_engine_read_pcm_frames(). Only accessed by the audio thread. */
+    ma_sound_transform* pSoundTransforms;       /* Three blocks of soundTransformCapacity transforms. One is written by the updating thread, one is owned by the audio thread and the third is handed between them. */
+    ma_uint32 soundTransformCapacity;
+    ma_uint32 soundTransformCounts[3];          /* The number of transforms in each block. Only accessed by whichever thread owns the block. */
+    ma_uint32 soundTransformWriteBlock;         /* The index of the block that's owned by the updating thread. */
+    ma_uint32 soundTransformReadBlock;          /* The index of the block that's owned by the audio thread. */
+    MA_ATOMIC(4, ma_uint32) soundTransformState;            /* The index of the block being handed over, plus the MA_SOUND_TRANSFORM_STATE_* flags. */
+    MA_ATOMIC(4, ma_uint32) soundTransformReadGeneration;   /* Odd while the audio thread is taking or applying a block. */
+    float lodReducedDistance;
+    float lodMinimalDistance;
+    float lodReducedGain;
+    float lodMinimalGain;
+    MA_ATOMIC(4, ma_uint32) lodEpoch;           /* Incremented at the start of each call to ma_engine_read_pcm_frames() when LOD is enabled. */
     ma_uint32 gainSmoothTimeInFrames;           /* The number of frames to interpolate the gain of spatialized sounds across. */
     ma_uint32 defaultVolumeSmoothTimeInPCMFrames;
     ma_mono_expansion_mode monoExpansionMode;
@@ -11233,6 +12233,7 @@ struct ma_engine
 MA_API ma_result ma_engine_init(const ma_engine_config* pConfig, ma_engine* pEngine);
 MA_API void ma_engine_uninit(ma_engine* pEngine);
 MA_API ma_result ma_engine_read_pcm_frames(ma_engine* pEngine, void* pFramesOut, ma_uint64 frameCount, ma_uint64* pFramesRead);
+MA_API ma_result ma_engine_render_offline(ma_engine* pEngine, const ma_offline_render_config* pConfig, ma_offline_render_stats* pStats);
 MA_API ma_node_graph* ma_engine_get_node_graph(ma_engine* pEngine);
 #if !defined(MA_NO_RESOURCE_MANAGER)
 MA_API ma_resource_manager* ma_engine_get_resource_manager(ma_engine* pEngine);
@@ -11273,8 +12274,16 @@ MA_API ma_bool32 ma_engine_listener_is_enabled(const ma_engine* pEngine, ma_uint
 
 #ifndef MA_NO_RESOURCE_MANAGER
 MA_API ma_result ma_engine_play_sound_ex(ma_engine* pEngine, const char* pFilePath, ma_node* pNode, ma_uint32 nodeInputBusIndex);
+MA_API ma_result ma_engine_play_sound_with_volume(ma_engine* pEngine, const char* pFilePath, ma_node* pNode, ma_uint32 nodeInputBusIndex, float volume);
 MA_API ma_result ma_engine_play_sound(ma_engine* pEngine, const char* pFilePath, ma_sound_group* pGroup);   /* Fire and forget. */
 #endif
+MA_API ma_result ma_engine_get_inlined_sound_pool_stats(const ma_engine* pEngine, ma_inlined_sound_pool_stats* pStats);
+MA_API ma_uint32 ma_engine_get_real_sound_count(const ma_engine* pEngine);
+MA_API ma_uint32 ma_engine_get_virtual_sound_count(const ma_engine* pEngine);
+MA_API ma_sound_group* ma_engine_get_sample_rate_group(ma_engine* pEngine, ma_uint32 sampleRate);
+MA_API ma_node* ma_engine_get_ambisonic_bus(ma_engine* pEngine);
+MA_API ma_result ma_engine_acquire_sound_transforms(ma_engine* pEngine, ma_sound_transform** ppTransforms, ma_uint32* pCapacity);
+MA_API ma_result ma_engine_commit_sound_transforms(ma_engine* pEngine, ma_uint32 count);
 
 #ifndef MA_NO_RESOURCE_MANAGER
 MA_API ma_result ma_sound_init_from_file(ma_engine* pEngine, const char* pFilePath, ma_uint32 flags, ma_sound_group* pGroup, ma_fence* pDoneFence, ma_sound* pSound);
@@ -11304,6 +12313,10 @@ MA_API void ma_sound_set_pinned_listener_index(ma_sound* pSound, ma_uint32 liste
 MA_API ma_uint32 ma_sound_get_pinned_listener_index(const ma_sound* pSound);
 MA_API ma_uint32 ma_sound_get_listener_index(const ma_sound* pSound);
 MA_API ma_vec3f ma_sound_get_direction_to_listener(const ma_sound* pSound);
+MA_API void ma_sound_set_priority(ma_sound* pSound, ma_uint8 priority);
+MA_API ma_uint8 ma_sound_get_priority(const ma_sound* pSound);
+MA_API ma_bool32 ma_sound_is_virtual(const ma_sound* pSound);
+MA_API ma_sound_lod ma_sound_get_lod(const ma_sound* pSound);
 MA_API void ma_sound_set_position(ma_sound* pSound, float x, float y, float z);
 MA_API ma_vec3f ma_sound_get_position(const ma_sound* pSound);
 MA_API void ma_sound_set_direction(ma_sound* pSound, float x, float y, float z);
@@ -11359,6 +12372,7 @@ MA_API ma_result ma_sound_group_init(ma_engine* pEngine, ma_uint32 flags, ma_sou
 MA_API ma_result ma_sound_group_init_ex(ma_engine* pEngine, const ma_sound_group_config* pConfig, ma_sound_group* pGroup);
 MA_API void ma_sound_group_uninit(ma_sound_group* pGroup);
 MA_API ma_engine* ma_sound_group_get_engine(const ma_sound_group* pGroup);
+MA_API ma_uint32 ma_sound_group_get_sample_rate(const ma_sound_group* pGroup);
 MA_API ma_result ma_sound_group_start(ma_sound_group* pGroup);
 MA_API ma_result ma_sound_group_stop(ma_sound_group* pGroup);
 MA_API void ma_sound_group_set_volume(ma_sound_group* pGroup, float volume);
@@ -11478,6 +12492,25 @@ IMPLEMENTATION
 #include <pthread.h>
 #endif
 
+/* For parking node graph worker threads. */
+#if defined(MA_LINUX) && !defined(MA_NO_THREADING)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#if defined(SYS_futex) && defined(FUTEX_WAIT_PRIVATE) && defined(FUTEX_WAKE_PRIVATE)
+#define MA_HAS_FUTEX
+#if defined(__STRICT_ANSI__) && !defined(__cplusplus)
+/* syscall() is still there in strict ANSI mode, it's just not declared. C++ compilers always enable the GNU extensions so this is only needed for C. */
+extern long syscall(long number, ...);
+#endif
+#endif
+#endif
+
+#if defined(MA_APPLE) && !defined(MA_NO_THREADING)
+#include <mach/mach.h>
+#define MA_HAS_MACH_SEMAPHORE
+#endif
+
 #ifdef MA_NX
 #include <time.h>       /* For nanosleep() */
 #endif
@@ -14018,6 +15051,27 @@ static MA_INLINE ma_int32 ma_dither_s32(ma_dither_mode ditherMode, ma_int32 dith
     return 0;
 }
 
+/*
+The random number generator is serial so dither values are always generated one at a time in sample order. This is used by the
+SIMD format conversion routines to generate a batch of dither up front so it can be applied with vector instructions while
+still producing exactly the same output as the reference implementations.
+*/
+static MA_INLINE void ma_dither_f32_array(ma_dither_mode ditherMode, float ditherMin, float ditherMax, float* pDither, ma_uint32 count)
+{
+    ma_uint32 i;
+    for (i = 0; i < count; i += 1) {
+        pDither[i] = ma_dither_f32(ditherMode, ditherMin, ditherMax);
+    }
+}
+
+static MA_INLINE void ma_dither_s32_array(ma_dither_mode ditherMode, ma_int32 ditherMin, ma_int32 ditherMax, ma_int32* pDither, ma_uint32 count)
+{
+    ma_uint32 i;
+    for (i = 0; i < count; i += 1) {
+        pDither[i] = ma_dither_s32(ditherMode, ditherMin, ditherMax);
+    }
+}
+
 
 /**************************************************************************************************************************************************************
 
@@ -17923,12 +18977,126 @@ DEVICE I/O
     #endif
 #endif
 
-#ifndef MA_NO_DEVICE_IO
-
+#if !defined(MA_NO_DEVICE_IO) || !defined(MA_NO_NODE_GRAPH)
 #if defined(MA_APPLE) && (__MAC_OS_X_VERSION_MIN_REQUIRED < 101200)
     #include <mach/mach_time.h> /* For mach_absolute_time() */
 #endif
 
+/*******************************************************************************
+
+Timing
+
+*******************************************************************************/
+#if defined(MA_WIN32) && !defined(MA_POSIX)
+    static LARGE_INTEGER g_ma_TimerFrequency;   /* <-- Initialized to zero since it's static. */
+    static void ma_timer_init(ma_timer* pTimer)
+    {
+        LARGE_INTEGER counter;
+
+        if (g_ma_TimerFrequency.QuadPart == 0) {
+            QueryPerformanceFrequency(&g_ma_TimerFrequency);
+        }
+
+        QueryPerformanceCounter(&counter);
+        pTimer->counter = counter.QuadPart;
+    }
+
+    static double ma_timer_get_time_in_seconds(ma_timer* pTimer)
+    {
+        LARGE_INTEGER counter;
+        if (!QueryPerformanceCounter(&counter)) {
+            return 0;
+        }
+
+        return (double)(counter.QuadPart - pTimer->counter) / g_ma_TimerFrequency.QuadPart;
+    }
+#elif defined(MA_APPLE) && (__MAC_OS_X_VERSION_MIN_REQUIRED < 101200)
+    static ma_uint64 g_ma_TimerFrequency = 0;
+    static void ma_timer_init(ma_timer* pTimer)
+    {
+        mach_timebase_info_data_t baseTime;
+        mach_timebase_info(&baseTime);
+        g_ma_TimerFrequency = (baseTime.denom * 1e9) / baseTime.numer;
+
+        pTimer->counter = mach_absolute_time();
+    }
+
+    static double ma_timer_get_time_in_seconds(ma_timer* pTimer)
+    {
+        ma_uint64 newTimeCounter = mach_absolute_time();
+        ma_uint64 oldTimeCounter = pTimer->counter;
+
+        return (newTimeCounter - oldTimeCounter) / g_ma_TimerFrequency;
+    }
+#elif defined(MA_EMSCRIPTEN)
+    static MA_INLINE void ma_timer_init(ma_timer* pTimer)
+    {
+        pTimer->counterD = emscripten_get_now();
+    }
+
+    static MA_INLINE double ma_timer_get_time_in_seconds(ma_timer* pTimer)
+    {
+        return (emscripten_get_now() - pTimer->counterD) / 1000;    /* Emscripten is in milliseconds. */
+    }
+#else
+    #if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 199309L
+        #if defined(CLOCK_MONOTONIC)
+            #define MA_CLOCK_ID CLOCK_MONOTONIC
+        #else
+            #define MA_CLOCK_ID CLOCK_REALTIME
+        #endif
+
+        static void ma_timer_init(ma_timer* pTimer)
+        {
+            struct timespec newTime;
+            clock_gettime(MA_CLOCK_ID, &newTime);
+
+            pTimer->counter = (newTime.tv_sec * 1000000000) + newTime.tv_nsec;
+        }
+
+        static double ma_timer_get_time_in_seconds(ma_timer* pTimer)
+        {
+            ma_uint64 newTimeCounter;
+            ma_uint64 oldTimeCounter;
+
+            struct timespec newTime;
+            clock_gettime(MA_CLOCK_ID, &newTime);
+
+            newTimeCounter = (newTime.tv_sec * 1000000000) + newTime.tv_nsec;
+            oldTimeCounter = pTimer->counter;
+
+            return (newTimeCounter - oldTimeCounter) / 1000000000.0;
+        }
+    #else
+        static void ma_timer_init(ma_timer* pTimer)
+        {
+            struct timeval newTime;
+            gettimeofday(&newTime, NULL);
+
+            pTimer->counter = (newTime.tv_sec * 1000000) + newTime.tv_usec;
+        }
+
+        static double ma_timer_get_time_in_seconds(ma_timer* pTimer)
+        {
+            ma_uint64 newTimeCounter;
+            ma_uint64 oldTimeCounter;
+
+            struct timeval newTime;
+            gettimeofday(&newTime, NULL);
+
+            newTimeCounter = (newTime.tv_sec * 1000000) + newTime.tv_usec;
+            oldTimeCounter = pTimer->counter;
+
+            return (newTimeCounter - oldTimeCounter) / 1000000.0;
+        }
+    #endif
+#endif
+#endif  /* !MA_NO_DEVICE_IO || !MA_NO_NODE_GRAPH */
+
+
+
+#ifndef MA_NO_DEVICE_IO
+
 #ifdef MA_POSIX
     #include <sys/types.h>
     #include <unistd.h>
@@ -18459,118 +19627,6 @@ MA_API int ma_strcpy_s_WCHAR(WCHAR* dst, size_t dstCap, const WCHAR* src)
 
 
 
-/*******************************************************************************
-
-Timing
-
-*******************************************************************************/
-#if defined(MA_WIN32) && !defined(MA_POSIX)
-    static LARGE_INTEGER g_ma_TimerFrequency;   /* <-- Initialized to zero since it's static. */
-    static void ma_timer_init(ma_timer* pTimer)
-    {
-        LARGE_INTEGER counter;
-
-        if (g_ma_TimerFrequency.QuadPart == 0) {
-            QueryPerformanceFrequency(&g_ma_TimerFrequency);
-        }
-
-        QueryPerformanceCounter(&counter);
-        pTimer->counter = counter.QuadPart;
-    }
-
-    static double ma_timer_get_time_in_seconds(ma_timer* pTimer)
-    {
-        LARGE_INTEGER counter;
-        if (!QueryPerformanceCounter(&counter)) {
-            return 0;
-        }
-
-        return (double)(counter.QuadPart - pTimer->counter) / g_ma_TimerFrequency.QuadPart;
-    }
-#elif defined(MA_APPLE) && (__MAC_OS_X_VERSION_MIN_REQUIRED < 101200)
-    static ma_uint64 g_ma_TimerFrequency = 0;
-    static void ma_timer_init(ma_timer* pTimer)
-    {
-        mach_timebase_info_data_t baseTime;
-        mach_timebase_info(&baseTime);
-        g_ma_TimerFrequency = (baseTime.denom * 1e9) / baseTime.numer;
-
-        pTimer->counter = mach_absolute_time();
-    }
-
-    static double ma_timer_get_time_in_seconds(ma_timer* pTimer)
-    {
-        ma_uint64 newTimeCounter = mach_absolute_time();
-        ma_uint64 oldTimeCounter = pTimer->counter;
-
-        return (newTimeCounter - oldTimeCounter) / g_ma_TimerFrequency;
-    }
-#elif defined(MA_EMSCRIPTEN)
-    static MA_INLINE void ma_timer_init(ma_timer* pTimer)
-    {
-        pTimer->counterD = emscripten_get_now();
-    }
-
-    static MA_INLINE double ma_timer_get_time_in_seconds(ma_timer* pTimer)
-    {
-        return (emscripten_get_now() - pTimer->counterD) / 1000;    /* Emscripten is in milliseconds. */
-    }
-#else
-    #if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 199309L
-        #if defined(CLOCK_MONOTONIC)
-            #define MA_CLOCK_ID CLOCK_MONOTONIC
-        #else
-            #define MA_CLOCK_ID CLOCK_REALTIME
-        #endif
-
-        static void ma_timer_init(ma_timer* pTimer)
-        {
-            struct timespec newTime;
-            clock_gettime(MA_CLOCK_ID, &newTime);
-
-            pTimer->counter = (newTime.tv_sec * 1000000000) + newTime.tv_nsec;
-        }
-
-        static double ma_timer_get_time_in_seconds(ma_timer* pTimer)
-        {
-            ma_uint64 newTimeCounter;
-            ma_uint64 oldTimeCounter;
-
-            struct timespec newTime;
-            clock_gettime(MA_CLOCK_ID, &newTime);
-
-            newTimeCounter = (newTime.tv_sec * 1000000000) + newTime.tv_nsec;
-            oldTimeCounter = pTimer->counter;
-
-            return (newTimeCounter - oldTimeCounter) / 1000000000.0;
-        }
-    #else
-        static void ma_timer_init(ma_timer* pTimer)
-        {
-            struct timeval newTime;
-            gettimeofday(&newTime, NULL);
-
-            pTimer->counter = (newTime.tv_sec * 1000000) + newTime.tv_usec;
-        }
-
-        static double ma_timer_get_time_in_seconds(ma_timer* pTimer)
-        {
-            ma_uint64 newTimeCounter;
-            ma_uint64 oldTimeCounter;
-
-            struct timeval newTime;
-            gettimeofday(&newTime, NULL);
-
-            newTimeCounter = (newTime.tv_sec * 1000000) + newTime.tv_usec;
-            oldTimeCounter = pTimer->counter;
-
-            return (newTimeCounter - oldTimeCounter) / 1000000.0;
-        }
-    #endif
-#endif
-
-
-
 #if 0
 static ma_uint32 ma_get_closest_standard_sample_rate(ma_uint32 sampleRateIn)
 {
@@ -40645,6 +41701,7 @@ static ma_result ma_device__post_init_setup(ma_device* pDevice, ma_device_type d
         converterConfig.allowDynamicSampleRate          = MA_FALSE;
         converterConfig.resampling.algorithm            = pDevice->resampling.algorithm;
         converterConfig.resampling.linear.lpfOrder      = pDevice->resampling.linear.lpfOrder;
+        converterConfig.resampling.polyphase.quality    = pDevice->resampling.polyphase.quality;
         converterConfig.resampling.pBackendVTable       = pDevice->resampling.pBackendVTable;
         converterConfig.resampling.pBackendUserData     = pDevice->resampling.pBackendUserData;
 
@@ -40675,6 +41732,7 @@ static ma_result ma_device__post_init_setup(ma_device* pDevice, ma_device_type d
         converterConfig.allowDynamicSampleRate          = MA_FALSE;
         converterConfig.resampling.algorithm            = pDevice->resampling.algorithm;
         converterConfig.resampling.linear.lpfOrder      = pDevice->resampling.linear.lpfOrder;
+        converterConfig.resampling.polyphase.quality    = pDevice->resampling.polyphase.quality;
         converterConfig.resampling.pBackendVTable       = pDevice->resampling.pBackendVTable;
         converterConfig.resampling.pBackendUserData     = pDevice->resampling.pBackendUserData;
 
@@ -41719,6 +42777,7 @@ MA_API ma_result ma_device_init(ma_context* pContext, const ma_device_config* pC
     pDevice->sampleRate                  = pConfig->sampleRate;
     pDevice->resampling.algorithm        = pConfig->resampling.algorithm;
     pDevice->resampling.linear.lpfOrder  = pConfig->resampling.linear.lpfOrder;
+    pDevice->resampling.polyphase.quality = pConfig->resampling.polyphase.quality;
     pDevice->resampling.pBackendVTable   = pConfig->resampling.pBackendVTable;
     pDevice->resampling.pBackendUserData = pConfig->resampling.pBackendUserData;
 
@@ -43056,6 +44115,165 @@ MA_API float ma_volume_db_to_linear(float gain)
 }
 
 
+#if defined(MA_SUPPORT_SSE2)
+static MA_INLINE ma_uint64 ma_mix_pcm_samples_f32__sse2(float* pDst, const float* pSrc, ma_uint64 sampleCount, float volume)
+{
+    ma_uint64 sampleCount8 = sampleCount & ~(ma_uint64)7;
+    ma_uint64 iSample;
+
+    if (volume == 1) {
+        for (iSample = 0; iSample < sampleCount8; iSample += 8) {
+            _mm_storeu_ps(pDst + iSample + 0, _mm_add_ps(_mm_loadu_ps(pDst + iSample + 0), _mm_loadu_ps(pSrc + iSample + 0)));
+            _mm_storeu_ps(pDst + iSample + 4, _mm_add_ps(_mm_loadu_ps(pDst + iSample + 4), _mm_loadu_ps(pSrc + iSample + 4)));
+        }
+    } else {
+        __m128 volume4 = _mm_set1_ps(volume);
+
+        for (iSample = 0; iSample < sampleCount8; iSample += 8) {
+            _mm_storeu_ps(pDst + iSample + 0, _mm_add_ps(_mm_loadu_ps(pDst + iSample + 0), _mm_mul_ps(_mm_loadu_ps(pSrc + iSample + 0), volume4)));
+            _mm_storeu_ps(pDst + iSample + 4, _mm_add_ps(_mm_loadu_ps(pDst + iSample + 4), _mm_mul_ps(_mm_loadu_ps(pSrc + iSample + 4), volume4)));
+        }
+    }
+
+    return sampleCount8;
+}
+
+static MA_INLINE ma_uint64 ma_mix_pcm_samples_multi_f32__sse2(float* pDst, const float** ppSrc, const float* pVolumes, ma_uint32 sourceCount, ma_uint64 sampleCount)
+{
+    ma_uint64 sampleCount8 = sampleCount & ~(ma_uint64)7;
+    ma_uint64 iSample;
+    ma_uint32 iSource;
+
+    for (iSample = 0; iSample < sampleCount8; iSample += 8) {
+        __m128 x0 = _mm_loadu_ps(pDst + iSample + 0);
+        __m128 x1 = _mm_loadu_ps(pDst + iSample + 4);
+
+        if (pVolumes == NULL) {
+            for (iSource = 0; iSource < sourceCount; iSource += 1) {
+                x0 = _mm_add_ps(x0, _mm_loadu_ps(ppSrc[iSource] + iSample + 0));
+                x1 = _mm_add_ps(x1, _mm_loadu_ps(ppSrc[iSource] + iSample + 4));
+            }
+        } else {
+            for (iSource = 0; iSource < sourceCount; iSource += 1) {
+                __m128 volume4 = _mm_set1_ps(pVolumes[iSource]);
+                x0 = _mm_add_ps(x0, _mm_mul_ps(_mm_loadu_ps(ppSrc[iSource] + iSample + 0), volume4));
+                x1 = _mm_add_ps(x1, _mm_mul_ps(_mm_loadu_ps(ppSrc[iSource] + iSample + 4), volume4));
+            }
+        }
+
+        _mm_storeu_ps(pDst + iSample + 0, x0);
+        _mm_storeu_ps(pDst + iSample + 4, x1);
+    }
+
+    return sampleCount8;
+}
+#endif
+
+#if defined(MA_SUPPORT_AVX2)
+static MA_INLINE ma_uint64 ma_mix_pcm_samples_f32__avx2(float* pDst, const float* pSrc, ma_uint64 sampleCount, float volume)
+{
+    ma_uint64 sampleCount16 = sampleCount & ~(ma_uint64)15;
+    ma_uint64 iSample;
+
+    if (volume == 1) {
+        for (iSample = 0; iSample < sampleCount16; iSample += 16) {
+            _mm256_storeu_ps(pDst + iSample + 0, _mm256_add_ps(_mm256_loadu_ps(pDst + iSample + 0), _mm256_loadu_ps(pSrc + iSample + 0)));
+            _mm256_storeu_ps(pDst + iSample + 8, _mm256_add_ps(_mm256_loadu_ps(pDst + iSample + 8), _mm256_loadu_ps(pSrc + iSample + 8)));
+        }
+    } else {
+        __m256 volume8 = _mm256_set1_ps(volume);
+
+        for (iSample = 0; iSample < sampleCount16; iSample += 16) {
+            _mm256_storeu_ps(pDst + iSample + 0, _mm256_add_ps(_mm256_loadu_ps(pDst + iSample + 0), _mm256_mul_ps(_mm256_loadu_ps(pSrc + iSample + 0), volume8)));
+            _mm256_storeu_ps(pDst + iSample + 8, _mm256_add_ps(_mm256_loadu_ps(pDst + iSample + 8), _mm256_mul_ps(_mm256_loadu_ps(pSrc + iSample + 8), volume8)));
+        }
+    }
+
+    return sampleCount16;
+}
+
+static MA_INLINE ma_uint64 ma_mix_pcm_samples_multi_f32__avx2(float* pDst, const float** ppSrc, const float* pVolumes, ma_uint32 sourceCount, ma_uint64 sampleCount)
+{
+    ma_uint64 sampleCount16 = sampleCount & ~(ma_uint64)15;
+    ma_uint64 iSample;
+    ma_uint32 iSource;
+
+    for (iSample = 0; iSample < sampleCount16; iSample += 16) {
+        __m256 x0 = _mm256_loadu_ps(pDst + iSample + 0);
+        __m256 x1 = _mm256_loadu_ps(pDst + iSample + 8);
+
+        if (pVolumes == NULL) {
+            for (iSource = 0; iSource < sourceCount; iSource += 1) {
+                x0 = _mm256_add_ps(x0, _mm256_loadu_ps(ppSrc[iSource] + iSample + 0));
+                x1 = _mm256_add_ps(x1, _mm256_loadu_ps(ppSrc[iSource] + iSample + 8));
+            }
+        } else {
+            for (iSource = 0; iSource < sourceCount; iSource += 1) {
+                __m256 volume8 = _mm256_set1_ps(pVolumes[iSource]);
+                x0 = _mm256_add_ps(x0, _mm256_mul_ps(_mm256_loadu_ps(ppSrc[iSource] + iSample + 0), volume8));
+                x1 = _mm256_add_ps(x1, _mm256_mul_ps(_mm256_loadu_ps(ppSrc[iSource] + iSample + 8), volume8));
+            }
+        }
+
+        _mm256_storeu_ps(pDst + iSample + 0, x0);
+        _mm256_storeu_ps(pDst + iSample + 8, x1);
+    }
+
+    return sampleCount16;
+}
+#endif
+
+#if defined(MA_SUPPORT_NEON)
+static MA_INLINE ma_uint64 ma_mix_pcm_samples_f32__neon(float* pDst, const float* pSrc, ma_uint64 sampleCount, float volume)
+{
+    ma_uint64 sampleCount8 = sampleCount & ~(ma_uint64)7;
+    ma_uint64 iSample;
+
+    if (volume == 1) {
+        for (iSample = 0; iSample < sampleCount8; iSample += 8) {
+            vst1q_f32(pDst + iSample + 0, vaddq_f32(vld1q_f32(pDst + iSample + 0), vld1q_f32(pSrc + iSample + 0)));
+            vst1q_f32(pDst + iSample + 4, vaddq_f32(vld1q_f32(pDst + iSample + 4), vld1q_f32(pSrc + iSample + 4)));
+        }
+    } else {
+        for (iSample = 0; iSample < sampleCount8; iSample += 8) {
+            vst1q_f32(pDst + iSample + 0, vaddq_f32(vld1q_f32(pDst + iSample + 0), vmulq_n_f32(vld1q_f32(pSrc + iSample + 0), volume)));
+            vst1q_f32(pDst + iSample + 4, vaddq_f32(vld1q_f32(pDst + iSample + 4), vmulq_n_f32(vld1q_f32(pSrc + iSample + 4), volume)));
+        }
+    }
+
+    return sampleCount8;
+}
+
+static MA_INLINE ma_uint64 ma_mix_pcm_samples_multi_f32__neon(float* pDst, const float** ppSrc, const float* pVolumes, ma_uint32 sourceCount, ma_uint64 sampleCount)
+{
+    ma_uint64 sampleCount8 = sampleCount & ~(ma_uint64)7;
+    ma_uint64 iSample;
+    ma_uint32 iSource;
+
+    for (iSample = 0; iSample < sampleCount8; iSample += 8) {
+        float32x4_t x0 = vld1q_f32(pDst + iSample + 0);
+        float32x4_t x1 = vld1q_f32(pDst + iSample + 4);
+
+        if (pVolumes == NULL) {
+            for (iSource = 0; iSource < sourceCount; iSource += 1) {
+                x0 = vaddq_f32(x0, vld1q_f32(ppSrc[iSource] + iSample + 0));
+                x1 = vaddq_f32(x1, vld1q_f32(ppSrc[iSource] + iSample + 4));
+            }
+        } else {
+            for (iSource = 0; iSource < sourceCount; iSource += 1) {
+                x0 = vaddq_f32(x0, vmulq_n_f32(vld1q_f32(ppSrc[iSource] + iSample + 0), pVolumes[iSource]));
+                x1 = vaddq_f32(x1, vmulq_n_f32(vld1q_f32(ppSrc[iSource] + iSample + 4), pVolumes[iSource]));
+            }
+        }
+
+        vst1q_f32(pDst + iSample + 0, x0);
+        vst1q_f32(pDst + iSample + 4, x1);
+    }
+
+    return sampleCount8;
+}
+#endif
+
 MA_API ma_result ma_mix_pcm_frames_f32(float* pDst, const float* pSrc, ma_uint64 frameCount, ma_uint32 channels, float volume)
 {
     ma_uint64 iSample;
@@ -43071,12 +44289,32 @@ MA_API ma_result ma_mix_pcm_frames_f32(float* pDst, const float* pSrc, ma_uint64
 
     sampleCount = frameCount * channels;
 
+    /* The SIMD paths return the number of samples they processed. Whatever is left over is done with the scalar path. */
+#if defined(MA_SUPPORT_AVX2)
+    if (ma_has_avx2()) {
+        iSample = ma_mix_pcm_samples_f32__avx2(pDst, pSrc, sampleCount, volume);
+    } else
+#endif
+#if defined(MA_SUPPORT_SSE2)
+    if (ma_has_sse2()) {
+        iSample = ma_mix_pcm_samples_f32__sse2(pDst, pSrc, sampleCount, volume);
+    } else
+#endif
+#if defined(MA_SUPPORT_NEON)
+    if (ma_has_neon()) {
+        iSample = ma_mix_pcm_samples_f32__neon(pDst, pSrc, sampleCount, volume);
+    } else
+#endif
+    {
+        iSample = 0;
+    }
+
     if (volume == 1) {
-        for (iSample = 0; iSample < sampleCount; iSample += 1) {
+        for (; iSample < sampleCount; iSample += 1) {
             pDst[iSample] += pSrc[iSample];
         }
     } else {
-        for (iSample = 0; iSample < sampleCount; iSample += 1) {
+        for (; iSample < sampleCount; iSample += 1) {
             pDst[iSample] += ma_apply_volume_unclipped_f32(pSrc[iSample], volume);
         }
     }
@@ -43084,6 +44322,76 @@ MA_API ma_result ma_mix_pcm_frames_f32(float* pDst, const float* pSrc, ma_uint64
     return MA_SUCCESS;
 }
 
+MA_API ma_result ma_mix_pcm_frames_multi_f32(float* pDst, const float** ppSrc, const float* pVolumes, ma_uint32 sourceCount, ma_uint64 frameCount, ma_uint32 channels)
+{
+    ma_uint64 iSample;
+    ma_uint64 sampleCount;
+    ma_uint32 iSource;
+
+    if (pDst == NULL || ppSrc == NULL || channels == 0) {
+        return MA_INVALID_ARGS;
+    }
+
+    for (iSource = 0; iSource < sourceCount; iSource += 1) {
+        if (ppSrc[iSource] == NULL) {
+            return MA_INVALID_ARGS;
+        }
+    }
+
+    if (sourceCount == 0) {
+        return MA_SUCCESS;
+    }
+
+    /* Don't bother with the multi-source loop if there's only a single source. */
+    if (sourceCount == 1) {
+        return ma_mix_pcm_frames_f32(pDst, ppSrc[0], frameCount, channels, (pVolumes != NULL) ? pVolumes[0] : 1);
+    }
+
+    sampleCount = frameCount * channels;
+
+    /*
+    Sources are accumulated in order for each sample which means the result is exactly the same as
+    calling ma_mix_pcm_frames_f32() once for each source. The difference is that the destination
+    buffer is only read and written once.
+    */
+#if defined(MA_SUPPORT_AVX2)
+    if (ma_has_avx2()) {
+        iSample = ma_mix_pcm_samples_multi_f32__avx2(pDst, ppSrc, pVolumes, sourceCount, sampleCount);
+    } else
+#endif
+#if defined(MA_SUPPORT_SSE2)
+    if (ma_has_sse2()) {
+        iSample = ma_mix_pcm_samples_multi_f32__sse2(pDst, ppSrc, pVolumes, sourceCount, sampleCount);
+    } else
+#endif
+#if defined(MA_SUPPORT_NEON)
+    if (ma_has_neon()) {
+        iSample = ma_mix_pcm_samples_multi_f32__neon(pDst, ppSrc, pVolumes, sourceCount, sampleCount);
+    } else
+#endif
+    {
+        iSample = 0;
+    }
+
+    for (; iSample < sampleCount; iSample += 1) {
+        float x = pDst[iSample];
+
+        if (pVolumes == NULL) {
+            for (iSource = 0; iSource < sourceCount; iSource += 1) {
+                x += ppSrc[iSource][iSample];
+            }
+        } else {
+            for (iSource = 0; iSource < sourceCount; iSource += 1) {
+                x += ma_apply_volume_unclipped_f32(ppSrc[iSource][iSample], pVolumes[iSource]);
+            }
+        }
+
+        pDst[iSample] = x;
+    }
+
+    return MA_SUCCESS;
+}
+
 
 
 /**************************************************************************************************************************************************************
@@ -43115,6 +44423,111 @@ static MA_INLINE void ma_pcm_sample_s32_to_s24_no_scale(ma_int64 x, ma_uint8* s2
 }
 
 
+#if defined(MA_SUPPORT_SSE2)
+static MA_INLINE __m128i ma_pcm_load_s24x4__sse2(const ma_uint8* pSrc)
+{
+    /* Loads 4 packed s24 samples into the upper 24 bits of each 32-bit lane. This is the same as converting them to s32. */
+    ma_uint32 hi;
+    __m128i x;
+
+    MA_COPY_MEMORY(&hi, pSrc + 8, 4);
+    x = _mm_or_si128(_mm_loadl_epi64((const __m128i*)pSrc), _mm_slli_si128(_mm_cvtsi32_si128((int)hi), 8));
+
+    /* Sample n lives at byte 3n. Shifting by n bytes moves it to byte 4n which is the start of lane n. */
+    x = _mm_or_si128(
+        _mm_or_si128(_mm_and_si128(                x    , _mm_setr_epi32(0x00FFFFFF, 0, 0, 0)), _mm_and_si128(_mm_slli_si128(x, 1), _mm_setr_epi32(0, 0x00FFFFFF, 0, 0))),
+        _mm_or_si128(_mm_and_si128(_mm_slli_si128(x, 2), _mm_setr_epi32(0, 0, 0x00FFFFFF, 0)), _mm_and_si128(_mm_slli_si128(x, 3), _mm_setr_epi32(0, 0, 0, 0x00FFFFFF)))
+    );
+
+    return _mm_slli_epi32(x, 8);
+}
+
+static MA_INLINE void ma_pcm_store_s24x4__sse2(ma_uint8* pDst, __m128i x)
+{
+    /* Stores the low 24 bits of each 32-bit lane as 4 packed s24 samples. This is the inverse of the shuffle in ma_pcm_load_s24x4__sse2(). */
+    ma_uint32 hi;
+
+    x = _mm_or_si128(
+        _mm_or_si128(               _mm_and_si128(x, _mm_setr_epi32(0x00FFFFFF, 0, 0, 0))    , _mm_srli_si128(_mm_and_si128(x, _mm_setr_epi32(0, 0x00FFFFFF, 0, 0)), 1)),
+        _mm_or_si128(_mm_srli_si128(_mm_and_si128(x, _mm_setr_epi32(0, 0, 0x00FFFFFF, 0)), 2), _mm_srli_si128(_mm_and_si128(x, _mm_setr_epi32(0, 0, 0, 0x00FFFFFF)), 3))
+    );
+
+    _mm_storel_epi64((__m128i*)pDst, x);
+    hi = (ma_uint32)_mm_cvtsi128_si32(_mm_srli_si128(x, 8));
+    MA_COPY_MEMORY(pDst + 8, &hi, 4);
+}
+
+static MA_INLINE __m128i ma_pcm_dither_s32__sse2(__m128i x, __m128i dither)
+{
+    /* Adds dither to s32 samples, clamping to 0x7FFFFFFF on overflow like the reference implementations. */
+    __m128i r = _mm_add_epi32(x, dither);
+    __m128i overflow = _mm_and_si128(_mm_cmpgt_epi32(dither, _mm_setzero_si128()), _mm_cmpgt_epi32(x, r));
+    return _mm_or_si128(_mm_andnot_si128(overflow, r), _mm_and_si128(overflow, _mm_set1_epi32(0x7FFFFFFF)));
+}
+
+static MA_INLINE __m128i ma_pcm_s32_to_u8_lanes__sse2(__m128i x)
+{
+    /* Returns (x >> 24) + 128 in each 32-bit lane. */
+    return _mm_add_epi32(_mm_srai_epi32(x, 24), _mm_set1_epi32(128));
+}
+#endif
+
+#if defined(MA_SUPPORT_AVX2)
+static MA_INLINE __m256i ma_pcm_dither_s32__avx2(__m256i x, __m256i dither)
+{
+    __m256i r = _mm256_add_epi32(x, dither);
+    __m256i overflow = _mm256_and_si256(_mm256_cmpgt_epi32(dither, _mm256_setzero_si256()), _mm256_cmpgt_epi32(x, r));
+    return _mm256_blendv_epi8(r, _mm256_set1_epi32(0x7FFFFFFF), overflow);
+}
+
+static MA_INLINE __m256i ma_pcm_packs_epi32__avx2(__m256i a, __m256i b)
+{
+    /* _mm256_packs_epi32() packs each 128-bit lane separately so the 64-bit blocks need to be put back in order. */
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+}
+#endif
+
+#if defined(MA_SUPPORT_NEON)
+static MA_INLINE void ma_pcm_load_s24x8__neon(const ma_uint8* pSrc, int32x4_t* pLo, int32x4_t* pHi)
+{
+    /* Loads 8 packed s24 samples as s32. */
+    uint8x8x3_t b   = vld3_u8(pSrc);
+    uint16x8_t lo16 = vorrq_u16(vmovl_u8(b.val[0]), vshll_n_u8(b.val[1], 8));
+    int16x8_t  hi16 = vmovl_s8(vreinterpret_s8_u8(b.val[2]));
+
+    *pLo = vorrq_s32(vshlq_n_s32(vmovl_s16(vget_low_s16 (hi16)), 24), vreinterpretq_s32_u32(vshlq_n_u32(vmovl_u16(vget_low_u16 (lo16)), 8)));
+    *pHi = vorrq_s32(vshlq_n_s32(vmovl_s16(vget_high_s16(hi16)), 24), vreinterpretq_s32_u32(vshlq_n_u32(vmovl_u16(vget_high_u16(lo16)), 8)));
+}
+
+static MA_INLINE void ma_pcm_store_s24x8__neon(ma_uint8* pDst, int32x4_t lo, int32x4_t hi)
+{
+    /* Stores the low 24 bits of each 32-bit lane as 8 packed s24 samples. */
+    uint8x8x3_t b;
+    uint16x8_t w0 = vcombine_u16(vmovn_u32  (vreinterpretq_u32_s32(lo)    ), vmovn_u32  (vreinterpretq_u32_s32(hi)    ));
+    uint16x8_t w1 = vcombine_u16(vshrn_n_u32(vreinterpretq_u32_s32(lo), 16), vshrn_n_u32(vreinterpretq_u32_s32(hi), 16));
+
+    b.val[0] = vmovn_u16(w0);
+    b.val[1] = vshrn_n_u16(w0, 8);
+    b.val[2] = vmovn_u16(w1);
+    vst3_u8(pDst, b);
+}
+
+static MA_INLINE int32x4_t ma_pcm_dither_s32__neon(int32x4_t x, int32x4_t dither)
+{
+    int32x4_t  r = vaddq_s32(x, dither);
+    uint32x4_t overflow = vandq_u32(vcgtq_s32(dither, vdupq_n_s32(0)), vcgtq_s32(x, r));
+    return vbslq_s32(overflow, vdupq_n_s32(0x7FFFFFFF), r);
+}
+
+static MA_INLINE uint8x8_t ma_pcm_s32_to_u8x8__neon(int32x4_t lo, int32x4_t hi)
+{
+    /* (x >> 24) + 128 for 8 samples. */
+    int16x8_t x = vcombine_s16(vmovn_s32(vshrq_n_s32(lo, 24)), vmovn_s32(vshrq_n_s32(hi, 24)));
+    return vqmovun_s16(vaddq_s16(x, vdupq_n_s16(128)));
+}
+#endif
+
+
 /* u8 */
 MA_API void ma_pcm_u8_to_u8(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
@@ -43147,13 +44560,38 @@ static MA_INLINE void ma_pcm_u8_to_s16__optimized(void* dst, const void* src, ma
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_u8_to_s16__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_u8_to_s16__optimized(dst, src, count, ditherMode);
+    ma_int16* dst_s16 = (ma_int16*)dst;
+    const ma_uint8* src_u8 = (const ma_uint8*)src;
+    ma_uint64 count16 = count & ~(ma_uint64)15;
+    ma_uint64 i;
+
+    /* Flipping the top bit turns u8 into s8. Interleaving with zero then moves it into the upper byte of each s16. */
+    for (i = 0; i < count16; i += 16) {
+        __m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(src_u8 + i)), _mm_set1_epi8((char)0x80));
+        _mm_storeu_si128((__m128i*)(dst_s16 + i + 0), _mm_unpacklo_epi8(_mm_setzero_si128(), x));
+        _mm_storeu_si128((__m128i*)(dst_s16 + i + 8), _mm_unpackhi_epi8(_mm_setzero_si128(), x));
+    }
+
+    /* Leftover. */
+    ma_pcm_u8_to_s16__optimized(dst_s16 + i, src_u8 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_u8_to_s16__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_u8_to_s16__optimized(dst, src, count, ditherMode);
+    ma_int16* dst_s16 = (ma_int16*)dst;
+    const ma_uint8* src_u8 = (const ma_uint8*)src;
+    ma_uint64 count16 = count & ~(ma_uint64)15;
+    ma_uint64 i;
+
+    for (i = 0; i < count16; i += 16) {
+        int8x16_t x = vreinterpretq_s8_u8(veorq_u8(vld1q_u8(src_u8 + i), vdupq_n_u8(0x80)));
+        vst1q_s16(dst_s16 + i + 0, vshll_n_s8(vget_low_s8 (x), 8));
+        vst1q_s16(dst_s16 + i + 8, vshll_n_s8(vget_high_s8(x), 8));
+    }
+
+    /* Leftover. */
+    ma_pcm_u8_to_s16__optimized(dst_s16 + i, src_u8 + i, count - i, ditherMode);
 }
 #endif
 
@@ -43204,13 +44642,46 @@ static MA_INLINE void ma_pcm_u8_to_s24__optimized(void* dst, const void* src, ma
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_u8_to_s24__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_u8_to_s24__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_s24 = (ma_uint8*)dst;
+    const ma_uint8* src_u8 = (const ma_uint8*)src;
+    ma_uint64 count16 = count & ~(ma_uint64)15;
+    ma_uint64 i;
+
+    for (i = 0; i < count16; i += 16) {
+        __m128i x  = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(src_u8 + i)), _mm_set1_epi8((char)0x80));
+        __m128i lo = _mm_unpacklo_epi8(_mm_setzero_si128(), x);
+        __m128i hi = _mm_unpackhi_epi8(_mm_setzero_si128(), x);
+
+        /* The sample goes into the top byte of the 24-bit value with the lower two bytes left at zero. */
+        ma_pcm_store_s24x4__sse2(dst_s24 + (i +  0)*3, _mm_srli_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), lo), 8));
+        ma_pcm_store_s24x4__sse2(dst_s24 + (i +  4)*3, _mm_srli_epi32(_mm_unpackhi_epi16(_mm_setzero_si128(), lo), 8));
+        ma_pcm_store_s24x4__sse2(dst_s24 + (i +  8)*3, _mm_srli_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), hi), 8));
+        ma_pcm_store_s24x4__sse2(dst_s24 + (i + 12)*3, _mm_srli_epi32(_mm_unpackhi_epi16(_mm_setzero_si128(), hi), 8));
+    }
+
+    /* Leftover. */
+    ma_pcm_u8_to_s24__optimized(dst_s24 + i*3, src_u8 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_u8_to_s24__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_u8_to_s24__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_s24 = (ma_uint8*)dst;
+    const ma_uint8* src_u8 = (const ma_uint8*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+    uint8x8x3_t b;
+
+    b.val[0] = vdup_n_u8(0);
+    b.val[1] = vdup_n_u8(0);
+
+    for (i = 0; i < count8; i += 8) {
+        b.val[2] = veor_u8(vld1_u8(src_u8 + i), vdup_n_u8(0x80));
+        vst3_u8(dst_s24 + i*3, b);
+    }
+
+    /* Leftover. */
+    ma_pcm_u8_to_s24__optimized(dst_s24 + i*3, src_u8 + i, count - i, ditherMode);
 }
 #endif
 
@@ -43259,13 +44730,42 @@ static MA_INLINE void ma_pcm_u8_to_s32__optimized(void* dst, const void* src, ma
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_u8_to_s32__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_u8_to_s32__optimized(dst, src, count, ditherMode);
+    ma_int32* dst_s32 = (ma_int32*)dst;
+    const ma_uint8* src_u8 = (const ma_uint8*)src;
+    ma_uint64 count16 = count & ~(ma_uint64)15;
+    ma_uint64 i;
+
+    for (i = 0; i < count16; i += 16) {
+        __m128i x  = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(src_u8 + i)), _mm_set1_epi8((char)0x80));
+        __m128i lo = _mm_unpacklo_epi8(_mm_setzero_si128(), x);
+        __m128i hi = _mm_unpackhi_epi8(_mm_setzero_si128(), x);
+
+        _mm_storeu_si128((__m128i*)(dst_s32 + i +  0), _mm_unpacklo_epi16(_mm_setzero_si128(), lo));
+        _mm_storeu_si128((__m128i*)(dst_s32 + i +  4), _mm_unpackhi_epi16(_mm_setzero_si128(), lo));
+        _mm_storeu_si128((__m128i*)(dst_s32 + i +  8), _mm_unpacklo_epi16(_mm_setzero_si128(), hi));
+        _mm_storeu_si128((__m128i*)(dst_s32 + i + 12), _mm_unpackhi_epi16(_mm_setzero_si128(), hi));
+    }
+
+    /* Leftover. */
+    ma_pcm_u8_to_s32__optimized(dst_s32 + i, src_u8 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_u8_to_s32__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_u8_to_s32__optimized(dst, src, count, ditherMode);
+    ma_int32* dst_s32 = (ma_int32*)dst;
+    const ma_uint8* src_u8 = (const ma_uint8*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        int16x8_t x = vshll_n_s8(vreinterpret_s8_u8(veor_u8(vld1_u8(src_u8 + i), vdup_n_u8(0x80))), 8);
+        vst1q_s32(dst_s32 + i + 0, vshll_n_s16(vget_low_s16 (x), 16));
+        vst1q_s32(dst_s32 + i + 4, vshll_n_s16(vget_high_s16(x), 16));
+    }
+
+    /* Leftover. */
+    ma_pcm_u8_to_s32__optimized(dst_s32 + i, src_u8 + i, count - i, ditherMode);
 }
 #endif
 
@@ -43315,13 +44815,49 @@ static MA_INLINE void ma_pcm_u8_to_f32__optimized(void* dst, const void* src, ma
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_u8_to_f32__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_u8_to_f32__optimized(dst, src, count, ditherMode);
+    float* dst_f32 = (float*)dst;
+    const ma_uint8* src_u8 = (const ma_uint8*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        __m128i x = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(src_u8 + i)), _mm_setzero_si128());
+        __m128  a = _mm_cvtepi32_ps(_mm_unpacklo_epi16(x, _mm_setzero_si128()));
+        __m128  b = _mm_cvtepi32_ps(_mm_unpackhi_epi16(x, _mm_setzero_si128()));
+
+        a = _mm_sub_ps(_mm_mul_ps(a, _mm_set1_ps(0.00784313725490196078f)), _mm_set1_ps(1));
+        b = _mm_sub_ps(_mm_mul_ps(b, _mm_set1_ps(0.00784313725490196078f)), _mm_set1_ps(1));
+
+        _mm_storeu_ps(dst_f32 + i + 0, a);
+        _mm_storeu_ps(dst_f32 + i + 4, b);
+    }
+
+    /* Leftover. */
+    ma_pcm_u8_to_f32__optimized(dst_f32 + i, src_u8 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_u8_to_f32__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_u8_to_f32__optimized(dst, src, count, ditherMode);
+    float* dst_f32 = (float*)dst;
+    const ma_uint8* src_u8 = (const ma_uint8*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        uint16x8_t  x = vmovl_u8(vld1_u8(src_u8 + i));
+        float32x4_t a = vcvtq_f32_u32(vmovl_u16(vget_low_u16 (x)));
+        float32x4_t b = vcvtq_f32_u32(vmovl_u16(vget_high_u16(x)));
+
+        a = vsubq_f32(vmulq_n_f32(a, 0.00784313725490196078f), vdupq_n_f32(1));
+        b = vsubq_f32(vmulq_n_f32(b, 0.00784313725490196078f), vdupq_n_f32(1));
+
+        vst1q_f32(dst_f32 + i + 0, a);
+        vst1q_f32(dst_f32 + i + 4, b);
+    }
+
+    /* Leftover. */
+    ma_pcm_u8_to_f32__optimized(dst_f32 + i, src_u8 + i, count - i, ditherMode);
 }
 #endif
 
@@ -43467,13 +45003,82 @@ static MA_INLINE void ma_pcm_s16_to_u8__optimized(void* dst, const void* src, ma
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_s16_to_u8__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s16_to_u8__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_u8 = (ma_uint8*)dst;
+    const ma_int16* src_s16 = (const ma_int16*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    if (ditherMode == ma_dither_mode_none) {
+        for (i = 0; i < count8; i += 8) {
+            __m128i x = _mm_add_epi16(_mm_srai_epi16(_mm_loadu_si128((const __m128i*)(src_s16 + i)), 8), _mm_set1_epi16(128));
+            _mm_storel_epi64((__m128i*)(dst_u8 + i), _mm_packus_epi16(x, x));
+        }
+    } else {
+        ma_int32 dither[8];
+
+        for (i = 0; i < count8; i += 8) {
+            __m128i x  = _mm_loadu_si128((const __m128i*)(src_s16 + i));
+            __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), x), 16);
+            __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(_mm_setzero_si128(), x), 16);
+            __m128i maxLo;
+            __m128i maxHi;
+
+            ma_dither_s32_array(ditherMode, -0x80, 0x7F, dither, 8);
+            lo = _mm_add_epi32(lo, _mm_loadu_si128((const __m128i*)(dither + 0)));
+            hi = _mm_add_epi32(hi, _mm_loadu_si128((const __m128i*)(dither + 4)));
+
+            /* Don't overflow. */
+            maxLo = _mm_cmpgt_epi32(lo, _mm_set1_epi32(0x7FFF));
+            maxHi = _mm_cmpgt_epi32(hi, _mm_set1_epi32(0x7FFF));
+            lo = _mm_or_si128(_mm_andnot_si128(maxLo, lo), _mm_and_si128(maxLo, _mm_set1_epi32(0x7FFF)));
+            hi = _mm_or_si128(_mm_andnot_si128(maxHi, hi), _mm_and_si128(maxHi, _mm_set1_epi32(0x7FFF)));
+
+            /* Wrap around to 16 bits before shifting, just like the reference implementation. */
+            lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 24);
+            hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 24);
+
+            x = _mm_add_epi16(_mm_packs_epi32(lo, hi), _mm_set1_epi16(128));
+            _mm_storel_epi64((__m128i*)(dst_u8 + i), _mm_packus_epi16(x, x));
+        }
+    }
+
+    /* Leftover. */
+    ma_pcm_s16_to_u8__optimized(dst_u8 + i, src_s16 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_s16_to_u8__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s16_to_u8__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_u8 = (ma_uint8*)dst;
+    const ma_int16* src_s16 = (const ma_int16*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    if (ditherMode == ma_dither_mode_none) {
+        for (i = 0; i < count8; i += 8) {
+            int16x8_t x = vaddq_s16(vshrq_n_s16(vld1q_s16(src_s16 + i), 8), vdupq_n_s16(128));
+            vst1_u8(dst_u8 + i, vqmovun_s16(x));
+        }
+    } else {
+        ma_int32 dither[8];
+
+        for (i = 0; i < count8; i += 8) {
+            int16x8_t x  = vld1q_s16(src_s16 + i);
+            int32x4_t lo;
+            int32x4_t hi;
+
+            ma_dither_s32_array(ditherMode, -0x80, 0x7F, dither, 8);
+            lo = vminq_s32(vaddq_s32(vmovl_s16(vget_low_s16 (x)), vld1q_s32(dither + 0)), vdupq_n_s32(0x7FFF));  /* Don't overflow. */
+            hi = vminq_s32(vaddq_s32(vmovl_s16(vget_high_s16(x)), vld1q_s32(dither + 4)), vdupq_n_s32(0x7FFF));
+
+            /* The narrowing wraps around to 16 bits just like the reference implementation. */
+            x = vaddq_s16(vshrq_n_s16(vcombine_s16(vmovn_s32(lo), vmovn_s32(hi)), 8), vdupq_n_s16(128));
+            vst1_u8(dst_u8 + i, vqmovun_s16(x));
+        }
+    }
+
+    /* Leftover. */
+    ma_pcm_s16_to_u8__optimized(dst_u8 + i, src_s16 + i, count - i, ditherMode);
 }
 #endif
 
@@ -43528,13 +45133,41 @@ static MA_INLINE void ma_pcm_s16_to_s24__optimized(void* dst, const void* src, m
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_s16_to_s24__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s16_to_s24__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_s24 = (ma_uint8*)dst;
+    const ma_int16* src_s16 = (const ma_int16*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(src_s16 + i));
+        ma_pcm_store_s24x4__sse2(dst_s24 + (i + 0)*3, _mm_srli_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), x), 8));
+        ma_pcm_store_s24x4__sse2(dst_s24 + (i + 4)*3, _mm_srli_epi32(_mm_unpackhi_epi16(_mm_setzero_si128(), x), 8));
+    }
+
+    /* Leftover. */
+    ma_pcm_s16_to_s24__optimized(dst_s24 + i*3, src_s16 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_s16_to_s24__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s16_to_s24__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_s24 = (ma_uint8*)dst;
+    const ma_int16* src_s16 = (const ma_int16*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+    uint8x8x3_t b;
+
+    b.val[0] = vdup_n_u8(0);
+
+    for (i = 0; i < count8; i += 8) {
+        uint16x8_t x = vreinterpretq_u16_s16(vld1q_s16(src_s16 + i));
+        b.val[1] = vmovn_u16(x);
+        b.val[2] = vshrn_n_u16(x, 8);
+        vst3_u8(dst_s24 + i*3, b);
+    }
+
+    /* Leftover. */
+    ma_pcm_s16_to_s24__optimized(dst_s24 + i*3, src_s16 + i, count - i, ditherMode);
 }
 #endif
 
@@ -43580,13 +45213,56 @@ static MA_INLINE void ma_pcm_s16_to_s32__optimized(void* dst, const void* src, m
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_s16_to_s32__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s16_to_s32__optimized(dst, src, count, ditherMode);
+    ma_int32* dst_s32 = (ma_int32*)dst;
+    const ma_int16* src_s16 = (const ma_int16*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(src_s16 + i));
+        _mm_storeu_si128((__m128i*)(dst_s32 + i + 0), _mm_unpacklo_epi16(_mm_setzero_si128(), x));
+        _mm_storeu_si128((__m128i*)(dst_s32 + i + 4), _mm_unpackhi_epi16(_mm_setzero_si128(), x));
+    }
+
+    /* Leftover. */
+    ma_pcm_s16_to_s32__optimized(dst_s32 + i, src_s16 + i, count - i, ditherMode);
+}
+#endif
+#if defined(MA_SUPPORT_AVX2)
+static MA_INLINE void ma_pcm_s16_to_s32__avx2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
+{
+    ma_int32* dst_s32 = (ma_int32*)dst;
+    const ma_int16* src_s16 = (const ma_int16*)src;
+    ma_uint64 count16 = count & ~(ma_uint64)15;
+    ma_uint64 i;
+
+    for (i = 0; i < count16; i += 16) {
+        __m256i a = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(src_s16 + i + 0)));
+        __m256i b = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(src_s16 + i + 8)));
+        _mm256_storeu_si256((__m256i*)(dst_s32 + i + 0), _mm256_slli_epi32(a, 16));
+        _mm256_storeu_si256((__m256i*)(dst_s32 + i + 8), _mm256_slli_epi32(b, 16));
+    }
+
+    /* Leftover. */
+    ma_pcm_s16_to_s32__optimized(dst_s32 + i, src_s16 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_s16_to_s32__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s16_to_s32__optimized(dst, src, count, ditherMode);
+    ma_int32* dst_s32 = (ma_int32*)dst;
+    const ma_int16* src_s16 = (const ma_int16*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        int16x8_t x = vld1q_s16(src_s16 + i);
+        vst1q_s32(dst_s32 + i + 0, vshll_n_s16(vget_low_s16 (x), 16));
+        vst1q_s32(dst_s32 + i + 4, vshll_n_s16(vget_high_s16(x), 16));
+    }
+
+    /* Leftover. */
+    ma_pcm_s16_to_s32__optimized(dst_s32 + i, src_s16 + i, count - i, ditherMode);
 }
 #endif
 
@@ -43595,6 +45271,11 @@ MA_API void ma_pcm_s16_to_s32(void* dst, const void* src, ma_uint64 count, ma_di
 #ifdef MA_USE_REFERENCE_CONVERSION_APIS
     ma_pcm_s16_to_s32__reference(dst, src, count, ditherMode);
 #else
+    #  if defined(MA_SUPPORT_AVX2)
+        if (ma_has_avx2()) {
+            ma_pcm_s16_to_s32__avx2(dst, src, count, ditherMode);
+        } else
+    #  endif
     #  if defined(MA_SUPPORT_SSE2)
         if (ma_has_sse2()) {
             ma_pcm_s16_to_s32__sse2(dst, src, count, ditherMode);
@@ -43644,13 +45325,60 @@ static MA_INLINE void ma_pcm_s16_to_f32__optimized(void* dst, const void* src, m
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_s16_to_f32__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s16_to_f32__optimized(dst, src, count, ditherMode);
+    float* dst_f32 = (float*)dst;
+    const ma_int16* src_s16 = (const ma_int16*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(src_s16 + i));
+        __m128  a = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), x), 16));
+        __m128  b = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(_mm_setzero_si128(), x), 16));
+
+        _mm_storeu_ps(dst_f32 + i + 0, _mm_mul_ps(a, _mm_set1_ps(0.000030517578125f)));
+        _mm_storeu_ps(dst_f32 + i + 4, _mm_mul_ps(b, _mm_set1_ps(0.000030517578125f)));
+    }
+
+    /* Leftover. */
+    ma_pcm_s16_to_f32__optimized(dst_f32 + i, src_s16 + i, count - i, ditherMode);
+}
+#endif
+#if defined(MA_SUPPORT_AVX2)
+static MA_INLINE void ma_pcm_s16_to_f32__avx2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
+{
+    float* dst_f32 = (float*)dst;
+    const ma_int16* src_s16 = (const ma_int16*)src;
+    ma_uint64 count16 = count & ~(ma_uint64)15;
+    ma_uint64 i;
+
+    for (i = 0; i < count16; i += 16) {
+        __m256 a = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(src_s16 + i + 0))));
+        __m256 b = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(src_s16 + i + 8))));
+
+        _mm256_storeu_ps(dst_f32 + i + 0, _mm256_mul_ps(a, _mm256_set1_ps(0.000030517578125f)));
+        _mm256_storeu_ps(dst_f32 + i + 8, _mm256_mul_ps(b, _mm256_set1_ps(0.000030517578125f)));
+    }
+
+    /* Leftover. */
+    ma_pcm_s16_to_f32__optimized(dst_f32 + i, src_s16 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_s16_to_f32__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s16_to_f32__optimized(dst, src, count, ditherMode);
+    float* dst_f32 = (float*)dst;
+    const ma_int16* src_s16 = (const ma_int16*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        int16x8_t x = vld1q_s16(src_s16 + i);
+        vst1q_f32(dst_f32 + i + 0, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16 (x))), 0.000030517578125f));
+        vst1q_f32(dst_f32 + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), 0.000030517578125f));
+    }
+
+    /* Leftover. */
+    ma_pcm_s16_to_f32__optimized(dst_f32 + i, src_s16 + i, count - i, ditherMode);
 }
 #endif
 
@@ -43659,6 +45387,11 @@ MA_API void ma_pcm_s16_to_f32(void* dst, const void* src, ma_uint64 count, ma_di
 #ifdef MA_USE_REFERENCE_CONVERSION_APIS
     ma_pcm_s16_to_f32__reference(dst, src, count, ditherMode);
 #else
+    #  if defined(MA_SUPPORT_AVX2)
+        if (ma_has_avx2()) {
+            ma_pcm_s16_to_f32__avx2(dst, src, count, ditherMode);
+        } else
+    #  endif
     #  if defined(MA_SUPPORT_SSE2)
         if (ma_has_sse2()) {
             ma_pcm_s16_to_f32__sse2(dst, src, count, ditherMode);
@@ -43772,13 +45505,64 @@ static MA_INLINE void ma_pcm_s24_to_u8__optimized(void* dst, const void* src, ma
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_s24_to_u8__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s24_to_u8__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_u8 = (ma_uint8*)dst;
+    const ma_uint8* src_s24 = (const ma_uint8*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+    ma_int32 dither[8];
+
+    for (i = 0; i < count8; i += 8) {
+        __m128i a = ma_pcm_load_s24x4__sse2(src_s24 + (i + 0)*3);
+        __m128i b = ma_pcm_load_s24x4__sse2(src_s24 + (i + 4)*3);
+        __m128i x;
+
+        if (ditherMode != ma_dither_mode_none) {
+            ma_dither_s32_array(ditherMode, -0x800000, 0x7FFFFF, dither, 8);
+            a = ma_pcm_dither_s32__sse2(a, _mm_loadu_si128((const __m128i*)(dither + 0)));
+            b = ma_pcm_dither_s32__sse2(b, _mm_loadu_si128((const __m128i*)(dither + 4)));
+        }
+
+        x = _mm_packs_epi32(ma_pcm_s32_to_u8_lanes__sse2(a), ma_pcm_s32_to_u8_lanes__sse2(b));
+        _mm_storel_epi64((__m128i*)(dst_u8 + i), _mm_packus_epi16(x, x));
+    }
+
+    /* Leftover. */
+    ma_pcm_s24_to_u8__optimized(dst_u8 + i, src_s24 + i*3, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_s24_to_u8__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s24_to_u8__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_u8 = (ma_uint8*)dst;
+    const ma_uint8* src_s24 = (const ma_uint8*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    if (ditherMode == ma_dither_mode_none) {
+        /* Only the top byte is needed which means we can pull it straight out of the deinterleaved load. */
+        for (i = 0; i < count8; i += 8) {
+            uint8x8x3_t b = vld3_u8(src_s24 + i*3);
+            vst1_u8(dst_u8 + i, veor_u8(b.val[2], vdup_n_u8(0x80)));
+        }
+    } else {
+        ma_int32 dither[8];
+
+        for (i = 0; i < count8; i += 8) {
+            int32x4_t lo;
+            int32x4_t hi;
+
+            ma_pcm_load_s24x8__neon(src_s24 + i*3, &lo, &hi);
+
+            ma_dither_s32_array(ditherMode, -0x800000, 0x7FFFFF, dither, 8);
+            lo = ma_pcm_dither_s32__neon(lo, vld1q_s32(dither + 0));
+            hi = ma_pcm_dither_s32__neon(hi, vld1q_s32(dither + 4));
+
+            vst1_u8(dst_u8 + i, ma_pcm_s32_to_u8x8__neon(lo, hi));
+        }
+    }
+
+    /* Leftover. */
+    ma_pcm_s24_to_u8__optimized(dst_u8 + i, src_s24 + i*3, count - i, ditherMode);
 }
 #endif
 
@@ -43842,13 +45626,62 @@ static MA_INLINE void ma_pcm_s24_to_s16__optimized(void* dst, const void* src, m
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_s24_to_s16__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s24_to_s16__optimized(dst, src, count, ditherMode);
+    ma_int16* dst_s16 = (ma_int16*)dst;
+    const ma_uint8* src_s24 = (const ma_uint8*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+    ma_int32 dither[8];
+
+    for (i = 0; i < count8; i += 8) {
+        __m128i a = ma_pcm_load_s24x4__sse2(src_s24 + (i + 0)*3);
+        __m128i b = ma_pcm_load_s24x4__sse2(src_s24 + (i + 4)*3);
+
+        if (ditherMode != ma_dither_mode_none) {
+            ma_dither_s32_array(ditherMode, -0x8000, 0x7FFF, dither, 8);
+            a = ma_pcm_dither_s32__sse2(a, _mm_loadu_si128((const __m128i*)(dither + 0)));
+            b = ma_pcm_dither_s32__sse2(b, _mm_loadu_si128((const __m128i*)(dither + 4)));
+        }
+
+        _mm_storeu_si128((__m128i*)(dst_s16 + i), _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16)));
+    }
+
+    /* Leftover. */
+    ma_pcm_s24_to_s16__optimized(dst_s16 + i, src_s24 + i*3, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_s24_to_s16__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s24_to_s16__optimized(dst, src, count, ditherMode);
+    ma_int16* dst_s16 = (ma_int16*)dst;
+    const ma_uint8* src_s24 = (const ma_uint8*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    if (ditherMode == ma_dither_mode_none) {
+        /* The lowest byte is simply dropped. */
+        for (i = 0; i < count8; i += 8) {
+            uint8x8x3_t b = vld3_u8(src_s24 + i*3);
+            vst1q_s16(dst_s16 + i, vreinterpretq_s16_u16(vorrq_u16(vmovl_u8(b.val[1]), vshll_n_u8(b.val[2], 8))));
+        }
+    } else {
+        ma_int32 dither[8];
+
+        for (i = 0; i < count8; i += 8) {
+            int32x4_t lo;
+            int32x4_t hi;
+
+            ma_pcm_load_s24x8__neon(src_s24 + i*3, &lo, &hi);
+
+            ma_dither_s32_array(ditherMode, -0x8000, 0x7FFF, dither, 8);
+            lo = ma_pcm_dither_s32__neon(lo, vld1q_s32(dither + 0));
+            hi = ma_pcm_dither_s32__neon(hi, vld1q_s32(dither + 4));
+
+            vst1q_s16(dst_s16 + i, vcombine_s16(vshrn_n_s32(lo, 16), vshrn_n_s32(hi, 16)));
+        }
+    }
+
+    /* Leftover. */
+    ma_pcm_s24_to_s16__optimized(dst_s16 + i, src_s24 + i*3, count - i, ditherMode);
 }
 #endif
 
@@ -43902,13 +45735,38 @@ static MA_INLINE void ma_pcm_s24_to_s32__optimized(void* dst, const void* src, m
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_s24_to_s32__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s24_to_s32__optimized(dst, src, count, ditherMode);
+    ma_int32* dst_s32 = (ma_int32*)dst;
+    const ma_uint8* src_s24 = (const ma_uint8*)src;
+    ma_uint64 count4 = count & ~(ma_uint64)3;
+    ma_uint64 i;
+
+    for (i = 0; i < count4; i += 4) {
+        _mm_storeu_si128((__m128i*)(dst_s32 + i), ma_pcm_load_s24x4__sse2(src_s24 + i*3));
+    }
+
+    /* Leftover. */
+    ma_pcm_s24_to_s32__optimized(dst_s32 + i, src_s24 + i*3, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_s24_to_s32__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s24_to_s32__optimized(dst, src, count, ditherMode);
+    ma_int32* dst_s32 = (ma_int32*)dst;
+    const ma_uint8* src_s24 = (const ma_uint8*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        int32x4_t lo;
+        int32x4_t hi;
+
+        ma_pcm_load_s24x8__neon(src_s24 + i*3, &lo, &hi);
+        vst1q_s32(dst_s32 + i + 0, lo);
+        vst1q_s32(dst_s32 + i + 4, hi);
+    }
+
+    /* Leftover. */
+    ma_pcm_s24_to_s32__optimized(dst_s32 + i, src_s24 + i*3, count - i, ditherMode);
 }
 #endif
 
@@ -43966,13 +45824,39 @@ static MA_INLINE void ma_pcm_s24_to_f32__optimized(void* dst, const void* src, m
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_s24_to_f32__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s24_to_f32__optimized(dst, src, count, ditherMode);
+    float* dst_f32 = (float*)dst;
+    const ma_uint8* src_s24 = (const ma_uint8*)src;
+    ma_uint64 count4 = count & ~(ma_uint64)3;
+    ma_uint64 i;
+
+    for (i = 0; i < count4; i += 4) {
+        __m128 x = _mm_cvtepi32_ps(_mm_srai_epi32(ma_pcm_load_s24x4__sse2(src_s24 + i*3), 8));
+        _mm_storeu_ps(dst_f32 + i, _mm_mul_ps(x, _mm_set1_ps(0.00000011920928955078125f)));
+    }
+
+    /* Leftover. */
+    ma_pcm_s24_to_f32__optimized(dst_f32 + i, src_s24 + i*3, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_s24_to_f32__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s24_to_f32__optimized(dst, src, count, ditherMode);
+    float* dst_f32 = (float*)dst;
+    const ma_uint8* src_s24 = (const ma_uint8*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        int32x4_t lo;
+        int32x4_t hi;
+
+        ma_pcm_load_s24x8__neon(src_s24 + i*3, &lo, &hi);
+        vst1q_f32(dst_f32 + i + 0, vmulq_n_f32(vcvtq_f32_s32(vshrq_n_s32(lo, 8)), 0.00000011920928955078125f));
+        vst1q_f32(dst_f32 + i + 4, vmulq_n_f32(vcvtq_f32_s32(vshrq_n_s32(hi, 8)), 0.00000011920928955078125f));
+    }
+
+    /* Leftover. */
+    ma_pcm_s24_to_f32__optimized(dst_f32 + i, src_s24 + i*3, count - i, ditherMode);
 }
 #endif
 
@@ -44102,13 +45986,55 @@ static MA_INLINE void ma_pcm_s32_to_u8__optimized(void* dst, const void* src, ma
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_s32_to_u8__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s32_to_u8__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_u8 = (ma_uint8*)dst;
+    const ma_int32* src_s32 = (const ma_int32*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+    ma_int32 dither[8];
+
+    for (i = 0; i < count8; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(src_s32 + i + 0));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src_s32 + i + 4));
+        __m128i x;
+
+        if (ditherMode != ma_dither_mode_none) {
+            ma_dither_s32_array(ditherMode, -0x800000, 0x7FFFFF, dither, 8);
+            a = ma_pcm_dither_s32__sse2(a, _mm_loadu_si128((const __m128i*)(dither + 0)));
+            b = ma_pcm_dither_s32__sse2(b, _mm_loadu_si128((const __m128i*)(dither + 4)));
+        }
+
+        x = _mm_packs_epi32(ma_pcm_s32_to_u8_lanes__sse2(a), ma_pcm_s32_to_u8_lanes__sse2(b));
+        _mm_storel_epi64((__m128i*)(dst_u8 + i), _mm_packus_epi16(x, x));
+    }
+
+    /* Leftover. */
+    ma_pcm_s32_to_u8__optimized(dst_u8 + i, src_s32 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_s32_to_u8__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s32_to_u8__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_u8 = (ma_uint8*)dst;
+    const ma_int32* src_s32 = (const ma_int32*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+    ma_int32 dither[8];
+
+    for (i = 0; i < count8; i += 8) {
+        int32x4_t lo = vld1q_s32(src_s32 + i + 0);
+        int32x4_t hi = vld1q_s32(src_s32 + i + 4);
+
+        if (ditherMode != ma_dither_mode_none) {
+            ma_dither_s32_array(ditherMode, -0x800000, 0x7FFFFF, dither, 8);
+            lo = ma_pcm_dither_s32__neon(lo, vld1q_s32(dither + 0));
+            hi = ma_pcm_dither_s32__neon(hi, vld1q_s32(dither + 4));
+        }
+
+        vst1_u8(dst_u8 + i, ma_pcm_s32_to_u8x8__neon(lo, hi));
+    }
+
+    /* Leftover. */
+    ma_pcm_s32_to_u8__optimized(dst_u8 + i, src_s32 + i, count - i, ditherMode);
 }
 #endif
 
@@ -44172,13 +46098,79 @@ static MA_INLINE void ma_pcm_s32_to_s16__optimized(void* dst, const void* src, m
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_s32_to_s16__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s32_to_s16__optimized(dst, src, count, ditherMode);
+    ma_int16* dst_s16 = (ma_int16*)dst;
+    const ma_int32* src_s32 = (const ma_int32*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+    ma_int32 dither[8];
+
+    for (i = 0; i < count8; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(src_s32 + i + 0));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src_s32 + i + 4));
+
+        if (ditherMode != ma_dither_mode_none) {
+            ma_dither_s32_array(ditherMode, -0x8000, 0x7FFF, dither, 8);
+            a = ma_pcm_dither_s32__sse2(a, _mm_loadu_si128((const __m128i*)(dither + 0)));
+            b = ma_pcm_dither_s32__sse2(b, _mm_loadu_si128((const __m128i*)(dither + 4)));
+        }
+
+        _mm_storeu_si128((__m128i*)(dst_s16 + i), _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16)));
+    }
+
+    /* Leftover. */
+    ma_pcm_s32_to_s16__optimized(dst_s16 + i, src_s32 + i, count - i, ditherMode);
+}
+#endif
+#if defined(MA_SUPPORT_AVX2)
+static MA_INLINE void ma_pcm_s32_to_s16__avx2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
+{
+    ma_int16* dst_s16 = (ma_int16*)dst;
+    const ma_int32* src_s32 = (const ma_int32*)src;
+    ma_uint64 count16 = count & ~(ma_uint64)15;
+    ma_uint64 i;
+    ma_int32 dither[16];
+
+    for (i = 0; i < count16; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(src_s32 + i + 0));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(src_s32 + i + 8));
+
+        if (ditherMode != ma_dither_mode_none) {
+            ma_dither_s32_array(ditherMode, -0x8000, 0x7FFF, dither, 16);
+            a = ma_pcm_dither_s32__avx2(a, _mm256_loadu_si256((const __m256i*)(dither + 0)));
+            b = ma_pcm_dither_s32__avx2(b, _mm256_loadu_si256((const __m256i*)(dither + 8)));
+        }
+
+        _mm256_storeu_si256((__m256i*)(dst_s16 + i), ma_pcm_packs_epi32__avx2(_mm256_srai_epi32(a, 16), _mm256_srai_epi32(b, 16)));
+    }
+
+    /* Leftover. */
+    ma_pcm_s32_to_s16__optimized(dst_s16 + i, src_s32 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_s32_to_s16__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s32_to_s16__optimized(dst, src, count, ditherMode);
+    ma_int16* dst_s16 = (ma_int16*)dst;
+    const ma_int32* src_s32 = (const ma_int32*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+    ma_int32 dither[8];
+
+    for (i = 0; i < count8; i += 8) {
+        int32x4_t lo = vld1q_s32(src_s32 + i + 0);
+        int32x4_t hi = vld1q_s32(src_s32 + i + 4);
+
+        if (ditherMode != ma_dither_mode_none) {
+            ma_dither_s32_array(ditherMode, -0x8000, 0x7FFF, dither, 8);
+            lo = ma_pcm_dither_s32__neon(lo, vld1q_s32(dither + 0));
+            hi = ma_pcm_dither_s32__neon(hi, vld1q_s32(dither + 4));
+        }
+
+        vst1q_s16(dst_s16 + i, vcombine_s16(vshrn_n_s32(lo, 16), vshrn_n_s32(hi, 16)));
+    }
+
+    /* Leftover. */
+    ma_pcm_s32_to_s16__optimized(dst_s16 + i, src_s32 + i, count - i, ditherMode);
 }
 #endif
 
@@ -44187,6 +46179,11 @@ MA_API void ma_pcm_s32_to_s16(void* dst, const void* src, ma_uint64 count, ma_di
 #ifdef MA_USE_REFERENCE_CONVERSION_APIS
     ma_pcm_s32_to_s16__reference(dst, src, count, ditherMode);
 #else
+    #  if defined(MA_SUPPORT_AVX2)
+        if (ma_has_avx2()) {
+            ma_pcm_s32_to_s16__avx2(dst, src, count, ditherMode);
+        } else
+    #  endif
     #  if defined(MA_SUPPORT_SSE2)
         if (ma_has_sse2()) {
             ma_pcm_s32_to_s16__sse2(dst, src, count, ditherMode);
@@ -44227,13 +46224,33 @@ static MA_INLINE void ma_pcm_s32_to_s24__optimized(void* dst, const void* src, m
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_s32_to_s24__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s32_to_s24__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_s24 = (ma_uint8*)dst;
+    const ma_int32* src_s32 = (const ma_int32*)src;
+    ma_uint64 count4 = count & ~(ma_uint64)3;
+    ma_uint64 i;
+
+    for (i = 0; i < count4; i += 4) {
+        ma_pcm_store_s24x4__sse2(dst_s24 + i*3, _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(src_s32 + i)), 8));
+    }
+
+    /* Leftover. */
+    ma_pcm_s32_to_s24__optimized(dst_s24 + i*3, src_s32 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_s32_to_s24__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s32_to_s24__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_s24 = (ma_uint8*)dst;
+    const ma_int32* src_s32 = (const ma_int32*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        ma_pcm_store_s24x8__neon(dst_s24 + i*3, vshrq_n_s32(vld1q_s32(src_s32 + i + 0), 8), vshrq_n_s32(vld1q_s32(src_s32 + i + 4), 8));
+    }
+
+    /* Leftover. */
+    ma_pcm_s32_to_s24__optimized(dst_s24 + i*3, src_s32 + i, count - i, ditherMode);
 }
 #endif
 
@@ -44297,13 +46314,62 @@ static MA_INLINE void ma_pcm_s32_to_f32__optimized(void* dst, const void* src, m
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_s32_to_f32__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s32_to_f32__optimized(dst, src, count, ditherMode);
+    float* dst_f32 = (float*)dst;
+    const ma_int32* src_s32 = (const ma_int32*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    /*
+    The reference implementation divides in double precision. Since the divisor is a power of two, rounding to float first and
+    then scaling gives the exact same result.
+    */
+    for (i = 0; i < count8; i += 8) {
+        __m128 a = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(src_s32 + i + 0)));
+        __m128 b = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(src_s32 + i + 4)));
+
+        _mm_storeu_ps(dst_f32 + i + 0, _mm_mul_ps(a, _mm_set1_ps(0.0000000004656612873077392578125f)));
+        _mm_storeu_ps(dst_f32 + i + 4, _mm_mul_ps(b, _mm_set1_ps(0.0000000004656612873077392578125f)));
+    }
+
+    /* Leftover. */
+    ma_pcm_s32_to_f32__optimized(dst_f32 + i, src_s32 + i, count - i, ditherMode);
+}
+#endif
+#if defined(MA_SUPPORT_AVX2)
+static MA_INLINE void ma_pcm_s32_to_f32__avx2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
+{
+    float* dst_f32 = (float*)dst;
+    const ma_int32* src_s32 = (const ma_int32*)src;
+    ma_uint64 count16 = count & ~(ma_uint64)15;
+    ma_uint64 i;
+
+    for (i = 0; i < count16; i += 16) {
+        __m256 a = _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*)(src_s32 + i + 0)));
+        __m256 b = _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*)(src_s32 + i + 8)));
+
+        _mm256_storeu_ps(dst_f32 + i + 0, _mm256_mul_ps(a, _mm256_set1_ps(0.0000000004656612873077392578125f)));
+        _mm256_storeu_ps(dst_f32 + i + 8, _mm256_mul_ps(b, _mm256_set1_ps(0.0000000004656612873077392578125f)));
+    }
+
+    /* Leftover. */
+    ma_pcm_s32_to_f32__optimized(dst_f32 + i, src_s32 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_s32_to_f32__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_s32_to_f32__optimized(dst, src, count, ditherMode);
+    float* dst_f32 = (float*)dst;
+    const ma_int32* src_s32 = (const ma_int32*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        vst1q_f32(dst_f32 + i + 0, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(src_s32 + i + 0)), 0.0000000004656612873077392578125f));
+        vst1q_f32(dst_f32 + i + 4, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(src_s32 + i + 4)), 0.0000000004656612873077392578125f));
+    }
+
+    /* Leftover. */
+    ma_pcm_s32_to_f32__optimized(dst_f32 + i, src_s32 + i, count - i, ditherMode);
 }
 #endif
 
@@ -44312,6 +46378,11 @@ MA_API void ma_pcm_s32_to_f32(void* dst, const void* src, ma_uint64 count, ma_di
 #ifdef MA_USE_REFERENCE_CONVERSION_APIS
     ma_pcm_s32_to_f32__reference(dst, src, count, ditherMode);
 #else
+    #  if defined(MA_SUPPORT_AVX2)
+        if (ma_has_avx2()) {
+            ma_pcm_s32_to_f32__avx2(dst, src, count, ditherMode);
+        } else
+    #  endif
     #  if defined(MA_SUPPORT_SSE2)
         if (ma_has_sse2()) {
             ma_pcm_s32_to_f32__sse2(dst, src, count, ditherMode);
@@ -44420,13 +46491,71 @@ static MA_INLINE void ma_pcm_f32_to_u8__optimized(void* dst, const void* src, ma
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_f32_to_u8__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_f32_to_u8__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_u8 = (ma_uint8*)dst;
+    const float* src_f32 = (const float*)src;
+    ma_uint64 count16 = count & ~(ma_uint64)15;
+    ma_uint64 i;
+    float dither[16];
+
+    for (i = 0; i < count16; i += 16) {
+        __m128 x[4];
+        ma_uint32 j;
+
+        for (j = 0; j < 4; j += 1) {
+            x[j] = _mm_loadu_ps(src_f32 + i + j*4);
+        }
+
+        if (ditherMode != ma_dither_mode_none) {
+            ma_dither_f32_array(ditherMode, 1.0f / -128, 1.0f / 127, dither, 16);
+            for (j = 0; j < 4; j += 1) {
+                x[j] = _mm_add_ps(x[j], _mm_loadu_ps(dither + j*4));
+            }
+        }
+
+        for (j = 0; j < 4; j += 1) {
+            x[j] = _mm_min_ps(_mm_max_ps(x[j], _mm_set1_ps(-1)), _mm_set1_ps(1));     /* clip */
+            x[j] = _mm_mul_ps(_mm_add_ps(x[j], _mm_set1_ps(1)), _mm_set1_ps(127.5f));   /* -1..1 to 0..255 */
+        }
+
+        _mm_storeu_si128((__m128i*)(dst_u8 + i), _mm_packus_epi16(
+            _mm_packs_epi32(_mm_cvttps_epi32(x[0]), _mm_cvttps_epi32(x[1])),
+            _mm_packs_epi32(_mm_cvttps_epi32(x[2]), _mm_cvttps_epi32(x[3]))
+        ));
+    }
+
+    /* Leftover. */
+    ma_pcm_f32_to_u8__optimized(dst_u8 + i, src_f32 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_f32_to_u8__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_f32_to_u8__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_u8 = (ma_uint8*)dst;
+    const float* src_f32 = (const float*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+    float dither[8];
+
+    for (i = 0; i < count8; i += 8) {
+        float32x4_t a = vld1q_f32(src_f32 + i + 0);
+        float32x4_t b = vld1q_f32(src_f32 + i + 4);
+
+        if (ditherMode != ma_dither_mode_none) {
+            ma_dither_f32_array(ditherMode, 1.0f / -128, 1.0f / 127, dither, 8);
+            a = vaddq_f32(a, vld1q_f32(dither + 0));
+            b = vaddq_f32(b, vld1q_f32(dither + 4));
+        }
+
+        a = vminq_f32(vmaxq_f32(a, vdupq_n_f32(-1)), vdupq_n_f32(1));
+        b = vminq_f32(vmaxq_f32(b, vdupq_n_f32(-1)), vdupq_n_f32(1));
+        a = vmulq_n_f32(vaddq_f32(a, vdupq_n_f32(1)), 127.5f);
+        b = vmulq_n_f32(vaddq_f32(b, vdupq_n_f32(1)), 127.5f);
+
+        vst1_u8(dst_u8 + i, vqmovun_s16(vcombine_s16(vmovn_s32(vcvtq_s32_f32(a)), vmovn_s32(vcvtq_s32_f32(b)))));
+    }
+
+    /* Leftover. */
+    ma_pcm_f32_to_u8__optimized(dst_u8 + i, src_f32 + i, count - i, ditherMode);
 }
 #endif
 
@@ -44450,7 +46579,6 @@ MA_API void ma_pcm_f32_to_u8(void* dst, const void* src, ma_uint64 count, ma_dit
 #endif
 }
 
-#ifdef MA_USE_REFERENCE_CONVERSION_APIS
 static MA_INLINE void ma_pcm_f32_to_s16__reference(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
     ma_uint64 i;
@@ -44483,7 +46611,7 @@ static MA_INLINE void ma_pcm_f32_to_s16__reference(void* dst, const void* src, m
         dst_s16[i] = (ma_int16)x;
     }
 }
-#else
+
 static MA_INLINE void ma_pcm_f32_to_s16__optimized(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
     ma_uint64 i;
@@ -44551,212 +46679,114 @@ static MA_INLINE void ma_pcm_f32_to_s16__optimized(void* dst, const void* src, m
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_f32_to_s16__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
+    ma_int16* dst_s16 = (ma_int16*)dst;
+    const float* src_f32 = (const float*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
     ma_uint64 i;
-    ma_uint64 i8;
-    ma_uint64 count8;
-    ma_int16* dst_s16;
-    const float* src_f32;
-    float ditherMin;
-    float ditherMax;
-
-    /* Both the input and output buffers need to be aligned to 16 bytes. */
-    if ((((ma_uintptr)dst & 15) != 0) || (((ma_uintptr)src & 15) != 0)) {
-        ma_pcm_f32_to_s16__optimized(dst, src, count, ditherMode);
-        return;
-    }
-
-    dst_s16 = (ma_int16*)dst;
-    src_f32 = (const float*)src;
-
-    ditherMin = 0;
-    ditherMax = 0;
-    if (ditherMode != ma_dither_mode_none) {
-        ditherMin = 1.0f / -32768;
-        ditherMax = 1.0f /  32767;
-    }
-
-    i = 0;
+    float dither[8];
 
     /* SSE2. SSE allows us to output 8 s16's at a time which means our loop is unrolled 8 times. */
-    count8 = count >> 3;
-    for (i8 = 0; i8 < count8; i8 += 1) {
-        __m128 d0;
-        __m128 d1;
-        __m128 x0;
-        __m128 x1;
-
-        if (ditherMode == ma_dither_mode_none) {
-            d0 = _mm_set1_ps(0);
-            d1 = _mm_set1_ps(0);
-        } else if (ditherMode == ma_dither_mode_rectangle) {
-            d0 = _mm_set_ps(
-                ma_dither_f32_rectangle(ditherMin, ditherMax),
-                ma_dither_f32_rectangle(ditherMin, ditherMax),
-                ma_dither_f32_rectangle(ditherMin, ditherMax),
-                ma_dither_f32_rectangle(ditherMin, ditherMax)
-            );
-            d1 = _mm_set_ps(
-                ma_dither_f32_rectangle(ditherMin, ditherMax),
-                ma_dither_f32_rectangle(ditherMin, ditherMax),
-                ma_dither_f32_rectangle(ditherMin, ditherMax),
-                ma_dither_f32_rectangle(ditherMin, ditherMax)
-            );
-        } else {
-            d0 = _mm_set_ps(
-                ma_dither_f32_triangle(ditherMin, ditherMax),
-                ma_dither_f32_triangle(ditherMin, ditherMax),
-                ma_dither_f32_triangle(ditherMin, ditherMax),
-                ma_dither_f32_triangle(ditherMin, ditherMax)
-            );
-            d1 = _mm_set_ps(
-                ma_dither_f32_triangle(ditherMin, ditherMax),
-                ma_dither_f32_triangle(ditherMin, ditherMax),
-                ma_dither_f32_triangle(ditherMin, ditherMax),
-                ma_dither_f32_triangle(ditherMin, ditherMax)
-            );
-        }
+    for (i = 0; i < count8; i += 8) {
+        __m128 x0 = _mm_loadu_ps(src_f32 + i + 0);
+        __m128 x1 = _mm_loadu_ps(src_f32 + i + 4);
 
-        x0 = *((__m128*)(src_f32 + i) + 0);
-        x1 = *((__m128*)(src_f32 + i) + 1);
+        if (ditherMode != ma_dither_mode_none) {
+            ma_dither_f32_array(ditherMode, 1.0f / -32768, 1.0f / 32767, dither, 8);
+            x0 = _mm_add_ps(x0, _mm_loadu_ps(dither + 0));
+            x1 = _mm_add_ps(x1, _mm_loadu_ps(dither + 4));
+        }
 
-        x0 = _mm_add_ps(x0, d0);
-        x1 = _mm_add_ps(x1, d1);
+        x0 = _mm_min_ps(_mm_max_ps(x0, _mm_set1_ps(-1)), _mm_set1_ps(1));
+        x1 = _mm_min_ps(_mm_max_ps(x1, _mm_set1_ps(-1)), _mm_set1_ps(1));
 
         x0 = _mm_mul_ps(x0, _mm_set1_ps(32767.0f));
         x1 = _mm_mul_ps(x1, _mm_set1_ps(32767.0f));
 
-        _mm_stream_si128(((__m128i*)(dst_s16 + i)), _mm_packs_epi32(_mm_cvttps_epi32(x0), _mm_cvttps_epi32(x1)));
-
-        i += 8;
+        _mm_storeu_si128((__m128i*)(dst_s16 + i), _mm_packs_epi32(_mm_cvttps_epi32(x0), _mm_cvttps_epi32(x1)));
     }
 
-
     /* Leftover. */
-    for (; i < count; i += 1) {
-        float x = src_f32[i];
-        x = x + ma_dither_f32(ditherMode, ditherMin, ditherMax);
-        x = ((x < -1) ? -1 : ((x > 1) ? 1 : x));    /* clip */
-        x = x * 32767.0f;                           /* -1..1 to -32767..32767 */
-
-        dst_s16[i] = (ma_int16)x;
-    }
+    ma_pcm_f32_to_s16__optimized(dst_s16 + i, src_f32 + i, count - i, ditherMode);
 }
 #endif  /* SSE2 */
 
-#if defined(MA_SUPPORT_NEON)
-static MA_INLINE void ma_pcm_f32_to_s16__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
+#if defined(MA_SUPPORT_AVX2)
+static MA_INLINE void ma_pcm_f32_to_s16__avx2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
+    ma_int16* dst_s16 = (ma_int16*)dst;
+    const float* src_f32 = (const float*)src;
+    ma_uint64 count16 = count & ~(ma_uint64)15;
     ma_uint64 i;
-    ma_uint64 i8;
-    ma_uint64 count8;
-    ma_int16* dst_s16;
-    const float* src_f32;
-    float ditherMin;
-    float ditherMax;
-
-    if (!ma_has_neon()) {
-        ma_pcm_f32_to_s16__optimized(dst, src, count, ditherMode);
-        return;
-    }
+    float dither[16];
 
-    /* Both the input and output buffers need to be aligned to 16 bytes. */
-    if ((((ma_uintptr)dst & 15) != 0) || (((ma_uintptr)src & 15) != 0)) {
-        ma_pcm_f32_to_s16__optimized(dst, src, count, ditherMode);
-        return;
-    }
+    for (i = 0; i < count16; i += 16) {
+        __m256 x0 = _mm256_loadu_ps(src_f32 + i + 0);
+        __m256 x1 = _mm256_loadu_ps(src_f32 + i + 8);
 
-    dst_s16 = (ma_int16*)dst;
-    src_f32 = (const float*)src;
+        if (ditherMode != ma_dither_mode_none) {
+            ma_dither_f32_array(ditherMode, 1.0f / -32768, 1.0f / 32767, dither, 16);
+            x0 = _mm256_add_ps(x0, _mm256_loadu_ps(dither + 0));
+            x1 = _mm256_add_ps(x1, _mm256_loadu_ps(dither + 8));
+        }
 
-    ditherMin = 0;
-    ditherMax = 0;
-    if (ditherMode != ma_dither_mode_none) {
-        ditherMin = 1.0f / -32768;
-        ditherMax = 1.0f /  32767;
+        x0 = _mm256_min_ps(_mm256_max_ps(x0, _mm256_set1_ps(-1)), _mm256_set1_ps(1));
+        x1 = _mm256_min_ps(_mm256_max_ps(x1, _mm256_set1_ps(-1)), _mm256_set1_ps(1));
+
+        x0 = _mm256_mul_ps(x0, _mm256_set1_ps(32767.0f));
+        x1 = _mm256_mul_ps(x1, _mm256_set1_ps(32767.0f));
+
+        _mm256_storeu_si256((__m256i*)(dst_s16 + i), ma_pcm_packs_epi32__avx2(_mm256_cvttps_epi32(x0), _mm256_cvttps_epi32(x1)));
     }
 
-    i = 0;
+    /* Leftover. */
+    ma_pcm_f32_to_s16__optimized(dst_s16 + i, src_f32 + i, count - i, ditherMode);
+}
+#endif  /* AVX2 */
 
-    /* NEON. NEON allows us to output 8 s16's at a time which means our loop is unrolled 8 times. */
-    count8 = count >> 3;
-    for (i8 = 0; i8 < count8; i8 += 1) {
-        float32x4_t d0;
-        float32x4_t d1;
-        float32x4_t x0;
-        float32x4_t x1;
-        int32x4_t i0;
-        int32x4_t i1;
-
-        if (ditherMode == ma_dither_mode_none) {
-            d0 = vmovq_n_f32(0);
-            d1 = vmovq_n_f32(0);
-        } else if (ditherMode == ma_dither_mode_rectangle) {
-            float d0v[4];
-            float d1v[4];
-
-            d0v[0] = ma_dither_f32_rectangle(ditherMin, ditherMax);
-            d0v[1] = ma_dither_f32_rectangle(ditherMin, ditherMax);
-            d0v[2] = ma_dither_f32_rectangle(ditherMin, ditherMax);
-            d0v[3] = ma_dither_f32_rectangle(ditherMin, ditherMax);
-            d0 = vld1q_f32(d0v);
-
-            d1v[0] = ma_dither_f32_rectangle(ditherMin, ditherMax);
-            d1v[1] = ma_dither_f32_rectangle(ditherMin, ditherMax);
-            d1v[2] = ma_dither_f32_rectangle(ditherMin, ditherMax);
-            d1v[3] = ma_dither_f32_rectangle(ditherMin, ditherMax);
-            d1 = vld1q_f32(d1v);
-        } else {
-            float d0v[4];
-            float d1v[4];
+#if defined(MA_SUPPORT_NEON)
+static MA_INLINE void ma_pcm_f32_to_s16__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
+{
+    ma_int16* dst_s16 = (ma_int16*)dst;
+    const float* src_f32 = (const float*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+    float dither[8];
 
-            d0v[0] = ma_dither_f32_triangle(ditherMin, ditherMax);
-            d0v[1] = ma_dither_f32_triangle(ditherMin, ditherMax);
-            d0v[2] = ma_dither_f32_triangle(ditherMin, ditherMax);
-            d0v[3] = ma_dither_f32_triangle(ditherMin, ditherMax);
-            d0 = vld1q_f32(d0v);
+    /* NEON. NEON allows us to output 8 s16's at a time which means our loop is unrolled 8 times. */
+    for (i = 0; i < count8; i += 8) {
+        float32x4_t x0 = vld1q_f32(src_f32 + i + 0);
+        float32x4_t x1 = vld1q_f32(src_f32 + i + 4);
 
-            d1v[0] = ma_dither_f32_triangle(ditherMin, ditherMax);
-            d1v[1] = ma_dither_f32_triangle(ditherMin, ditherMax);
-            d1v[2] = ma_dither_f32_triangle(ditherMin, ditherMax);
-            d1v[3] = ma_dither_f32_triangle(ditherMin, ditherMax);
-            d1 = vld1q_f32(d1v);
+        if (ditherMode != ma_dither_mode_none) {
+            ma_dither_f32_array(ditherMode, 1.0f / -32768, 1.0f / 32767, dither, 8);
+            x0 = vaddq_f32(x0, vld1q_f32(dither + 0));
+            x1 = vaddq_f32(x1, vld1q_f32(dither + 4));
         }
 
-        x0 = *((float32x4_t*)(src_f32 + i) + 0);
-        x1 = *((float32x4_t*)(src_f32 + i) + 1);
-
-        x0 = vaddq_f32(x0, d0);
-        x1 = vaddq_f32(x1, d1);
+        x0 = vminq_f32(vmaxq_f32(x0, vdupq_n_f32(-1)), vdupq_n_f32(1));
+        x1 = vminq_f32(vmaxq_f32(x1, vdupq_n_f32(-1)), vdupq_n_f32(1));
 
         x0 = vmulq_n_f32(x0, 32767.0f);
         x1 = vmulq_n_f32(x1, 32767.0f);
 
-        i0 = vcvtq_s32_f32(x0);
-        i1 = vcvtq_s32_f32(x1);
-        *((int16x8_t*)(dst_s16 + i)) = vcombine_s16(vqmovn_s32(i0), vqmovn_s32(i1));
-
-        i += 8;
+        vst1q_s16(dst_s16 + i, vcombine_s16(vmovn_s32(vcvtq_s32_f32(x0)), vmovn_s32(vcvtq_s32_f32(x1))));
     }
 
-
     /* Leftover. */
-    for (; i < count; i += 1) {
-        float x = src_f32[i];
-        x = x + ma_dither_f32(ditherMode, ditherMin, ditherMax);
-        x = ((x < -1) ? -1 : ((x > 1) ? 1 : x));    /* clip */
-        x = x * 32767.0f;                           /* -1..1 to -32767..32767 */
-
-        dst_s16[i] = (ma_int16)x;
-    }
+    ma_pcm_f32_to_s16__optimized(dst_s16 + i, src_f32 + i, count - i, ditherMode);
 }
 #endif  /* Neon */
-#endif  /* MA_USE_REFERENCE_CONVERSION_APIS */
 
 MA_API void ma_pcm_f32_to_s16(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
 #ifdef MA_USE_REFERENCE_CONVERSION_APIS
     ma_pcm_f32_to_s16__reference(dst, src, count, ditherMode);
 #else
+    #  if defined(MA_SUPPORT_AVX2)
+        if (ma_has_avx2()) {
+            ma_pcm_f32_to_s16__avx2(dst, src, count, ditherMode);
+        } else
+    #  endif
     #  if defined(MA_SUPPORT_SSE2)
         if (ma_has_sse2()) {
             ma_pcm_f32_to_s16__sse2(dst, src, count, ditherMode);
@@ -44811,13 +46841,43 @@ static MA_INLINE void ma_pcm_f32_to_s24__optimized(void* dst, const void* src, m
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_f32_to_s24__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_f32_to_s24__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_s24 = (ma_uint8*)dst;
+    const float* src_f32 = (const float*)src;
+    ma_uint64 count4 = count & ~(ma_uint64)3;
+    ma_uint64 i;
+
+    for (i = 0; i < count4; i += 4) {
+        __m128 x = _mm_loadu_ps(src_f32 + i);
+        x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-1)), _mm_set1_ps(1));
+        x = _mm_mul_ps(x, _mm_set1_ps(8388607.0f));
+
+        ma_pcm_store_s24x4__sse2(dst_s24 + i*3, _mm_cvttps_epi32(x));
+    }
+
+    /* Leftover. */
+    ma_pcm_f32_to_s24__optimized(dst_s24 + i*3, src_f32 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_f32_to_s24__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_f32_to_s24__optimized(dst, src, count, ditherMode);
+    ma_uint8* dst_s24 = (ma_uint8*)dst;
+    const float* src_f32 = (const float*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        float32x4_t a = vld1q_f32(src_f32 + i + 0);
+        float32x4_t b = vld1q_f32(src_f32 + i + 4);
+
+        a = vmulq_n_f32(vminq_f32(vmaxq_f32(a, vdupq_n_f32(-1)), vdupq_n_f32(1)), 8388607.0f);
+        b = vmulq_n_f32(vminq_f32(vmaxq_f32(b, vdupq_n_f32(-1)), vdupq_n_f32(1)), 8388607.0f);
+
+        ma_pcm_store_s24x8__neon(dst_s24 + i*3, vcvtq_s32_f32(a), vcvtq_s32_f32(b));
+    }
+
+    /* Leftover. */
+    ma_pcm_f32_to_s24__optimized(dst_s24 + i*3, src_f32 + i, count - i, ditherMode);
 }
 #endif
 
@@ -44876,13 +46936,76 @@ static MA_INLINE void ma_pcm_f32_to_s32__optimized(void* dst, const void* src, m
 #if defined(MA_SUPPORT_SSE2)
 static MA_INLINE void ma_pcm_f32_to_s32__sse2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
-    ma_pcm_f32_to_s32__optimized(dst, src, count, ditherMode);
+    ma_int32* dst_s32 = (ma_int32*)dst;
+    const float* src_f32 = (const float*)src;
+    ma_uint64 count4 = count & ~(ma_uint64)3;
+    ma_uint64 i;
+
+    /* Single precision isn't enough for a 32-bit result so this is done in double precision like the reference implementation. */
+    for (i = 0; i < count4; i += 4) {
+        __m128  x  = _mm_loadu_ps(src_f32 + i);
+        __m128d lo = _mm_cvtps_pd(x);
+        __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+
+        lo = _mm_mul_pd(_mm_min_pd(_mm_max_pd(lo, _mm_set1_pd(-1)), _mm_set1_pd(1)), _mm_set1_pd(2147483647.0));
+        hi = _mm_mul_pd(_mm_min_pd(_mm_max_pd(hi, _mm_set1_pd(-1)), _mm_set1_pd(1)), _mm_set1_pd(2147483647.0));
+
+        _mm_storeu_si128((__m128i*)(dst_s32 + i), _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi)));
+    }
+
+    /* Leftover. */
+    ma_pcm_f32_to_s32__optimized(dst_s32 + i, src_f32 + i, count - i, ditherMode);
+}
+#endif
+#if defined(MA_SUPPORT_AVX2)
+static MA_INLINE void ma_pcm_f32_to_s32__avx2(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
+{
+    ma_int32* dst_s32 = (ma_int32*)dst;
+    const float* src_f32 = (const float*)src;
+    ma_uint64 count8 = count & ~(ma_uint64)7;
+    ma_uint64 i;
+
+    for (i = 0; i < count8; i += 8) {
+        __m256d lo = _mm256_cvtps_pd(_mm_loadu_ps(src_f32 + i + 0));
+        __m256d hi = _mm256_cvtps_pd(_mm_loadu_ps(src_f32 + i + 4));
+
+        lo = _mm256_mul_pd(_mm256_min_pd(_mm256_max_pd(lo, _mm256_set1_pd(-1)), _mm256_set1_pd(1)), _mm256_set1_pd(2147483647.0));
+        hi = _mm256_mul_pd(_mm256_min_pd(_mm256_max_pd(hi, _mm256_set1_pd(-1)), _mm256_set1_pd(1)), _mm256_set1_pd(2147483647.0));
+
+        _mm_storeu_si128((__m128i*)(dst_s32 + i + 0), _mm256_cvttpd_epi32(lo));
+        _mm_storeu_si128((__m128i*)(dst_s32 + i + 4), _mm256_cvttpd_epi32(hi));
+    }
+
+    /* Leftover. */
+    ma_pcm_f32_to_s32__optimized(dst_s32 + i, src_f32 + i, count - i, ditherMode);
 }
 #endif
 #if defined(MA_SUPPORT_NEON)
 static MA_INLINE void ma_pcm_f32_to_s32__neon(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode)
 {
+#if defined(MA_ARM64)
+    ma_int32* dst_s32 = (ma_int32*)dst;
+    const float* src_f32 = (const float*)src;
+    ma_uint64 count4 = count & ~(ma_uint64)3;
+    ma_uint64 i;
+
+    for (i = 0; i < count4; i += 4) {
+        float32x4_t x  = vld1q_f32(src_f32 + i);
+        float64x2_t lo = vcvt_f64_f32(vget_low_f32(x));
+        float64x2_t hi = vcvt_high_f64_f32(x);
+
+        lo = vmulq_n_f64(vminq_f64(vmaxq_f64(lo, vdupq_n_f64(-1)), vdupq_n_f64(1)), 2147483647.0);
+        hi = vmulq_n_f64(vminq_f64(vmaxq_f64(hi, vdupq_n_f64(-1)), vdupq_n_f64(1)), 2147483647.0);
+
+        vst1q_s32(dst_s32 + i, vcombine_s32(vmovn_s64(vcvtq_s64_f64(lo)), vmovn_s64(vcvtq_s64_f64(hi))));
+    }
+
+    /* Leftover. */
+    ma_pcm_f32_to_s32__optimized(dst_s32 + i, src_f32 + i, count - i, ditherMode);
+#else
+    /* 32-bit NEON has no double precision vectors which we need for an exact result. */
     ma_pcm_f32_to_s32__optimized(dst, src, count, ditherMode);
+#endif
 }
 #endif
 
@@ -44891,6 +47014,11 @@ MA_API void ma_pcm_f32_to_s32(void* dst, const void* src, ma_uint64 count, ma_di
 #ifdef MA_USE_REFERENCE_CONVERSION_APIS
     ma_pcm_f32_to_s32__reference(dst, src, count, ditherMode);
 #else
+    #  if defined(MA_SUPPORT_AVX2)
+        if (ma_has_avx2()) {
+            ma_pcm_f32_to_s32__avx2(dst, src, count, ditherMode);
+        } else
+    #  endif
     #  if defined(MA_SUPPORT_SSE2)
         if (ma_has_sse2()) {
             ma_pcm_f32_to_s32__sse2(dst, src, count, ditherMode);
@@ -45051,12 +47179,255 @@ MA_API void ma_convert_pcm_frames_format(void* pOut, ma_format formatOut, const
     ma_pcm_convert(pOut, formatOut, pIn, formatIn, frameCount * channels, ditherMode);
 }
 
-MA_API void ma_deinterleave_pcm_frames(ma_format format, ma_uint32 channels, ma_uint64 frameCount, const void* pInterleavedPCMFrames, void** ppDeinterleavedPCMFrames)
+/*
+Interleaving and deinterleaving with SIMD. These work on blocks of 4 frames and 4 channels at a time
+which are transposed in registers. Channel counts that aren't a multiple of 4 are handled by having
+the last block overlap the one before it, which means 6 channels is done as channels 0-3 and 2-5.
+Stereo has its own path.
+
+Samples can be converted between s16 and f32 in the same pass. These conversions give the same
+results as `ma_pcm_s16_to_f32()` and `ma_pcm_f32_to_s16()` without dithering. When neither side is
+converted the samples are just moved around, which is how s16 to s16 and s32 to s32 work.
+*/
+static ma_bool32 ma_pcm_interleave_has_simd_path(ma_format formatOut, ma_format formatIn, ma_uint32 channels, ma_dither_mode ditherMode)
 {
-    if (pInterleavedPCMFrames == NULL || ppDeinterleavedPCMFrames == NULL) {
-        return; /* Invalid args. */
+    if (channels != 2 && channels < 4) {
+        return MA_FALSE;
+    }
+
+    if (formatOut == formatIn) {
+        return formatIn == ma_format_s16 || formatIn == ma_format_s32 || formatIn == ma_format_f32;
+    }
+
+    if (formatIn == ma_format_s16 && formatOut == ma_format_f32) {
+        return MA_TRUE;
+    }
+
+    /* Dithering is left to ma_pcm_convert(). */
+    if (formatIn == ma_format_f32 && formatOut == ma_format_s16 && ditherMode == ma_dither_mode_none) {
+        return MA_TRUE;
+    }
+
+    return MA_FALSE;
+}
+
+#if defined(MA_SUPPORT_SSE2)
+static MA_INLINE __m128 ma_pcm_interleave_load4__sse2(ma_format formatOut, ma_format formatIn, const void* pSrc)
+{
+    if (formatIn == ma_format_s16) {
+        __m128i x = _mm_srai_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), _mm_loadl_epi64((const __m128i*)pSrc)), 16);
+        if (formatOut == ma_format_s16) {
+            return _mm_castsi128_ps(x);
+        } else {
+            return _mm_mul_ps(_mm_cvtepi32_ps(x), _mm_set1_ps(0.000030517578125f));
+        }
+    } else {
+        return _mm_loadu_ps((const float*)pSrc);
+    }
+}
+
+static MA_INLINE void ma_pcm_interleave_store4__sse2(ma_format formatOut, ma_format formatIn, void* pDst, __m128 x)
+{
+    if (formatOut == ma_format_s16) {
+        __m128i s;
+        if (formatIn == ma_format_s16) {
+            s = _mm_castps_si128(x);
+        } else {
+            s = _mm_cvttps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-1)), _mm_set1_ps(1)), _mm_set1_ps(32767.0f)));
+        }
+        _mm_storel_epi64((__m128i*)pDst, _mm_packs_epi32(s, s));
+    } else {
+        _mm_storeu_ps((float*)pDst, x);
+    }
+}
+
+static MA_INLINE ma_uint64 ma_pcm_deinterleave__sse2(ma_format formatOut, ma_format formatIn, ma_uint32 channels, ma_uint64 frameCount, const void* pInterleavedPCMFrames, void** ppDeinterleavedPCMFrames)
+{
+    ma_uint32 bpsIn  = ma_get_bytes_per_sample(formatIn);
+    ma_uint32 bpsOut = ma_get_bytes_per_sample(formatOut);
+    ma_uint64 frameCount4 = frameCount & ~(ma_uint64)3;
+    ma_uint64 iFrame;
+    ma_uint32 iChannel;
+
+    for (iFrame = 0; iFrame < frameCount4; iFrame += 4) {
+        if (channels == 2) {
+            __m128 a = ma_pcm_interleave_load4__sse2(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, (iFrame*2 + 0) * bpsIn));
+            __m128 b = ma_pcm_interleave_load4__sse2(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, (iFrame*2 + 4) * bpsIn));
+            ma_pcm_interleave_store4__sse2(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[0], iFrame * bpsOut), _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            ma_pcm_interleave_store4__sse2(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[1], iFrame * bpsOut), _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        } else {
+            for (iChannel = 0; iChannel < channels; iChannel += 4) {
+                ma_uint32 iFirstChannel = (iChannel + 4 <= channels) ? iChannel : channels - 4;
+                __m128 r0 = ma_pcm_interleave_load4__sse2(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 0)*channels + iFirstChannel) * bpsIn));
+                __m128 r1 = ma_pcm_interleave_load4__sse2(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 1)*channels + iFirstChannel) * bpsIn));
+                __m128 r2 = ma_pcm_interleave_load4__sse2(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 2)*channels + iFirstChannel) * bpsIn));
+                __m128 r3 = ma_pcm_interleave_load4__sse2(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 3)*channels + iFirstChannel) * bpsIn));
+
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+                ma_pcm_interleave_store4__sse2(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 0], iFrame * bpsOut), r0);
+                ma_pcm_interleave_store4__sse2(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 1], iFrame * bpsOut), r1);
+                ma_pcm_interleave_store4__sse2(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 2], iFrame * bpsOut), r2);
+                ma_pcm_interleave_store4__sse2(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 3], iFrame * bpsOut), r3);
+            }
+        }
+    }
+
+    return frameCount4;
+}
+
+static MA_INLINE ma_uint64 ma_pcm_interleave__sse2(ma_format formatOut, ma_format formatIn, ma_uint32 channels, ma_uint64 frameCount, const void** ppDeinterleavedPCMFrames, void* pInterleavedPCMFrames)
+{
+    ma_uint32 bpsIn  = ma_get_bytes_per_sample(formatIn);
+    ma_uint32 bpsOut = ma_get_bytes_per_sample(formatOut);
+    ma_uint64 frameCount4 = frameCount & ~(ma_uint64)3;
+    ma_uint64 iFrame;
+    ma_uint32 iChannel;
+
+    for (iFrame = 0; iFrame < frameCount4; iFrame += 4) {
+        if (channels == 2) {
+            __m128 l = ma_pcm_interleave_load4__sse2(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[0], iFrame * bpsIn));
+            __m128 r = ma_pcm_interleave_load4__sse2(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[1], iFrame * bpsIn));
+            ma_pcm_interleave_store4__sse2(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, (iFrame*2 + 0) * bpsOut), _mm_unpacklo_ps(l, r));
+            ma_pcm_interleave_store4__sse2(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, (iFrame*2 + 4) * bpsOut), _mm_unpackhi_ps(l, r));
+        } else {
+            for (iChannel = 0; iChannel < channels; iChannel += 4) {
+                ma_uint32 iFirstChannel = (iChannel + 4 <= channels) ? iChannel : channels - 4;
+                __m128 r0 = ma_pcm_interleave_load4__sse2(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 0], iFrame * bpsIn));
+                __m128 r1 = ma_pcm_interleave_load4__sse2(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 1], iFrame * bpsIn));
+                __m128 r2 = ma_pcm_interleave_load4__sse2(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 2], iFrame * bpsIn));
+                __m128 r3 = ma_pcm_interleave_load4__sse2(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 3], iFrame * bpsIn));
+
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+                ma_pcm_interleave_store4__sse2(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 0)*channels + iFirstChannel) * bpsOut), r0);
+                ma_pcm_interleave_store4__sse2(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 1)*channels + iFirstChannel) * bpsOut), r1);
+                ma_pcm_interleave_store4__sse2(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 2)*channels + iFirstChannel) * bpsOut), r2);
+                ma_pcm_interleave_store4__sse2(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 3)*channels + iFirstChannel) * bpsOut), r3);
+            }
+        }
+    }
+
+    return frameCount4;
+}
+#endif
+
+#if defined(MA_SUPPORT_NEON)
+static MA_INLINE float32x4_t ma_pcm_interleave_load4__neon(ma_format formatOut, ma_format formatIn, const void* pSrc)
+{
+    if (formatIn == ma_format_s16) {
+        int32x4_t x = vmovl_s16(vld1_s16((const ma_int16*)pSrc));
+        if (formatOut == ma_format_s16) {
+            return vreinterpretq_f32_s32(x);
+        } else {
+            return vmulq_n_f32(vcvtq_f32_s32(x), 0.000030517578125f);
+        }
+    } else {
+        return vld1q_f32((const float*)pSrc);
+    }
+}
+
+static MA_INLINE void ma_pcm_interleave_store4__neon(ma_format formatOut, ma_format formatIn, void* pDst, float32x4_t x)
+{
+    if (formatOut == ma_format_s16) {
+        int32x4_t s;
+        if (formatIn == ma_format_s16) {
+            s = vreinterpretq_s32_f32(x);
+        } else {
+            s = vcvtq_s32_f32(vmulq_n_f32(vminq_f32(vmaxq_f32(x, vdupq_n_f32(-1)), vdupq_n_f32(1)), 32767.0f));
+        }
+        vst1_s16((ma_int16*)pDst, vmovn_s32(s));
+    } else {
+        vst1q_f32((float*)pDst, x);
+    }
+}
+
+static MA_INLINE void ma_pcm_transpose4__neon(float32x4_t* r0, float32x4_t* r1, float32x4_t* r2, float32x4_t* r3)
+{
+    float32x4x2_t t01 = vtrnq_f32(*r0, *r1);
+    float32x4x2_t t23 = vtrnq_f32(*r2, *r3);
+    *r0 = vcombine_f32(vget_low_f32 (t01.val[0]), vget_low_f32 (t23.val[0]));
+    *r1 = vcombine_f32(vget_low_f32 (t01.val[1]), vget_low_f32 (t23.val[1]));
+    *r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    *r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+static MA_INLINE ma_uint64 ma_pcm_deinterleave__neon(ma_format formatOut, ma_format formatIn, ma_uint32 channels, ma_uint64 frameCount, const void* pInterleavedPCMFrames, void** ppDeinterleavedPCMFrames)
+{
+    ma_uint32 bpsIn  = ma_get_bytes_per_sample(formatIn);
+    ma_uint32 bpsOut = ma_get_bytes_per_sample(formatOut);
+    ma_uint64 frameCount4 = frameCount & ~(ma_uint64)3;
+    ma_uint64 iFrame;
+    ma_uint32 iChannel;
+
+    for (iFrame = 0; iFrame < frameCount4; iFrame += 4) {
+        if (channels == 2) {
+            float32x4x2_t x = vuzpq_f32(
+                ma_pcm_interleave_load4__neon(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, (iFrame*2 + 0) * bpsIn)),
+                ma_pcm_interleave_load4__neon(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, (iFrame*2 + 4) * bpsIn)));
+            ma_pcm_interleave_store4__neon(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[0], iFrame * bpsOut), x.val[0]);
+            ma_pcm_interleave_store4__neon(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[1], iFrame * bpsOut), x.val[1]);
+        } else {
+            for (iChannel = 0; iChannel < channels; iChannel += 4) {
+                ma_uint32 iFirstChannel = (iChannel + 4 <= channels) ? iChannel : channels - 4;
+                float32x4_t r0 = ma_pcm_interleave_load4__neon(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 0)*channels + iFirstChannel) * bpsIn));
+                float32x4_t r1 = ma_pcm_interleave_load4__neon(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 1)*channels + iFirstChannel) * bpsIn));
+                float32x4_t r2 = ma_pcm_interleave_load4__neon(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 2)*channels + iFirstChannel) * bpsIn));
+                float32x4_t r3 = ma_pcm_interleave_load4__neon(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 3)*channels + iFirstChannel) * bpsIn));
+
+                ma_pcm_transpose4__neon(&r0, &r1, &r2, &r3);
+
+                ma_pcm_interleave_store4__neon(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 0], iFrame * bpsOut), r0);
+                ma_pcm_interleave_store4__neon(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 1], iFrame * bpsOut), r1);
+                ma_pcm_interleave_store4__neon(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 2], iFrame * bpsOut), r2);
+                ma_pcm_interleave_store4__neon(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 3], iFrame * bpsOut), r3);
+            }
+        }
+    }
+
+    return frameCount4;
+}
+
+static MA_INLINE ma_uint64 ma_pcm_interleave__neon(ma_format formatOut, ma_format formatIn, ma_uint32 channels, ma_uint64 frameCount, const void** ppDeinterleavedPCMFrames, void* pInterleavedPCMFrames)
+{
+    ma_uint32 bpsIn  = ma_get_bytes_per_sample(formatIn);
+    ma_uint32 bpsOut = ma_get_bytes_per_sample(formatOut);
+    ma_uint64 frameCount4 = frameCount & ~(ma_uint64)3;
+    ma_uint64 iFrame;
+    ma_uint32 iChannel;
+
+    for (iFrame = 0; iFrame < frameCount4; iFrame += 4) {
+        if (channels == 2) {
+            float32x4x2_t x = vzipq_f32(
+                ma_pcm_interleave_load4__neon(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[0], iFrame * bpsIn)),
+                ma_pcm_interleave_load4__neon(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[1], iFrame * bpsIn)));
+            ma_pcm_interleave_store4__neon(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, (iFrame*2 + 0) * bpsOut), x.val[0]);
+            ma_pcm_interleave_store4__neon(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, (iFrame*2 + 4) * bpsOut), x.val[1]);
+        } else {
+            for (iChannel = 0; iChannel < channels; iChannel += 4) {
+                ma_uint32 iFirstChannel = (iChannel + 4 <= channels) ? iChannel : channels - 4;
+                float32x4_t r0 = ma_pcm_interleave_load4__neon(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 0], iFrame * bpsIn));
+                float32x4_t r1 = ma_pcm_interleave_load4__neon(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 1], iFrame * bpsIn));
+                float32x4_t r2 = ma_pcm_interleave_load4__neon(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 2], iFrame * bpsIn));
+                float32x4_t r3 = ma_pcm_interleave_load4__neon(formatOut, formatIn, ma_offset_ptr(ppDeinterleavedPCMFrames[iFirstChannel + 3], iFrame * bpsIn));
+
+                ma_pcm_transpose4__neon(&r0, &r1, &r2, &r3);
+
+                ma_pcm_interleave_store4__neon(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 0)*channels + iFirstChannel) * bpsOut), r0);
+                ma_pcm_interleave_store4__neon(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 1)*channels + iFirstChannel) * bpsOut), r1);
+                ma_pcm_interleave_store4__neon(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 2)*channels + iFirstChannel) * bpsOut), r2);
+                ma_pcm_interleave_store4__neon(formatOut, formatIn, ma_offset_ptr(pInterleavedPCMFrames, ((iFrame + 3)*channels + iFirstChannel) * bpsOut), r3);
+            }
+        }
     }
 
+    return frameCount4;
+}
+#endif
+
+/* The scalar paths. The deinterleaved side starts at `frameOffset` so these can pick up where the SIMD paths left off. */
+static void ma_deinterleave_pcm_frames__scalar(ma_format format, ma_uint32 channels, ma_uint64 frameOffset, ma_uint64 frameCount, const void* pInterleavedPCMFrames, void** ppDeinterleavedPCMFrames)
+{
     /* For efficiency we do this per format. */
     switch (format) {
         case ma_format_s16:
@@ -45066,7 +47437,7 @@ MA_API void ma_deinterleave_pcm_frames(ma_format format, ma_uint32 channels, ma_
             for (iPCMFrame = 0; iPCMFrame < frameCount; ++iPCMFrame) {
                 ma_uint32 iChannel;
                 for (iChannel = 0; iChannel < channels; ++iChannel) {
-                    ma_int16* pDstS16 = (ma_int16*)ppDeinterleavedPCMFrames[iChannel];
+                    ma_int16* pDstS16 = (ma_int16*)ppDeinterleavedPCMFrames[iChannel] + frameOffset;
                     pDstS16[iPCMFrame] = pSrcS16[iPCMFrame*channels+iChannel];
                 }
             }
@@ -45079,7 +47450,7 @@ MA_API void ma_deinterleave_pcm_frames(ma_format format, ma_uint32 channels, ma_
             for (iPCMFrame = 0; iPCMFrame < frameCount; ++iPCMFrame) {
                 ma_uint32 iChannel;
                 for (iChannel = 0; iChannel < channels; ++iChannel) {
-                    float* pDstF32 = (float*)ppDeinterleavedPCMFrames[iChannel];
+                    float* pDstF32 = (float*)ppDeinterleavedPCMFrames[iChannel] + frameOffset;
                     pDstF32[iPCMFrame] = pSrcF32[iPCMFrame*channels+iChannel];
                 }
             }
@@ -45092,7 +47463,7 @@ MA_API void ma_deinterleave_pcm_frames(ma_format format, ma_uint32 channels, ma_
             for (iPCMFrame = 0; iPCMFrame < frameCount; ++iPCMFrame) {
                 ma_uint32 iChannel;
                 for (iChannel = 0; iChannel < channels; ++iChannel) {
-                          void* pDst = ma_offset_ptr(ppDeinterleavedPCMFrames[iChannel], iPCMFrame*sampleSizeInBytes);
+                          void* pDst = ma_offset_ptr(ppDeinterleavedPCMFrames[iChannel], (frameOffset+iPCMFrame)*sampleSizeInBytes);
                     const void* pSrc = ma_offset_ptr(pInterleavedPCMFrames, (iPCMFrame*channels+iChannel)*sampleSizeInBytes);
                     memcpy(pDst, pSrc, sampleSizeInBytes);
                 }
@@ -45101,7 +47472,7 @@ MA_API void ma_deinterleave_pcm_frames(ma_format format, ma_uint32 channels, ma_
     }
 }
 
-MA_API void ma_interleave_pcm_frames(ma_format format, ma_uint32 channels, ma_uint64 frameCount, const void** ppDeinterleavedPCMFrames, void* pInterleavedPCMFrames)
+static void ma_interleave_pcm_frames__scalar(ma_format format, ma_uint32 channels, ma_uint64 frameOffset, ma_uint64 frameCount, const void** ppDeinterleavedPCMFrames, void* pInterleavedPCMFrames)
 {
     switch (format)
     {
@@ -45112,7 +47483,7 @@ MA_API void ma_interleave_pcm_frames(ma_format format, ma_uint32 channels, ma_ui
             for (iPCMFrame = 0; iPCMFrame < frameCount; ++iPCMFrame) {
                 ma_uint32 iChannel;
                 for (iChannel = 0; iChannel < channels; ++iChannel) {
-                    const ma_int16* pSrcS16 = (const ma_int16*)ppDeinterleavedPCMFrames[iChannel];
+                    const ma_int16* pSrcS16 = (const ma_int16*)ppDeinterleavedPCMFrames[iChannel] + frameOffset;
                     pDstS16[iPCMFrame*channels+iChannel] = pSrcS16[iPCMFrame];
                 }
             }
@@ -45125,7 +47496,7 @@ MA_API void ma_interleave_pcm_frames(ma_format format, ma_uint32 channels, ma_ui
             for (iPCMFrame = 0; iPCMFrame < frameCount; ++iPCMFrame) {
                 ma_uint32 iChannel;
                 for (iChannel = 0; iChannel < channels; ++iChannel) {
-                    const float* pSrcF32 = (const float*)ppDeinterleavedPCMFrames[iChannel];
+                    const float* pSrcF32 = (const float*)ppDeinterleavedPCMFrames[iChannel] + frameOffset;
                     pDstF32[iPCMFrame*channels+iChannel] = pSrcF32[iPCMFrame];
                 }
             }
@@ -45139,7 +47510,7 @@ MA_API void ma_interleave_pcm_frames(ma_format format, ma_uint32 channels, ma_ui
                 ma_uint32 iChannel;
                 for (iChannel = 0; iChannel < channels; ++iChannel) {
                           void* pDst = ma_offset_ptr(pInterleavedPCMFrames, (iPCMFrame*channels+iChannel)*sampleSizeInBytes);
-                    const void* pSrc = ma_offset_ptr(ppDeinterleavedPCMFrames[iChannel], iPCMFrame*sampleSizeInBytes);
+                    const void* pSrc = ma_offset_ptr(ppDeinterleavedPCMFrames[iChannel], (frameOffset+iPCMFrame)*sampleSizeInBytes);
                     memcpy(pDst, pSrc, sampleSizeInBytes);
                 }
             }
@@ -45147,6 +47518,98 @@ MA_API void ma_interleave_pcm_frames(ma_format format, ma_uint32 channels, ma_ui
     }
 }
 
+MA_API void ma_deinterleave_pcm_frames_ex(ma_format formatOut, ma_format formatIn, ma_uint32 channels, ma_uint64 frameCount, const void* pInterleavedPCMFrames, void** ppDeinterleavedPCMFrames, ma_dither_mode ditherMode)
+{
+    ma_uint64 framesProcessed = 0;
+
+    if (pInterleavedPCMFrames == NULL || ppDeinterleavedPCMFrames == NULL) {
+        return; /* Invalid args. */
+    }
+
+    if (ma_pcm_interleave_has_simd_path(formatOut, formatIn, channels, ditherMode)) {
+    #if defined(MA_SUPPORT_SSE2)
+        if (ma_has_sse2()) {
+            framesProcessed = ma_pcm_deinterleave__sse2(formatOut, formatIn, channels, frameCount, pInterleavedPCMFrames, ppDeinterleavedPCMFrames);
+        } else
+    #elif defined(MA_SUPPORT_NEON)
+        if (ma_has_neon()) {
+            framesProcessed = ma_pcm_deinterleave__neon(formatOut, formatIn, channels, frameCount, pInterleavedPCMFrames, ppDeinterleavedPCMFrames);
+        } else
+    #endif
+        {
+            /* Scalar only. */
+        }
+    }
+
+    if (formatOut == formatIn) {
+        ma_deinterleave_pcm_frames__scalar(formatIn, channels, framesProcessed, frameCount - framesProcessed, ma_offset_ptr(pInterleavedPCMFrames, framesProcessed * ma_get_bytes_per_frame(formatIn, channels)), ppDeinterleavedPCMFrames);
+    } else {
+        /* Anything else is converted a chunk at a time into a stack buffer and then deinterleaved. */
+        ma_uint8 temp[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+        ma_uint32 tempCapInFrames = sizeof(temp) / ma_get_bytes_per_frame(formatOut, channels);
+
+        while (framesProcessed < frameCount) {
+            ma_uint64 framesToProcess = ma_min(frameCount - framesProcessed, tempCapInFrames);
+
+            ma_pcm_convert(temp, formatOut, ma_offset_ptr(pInterleavedPCMFrames, framesProcessed * ma_get_bytes_per_frame(formatIn, channels)), formatIn, framesToProcess * channels, ditherMode);
+            ma_deinterleave_pcm_frames__scalar(formatOut, channels, framesProcessed, framesToProcess, temp, ppDeinterleavedPCMFrames);
+
+            framesProcessed += framesToProcess;
+        }
+    }
+}
+
+MA_API void ma_interleave_pcm_frames_ex(ma_format formatOut, ma_format formatIn, ma_uint32 channels, ma_uint64 frameCount, const void** ppDeinterleavedPCMFrames, void* pInterleavedPCMFrames, ma_dither_mode ditherMode)
+{
+    ma_uint64 framesProcessed = 0;
+
+    if (pInterleavedPCMFrames == NULL || ppDeinterleavedPCMFrames == NULL) {
+        return; /* Invalid args. */
+    }
+
+    if (ma_pcm_interleave_has_simd_path(formatOut, formatIn, channels, ditherMode)) {
+    #if defined(MA_SUPPORT_SSE2)
+        if (ma_has_sse2()) {
+            framesProcessed = ma_pcm_interleave__sse2(formatOut, formatIn, channels, frameCount, ppDeinterleavedPCMFrames, pInterleavedPCMFrames);
+        } else
+    #elif defined(MA_SUPPORT_NEON)
+        if (ma_has_neon()) {
+            framesProcessed = ma_pcm_interleave__neon(formatOut, formatIn, channels, frameCount, ppDeinterleavedPCMFrames, pInterleavedPCMFrames);
+        } else
+    #endif
+        {
+            /* Scalar only. */
+        }
+    }
+
+    if (formatOut == formatIn) {
+        ma_interleave_pcm_frames__scalar(formatIn, channels, framesProcessed, frameCount - framesProcessed, ppDeinterleavedPCMFrames, ma_offset_ptr(pInterleavedPCMFrames, framesProcessed * ma_get_bytes_per_frame(formatOut, channels)));
+    } else {
+        /* Anything else is interleaved a chunk at a time into a stack buffer and then converted. */
+        ma_uint8 temp[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+        ma_uint32 tempCapInFrames = sizeof(temp) / ma_get_bytes_per_frame(formatIn, channels);
+
+        while (framesProcessed < frameCount) {
+            ma_uint64 framesToProcess = ma_min(frameCount - framesProcessed, tempCapInFrames);
+
+            ma_interleave_pcm_frames__scalar(formatIn, channels, framesProcessed, framesToProcess, ppDeinterleavedPCMFrames, temp);
+            ma_pcm_convert(ma_offset_ptr(pInterleavedPCMFrames, framesProcessed * ma_get_bytes_per_frame(formatOut, channels)), formatOut, temp, formatIn, framesToProcess * channels, ditherMode);
+
+            framesProcessed += framesToProcess;
+        }
+    }
+}
+
+MA_API void ma_deinterleave_pcm_frames(ma_format format, ma_uint32 channels, ma_uint64 frameCount, const void* pInterleavedPCMFrames, void** ppDeinterleavedPCMFrames)
+{
+    ma_deinterleave_pcm_frames_ex(format, format, channels, frameCount, pInterleavedPCMFrames, ppDeinterleavedPCMFrames, ma_dither_mode_none);
+}
+
+MA_API void ma_interleave_pcm_frames(ma_format format, ma_uint32 channels, ma_uint64 frameCount, const void** ppDeinterleavedPCMFrames, void* pInterleavedPCMFrames)
+{
+    ma_interleave_pcm_frames_ex(format, format, channels, frameCount, ppDeinterleavedPCMFrames, pInterleavedPCMFrames, ma_dither_mode_none);
+}
+
 
 /**************************************************************************************************************************************************************
 
@@ -50089,6 +52552,13 @@ static ma_result ma_spatializer_validate_config(const ma_spatializer_config* pCo
         return MA_INVALID_ARGS;
     }
 
+    /* When encoding to an ambisonic bus the output channel count must match the order. */
+    if (pConfig->ambisonicOrder > 0) {
+        if (pConfig->ambisonicOrder > MA_AMBISONIC_MAX_ORDER || pConfig->channelsOut != ma_ambisonic_get_channel_count(pConfig->ambisonicOrder)) {
+            return MA_INVALID_ARGS;
+        }
+    }
+
     return MA_SUCCESS;
 }
 
@@ -50212,6 +52682,7 @@ MA_API ma_result ma_spatializer_init_preallocated(const ma_spatializer_config* p
     pSpatializer->minSpatializationChannelGain = pConfig->minSpatializationChannelGain;
     pSpatializer->directionalAttenuationFactor = pConfig->directionalAttenuationFactor;
     pSpatializer->gainSmoothTimeInFrames       = pConfig->gainSmoothTimeInFrames;
+    pSpatializer->ambisonicOrder               = pConfig->ambisonicOrder;
     ma_atomic_vec3f_init(&pSpatializer->position,  ma_vec3f_init_3f(0, 0,  0));
     ma_atomic_vec3f_init(&pSpatializer->direction, ma_vec3f_init_3f(0, 0, -1));
     ma_atomic_vec3f_init(&pSpatializer->velocity,  ma_vec3f_init_3f(0, 0,  0));
@@ -50331,6 +52802,292 @@ static float ma_calculate_angular_gain(ma_vec3f dirA, ma_vec3f dirB, float coneI
     }
 }
 
+static float ma_spatializer_calculate_gain(ma_spatializer* pSpatializer, ma_spatializer_listener* pListener, ma_vec3f relativePos, ma_vec3f relativeDir)
+{
+    /* Calculates the distance and angular attenuation of a sound at the given position and direction relative to the listener. */
+    ma_vec3f relativePosNormalized;
+    float distance;
+    float gain;
+    float minDistance = ma_spatializer_get_min_distance(pSpatializer);
+    float maxDistance = ma_spatializer_get_max_distance(pSpatializer);
+    float rolloff = ma_spatializer_get_rolloff(pSpatializer);
+
+    distance = ma_vec3f_len(relativePos);
+
+    /* We've gathered the data, so now we can apply some spatialization. */
+    switch (ma_spatializer_get_attenuation_model(pSpatializer)) {
+        case ma_attenuation_model_inverse:
+        {
+            gain = ma_attenuation_inverse(distance, minDistance, maxDistance, rolloff);
+        } break;
+        case ma_attenuation_model_linear:
+        {
+            gain = ma_attenuation_linear(distance, minDistance, maxDistance, rolloff);
+        } break;
+        case ma_attenuation_model_exponential:
+        {
+            gain = ma_attenuation_exponential(distance, minDistance, maxDistance, rolloff);
+        } break;
+        case ma_attenuation_model_none:
+        default:
+        {
+            gain = 1;
+        } break;
+    }
+
+    /* Normalize the position. */
+    if (distance > 0.001f) {
+        float distanceInv = 1/distance;
+        relativePosNormalized    = relativePos;
+        relativePosNormalized.x *= distanceInv;
+        relativePosNormalized.y *= distanceInv;
+        relativePosNormalized.z *= distanceInv;
+    } else {
+        distance = 0;
+        relativePosNormalized = ma_vec3f_init_3f(0, 0, 0);
+    }
+
+    /*
+    Angular attenuation.
+
+    Unlike distance gain, the math for this is not specified by the OpenAL spec so we'll just go ahead and figure
+    this out for ourselves at the expense of possibly being inconsistent with other implementations.
+
+    To do cone attenuation, I'm just using the same math that we'd use to implement a basic spotlight in OpenGL. We
+    just need to get the direction from the source to the listener and then do a dot product against that and the
+    direction of the spotlight. Then we just compare that dot product against the cosine of the inner and outer
+    angles. If the dot product is greater than the the outer angle, we just use coneOuterGain. If it's less than
+    the inner angle, we just use a gain of 1. Otherwise we linearly interpolate between 1 and coneOuterGain.
+    */
+    if (distance > 0) {
+        /* Source anglular gain. */
+        float spatializerConeInnerAngle = 0;
+        float spatializerConeOuterAngle = 0;
+        float spatializerConeOuterGain  = 0;
+        ma_spatializer_get_cone(pSpatializer, &spatializerConeInnerAngle, &spatializerConeOuterAngle, &spatializerConeOuterGain);
+
+        gain *= ma_calculate_angular_gain(relativeDir, ma_vec3f_neg(relativePosNormalized), spatializerConeInnerAngle, spatializerConeOuterAngle, spatializerConeOuterGain);
+
+        /*
+        We're supporting angular gain on the listener as well for those who want to reduce the volume of sounds that
+        are positioned behind the listener. On default settings, this will have no effect.
+        */
+        if (pListener != NULL && pListener->config.coneInnerAngleInRadians < 6.283185f) {
+            ma_vec3f listenerDirection;
+            float listenerInnerAngle;
+            float listenerOuterAngle;
+            float listenerOuterGain;
+
+            if (pListener->config.handedness == ma_handedness_right) {
+                listenerDirection = ma_vec3f_init_3f(0, 0, -1);
+            } else {
+                listenerDirection = ma_vec3f_init_3f(0, 0, +1);
+            }
+
+            listenerInnerAngle = pListener->config.coneInnerAngleInRadians;
+            listenerOuterAngle = pListener->config.coneOuterAngleInRadians;
+            listenerOuterGain  = pListener->config.coneOuterGain;
+
+            gain *= ma_calculate_angular_gain(listenerDirection, relativePosNormalized, listenerInnerAngle, listenerOuterAngle, listenerOuterGain);
+        }
+    } else {
+        /* The sound is right on top of the listener. Don't do any angular attenuation. */
+    }
+
+
+    /* Clamp the gain. */
+    gain = ma_clamp(gain, ma_spatializer_get_min_gain(pSpatializer), ma_spatializer_get_max_gain(pSpatializer));
+
+    return gain;
+}
+
+static void ma_ambisonic_encode_omni_f32(float* pFramesOut, ma_uint32 channelsOut, const float* pFramesIn, ma_uint32 channelsIn, ma_uint64 frameCount, float volume, ma_bool32 isOmniOnly);
+
+/*
+Applies the spatialization gains to a block of frames. The gain is the combined distance and cone attenuation. The unit
+position is the normalized position of the sound relative to the listener and is only used when the distance is greater
+than zero.
+*/
+static void ma_spatializer_apply_gain_and_panning(ma_spatializer* pSpatializer, ma_spatializer_listener* pListener, void* pFramesOut, const void* pFramesIn, ma_uint64 frameCount, float gain, float distance, ma_vec3f unitPos)
+{
+    ma_channel* pChannelMapIn  = pSpatializer->pChannelMapIn;
+    ma_channel* pChannelMapOut = pListener->config.pChannelMapOut;
+    const ma_uint32 channelsOut = pSpatializer->channelsOut;
+    const ma_uint32 channelsIn  = pSpatializer->channelsIn;
+    ma_uint32 iChannel;
+
+    /*
+    The gain needs to be applied per-channel here. The spatialization code below will be changing the per-channel
+    gains which will then eventually be passed into the gainer which will deal with smoothing the gain transitions
+    to avoid harsh changes in gain.
+    */
+    for (iChannel = 0; iChannel < channelsOut; iChannel += 1) {
+        pSpatializer->pNewChannelGainsOut[iChannel] = gain;
+    }
+
+    /*
+    Convert to our output channel count. If the listener is disabled we just output silence here. We cannot ignore
+    the whole section of code here because we need to update some internal spatialization state.
+    */
+    if (ma_spatializer_listener_is_enabled(pListener)) {
+        if (pSpatializer->ambisonicOrder > 0) {
+            /* The source is encoded as mono. The encoding gains are applied by the gainer below. */
+            ma_ambisonic_encode_omni_f32((float*)pFramesOut, channelsOut, (const float*)pFramesIn, channelsIn, frameCount, 1, MA_FALSE);
+        } else {
+            ma_channel_map_apply_f32((float*)pFramesOut, pChannelMapOut, channelsOut, (const float*)pFramesIn, pChannelMapIn, channelsIn, frameCount, ma_channel_mix_mode_rectangular, ma_mono_expansion_mode_default);
+        }
+    } else {
+        ma_silence_pcm_frames(pFramesOut, frameCount, ma_format_f32, pSpatializer->channelsOut);
+    }
+
+
+    /*
+    Panning. This is where we'll apply the gain and convert to the output channel count. We have an optimized path for
+    when we're converting to a mono stream. In that case we don't really need to do any panning - we just apply the
+    gain to the final output.
+    */
+    /*printf("distance=%f; gain=%f\n", distance, gain);*/
+
+    /* We must have a valid channel map here to ensure we spatialize properly. */
+    MA_ASSERT(pChannelMapOut != NULL || pSpatializer->ambisonicOrder > 0);
+
+    /*
+    We're not converting to mono so we'll want to apply some panning. This is where the feeling of something being
+    to the left, right, infront or behind the listener is calculated. I'm just using a basic model here. Note that
+    the code below is not based on any specific algorithm. I'm just implementing this off the top of my head and
+    seeing how it goes. There might be better ways to do this.
+
+    To determine the direction of the sound relative to a speaker I'm using dot products. Each speaker is given a
+    direction. For example, the left channel in a stereo system will be -1 on the X axis and the right channel will
+    be +1 on the X axis. A dot product is performed against the direction vector of the channel and the normalized
+    position of the sound.
+    */
+
+    /*
+    Calculate our per-channel gains. We do this based on the normalized relative position of the sound and it's
+    relation to the direction of the channel.
+    */
+    if (pSpatializer->ambisonicOrder > 0) {
+        /*
+        For an ambisonic bus the per-channel gains are the encoding coefficients of the source direction. The
+        directional attenuation factor scales the directional components so that a factor of 0 results in an
+        omnidirectional source, consistent with the speaker panning path below.
+        */
+        float encodingGains[MA_AMBISONIC_MAX_CHANNELS];
+
+        if (distance > 0) {
+            float directionalGain = gain * ma_spatializer_get_directional_attenuation_factor(pSpatializer);
+
+            ma_ambisonic_encode(pSpatializer->ambisonicOrder, unitPos, encodingGains);
+
+            for (iChannel = 1; iChannel < channelsOut; iChannel += 1) {
+                pSpatializer->pNewChannelGainsOut[iChannel] = directionalGain * encodingGains[iChannel];
+            }
+        } else {
+            /* Right on top of the listener. There's no direction so only the omnidirectional component is used. */
+            for (iChannel = 1; iChannel < channelsOut; iChannel += 1) {
+                pSpatializer->pNewChannelGainsOut[iChannel] = 0;
+            }
+        }
+    } else if (distance > 0) {
+        for (iChannel = 0; iChannel < channelsOut; iChannel += 1) {
+            ma_channel channelOut;
+            float d;
+            float dMin;
+
+            channelOut = ma_channel_map_get_channel(pChannelMapOut, channelsOut, iChannel);
+            if (ma_is_spatial_channel_position(channelOut)) {
+                d = ma_mix_f32_fast(1, ma_vec3f_dot(unitPos, ma_get_channel_direction(channelOut)), ma_spatializer_get_directional_attenuation_factor(pSpatializer));
+            } else {
+                d = 1;  /* It's not a spatial channel so there's no real notion of direction. */
+            }
+
+            /*
+            In my testing, if the panning effect is too aggressive it makes spatialization feel uncomfortable.
+            The "dMin" variable below is used to control the aggressiveness of the panning effect. When set to
+            0, panning will be most extreme and any sounds that are positioned on the opposite side of the
+            speaker will be completely silent from that speaker. Not only does this feel uncomfortable, it
+            doesn't even remotely represent the real world at all because sounds that come from your right side
+            are still clearly audible from your left side. Setting "dMin" to 1 will result in no panning at
+            all, which is also not ideal. By setting it to something greater than 0, the spatialization effect
+            becomes much less dramatic and a lot more bearable.
+
+            Summary: 0 = more extreme panning; 1 = no panning.
+            */
+            dMin = pSpatializer->minSpatializationChannelGain;
+
+            /*
+            At this point, "d" will be positive if the sound is on the same side as the channel and negative if
+            it's on the opposite side. It will be in the range of -1..1. There's two ways I can think of to
+            calculate a panning value. The first is to simply convert it to 0..1, however this has a problem
+            which I'm not entirely happy with. Considering a stereo system, when a sound is positioned right
+            in front of the listener it'll result in each speaker getting a gain of 0.5. I don't know if I like
+            the idea of having a scaling factor of 0.5 being applied to a sound when it's sitting right in front
+            of the listener. I would intuitively expect that to be played at full volume, or close to it.
+
+            The second idea I think of is to only apply a reduction in gain when the sound is on the opposite
+            side of the speaker. That is, reduce the gain only when the dot product is negative. The problem
+            with this is that there will not be any attenuation as the sound sweeps around the 180 degrees
+            where the dot product is positive. The idea with this option is that you leave the gain at 1 when
+            the sound is being played on the same side as the speaker and then you just reduce the volume when
+            the sound is on the other side.
+
+            The summarize, I think the first option should give a better sense of spatialization, but the second
+            option is better for preserving the sound's power.
+
+            UPDATE: In my testing, I find the first option to sound better. You can feel the sense of space a
+            bit better, but you can also hear the reduction in volume when it's right in front.
+            */
+            #if 1
+            {
+                /*
+                Scale the dot product from -1..1 to 0..1. Will result in a sound directly in front losing power
+                by being played at 0.5 gain.
+                */
+                d = (d + 1) * 0.5f;  /* -1..1 to 0..1 */
+                d = ma_max(d, dMin);
+                pSpatializer->pNewChannelGainsOut[iChannel] *= d;
+            }
+            #else
+            {
+                /*
+                Only reduce the volume of the sound if it's on the opposite side. This path keeps the volume more
+                consistent, but comes at the expense of a worse sense of space and positioning.
+                */
+                if (d < 0) {
+                    d += 1; /* Move into the positive range. */
+                    d = ma_max(d, dMin);
+                    channelGainsOut[iChannel] *= d;
+                }
+            }
+            #endif
+        }
+    } else {
+        /* Assume the sound is right on top of us. Don't do any panning. */
+    }
+
+    /*
+    Now we need to apply the volume to each channel. This needs to run through the gainer to ensure we get a smooth volume transition. When
+    a tolerance is set, small changes are ignored which lets the gainer stay on its constant gain path. Larger changes are still smoothed.
+    */
+    if (pSpatializer->gainTolerance > 0 && pSpatializer->gainer.t != (ma_uint32)-1) {
+        for (iChannel = 0; iChannel < channelsOut; iChannel += 1) {
+            float currentGain = pSpatializer->gainer.pNewGains[iChannel];
+            if (ma_abs(pSpatializer->pNewChannelGainsOut[iChannel] - currentGain) > pSpatializer->gainTolerance * ma_abs(currentGain)) {
+                break;
+            }
+        }
+
+        if (iChannel < channelsOut) {
+            ma_gainer_set_gains(&pSpatializer->gainer, pSpatializer->pNewChannelGainsOut);
+        }
+    } else {
+        ma_gainer_set_gains(&pSpatializer->gainer, pSpatializer->pNewChannelGainsOut);
+    }
+
+    ma_gainer_process_pcm_frames(&pSpatializer->gainer, pFramesOut, pFramesOut, frameCount);
+}
+
 MA_API ma_result ma_spatializer_process_pcm_frames(ma_spatializer* pSpatializer, ma_spatializer_listener* pListener, void* pFramesOut, const void* pFramesIn, ma_uint64 frameCount)
 {
     ma_channel* pChannelMapIn  = pSpatializer->pChannelMapIn;
@@ -50344,7 +53101,10 @@ MA_API ma_result ma_spatializer_process_pcm_frames(ma_spatializer* pSpatializer,
     if (ma_atomic_load_i32(&pSpatializer->attenuationModel) == ma_attenuation_model_none) {
         if (ma_spatializer_listener_is_enabled(pListener)) {
             /* No attenuation is required, but we'll need to do some channel conversion. */
-            if (pSpatializer->channelsIn == pSpatializer->channelsOut) {
+            if (pSpatializer->ambisonicOrder > 0) {
+                /* Without any attenuation there's no direction so we just encode an omnidirectional source. */
+                ma_ambisonic_encode_omni_f32((float*)pFramesOut, pSpatializer->channelsOut, (const float*)pFramesIn, pSpatializer->channelsIn, frameCount, 1, MA_TRUE);
+            } else if (pSpatializer->channelsIn == pSpatializer->channelsOut) {
                 ma_copy_pcm_frames(pFramesOut, pFramesIn, frameCount, ma_format_f32, pSpatializer->channelsIn);
             } else {
                 ma_channel_map_apply_f32((float*)pFramesOut, pChannelMapOut, pSpatializer->channelsOut, (const float*)pFramesIn, pChannelMapIn, pSpatializer->channelsIn, frameCount, ma_channel_mix_mode_rectangular, ma_mono_expansion_mode_default);   /* Safe casts to float* because f32 is the only supported format. */
@@ -50365,19 +53125,13 @@ MA_API ma_result ma_spatializer_process_pcm_frames(ma_spatializer* pSpatializer,
         might not have a world or any listeners, in which case we just spatializer based on the
         listener being positioned at the origin (0, 0, 0).
         */
-        ma_vec3f relativePosNormalized;
         ma_vec3f relativePos;   /* The position relative to the listener. */
         ma_vec3f relativeDir;   /* The direction of the sound, relative to the listener. */
         ma_vec3f listenerVel;   /* The volocity of the listener. For doppler pitch calculation. */
+        ma_vec3f unitPos;       /* The normalized position relative to the listener. For panning. */
         float speedOfSound;
         float distance = 0;
         float gain = 1;
-        ma_uint32 iChannel;
-        const ma_uint32 channelsOut = pSpatializer->channelsOut;
-        const ma_uint32 channelsIn  = pSpatializer->channelsIn;
-        float minDistance = ma_spatializer_get_min_distance(pSpatializer);
-        float maxDistance = ma_spatializer_get_max_distance(pSpatializer);
-        float rolloff = ma_spatializer_get_rolloff(pSpatializer);
         float dopplerFactor = ma_spatializer_get_doppler_factor(pSpatializer);
 
         /*
@@ -50405,224 +53159,20 @@ MA_API ma_result ma_spatializer_process_pcm_frames(ma_spatializer* pSpatializer,
             ma_spatializer_get_relative_position_and_direction(pSpatializer, pListener, &relativePos, &relativeDir);
         }
 
-        distance = ma_vec3f_len(relativePos);
-
-        /* We've gathered the data, so now we can apply some spatialization. */
-        switch (ma_spatializer_get_attenuation_model(pSpatializer)) {
-            case ma_attenuation_model_inverse:
-            {
-                gain = ma_attenuation_inverse(distance, minDistance, maxDistance, rolloff);
-            } break;
-            case ma_attenuation_model_linear:
-            {
-                gain = ma_attenuation_linear(distance, minDistance, maxDistance, rolloff);
-            } break;
-            case ma_attenuation_model_exponential:
-            {
-                gain = ma_attenuation_exponential(distance, minDistance, maxDistance, rolloff);
-            } break;
-            case ma_attenuation_model_none:
-            default:
-            {
-                gain = 1;
-            } break;
-        }
-
-        /* Normalize the position. */
-        if (distance > 0.001f) {
-            float distanceInv = 1/distance;
-            relativePosNormalized    = relativePos;
-            relativePosNormalized.x *= distanceInv;
-            relativePosNormalized.y *= distanceInv;
-            relativePosNormalized.z *= distanceInv;
-        } else {
-            distance = 0;
-            relativePosNormalized = ma_vec3f_init_3f(0, 0, 0);
-        }
-
-        /*
-        Angular attenuation.
-
-        Unlike distance gain, the math for this is not specified by the OpenAL spec so we'll just go ahead and figure
-        this out for ourselves at the expense of possibly being inconsistent with other implementations.
-
-        To do cone attenuation, I'm just using the same math that we'd use to implement a basic spotlight in OpenGL. We
-        just need to get the direction from the source to the listener and then do a dot product against that and the
-        direction of the spotlight. Then we just compare that dot product against the cosine of the inner and outer
-        angles. If the dot product is greater than the the outer angle, we just use coneOuterGain. If it's less than
-        the inner angle, we just use a gain of 1. Otherwise we linearly interpolate between 1 and coneOuterGain.
-        */
-        if (distance > 0) {
-            /* Source anglular gain. */
-            float spatializerConeInnerAngle;
-            float spatializerConeOuterAngle;
-            float spatializerConeOuterGain;
-            ma_spatializer_get_cone(pSpatializer, &spatializerConeInnerAngle, &spatializerConeOuterAngle, &spatializerConeOuterGain);
-
-            gain *= ma_calculate_angular_gain(relativeDir, ma_vec3f_neg(relativePosNormalized), spatializerConeInnerAngle, spatializerConeOuterAngle, spatializerConeOuterGain);
-
-            /*
-            We're supporting angular gain on the listener as well for those who want to reduce the volume of sounds that
-            are positioned behind the listener. On default settings, this will have no effect.
-            */
-            if (pListener != NULL && pListener->config.coneInnerAngleInRadians < 6.283185f) {
-                ma_vec3f listenerDirection;
-                float listenerInnerAngle;
-                float listenerOuterAngle;
-                float listenerOuterGain;
-
-                if (pListener->config.handedness == ma_handedness_right) {
-                    listenerDirection = ma_vec3f_init_3f(0, 0, -1);
-                } else {
-                    listenerDirection = ma_vec3f_init_3f(0, 0, +1);
-                }
-
-                listenerInnerAngle = pListener->config.coneInnerAngleInRadians;
-                listenerOuterAngle = pListener->config.coneOuterAngleInRadians;
-                listenerOuterGain  = pListener->config.coneOuterGain;
-
-                gain *= ma_calculate_angular_gain(listenerDirection, relativePosNormalized, listenerInnerAngle, listenerOuterAngle, listenerOuterGain);
-            }
-        } else {
-            /* The sound is right on top of the listener. Don't do any angular attenuation. */
-        }
-
-
-        /* Clamp the gain. */
-        gain = ma_clamp(gain, ma_spatializer_get_min_gain(pSpatializer), ma_spatializer_get_max_gain(pSpatializer));
+        gain = ma_spatializer_calculate_gain(pSpatializer, pListener, relativePos, relativeDir);
 
-        /*
-        The gain needs to be applied per-channel here. The spatialization code below will be changing the per-channel
-        gains which will then eventually be passed into the gainer which will deal with smoothing the gain transitions
-        to avoid harsh changes in gain.
-        */
-        for (iChannel = 0; iChannel < channelsOut; iChannel += 1) {
-            pSpatializer->pNewChannelGainsOut[iChannel] = gain;
-        }
-
-        /*
-        Convert to our output channel count. If the listener is disabled we just output silence here. We cannot ignore
-        the whole section of code here because we need to update some internal spatialization state.
-        */
-        if (ma_spatializer_listener_is_enabled(pListener)) {
-            ma_channel_map_apply_f32((float*)pFramesOut, pChannelMapOut, channelsOut, (const float*)pFramesIn, pChannelMapIn, channelsIn, frameCount, ma_channel_mix_mode_rectangular, ma_mono_expansion_mode_default);
+        distance = ma_vec3f_len(relativePos);
+        if (distance <= 0.001f) {
+            distance = 0;   /* The sound is right on top of the listener. Don't do any panning. */
+            unitPos  = ma_vec3f_init_3f(0, 0, 0);
         } else {
-            ma_silence_pcm_frames(pFramesOut, frameCount, ma_format_f32, pSpatializer->channelsOut);
-        }
-
-
-        /*
-        Panning. This is where we'll apply the gain and convert to the output channel count. We have an optimized path for
-        when we're converting to a mono stream. In that case we don't really need to do any panning - we just apply the
-        gain to the final output.
-        */
-        /*printf("distance=%f; gain=%f\n", distance, gain);*/
-
-        /* We must have a valid channel map here to ensure we spatialize properly. */
-        MA_ASSERT(pChannelMapOut != NULL);
-
-        /*
-        We're not converting to mono so we'll want to apply some panning. This is where the feeling of something being
-        to the left, right, infront or behind the listener is calculated. I'm just using a basic model here. Note that
-        the code below is not based on any specific algorithm. I'm just implementing this off the top of my head and
-        seeing how it goes. There might be better ways to do this.
-
-        To determine the direction of the sound relative to a speaker I'm using dot products. Each speaker is given a
-        direction. For example, the left channel in a stereo system will be -1 on the X axis and the right channel will
-        be +1 on the X axis. A dot product is performed against the direction vector of the channel and the normalized
-        position of the sound.
-        */
-
-        /*
-        Calculate our per-channel gains. We do this based on the normalized relative position of the sound and it's
-        relation to the direction of the channel.
-        */
-        if (distance > 0) {
-            ma_vec3f unitPos = relativePos;
             float distanceInv = 1/distance;
-            unitPos.x *= distanceInv;
-            unitPos.y *= distanceInv;
-            unitPos.z *= distanceInv;
-
-            for (iChannel = 0; iChannel < channelsOut; iChannel += 1) {
-                ma_channel channelOut;
-                float d;
-                float dMin;
-
-                channelOut = ma_channel_map_get_channel(pChannelMapOut, channelsOut, iChannel);
-                if (ma_is_spatial_channel_position(channelOut)) {
-                    d = ma_mix_f32_fast(1, ma_vec3f_dot(unitPos, ma_get_channel_direction(channelOut)), ma_spatializer_get_directional_attenuation_factor(pSpatializer));
-                } else {
-                    d = 1;  /* It's not a spatial channel so there's no real notion of direction. */
-                }
-
-                /*
-                In my testing, if the panning effect is too aggressive it makes spatialization feel uncomfortable.
-                The "dMin" variable below is used to control the aggressiveness of the panning effect. When set to
-                0, panning will be most extreme and any sounds that are positioned on the opposite side of the
-                speaker will be completely silent from that speaker. Not only does this feel uncomfortable, it
-                doesn't even remotely represent the real world at all because sounds that come from your right side
-                are still clearly audible from your left side. Setting "dMin" to 1 will result in no panning at
-                all, which is also not ideal. By setting it to something greater than 0, the spatialization effect
-                becomes much less dramatic and a lot more bearable.
-
-                Summary: 0 = more extreme panning; 1 = no panning.
-                */
-                dMin = pSpatializer->minSpatializationChannelGain;
-
-                /*
-                At this point, "d" will be positive if the sound is on the same side as the channel and negative if
-                it's on the opposite side. It will be in the range of -1..1. There's two ways I can think of to
-                calculate a panning value. The first is to simply convert it to 0..1, however this has a problem
-                which I'm not entirely happy with. Considering a stereo system, when a sound is positioned right
-                in front of the listener it'll result in each speaker getting a gain of 0.5. I don't know if I like
-                the idea of having a scaling factor of 0.5 being applied to a sound when it's sitting right in front
-                of the listener. I would intuitively expect that to be played at full volume, or close to it.
-
-                The second idea I think of is to only apply a reduction in gain when the sound is on the opposite
-                side of the speaker. That is, reduce the gain only when the dot product is negative. The problem
-                with this is that there will not be any attenuation as the sound sweeps around the 180 degrees
-                where the dot product is positive. The idea with this option is that you leave the gain at 1 when
-                the sound is being played on the same side as the speaker and then you just reduce the volume when
-                the sound is on the other side.
-
-                The summarize, I think the first option should give a better sense of spatialization, but the second
-                option is better for preserving the sound's power.
-
-                UPDATE: In my testing, I find the first option to sound better. You can feel the sense of space a
-                bit better, but you can also hear the reduction in volume when it's right in front.
-                */
-                #if 1
-                {
-                    /*
-                    Scale the dot product from -1..1 to 0..1. Will result in a sound directly in front losing power
-                    by being played at 0.5 gain.
-                    */
-                    d = (d + 1) * 0.5f;  /* -1..1 to 0..1 */
-                    d = ma_max(d, dMin);
-                    pSpatializer->pNewChannelGainsOut[iChannel] *= d;
-                }
-                #else
-                {
-                    /*
-                    Only reduce the volume of the sound if it's on the opposite side. This path keeps the volume more
-                    consistent, but comes at the expense of a worse sense of space and positioning.
-                    */
-                    if (d < 0) {
-                        d += 1; /* Move into the positive range. */
-                        d = ma_max(d, dMin);
-                        channelGainsOut[iChannel] *= d;
-                    }
-                }
-                #endif
-            }
-        } else {
-            /* Assume the sound is right on top of us. Don't do any panning. */
+            unitPos.x = relativePos.x * distanceInv;
+            unitPos.y = relativePos.y * distanceInv;
+            unitPos.z = relativePos.z * distanceInv;
         }
 
-        /* Now we need to apply the volume to each channel. This needs to run through the gainer to ensure we get a smooth volume transition. */
-        ma_gainer_set_gains(&pSpatializer->gainer, pSpatializer->pNewChannelGainsOut);
-        ma_gainer_process_pcm_frames(&pSpatializer->gainer, pFramesOut, pFramesOut, frameCount);
+        ma_spatializer_apply_gain_and_panning(pSpatializer, pListener, pFramesOut, pFramesIn, frameCount, gain, distance, unitPos);
 
         /*
         Before leaving we'll want to update our doppler pitch so that the caller can apply some
@@ -50922,6 +53472,52 @@ MA_API ma_vec3f ma_spatializer_get_velocity(const ma_spatializer* pSpatializer)
     return ma_atomic_vec3f_get((ma_atomic_vec3f*)&pSpatializer->velocity);  /* Naughty const-cast. It's just for atomically loading the vec3 which should be safe. */
 }
 
+static void ma_spatializer_listener_get_view_matrix(const ma_spatializer_listener* pListener, float m[4][4])
+{
+    ma_vec3f listenerPosition;
+    ma_vec3f listenerDirection;
+    ma_vec3f axisX;
+    ma_vec3f axisY;
+    ma_vec3f axisZ;
+
+    listenerPosition  = ma_spatializer_listener_get_position(pListener);
+    listenerDirection = ma_spatializer_listener_get_direction(pListener);
+
+    /*
+    We need to calcualte the right vector from our forward and up vectors. This is done with
+    a cross product.
+    */
+    axisZ = ma_vec3f_normalize(listenerDirection);                                  /* Normalization required here because we can't trust the caller. */
+    axisX = ma_vec3f_normalize(ma_vec3f_cross(axisZ, pListener->config.worldUp));   /* Normalization required here because the world up vector may not be perpendicular with the forward vector. */
+
+    /*
+    The calculation of axisX above can result in a zero-length vector if the listener is
+    looking straight up on the Y axis. We'll need to fall back to a +X in this case so that
+    the calculations below don't fall apart. This is where a quaternion based listener and
+    sound orientation would come in handy.
+    */
+    if (ma_vec3f_len2(axisX) == 0) {
+        axisX = ma_vec3f_init_3f(1, 0, 0);
+    }
+
+    axisY = ma_vec3f_cross(axisX, axisZ);                                           /* No normalization is required here because axisX and axisZ are unit length and perpendicular. */
+
+    /*
+    We need to swap the X axis if we're left handed because otherwise the cross product above
+    will have resulted in it pointing in the wrong direction (right handed was assumed in the
+    cross products above).
+    */
+    if (pListener->config.handedness == ma_handedness_left) {
+        axisX = ma_vec3f_neg(axisX);
+    }
+
+    /* Lookat. */
+    m[0][0] =  axisX.x; m[1][0] =  axisX.y; m[2][0] =  axisX.z; m[3][0] = -ma_vec3f_dot(axisX,               listenerPosition);
+    m[0][1] =  axisY.x; m[1][1] =  axisY.y; m[2][1] =  axisY.z; m[3][1] = -ma_vec3f_dot(axisY,               listenerPosition);
+    m[0][2] = -axisZ.x; m[1][2] = -axisZ.y; m[2][2] = -axisZ.z; m[3][2] = -ma_vec3f_dot(ma_vec3f_neg(axisZ), listenerPosition);
+    m[0][3] = 0;        m[1][3] = 0;        m[2][3] = 0;        m[3][3] = 1;
+}
+
 MA_API void ma_spatializer_get_relative_position_and_direction(const ma_spatializer* pSpatializer, const ma_spatializer_listener* pListener, ma_vec3f* pRelativePos, ma_vec3f* pRelativeDir)
 {
     if (pRelativePos != NULL) {
@@ -50951,52 +53547,14 @@ MA_API void ma_spatializer_get_relative_position_and_direction(const ma_spatiali
     } else {
         ma_vec3f spatializerPosition;
         ma_vec3f spatializerDirection;
-        ma_vec3f listenerPosition;
-        ma_vec3f listenerDirection;
         ma_vec3f v;
-        ma_vec3f axisX;
-        ma_vec3f axisY;
-        ma_vec3f axisZ;
         float m[4][4];
 
         spatializerPosition  = ma_spatializer_get_position(pSpatializer);
         spatializerDirection = ma_spatializer_get_direction(pSpatializer);
-        listenerPosition     = ma_spatializer_listener_get_position(pListener);
-        listenerDirection    = ma_spatializer_listener_get_direction(pListener);
-
-        /*
-        We need to calcualte the right vector from our forward and up vectors. This is done with
-        a cross product.
-        */
-        axisZ = ma_vec3f_normalize(listenerDirection);                                  /* Normalization required here because we can't trust the caller. */
-        axisX = ma_vec3f_normalize(ma_vec3f_cross(axisZ, pListener->config.worldUp));   /* Normalization required here because the world up vector may not be perpendicular with the forward vector. */
-
-        /*
-        The calculation of axisX above can result in a zero-length vector if the listener is
-        looking straight up on the Y axis. We'll need to fall back to a +X in this case so that
-        the calculations below don't fall apart. This is where a quaternion based listener and
-        sound orientation would come in handy.
-        */
-        if (ma_vec3f_len2(axisX) == 0) {
-            axisX = ma_vec3f_init_3f(1, 0, 0);
-        }
 
-        axisY = ma_vec3f_cross(axisX, axisZ);                                           /* No normalization is required here because axisX and axisZ are unit length and perpendicular. */
-
-        /*
-        We need to swap the X axis if we're left handed because otherwise the cross product above
-        will have resulted in it pointing in the wrong direction (right handed was assumed in the
-        cross products above).
-        */
-        if (pListener->config.handedness == ma_handedness_left) {
-            axisX = ma_vec3f_neg(axisX);
-        }
-
-        /* Lookat. */
-        m[0][0] =  axisX.x; m[1][0] =  axisX.y; m[2][0] =  axisX.z; m[3][0] = -ma_vec3f_dot(axisX,               listenerPosition);
-        m[0][1] =  axisY.x; m[1][1] =  axisY.y; m[2][1] =  axisY.z; m[3][1] = -ma_vec3f_dot(axisY,               listenerPosition);
-        m[0][2] = -axisZ.x; m[1][2] = -axisZ.y; m[2][2] = -axisZ.z; m[3][2] = -ma_vec3f_dot(ma_vec3f_neg(axisZ), listenerPosition);
-        m[0][3] = 0;        m[1][3] = 0;        m[2][3] = 0;        m[3][3] = 1;
+        /* The lookat matrix of the listener. This transforms from world space to listener space. */
+        ma_spatializer_listener_get_view_matrix(pListener, m);
 
         /*
         Multiply the lookat matrix by the spatializer position to transform it to listener
@@ -51025,176 +53583,718 @@ MA_API void ma_spatializer_get_relative_position_and_direction(const ma_spatiali
 
 
 
-
-/**************************************************************************************************************************************************************
-
-Resampling
-
-**************************************************************************************************************************************************************/
-MA_API ma_linear_resampler_config ma_linear_resampler_config_init(ma_format format, ma_uint32 channels, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut)
+MA_API ma_spatializer_batch_config ma_spatializer_batch_config_init(ma_uint32 capacity)
 {
-    ma_linear_resampler_config config;
+    ma_spatializer_batch_config config;
+
     MA_ZERO_OBJECT(&config);
-    config.format           = format;
-    config.channels         = channels;
-    config.sampleRateIn     = sampleRateIn;
-    config.sampleRateOut    = sampleRateOut;
-    config.lpfOrder         = ma_min(MA_DEFAULT_RESAMPLER_LPF_ORDER, MA_MAX_FILTER_ORDER);
-    config.lpfNyquistFactor = 1;
+    config.capacity = capacity;
 
     return config;
 }
 
 
+#define MA_SPATIALIZER_BATCH_FLOAT_ARRAY_COUNT  24  /* 18 inputs and 6 outputs. */
+#define MA_SPATIALIZER_BATCH_INT_ARRAY_COUNT    3   /* Attenuation model, positioning and listener index. */
+
 typedef struct
 {
     size_t sizeInBytes;
-    size_t x0Offset;
-    size_t x1Offset;
-    size_t lpfOffset;
-} ma_linear_resampler_heap_layout;
+    size_t arraySizeInBytes;    /* The size of each individual array, including padding. Every array is the same size. */
+} ma_spatializer_batch_heap_layout;
 
-
-static void ma_linear_resampler_adjust_timer_for_new_rate(ma_linear_resampler* pResampler, ma_uint32 oldSampleRateOut, ma_uint32 newSampleRateOut)
+static ma_result ma_spatializer_batch_get_heap_layout(const ma_spatializer_batch_config* pConfig, ma_spatializer_batch_heap_layout* pHeapLayout)
 {
-    /*
-    So what's happening here? Basically we need to adjust the fractional component of the time advance based on the new rate. The old time advance will
-    be based on the old sample rate, but we are needing to adjust it to that it's based on the new sample rate.
-    */
-    ma_uint32 oldRateTimeWhole = pResampler->inTimeFrac / oldSampleRateOut;  /* <-- This should almost never be anything other than 0, but leaving it here to make this more general and robust just in case. */
-    ma_uint32 oldRateTimeFract = pResampler->inTimeFrac % oldSampleRateOut;
+    MA_ASSERT(pHeapLayout != NULL);
 
-    pResampler->inTimeFrac =
-         (oldRateTimeWhole * newSampleRateOut) +
-        ((oldRateTimeFract * newSampleRateOut) / oldSampleRateOut);
+    MA_ZERO_OBJECT(pHeapLayout);
 
-    /* Make sure the fractional part is less than the output sample rate. */
-    pResampler->inTimeInt += pResampler->inTimeFrac / pResampler->config.sampleRateOut;
-    pResampler->inTimeFrac = pResampler->inTimeFrac % pResampler->config.sampleRateOut;
+    if (pConfig == NULL || pConfig->capacity == 0) {
+        return MA_INVALID_ARGS;
+    }
+
+    /* All arrays are 4 bytes per element so they can share the same size. Aligning each one keeps them on their own cache lines. */
+    MA_ASSERT(sizeof(float) == sizeof(ma_int32));
+    pHeapLayout->arraySizeInBytes = ma_align_64(sizeof(float) * pConfig->capacity);
+    pHeapLayout->sizeInBytes      = pHeapLayout->arraySizeInBytes * (MA_SPATIALIZER_BATCH_FLOAT_ARRAY_COUNT + MA_SPATIALIZER_BATCH_INT_ARRAY_COUNT);
+
+    return MA_SUCCESS;
 }
 
-static ma_result ma_linear_resampler_set_rate_internal(ma_linear_resampler* pResampler, void* pHeap, ma_linear_resampler_heap_layout* pHeapLayout, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut, ma_bool32 isResamplerAlreadyInitialized)
+MA_API ma_result ma_spatializer_batch_get_heap_size(const ma_spatializer_batch_config* pConfig, size_t* pHeapSizeInBytes)
 {
     ma_result result;
-    ma_uint32 gcf;
-    ma_uint32 lpfSampleRate;
-    double lpfCutoffFrequency;
-    ma_lpf_config lpfConfig;
-    ma_uint32 oldSampleRateOut; /* Required for adjusting time advance down the bottom. */
+    ma_spatializer_batch_heap_layout heapLayout;
 
-    if (pResampler == NULL) {
+    if (pHeapSizeInBytes == NULL) {
         return MA_INVALID_ARGS;
     }
 
-    if (sampleRateIn == 0 || sampleRateOut == 0) {
-        return MA_INVALID_ARGS;
+    *pHeapSizeInBytes = 0;
+
+    result = ma_spatializer_batch_get_heap_layout(pConfig, &heapLayout);
+    if (result != MA_SUCCESS) {
+        return result;
     }
 
-    oldSampleRateOut = pResampler->config.sampleRateOut;
+    *pHeapSizeInBytes = heapLayout.sizeInBytes;
 
-    pResampler->config.sampleRateIn  = sampleRateIn;
-    pResampler->config.sampleRateOut = sampleRateOut;
+    return MA_SUCCESS;
+}
 
-    /* Simplify the sample rate. */
-    gcf = ma_gcf_u32(pResampler->config.sampleRateIn, pResampler->config.sampleRateOut);
-    pResampler->config.sampleRateIn  /= gcf;
-    pResampler->config.sampleRateOut /= gcf;
+MA_API ma_result ma_spatializer_batch_init_preallocated(const ma_spatializer_batch_config* pConfig, void* pHeap, ma_spatializer_batch* pBatch)
+{
+    ma_result result;
+    ma_spatializer_batch_heap_layout heapLayout;
+    size_t offset = 0;
 
-    /* Always initialize the low-pass filter, even when the order is 0. */
-    if (pResampler->config.lpfOrder > MA_MAX_FILTER_ORDER) {
+    if (pBatch == NULL) {
         return MA_INVALID_ARGS;
     }
 
-    lpfSampleRate      = (ma_uint32)(ma_max(pResampler->config.sampleRateIn, pResampler->config.sampleRateOut));
-    lpfCutoffFrequency = (   double)(ma_min(pResampler->config.sampleRateIn, pResampler->config.sampleRateOut) * 0.5 * pResampler->config.lpfNyquistFactor);
+    MA_ZERO_OBJECT(pBatch);
 
-    lpfConfig = ma_lpf_config_init(pResampler->config.format, pResampler->config.channels, lpfSampleRate, lpfCutoffFrequency, pResampler->config.lpfOrder);
+    result = ma_spatializer_batch_get_heap_layout(pConfig, &heapLayout);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
 
-    /*
-    If the resampler is alreay initialized we don't want to do a fresh initialization of the low-pass filter because it will result in the cached frames
-    getting cleared. Instead we re-initialize the filter which will maintain any cached frames.
-    */
-    if (isResamplerAlreadyInitialized) {
-        result = ma_lpf_reinit(&lpfConfig, &pResampler->lpf);
-    } else {
-        result = ma_lpf_init_preallocated(&lpfConfig, ma_offset_ptr(pHeap, pHeapLayout->lpfOffset), &pResampler->lpf);
+    if (pHeap == NULL) {
+        return MA_INVALID_ARGS;
     }
 
+    pBatch->_pHeap = pHeap;
+    MA_ZERO_MEMORY(pHeap, heapLayout.sizeInBytes);
+
+    pBatch->capacity = pConfig->capacity;
+    pBatch->count    = 0;
+
+    #define MA_SPATIALIZER_BATCH_NEXT_ARRAY(type) (type*)ma_offset_ptr(pHeap, offset); offset += heapLayout.arraySizeInBytes
+    pBatch->pPositionX          = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pPositionY          = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pPositionZ          = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pDirectionX         = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pDirectionY         = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pDirectionZ         = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pVelocityX          = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pVelocityY          = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pVelocityZ          = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pMinDistance        = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pMaxDistance        = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pRolloff            = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pMinGain            = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pMaxGain            = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pConeInnerCos       = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pConeOuterCos       = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pConeOuterGain      = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pDopplerFactor      = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pGain               = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pDistance           = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pRelativeDirectionX = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pRelativeDirectionY = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pRelativeDirectionZ = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pDopplerPitch       = MA_SPATIALIZER_BATCH_NEXT_ARRAY(float);
+    pBatch->pAttenuationModel   = MA_SPATIALIZER_BATCH_NEXT_ARRAY(ma_int32);
+    pBatch->pPositioning        = MA_SPATIALIZER_BATCH_NEXT_ARRAY(ma_int32);
+    pBatch->pListenerIndex      = MA_SPATIALIZER_BATCH_NEXT_ARRAY(ma_uint32);
+    #undef MA_SPATIALIZER_BATCH_NEXT_ARRAY
+
+    MA_ASSERT(offset == heapLayout.sizeInBytes);
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_spatializer_batch_init(const ma_spatializer_batch_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_spatializer_batch* pBatch)
+{
+    ma_result result;
+    size_t heapSizeInBytes;
+    void* pHeap;
+
+    result = ma_spatializer_batch_get_heap_size(pConfig, &heapSizeInBytes);
     if (result != MA_SUCCESS) {
         return result;
     }
 
+    pHeap = ma_malloc(heapSizeInBytes, pAllocationCallbacks);
+    if (pHeap == NULL) {
+        return MA_OUT_OF_MEMORY;
+    }
 
-    pResampler->inAdvanceInt  = pResampler->config.sampleRateIn / pResampler->config.sampleRateOut;
-    pResampler->inAdvanceFrac = pResampler->config.sampleRateIn % pResampler->config.sampleRateOut;
+    result = ma_spatializer_batch_init_preallocated(pConfig, pHeap, pBatch);
+    if (result != MA_SUCCESS) {
+        ma_free(pHeap, pAllocationCallbacks);
+        return result;
+    }
 
-    /* Our timer was based on the old rate. We need to adjust it so that it's based on the new rate. */
-    ma_linear_resampler_adjust_timer_for_new_rate(pResampler, oldSampleRateOut, pResampler->config.sampleRateOut);
+    pBatch->_ownsHeap = MA_TRUE;
+    return MA_SUCCESS;
+}
+
+MA_API void ma_spatializer_batch_uninit(ma_spatializer_batch* pBatch, const ma_allocation_callbacks* pAllocationCallbacks)
+{
+    if (pBatch == NULL) {
+        return;
+    }
+
+    if (pBatch->_ownsHeap) {
+        ma_free(pBatch->_pHeap, pAllocationCallbacks);
+    }
+}
+
+static float ma_spatializer_batch_cone_cos(float angleInRadians)
+{
+    return (float)ma_cosd(angleInRadians*0.5f);
+}
+
+MA_API ma_result ma_spatializer_batch_set_source(ma_spatializer_batch* pBatch, ma_uint32 index, const ma_spatializer* pSpatializer, ma_uint32 listenerIndex)
+{
+    ma_vec3f position;
+    ma_vec3f direction;
+    ma_vec3f velocity;
+    float coneInnerAngle;
+    float coneOuterAngle;
+    float coneOuterGain;
+
+    if (pBatch == NULL || pSpatializer == NULL || index >= pBatch->capacity) {
+        return MA_INVALID_ARGS;
+    }
+
+    position  = ma_spatializer_get_position(pSpatializer);
+    direction = ma_spatializer_get_direction(pSpatializer);
+    velocity  = ma_spatializer_get_velocity(pSpatializer);
+    ma_spatializer_get_cone(pSpatializer, &coneInnerAngle, &coneOuterAngle, &coneOuterGain);
+
+    pBatch->pPositionX[index]        = position.x;
+    pBatch->pPositionY[index]        = position.y;
+    pBatch->pPositionZ[index]        = position.z;
+    pBatch->pDirectionX[index]       = direction.x;
+    pBatch->pDirectionY[index]       = direction.y;
+    pBatch->pDirectionZ[index]       = direction.z;
+    pBatch->pVelocityX[index]        = velocity.x;
+    pBatch->pVelocityY[index]        = velocity.y;
+    pBatch->pVelocityZ[index]        = velocity.z;
+    pBatch->pMinDistance[index]      = ma_spatializer_get_min_distance(pSpatializer);
+    pBatch->pMaxDistance[index]      = ma_spatializer_get_max_distance(pSpatializer);
+    pBatch->pRolloff[index]          = ma_spatializer_get_rolloff(pSpatializer);
+    pBatch->pMinGain[index]          = ma_spatializer_get_min_gain(pSpatializer);
+    pBatch->pMaxGain[index]          = ma_spatializer_get_max_gain(pSpatializer);
+    pBatch->pConeOuterGain[index]    = coneOuterGain;
+    pBatch->pDopplerFactor[index]    = ma_spatializer_get_doppler_factor(pSpatializer);
+    pBatch->pAttenuationModel[index] = (ma_int32)ma_spatializer_get_attenuation_model(pSpatializer);
+    pBatch->pPositioning[index]      = (ma_int32)ma_spatializer_get_positioning(pSpatializer);
+    pBatch->pListenerIndex[index]    = listenerIndex;
+
+    /* The cone is stored as cosines so the batch doesn't need to do any trigonometry. A full circle disables the cone. */
+    if (coneInnerAngle < 6.283185f) {
+        pBatch->pConeInnerCos[index] = ma_spatializer_batch_cone_cos(coneInnerAngle);
+        pBatch->pConeOuterCos[index] = ma_spatializer_batch_cone_cos(coneOuterAngle);
+    } else {
+        pBatch->pConeInnerCos[index] = -MA_FLT_MAX;
+        pBatch->pConeOuterCos[index] = -MA_FLT_MAX;
+    }
 
     return MA_SUCCESS;
 }
 
-static ma_result ma_linear_resampler_get_heap_layout(const ma_linear_resampler_config* pConfig, ma_linear_resampler_heap_layout* pHeapLayout)
+
+/* The state of the listener that's shared by every source in a batch. */
+typedef struct
 {
-    MA_ASSERT(pHeapLayout != NULL);
+    float m[4][4];
+    ma_vec3f position;
+    ma_vec3f velocity;
+    float speedOfSound;
+    float forwardZ;         /* The Z component of the listener's forward direction in listener space. */
+    float coneInnerCos;     /* -MA_FLT_MAX when the listener has no cone. */
+    float coneOuterCos;
+    float coneOuterGain;
+} ma_spatializer_batch_listener;
 
-    MA_ZERO_OBJECT(pHeapLayout);
+static void ma_spatializer_batch_listener_init(const ma_spatializer_listener* pListener, ma_spatializer_batch_listener* pBatchListener)
+{
+    MA_ZERO_OBJECT(pBatchListener);
 
-    if (pConfig == NULL) {
+    if (pListener != NULL) {
+        ma_spatializer_listener_get_view_matrix(pListener, pBatchListener->m);
+        pBatchListener->position     = ma_spatializer_listener_get_position(pListener);
+        pBatchListener->velocity     = ma_spatializer_listener_get_velocity(pListener);
+        pBatchListener->speedOfSound = pListener->config.speedOfSound;
+        pBatchListener->forwardZ     = (pListener->config.handedness == ma_handedness_right) ? -1.0f : 1.0f;
+
+        if (pListener->config.coneInnerAngleInRadians < 6.283185f) {
+            pBatchListener->coneInnerCos  = ma_spatializer_batch_cone_cos(pListener->config.coneInnerAngleInRadians);
+            pBatchListener->coneOuterCos  = ma_spatializer_batch_cone_cos(pListener->config.coneOuterAngleInRadians);
+            pBatchListener->coneOuterGain = pListener->config.coneOuterGain;
+        } else {
+            pBatchListener->coneInnerCos  = -MA_FLT_MAX;
+            pBatchListener->coneOuterCos  = -MA_FLT_MAX;
+            pBatchListener->coneOuterGain = 1;
+        }
+    } else {
+        /* No listener. Sources are treated as if they're already relative to a listener at the origin. */
+        pBatchListener->m[0][0] = 1;
+        pBatchListener->m[1][1] = 1;
+        pBatchListener->m[2][2] = 1;
+        pBatchListener->m[3][3] = 1;
+        pBatchListener->speedOfSound = MA_DEFAULT_SPEED_OF_SOUND;
+        pBatchListener->forwardZ     = -1;
+        pBatchListener->coneInnerCos = -MA_FLT_MAX;
+        pBatchListener->coneOuterCos = -MA_FLT_MAX;
+        pBatchListener->coneOuterGain = 1;
+    }
+}
+
+static float ma_spatializer_batch_cone_gain(float d, float cutoffInner, float cutoffOuter, float outerGain)
+{
+    /* This is the same as ma_calculate_angular_gain(), but with the cutoffs precalculated. */
+    if (d > cutoffInner) {
+        return 1;
+    } else if (d > cutoffOuter) {
+        return ma_mix_f32(outerGain, 1, (d - cutoffOuter) / (cutoffInner - cutoffOuter));
+    } else {
+        return outerGain;
+    }
+}
+
+static void ma_spatializer_batch_process_range__scalar(ma_spatializer_batch* pBatch, const ma_spatializer_batch_listener* pListener, ma_uint32 listenerIndex, ma_uint32 firstIndex, ma_uint32 count)
+{
+    ma_uint32 i;
+
+    for (i = firstIndex; i < firstIndex + count; i += 1) {
+        ma_vec3f relativePos;
+        ma_vec3f relativeDir;
+        ma_vec3f unitPos;
+        ma_vec3f toListener;
+        float distance;
+        float gain;
+        float minDistance = pBatch->pMinDistance[i];
+        float maxDistance = pBatch->pMaxDistance[i];
+        float rolloff     = pBatch->pRolloff[i];
+        float dopplerFactor = pBatch->pDopplerFactor[i];
+
+        if (pBatch->pListenerIndex[i] != listenerIndex) {
+            continue;
+        }
+
+        if (pBatch->pPositioning[i] == ma_positioning_relative) {
+            relativePos = ma_vec3f_init_3f(pBatch->pPositionX[i],  pBatch->pPositionY[i],  pBatch->pPositionZ[i]);
+            relativeDir = ma_vec3f_init_3f(pBatch->pDirectionX[i], pBatch->pDirectionY[i], pBatch->pDirectionZ[i]);
+        } else {
+            const float (* m)[4] = pListener->m;
+            float px = pBatch->pPositionX[i];
+            float py = pBatch->pPositionY[i];
+            float pz = pBatch->pPositionZ[i];
+            float dx = pBatch->pDirectionX[i];
+            float dy = pBatch->pDirectionY[i];
+            float dz = pBatch->pDirectionZ[i];
+
+            relativePos.x = m[0][0] * px + m[1][0] * py + m[2][0] * pz + m[3][0];
+            relativePos.y = m[0][1] * px + m[1][1] * py + m[2][1] * pz + m[3][1];
+            relativePos.z = m[0][2] * px + m[1][2] * py + m[2][2] * pz + m[3][2];
+            relativeDir.x = m[0][0] * dx + m[1][0] * dy + m[2][0] * dz;
+            relativeDir.y = m[0][1] * dx + m[1][1] * dy + m[2][1] * dz;
+            relativeDir.z = m[0][2] * dx + m[1][2] * dy + m[2][2] * dz;
+        }
+
+        distance = ma_vec3f_len(relativePos);
+
+        switch (pBatch->pAttenuationModel[i])
+        {
+            case ma_attenuation_model_inverse:     gain = ma_attenuation_inverse(distance, minDistance, maxDistance, rolloff);     break;
+            case ma_attenuation_model_linear:      gain = ma_attenuation_linear(distance, minDistance, maxDistance, rolloff);      break;
+            case ma_attenuation_model_exponential: gain = ma_attenuation_exponential(distance, minDistance, maxDistance, rolloff); break;
+            case ma_attenuation_model_none:
+            default:                               gain = 1; break;
+        }
+
+        if (distance > 0.001f) {
+            float distanceInv = 1/distance;
+            unitPos.x = relativePos.x * distanceInv;
+            unitPos.y = relativePos.y * distanceInv;
+            unitPos.z = relativePos.z * distanceInv;
+
+            gain *= ma_spatializer_batch_cone_gain(-ma_vec3f_dot(relativeDir, unitPos), pBatch->pConeInnerCos[i], pBatch->pConeOuterCos[i], pBatch->pConeOuterGain[i]);
+            gain *= ma_spatializer_batch_cone_gain(pListener->forwardZ * unitPos.z, pListener->coneInnerCos, pListener->coneOuterCos, pListener->coneOuterGain);
+        } else {
+            distance = 0;
+            unitPos  = ma_vec3f_init_3f(0, 0, 0);
+        }
+
+        pBatch->pGain[i]               = ma_clamp(gain, pBatch->pMinGain[i], pBatch->pMaxGain[i]);
+        pBatch->pDistance[i]           = distance;
+        pBatch->pRelativeDirectionX[i] = unitPos.x;
+        pBatch->pRelativeDirectionY[i] = unitPos.y;
+        pBatch->pRelativeDirectionZ[i] = unitPos.z;
+
+        /* Doppler is based on the untransformed position for consistency with ma_spatializer_process_pcm_frames(). */
+        if (dopplerFactor > 0) {
+            toListener.x = pListener->position.x - pBatch->pPositionX[i];
+            toListener.y = pListener->position.y - pBatch->pPositionY[i];
+            toListener.z = pListener->position.z - pBatch->pPositionZ[i];
+            pBatch->pDopplerPitch[i] = ma_doppler_pitch(toListener, ma_vec3f_init_3f(pBatch->pVelocityX[i], pBatch->pVelocityY[i], pBatch->pVelocityZ[i]), pListener->velocity, pListener->speedOfSound, dopplerFactor);
+        } else {
+            pBatch->pDopplerPitch[i] = 1;
+        }
+    }
+}
+
+#if defined(MA_SUPPORT_SSE2)
+static MA_INLINE __m128 ma_select_f32__sse2(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static MA_INLINE __m128 ma_spatializer_batch_cone_gain__sse2(__m128 d, __m128 cutoffInner, __m128 cutoffOuter, __m128 outerGain)
+{
+    __m128 one = _mm_set1_ps(1);
+    __m128 t = _mm_div_ps(_mm_sub_ps(d, cutoffOuter), _mm_sub_ps(cutoffInner, cutoffOuter));
+    __m128 g = _mm_add_ps(_mm_mul_ps(outerGain, _mm_sub_ps(one, t)), t);    /* ma_mix_f32(outerGain, 1, t). The division is discarded below when the cutoffs are equal. */
+
+    g = ma_select_f32__sse2(_mm_cmpgt_ps(d, cutoffOuter), g, outerGain);
+    g = ma_select_f32__sse2(_mm_cmpgt_ps(d, cutoffInner), one, g);
+
+    return g;
+}
+
+static void ma_spatializer_batch_process_range__sse2(ma_spatializer_batch* pBatch, const ma_spatializer_batch_listener* pListener, ma_uint32 listenerIndex, ma_uint32 firstIndex, ma_uint32 count)
+{
+    const float (* m)[4] = pListener->m;
+    ma_uint32 i;
+    ma_uint32 groupCount = count / 4;
+    const __m128 zero  = _mm_setzero_ps();
+    const __m128 one   = _mm_set1_ps(1);
+    const __m128 m00 = _mm_set1_ps(m[0][0]), m10 = _mm_set1_ps(m[1][0]), m20 = _mm_set1_ps(m[2][0]), m30 = _mm_set1_ps(m[3][0]);
+    const __m128 m01 = _mm_set1_ps(m[0][1]), m11 = _mm_set1_ps(m[1][1]), m21 = _mm_set1_ps(m[2][1]), m31 = _mm_set1_ps(m[3][1]);
+    const __m128 m02 = _mm_set1_ps(m[0][2]), m12 = _mm_set1_ps(m[1][2]), m22 = _mm_set1_ps(m[2][2]), m32 = _mm_set1_ps(m[3][2]);
+    const __m128 listenerPosX = _mm_set1_ps(pListener->position.x);
+    const __m128 listenerPosY = _mm_set1_ps(pListener->position.y);
+    const __m128 listenerPosZ = _mm_set1_ps(pListener->position.z);
+    const __m128 listenerVelX = _mm_set1_ps(pListener->velocity.x);
+    const __m128 listenerVelY = _mm_set1_ps(pListener->velocity.y);
+    const __m128 listenerVelZ = _mm_set1_ps(pListener->velocity.z);
+    const __m128 speedOfSound = _mm_set1_ps(pListener->speedOfSound);
+    const __m128 listenerForwardZ     = _mm_set1_ps(pListener->forwardZ);
+    const __m128 listenerConeInnerCos = _mm_set1_ps(pListener->coneInnerCos);
+    const __m128 listenerConeOuterCos = _mm_set1_ps(pListener->coneOuterCos);
+    const __m128 listenerConeOuterGain = _mm_set1_ps(pListener->coneOuterGain);
+    const __m128i listenerIndex4 = _mm_set1_epi32((int)listenerIndex);
+    const __m128i modelInverse     = _mm_set1_epi32(ma_attenuation_model_inverse);
+    const __m128i modelLinear      = _mm_set1_epi32(ma_attenuation_model_linear);
+    const __m128i modelExponential = _mm_set1_epi32(ma_attenuation_model_exponential);
+    const __m128i positioningRelative = _mm_set1_epi32(ma_positioning_relative);
+
+    for (i = firstIndex; i < firstIndex + groupCount*4; i += 4) {
+        __m128 isActive;
+        __m128 isRelative;
+        __m128 px, py, pz, dx, dy, dz;
+        __m128 rx, ry, rz, rdx, rdy, rdz;
+        __m128 distance;
+        __m128 minDistance, maxDistance, rolloff;
+        __m128 clampedDistance;
+        __m128 gainInverse, gainLinear, gain;
+        __m128i model;
+        __m128 isAttenuated;
+        __m128 isNear;
+        __m128 distanceInv;
+        __m128 ux, uy, uz;
+        __m128 coneGain;
+        __m128 tlx, tly, tlz, toListenerLen, toListenerLenInv;
+        __m128 dopplerFactor, dopplerLimit, vls, vss, dopplerPitch, isDopplerEnabled;
+
+        isActive = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(pBatch->pListenerIndex + i)), listenerIndex4));
+        if (_mm_movemask_ps(isActive) == 0) {
+            continue;   /* None of these sources are using this listener. */
+        }
+
+        isRelative = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(pBatch->pPositioning + i)), positioningRelative));
+
+        px = _mm_loadu_ps(pBatch->pPositionX  + i);
+        py = _mm_loadu_ps(pBatch->pPositionY  + i);
+        pz = _mm_loadu_ps(pBatch->pPositionZ  + i);
+        dx = _mm_loadu_ps(pBatch->pDirectionX + i);
+        dy = _mm_loadu_ps(pBatch->pDirectionY + i);
+        dz = _mm_loadu_ps(pBatch->pDirectionZ + i);
+
+        /* Transform to listener space. Relative sources are already in listener space. */
+        rx  = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, px), _mm_mul_ps(m10, py)), _mm_mul_ps(m20, pz)), m30);
+        ry  = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, px), _mm_mul_ps(m11, py)), _mm_mul_ps(m21, pz)), m31);
+        rz  = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m02, px), _mm_mul_ps(m12, py)), _mm_mul_ps(m22, pz)), m32);
+        rdx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, dx), _mm_mul_ps(m10, dy)), _mm_mul_ps(m20, dz));
+        rdy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, dx), _mm_mul_ps(m11, dy)), _mm_mul_ps(m21, dz));
+        rdz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m02, dx), _mm_mul_ps(m12, dy)), _mm_mul_ps(m22, dz));
+
+        rx  = ma_select_f32__sse2(isRelative, px, rx);
+        ry  = ma_select_f32__sse2(isRelative, py, ry);
+        rz  = ma_select_f32__sse2(isRelative, pz, rz);
+        rdx = ma_select_f32__sse2(isRelative, dx, rdx);
+        rdy = ma_select_f32__sse2(isRelative, dy, rdy);
+        rdz = ma_select_f32__sse2(isRelative, dz, rdz);
+
+        distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)), _mm_mul_ps(rz, rz)));
+
+        /* Distance attenuation. */
+        minDistance = _mm_loadu_ps(pBatch->pMinDistance + i);
+        maxDistance = _mm_loadu_ps(pBatch->pMaxDistance + i);
+        rolloff     = _mm_loadu_ps(pBatch->pRolloff     + i);
+        model       = _mm_loadu_si128((const __m128i*)(pBatch->pAttenuationModel + i));
+
+        clampedDistance = _mm_max_ps(minDistance, _mm_min_ps(distance, maxDistance));
+        gainInverse = _mm_div_ps(minDistance, _mm_add_ps(minDistance, _mm_mul_ps(rolloff, _mm_sub_ps(clampedDistance, minDistance))));
+        gainLinear  = _mm_sub_ps(one, _mm_div_ps(_mm_mul_ps(rolloff, _mm_sub_ps(clampedDistance, minDistance)), _mm_sub_ps(maxDistance, minDistance)));
+
+        gain = one;
+        gain = ma_select_f32__sse2(_mm_castsi128_ps(_mm_cmpeq_epi32(model, modelInverse)), gainInverse, gain);
+        gain = ma_select_f32__sse2(_mm_castsi128_ps(_mm_cmpeq_epi32(model, modelLinear)),  gainLinear,  gain);
+
+        /* There's no vectorized pow() so the exponential model is done per-lane. It's rare enough that it's not worth approximating. */
+        if (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(model, modelExponential))) != 0) {
+            float gains[4];
+            float distances[4];
+            ma_uint32 iLane;
+
+            _mm_storeu_ps(gains, gain);
+            _mm_storeu_ps(distances, distance);
+            for (iLane = 0; iLane < 4; iLane += 1) {
+                if (pBatch->pAttenuationModel[i + iLane] == ma_attenuation_model_exponential) {
+                    gains[iLane] = ma_attenuation_exponential(distances[iLane], pBatch->pMinDistance[i + iLane], pBatch->pMaxDistance[i + iLane], pBatch->pRolloff[i + iLane]);
+                }
+            }
+            gain = _mm_loadu_ps(gains);
+        }
+
+        /* Attenuation is disabled when the min distance is not less than the max distance. */
+        isAttenuated = _mm_cmplt_ps(minDistance, maxDistance);
+        gain = ma_select_f32__sse2(isAttenuated, gain, one);
+
+        /* Normalize the position. */
+        isNear = _mm_cmple_ps(distance, _mm_set1_ps(0.001f));
+        distance = _mm_andnot_ps(isNear, distance);
+        distanceInv = _mm_andnot_ps(isNear, _mm_div_ps(one, distance));
+        ux = _mm_mul_ps(rx, distanceInv);
+        uy = _mm_mul_ps(ry, distanceInv);
+        uz = _mm_mul_ps(rz, distanceInv);
+
+        /* Cones. These don't apply when the source is right on top of the listener. */
+        coneGain = ma_spatializer_batch_cone_gain__sse2(
+            _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(rdx, ux), _mm_mul_ps(rdy, uy)), _mm_mul_ps(rdz, uz))),
+            _mm_loadu_ps(pBatch->pConeInnerCos  + i),
+            _mm_loadu_ps(pBatch->pConeOuterCos  + i),
+            _mm_loadu_ps(pBatch->pConeOuterGain + i));
+        coneGain = _mm_mul_ps(coneGain, ma_spatializer_batch_cone_gain__sse2(_mm_mul_ps(listenerForwardZ, uz), listenerConeInnerCos, listenerConeOuterCos, listenerConeOuterGain));
+        gain = _mm_mul_ps(gain, ma_select_f32__sse2(isNear, one, coneGain));
+
+        gain = _mm_max_ps(_mm_loadu_ps(pBatch->pMinGain + i), _mm_min_ps(gain, _mm_loadu_ps(pBatch->pMaxGain + i)));
+
+        /* Doppler. */
+        dopplerFactor = _mm_loadu_ps(pBatch->pDopplerFactor + i);
+        tlx = _mm_sub_ps(listenerPosX, px);
+        tly = _mm_sub_ps(listenerPosY, py);
+        tlz = _mm_sub_ps(listenerPosZ, pz);
+        toListenerLen    = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tlx, tlx), _mm_mul_ps(tly, tly)), _mm_mul_ps(tlz, tlz)));
+        toListenerLenInv = _mm_div_ps(one, toListenerLen);
+        dopplerLimit = _mm_div_ps(speedOfSound, dopplerFactor);
+        vls = _mm_min_ps(_mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tlx, listenerVelX), _mm_mul_ps(tly, listenerVelY)), _mm_mul_ps(tlz, listenerVelZ)), toListenerLenInv), dopplerLimit);
+        vss = _mm_min_ps(_mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tlx, _mm_loadu_ps(pBatch->pVelocityX + i)), _mm_mul_ps(tly, _mm_loadu_ps(pBatch->pVelocityY + i))), _mm_mul_ps(tlz, _mm_loadu_ps(pBatch->pVelocityZ + i))), toListenerLenInv), dopplerLimit);
+        dopplerPitch = _mm_div_ps(_mm_sub_ps(speedOfSound, _mm_mul_ps(dopplerFactor, vls)), _mm_sub_ps(speedOfSound, _mm_mul_ps(dopplerFactor, vss)));
+        isDopplerEnabled = _mm_and_ps(_mm_cmpgt_ps(dopplerFactor, zero), _mm_cmpneq_ps(toListenerLen, zero));
+        dopplerPitch = ma_select_f32__sse2(isDopplerEnabled, dopplerPitch, one);
+
+        /* Only update the sources that are using this listener. */
+        _mm_storeu_ps(pBatch->pGain               + i, ma_select_f32__sse2(isActive, gain,         _mm_loadu_ps(pBatch->pGain               + i)));
+        _mm_storeu_ps(pBatch->pDistance           + i, ma_select_f32__sse2(isActive, distance,     _mm_loadu_ps(pBatch->pDistance           + i)));
+        _mm_storeu_ps(pBatch->pRelativeDirectionX + i, ma_select_f32__sse2(isActive, ux,           _mm_loadu_ps(pBatch->pRelativeDirectionX + i)));
+        _mm_storeu_ps(pBatch->pRelativeDirectionY + i, ma_select_f32__sse2(isActive, uy,           _mm_loadu_ps(pBatch->pRelativeDirectionY + i)));
+        _mm_storeu_ps(pBatch->pRelativeDirectionZ + i, ma_select_f32__sse2(isActive, uz,           _mm_loadu_ps(pBatch->pRelativeDirectionZ + i)));
+        _mm_storeu_ps(pBatch->pDopplerPitch       + i, ma_select_f32__sse2(isActive, dopplerPitch, _mm_loadu_ps(pBatch->pDopplerPitch       + i)));
+    }
+
+    /* Leftovers. */
+    ma_spatializer_batch_process_range__scalar(pBatch, pListener, listenerIndex, firstIndex + groupCount*4, count - groupCount*4);
+}
+#endif
+
+MA_API ma_result ma_spatializer_batch_process_range(ma_spatializer_batch* pBatch, const ma_spatializer_listener* pListener, ma_uint32 listenerIndex, ma_uint32 firstIndex, ma_uint32 count)
+{
+    ma_spatializer_batch_listener batchListener;
+
+    if (pBatch == NULL || firstIndex > pBatch->capacity || count > pBatch->capacity - firstIndex) {
         return MA_INVALID_ARGS;
     }
 
-    if (pConfig->format != ma_format_f32 && pConfig->format != ma_format_s16) {
+    ma_spatializer_batch_listener_init(pListener, &batchListener);
+
+    /*
+    There's no NEON path here because the batch needs division and square roots which are only
+    available on 64-bit ARM. The scalar path is used instead.
+    */
+    #if defined(MA_SUPPORT_SSE2)
+    if (ma_has_sse2()) {
+        ma_spatializer_batch_process_range__sse2(pBatch, &batchListener, listenerIndex, firstIndex, count);
+    } else
+    #endif
+    {
+        ma_spatializer_batch_process_range__scalar(pBatch, &batchListener, listenerIndex, firstIndex, count);
+    }
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_spatializer_batch_process(ma_spatializer_batch* pBatch, const ma_spatializer_listener* pListener, ma_uint32 listenerIndex)
+{
+    if (pBatch == NULL) {
         return MA_INVALID_ARGS;
     }
 
-    if (pConfig->channels == 0) {
+    return ma_spatializer_batch_process_range(pBatch, pListener, listenerIndex, 0, pBatch->count);
+}
+
+MA_API ma_result ma_spatializer_process_pcm_frames_batched(ma_spatializer* pSpatializer, ma_spatializer_listener* pListener, const ma_spatializer_batch* pBatch, ma_uint32 index, void* pFramesOut, const void* pFramesIn, ma_uint64 frameCount)
+{
+    ma_vec3f unitPos;
+
+    if (pSpatializer == NULL || pListener == NULL || pBatch == NULL || index >= pBatch->capacity) {
         return MA_INVALID_ARGS;
     }
 
-    pHeapLayout->sizeInBytes = 0;
+    /* Without attenuation there's nothing for the batch to have calculated. This path doesn't do any spatial math anyway. */
+    if (ma_spatializer_get_attenuation_model(pSpatializer) == ma_attenuation_model_none) {
+        return ma_spatializer_process_pcm_frames(pSpatializer, pListener, pFramesOut, pFramesIn, frameCount);
+    }
 
-    /* x0 */
-    pHeapLayout->x0Offset = pHeapLayout->sizeInBytes;
-    if (pConfig->format == ma_format_f32) {
-        pHeapLayout->sizeInBytes += sizeof(float) * pConfig->channels;
-    } else {
-        pHeapLayout->sizeInBytes += sizeof(ma_int16) * pConfig->channels;
+    unitPos = ma_vec3f_init_3f(pBatch->pRelativeDirectionX[index], pBatch->pRelativeDirectionY[index], pBatch->pRelativeDirectionZ[index]);
+
+    ma_spatializer_apply_gain_and_panning(pSpatializer, pListener, pFramesOut, pFramesIn, frameCount, pBatch->pGain[index], pBatch->pDistance[index], unitPos);
+    pSpatializer->dopplerPitch = pBatch->pDopplerPitch[index];
+
+    return MA_SUCCESS;
+}
+
+
+
+MA_API ma_uint32 ma_ambisonic_get_channel_count(ma_uint32 order)
+{
+    if (order > MA_AMBISONIC_MAX_ORDER) {
+        return 0;
     }
 
-    /* x1 */
-    pHeapLayout->x1Offset = pHeapLayout->sizeInBytes;
-    if (pConfig->format == ma_format_f32) {
-        pHeapLayout->sizeInBytes += sizeof(float) * pConfig->channels;
-    } else {
-        pHeapLayout->sizeInBytes += sizeof(ma_int16) * pConfig->channels;
+    return (order + 1) * (order + 1);
+}
+
+MA_API void ma_ambisonic_encode(ma_uint32 order, ma_vec3f direction, float* pGains)
+{
+    /* Convert to the ambisonic convention where +X is forward, +Y is left and +Z is up. */
+    float x = -direction.z;
+    float y = -direction.x;
+    float z =  direction.y;
+
+    if (pGains == NULL) {
+        return;
     }
 
-    /* LPF */
-    pHeapLayout->lpfOffset = ma_align_64(pHeapLayout->sizeInBytes);
-    {
-        ma_result result;
-        size_t lpfHeapSizeInBytes;
-        ma_lpf_config lpfConfig = ma_lpf_config_init(pConfig->format, pConfig->channels, 1, 1, pConfig->lpfOrder);  /* Sample rate and cutoff frequency do not matter. */
+    pGains[0] = 1;
 
-        result = ma_lpf_get_heap_size(&lpfConfig, &lpfHeapSizeInBytes);
-        if (result != MA_SUCCESS) {
-            return result;
+    if (order >= 1) {
+        pGains[1] = y;
+        pGains[2] = z;
+        pGains[3] = x;
+    }
+
+    if (order >= 2) {
+        const float sqrt3 = 1.7320508f;
+        pGains[4] = sqrt3 * x * y;
+        pGains[5] = sqrt3 * y * z;
+        pGains[6] = 0.5f * (3*z*z - 1);
+        pGains[7] = sqrt3 * x * z;
+        pGains[8] = 0.5f * sqrt3 * (x*x - y*y);
+    }
+
+    if (order >= 3) {
+        const float sqrt5_8  = 0.7905694f;
+        const float sqrt15   = 3.8729833f;
+        const float sqrt3_8  = 0.6123724f;
+        pGains[ 9] = sqrt5_8 * y * (3*x*x - y*y);
+        pGains[10] = sqrt15 * x * y * z;
+        pGains[11] = sqrt3_8 * y * (5*z*z - 1);
+        pGains[12] = 0.5f * z * (5*z*z - 3);
+        pGains[13] = sqrt3_8 * x * (5*z*z - 1);
+        pGains[14] = 0.5f * sqrt15 * z * (x*x - y*y);
+        pGains[15] = sqrt5_8 * x * (x*x - 3*y*y);
+    }
+}
+
+static void ma_ambisonic_encode_omni_f32(float* pFramesOut, ma_uint32 channelsOut, const float* pFramesIn, ma_uint32 channelsIn, ma_uint64 frameCount, float volume, ma_bool32 isOmniOnly)
+{
+    /*
+    Sources are encoded as a mono signal. When isOmniOnly is set only the W channel is written, otherwise the signal is
+    written to every channel so the per-channel gains can be applied afterwards in a single pass.
+    */
+    ma_uint64 iFrame;
+    ma_uint32 iChannel;
+    float scale = volume / (float)channelsIn;
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        float sample = 0;
+        for (iChannel = 0; iChannel < channelsIn; iChannel += 1) {
+            sample += pFramesIn[iChannel];
+        }
+        sample *= scale;
+
+        pFramesOut[0] = sample;
+        for (iChannel = 1; iChannel < channelsOut; iChannel += 1) {
+            pFramesOut[iChannel] = (isOmniOnly) ? 0 : sample;
         }
 
-        pHeapLayout->sizeInBytes += lpfHeapSizeInBytes;
+        pFramesIn  += channelsIn;
+        pFramesOut += channelsOut;
     }
+}
 
-    /* Make sure allocation size is aligned. */
-    pHeapLayout->sizeInBytes = ma_align_64(pHeapLayout->sizeInBytes);
+
+MA_API ma_ambisonic_decoder_config ma_ambisonic_decoder_config_init(ma_uint32 order, ma_uint32 channelsOut, const ma_channel* pChannelMapOut)
+{
+    ma_ambisonic_decoder_config config;
+
+    MA_ZERO_OBJECT(&config);
+    config.order          = order;
+    config.channelsOut    = channelsOut;
+    config.pChannelMapOut = pChannelMapOut;
+
+    return config;
+}
+
+typedef struct
+{
+    size_t sizeInBytes;
+    size_t matrixOffset;
+} ma_ambisonic_decoder_heap_layout;
+
+static ma_result ma_ambisonic_decoder_get_heap_layout(const ma_ambisonic_decoder_config* pConfig, ma_ambisonic_decoder_heap_layout* pHeapLayout)
+{
+    MA_ASSERT(pHeapLayout != NULL);
+
+    MA_ZERO_OBJECT(pHeapLayout);
+
+    if (pConfig == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (pConfig->order == 0 || pConfig->order > MA_AMBISONIC_MAX_ORDER || pConfig->channelsOut == 0 || pConfig->channelsOut > MA_MAX_CHANNELS) {
+        return MA_INVALID_ARGS;
+    }
+
+    pHeapLayout->sizeInBytes = 0;
+
+    /* Decoding matrix. */
+    pHeapLayout->matrixOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(sizeof(float) * pConfig->channelsOut * ma_ambisonic_get_channel_count(pConfig->order));
 
     return MA_SUCCESS;
 }
 
-MA_API ma_result ma_linear_resampler_get_heap_size(const ma_linear_resampler_config* pConfig, size_t* pHeapSizeInBytes)
+MA_API ma_result ma_ambisonic_decoder_get_heap_size(const ma_ambisonic_decoder_config* pConfig, size_t* pHeapSizeInBytes)
 {
     ma_result result;
-    ma_linear_resampler_heap_layout heapLayout;
+    ma_ambisonic_decoder_heap_layout heapLayout;
 
     if (pHeapSizeInBytes == NULL) {
         return MA_INVALID_ARGS;
@@ -51202,7 +54302,7 @@ MA_API ma_result ma_linear_resampler_get_heap_size(const ma_linear_resampler_con
 
     *pHeapSizeInBytes = 0;
 
-    result = ma_linear_resampler_get_heap_layout(pConfig, &heapLayout);
+    result = ma_ambisonic_decoder_get_heap_layout(pConfig, &heapLayout);
     if (result != MA_SUCCESS) {
         return result;
     }
@@ -51212,54 +54312,94 @@ MA_API ma_result ma_linear_resampler_get_heap_size(const ma_linear_resampler_con
     return MA_SUCCESS;
 }
 
-MA_API ma_result ma_linear_resampler_init_preallocated(const ma_linear_resampler_config* pConfig, void* pHeap, ma_linear_resampler* pResampler)
+static float ma_legendre_f32(ma_uint32 degree, float x)
+{
+    switch (degree)
+    {
+        case 0:  return 1;
+        case 1:  return x;
+        case 2:  return 0.5f * (3*x*x - 1);
+        case 3:  return 0.5f * (5*x*x*x - 3*x);
+        default: return 0;
+    }
+}
+
+MA_API ma_result ma_ambisonic_decoder_init_preallocated(const ma_ambisonic_decoder_config* pConfig, void* pHeap, ma_ambisonic_decoder* pDecoder)
 {
     ma_result result;
-    ma_linear_resampler_heap_layout heapLayout;
+    ma_ambisonic_decoder_heap_layout heapLayout;
+    ma_channel channelMapOut[MA_MAX_CHANNELS];
+    float orderWeights[MA_AMBISONIC_MAX_ORDER + 1];
+    float normalization;
+    float rE;
+    ma_uint32 iOrder;
+    ma_uint32 iChannelOut;
 
-    if (pResampler == NULL) {
+    if (pDecoder == NULL) {
         return MA_INVALID_ARGS;
     }
 
-    MA_ZERO_OBJECT(pResampler);
+    MA_ZERO_OBJECT(pDecoder);
 
-    result = ma_linear_resampler_get_heap_layout(pConfig, &heapLayout);
+    result = ma_ambisonic_decoder_get_heap_layout(pConfig, &heapLayout);
     if (result != MA_SUCCESS) {
         return result;
     }
 
-    pResampler->config = *pConfig;
-
-    pResampler->_pHeap = pHeap;
+    pDecoder->_pHeap = pHeap;
     MA_ZERO_MEMORY(pHeap, heapLayout.sizeInBytes);
 
-    if (pConfig->format == ma_format_f32) {
-        pResampler->x0.f32 = (float*)ma_offset_ptr(pHeap, heapLayout.x0Offset);
-        pResampler->x1.f32 = (float*)ma_offset_ptr(pHeap, heapLayout.x1Offset);
-    } else {
-        pResampler->x0.s16 = (ma_int16*)ma_offset_ptr(pHeap, heapLayout.x0Offset);
-        pResampler->x1.s16 = (ma_int16*)ma_offset_ptr(pHeap, heapLayout.x1Offset);
-    }
+    pDecoder->order       = pConfig->order;
+    pDecoder->channelsIn  = ma_ambisonic_get_channel_count(pConfig->order);
+    pDecoder->channelsOut = pConfig->channelsOut;
+    pDecoder->pMatrix     = (float*)ma_offset_ptr(pHeap, heapLayout.matrixOffset);
 
-    /* Setting the rate will set up the filter and time advances for us. */
-    result = ma_linear_resampler_set_rate_internal(pResampler, pHeap, &heapLayout, pConfig->sampleRateIn, pConfig->sampleRateOut, /* isResamplerAlreadyInitialized = */ MA_FALSE);
-    if (result != MA_SUCCESS) {
-        return result;
+    ma_channel_map_copy_or_default(channelMapOut, ma_countof(channelMapOut), pConfig->pChannelMapOut, pConfig->channelsOut);
+
+    /*
+    This is a basic sampling decoder. Each speaker gets the sound field evaluated in its direction, with max-rE weights
+    applied to each order to tighten up the image. The weights are normalized such that a source positioned exactly on
+    a speaker comes out of that speaker at unity gain.
+    */
+    rE = (float)ma_cosd((137.9 * MA_PI_D / 180.0) / (pConfig->order + 1.51));
+
+    normalization = 0;
+    for (iOrder = 0; iOrder <= pConfig->order; iOrder += 1) {
+        orderWeights[iOrder] = (2*iOrder + 1) * ma_legendre_f32(iOrder, rE);
+        normalization += orderWeights[iOrder];
     }
 
-    pResampler->inTimeInt  = 1;  /* Set this to one to force an input sample to always be loaded for the first output frame. */
-    pResampler->inTimeFrac = 0;
+    for (iChannelOut = 0; iChannelOut < pDecoder->channelsOut; iChannelOut += 1) {
+        ma_channel channel = ma_channel_map_get_channel(channelMapOut, pDecoder->channelsOut, iChannelOut);
+        float* pRow = pDecoder->pMatrix + (iChannelOut * pDecoder->channelsIn);
+
+        if (ma_is_spatial_channel_position(channel)) {
+            ma_uint32 iChannelIn;
+
+            ma_ambisonic_encode(pDecoder->order, ma_vec3f_normalize(ma_get_channel_direction(channel)), pRow);
+
+            for (iOrder = 0; iOrder <= pDecoder->order; iOrder += 1) {
+                for (iChannelIn = iOrder*iOrder; iChannelIn < (iOrder + 1)*(iOrder + 1); iChannelIn += 1) {
+                    pRow[iChannelIn] *= orderWeights[iOrder] / normalization;
+                }
+            }
+        } else if (channel == MA_CHANNEL_MONO) {
+            pRow[0] = 1;    /* A mono output just gets the omnidirectional component. */
+        } else {
+            /* Not a speaker with a direction, such as the LFE. Leave it silent. */
+        }
+    }
 
     return MA_SUCCESS;
 }
 
-MA_API ma_result ma_linear_resampler_init(const ma_linear_resampler_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_linear_resampler* pResampler)
+MA_API ma_result ma_ambisonic_decoder_init(const ma_ambisonic_decoder_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_ambisonic_decoder* pDecoder)
 {
     ma_result result;
     size_t heapSizeInBytes;
     void* pHeap;
 
-    result = ma_linear_resampler_get_heap_size(pConfig, &heapSizeInBytes);
+    result = ma_ambisonic_decoder_get_heap_size(pConfig, &heapSizeInBytes);
     if (result != MA_SUCCESS) {
         return result;
     }
@@ -51273,59 +54413,449 @@ MA_API ma_result ma_linear_resampler_init(const ma_linear_resampler_config* pCon
         pHeap = NULL;
     }
 
-    result = ma_linear_resampler_init_preallocated(pConfig, pHeap, pResampler);
+    result = ma_ambisonic_decoder_init_preallocated(pConfig, pHeap, pDecoder);
     if (result != MA_SUCCESS) {
         ma_free(pHeap, pAllocationCallbacks);
         return result;
     }
 
-    pResampler->_ownsHeap = MA_TRUE;
+    pDecoder->_ownsHeap = MA_TRUE;
     return MA_SUCCESS;
 }
 
-MA_API void ma_linear_resampler_uninit(ma_linear_resampler* pResampler, const ma_allocation_callbacks* pAllocationCallbacks)
+MA_API void ma_ambisonic_decoder_uninit(ma_ambisonic_decoder* pDecoder, const ma_allocation_callbacks* pAllocationCallbacks)
 {
-    if (pResampler == NULL) {
+    if (pDecoder == NULL) {
         return;
     }
 
-    ma_lpf_uninit(&pResampler->lpf, pAllocationCallbacks);
-
-    if (pResampler->_ownsHeap) {
-        ma_free(pResampler->_pHeap, pAllocationCallbacks);
+    if (pDecoder->_ownsHeap) {
+        ma_free(pDecoder->_pHeap, pAllocationCallbacks);
     }
 }
 
-static MA_INLINE ma_int16 ma_linear_resampler_mix_s16(ma_int16 x, ma_int16 y, ma_int32 a, const ma_int32 shift)
+MA_API ma_result ma_ambisonic_decoder_process_pcm_frames(ma_ambisonic_decoder* pDecoder, float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount)
 {
-    ma_int32 b;
-    ma_int32 c;
-    ma_int32 r;
+    ma_uint64 iFrame;
+    ma_uint32 channelsIn;
+    ma_uint32 channelsOut;
 
-    MA_ASSERT(a <= (1<<shift));
+    if (pDecoder == NULL || pFramesOut == NULL || pFramesIn == NULL) {
+        return MA_INVALID_ARGS;
+    }
 
-    b = x * ((1<<shift) - a);
-    c = y * a;
-    r = b + c;
+    channelsIn  = pDecoder->channelsIn;
+    channelsOut = pDecoder->channelsOut;
 
-    return (ma_int16)(r >> shift);
-}
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        const float* pRow = pDecoder->pMatrix;
+        ma_uint32 iChannelOut;
 
-static void ma_linear_resampler_interpolate_frame_s16(ma_linear_resampler* pResampler, ma_int16* MA_RESTRICT pFrameOut)
-{
-    ma_uint32 c;
-    ma_uint32 a;
-    const ma_uint32 channels = pResampler->config.channels;
-    const ma_uint32 shift = 12;
+        for (iChannelOut = 0; iChannelOut < channelsOut; iChannelOut += 1) {
+            float sample = 0;
+            ma_uint32 iChannelIn;
 
-    MA_ASSERT(pResampler != NULL);
-    MA_ASSERT(pFrameOut  != NULL);
+            for (iChannelIn = 0; iChannelIn < channelsIn; iChannelIn += 1) {
+                sample += pRow[iChannelIn] * pFramesIn[iChannelIn];
+            }
 
-    a = (pResampler->inTimeFrac << shift) / pResampler->config.sampleRateOut;
+            pFramesOut[iChannelOut] = sample;
+            pRow += channelsIn;
+        }
 
-    MA_ASSUME(channels > 0);
-    for (c = 0; c < channels; c += 1) {
-        ma_int16 s = ma_linear_resampler_mix_s16(pResampler->x0.s16[c], pResampler->x1.s16[c], a, shift);
+        pFramesIn  += channelsIn;
+        pFramesOut += channelsOut;
+    }
+
+    return MA_SUCCESS;
+}
+
+
+
+
+/**************************************************************************************************************************************************************
+
+Resampling
+
+**************************************************************************************************************************************************************/
+MA_API ma_linear_resampler_config ma_linear_resampler_config_init(ma_format format, ma_uint32 channels, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut)
+{
+    ma_linear_resampler_config config;
+    MA_ZERO_OBJECT(&config);
+    config.format           = format;
+    config.channels         = channels;
+    config.sampleRateIn     = sampleRateIn;
+    config.sampleRateOut    = sampleRateOut;
+    config.lpfOrder         = ma_min(MA_DEFAULT_RESAMPLER_LPF_ORDER, MA_MAX_FILTER_ORDER);
+    config.lpfNyquistFactor = 1;
+
+    return config;
+}
+
+
+typedef struct
+{
+    size_t sizeInBytes;
+    size_t x0Offset;
+    size_t x1Offset;
+    size_t lpfOffset;
+    size_t phasesOffset;
+    ma_uint32 phaseCapacity;
+} ma_linear_resampler_heap_layout;
+
+
+static ma_uint32 ma_linear_resampler_get_fixed_ratio_phase_count(ma_uint32 sampleRateIn, ma_uint32 sampleRateOut)
+{
+    ma_uint32 gcf;
+
+    if (sampleRateIn == 0 || sampleRateOut == 0) {
+        return 0;
+    }
+
+    gcf = ma_gcf_u32(sampleRateIn, sampleRateOut);
+    sampleRateIn  /= gcf;
+    sampleRateOut /= gcf;
+
+    if (sampleRateIn > MA_LINEAR_RESAMPLER_MAX_PHASE_COUNT || sampleRateOut > MA_LINEAR_RESAMPLER_MAX_PHASE_COUNT) {
+        return 0;   /* Not a fixed ratio. */
+    }
+
+    /* There is one phase for each possible value of the fractional part of the timer. */
+    return sampleRateOut;
+}
+
+static void ma_linear_resampler_build_phase_table(ma_linear_resampler* pResampler)
+{
+    ma_uint32 iPhase;
+    ma_uint32 sampleRateOut = pResampler->config.sampleRateOut;
+
+    MA_ASSERT(sampleRateOut <= pResampler->phaseCapacity);
+
+    /* The weights need to be calculated exactly as they are in the interpolation functions so the output is the same either way. */
+    for (iPhase = 0; iPhase < sampleRateOut; iPhase += 1) {
+        ma_linear_resampler_phase* pPhase = &pResampler->pPhases[iPhase];
+        ma_uint32 nextPhase = iPhase + pResampler->inAdvanceFrac;
+        ma_uint32 inAdvance = pResampler->inAdvanceInt;
+
+        if (nextPhase >= sampleRateOut) {
+            nextPhase -= sampleRateOut;
+            inAdvance += 1;
+        }
+
+        if (pResampler->config.format == ma_format_f32) {
+            pPhase->alpha.f32 = (float)iPhase / sampleRateOut;
+        } else {
+            pPhase->alpha.s16 = (ma_int32)((iPhase << 12) / sampleRateOut);
+        }
+
+        pPhase->inAdvance = (ma_uint16)inAdvance;
+        pPhase->nextPhase = (ma_uint16)nextPhase;
+    }
+}
+
+
+static void ma_linear_resampler_adjust_timer_for_new_rate(ma_linear_resampler* pResampler, ma_uint32 oldSampleRateOut, ma_uint32 newSampleRateOut)
+{
+    /*
+    So what's happening here? Basically we need to adjust the fractional component of the time advance based on the new rate. The old time advance will
+    be based on the old sample rate, but we are needing to adjust it to that it's based on the new sample rate.
+    */
+    ma_uint32 oldRateTimeWhole = pResampler->inTimeFrac / oldSampleRateOut;  /* <-- This should almost never be anything other than 0, but leaving it here to make this more general and robust just in case. */
+    ma_uint32 oldRateTimeFract = pResampler->inTimeFrac % oldSampleRateOut;
+
+    pResampler->inTimeFrac =
+         (oldRateTimeWhole * newSampleRateOut) +
+        ((oldRateTimeFract * newSampleRateOut) / oldSampleRateOut);
+
+    /* Make sure the fractional part is less than the output sample rate. */
+    pResampler->inTimeInt += pResampler->inTimeFrac / pResampler->config.sampleRateOut;
+    pResampler->inTimeFrac = pResampler->inTimeFrac % pResampler->config.sampleRateOut;
+}
+
+static ma_result ma_linear_resampler_set_rate_internal(ma_linear_resampler* pResampler, void* pHeap, ma_linear_resampler_heap_layout* pHeapLayout, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut, ma_bool32 isResamplerAlreadyInitialized)
+{
+    ma_result result;
+    ma_uint32 gcf;
+    ma_uint32 lpfSampleRate;
+    double lpfCutoffFrequency;
+    ma_lpf_config lpfConfig;
+    ma_uint32 oldSampleRateOut; /* Required for adjusting time advance down the bottom. */
+
+    if (pResampler == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (sampleRateIn == 0 || sampleRateOut == 0) {
+        return MA_INVALID_ARGS;
+    }
+
+    oldSampleRateOut = pResampler->config.sampleRateOut;
+
+    pResampler->config.sampleRateIn  = sampleRateIn;
+    pResampler->config.sampleRateOut = sampleRateOut;
+
+    /* Simplify the sample rate. */
+    gcf = ma_gcf_u32(pResampler->config.sampleRateIn, pResampler->config.sampleRateOut);
+    pResampler->config.sampleRateIn  /= gcf;
+    pResampler->config.sampleRateOut /= gcf;
+
+    /* Always initialize the low-pass filter, even when the order is 0. */
+    if (pResampler->config.lpfOrder > MA_MAX_FILTER_ORDER) {
+        return MA_INVALID_ARGS;
+    }
+
+    lpfSampleRate      = (ma_uint32)(ma_max(pResampler->config.sampleRateIn, pResampler->config.sampleRateOut));
+    lpfCutoffFrequency = (   double)(ma_min(pResampler->config.sampleRateIn, pResampler->config.sampleRateOut) * 0.5 * pResampler->config.lpfNyquistFactor);
+
+    lpfConfig = ma_lpf_config_init(pResampler->config.format, pResampler->config.channels, lpfSampleRate, lpfCutoffFrequency, pResampler->config.lpfOrder);
+
+    /* The engine can switch the resampler to mono, but the filter always keeps the channel count it was initialized with. */
+    if (isResamplerAlreadyInitialized) {
+        lpfConfig.channels = pResampler->lpf.channels;
+    }
+
+    /*
+    If the resampler is alreay initialized we don't want to do a fresh initialization of the low-pass filter because it will result in the cached frames
+    getting cleared. Instead we re-initialize the filter which will maintain any cached frames.
+    */
+    if (isResamplerAlreadyInitialized) {
+        result = ma_lpf_reinit(&lpfConfig, &pResampler->lpf);
+    } else {
+        result = ma_lpf_init_preallocated(&lpfConfig, ma_offset_ptr(pHeap, pHeapLayout->lpfOffset), &pResampler->lpf);
+    }
+
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+
+    pResampler->inAdvanceInt  = pResampler->config.sampleRateIn / pResampler->config.sampleRateOut;
+    pResampler->inAdvanceFrac = pResampler->config.sampleRateIn % pResampler->config.sampleRateOut;
+
+    /* Our timer was based on the old rate. We need to adjust it so that it's based on the new rate. */
+    ma_linear_resampler_adjust_timer_for_new_rate(pResampler, oldSampleRateOut, pResampler->config.sampleRateOut);
+
+    /*
+    Small rational ratios use a precomputed table of phases. The table was sized for the initial ratio so if the
+    rate has changed to something that doesn't fit we just fall back to calculating each step.
+    */
+    pResampler->isFixedRatio = MA_FALSE;
+    if (pResampler->pPhases != NULL && pResampler->config.sampleRateIn <= MA_LINEAR_RESAMPLER_MAX_PHASE_COUNT && pResampler->config.sampleRateOut <= pResampler->phaseCapacity) {
+        ma_linear_resampler_build_phase_table(pResampler);
+        pResampler->isFixedRatio = MA_TRUE;
+    }
+
+    return MA_SUCCESS;
+}
+
+static ma_result ma_linear_resampler_get_heap_layout(const ma_linear_resampler_config* pConfig, ma_linear_resampler_heap_layout* pHeapLayout)
+{
+    MA_ASSERT(pHeapLayout != NULL);
+
+    MA_ZERO_OBJECT(pHeapLayout);
+
+    if (pConfig == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (pConfig->format != ma_format_f32 && pConfig->format != ma_format_s16) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (pConfig->channels == 0) {
+        return MA_INVALID_ARGS;
+    }
+
+    pHeapLayout->sizeInBytes = 0;
+
+    /* x0 */
+    pHeapLayout->x0Offset = pHeapLayout->sizeInBytes;
+    if (pConfig->format == ma_format_f32) {
+        pHeapLayout->sizeInBytes += sizeof(float) * pConfig->channels;
+    } else {
+        pHeapLayout->sizeInBytes += sizeof(ma_int16) * pConfig->channels;
+    }
+
+    /* x1 */
+    pHeapLayout->x1Offset = pHeapLayout->sizeInBytes;
+    if (pConfig->format == ma_format_f32) {
+        pHeapLayout->sizeInBytes += sizeof(float) * pConfig->channels;
+    } else {
+        pHeapLayout->sizeInBytes += sizeof(ma_int16) * pConfig->channels;
+    }
+
+    /* LPF */
+    pHeapLayout->lpfOffset = ma_align_64(pHeapLayout->sizeInBytes);
+    {
+        ma_result result;
+        size_t lpfHeapSizeInBytes;
+        ma_lpf_config lpfConfig = ma_lpf_config_init(pConfig->format, pConfig->channels, 1, 1, pConfig->lpfOrder);  /* Sample rate and cutoff frequency do not matter. */
+
+        result = ma_lpf_get_heap_size(&lpfConfig, &lpfHeapSizeInBytes);
+        if (result != MA_SUCCESS) {
+            return result;
+        }
+
+        pHeapLayout->sizeInBytes = pHeapLayout->lpfOffset + lpfHeapSizeInBytes;
+    }
+
+    /* Phase table. This is only allocated when the initial ratio is a fixed ratio. */
+    pHeapLayout->phaseCapacity = ma_linear_resampler_get_fixed_ratio_phase_count(pConfig->sampleRateIn, pConfig->sampleRateOut);
+    pHeapLayout->phasesOffset  = ma_align_64(pHeapLayout->sizeInBytes);
+    if (pHeapLayout->phaseCapacity > 0) {
+        pHeapLayout->sizeInBytes = pHeapLayout->phasesOffset + (sizeof(ma_linear_resampler_phase) * pHeapLayout->phaseCapacity);
+    }
+
+    /* Make sure allocation size is aligned. */
+    pHeapLayout->sizeInBytes = ma_align_64(pHeapLayout->sizeInBytes);
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_linear_resampler_get_heap_size(const ma_linear_resampler_config* pConfig, size_t* pHeapSizeInBytes)
+{
+    ma_result result;
+    ma_linear_resampler_heap_layout heapLayout;
+
+    if (pHeapSizeInBytes == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    *pHeapSizeInBytes = 0;
+
+    result = ma_linear_resampler_get_heap_layout(pConfig, &heapLayout);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    *pHeapSizeInBytes = heapLayout.sizeInBytes;
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_linear_resampler_init_preallocated(const ma_linear_resampler_config* pConfig, void* pHeap, ma_linear_resampler* pResampler)
+{
+    ma_result result;
+    ma_linear_resampler_heap_layout heapLayout;
+
+    if (pResampler == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    MA_ZERO_OBJECT(pResampler);
+
+    result = ma_linear_resampler_get_heap_layout(pConfig, &heapLayout);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    pResampler->config = *pConfig;
+
+    pResampler->_pHeap = pHeap;
+    MA_ZERO_MEMORY(pHeap, heapLayout.sizeInBytes);
+
+    if (pConfig->format == ma_format_f32) {
+        pResampler->x0.f32 = (float*)ma_offset_ptr(pHeap, heapLayout.x0Offset);
+        pResampler->x1.f32 = (float*)ma_offset_ptr(pHeap, heapLayout.x1Offset);
+    } else {
+        pResampler->x0.s16 = (ma_int16*)ma_offset_ptr(pHeap, heapLayout.x0Offset);
+        pResampler->x1.s16 = (ma_int16*)ma_offset_ptr(pHeap, heapLayout.x1Offset);
+    }
+
+    if (heapLayout.phaseCapacity > 0) {
+        pResampler->phaseCapacity = heapLayout.phaseCapacity;
+        pResampler->pPhases       = (ma_linear_resampler_phase*)ma_offset_ptr(pHeap, heapLayout.phasesOffset);
+    }
+
+    /* Setting the rate will set up the filter, time advances and phase table for us. */
+    result = ma_linear_resampler_set_rate_internal(pResampler, pHeap, &heapLayout, pConfig->sampleRateIn, pConfig->sampleRateOut, /* isResamplerAlreadyInitialized = */ MA_FALSE);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    pResampler->inTimeInt  = 1;  /* Set this to one to force an input sample to always be loaded for the first output frame. */
+    pResampler->inTimeFrac = 0;
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_linear_resampler_init(const ma_linear_resampler_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_linear_resampler* pResampler)
+{
+    ma_result result;
+    size_t heapSizeInBytes;
+    void* pHeap;
+
+    result = ma_linear_resampler_get_heap_size(pConfig, &heapSizeInBytes);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    if (heapSizeInBytes > 0) {
+        pHeap = ma_malloc(heapSizeInBytes, pAllocationCallbacks);
+        if (pHeap == NULL) {
+            return MA_OUT_OF_MEMORY;
+        }
+    } else {
+        pHeap = NULL;
+    }
+
+    result = ma_linear_resampler_init_preallocated(pConfig, pHeap, pResampler);
+    if (result != MA_SUCCESS) {
+        ma_free(pHeap, pAllocationCallbacks);
+        return result;
+    }
+
+    pResampler->_ownsHeap = MA_TRUE;
+    return MA_SUCCESS;
+}
+
+MA_API void ma_linear_resampler_uninit(ma_linear_resampler* pResampler, const ma_allocation_callbacks* pAllocationCallbacks)
+{
+    if (pResampler == NULL) {
+        return;
+    }
+
+    ma_lpf_uninit(&pResampler->lpf, pAllocationCallbacks);
+
+    if (pResampler->_ownsHeap) {
+        ma_free(pResampler->_pHeap, pAllocationCallbacks);
+    }
+}
+
+static MA_INLINE ma_int16 ma_linear_resampler_mix_s16(ma_int16 x, ma_int16 y, ma_int32 a, const ma_int32 shift)
+{
+    ma_int32 b;
+    ma_int32 c;
+    ma_int32 r;
+
+    MA_ASSERT(a <= (1<<shift));
+
+    b = x * ((1<<shift) - a);
+    c = y * a;
+    r = b + c;
+
+    return (ma_int16)(r >> shift);
+}
+
+static void ma_linear_resampler_interpolate_frame_s16(ma_linear_resampler* pResampler, ma_int16* MA_RESTRICT pFrameOut)
+{
+    ma_uint32 c;
+    ma_uint32 a;
+    const ma_uint32 channels = pResampler->config.channels;
+    const ma_uint32 shift = 12;
+
+    MA_ASSERT(pResampler != NULL);
+    MA_ASSERT(pFrameOut  != NULL);
+
+    if (pResampler->isFixedRatio) {
+        a = (ma_uint32)pResampler->pPhases[pResampler->inTimeFrac].alpha.s16;
+    } else {
+        a = (pResampler->inTimeFrac << shift) / pResampler->config.sampleRateOut;
+    }
+
+    MA_ASSUME(channels > 0);
+    for (c = 0; c < channels; c += 1) {
+        ma_int16 s = ma_linear_resampler_mix_s16(pResampler->x0.s16[c], pResampler->x1.s16[c], a, shift);
         pFrameOut[c] = s;
     }
 }
@@ -51340,7 +54870,11 @@ static void ma_linear_resampler_interpolate_frame_f32(ma_linear_resampler* pResa
     MA_ASSERT(pResampler != NULL);
     MA_ASSERT(pFrameOut  != NULL);
 
-    a = (float)pResampler->inTimeFrac / pResampler->config.sampleRateOut;
+    if (pResampler->isFixedRatio) {
+        a = pResampler->pPhases[pResampler->inTimeFrac].alpha.f32;
+    } else {
+        a = (float)pResampler->inTimeFrac / pResampler->config.sampleRateOut;
+    }
 
     MA_ASSUME(channels > 0);
     for (c = 0; c < channels; c += 1) {
@@ -51349,6 +54883,325 @@ static void ma_linear_resampler_interpolate_frame_f32(ma_linear_resampler* pResa
     }
 }
 
+/*
+Batched interpolation. Output frame i is interpolated between the input frame at pIndices[i] and the one
+immediately after it using the weight in pAlphas[i]. The arithmetic is the same as the per-frame functions
+above so the output is identical. The SIMD paths run across output frames for mono and stereo and across
+channels for everything else.
+*/
+#define MA_LINEAR_RESAMPLER_BATCH_SIZE  8
+
+static void ma_linear_resampler_interpolate_frames_s16__scalar(const ma_int16* MA_RESTRICT pFramesIn, ma_uint32 channels, const size_t* pIndices, const ma_int32* pAlphas, ma_uint32 frameCount, ma_int16* MA_RESTRICT pFramesOut)
+{
+    ma_uint32 iFrame;
+    ma_uint32 iChannel;
+    const ma_uint32 shift = 12;
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        const ma_int16* pX0 = pFramesIn + (pIndices[iFrame] * channels);
+        const ma_int16* pX1 = pX0 + channels;
+
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            pFramesOut[iChannel] = ma_linear_resampler_mix_s16(pX0[iChannel], pX1[iChannel], pAlphas[iFrame], shift);
+        }
+
+        pFramesOut += channels;
+    }
+}
+
+static void ma_linear_resampler_interpolate_frames_f32__scalar(const float* MA_RESTRICT pFramesIn, ma_uint32 channels, const size_t* pIndices, const float* pAlphas, ma_uint32 frameCount, float* MA_RESTRICT pFramesOut)
+{
+    ma_uint32 iFrame;
+    ma_uint32 iChannel;
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        const float* pX0 = pFramesIn + (pIndices[iFrame] * channels);
+        const float* pX1 = pX0 + channels;
+
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            pFramesOut[iChannel] = ma_mix_f32_fast(pX0[iChannel], pX1[iChannel], pAlphas[iFrame]);
+        }
+
+        pFramesOut += channels;
+    }
+}
+
+#if defined(MA_SUPPORT_SSE2)
+static MA_INLINE __m128i ma_linear_resampler_mix_s16__sse2(__m128i x0x1, __m128i weights)
+{
+    /* x0x1 holds interleaved pairs of samples and weights holds matching pairs of (1<<12)-a and a. */
+    return _mm_srai_epi32(_mm_madd_epi16(x0x1, weights), 12);
+}
+
+static void ma_linear_resampler_interpolate_frames_s16__sse2(const ma_int16* MA_RESTRICT pFramesIn, ma_uint32 channels, const size_t* pIndices, const ma_int32* pAlphas, ma_uint32 frameCount, ma_int16* MA_RESTRICT pFramesOut)
+{
+    ma_uint32 iFrame = 0;
+    ma_uint32 iChannel;
+
+    if (channels == 1) {
+        for (; iFrame + 4 <= frameCount; iFrame += 4) {
+            const ma_int16* pX0 = pFramesIn;
+            __m128i x = _mm_set_epi16(
+                pX0[pIndices[iFrame+3] + 1], pX0[pIndices[iFrame+3]],
+                pX0[pIndices[iFrame+2] + 1], pX0[pIndices[iFrame+2]],
+                pX0[pIndices[iFrame+1] + 1], pX0[pIndices[iFrame+1]],
+                pX0[pIndices[iFrame+0] + 1], pX0[pIndices[iFrame+0]]);
+            __m128i w = _mm_set_epi16(
+                (short)pAlphas[iFrame+3], (short)(4096 - pAlphas[iFrame+3]),
+                (short)pAlphas[iFrame+2], (short)(4096 - pAlphas[iFrame+2]),
+                (short)pAlphas[iFrame+1], (short)(4096 - pAlphas[iFrame+1]),
+                (short)pAlphas[iFrame+0], (short)(4096 - pAlphas[iFrame+0]));
+            __m128i r = ma_linear_resampler_mix_s16__sse2(x, w);
+
+            _mm_storel_epi64((__m128i*)(pFramesOut + iFrame), _mm_packs_epi32(r, r));
+        }
+    } else if (channels == 2) {
+        for (; iFrame + 2 <= frameCount; iFrame += 2) {
+            /* Each load picks up both frames that are being interpolated, [x0L x0R x1L x1R], which are then reordered into pairs. */
+            __m128i a = _mm_loadl_epi64((const __m128i*)(pFramesIn + (pIndices[iFrame+0] * 2)));
+            __m128i b = _mm_loadl_epi64((const __m128i*)(pFramesIn + (pIndices[iFrame+1] * 2)));
+            __m128i x = _mm_unpacklo_epi64(a, b);
+            __m128i w = _mm_set_epi16(
+                (short)pAlphas[iFrame+1], (short)(4096 - pAlphas[iFrame+1]), (short)pAlphas[iFrame+1], (short)(4096 - pAlphas[iFrame+1]),
+                (short)pAlphas[iFrame+0], (short)(4096 - pAlphas[iFrame+0]), (short)pAlphas[iFrame+0], (short)(4096 - pAlphas[iFrame+0]));
+            __m128i r;
+
+            x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 1, 2, 0));
+            x = _mm_shufflehi_epi16(x, _MM_SHUFFLE(3, 1, 2, 0));
+            r = ma_linear_resampler_mix_s16__sse2(x, w);
+
+            _mm_storel_epi64((__m128i*)(pFramesOut + (iFrame * 2)), _mm_packs_epi32(r, r));
+        }
+    } else {
+        for (; iFrame < frameCount; iFrame += 1) {
+            const ma_int16* pX0 = pFramesIn + (pIndices[iFrame] * channels);
+            const ma_int16* pX1 = pX0 + channels;
+            ma_int16* pY = pFramesOut + (iFrame * channels);
+            __m128i w = _mm_set1_epi32((ma_int32)(((ma_uint32)pAlphas[iFrame] << 16) | (ma_uint32)(4096 - pAlphas[iFrame])));
+
+            for (iChannel = 0; iChannel + 8 <= channels; iChannel += 8) {
+                __m128i x0 = _mm_loadu_si128((const __m128i*)(pX0 + iChannel));
+                __m128i x1 = _mm_loadu_si128((const __m128i*)(pX1 + iChannel));
+                __m128i lo = ma_linear_resampler_mix_s16__sse2(_mm_unpacklo_epi16(x0, x1), w);
+                __m128i hi = ma_linear_resampler_mix_s16__sse2(_mm_unpackhi_epi16(x0, x1), w);
+
+                _mm_storeu_si128((__m128i*)(pY + iChannel), _mm_packs_epi32(lo, hi));
+            }
+
+            for (; iChannel + 4 <= channels; iChannel += 4) {
+                __m128i x0 = _mm_loadl_epi64((const __m128i*)(pX0 + iChannel));
+                __m128i x1 = _mm_loadl_epi64((const __m128i*)(pX1 + iChannel));
+                __m128i r  = ma_linear_resampler_mix_s16__sse2(_mm_unpacklo_epi16(x0, x1), w);
+
+                _mm_storel_epi64((__m128i*)(pY + iChannel), _mm_packs_epi32(r, r));
+            }
+
+            for (; iChannel < channels; iChannel += 1) {
+                pY[iChannel] = ma_linear_resampler_mix_s16(pX0[iChannel], pX1[iChannel], pAlphas[iFrame], 12);
+            }
+        }
+    }
+
+    /* Leftovers for mono and stereo. */
+    ma_linear_resampler_interpolate_frames_s16__scalar(pFramesIn, channels, pIndices + iFrame, pAlphas + iFrame, frameCount - iFrame, pFramesOut + (iFrame * channels));
+}
+
+static void ma_linear_resampler_interpolate_frames_f32__sse2(const float* MA_RESTRICT pFramesIn, ma_uint32 channels, const size_t* pIndices, const float* pAlphas, ma_uint32 frameCount, float* MA_RESTRICT pFramesOut)
+{
+    ma_uint32 iFrame = 0;
+    ma_uint32 iChannel;
+
+    if (channels == 1) {
+        for (; iFrame + 4 <= frameCount; iFrame += 4) {
+            __m128 x0 = _mm_set_ps(pFramesIn[pIndices[iFrame+3]    ], pFramesIn[pIndices[iFrame+2]    ], pFramesIn[pIndices[iFrame+1]    ], pFramesIn[pIndices[iFrame+0]    ]);
+            __m128 x1 = _mm_set_ps(pFramesIn[pIndices[iFrame+3] + 1], pFramesIn[pIndices[iFrame+2] + 1], pFramesIn[pIndices[iFrame+1] + 1], pFramesIn[pIndices[iFrame+0] + 1]);
+
+            _mm_storeu_ps(pFramesOut + iFrame, ma_mix_f32_fast__sse2(x0, x1, _mm_loadu_ps(pAlphas + iFrame)));
+        }
+    } else if (channels == 2) {
+        for (; iFrame + 2 <= frameCount; iFrame += 2) {
+            /* Each load picks up both frames that are being interpolated, [x0L x0R x1L x1R]. */
+            __m128 a  = _mm_loadu_ps(pFramesIn + (pIndices[iFrame+0] * 2));
+            __m128 b  = _mm_loadu_ps(pFramesIn + (pIndices[iFrame+1] * 2));
+            __m128 x0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 1, 0));
+            __m128 x1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 2, 3, 2));
+            __m128 w  = _mm_set_ps(pAlphas[iFrame+1], pAlphas[iFrame+1], pAlphas[iFrame+0], pAlphas[iFrame+0]);
+
+            _mm_storeu_ps(pFramesOut + (iFrame * 2), ma_mix_f32_fast__sse2(x0, x1, w));
+        }
+    } else {
+        for (; iFrame < frameCount; iFrame += 1) {
+            const float* pX0 = pFramesIn + (pIndices[iFrame] * channels);
+            const float* pX1 = pX0 + channels;
+            float* pY = pFramesOut + (iFrame * channels);
+            __m128 w = _mm_set1_ps(pAlphas[iFrame]);
+
+            for (iChannel = 0; iChannel + 4 <= channels; iChannel += 4) {
+                _mm_storeu_ps(pY + iChannel, ma_mix_f32_fast__sse2(_mm_loadu_ps(pX0 + iChannel), _mm_loadu_ps(pX1 + iChannel), w));
+            }
+
+            for (; iChannel < channels; iChannel += 1) {
+                pY[iChannel] = ma_mix_f32_fast(pX0[iChannel], pX1[iChannel], pAlphas[iFrame]);
+            }
+        }
+    }
+
+    /* Leftovers for mono and stereo. */
+    ma_linear_resampler_interpolate_frames_f32__scalar(pFramesIn, channels, pIndices + iFrame, pAlphas + iFrame, frameCount - iFrame, pFramesOut + (iFrame * channels));
+}
+#endif
+
+#if defined(MA_SUPPORT_AVX2)
+static void ma_linear_resampler_interpolate_frames_f32__avx2(const float* MA_RESTRICT pFramesIn, ma_uint32 channels, const size_t* pIndices, const float* pAlphas, ma_uint32 frameCount, float* MA_RESTRICT pFramesOut)
+{
+    ma_uint32 iFrame;
+    ma_uint32 iChannel;
+
+    /* Only wide layouts benefit from the extra lanes. Everything else uses the SSE2 path. */
+    if (channels < 8) {
+        ma_linear_resampler_interpolate_frames_f32__sse2(pFramesIn, channels, pIndices, pAlphas, frameCount, pFramesOut);
+        return;
+    }
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        const float* pX0 = pFramesIn + (pIndices[iFrame] * channels);
+        const float* pX1 = pX0 + channels;
+        float* pY = pFramesOut + (iFrame * channels);
+        __m256 w = _mm256_set1_ps(pAlphas[iFrame]);
+
+        for (iChannel = 0; iChannel + 8 <= channels; iChannel += 8) {
+            _mm256_storeu_ps(pY + iChannel, ma_mix_f32_fast__avx2(_mm256_loadu_ps(pX0 + iChannel), _mm256_loadu_ps(pX1 + iChannel), w));
+        }
+
+        for (; iChannel < channels; iChannel += 1) {
+            pY[iChannel] = ma_mix_f32_fast(pX0[iChannel], pX1[iChannel], pAlphas[iFrame]);
+        }
+    }
+}
+#endif
+
+#if defined(MA_SUPPORT_NEON)
+static void ma_linear_resampler_interpolate_frames_s16__neon(const ma_int16* MA_RESTRICT pFramesIn, ma_uint32 channels, const size_t* pIndices, const ma_int32* pAlphas, ma_uint32 frameCount, ma_int16* MA_RESTRICT pFramesOut)
+{
+    ma_uint32 iFrame;
+    ma_uint32 iChannel;
+
+    if (channels < 4) {
+        ma_linear_resampler_interpolate_frames_s16__scalar(pFramesIn, channels, pIndices, pAlphas, frameCount, pFramesOut);
+        return;
+    }
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        const ma_int16* pX0 = pFramesIn + (pIndices[iFrame] * channels);
+        const ma_int16* pX1 = pX0 + channels;
+        ma_int16* pY = pFramesOut + (iFrame * channels);
+        int16x4_t w0 = vdup_n_s16((ma_int16)(4096 - pAlphas[iFrame]));
+        int16x4_t w1 = vdup_n_s16((ma_int16)pAlphas[iFrame]);
+
+        for (iChannel = 0; iChannel + 4 <= channels; iChannel += 4) {
+            int32x4_t r = vmlal_s16(vmull_s16(vld1_s16(pX0 + iChannel), w0), vld1_s16(pX1 + iChannel), w1);
+            vst1_s16(pY + iChannel, vshrn_n_s32(r, 12));
+        }
+
+        for (; iChannel < channels; iChannel += 1) {
+            pY[iChannel] = ma_linear_resampler_mix_s16(pX0[iChannel], pX1[iChannel], pAlphas[iFrame], 12);
+        }
+    }
+}
+
+static void ma_linear_resampler_interpolate_frames_f32__neon(const float* MA_RESTRICT pFramesIn, ma_uint32 channels, const size_t* pIndices, const float* pAlphas, ma_uint32 frameCount, float* MA_RESTRICT pFramesOut)
+{
+    ma_uint32 iFrame = 0;
+    ma_uint32 iChannel;
+
+    if (channels == 1) {
+        for (; iFrame + 4 <= frameCount; iFrame += 4) {
+            float x0[4];
+            float x1[4];
+            ma_uint32 i;
+
+            for (i = 0; i < 4; i += 1) {
+                x0[i] = pFramesIn[pIndices[iFrame+i]    ];
+                x1[i] = pFramesIn[pIndices[iFrame+i] + 1];
+            }
+
+            vst1q_f32(pFramesOut + iFrame, ma_mix_f32_fast__neon(vld1q_f32(x0), vld1q_f32(x1), vld1q_f32(pAlphas + iFrame)));
+        }
+    } else if (channels == 2) {
+        for (; iFrame + 2 <= frameCount; iFrame += 2) {
+            /* Each load picks up both frames that are being interpolated, [x0L x0R x1L x1R]. */
+            float32x4_t a  = vld1q_f32(pFramesIn + (pIndices[iFrame+0] * 2));
+            float32x4_t b  = vld1q_f32(pFramesIn + (pIndices[iFrame+1] * 2));
+            float32x4_t x0 = vcombine_f32(vget_low_f32(a),  vget_low_f32(b));
+            float32x4_t x1 = vcombine_f32(vget_high_f32(a), vget_high_f32(b));
+            float32x4_t w  = vcombine_f32(vdup_n_f32(pAlphas[iFrame+0]), vdup_n_f32(pAlphas[iFrame+1]));
+
+            vst1q_f32(pFramesOut + (iFrame * 2), ma_mix_f32_fast__neon(x0, x1, w));
+        }
+    } else {
+        for (; iFrame < frameCount; iFrame += 1) {
+            const float* pX0 = pFramesIn + (pIndices[iFrame] * channels);
+            const float* pX1 = pX0 + channels;
+            float* pY = pFramesOut + (iFrame * channels);
+            float32x4_t w = vdupq_n_f32(pAlphas[iFrame]);
+
+            for (iChannel = 0; iChannel + 4 <= channels; iChannel += 4) {
+                vst1q_f32(pY + iChannel, ma_mix_f32_fast__neon(vld1q_f32(pX0 + iChannel), vld1q_f32(pX1 + iChannel), w));
+            }
+
+            for (; iChannel < channels; iChannel += 1) {
+                pY[iChannel] = ma_mix_f32_fast(pX0[iChannel], pX1[iChannel], pAlphas[iFrame]);
+            }
+        }
+    }
+
+    /* Leftovers for mono and stereo. */
+    ma_linear_resampler_interpolate_frames_f32__scalar(pFramesIn, channels, pIndices + iFrame, pAlphas + iFrame, frameCount - iFrame, pFramesOut + (iFrame * channels));
+}
+#endif
+
+static void ma_linear_resampler_interpolate_frames_s16(const ma_int16* MA_RESTRICT pFramesIn, ma_uint32 channels, const size_t* pIndices, const ma_int32* pAlphas, ma_uint32 frameCount, ma_int16* MA_RESTRICT pFramesOut)
+{
+#if defined(MA_SUPPORT_SSE2)
+    if (ma_has_sse2()) {
+        ma_linear_resampler_interpolate_frames_s16__sse2(pFramesIn, channels, pIndices, pAlphas, frameCount, pFramesOut);
+        return;
+    }
+#endif
+#if defined(MA_SUPPORT_NEON)
+    if (ma_has_neon()) {
+        ma_linear_resampler_interpolate_frames_s16__neon(pFramesIn, channels, pIndices, pAlphas, frameCount, pFramesOut);
+        return;
+    }
+#endif
+
+    ma_linear_resampler_interpolate_frames_s16__scalar(pFramesIn, channels, pIndices, pAlphas, frameCount, pFramesOut);
+}
+
+static void ma_linear_resampler_interpolate_frames_f32(const float* MA_RESTRICT pFramesIn, ma_uint32 channels, const size_t* pIndices, const float* pAlphas, ma_uint32 frameCount, float* MA_RESTRICT pFramesOut)
+{
+#if defined(MA_SUPPORT_AVX2)
+    if (ma_has_avx2()) {
+        ma_linear_resampler_interpolate_frames_f32__avx2(pFramesIn, channels, pIndices, pAlphas, frameCount, pFramesOut);
+        return;
+    }
+#endif
+#if defined(MA_SUPPORT_SSE2)
+    if (ma_has_sse2()) {
+        ma_linear_resampler_interpolate_frames_f32__sse2(pFramesIn, channels, pIndices, pAlphas, frameCount, pFramesOut);
+        return;
+    }
+#endif
+#if defined(MA_SUPPORT_NEON)
+    if (ma_has_neon()) {
+        ma_linear_resampler_interpolate_frames_f32__neon(pFramesIn, channels, pIndices, pAlphas, frameCount, pFramesOut);
+        return;
+    }
+#endif
+
+    ma_linear_resampler_interpolate_frames_f32__scalar(pFramesIn, channels, pIndices, pAlphas, frameCount, pFramesOut);
+}
+
 static ma_result ma_linear_resampler_process_pcm_frames_s16_downsample(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
 {
     const ma_int16* pFramesInS16;
@@ -51387,244 +55240,1322 @@ static ma_result ma_linear_resampler_process_pcm_frames_s16_downsample(ma_linear
                 }
             }
 
-            /* Filter. Do not apply filtering if sample rates are the same or else you'll get dangerous glitching. */
-            if (pResampler->config.sampleRateIn != pResampler->config.sampleRateOut) {
-                ma_lpf_process_pcm_frame_s16(&pResampler->lpf, pResampler->x1.s16, pResampler->x1.s16);
-            }
+            /* Filter. Do not apply filtering if sample rates are the same or else you'll get dangerous glitching. */
+            if (pResampler->config.sampleRateIn != pResampler->config.sampleRateOut) {
+                ma_lpf_process_pcm_frame_s16(&pResampler->lpf, pResampler->x1.s16, pResampler->x1.s16);
+            }
+
+            framesProcessedIn     += 1;
+            pResampler->inTimeInt -= 1;
+        }
+
+        if (pResampler->inTimeInt > 0) {
+            break;  /* Ran out of input data. */
+        }
+
+        /* Getting here means the frames have been loaded and filtered and we can generate the next output frame. */
+        if (pFramesOutS16 != NULL) {
+            MA_ASSERT(pResampler->inTimeInt == 0);
+            ma_linear_resampler_interpolate_frame_s16(pResampler, pFramesOutS16);
+
+            pFramesOutS16 += pResampler->config.channels;
+        }
+
+        framesProcessedOut += 1;
+
+        /* Advance time forward. */
+        pResampler->inTimeInt  += pResampler->inAdvanceInt;
+        pResampler->inTimeFrac += pResampler->inAdvanceFrac;
+        if (pResampler->inTimeFrac >= pResampler->config.sampleRateOut) {
+            pResampler->inTimeFrac -= pResampler->config.sampleRateOut;
+            pResampler->inTimeInt  += 1;
+        }
+    }
+
+    *pFrameCountIn  = framesProcessedIn;
+    *pFrameCountOut = framesProcessedOut;
+
+    return MA_SUCCESS;
+}
+
+static ma_result ma_linear_resampler_process_pcm_frames_s16_upsample(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+{
+    const ma_int16* pFramesInS16;
+    /* */ ma_int16* pFramesOutS16;
+    ma_uint64 frameCountIn;
+    ma_uint64 frameCountOut;
+    ma_uint64 framesProcessedIn;
+    ma_uint64 framesProcessedOut;
+
+    MA_ASSERT(pResampler     != NULL);
+    MA_ASSERT(pFrameCountIn  != NULL);
+    MA_ASSERT(pFrameCountOut != NULL);
+
+    pFramesInS16       = (const ma_int16*)pFramesIn;
+    pFramesOutS16      = (      ma_int16*)pFramesOut;
+    frameCountIn       = *pFrameCountIn;
+    frameCountOut      = *pFrameCountOut;
+    framesProcessedIn  = 0;
+    framesProcessedOut = 0;
+
+    while (framesProcessedOut < frameCountOut) {
+        /* Before interpolating we need to load the buffers. */
+        while (pResampler->inTimeInt > 0 && frameCountIn > framesProcessedIn) {
+            ma_uint32 iChannel;
+
+            if (pFramesInS16 != NULL) {
+                for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
+                    pResampler->x0.s16[iChannel] = pResampler->x1.s16[iChannel];
+                    pResampler->x1.s16[iChannel] = pFramesInS16[iChannel];
+                }
+                pFramesInS16 += pResampler->config.channels;
+            } else {
+                for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
+                    pResampler->x0.s16[iChannel] = pResampler->x1.s16[iChannel];
+                    pResampler->x1.s16[iChannel] = 0;
+                }
+            }
+
+            framesProcessedIn     += 1;
+            pResampler->inTimeInt -= 1;
+        }
+
+        if (pResampler->inTimeInt > 0) {
+            break;  /* Ran out of input data. */
+        }
+
+        /* Getting here means the frames have been loaded and we can generate the next output frame. */
+        if (pFramesOutS16 != NULL) {
+            MA_ASSERT(pResampler->inTimeInt == 0);
+            ma_linear_resampler_interpolate_frame_s16(pResampler, pFramesOutS16);
+
+            /* Filter. Do not apply filtering if sample rates are the same or else you'll get dangerous glitching. */
+            if (pResampler->config.sampleRateIn != pResampler->config.sampleRateOut) {
+                ma_lpf_process_pcm_frame_s16(&pResampler->lpf, pFramesOutS16, pFramesOutS16);
+            }
+
+            pFramesOutS16 += pResampler->config.channels;
+        }
+
+        framesProcessedOut += 1;
+
+        /* Advance time forward. */
+        pResampler->inTimeInt  += pResampler->inAdvanceInt;
+        pResampler->inTimeFrac += pResampler->inAdvanceFrac;
+        if (pResampler->inTimeFrac >= pResampler->config.sampleRateOut) {
+            pResampler->inTimeFrac -= pResampler->config.sampleRateOut;
+            pResampler->inTimeInt  += 1;
+        }
+    }
+
+    *pFrameCountIn  = framesProcessedIn;
+    *pFrameCountOut = framesProcessedOut;
+
+    return MA_SUCCESS;
+}
+
+/*
+Batched processing. This is only used when there's both an input and an output buffer. Rather than
+cycling every input frame through x0 and x1, output frames are interpolated straight out of the input
+buffer in batches. The per-frame path above is still used for the first couple of input frames, since
+they need the cached frame from the previous call, and for when input runs out part way through a
+frame. No filtering is done here.
+*/
+static ma_result ma_linear_resampler_process_pcm_frames_s16_batched(ma_linear_resampler* pResampler, const ma_int16* pFramesIn, ma_uint64* pFrameCountIn, ma_int16* pFramesOut, ma_uint64* pFrameCountOut)
+{
+    ma_uint64 frameCountIn;
+    ma_uint64 frameCountOut;
+    ma_uint64 framesProcessedIn;
+    ma_uint64 framesProcessedOut;
+    ma_uint32 channels;
+
+    MA_ASSERT(pResampler     != NULL);
+    MA_ASSERT(pFramesIn      != NULL);
+    MA_ASSERT(pFrameCountIn  != NULL);
+    MA_ASSERT(pFramesOut     != NULL);
+    MA_ASSERT(pFrameCountOut != NULL);
+
+    frameCountIn       = *pFrameCountIn;
+    frameCountOut      = *pFrameCountOut;
+    framesProcessedIn  = 0;
+    framesProcessedOut = 0;
+    channels           = pResampler->config.channels;
+
+    while (framesProcessedOut < frameCountOut) {
+        if (framesProcessedIn + pResampler->inTimeInt >= 2 && framesProcessedIn + pResampler->inTimeInt <= frameCountIn) {
+            /* Both frames for the next output frame are in the input buffer. */
+            while (framesProcessedOut < frameCountOut) {
+                size_t indices[MA_LINEAR_RESAMPLER_BATCH_SIZE];
+                ma_int32 alphas[MA_LINEAR_RESAMPLER_BATCH_SIZE];
+                ma_uint32 batchCount = 0;
+
+                if (pResampler->isFixedRatio) {
+                    /* Fixed ratios have the weight and the step for each phase in a table. */
+                    while (batchCount < MA_LINEAR_RESAMPLER_BATCH_SIZE && framesProcessedOut + batchCount < frameCountOut) {
+                        const ma_linear_resampler_phase* pPhase;
+                        ma_uint64 iFrameIn = framesProcessedIn + pResampler->inTimeInt;  /* One past the second frame. */
+                        if (iFrameIn > frameCountIn) {
+                            break;
+                        }
+
+                        pPhase = &pResampler->pPhases[pResampler->inTimeFrac];
+
+                        indices[batchCount] = (size_t)(iFrameIn - 2);
+                        alphas[batchCount]  = pPhase->alpha.s16;
+                        batchCount += 1;
+
+                        framesProcessedIn      = iFrameIn;
+                        pResampler->inTimeInt  = pPhase->inAdvance;
+                        pResampler->inTimeFrac = pPhase->nextPhase;
+                    }
+                } else {
+                    while (batchCount < MA_LINEAR_RESAMPLER_BATCH_SIZE && framesProcessedOut + batchCount < frameCountOut) {
+                        ma_uint64 iFrameIn = framesProcessedIn + pResampler->inTimeInt;  /* One past the second frame. */
+                        if (iFrameIn > frameCountIn) {
+                            break;
+                        }
+
+                        indices[batchCount] = (size_t)(iFrameIn - 2);
+                        alphas[batchCount]  = (ma_int32)((pResampler->inTimeFrac << 12) / pResampler->config.sampleRateOut);
+                        batchCount += 1;
+
+                        framesProcessedIn     = iFrameIn;
+                        pResampler->inTimeInt = 0;
+
+                        /* Advance time forward. */
+                        pResampler->inTimeInt  += pResampler->inAdvanceInt;
+                        pResampler->inTimeFrac += pResampler->inAdvanceFrac;
+                        if (pResampler->inTimeFrac >= pResampler->config.sampleRateOut) {
+                            pResampler->inTimeFrac -= pResampler->config.sampleRateOut;
+                            pResampler->inTimeInt  += 1;
+                        }
+                    }
+                }
+
+                if (batchCount == 0) {
+                    break;
+                }
+
+                ma_linear_resampler_interpolate_frames_s16(pFramesIn, channels, indices, alphas, batchCount, pFramesOut + (framesProcessedOut * channels));
+                framesProcessedOut += batchCount;
+            }
+
+            /* The cached frames need to be kept in sync for the next call. */
+            MA_COPY_MEMORY(pResampler->x0.s16, pFramesIn + ((framesProcessedIn - 2) * channels), sizeof(ma_int16) * channels);
+            MA_COPY_MEMORY(pResampler->x1.s16, pFramesIn + ((framesProcessedIn - 1) * channels), sizeof(ma_int16) * channels);
+        } else {
+            /* Slow path. This is the same as the per-frame path, only for a single output frame. */
+            while (pResampler->inTimeInt > 0 && frameCountIn > framesProcessedIn) {
+                MA_COPY_MEMORY(pResampler->x0.s16, pResampler->x1.s16, sizeof(ma_int16) * channels);
+                MA_COPY_MEMORY(pResampler->x1.s16, pFramesIn + (framesProcessedIn * channels), sizeof(ma_int16) * channels);
+
+                framesProcessedIn     += 1;
+                pResampler->inTimeInt -= 1;
+            }
+
+            if (pResampler->inTimeInt > 0) {
+                break;  /* Ran out of input data. */
+            }
+
+            ma_linear_resampler_interpolate_frame_s16(pResampler, pFramesOut + (framesProcessedOut * channels));
+            framesProcessedOut += 1;
+
+            /* Advance time forward. */
+            pResampler->inTimeInt  += pResampler->inAdvanceInt;
+            pResampler->inTimeFrac += pResampler->inAdvanceFrac;
+            if (pResampler->inTimeFrac >= pResampler->config.sampleRateOut) {
+                pResampler->inTimeFrac -= pResampler->config.sampleRateOut;
+                pResampler->inTimeInt  += 1;
+            }
+        }
+    }
+
+    *pFrameCountIn  = framesProcessedIn;
+    *pFrameCountOut = framesProcessedOut;
+
+    return MA_SUCCESS;
+}
+
+static ma_result ma_linear_resampler_process_pcm_frames_s16(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+{
+    MA_ASSERT(pResampler != NULL);
+
+    /*
+    The batched path is used when there's no filtering, which is the case when pitching sounds in the engine. When
+    filtering is enabled the filter dominates and the per-frame path is faster since it keeps the filter fused with
+    the interpolation. The batched path also needs an input and an output buffer.
+    */
+    if (pFramesIn != NULL && pFramesOut != NULL && (pResampler->config.sampleRateIn == pResampler->config.sampleRateOut || (pResampler->lpf.lpf1Count + pResampler->lpf.lpf2Count) == 0)) {
+        return ma_linear_resampler_process_pcm_frames_s16_batched(pResampler, (const ma_int16*)pFramesIn, pFrameCountIn, (ma_int16*)pFramesOut, pFrameCountOut);
+    }
+
+    if (pResampler->config.sampleRateIn > pResampler->config.sampleRateOut) {
+        return ma_linear_resampler_process_pcm_frames_s16_downsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+    } else {
+        return ma_linear_resampler_process_pcm_frames_s16_upsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+    }
+}
+
+
+static ma_result ma_linear_resampler_process_pcm_frames_f32_downsample(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+{
+    const float* pFramesInF32;
+    /* */ float* pFramesOutF32;
+    ma_uint64 frameCountIn;
+    ma_uint64 frameCountOut;
+    ma_uint64 framesProcessedIn;
+    ma_uint64 framesProcessedOut;
+
+    MA_ASSERT(pResampler     != NULL);
+    MA_ASSERT(pFrameCountIn  != NULL);
+    MA_ASSERT(pFrameCountOut != NULL);
+
+    pFramesInF32       = (const float*)pFramesIn;
+    pFramesOutF32      = (      float*)pFramesOut;
+    frameCountIn       = *pFrameCountIn;
+    frameCountOut      = *pFrameCountOut;
+    framesProcessedIn  = 0;
+    framesProcessedOut = 0;
+
+    while (framesProcessedOut < frameCountOut) {
+        /* Before interpolating we need to load the buffers. When doing this we need to ensure we run every input sample through the filter. */
+        while (pResampler->inTimeInt > 0 && frameCountIn > framesProcessedIn) {
+            ma_uint32 iChannel;
+
+            if (pFramesInF32 != NULL) {
+                for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
+                    pResampler->x0.f32[iChannel] = pResampler->x1.f32[iChannel];
+                    pResampler->x1.f32[iChannel] = pFramesInF32[iChannel];
+                }
+                pFramesInF32 += pResampler->config.channels;
+            } else {
+                for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
+                    pResampler->x0.f32[iChannel] = pResampler->x1.f32[iChannel];
+                    pResampler->x1.f32[iChannel] = 0;
+                }
+            }
+
+            /* Filter. Do not apply filtering if sample rates are the same or else you'll get dangerous glitching. */
+            if (pResampler->config.sampleRateIn != pResampler->config.sampleRateOut) {
+                ma_lpf_process_pcm_frame_f32(&pResampler->lpf, pResampler->x1.f32, pResampler->x1.f32);
+            }
+
+            framesProcessedIn     += 1;
+            pResampler->inTimeInt -= 1;
+        }
+
+        if (pResampler->inTimeInt > 0) {
+            break;  /* Ran out of input data. */
+        }
+
+        /* Getting here means the frames have been loaded and filtered and we can generate the next output frame. */
+        if (pFramesOutF32 != NULL) {
+            MA_ASSERT(pResampler->inTimeInt == 0);
+            ma_linear_resampler_interpolate_frame_f32(pResampler, pFramesOutF32);
+
+            pFramesOutF32 += pResampler->config.channels;
+        }
+
+        framesProcessedOut += 1;
+
+        /* Advance time forward. */
+        pResampler->inTimeInt  += pResampler->inAdvanceInt;
+        pResampler->inTimeFrac += pResampler->inAdvanceFrac;
+        if (pResampler->inTimeFrac >= pResampler->config.sampleRateOut) {
+            pResampler->inTimeFrac -= pResampler->config.sampleRateOut;
+            pResampler->inTimeInt  += 1;
+        }
+    }
+
+    *pFrameCountIn  = framesProcessedIn;
+    *pFrameCountOut = framesProcessedOut;
+
+    return MA_SUCCESS;
+}
+
+static ma_result ma_linear_resampler_process_pcm_frames_f32_upsample(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+{
+    const float* pFramesInF32;
+    /* */ float* pFramesOutF32;
+    ma_uint64 frameCountIn;
+    ma_uint64 frameCountOut;
+    ma_uint64 framesProcessedIn;
+    ma_uint64 framesProcessedOut;
+
+    MA_ASSERT(pResampler     != NULL);
+    MA_ASSERT(pFrameCountIn  != NULL);
+    MA_ASSERT(pFrameCountOut != NULL);
+
+    pFramesInF32       = (const float*)pFramesIn;
+    pFramesOutF32      = (      float*)pFramesOut;
+    frameCountIn       = *pFrameCountIn;
+    frameCountOut      = *pFrameCountOut;
+    framesProcessedIn  = 0;
+    framesProcessedOut = 0;
+
+    while (framesProcessedOut < frameCountOut) {
+        /* Before interpolating we need to load the buffers. */
+        while (pResampler->inTimeInt > 0 && frameCountIn > framesProcessedIn) {
+            ma_uint32 iChannel;
+
+            if (pFramesInF32 != NULL) {
+                for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
+                    pResampler->x0.f32[iChannel] = pResampler->x1.f32[iChannel];
+                    pResampler->x1.f32[iChannel] = pFramesInF32[iChannel];
+                }
+                pFramesInF32 += pResampler->config.channels;
+            } else {
+                for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
+                    pResampler->x0.f32[iChannel] = pResampler->x1.f32[iChannel];
+                    pResampler->x1.f32[iChannel] = 0;
+                }
+            }
+
+            framesProcessedIn     += 1;
+            pResampler->inTimeInt -= 1;
+        }
+
+        if (pResampler->inTimeInt > 0) {
+            break;  /* Ran out of input data. */
+        }
+
+        /* Getting here means the frames have been loaded and we can generate the next output frame. */
+        if (pFramesOutF32 != NULL) {
+            MA_ASSERT(pResampler->inTimeInt == 0);
+            ma_linear_resampler_interpolate_frame_f32(pResampler, pFramesOutF32);
+
+            /* Filter. Do not apply filtering if sample rates are the same or else you'll get dangerous glitching. */
+            if (pResampler->config.sampleRateIn != pResampler->config.sampleRateOut) {
+                ma_lpf_process_pcm_frame_f32(&pResampler->lpf, pFramesOutF32, pFramesOutF32);
+            }
+
+            pFramesOutF32 += pResampler->config.channels;
+        }
+
+        framesProcessedOut += 1;
+
+        /* Advance time forward. */
+        pResampler->inTimeInt  += pResampler->inAdvanceInt;
+        pResampler->inTimeFrac += pResampler->inAdvanceFrac;
+        if (pResampler->inTimeFrac >= pResampler->config.sampleRateOut) {
+            pResampler->inTimeFrac -= pResampler->config.sampleRateOut;
+            pResampler->inTimeInt  += 1;
+        }
+    }
+
+    *pFrameCountIn  = framesProcessedIn;
+    *pFrameCountOut = framesProcessedOut;
+
+    return MA_SUCCESS;
+}
+
+static ma_result ma_linear_resampler_process_pcm_frames_f32_batched(ma_linear_resampler* pResampler, const float* pFramesIn, ma_uint64* pFrameCountIn, float* pFramesOut, ma_uint64* pFrameCountOut)
+{
+    ma_uint64 frameCountIn;
+    ma_uint64 frameCountOut;
+    ma_uint64 framesProcessedIn;
+    ma_uint64 framesProcessedOut;
+    ma_uint32 channels;
+
+    MA_ASSERT(pResampler     != NULL);
+    MA_ASSERT(pFramesIn      != NULL);
+    MA_ASSERT(pFrameCountIn  != NULL);
+    MA_ASSERT(pFramesOut     != NULL);
+    MA_ASSERT(pFrameCountOut != NULL);
+
+    frameCountIn       = *pFrameCountIn;
+    frameCountOut      = *pFrameCountOut;
+    framesProcessedIn  = 0;
+    framesProcessedOut = 0;
+    channels           = pResampler->config.channels;
+
+    while (framesProcessedOut < frameCountOut) {
+        if (framesProcessedIn + pResampler->inTimeInt >= 2 && framesProcessedIn + pResampler->inTimeInt <= frameCountIn) {
+            /* Both frames for the next output frame are in the input buffer. */
+            while (framesProcessedOut < frameCountOut) {
+                size_t indices[MA_LINEAR_RESAMPLER_BATCH_SIZE];
+                float alphas[MA_LINEAR_RESAMPLER_BATCH_SIZE];
+                ma_uint32 batchCount = 0;
+
+                if (pResampler->isFixedRatio) {
+                    /* Fixed ratios have the weight and the step for each phase in a table. */
+                    while (batchCount < MA_LINEAR_RESAMPLER_BATCH_SIZE && framesProcessedOut + batchCount < frameCountOut) {
+                        const ma_linear_resampler_phase* pPhase;
+                        ma_uint64 iFrameIn = framesProcessedIn + pResampler->inTimeInt;  /* One past the second frame. */
+                        if (iFrameIn > frameCountIn) {
+                            break;
+                        }
+
+                        pPhase = &pResampler->pPhases[pResampler->inTimeFrac];
+
+                        indices[batchCount] = (size_t)(iFrameIn - 2);
+                        alphas[batchCount]  = pPhase->alpha.f32;
+                        batchCount += 1;
+
+                        framesProcessedIn      = iFrameIn;
+                        pResampler->inTimeInt  = pPhase->inAdvance;
+                        pResampler->inTimeFrac = pPhase->nextPhase;
+                    }
+                } else {
+                    while (batchCount < MA_LINEAR_RESAMPLER_BATCH_SIZE && framesProcessedOut + batchCount < frameCountOut) {
+                        ma_uint64 iFrameIn = framesProcessedIn + pResampler->inTimeInt;  /* One past the second frame. */
+                        if (iFrameIn > frameCountIn) {
+                            break;
+                        }
+
+                        indices[batchCount] = (size_t)(iFrameIn - 2);
+                        alphas[batchCount]  = (float)pResampler->inTimeFrac / pResampler->config.sampleRateOut;
+                        batchCount += 1;
+
+                        framesProcessedIn     = iFrameIn;
+                        pResampler->inTimeInt = 0;
+
+                        /* Advance time forward. */
+                        pResampler->inTimeInt  += pResampler->inAdvanceInt;
+                        pResampler->inTimeFrac += pResampler->inAdvanceFrac;
+                        if (pResampler->inTimeFrac >= pResampler->config.sampleRateOut) {
+                            pResampler->inTimeFrac -= pResampler->config.sampleRateOut;
+                            pResampler->inTimeInt  += 1;
+                        }
+                    }
+                }
+
+                if (batchCount == 0) {
+                    break;
+                }
+
+                ma_linear_resampler_interpolate_frames_f32(pFramesIn, channels, indices, alphas, batchCount, pFramesOut + (framesProcessedOut * channels));
+                framesProcessedOut += batchCount;
+            }
+
+            /* The cached frames need to be kept in sync for the next call. */
+            MA_COPY_MEMORY(pResampler->x0.f32, pFramesIn + ((framesProcessedIn - 2) * channels), sizeof(float) * channels);
+            MA_COPY_MEMORY(pResampler->x1.f32, pFramesIn + ((framesProcessedIn - 1) * channels), sizeof(float) * channels);
+        } else {
+            /* Slow path. This is the same as the per-frame path, only for a single output frame. */
+            while (pResampler->inTimeInt > 0 && frameCountIn > framesProcessedIn) {
+                MA_COPY_MEMORY(pResampler->x0.f32, pResampler->x1.f32, sizeof(float) * channels);
+                MA_COPY_MEMORY(pResampler->x1.f32, pFramesIn + (framesProcessedIn * channels), sizeof(float) * channels);
+
+                framesProcessedIn     += 1;
+                pResampler->inTimeInt -= 1;
+            }
+
+            if (pResampler->inTimeInt > 0) {
+                break;  /* Ran out of input data. */
+            }
+
+            ma_linear_resampler_interpolate_frame_f32(pResampler, pFramesOut + (framesProcessedOut * channels));
+            framesProcessedOut += 1;
+
+            /* Advance time forward. */
+            pResampler->inTimeInt  += pResampler->inAdvanceInt;
+            pResampler->inTimeFrac += pResampler->inAdvanceFrac;
+            if (pResampler->inTimeFrac >= pResampler->config.sampleRateOut) {
+                pResampler->inTimeFrac -= pResampler->config.sampleRateOut;
+                pResampler->inTimeInt  += 1;
+            }
+        }
+    }
+
+    *pFrameCountIn  = framesProcessedIn;
+    *pFrameCountOut = framesProcessedOut;
+
+    return MA_SUCCESS;
+}
+
+static ma_result ma_linear_resampler_process_pcm_frames_f32(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+{
+    MA_ASSERT(pResampler != NULL);
+
+    /* See ma_linear_resampler_process_pcm_frames_s16() for when the batched path is used. */
+    if (pFramesIn != NULL && pFramesOut != NULL && (pResampler->config.sampleRateIn == pResampler->config.sampleRateOut || (pResampler->lpf.lpf1Count + pResampler->lpf.lpf2Count) == 0)) {
+        return ma_linear_resampler_process_pcm_frames_f32_batched(pResampler, (const float*)pFramesIn, pFrameCountIn, (float*)pFramesOut, pFrameCountOut);
+    }
+
+    if (pResampler->config.sampleRateIn > pResampler->config.sampleRateOut) {
+        return ma_linear_resampler_process_pcm_frames_f32_downsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+    } else {
+        return ma_linear_resampler_process_pcm_frames_f32_upsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+    }
+}
+
+
+MA_API ma_result ma_linear_resampler_process_pcm_frames(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+{
+    if (pResampler == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    /*  */ if (pResampler->config.format == ma_format_s16) {
+        return ma_linear_resampler_process_pcm_frames_s16(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+    } else if (pResampler->config.format == ma_format_f32) {
+        return ma_linear_resampler_process_pcm_frames_f32(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+    } else {
+        /* Should never get here. Getting here means the format is not supported and you didn't check the return value of ma_linear_resampler_init(). */
+        MA_ASSERT(MA_FALSE);
+        return MA_INVALID_ARGS;
+    }
+}
+
+
+MA_API ma_result ma_linear_resampler_set_rate(ma_linear_resampler* pResampler, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut)
+{
+    return ma_linear_resampler_set_rate_internal(pResampler, NULL, NULL, sampleRateIn, sampleRateOut, /* isResamplerAlreadyInitialized = */ MA_TRUE);
+}
+
+MA_API ma_result ma_linear_resampler_set_rate_ratio(ma_linear_resampler* pResampler, float ratioInOut)
+{
+    ma_uint32 n;
+    ma_uint32 d;
+
+    if (pResampler == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (ratioInOut <= 0) {
+        return MA_INVALID_ARGS;
+    }
+
+    d = 1000000;
+    n = (ma_uint32)(ratioInOut * d);
+
+    if (n == 0) {
+        return MA_INVALID_ARGS; /* Ratio too small. */
+    }
+
+    MA_ASSERT(n != 0);
+
+    return ma_linear_resampler_set_rate(pResampler, n, d);
+}
+
+MA_API ma_uint64 ma_linear_resampler_get_input_latency(const ma_linear_resampler* pResampler)
+{
+    if (pResampler == NULL) {
+        return 0;
+    }
+
+    return 1 + ma_lpf_get_latency(&pResampler->lpf);
+}
+
+MA_API ma_uint64 ma_linear_resampler_get_output_latency(const ma_linear_resampler* pResampler)
+{
+    if (pResampler == NULL) {
+        return 0;
+    }
+
+    return ma_linear_resampler_get_input_latency(pResampler) * pResampler->config.sampleRateOut / pResampler->config.sampleRateIn;
+}
+
+MA_API ma_result ma_linear_resampler_get_required_input_frame_count(const ma_linear_resampler* pResampler, ma_uint64 outputFrameCount, ma_uint64* pInputFrameCount)
+{
+    ma_uint64 inputFrameCount;
+
+    if (pInputFrameCount == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    *pInputFrameCount = 0;
+
+    if (pResampler == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (outputFrameCount == 0) {
+        return MA_SUCCESS;
+    }
+
+    /* Any whole input frames are consumed before the first output frame is generated. */
+    inputFrameCount = pResampler->inTimeInt;
+    outputFrameCount -= 1;
+
+    /* The rest of the output frames can be calculated in constant time. */
+    inputFrameCount += outputFrameCount * pResampler->inAdvanceInt;
+    inputFrameCount += (pResampler->inTimeFrac + (outputFrameCount * pResampler->inAdvanceFrac)) / pResampler->config.sampleRateOut;
+
+    *pInputFrameCount = inputFrameCount;
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_linear_resampler_get_expected_output_frame_count(const ma_linear_resampler* pResampler, ma_uint64 inputFrameCount, ma_uint64* pOutputFrameCount)
+{
+    ma_uint64 outputFrameCount;
+    ma_uint64 preliminaryInputFrameCountFromFrac;
+    ma_uint64 preliminaryInputFrameCount;
+
+    if (pOutputFrameCount == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    *pOutputFrameCount = 0;
+
+    if (pResampler == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    /*
+    The first step is to get a preliminary output frame count. This will either be exactly equal to what we need, or less by 1. We need to
+    determine how many input frames will be consumed by this value. If it's greater than our original input frame count it means we won't
+    be able to generate an extra frame because we will have run out of input data. Otherwise we will have enough input for the generation
+    of an extra output frame. This add-by-one logic is necessary due to how the data loading logic works when processing frames.
+    */
+    outputFrameCount = (inputFrameCount * pResampler->config.sampleRateOut) / pResampler->config.sampleRateIn;
+
+    /*
+    We need to determine how many *whole* input frames will have been processed to generate our preliminary output frame count. This is
+    used in the logic below to determine whether or not we need to add an extra output frame.
+    */
+    preliminaryInputFrameCountFromFrac = (pResampler->inTimeFrac + outputFrameCount*pResampler->inAdvanceFrac) / pResampler->config.sampleRateOut;
+    preliminaryInputFrameCount         = (pResampler->inTimeInt  + outputFrameCount*pResampler->inAdvanceInt ) + preliminaryInputFrameCountFromFrac;
+
+    /*
+    If the total number of *whole* input frames that would be required to generate our preliminary output frame count is greather than
+    the amount of whole input frames we have available as input we need to *not* add an extra output frame as there won't be enough data
+    to actually process. Otherwise we need to add the extra output frame.
+    */
+    if (preliminaryInputFrameCount <= inputFrameCount) {
+        outputFrameCount += 1;
+    }
+
+    *pOutputFrameCount = outputFrameCount;
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_linear_resampler_reset(ma_linear_resampler* pResampler)
+{
+    ma_uint32 iChannel;
+
+    if (pResampler == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    /* Timers need to be cleared back to zero. */
+    pResampler->inTimeInt  = 1;  /* Set this to one to force an input sample to always be loaded for the first output frame. */
+    pResampler->inTimeFrac = 0;
+
+    /* Cached samples need to be cleared. */
+    if (pResampler->config.format == ma_format_f32) {
+        for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
+            pResampler->x0.f32[iChannel] = 0;
+            pResampler->x1.f32[iChannel] = 0;
+        }
+    } else {
+        for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
+            pResampler->x0.s16[iChannel] = 0;
+            pResampler->x1.s16[iChannel] = 0;
+        }
+    }
+
+    /* The low pass filter needs to have it's cache reset. */
+    ma_lpf_clear_cache(&pResampler->lpf);
+
+    return MA_SUCCESS;
+}
+
+#if !defined(MA_NO_ENGINE) && !defined(MA_NO_NODE_GRAPH)  /* Only used by the engine. */
+/*
+Switches an f32 resampler between mono and the channel count it was initialized with. This is used by the engine to
+resample distant sounds in mono. It's only valid when low-pass filtering is disabled. When switching to mono the cached
+frames are mixed down, and when switching back they're duplicated. Since interpolation is linear, the mono output is
+exactly the mix down of what the multi-channel output would have been.
+*/
+static void ma_linear_resampler_set_channels_f32(ma_linear_resampler* pResampler, ma_uint32 channels)
+{
+    ma_uint32 iChannel;
+
+    MA_ASSERT(pResampler != NULL);
+    MA_ASSERT(pResampler->config.format == ma_format_f32);
+    MA_ASSERT((pResampler->lpf.lpf1Count + pResampler->lpf.lpf2Count) == 0);
+
+    if (channels == pResampler->config.channels) {
+        return;
+    }
+
+    if (channels == 1) {
+        float x0 = 0;
+        float x1 = 0;
+
+        for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
+            x0 += pResampler->x0.f32[iChannel];
+            x1 += pResampler->x1.f32[iChannel];
+        }
+
+        pResampler->x0.f32[0] = x0 / pResampler->config.channels;
+        pResampler->x1.f32[0] = x1 / pResampler->config.channels;
+    } else {
+        MA_ASSERT(pResampler->config.channels == 1);
+
+        for (iChannel = 1; iChannel < channels; iChannel += 1) {
+            pResampler->x0.f32[iChannel] = pResampler->x0.f32[0];
+            pResampler->x1.f32[iChannel] = pResampler->x1.f32[0];
+        }
+    }
+
+    pResampler->config.channels = channels;
+}
+#endif
+
+MA_API ma_bool32 ma_linear_resampler_is_fixed_ratio(const ma_linear_resampler* pResampler)
+{
+    if (pResampler == NULL) {
+        return MA_FALSE;
+    }
+
+    return pResampler->isFixedRatio;
+}
+
+
+
+/* Polyphase resampler. */
+MA_API ma_polyphase_resampler_config ma_polyphase_resampler_config_init(ma_format format, ma_uint32 channels, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut)
+{
+    ma_polyphase_resampler_config config;
+    MA_ZERO_OBJECT(&config);
+    config.format        = format;
+    config.channels      = channels;
+    config.sampleRateIn  = sampleRateIn;
+    config.sampleRateOut = sampleRateOut;
+    config.quality       = MA_DEFAULT_POLYPHASE_RESAMPLER_QUALITY;
+
+    return config;
+}
+
+
+typedef struct
+{
+    ma_uint32 tapCount;     /* Must be a multiple of 16 so the SIMD paths never need to handle a tail. */
+    double kaiserBeta;      /* Controls the trade off between stop band attenuation and transition width. */
+    double rolloff;         /* The cutoff as a fraction of the Nyquist frequency of the lower of the two rates. */
+} ma_polyphase_resampler_preset;
+
+static ma_polyphase_resampler_preset g_ma_polyphase_resampler_presets[] =
+{
+    { 16,  5.0, 0.85},  /* ma_polyphase_resampler_quality_low    */
+    { 32,  7.0, 0.90},  /* ma_polyphase_resampler_quality_medium */
+    { 64,  9.0, 0.94},  /* ma_polyphase_resampler_quality_high   */
+    {128, 11.0, 0.96}   /* ma_polyphase_resampler_quality_best   */
+};
+
+typedef struct
+{
+    size_t sizeInBytes;
+    size_t coefficientsOffset;
+    size_t coefficientsInterpolatedOffset;
+    size_t historyOffset;
+} ma_polyphase_resampler_heap_layout;
+
+
+/* Zeroth order modified Bessel function of the first kind. Only used for building the Kaiser window. */
+static double ma_bessel_i0(double x)
+{
+    double sum   = 1;
+    double term  = 1;
+    double halfX = x * 0.5;
+    ma_uint32 k;
+
+    for (k = 1; k < 64; k += 1) {
+        term *= (halfX / k) * (halfX / k);
+        sum  += term;
+
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+
+    return sum;
+}
+
+static void ma_polyphase_resampler_calculate_coefficients(ma_polyphase_resampler* pResampler)
+{
+    const ma_polyphase_resampler_preset* pPreset;
+    ma_uint32 tapCount;
+    ma_uint32 iPhase;
+    ma_uint32 iTap;
+    double halfLength;
+    double cutoff;
+    double betaI0;
+
+    MA_ASSERT(pResampler != NULL);
+
+    pPreset    = &g_ma_polyphase_resampler_presets[pResampler->config.quality];
+    tapCount   = pResampler->tapCount;
+    halfLength = tapCount * 0.5;
+    betaI0     = ma_bessel_i0(pPreset->kaiserBeta);
+
+    /* When downsampling the cutoff needs to be moved down to the Nyquist frequency of the output rate. */
+    cutoff = pPreset->rolloff;
+    if (pResampler->config.sampleRateIn > pResampler->config.sampleRateOut) {
+        cutoff = cutoff * pResampler->config.sampleRateOut / pResampler->config.sampleRateIn;
+    }
+
+    /*
+    There is one more row than there are phases. The last row is for a fractional position of exactly
+    1 and is only used as the upper bound when interpolating between phases.
+    */
+    for (iPhase = 0; iPhase <= pResampler->phaseCount; iPhase += 1) {
+        float* pRow = pResampler->pCoefficients + (iPhase * tapCount);
+        double frac = (double)iPhase / pResampler->phaseCount;
+        double sum  = 0;
+
+        for (iTap = 0; iTap < tapCount; iTap += 1) {
+            double x = (double)iTap - (halfLength - 1) - frac;   /* Distance from the output position in input frames. */
+            double r = x / halfLength;
+            double window;
+            double sinc;
+
+            if (r <= -1 || r >= 1) {
+                window = 0;
+            } else {
+                window = ma_bessel_i0(pPreset->kaiserBeta * ma_sqrtd(1 - r*r)) / betaI0;
+            }
+
+            if (x == 0) {
+                sinc = 1;
+            } else {
+                double a = MA_PI_D * cutoff * x;
+                sinc = ma_sind(a) / a;
+            }
+
+            pRow[iTap] = (float)(cutoff * sinc * window);
+            sum += pRow[iTap];
+        }
+
+        /* Normalize each phase for unity gain at DC or else we'll get a ripple at the output rate. */
+        for (iTap = 0; iTap < tapCount; iTap += 1) {
+            pRow[iTap] = (float)(pRow[iTap] / sum);
+        }
+    }
+}
+
+static void ma_polyphase_resampler_adjust_timer_for_new_rate(ma_polyphase_resampler* pResampler, ma_uint32 oldSampleRateOut, ma_uint32 newSampleRateOut)
+{
+    /* This is the same as the linear resampler. The fractional part of the timer is in terms of the output rate. */
+    ma_uint32 oldRateTimeWhole = pResampler->inTimeFrac / oldSampleRateOut;
+    ma_uint32 oldRateTimeFract = pResampler->inTimeFrac % oldSampleRateOut;
+
+    pResampler->inTimeFrac =
+         (oldRateTimeWhole * newSampleRateOut) +
+        ((oldRateTimeFract * newSampleRateOut) / oldSampleRateOut);
+
+    pResampler->inTimeInt += pResampler->inTimeFrac / pResampler->config.sampleRateOut;
+    pResampler->inTimeFrac = pResampler->inTimeFrac % pResampler->config.sampleRateOut;
+}
+
+static ma_result ma_polyphase_resampler_set_rate_internal(ma_polyphase_resampler* pResampler, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut, ma_bool32 isResamplerAlreadyInitialized)
+{
+    ma_uint32 gcf;
+    ma_uint32 oldSampleRateOut;
+
+    if (pResampler == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (sampleRateIn == 0 || sampleRateOut == 0) {
+        return MA_INVALID_ARGS;
+    }
+
+    /* Simplify the sample rate. */
+    gcf = ma_gcf_u32(sampleRateIn, sampleRateOut);
+    sampleRateIn  /= gcf;
+    sampleRateOut /= gcf;
+
+    /* Building the table is expensive so don't do it if nothing has actually changed. */
+    if (isResamplerAlreadyInitialized && pResampler->config.sampleRateIn == sampleRateIn && pResampler->config.sampleRateOut == sampleRateOut) {
+        return MA_SUCCESS;
+    }
+
+    oldSampleRateOut = pResampler->config.sampleRateOut;
+
+    pResampler->config.sampleRateIn  = sampleRateIn;
+    pResampler->config.sampleRateOut = sampleRateOut;
+
+    /*
+    The output rate defines the number of distinct fractional positions we can land on. If that fits in the
+    table we can use an exact phase for every output frame. Otherwise we fall back to interpolating between
+    the two nearest phases.
+    */
+    pResampler->phaseCount = ma_min(pResampler->config.sampleRateOut, MA_POLYPHASE_RESAMPLER_MAX_PHASE_COUNT);
+    ma_polyphase_resampler_calculate_coefficients(pResampler);
+
+    pResampler->inAdvanceInt  = pResampler->config.sampleRateIn / pResampler->config.sampleRateOut;
+    pResampler->inAdvanceFrac = pResampler->config.sampleRateIn % pResampler->config.sampleRateOut;
+
+    if (isResamplerAlreadyInitialized) {
+        ma_polyphase_resampler_adjust_timer_for_new_rate(pResampler, oldSampleRateOut, pResampler->config.sampleRateOut);
+    }
+
+    return MA_SUCCESS;
+}
+
+static ma_result ma_polyphase_resampler_get_heap_layout(const ma_polyphase_resampler_config* pConfig, ma_polyphase_resampler_heap_layout* pHeapLayout)
+{
+    ma_uint32 tapCount;
+
+    MA_ASSERT(pHeapLayout != NULL);
+
+    MA_ZERO_OBJECT(pHeapLayout);
+
+    if (pConfig == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (pConfig->format != ma_format_f32 && pConfig->format != ma_format_s16) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (pConfig->channels == 0) {
+        return MA_INVALID_ARGS;
+    }
+
+    if ((size_t)pConfig->quality >= ma_countof(g_ma_polyphase_resampler_presets)) {
+        return MA_INVALID_ARGS;
+    }
+
+    tapCount = g_ma_polyphase_resampler_presets[pConfig->quality].tapCount;
+
+    pHeapLayout->sizeInBytes = 0;
+
+    /* Coefficients. This is sized for the maximum phase count so the rate can be changed without reallocating. */
+    pHeapLayout->coefficientsOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(sizeof(float) * tapCount * (MA_POLYPHASE_RESAMPLER_MAX_PHASE_COUNT + 1));
+
+    /* Interpolated coefficients. */
+    pHeapLayout->coefficientsInterpolatedOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(sizeof(float) * tapCount);
+
+    /* History. */
+    pHeapLayout->historyOffset = pHeapLayout->sizeInBytes;
+    pHeapLayout->sizeInBytes += ma_align_64(sizeof(float) * tapCount * 2 * pConfig->channels);
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_polyphase_resampler_get_heap_size(const ma_polyphase_resampler_config* pConfig, size_t* pHeapSizeInBytes)
+{
+    ma_result result;
+    ma_polyphase_resampler_heap_layout heapLayout;
+
+    if (pHeapSizeInBytes == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    *pHeapSizeInBytes = 0;
+
+    result = ma_polyphase_resampler_get_heap_layout(pConfig, &heapLayout);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    *pHeapSizeInBytes = heapLayout.sizeInBytes;
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_polyphase_resampler_init_preallocated(const ma_polyphase_resampler_config* pConfig, void* pHeap, ma_polyphase_resampler* pResampler)
+{
+    ma_result result;
+    ma_polyphase_resampler_heap_layout heapLayout;
+
+    if (pResampler == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    MA_ZERO_OBJECT(pResampler);
+
+    result = ma_polyphase_resampler_get_heap_layout(pConfig, &heapLayout);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    pResampler->config   = *pConfig;
+    pResampler->tapCount = g_ma_polyphase_resampler_presets[pConfig->quality].tapCount;
 
-            framesProcessedIn     += 1;
-            pResampler->inTimeInt -= 1;
-        }
+    pResampler->_pHeap = pHeap;
+    MA_ZERO_MEMORY(pHeap, heapLayout.sizeInBytes);
 
-        if (pResampler->inTimeInt > 0) {
-            break;  /* Ran out of input data. */
-        }
+    pResampler->pCoefficients             = (float*)ma_offset_ptr(pHeap, heapLayout.coefficientsOffset);
+    pResampler->pCoefficientsInterpolated = (float*)ma_offset_ptr(pHeap, heapLayout.coefficientsInterpolatedOffset);
+    pResampler->pHistory                  = (float*)ma_offset_ptr(pHeap, heapLayout.historyOffset);
 
-        /* Getting here means the frames have been loaded and filtered and we can generate the next output frame. */
-        if (pFramesOutS16 != NULL) {
-            MA_ASSERT(pResampler->inTimeInt == 0);
-            ma_linear_resampler_interpolate_frame_s16(pResampler, pFramesOutS16);
+    /* Setting the rate will build the coefficient table and set up the time advances. */
+    result = ma_polyphase_resampler_set_rate_internal(pResampler, pConfig->sampleRateIn, pConfig->sampleRateOut, /* isResamplerAlreadyInitialized = */ MA_FALSE);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
 
-            pFramesOutS16 += pResampler->config.channels;
-        }
+    pResampler->inTimeInt  = 1;  /* Set this to one to force an input sample to always be loaded for the first output frame. */
+    pResampler->inTimeFrac = 0;
 
-        framesProcessedOut += 1;
+    return MA_SUCCESS;
+}
 
-        /* Advance time forward. */
-        pResampler->inTimeInt  += pResampler->inAdvanceInt;
-        pResampler->inTimeFrac += pResampler->inAdvanceFrac;
-        if (pResampler->inTimeFrac >= pResampler->config.sampleRateOut) {
-            pResampler->inTimeFrac -= pResampler->config.sampleRateOut;
-            pResampler->inTimeInt  += 1;
+MA_API ma_result ma_polyphase_resampler_init(const ma_polyphase_resampler_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_polyphase_resampler* pResampler)
+{
+    ma_result result;
+    size_t heapSizeInBytes;
+    void* pHeap;
+
+    result = ma_polyphase_resampler_get_heap_size(pConfig, &heapSizeInBytes);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    if (heapSizeInBytes > 0) {
+        pHeap = ma_malloc(heapSizeInBytes, pAllocationCallbacks);
+        if (pHeap == NULL) {
+            return MA_OUT_OF_MEMORY;
         }
+    } else {
+        pHeap = NULL;
     }
 
-    *pFrameCountIn  = framesProcessedIn;
-    *pFrameCountOut = framesProcessedOut;
+    result = ma_polyphase_resampler_init_preallocated(pConfig, pHeap, pResampler);
+    if (result != MA_SUCCESS) {
+        ma_free(pHeap, pAllocationCallbacks);
+        return result;
+    }
 
+    pResampler->_ownsHeap = MA_TRUE;
     return MA_SUCCESS;
 }
 
-static ma_result ma_linear_resampler_process_pcm_frames_s16_upsample(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+MA_API void ma_polyphase_resampler_uninit(ma_polyphase_resampler* pResampler, const ma_allocation_callbacks* pAllocationCallbacks)
 {
-    const ma_int16* pFramesInS16;
-    /* */ ma_int16* pFramesOutS16;
-    ma_uint64 frameCountIn;
-    ma_uint64 frameCountOut;
-    ma_uint64 framesProcessedIn;
-    ma_uint64 framesProcessedOut;
+    if (pResampler == NULL) {
+        return;
+    }
 
-    MA_ASSERT(pResampler     != NULL);
-    MA_ASSERT(pFrameCountIn  != NULL);
-    MA_ASSERT(pFrameCountOut != NULL);
+    if (pResampler->_ownsHeap) {
+        ma_free(pResampler->_pHeap, pAllocationCallbacks);
+    }
+}
 
-    pFramesInS16       = (const ma_int16*)pFramesIn;
-    pFramesOutS16      = (      ma_int16*)pFramesOut;
-    frameCountIn       = *pFrameCountIn;
-    frameCountOut      = *pFrameCountOut;
-    framesProcessedIn  = 0;
-    framesProcessedOut = 0;
 
-    while (framesProcessedOut < frameCountOut) {
-        /* Before interpolating we need to load the buffers. */
-        while (pResampler->inTimeInt > 0 && frameCountIn > framesProcessedIn) {
-            ma_uint32 iChannel;
+/*
+Filters one output frame. pWindows points to the oldest frame in the history of the first channel. The window
+for each subsequent channel is windowStride samples further along. Each window is tapCount samples long and is
+contiguous which is why the history stores every sample twice.
+*/
+typedef void (* ma_polyphase_resampler_filter_proc)(const float* pCoefficients, const float* pWindows, ma_uint32 windowStride, ma_uint32 tapCount, ma_uint32 channels, float* pFrameOut);
 
-            if (pFramesInS16 != NULL) {
-                for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
-                    pResampler->x0.s16[iChannel] = pResampler->x1.s16[iChannel];
-                    pResampler->x1.s16[iChannel] = pFramesInS16[iChannel];
-                }
-                pFramesInS16 += pResampler->config.channels;
-            } else {
-                for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
-                    pResampler->x0.s16[iChannel] = pResampler->x1.s16[iChannel];
-                    pResampler->x1.s16[iChannel] = 0;
-                }
-            }
+static void ma_polyphase_resampler_filter_frame__scalar(const float* pCoefficients, const float* pWindows, ma_uint32 windowStride, ma_uint32 tapCount, ma_uint32 channels, float* pFrameOut)
+{
+    ma_uint32 iChannel;
+    ma_uint32 iTap;
 
-            framesProcessedIn     += 1;
-            pResampler->inTimeInt -= 1;
-        }
+    for (iChannel = 0; iChannel < channels; iChannel += 1) {
+        const float* pWindow = pWindows + (iChannel * windowStride);
+        float acc0 = 0;
+        float acc1 = 0;
 
-        if (pResampler->inTimeInt > 0) {
-            break;  /* Ran out of input data. */
+        /* Two accumulators to break the dependency chain. The tap count is always a multiple of 16. */
+        for (iTap = 0; iTap < tapCount; iTap += 2) {
+            acc0 += pCoefficients[iTap + 0] * pWindow[iTap + 0];
+            acc1 += pCoefficients[iTap + 1] * pWindow[iTap + 1];
         }
 
-        /* Getting here means the frames have been loaded and we can generate the next output frame. */
-        if (pFramesOutS16 != NULL) {
-            MA_ASSERT(pResampler->inTimeInt == 0);
-            ma_linear_resampler_interpolate_frame_s16(pResampler, pFramesOutS16);
+        pFrameOut[iChannel] = acc0 + acc1;
+    }
+}
 
-            /* Filter. Do not apply filtering if sample rates are the same or else you'll get dangerous glitching. */
-            if (pResampler->config.sampleRateIn != pResampler->config.sampleRateOut) {
-                ma_lpf_process_pcm_frame_s16(&pResampler->lpf, pFramesOutS16, pFramesOutS16);
-            }
+#if defined(MA_SUPPORT_SSE2)
+static MA_INLINE float ma_polyphase_resampler_sum__sse2(__m128 x)
+{
+    x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+    x = _mm_add_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(x);
+}
 
-            pFramesOutS16 += pResampler->config.channels;
-        }
+static void ma_polyphase_resampler_filter_frame__sse2(const float* pCoefficients, const float* pWindows, ma_uint32 windowStride, ma_uint32 tapCount, ma_uint32 channels, float* pFrameOut)
+{
+    ma_uint32 iChannel;
+    ma_uint32 iTap;
 
-        framesProcessedOut += 1;
+    for (iChannel = 0; iChannel < channels; iChannel += 1) {
+        const float* pWindow = pWindows + (iChannel * windowStride);
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
 
-        /* Advance time forward. */
-        pResampler->inTimeInt  += pResampler->inAdvanceInt;
-        pResampler->inTimeFrac += pResampler->inAdvanceFrac;
-        if (pResampler->inTimeFrac >= pResampler->config.sampleRateOut) {
-            pResampler->inTimeFrac -= pResampler->config.sampleRateOut;
-            pResampler->inTimeInt  += 1;
+        for (iTap = 0; iTap < tapCount; iTap += 8) {
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(pCoefficients + iTap + 0), _mm_loadu_ps(pWindow + iTap + 0)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(pCoefficients + iTap + 4), _mm_loadu_ps(pWindow + iTap + 4)));
         }
+
+        pFrameOut[iChannel] = ma_polyphase_resampler_sum__sse2(_mm_add_ps(acc0, acc1));
     }
+}
+#endif
 
-    *pFrameCountIn  = framesProcessedIn;
-    *pFrameCountOut = framesProcessedOut;
+#if defined(MA_SUPPORT_AVX2)
+static void ma_polyphase_resampler_filter_frame__avx2(const float* pCoefficients, const float* pWindows, ma_uint32 windowStride, ma_uint32 tapCount, ma_uint32 channels, float* pFrameOut)
+{
+    ma_uint32 iChannel;
+    ma_uint32 iTap;
 
-    return MA_SUCCESS;
+    for (iChannel = 0; iChannel < channels; iChannel += 1) {
+        const float* pWindow = pWindows + (iChannel * windowStride);
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        __m128 sum;
+
+        for (iTap = 0; iTap < tapCount; iTap += 16) {
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(pCoefficients + iTap + 0), _mm256_loadu_ps(pWindow + iTap + 0)));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(pCoefficients + iTap + 8), _mm256_loadu_ps(pWindow + iTap + 8)));
+        }
+
+        acc0 = _mm256_add_ps(acc0, acc1);
+        sum  = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+        sum  = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum  = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+
+        pFrameOut[iChannel] = _mm_cvtss_f32(sum);
+    }
 }
+#endif
 
-static ma_result ma_linear_resampler_process_pcm_frames_s16(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+#if defined(MA_SUPPORT_NEON)
+static void ma_polyphase_resampler_filter_frame__neon(const float* pCoefficients, const float* pWindows, ma_uint32 windowStride, ma_uint32 tapCount, ma_uint32 channels, float* pFrameOut)
 {
-    MA_ASSERT(pResampler != NULL);
+    ma_uint32 iChannel;
+    ma_uint32 iTap;
 
-    if (pResampler->config.sampleRateIn > pResampler->config.sampleRateOut) {
-        return ma_linear_resampler_process_pcm_frames_s16_downsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
-    } else {
-        return ma_linear_resampler_process_pcm_frames_s16_upsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+    for (iChannel = 0; iChannel < channels; iChannel += 1) {
+        const float* pWindow = pWindows + (iChannel * windowStride);
+        float32x4_t acc0 = vdupq_n_f32(0);
+        float32x4_t acc1 = vdupq_n_f32(0);
+        float32x2_t sum;
+
+        for (iTap = 0; iTap < tapCount; iTap += 8) {
+            acc0 = vmlaq_f32(acc0, vld1q_f32(pCoefficients + iTap + 0), vld1q_f32(pWindow + iTap + 0));
+            acc1 = vmlaq_f32(acc1, vld1q_f32(pCoefficients + iTap + 4), vld1q_f32(pWindow + iTap + 4));
+        }
+
+        acc0 = vaddq_f32(acc0, acc1);
+        sum  = vadd_f32(vget_low_f32(acc0), vget_high_f32(acc0));
+        sum  = vpadd_f32(sum, sum);
+
+        pFrameOut[iChannel] = vget_lane_f32(sum, 0);
     }
 }
+#endif
 
-
-static ma_result ma_linear_resampler_process_pcm_frames_f32_downsample(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+static ma_polyphase_resampler_filter_proc ma_polyphase_resampler_get_filter_proc(void)
 {
-    const float* pFramesInF32;
-    /* */ float* pFramesOutF32;
-    ma_uint64 frameCountIn;
-    ma_uint64 frameCountOut;
-    ma_uint64 framesProcessedIn;
-    ma_uint64 framesProcessedOut;
+#if defined(MA_SUPPORT_AVX2)
+    if (ma_has_avx2()) {
+        return ma_polyphase_resampler_filter_frame__avx2;
+    }
+#endif
+#if defined(MA_SUPPORT_SSE2)
+    if (ma_has_sse2()) {
+        return ma_polyphase_resampler_filter_frame__sse2;
+    }
+#endif
+#if defined(MA_SUPPORT_NEON)
+    if (ma_has_neon()) {
+        return ma_polyphase_resampler_filter_frame__neon;
+    }
+#endif
 
-    MA_ASSERT(pResampler     != NULL);
-    MA_ASSERT(pFrameCountIn  != NULL);
-    MA_ASSERT(pFrameCountOut != NULL);
+    return ma_polyphase_resampler_filter_frame__scalar;
+}
 
-    pFramesInF32       = (const float*)pFramesIn;
-    pFramesOutF32      = (      float*)pFramesOut;
-    frameCountIn       = *pFrameCountIn;
-    frameCountOut      = *pFrameCountOut;
-    framesProcessedIn  = 0;
-    framesProcessedOut = 0;
+static const float* ma_polyphase_resampler_get_phase_coefficients(ma_polyphase_resampler* pResampler)
+{
+    ma_uint32 tapCount = pResampler->tapCount;
+    ma_uint64 position;
+    ma_uint32 iPhase;
+    ma_uint32 iTap;
+    const float* pRow0;
+    const float* pRow1;
+    float t;
 
-    while (framesProcessedOut < frameCountOut) {
-        /* Before interpolating we need to load the buffers. When doing this we need to ensure we run every input sample through the filter. */
-        while (pResampler->inTimeInt > 0 && frameCountIn > framesProcessedIn) {
-            ma_uint32 iChannel;
+    /* When every fractional position has its own phase we can use the row directly. */
+    if (pResampler->phaseCount == pResampler->config.sampleRateOut) {
+        return pResampler->pCoefficients + (pResampler->inTimeFrac * tapCount);
+    }
 
-            if (pFramesInF32 != NULL) {
-                for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
-                    pResampler->x0.f32[iChannel] = pResampler->x1.f32[iChannel];
-                    pResampler->x1.f32[iChannel] = pFramesInF32[iChannel];
-                }
-                pFramesInF32 += pResampler->config.channels;
-            } else {
-                for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
-                    pResampler->x0.f32[iChannel] = pResampler->x1.f32[iChannel];
-                    pResampler->x1.f32[iChannel] = 0;
-                }
-            }
+    position = (ma_uint64)pResampler->inTimeFrac * pResampler->phaseCount;
+    iPhase   = (ma_uint32)(position / pResampler->config.sampleRateOut);
+    t        = (float)(position % pResampler->config.sampleRateOut) / pResampler->config.sampleRateOut;
+    pRow0    = pResampler->pCoefficients + (iPhase * tapCount);
+    pRow1    = pRow0 + tapCount;
 
-            /* Filter. Do not apply filtering if sample rates are the same or else you'll get dangerous glitching. */
-            if (pResampler->config.sampleRateIn != pResampler->config.sampleRateOut) {
-                ma_lpf_process_pcm_frame_f32(&pResampler->lpf, pResampler->x1.f32, pResampler->x1.f32);
-            }
+    for (iTap = 0; iTap < tapCount; iTap += 1) {
+        pResampler->pCoefficientsInterpolated[iTap] = pRow0[iTap] + (pRow1[iTap] - pRow0[iTap]) * t;
+    }
 
-            framesProcessedIn     += 1;
-            pResampler->inTimeInt -= 1;
-        }
+    return pResampler->pCoefficientsInterpolated;
+}
 
-        if (pResampler->inTimeInt > 0) {
-            break;  /* Ran out of input data. */
-        }
+static void ma_polyphase_resampler_push_frame(ma_polyphase_resampler* pResampler, const void* pFrameIn)
+{
+    ma_uint32 tapCount = pResampler->tapCount;
+    ma_uint32 cursor   = pResampler->historyCursor;
+    ma_uint32 iChannel;
 
-        /* Getting here means the frames have been loaded and filtered and we can generate the next output frame. */
-        if (pFramesOutF32 != NULL) {
-            MA_ASSERT(pResampler->inTimeInt == 0);
-            ma_linear_resampler_interpolate_frame_f32(pResampler, pFramesOutF32);
+    for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
+        float* pHistory = pResampler->pHistory + (iChannel * tapCount * 2);
+        float x;
 
-            pFramesOutF32 += pResampler->config.channels;
+        if (pFrameIn == NULL) {
+            x = 0;
+        } else if (pResampler->config.format == ma_format_f32) {
+            x = ((const float*)pFrameIn)[iChannel];
+        } else {
+            x = ((const ma_int16*)pFrameIn)[iChannel] * (1.0f / 32768);
         }
 
-        framesProcessedOut += 1;
-
-        /* Advance time forward. */
-        pResampler->inTimeInt  += pResampler->inAdvanceInt;
-        pResampler->inTimeFrac += pResampler->inAdvanceFrac;
-        if (pResampler->inTimeFrac >= pResampler->config.sampleRateOut) {
-            pResampler->inTimeFrac -= pResampler->config.sampleRateOut;
-            pResampler->inTimeInt  += 1;
-        }
+        /* The newest frame replaces the oldest one. */
+        pHistory[cursor           ] = x;
+        pHistory[cursor + tapCount] = x;
     }
 
-    *pFrameCountIn  = framesProcessedIn;
-    *pFrameCountOut = framesProcessedOut;
+    cursor += 1;
+    if (cursor == tapCount) {
+        cursor = 0;
+    }
 
-    return MA_SUCCESS;
+    pResampler->historyCursor = cursor;
 }
 
-static ma_result ma_linear_resampler_process_pcm_frames_f32_upsample(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+MA_API ma_result ma_polyphase_resampler_process_pcm_frames(ma_polyphase_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
 {
-    const float* pFramesInF32;
-    /* */ float* pFramesOutF32;
+    ma_polyphase_resampler_filter_proc onFilter;
+    const ma_uint8* pRunningFramesIn;
+    /* */ ma_uint8* pRunningFramesOut;
     ma_uint64 frameCountIn;
     ma_uint64 frameCountOut;
     ma_uint64 framesProcessedIn;
     ma_uint64 framesProcessedOut;
+    ma_uint32 bpf;
+    ma_uint32 channels;
+    ma_uint32 windowStride;
 
-    MA_ASSERT(pResampler     != NULL);
-    MA_ASSERT(pFrameCountIn  != NULL);
-    MA_ASSERT(pFrameCountOut != NULL);
+    if (pResampler == NULL || pFrameCountIn == NULL || pFrameCountOut == NULL) {
+        return MA_INVALID_ARGS;
+    }
 
-    pFramesInF32       = (const float*)pFramesIn;
-    pFramesOutF32      = (      float*)pFramesOut;
+    onFilter           = ma_polyphase_resampler_get_filter_proc();   /* Resolve this once so we're not querying the CPU for every frame. */
+    pRunningFramesIn   = (const ma_uint8*)pFramesIn;
+    pRunningFramesOut  = (      ma_uint8*)pFramesOut;
     frameCountIn       = *pFrameCountIn;
     frameCountOut      = *pFrameCountOut;
     framesProcessedIn  = 0;
     framesProcessedOut = 0;
+    channels           = pResampler->config.channels;
+    bpf                = ma_get_bytes_per_frame(pResampler->config.format, channels);
+    windowStride       = pResampler->tapCount * 2;
 
     while (framesProcessedOut < frameCountOut) {
-        /* Before interpolating we need to load the buffers. */
+        /* The same timing rules as the linear resampler apply so frame count calculations are identical. */
         while (pResampler->inTimeInt > 0 && frameCountIn > framesProcessedIn) {
-            ma_uint32 iChannel;
+            ma_polyphase_resampler_push_frame(pResampler, pRunningFramesIn);
 
-            if (pFramesInF32 != NULL) {
-                for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
-                    pResampler->x0.f32[iChannel] = pResampler->x1.f32[iChannel];
-                    pResampler->x1.f32[iChannel] = pFramesInF32[iChannel];
-                }
-                pFramesInF32 += pResampler->config.channels;
-            } else {
-                for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
-                    pResampler->x0.f32[iChannel] = pResampler->x1.f32[iChannel];
-                    pResampler->x1.f32[iChannel] = 0;
-                }
+            if (pRunningFramesIn != NULL) {
+                pRunningFramesIn += bpf;
             }
 
             framesProcessedIn     += 1;
@@ -51635,17 +56566,22 @@ static ma_result ma_linear_resampler_process_pcm_frames_f32_upsample(ma_linear_r
             break;  /* Ran out of input data. */
         }
 
-        /* Getting here means the frames have been loaded and we can generate the next output frame. */
-        if (pFramesOutF32 != NULL) {
-            MA_ASSERT(pResampler->inTimeInt == 0);
-            ma_linear_resampler_interpolate_frame_f32(pResampler, pFramesOutF32);
+        if (pRunningFramesOut != NULL) {
+            const float* pCoefficients = ma_polyphase_resampler_get_phase_coefficients(pResampler);
+            const float* pWindows      = pResampler->pHistory + pResampler->historyCursor;
 
-            /* Filter. Do not apply filtering if sample rates are the same or else you'll get dangerous glitching. */
-            if (pResampler->config.sampleRateIn != pResampler->config.sampleRateOut) {
-                ma_lpf_process_pcm_frame_f32(&pResampler->lpf, pFramesOutF32, pFramesOutF32);
+            if (pResampler->config.format == ma_format_f32) {
+                onFilter(pCoefficients, pWindows, windowStride, pResampler->tapCount, channels, (float*)pRunningFramesOut);
+            } else {
+                ma_uint32 iChannel;
+                for (iChannel = 0; iChannel < channels; iChannel += 1) {
+                    float x;
+                    onFilter(pCoefficients, pWindows + (iChannel * windowStride), windowStride, pResampler->tapCount, 1, &x);
+                    ((ma_int16*)pRunningFramesOut)[iChannel] = ma_pcm_sample_f32_to_s16(ma_clip_f32(x));
+                }
             }
 
-            pFramesOutF32 += pResampler->config.channels;
+            pRunningFramesOut += bpf;
         }
 
         framesProcessedOut += 1;
@@ -51665,42 +56601,12 @@ static ma_result ma_linear_resampler_process_pcm_frames_f32_upsample(ma_linear_r
     return MA_SUCCESS;
 }
 
-static ma_result ma_linear_resampler_process_pcm_frames_f32(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
-{
-    MA_ASSERT(pResampler != NULL);
-
-    if (pResampler->config.sampleRateIn > pResampler->config.sampleRateOut) {
-        return ma_linear_resampler_process_pcm_frames_f32_downsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
-    } else {
-        return ma_linear_resampler_process_pcm_frames_f32_upsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
-    }
-}
-
-
-MA_API ma_result ma_linear_resampler_process_pcm_frames(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
-{
-    if (pResampler == NULL) {
-        return MA_INVALID_ARGS;
-    }
-
-    /*  */ if (pResampler->config.format == ma_format_s16) {
-        return ma_linear_resampler_process_pcm_frames_s16(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
-    } else if (pResampler->config.format == ma_format_f32) {
-        return ma_linear_resampler_process_pcm_frames_f32(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
-    } else {
-        /* Should never get here. Getting here means the format is not supported and you didn't check the return value of ma_linear_resampler_init(). */
-        MA_ASSERT(MA_FALSE);
-        return MA_INVALID_ARGS;
-    }
-}
-
-
-MA_API ma_result ma_linear_resampler_set_rate(ma_linear_resampler* pResampler, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut)
+MA_API ma_result ma_polyphase_resampler_set_rate(ma_polyphase_resampler* pResampler, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut)
 {
-    return ma_linear_resampler_set_rate_internal(pResampler, NULL, NULL, sampleRateIn, sampleRateOut, /* isResamplerAlreadyInitialized = */ MA_TRUE);
+    return ma_polyphase_resampler_set_rate_internal(pResampler, sampleRateIn, sampleRateOut, /* isResamplerAlreadyInitialized = */ MA_TRUE);
 }
 
-MA_API ma_result ma_linear_resampler_set_rate_ratio(ma_linear_resampler* pResampler, float ratioInOut)
+MA_API ma_result ma_polyphase_resampler_set_rate_ratio(ma_polyphase_resampler* pResampler, float ratioInOut)
 {
     ma_uint32 n;
     ma_uint32 d;
@@ -51720,30 +56626,29 @@ MA_API ma_result ma_linear_resampler_set_rate_ratio(ma_linear_resampler* pResamp
         return MA_INVALID_ARGS; /* Ratio too small. */
     }
 
-    MA_ASSERT(n != 0);
-
-    return ma_linear_resampler_set_rate(pResampler, n, d);
+    return ma_polyphase_resampler_set_rate(pResampler, n, d);
 }
 
-MA_API ma_uint64 ma_linear_resampler_get_input_latency(const ma_linear_resampler* pResampler)
+MA_API ma_uint64 ma_polyphase_resampler_get_input_latency(const ma_polyphase_resampler* pResampler)
 {
     if (pResampler == NULL) {
         return 0;
     }
 
-    return 1 + ma_lpf_get_latency(&pResampler->lpf);
+    /* The output position sits in the middle of the window. */
+    return pResampler->tapCount / 2;
 }
 
-MA_API ma_uint64 ma_linear_resampler_get_output_latency(const ma_linear_resampler* pResampler)
+MA_API ma_uint64 ma_polyphase_resampler_get_output_latency(const ma_polyphase_resampler* pResampler)
 {
     if (pResampler == NULL) {
         return 0;
     }
 
-    return ma_linear_resampler_get_input_latency(pResampler) * pResampler->config.sampleRateOut / pResampler->config.sampleRateIn;
+    return ma_polyphase_resampler_get_input_latency(pResampler) * pResampler->config.sampleRateOut / pResampler->config.sampleRateIn;
 }
 
-MA_API ma_result ma_linear_resampler_get_required_input_frame_count(const ma_linear_resampler* pResampler, ma_uint64 outputFrameCount, ma_uint64* pInputFrameCount)
+MA_API ma_result ma_polyphase_resampler_get_required_input_frame_count(const ma_polyphase_resampler* pResampler, ma_uint64 outputFrameCount, ma_uint64* pInputFrameCount)
 {
     ma_uint64 inputFrameCount;
 
@@ -51774,7 +56679,7 @@ MA_API ma_result ma_linear_resampler_get_required_input_frame_count(const ma_lin
     return MA_SUCCESS;
 }
 
-MA_API ma_result ma_linear_resampler_get_expected_output_frame_count(const ma_linear_resampler* pResampler, ma_uint64 inputFrameCount, ma_uint64* pOutputFrameCount)
+MA_API ma_result ma_polyphase_resampler_get_expected_output_frame_count(const ma_polyphase_resampler* pResampler, ma_uint64 inputFrameCount, ma_uint64* pOutputFrameCount)
 {
     ma_uint64 outputFrameCount;
     ma_uint64 preliminaryInputFrameCountFromFrac;
@@ -51790,26 +56695,12 @@ MA_API ma_result ma_linear_resampler_get_expected_output_frame_count(const ma_li
         return MA_INVALID_ARGS;
     }
 
-    /*
-    The first step is to get a preliminary output frame count. This will either be exactly equal to what we need, or less by 1. We need to
-    determine how many input frames will be consumed by this value. If it's greater than our original input frame count it means we won't
-    be able to generate an extra frame because we will have run out of input data. Otherwise we will have enough input for the generation
-    of an extra output frame. This add-by-one logic is necessary due to how the data loading logic works when processing frames.
-    */
+    /* See ma_linear_resampler_get_expected_output_frame_count() for an explanation of this. The timing logic is the same. */
     outputFrameCount = (inputFrameCount * pResampler->config.sampleRateOut) / pResampler->config.sampleRateIn;
 
-    /*
-    We need to determine how many *whole* input frames will have been processed to generate our preliminary output frame count. This is
-    used in the logic below to determine whether or not we need to add an extra output frame.
-    */
     preliminaryInputFrameCountFromFrac = (pResampler->inTimeFrac + outputFrameCount*pResampler->inAdvanceFrac) / pResampler->config.sampleRateOut;
     preliminaryInputFrameCount         = (pResampler->inTimeInt  + outputFrameCount*pResampler->inAdvanceInt ) + preliminaryInputFrameCountFromFrac;
 
-    /*
-    If the total number of *whole* input frames that would be required to generate our preliminary output frame count is greather than
-    the amount of whole input frames we have available as input we need to *not* add an extra output frame as there won't be enough data
-    to actually process. Otherwise we need to add the extra output frame.
-    */
     if (preliminaryInputFrameCount <= inputFrameCount) {
         outputFrameCount += 1;
     }
@@ -51819,10 +56710,8 @@ MA_API ma_result ma_linear_resampler_get_expected_output_frame_count(const ma_li
     return MA_SUCCESS;
 }
 
-MA_API ma_result ma_linear_resampler_reset(ma_linear_resampler* pResampler)
+MA_API ma_result ma_polyphase_resampler_reset(ma_polyphase_resampler* pResampler)
 {
-    ma_uint32 iChannel;
-
     if (pResampler == NULL) {
         return MA_INVALID_ARGS;
     }
@@ -51831,25 +56720,23 @@ MA_API ma_result ma_linear_resampler_reset(ma_linear_resampler* pResampler)
     pResampler->inTimeInt  = 1;  /* Set this to one to force an input sample to always be loaded for the first output frame. */
     pResampler->inTimeFrac = 0;
 
-    /* Cached samples need to be cleared. */
-    if (pResampler->config.format == ma_format_f32) {
-        for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
-            pResampler->x0.f32[iChannel] = 0;
-            pResampler->x1.f32[iChannel] = 0;
-        }
-    } else {
-        for (iChannel = 0; iChannel < pResampler->config.channels; iChannel += 1) {
-            pResampler->x0.s16[iChannel] = 0;
-            pResampler->x1.s16[iChannel] = 0;
-        }
-    }
-
-    /* The low pass filter needs to have it's cache reset. */
-    ma_lpf_clear_cache(&pResampler->lpf);
+    /* The history needs to be cleared. The coefficients are untouched since they only depend on the rate. */
+    pResampler->historyCursor = 0;
+    MA_ZERO_MEMORY(pResampler->pHistory, sizeof(float) * pResampler->tapCount * 2 * pResampler->config.channels);
 
     return MA_SUCCESS;
 }
 
+MA_API ma_bool32 ma_polyphase_resampler_is_fixed_ratio(const ma_polyphase_resampler* pResampler)
+{
+    if (pResampler == NULL) {
+        return MA_FALSE;
+    }
+
+    /* Every fractional position has its own row in the table. */
+    return pResampler->phaseCount == pResampler->config.sampleRateOut;
+}
+
 
 
 /* Linear resampler backend vtable. */
@@ -51966,6 +56853,118 @@ static ma_resampling_backend_vtable g_ma_linear_resampler_vtable =
 
 
 
+/* Polyphase resampler backend vtable. */
+static ma_polyphase_resampler_config ma_resampling_backend_get_config__polyphase(const ma_resampler_config* pConfig)
+{
+    ma_polyphase_resampler_config polyphaseConfig;
+
+    polyphaseConfig = ma_polyphase_resampler_config_init(pConfig->format, pConfig->channels, pConfig->sampleRateIn, pConfig->sampleRateOut);
+    polyphaseConfig.quality = pConfig->polyphase.quality;
+
+    return polyphaseConfig;
+}
+
+static ma_result ma_resampling_backend_get_heap_size__polyphase(void* pUserData, const ma_resampler_config* pConfig, size_t* pHeapSizeInBytes)
+{
+    ma_polyphase_resampler_config polyphaseConfig;
+
+    (void)pUserData;
+
+    polyphaseConfig = ma_resampling_backend_get_config__polyphase(pConfig);
+
+    return ma_polyphase_resampler_get_heap_size(&polyphaseConfig, pHeapSizeInBytes);
+}
+
+static ma_result ma_resampling_backend_init__polyphase(void* pUserData, const ma_resampler_config* pConfig, void* pHeap, ma_resampling_backend** ppBackend)
+{
+    ma_resampler* pResampler = (ma_resampler*)pUserData;
+    ma_result result;
+    ma_polyphase_resampler_config polyphaseConfig;
+
+    polyphaseConfig = ma_resampling_backend_get_config__polyphase(pConfig);
+
+    result = ma_polyphase_resampler_init_preallocated(&polyphaseConfig, pHeap, &pResampler->state.polyphase);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    *ppBackend = &pResampler->state.polyphase;
+
+    return MA_SUCCESS;
+}
+
+static void ma_resampling_backend_uninit__polyphase(void* pUserData, ma_resampling_backend* pBackend, const ma_allocation_callbacks* pAllocationCallbacks)
+{
+    (void)pUserData;
+
+    ma_polyphase_resampler_uninit((ma_polyphase_resampler*)pBackend, pAllocationCallbacks);
+}
+
+static ma_result ma_resampling_backend_process__polyphase(void* pUserData, ma_resampling_backend* pBackend, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+{
+    (void)pUserData;
+
+    return ma_polyphase_resampler_process_pcm_frames((ma_polyphase_resampler*)pBackend, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+}
+
+static ma_result ma_resampling_backend_set_rate__polyphase(void* pUserData, ma_resampling_backend* pBackend, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut)
+{
+    (void)pUserData;
+
+    return ma_polyphase_resampler_set_rate((ma_polyphase_resampler*)pBackend, sampleRateIn, sampleRateOut);
+}
+
+static ma_uint64 ma_resampling_backend_get_input_latency__polyphase(void* pUserData, const ma_resampling_backend* pBackend)
+{
+    (void)pUserData;
+
+    return ma_polyphase_resampler_get_input_latency((const ma_polyphase_resampler*)pBackend);
+}
+
+static ma_uint64 ma_resampling_backend_get_output_latency__polyphase(void* pUserData, const ma_resampling_backend* pBackend)
+{
+    (void)pUserData;
+
+    return ma_polyphase_resampler_get_output_latency((const ma_polyphase_resampler*)pBackend);
+}
+
+static ma_result ma_resampling_backend_get_required_input_frame_count__polyphase(void* pUserData, const ma_resampling_backend* pBackend, ma_uint64 outputFrameCount, ma_uint64* pInputFrameCount)
+{
+    (void)pUserData;
+
+    return ma_polyphase_resampler_get_required_input_frame_count((const ma_polyphase_resampler*)pBackend, outputFrameCount, pInputFrameCount);
+}
+
+static ma_result ma_resampling_backend_get_expected_output_frame_count__polyphase(void* pUserData, const ma_resampling_backend* pBackend, ma_uint64 inputFrameCount, ma_uint64* pOutputFrameCount)
+{
+    (void)pUserData;
+
+    return ma_polyphase_resampler_get_expected_output_frame_count((const ma_polyphase_resampler*)pBackend, inputFrameCount, pOutputFrameCount);
+}
+
+static ma_result ma_resampling_backend_reset__polyphase(void* pUserData, ma_resampling_backend* pBackend)
+{
+    (void)pUserData;
+
+    return ma_polyphase_resampler_reset((ma_polyphase_resampler*)pBackend);
+}
+
+static ma_resampling_backend_vtable g_ma_polyphase_resampler_vtable =
+{
+    ma_resampling_backend_get_heap_size__polyphase,
+    ma_resampling_backend_init__polyphase,
+    ma_resampling_backend_uninit__polyphase,
+    ma_resampling_backend_process__polyphase,
+    ma_resampling_backend_set_rate__polyphase,
+    ma_resampling_backend_get_input_latency__polyphase,
+    ma_resampling_backend_get_output_latency__polyphase,
+    ma_resampling_backend_get_required_input_frame_count__polyphase,
+    ma_resampling_backend_get_expected_output_frame_count__polyphase,
+    ma_resampling_backend_reset__polyphase
+};
+
+
+
 MA_API ma_resampler_config ma_resampler_config_init(ma_format format, ma_uint32 channels, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut, ma_resample_algorithm algorithm)
 {
     ma_resampler_config config;
@@ -51980,6 +56979,9 @@ MA_API ma_resampler_config ma_resampler_config_init(ma_format format, ma_uint32
     /* Linear. */
     config.linear.lpfOrder = ma_min(MA_DEFAULT_RESAMPLER_LPF_ORDER, MA_MAX_FILTER_ORDER);
 
+    /* Polyphase. */
+    config.polyphase.quality = MA_DEFAULT_POLYPHASE_RESAMPLER_QUALITY;
+
     return config;
 }
 
@@ -52001,6 +57003,12 @@ static ma_result ma_resampler_get_vtable(const ma_resampler_config* pConfig, ma_
             *ppUserData = pResampler;
         } break;
 
+        case ma_resample_algorithm_polyphase:
+        {
+            *ppVTable   = &g_ma_polyphase_resampler_vtable;
+            *ppUserData = pResampler;
+        } break;
+
         case ma_resample_algorithm_custom:
         {
             *ppVTable   = pConfig->pBackendVTable;
@@ -52276,6 +57284,23 @@ MA_API ma_result ma_resampler_reset(ma_resampler* pResampler)
     return pResampler->pBackendVTable->onReset(pResampler->pBackendUserData, pResampler->pBackend);
 }
 
+MA_API ma_bool32 ma_resampler_is_fixed_ratio(const ma_resampler* pResampler)
+{
+    if (pResampler == NULL) {
+        return MA_FALSE;
+    }
+
+    if (pResampler->pBackendVTable == &g_ma_linear_resampler_vtable) {
+        return ma_linear_resampler_is_fixed_ratio((const ma_linear_resampler*)pResampler->pBackend);
+    }
+
+    if (pResampler->pBackendVTable == &g_ma_polyphase_resampler_vtable) {
+        return ma_polyphase_resampler_is_fixed_ratio((const ma_polyphase_resampler*)pResampler->pBackend);
+    }
+
+    return MA_FALSE;
+}
+
 /**************************************************************************************************************************************************************
 
 Channel Conversion
@@ -52634,20 +57659,71 @@ static void ma_channel_map_apply_shuffle_table_s24(ma_uint8* pFramesOut, ma_uint
                 pFramesOut[iChannelOut*3 + 2] = pFramesIn[iChannelIn*3 + 2];
             } else {
                 pFramesOut[iChannelOut*3 + 0] = 0;
-            }   pFramesOut[iChannelOut*3 + 1] = 0;
-        }       pFramesOut[iChannelOut*3 + 2] = 0;
+                pFramesOut[iChannelOut*3 + 1] = 0;
+                pFramesOut[iChannelOut*3 + 2] = 0;
+            }
+        }
 
         pFramesOut += channelsOut*3;
         pFramesIn  += channelsIn*3;
     }
 }
 
+#if defined(MA_SUPPORT_AVX2)
+/*
+Shuffles 32-bit samples 8 at a time, which is 4 stereo frames, 2 quad frames or 1 7.1 frame. The
+channel counts must be the same and divide 8. Returns the number of frames that were processed.
+*/
+static ma_uint64 ma_channel_map_apply_shuffle_table_32__avx2(ma_int32* pFramesOut, const ma_int32* pFramesIn, ma_uint32 channels, ma_uint64 frameCount, const ma_uint8* pShuffleTable)
+{
+    ma_int32 indices[8];
+    ma_int32 mask[8];
+    ma_uint32 iLane;
+    ma_uint32 framesPerVector = 8 / channels;
+    ma_uint64 frameCountVectors = frameCount / framesPerVector;
+    ma_uint64 iVector;
+    __m256i indices8;
+    __m256i mask8;
+
+    MA_ASSERT(channels == 2 || channels == 4 || channels == 8);
+
+    for (iLane = 0; iLane < 8; iLane += 1) {
+        ma_uint8 iChannelIn = pShuffleTable[iLane % channels];
+        if (iChannelIn < channels) {
+            indices[iLane] = (ma_int32)((iLane / channels) * channels + iChannelIn);
+            mask[iLane]    = -1;
+        } else {
+            indices[iLane] = 0;
+            mask[iLane]    = 0;
+        }
+    }
+
+    indices8 = _mm256_loadu_si256((const __m256i*)indices);
+    mask8    = _mm256_loadu_si256((const __m256i*)mask);
+
+    for (iVector = 0; iVector < frameCountVectors; iVector += 1) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(pFramesIn + iVector*8));
+        _mm256_storeu_si256((__m256i*)(pFramesOut + iVector*8), _mm256_and_si256(_mm256_permutevar8x32_epi32(x, indices8), mask8));
+    }
+
+    return frameCountVectors * framesPerVector;
+}
+#endif
+
 static void ma_channel_map_apply_shuffle_table_s32(ma_int32* pFramesOut, ma_uint32 channelsOut, const ma_int32* pFramesIn, ma_uint32 channelsIn, ma_uint64 frameCount, const ma_uint8* pShuffleTable)
 {
-    ma_uint64 iFrame;
+    ma_uint64 iFrame = 0;
     ma_uint32 iChannelOut;
 
-    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+#if defined(MA_SUPPORT_AVX2)
+    if (ma_has_avx2() && channelsIn == channelsOut && (channelsOut == 2 || channelsOut == 4 || channelsOut == 8)) {
+        iFrame = ma_channel_map_apply_shuffle_table_32__avx2(pFramesOut, pFramesIn, channelsOut, frameCount, pShuffleTable);
+        pFramesOut += iFrame * channelsOut;
+        pFramesIn  += iFrame * channelsIn;
+    }
+#endif
+
+    for (; iFrame < frameCount; iFrame += 1) {
         for (iChannelOut = 0; iChannelOut < channelsOut; iChannelOut += 1) {
             ma_uint8 iChannelIn = pShuffleTable[iChannelOut];
             if (iChannelIn < channelsIn) {  /* For safety, and to deal with MA_CHANNEL_INDEX_NULL. */
@@ -52664,10 +57740,19 @@ static void ma_channel_map_apply_shuffle_table_s32(ma_int32* pFramesOut, ma_uint
 
 static void ma_channel_map_apply_shuffle_table_f32(float* pFramesOut, ma_uint32 channelsOut, const float* pFramesIn, ma_uint32 channelsIn, ma_uint64 frameCount, const ma_uint8* pShuffleTable)
 {
-    ma_uint64 iFrame;
+    ma_uint64 iFrame = 0;
     ma_uint32 iChannelOut;
 
-    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+#if defined(MA_SUPPORT_AVX2)
+    /* Only the bits are moved around so this can share the same path as s32. */
+    if (ma_has_avx2() && channelsIn == channelsOut && (channelsOut == 2 || channelsOut == 4 || channelsOut == 8)) {
+        iFrame = ma_channel_map_apply_shuffle_table_32__avx2((ma_int32*)pFramesOut, (const ma_int32*)pFramesIn, channelsOut, frameCount, pShuffleTable);
+        pFramesOut += iFrame * channelsOut;
+        pFramesIn  += iFrame * channelsIn;
+    }
+#endif
+
+    for (; iFrame < frameCount; iFrame += 1) {
         for (iChannelOut = 0; iChannelOut < channelsOut; iChannelOut += 1) {
             ma_uint8 iChannelIn = pShuffleTable[iChannelOut];
             if (iChannelIn < channelsIn) {  /* For safety, and to deal with MA_CHANNEL_INDEX_NULL. */
@@ -53182,6 +58267,10 @@ typedef struct
     size_t channelMapOutOffset;
     size_t shuffleTableOffset;
     size_t weightsOffset;
+    size_t sparseWeightsOffset;
+    size_t stereoWeightsOffset;
+    size_t sparseWeightChannelsOffset;
+    size_t stereoWeightChannelsOffset;
 } ma_channel_converter_heap_layout;
 
 static ma_channel_conversion_path ma_channel_converter_config_get_conversion_path(const ma_channel_converter_config* pConfig)
@@ -53244,6 +58333,28 @@ static ma_result ma_channel_converter_get_heap_layout(const ma_channel_converter
         pHeapLayout->sizeInBytes += sizeof(float ) * pConfig->channelsIn * pConfig->channelsOut;
     }
 
+    /* Sparse weights. Most weight tables are mostly zero so the non-zero weights are also stored as a list. This needs to be big enough for a full table. */
+    pHeapLayout->sparseWeightsOffset = pHeapLayout->sizeInBytes;
+    if (conversionPath == ma_channel_conversion_path_weights) {
+        pHeapLayout->sizeInBytes += sizeof(float) * pConfig->channelsIn * pConfig->channelsOut;
+    }
+
+    /* Weights for the f32 to stereo case, which is common enough for downmixing to have its own path. */
+    pHeapLayout->stereoWeightsOffset = pHeapLayout->sizeInBytes;
+    if (conversionPath == ma_channel_conversion_path_weights && pConfig->format == ma_format_f32 && pConfig->channelsOut == 2) {
+        pHeapLayout->sizeInBytes += sizeof(float) * 4 * pConfig->channelsIn;
+    }
+
+    pHeapLayout->sparseWeightChannelsOffset = pHeapLayout->sizeInBytes;
+    if (conversionPath == ma_channel_conversion_path_weights) {
+        pHeapLayout->sizeInBytes += sizeof(ma_uint8) * 2 * pConfig->channelsIn * pConfig->channelsOut;
+    }
+
+    pHeapLayout->stereoWeightChannelsOffset = pHeapLayout->sizeInBytes;
+    if (conversionPath == ma_channel_conversion_path_weights && pConfig->format == ma_format_f32 && pConfig->channelsOut == 2) {
+        pHeapLayout->sizeInBytes += sizeof(ma_uint8) * pConfig->channelsIn;
+    }
+
     /* Make sure allocation size is aligned. */
     pHeapLayout->sizeInBytes = ma_align_64(pHeapLayout->sizeInBytes);
 
@@ -53487,6 +58598,60 @@ MA_API ma_result ma_channel_converter_init_preallocated(const ma_channel_convert
                 }
             } break;
         }
+
+        /*
+        Now compile the weights into a list of the non-zero ones. Something like a 7.1 to stereo downmix
+        only has about one non-zero weight for each input channel, so this saves most of the work. The
+        order is the same as the table so each output channel is accumulated in the same order.
+        */
+        pConverter->pSparseWeightChannels = (ma_uint8*)ma_offset_ptr(pHeap, heapLayout.sparseWeightChannelsOffset);
+        if (pConverter->format == ma_format_f32) {
+            pConverter->sparseWeights.f32 = (float*   )ma_offset_ptr(pHeap, heapLayout.sparseWeightsOffset);
+        } else {
+            pConverter->sparseWeights.s16 = (ma_int32*)ma_offset_ptr(pHeap, heapLayout.sparseWeightsOffset);
+        }
+
+        for (iChannelIn = 0; iChannelIn < pConverter->channelsIn; iChannelIn += 1) {
+            for (iChannelOut = 0; iChannelOut < pConverter->channelsOut; iChannelOut += 1) {
+                if (pConverter->format == ma_format_f32) {
+                    if (pConverter->weights.f32[iChannelIn][iChannelOut] == 0) {
+                        continue;
+                    }
+                    pConverter->sparseWeights.f32[pConverter->sparseWeightCount] = pConverter->weights.f32[iChannelIn][iChannelOut];
+                } else {
+                    if (pConverter->weights.s16[iChannelIn][iChannelOut] == 0) {
+                        continue;
+                    }
+                    pConverter->sparseWeights.s16[pConverter->sparseWeightCount] = pConverter->weights.s16[iChannelIn][iChannelOut];
+                }
+
+                pConverter->pSparseWeightChannels[pConverter->sparseWeightCount*2 + 0] = (ma_uint8)iChannelIn;
+                pConverter->pSparseWeightChannels[pConverter->sparseWeightCount*2 + 1] = (ma_uint8)iChannelOut;
+                pConverter->sparseWeightCount += 1;
+            }
+        }
+
+        /* The stereo case only needs the input channels that contribute to either side. */
+        if (pConverter->format == ma_format_f32 && pConverter->channelsOut == 2) {
+            pConverter->pStereoWeights        = (float*   )ma_offset_ptr(pHeap, heapLayout.stereoWeightsOffset);
+            pConverter->pStereoWeightChannels = (ma_uint8*)ma_offset_ptr(pHeap, heapLayout.stereoWeightChannelsOffset);
+
+            for (iChannelIn = 0; iChannelIn < pConverter->channelsIn; iChannelIn += 1) {
+                float weightL = pConverter->weights.f32[iChannelIn][0];
+                float weightR = pConverter->weights.f32[iChannelIn][1];
+
+                if (weightL == 0 && weightR == 0) {
+                    continue;
+                }
+
+                pConverter->pStereoWeights[pConverter->stereoWeightCount*4 + 0] = weightL;
+                pConverter->pStereoWeights[pConverter->stereoWeightCount*4 + 1] = weightR;
+                pConverter->pStereoWeights[pConverter->stereoWeightCount*4 + 2] = weightL;
+                pConverter->pStereoWeights[pConverter->stereoWeightCount*4 + 3] = weightR;
+                pConverter->pStereoWeightChannels[pConverter->stereoWeightCount] = (ma_uint8)iChannelIn;
+                pConverter->stereoWeightCount += 1;
+            }
+        }
     }
 
     return MA_SUCCESS;
@@ -53553,6 +58718,102 @@ static ma_result ma_channel_converter_process_pcm_frames__shuffle(ma_channel_con
     return ma_channel_map_apply_shuffle_table(pFramesOut, pConverter->channelsOut, pFramesIn, pConverter->channelsIn, frameCount, pConverter->pShuffleTable, pConverter->format);
 }
 
+#if defined(MA_SUPPORT_SSE2)
+static MA_INLINE ma_uint64 ma_channel_converter_mono_to_stereo_f32__sse2(float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 frameCount4 = frameCount & ~(ma_uint64)3;
+    ma_uint64 iFrame;
+
+    for (iFrame = 0; iFrame < frameCount4; iFrame += 4) {
+        __m128 x = _mm_loadu_ps(pFramesIn + iFrame);
+        _mm_storeu_ps(pFramesOut + iFrame*2 + 0, _mm_unpacklo_ps(x, x));
+        _mm_storeu_ps(pFramesOut + iFrame*2 + 4, _mm_unpackhi_ps(x, x));
+    }
+
+    return frameCount4;
+}
+
+static MA_INLINE ma_uint64 ma_channel_converter_mono_to_stereo_s16__sse2(ma_int16* pFramesOut, const ma_int16* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 frameCount8 = frameCount & ~(ma_uint64)7;
+    ma_uint64 iFrame;
+
+    for (iFrame = 0; iFrame < frameCount8; iFrame += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(pFramesIn + iFrame));
+        _mm_storeu_si128((__m128i*)(pFramesOut + iFrame*2 + 0), _mm_unpacklo_epi16(x, x));
+        _mm_storeu_si128((__m128i*)(pFramesOut + iFrame*2 + 8), _mm_unpackhi_epi16(x, x));
+    }
+
+    return frameCount8;
+}
+
+static MA_INLINE ma_uint64 ma_channel_converter_mono_to_multi4_f32__sse2(float* pFramesOut, ma_uint32 channelsOut, const float* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 iFrame;
+    ma_uint32 iChannel;
+
+    MA_ASSERT((channelsOut & 3) == 0);
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        __m128 x = _mm_set1_ps(pFramesIn[iFrame]);
+        for (iChannel = 0; iChannel < channelsOut; iChannel += 4) {
+            _mm_storeu_ps(pFramesOut + iFrame*channelsOut + iChannel, x);
+        }
+    }
+
+    return frameCount;
+}
+#endif
+
+#if defined(MA_SUPPORT_NEON)
+static MA_INLINE ma_uint64 ma_channel_converter_mono_to_stereo_f32__neon(float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 frameCount4 = frameCount & ~(ma_uint64)3;
+    ma_uint64 iFrame;
+
+    for (iFrame = 0; iFrame < frameCount4; iFrame += 4) {
+        float32x4x2_t x;
+        x.val[0] = vld1q_f32(pFramesIn + iFrame);
+        x.val[1] = x.val[0];
+        vst2q_f32(pFramesOut + iFrame*2, x);
+    }
+
+    return frameCount4;
+}
+
+static MA_INLINE ma_uint64 ma_channel_converter_mono_to_stereo_s16__neon(ma_int16* pFramesOut, const ma_int16* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 frameCount8 = frameCount & ~(ma_uint64)7;
+    ma_uint64 iFrame;
+
+    for (iFrame = 0; iFrame < frameCount8; iFrame += 8) {
+        int16x8x2_t x;
+        x.val[0] = vld1q_s16(pFramesIn + iFrame);
+        x.val[1] = x.val[0];
+        vst2q_s16(pFramesOut + iFrame*2, x);
+    }
+
+    return frameCount8;
+}
+
+static MA_INLINE ma_uint64 ma_channel_converter_mono_to_multi4_f32__neon(float* pFramesOut, ma_uint32 channelsOut, const float* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 iFrame;
+    ma_uint32 iChannel;
+
+    MA_ASSERT((channelsOut & 3) == 0);
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        float32x4_t x = vdupq_n_f32(pFramesIn[iFrame]);
+        for (iChannel = 0; iChannel < channelsOut; iChannel += 4) {
+            vst1q_f32(pFramesOut + iFrame*channelsOut + iChannel, x);
+        }
+    }
+
+    return frameCount;
+}
+#endif
+
 static ma_result ma_channel_converter_process_pcm_frames__mono_in(ma_channel_converter* pConverter, void* pFramesOut, const void* pFramesIn, ma_uint64 frameCount)
 {
     ma_uint64 iFrame;
@@ -53583,7 +58844,22 @@ static ma_result ma_channel_converter_process_pcm_frames__mono_in(ma_channel_con
             const ma_int16* pFramesInS16  = (const ma_int16*)pFramesIn;
 
             if (pConverter->channelsOut == 2) {
-                for (iFrame = 0; iFrame < frameCount; ++iFrame) {
+                iFrame = 0;
+
+            #if defined(MA_SUPPORT_SSE2)
+                if (ma_has_sse2()) {
+                    iFrame = ma_channel_converter_mono_to_stereo_s16__sse2(pFramesOutS16, pFramesInS16, frameCount);
+                } else
+            #elif defined(MA_SUPPORT_NEON)
+                if (ma_has_neon()) {
+                    iFrame = ma_channel_converter_mono_to_stereo_s16__neon(pFramesOutS16, pFramesInS16, frameCount);
+                } else
+            #endif
+                {
+                    /* Scalar only. */
+                }
+
+                for (; iFrame < frameCount; ++iFrame) {
                     pFramesOutS16[iFrame*2 + 0] = pFramesInS16[iFrame];
                     pFramesOutS16[iFrame*2 + 1] = pFramesInS16[iFrame];
                 }
@@ -53633,12 +58909,45 @@ static ma_result ma_channel_converter_process_pcm_frames__mono_in(ma_channel_con
             const float* pFramesInF32  = (const float*)pFramesIn;
 
             if (pConverter->channelsOut == 2) {
-                for (iFrame = 0; iFrame < frameCount; ++iFrame) {
+                iFrame = 0;
+
+            #if defined(MA_SUPPORT_SSE2)
+                if (ma_has_sse2()) {
+                    iFrame = ma_channel_converter_mono_to_stereo_f32__sse2(pFramesOutF32, pFramesInF32, frameCount);
+                } else
+            #elif defined(MA_SUPPORT_NEON)
+                if (ma_has_neon()) {
+                    iFrame = ma_channel_converter_mono_to_stereo_f32__neon(pFramesOutF32, pFramesInF32, frameCount);
+                } else
+            #endif
+                {
+                    /* Scalar only. */
+                }
+
+                for (; iFrame < frameCount; ++iFrame) {
                     pFramesOutF32[iFrame*2 + 0] = pFramesInF32[iFrame];
                     pFramesOutF32[iFrame*2 + 1] = pFramesInF32[iFrame];
                 }
             } else {
-                for (iFrame = 0; iFrame < frameCount; ++iFrame) {
+                iFrame = 0;
+
+                /* Quad, 7.1 and the like can write whole vectors at a time. */
+                if ((pConverter->channelsOut & 3) == 0) {
+                #if defined(MA_SUPPORT_SSE2)
+                    if (ma_has_sse2()) {
+                        iFrame = ma_channel_converter_mono_to_multi4_f32__sse2(pFramesOutF32, pConverter->channelsOut, pFramesInF32, frameCount);
+                    } else
+                #elif defined(MA_SUPPORT_NEON)
+                    if (ma_has_neon()) {
+                        iFrame = ma_channel_converter_mono_to_multi4_f32__neon(pFramesOutF32, pConverter->channelsOut, pFramesInF32, frameCount);
+                    } else
+                #endif
+                    {
+                        /* Scalar only. */
+                    }
+                }
+
+                for (; iFrame < frameCount; ++iFrame) {
                     ma_uint32 iChannel;
                     for (iChannel = 0; iChannel < pConverter->channelsOut; iChannel += 1) {
                         pFramesOutF32[iFrame*pConverter->channelsOut + iChannel] = pFramesInF32[iFrame];
@@ -53653,6 +58962,89 @@ static ma_result ma_channel_converter_process_pcm_frames__mono_in(ma_channel_con
     return MA_SUCCESS;
 }
 
+
+/*
+The stereo to mono kernels below need to give the same results as the scalar path. For f32 the sum
+starts at zero like the scalar loop so that -0 comes out the same way. For s16 the division needs to
+round towards zero like the `/` operator, which is what the adjustment before the shift is for.
+*/
+#if defined(MA_SUPPORT_SSE2)
+static MA_INLINE ma_uint64 ma_channel_converter_stereo_to_mono_f32__sse2(float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 frameCount4 = frameCount & ~(ma_uint64)3;
+    ma_uint64 iFrame;
+    __m128 zero = _mm_setzero_ps();
+    __m128 two  = _mm_set1_ps(2.0f);
+
+    for (iFrame = 0; iFrame < frameCount4; iFrame += 4) {
+        __m128 a = _mm_loadu_ps(pFramesIn + iFrame*2 + 0);
+        __m128 b = _mm_loadu_ps(pFramesIn + iFrame*2 + 4);
+        __m128 l = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(pFramesOut + iFrame, _mm_div_ps(_mm_add_ps(_mm_add_ps(zero, l), r), two));
+    }
+
+    return frameCount4;
+}
+
+static MA_INLINE __m128i ma_channel_converter_stereo_to_mono_s16_4__sse2(__m128i x)
+{
+    __m128i t = _mm_madd_epi16(x, _mm_set1_epi16(1));  /* Adds each left and right pair as 32-bit. */
+    return _mm_srai_epi32(_mm_add_epi32(t, _mm_srli_epi32(t, 31)), 1);
+}
+
+static MA_INLINE ma_uint64 ma_channel_converter_stereo_to_mono_s16__sse2(ma_int16* pFramesOut, const ma_int16* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 frameCount8 = frameCount & ~(ma_uint64)7;
+    ma_uint64 iFrame;
+
+    for (iFrame = 0; iFrame < frameCount8; iFrame += 8) {
+        __m128i a = ma_channel_converter_stereo_to_mono_s16_4__sse2(_mm_loadu_si128((const __m128i*)(pFramesIn + iFrame*2 + 0)));
+        __m128i b = ma_channel_converter_stereo_to_mono_s16_4__sse2(_mm_loadu_si128((const __m128i*)(pFramesIn + iFrame*2 + 8)));
+        _mm_storeu_si128((__m128i*)(pFramesOut + iFrame), _mm_packs_epi32(a, b));
+    }
+
+    return frameCount8;
+}
+#endif
+
+#if defined(MA_SUPPORT_NEON)
+static MA_INLINE ma_uint64 ma_channel_converter_stereo_to_mono_f32__neon(float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 frameCount4 = frameCount & ~(ma_uint64)3;
+    ma_uint64 iFrame;
+    float32x4_t zero = vdupq_n_f32(0);
+    float32x4_t half = vdupq_n_f32(0.5f);   /* Multiplying by a half is exact so this is the same as dividing by two. */
+
+    for (iFrame = 0; iFrame < frameCount4; iFrame += 4) {
+        float32x4x2_t x = vld2q_f32(pFramesIn + iFrame*2);
+        vst1q_f32(pFramesOut + iFrame, vmulq_f32(vaddq_f32(vaddq_f32(zero, x.val[0]), x.val[1]), half));
+    }
+
+    return frameCount4;
+}
+
+static MA_INLINE int16x4_t ma_channel_converter_stereo_to_mono_s16_4__neon(int16x8_t x)
+{
+    int32x4_t t = vpaddlq_s16(x);
+    return vmovn_s32(vshrq_n_s32(vaddq_s32(t, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(t), 31))), 1));
+}
+
+static MA_INLINE ma_uint64 ma_channel_converter_stereo_to_mono_s16__neon(ma_int16* pFramesOut, const ma_int16* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 frameCount8 = frameCount & ~(ma_uint64)7;
+    ma_uint64 iFrame;
+
+    for (iFrame = 0; iFrame < frameCount8; iFrame += 8) {
+        int16x4_t a = ma_channel_converter_stereo_to_mono_s16_4__neon(vld1q_s16(pFramesIn + iFrame*2 + 0));
+        int16x4_t b = ma_channel_converter_stereo_to_mono_s16_4__neon(vld1q_s16(pFramesIn + iFrame*2 + 8));
+        vst1q_s16(pFramesOut + iFrame, vcombine_s16(a, b));
+    }
+
+    return frameCount8;
+}
+#endif
+
 static ma_result ma_channel_converter_process_pcm_frames__mono_out(ma_channel_converter* pConverter, void* pFramesOut, const void* pFramesIn, ma_uint64 frameCount)
 {
     ma_uint64 iFrame;
@@ -53685,13 +59077,30 @@ static ma_result ma_channel_converter_process_pcm_frames__mono_out(ma_channel_co
             /* */ ma_int16* pFramesOutS16 = (      ma_int16*)pFramesOut;
             const ma_int16* pFramesInS16  = (const ma_int16*)pFramesIn;
 
-            for (iFrame = 0; iFrame < frameCount; ++iFrame) {
+            iFrame = 0;
+
+            if (pConverter->channelsIn == 2) {
+            #if defined(MA_SUPPORT_SSE2)
+                if (ma_has_sse2()) {
+                    iFrame = ma_channel_converter_stereo_to_mono_s16__sse2(pFramesOutS16, pFramesInS16, frameCount);
+                } else
+            #elif defined(MA_SUPPORT_NEON)
+                if (ma_has_neon()) {
+                    iFrame = ma_channel_converter_stereo_to_mono_s16__neon(pFramesOutS16, pFramesInS16, frameCount);
+                } else
+            #endif
+                {
+                    /* Scalar only. */
+                }
+            }
+
+            for (; iFrame < frameCount; ++iFrame) {
                 ma_int32 t = 0;
                 for (iChannel = 0; iChannel < pConverter->channelsIn; iChannel += 1) {
                     t += pFramesInS16[iFrame*pConverter->channelsIn + iChannel];
                 }
 
-                pFramesOutS16[iFrame] = (ma_int16)(t / pConverter->channelsIn);
+                pFramesOutS16[iFrame] = (ma_int16)(t / (ma_int32)pConverter->channelsIn);
             }
         } break;
 
@@ -53730,7 +59139,24 @@ static ma_result ma_channel_converter_process_pcm_frames__mono_out(ma_channel_co
             /* */ float* pFramesOutF32 = (      float*)pFramesOut;
             const float* pFramesInF32  = (const float*)pFramesIn;
 
-            for (iFrame = 0; iFrame < frameCount; ++iFrame) {
+            iFrame = 0;
+
+            if (pConverter->channelsIn == 2) {
+            #if defined(MA_SUPPORT_SSE2)
+                if (ma_has_sse2()) {
+                    iFrame = ma_channel_converter_stereo_to_mono_f32__sse2(pFramesOutF32, pFramesInF32, frameCount);
+                } else
+            #elif defined(MA_SUPPORT_NEON)
+                if (ma_has_neon()) {
+                    iFrame = ma_channel_converter_stereo_to_mono_f32__neon(pFramesOutF32, pFramesInF32, frameCount);
+                } else
+            #endif
+                {
+                    /* Scalar only. */
+                }
+            }
+
+            for (; iFrame < frameCount; ++iFrame) {
                 float t = 0;
                 for (iChannel = 0; iChannel < pConverter->channelsIn; iChannel += 1) {
                     t += pFramesInF32[iFrame*pConverter->channelsIn + iChannel];
@@ -53746,17 +59172,132 @@ static ma_result ma_channel_converter_process_pcm_frames__mono_out(ma_channel_co
     return MA_SUCCESS;
 }
 
-static ma_result ma_channel_converter_process_pcm_frames__weights(ma_channel_converter* pConverter, void* pFramesOut, const void* pFramesIn, ma_uint64 frameCount)
+
+/*
+The f32 to stereo kernels work on two frames at a time. Each input channel is duplicated across a
+vector as [frame0, frame0, frame1, frame1] and multiplied with its [L, R, L, R] weights. The inputs
+are accumulated in the same order as the scalar path so the results match.
+*/
+#if defined(MA_SUPPORT_SSE2)
+static MA_INLINE ma_uint64 ma_channel_converter_apply_weights_stereo_f32__sse2(ma_channel_converter* pConverter, float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount)
 {
-    ma_uint32 iFrame;
-    ma_uint32 iChannelIn;
+    ma_uint64 frameCount2 = frameCount & ~(ma_uint64)1;
+    ma_uint64 iFrame;
+    ma_uint32 iWeight;
+    ma_uint32 channelsIn = pConverter->channelsIn;
+
+    for (iFrame = 0; iFrame < frameCount2; iFrame += 2) {
+        const float* pFrame0 = pFramesIn + (iFrame + 0)*channelsIn;
+        const float* pFrame1 = pFramesIn + (iFrame + 1)*channelsIn;
+        __m128 x = _mm_setzero_ps();
+
+        for (iWeight = 0; iWeight < pConverter->stereoWeightCount; iWeight += 1) {
+            ma_uint8 iChannelIn = pConverter->pStereoWeightChannels[iWeight];
+            __m128 a = _mm_shuffle_ps(_mm_load_ss(pFrame0 + iChannelIn), _mm_load_ss(pFrame1 + iChannelIn), _MM_SHUFFLE(0, 0, 0, 0));
+            x = _mm_add_ps(x, _mm_mul_ps(a, _mm_loadu_ps(pConverter->pStereoWeights + iWeight*4)));
+        }
+
+        _mm_storeu_ps(pFramesOut + iFrame*2, x);
+    }
+
+    return frameCount2;
+}
+
+/* Used for one input channel, such as front center to 5.1. The row of weights is multiplied by each sample. */
+static MA_INLINE ma_uint64 ma_channel_converter_apply_weights_mono_f32__sse2(ma_channel_converter* pConverter, float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 iFrame;
+    ma_uint32 iChannelOut;
+    ma_uint32 channelsOut  = pConverter->channelsOut;
+    ma_uint32 channelsOut4 = channelsOut & ~3;
+    const float* pWeights  = pConverter->weights.f32[0];
+    __m128 zero = _mm_setzero_ps();
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        __m128 a = _mm_set1_ps(pFramesIn[iFrame]);
+
+        for (iChannelOut = 0; iChannelOut < channelsOut4; iChannelOut += 4) {
+            _mm_storeu_ps(pFramesOut + iFrame*channelsOut + iChannelOut, _mm_add_ps(zero, _mm_mul_ps(a, _mm_loadu_ps(pWeights + iChannelOut))));
+        }
+
+        for (; iChannelOut < channelsOut; iChannelOut += 1) {
+            pFramesOut[iFrame*channelsOut + iChannelOut] += pFramesIn[iFrame] * pWeights[iChannelOut];
+        }
+    }
+
+    return frameCount;
+}
+#endif
+
+#if defined(MA_SUPPORT_NEON)
+static MA_INLINE ma_uint64 ma_channel_converter_apply_weights_stereo_f32__neon(ma_channel_converter* pConverter, float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 frameCount2 = frameCount & ~(ma_uint64)1;
+    ma_uint64 iFrame;
+    ma_uint32 iWeight;
+    ma_uint32 channelsIn = pConverter->channelsIn;
+
+    for (iFrame = 0; iFrame < frameCount2; iFrame += 2) {
+        const float* pFrame0 = pFramesIn + (iFrame + 0)*channelsIn;
+        const float* pFrame1 = pFramesIn + (iFrame + 1)*channelsIn;
+        float32x4_t x = vdupq_n_f32(0);
+
+        for (iWeight = 0; iWeight < pConverter->stereoWeightCount; iWeight += 1) {
+            ma_uint8 iChannelIn = pConverter->pStereoWeightChannels[iWeight];
+            float32x4_t a = vcombine_f32(vdup_n_f32(pFrame0[iChannelIn]), vdup_n_f32(pFrame1[iChannelIn]));
+            x = vaddq_f32(x, vmulq_f32(a, vld1q_f32(pConverter->pStereoWeights + iWeight*4)));  /* Not fused so the rounding is the same as the scalar path. */
+        }
+
+        vst1q_f32(pFramesOut + iFrame*2, x);
+    }
+
+    return frameCount2;
+}
+
+static MA_INLINE ma_uint64 ma_channel_converter_apply_weights_mono_f32__neon(ma_channel_converter* pConverter, float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 iFrame;
     ma_uint32 iChannelOut;
+    ma_uint32 channelsOut  = pConverter->channelsOut;
+    ma_uint32 channelsOut4 = channelsOut & ~3;
+    const float* pWeights  = pConverter->weights.f32[0];
+    float32x4_t zero = vdupq_n_f32(0);
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        float32x4_t a = vdupq_n_f32(pFramesIn[iFrame]);
+
+        for (iChannelOut = 0; iChannelOut < channelsOut4; iChannelOut += 4) {
+            vst1q_f32(pFramesOut + iFrame*channelsOut + iChannelOut, vaddq_f32(zero, vmulq_f32(a, vld1q_f32(pWeights + iChannelOut))));
+        }
+
+        for (; iChannelOut < channelsOut; iChannelOut += 1) {
+            pFramesOut[iFrame*channelsOut + iChannelOut] += pFramesIn[iFrame] * pWeights[iChannelOut];
+        }
+    }
+
+    return frameCount;
+}
+#endif
+
+static ma_result ma_channel_converter_process_pcm_frames__weights(ma_channel_converter* pConverter, void* pFramesOut, const void* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint64 iFrame;
+    ma_uint32 iWeight;
+    ma_uint32 channelsIn;
+    ma_uint32 channelsOut;
+    const ma_uint8* pWeightChannels;
 
     MA_ASSERT(pConverter != NULL);
     MA_ASSERT(pFramesOut != NULL);
     MA_ASSERT(pFramesIn  != NULL);
 
-    /* This is the more complicated case. Each of the output channels is accumulated with 0 or more input channels. */
+    /*
+    This is the more complicated case. Each of the output channels is accumulated with 0 or more input channels. Only the
+    non-zero weights are looked at since most of the table is usually zero.
+    */
+    channelsIn      = pConverter->channelsIn;
+    channelsOut     = pConverter->channelsOut;
+    pWeightChannels = pConverter->pSparseWeightChannels;
 
     /* Clear. */
     ma_zero_memory_64(pFramesOut, frameCount * ma_get_bytes_per_frame(pConverter->format, pConverter->channelsOut));
@@ -53770,13 +59311,13 @@ static ma_result ma_channel_converter_process_pcm_frames__weights(ma_channel_con
             const ma_uint8* pFramesInU8  = (const ma_uint8*)pFramesIn;
 
             for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
-                for (iChannelIn = 0; iChannelIn < pConverter->channelsIn; ++iChannelIn) {
-                    for (iChannelOut = 0; iChannelOut < pConverter->channelsOut; ++iChannelOut) {
-                        ma_int16 u8_O = ma_pcm_sample_u8_to_s16_no_scale(pFramesOutU8[iFrame*pConverter->channelsOut + iChannelOut]);
-                        ma_int16 u8_I = ma_pcm_sample_u8_to_s16_no_scale(pFramesInU8 [iFrame*pConverter->channelsIn  + iChannelIn ]);
-                        ma_int32 s    = (ma_int32)ma_clamp(u8_O + ((u8_I * pConverter->weights.s16[iChannelIn][iChannelOut]) >> MA_CHANNEL_CONVERTER_FIXED_POINT_SHIFT), -128, 127);
-                        pFramesOutU8[iFrame*pConverter->channelsOut + iChannelOut] = ma_clip_u8((ma_int16)s);
-                    }
+                for (iWeight = 0; iWeight < pConverter->sparseWeightCount; iWeight += 1) {
+                    ma_uint32 iChannelIn  = pWeightChannels[iWeight*2 + 0];
+                    ma_uint32 iChannelOut = pWeightChannels[iWeight*2 + 1];
+                    ma_int16 u8_O = ma_pcm_sample_u8_to_s16_no_scale(pFramesOutU8[iFrame*channelsOut + iChannelOut]);
+                    ma_int16 u8_I = ma_pcm_sample_u8_to_s16_no_scale(pFramesInU8 [iFrame*channelsIn  + iChannelIn ]);
+                    ma_int32 s    = (ma_int32)ma_clamp(u8_O + ((u8_I * pConverter->sparseWeights.s16[iWeight]) >> MA_CHANNEL_CONVERTER_FIXED_POINT_SHIFT), -128, 127);
+                    pFramesOutU8[iFrame*channelsOut + iChannelOut] = ma_clip_u8((ma_int16)s);
                 }
             }
         } break;
@@ -53787,13 +59328,13 @@ static ma_result ma_channel_converter_process_pcm_frames__weights(ma_channel_con
             const ma_int16* pFramesInS16  = (const ma_int16*)pFramesIn;
 
             for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
-                for (iChannelIn = 0; iChannelIn < pConverter->channelsIn; ++iChannelIn) {
-                    for (iChannelOut = 0; iChannelOut < pConverter->channelsOut; ++iChannelOut) {
-                        ma_int32 s = pFramesOutS16[iFrame*pConverter->channelsOut + iChannelOut];
-                        s += (pFramesInS16[iFrame*pConverter->channelsIn + iChannelIn] * pConverter->weights.s16[iChannelIn][iChannelOut]) >> MA_CHANNEL_CONVERTER_FIXED_POINT_SHIFT;
+                for (iWeight = 0; iWeight < pConverter->sparseWeightCount; iWeight += 1) {
+                    ma_uint32 iChannelIn  = pWeightChannels[iWeight*2 + 0];
+                    ma_uint32 iChannelOut = pWeightChannels[iWeight*2 + 1];
+                    ma_int32 s = pFramesOutS16[iFrame*channelsOut + iChannelOut];
+                    s += (pFramesInS16[iFrame*channelsIn + iChannelIn] * pConverter->sparseWeights.s16[iWeight]) >> MA_CHANNEL_CONVERTER_FIXED_POINT_SHIFT;
 
-                        pFramesOutS16[iFrame*pConverter->channelsOut + iChannelOut] = (ma_int16)ma_clamp(s, -32768, 32767);
-                    }
+                    pFramesOutS16[iFrame*channelsOut + iChannelOut] = (ma_int16)ma_clamp(s, -32768, 32767);
                 }
             }
         } break;
@@ -53804,13 +59345,13 @@ static ma_result ma_channel_converter_process_pcm_frames__weights(ma_channel_con
             const ma_uint8* pFramesInS24  = (const ma_uint8*)pFramesIn;
 
             for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
-                for (iChannelIn = 0; iChannelIn < pConverter->channelsIn; ++iChannelIn) {
-                    for (iChannelOut = 0; iChannelOut < pConverter->channelsOut; ++iChannelOut) {
-                        ma_int64 s24_O = ma_pcm_sample_s24_to_s32_no_scale(&pFramesOutS24[(iFrame*pConverter->channelsOut + iChannelOut)*3]);
-                        ma_int64 s24_I = ma_pcm_sample_s24_to_s32_no_scale(&pFramesInS24 [(iFrame*pConverter->channelsIn  + iChannelIn )*3]);
-                        ma_int64 s24   = (ma_int32)ma_clamp(s24_O + ((s24_I * pConverter->weights.s16[iChannelIn][iChannelOut]) >> MA_CHANNEL_CONVERTER_FIXED_POINT_SHIFT), -8388608, 8388607);
-                        ma_pcm_sample_s32_to_s24_no_scale(s24, &pFramesOutS24[(iFrame*pConverter->channelsOut + iChannelOut)*3]);
-                    }
+                for (iWeight = 0; iWeight < pConverter->sparseWeightCount; iWeight += 1) {
+                    ma_uint32 iChannelIn  = pWeightChannels[iWeight*2 + 0];
+                    ma_uint32 iChannelOut = pWeightChannels[iWeight*2 + 1];
+                    ma_int64 s24_O = ma_pcm_sample_s24_to_s32_no_scale(&pFramesOutS24[(iFrame*channelsOut + iChannelOut)*3]);
+                    ma_int64 s24_I = ma_pcm_sample_s24_to_s32_no_scale(&pFramesInS24 [(iFrame*channelsIn  + iChannelIn )*3]);
+                    ma_int64 s24   = (ma_int32)ma_clamp(s24_O + ((s24_I * pConverter->sparseWeights.s16[iWeight]) >> MA_CHANNEL_CONVERTER_FIXED_POINT_SHIFT), -8388608, 8388607);
+                    ma_pcm_sample_s32_to_s24_no_scale(s24, &pFramesOutS24[(iFrame*channelsOut + iChannelOut)*3]);
                 }
             }
         } break;
@@ -53821,13 +59362,13 @@ static ma_result ma_channel_converter_process_pcm_frames__weights(ma_channel_con
             const ma_int32* pFramesInS32  = (const ma_int32*)pFramesIn;
 
             for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
-                for (iChannelIn = 0; iChannelIn < pConverter->channelsIn; ++iChannelIn) {
-                    for (iChannelOut = 0; iChannelOut < pConverter->channelsOut; ++iChannelOut) {
-                        ma_int64 s = pFramesOutS32[iFrame*pConverter->channelsOut + iChannelOut];
-                        s += ((ma_int64)pFramesInS32[iFrame*pConverter->channelsIn + iChannelIn] * pConverter->weights.s16[iChannelIn][iChannelOut]) >> MA_CHANNEL_CONVERTER_FIXED_POINT_SHIFT;
+                for (iWeight = 0; iWeight < pConverter->sparseWeightCount; iWeight += 1) {
+                    ma_uint32 iChannelIn  = pWeightChannels[iWeight*2 + 0];
+                    ma_uint32 iChannelOut = pWeightChannels[iWeight*2 + 1];
+                    ma_int64 s = pFramesOutS32[iFrame*channelsOut + iChannelOut];
+                    s += ((ma_int64)pFramesInS32[iFrame*channelsIn + iChannelIn] * pConverter->sparseWeights.s16[iWeight]) >> MA_CHANNEL_CONVERTER_FIXED_POINT_SHIFT;
 
-                        pFramesOutS32[iFrame*pConverter->channelsOut + iChannelOut] = ma_clip_s32(s);
-                    }
+                    pFramesOutS32[iFrame*channelsOut + iChannelOut] = ma_clip_s32(s);
                 }
             }
         } break;
@@ -53837,11 +59378,41 @@ static ma_result ma_channel_converter_process_pcm_frames__weights(ma_channel_con
             /* */ float* pFramesOutF32 = (      float*)pFramesOut;
             const float* pFramesInF32  = (const float*)pFramesIn;
 
-            for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
-                for (iChannelIn = 0; iChannelIn < pConverter->channelsIn; ++iChannelIn) {
-                    for (iChannelOut = 0; iChannelOut < pConverter->channelsOut; ++iChannelOut) {
-                        pFramesOutF32[iFrame*pConverter->channelsOut + iChannelOut] += pFramesInF32[iFrame*pConverter->channelsIn + iChannelIn] * pConverter->weights.f32[iChannelIn][iChannelOut];
-                    }
+            iFrame = 0;
+
+            if (channelsOut == 2) {
+            #if defined(MA_SUPPORT_SSE2)
+                if (ma_has_sse2()) {
+                    iFrame = ma_channel_converter_apply_weights_stereo_f32__sse2(pConverter, pFramesOutF32, pFramesInF32, frameCount);
+                } else
+            #elif defined(MA_SUPPORT_NEON)
+                if (ma_has_neon()) {
+                    iFrame = ma_channel_converter_apply_weights_stereo_f32__neon(pConverter, pFramesOutF32, pFramesInF32, frameCount);
+                } else
+            #endif
+                {
+                    /* Scalar only. */
+                }
+            } else if (channelsIn == 1 && channelsOut >= 4) {
+            #if defined(MA_SUPPORT_SSE2)
+                if (ma_has_sse2()) {
+                    iFrame = ma_channel_converter_apply_weights_mono_f32__sse2(pConverter, pFramesOutF32, pFramesInF32, frameCount);
+                } else
+            #elif defined(MA_SUPPORT_NEON)
+                if (ma_has_neon()) {
+                    iFrame = ma_channel_converter_apply_weights_mono_f32__neon(pConverter, pFramesOutF32, pFramesInF32, frameCount);
+                } else
+            #endif
+                {
+                    /* Scalar only. */
+                }
+            }
+
+            for (; iFrame < frameCount; iFrame += 1) {
+                for (iWeight = 0; iWeight < pConverter->sparseWeightCount; iWeight += 1) {
+                    ma_uint32 iChannelIn  = pWeightChannels[iWeight*2 + 0];
+                    ma_uint32 iChannelOut = pWeightChannels[iWeight*2 + 1];
+                    pFramesOutF32[iFrame*channelsOut + iChannelOut] += pFramesInF32[iFrame*channelsIn + iChannelIn] * pConverter->sparseWeights.f32[iWeight];
                 }
             }
         } break;
@@ -53921,6 +59492,9 @@ MA_API ma_data_converter_config ma_data_converter_config_init_default(void)
     /* Linear resampling defaults. */
     config.resampling.linear.lpfOrder = 1;
 
+    /* Polyphase resampling defaults. */
+    config.resampling.polyphase.quality = MA_DEFAULT_POLYPHASE_RESAMPLER_QUALITY;
+
     return config;
 }
 
@@ -53943,6 +59517,8 @@ typedef struct
     size_t sizeInBytes;
     size_t channelConverterOffset;
     size_t resamplerOffset;
+    size_t scratchBufferOffset;
+    size_t scratchBufferSizeInBytes;
 } ma_data_converter_heap_layout;
 
 static ma_bool32 ma_data_converter_config_is_resampler_required(const ma_data_converter_config* pConfig)
@@ -53957,15 +59533,15 @@ static ma_format ma_data_converter_config_get_mid_format(const ma_data_converter
     MA_ASSERT(pConfig != NULL);
 
     /*
-    We want to avoid as much data conversion as possible. The channel converter and linear
-    resampler both support s16 and f32 natively. We need to decide on the format to use for this
+    We want to avoid as much data conversion as possible. The channel converter and the stock
+    resamplers all support s16 and f32 natively. We need to decide on the format to use for this
     stage. We call this the mid format because it's used in the middle stage of the conversion
     pipeline. If the output format is either s16 or f32 we use that one. If that is not the case it
     will do the same thing for the input format. If it's neither we just use f32. If we are using a
     custom resampling backend, we can only guarantee that f32 will be supported so we'll be forced
     to use that if resampling is required.
     */
-    if (ma_data_converter_config_is_resampler_required(pConfig) && pConfig->resampling.algorithm != ma_resample_algorithm_linear) {
+    if (ma_data_converter_config_is_resampler_required(pConfig) && pConfig->resampling.algorithm != ma_resample_algorithm_linear && pConfig->resampling.algorithm != ma_resample_algorithm_polyphase) {
         return ma_format_f32;  /* <-- Force f32 since that is the only one we can guarantee will be supported by the resampler. */
     } else {
         /*  */ if (pConfig->formatOut == ma_format_s16 || pConfig->formatOut == ma_format_f32) {
@@ -54007,6 +59583,7 @@ static ma_resampler_config ma_resampler_config_init_from_data_converter_config(c
 
     resamplerConfig = ma_resampler_config_init(ma_data_converter_config_get_mid_format(pConfig), resamplerChannels, pConfig->sampleRateIn, pConfig->sampleRateOut, pConfig->resampling.algorithm);
     resamplerConfig.linear           = pConfig->resampling.linear;
+    resamplerConfig.polyphase        = pConfig->resampling.polyphase;
     resamplerConfig.pBackendVTable   = pConfig->resampling.pBackendVTable;
     resamplerConfig.pBackendUserData = pConfig->resampling.pBackendUserData;
 
@@ -54059,6 +59636,18 @@ static ma_result ma_data_converter_get_heap_layout(const ma_data_converter_confi
         pHeapLayout->sizeInBytes += heapSizeInBytes;
     }
 
+    /*
+    Scratch buffers. Every intermediary stage is in the mid format, and the widest stage has the
+    larger of the input and output channel counts. Three buffers are needed for the paths that do
+    both format conversion and resampling.
+    */
+    pHeapLayout->sizeInBytes = ma_align(pHeapLayout->sizeInBytes, MA_SIMD_ALIGNMENT);
+    pHeapLayout->scratchBufferOffset = pHeapLayout->sizeInBytes;
+    if (pConfig->scratchBufferSizeInFrames > 0) {
+        pHeapLayout->scratchBufferSizeInBytes = ma_align((size_t)pConfig->scratchBufferSizeInFrames * ma_get_bytes_per_frame(ma_data_converter_config_get_mid_format(pConfig), ma_max(pConfig->channelsIn, pConfig->channelsOut)), MA_SIMD_ALIGNMENT);
+        pHeapLayout->sizeInBytes += pHeapLayout->scratchBufferSizeInBytes * 3;
+    }
+
     /* Make sure allocation size is aligned. */
     pHeapLayout->sizeInBytes = ma_align_64(pHeapLayout->sizeInBytes);
 
@@ -54115,6 +59704,11 @@ MA_API ma_result ma_data_converter_init_preallocated(const ma_data_converter_con
     pConverter->sampleRateOut = pConfig->sampleRateOut;
     pConverter->ditherMode    = pConfig->ditherMode;
 
+    if (heapLayout.scratchBufferSizeInBytes > 0) {
+        pConverter->pScratchBuffer           = ma_offset_ptr(pHeap, heapLayout.scratchBufferOffset);
+        pConverter->scratchBufferSizeInBytes = heapLayout.scratchBufferSizeInBytes;
+    }
+
     /*
     Determine if resampling is required. We need to do this so we can determine an appropriate
     mid format to use. If resampling is required, the mid format must be ma_format_f32 since
@@ -54216,6 +59810,19 @@ MA_API ma_result ma_data_converter_init_preallocated(const ma_data_converter_con
         }
     }
 
+    /*
+    The most common conversion is decoded s16 going to an f32 device at a different rate, usually with
+    a mono source going to a stereo device. This would otherwise take three passes through temporary
+    buffers so it gets its own path which does it all in one. It shares its state with the normal
+    resampler so nothing else needs to know about it.
+    */
+    if (pConverter->hasResampler && pConfig->resampling.algorithm == ma_resample_algorithm_linear && pConverter->formatIn == ma_format_s16 && pConverter->formatOut == ma_format_f32) {
+        if ((pConverter->channelsIn <= 2 && pConverter->hasChannelConverter == MA_FALSE) ||
+            (pConverter->channelsIn == 1 && pConverter->channelsOut == 2 && pConverter->channelConverter.conversionPath == ma_channel_conversion_path_mono_in)) {
+            pConverter->executionPath = ma_data_converter_execution_path_s16_to_f32_fused;
+        }
+    }
+
     return MA_SUCCESS;
 }
 
@@ -54266,6 +59873,22 @@ MA_API void ma_data_converter_uninit(ma_data_converter* pConverter, const ma_all
     }
 }
 
+static void* ma_data_converter_get_temp_buffer(ma_data_converter* pConverter, ma_uint32 index, void* pStackBuffer, size_t* pSizeInBytes)
+{
+    MA_ASSERT(pConverter   != NULL);
+    MA_ASSERT(pStackBuffer != NULL);
+    MA_ASSERT(index < 3);
+
+    /* Use the heap when it has been configured. Otherwise fall back to the caller's stack buffer. */
+    if (pConverter->pScratchBuffer != NULL) {
+        *pSizeInBytes = pConverter->scratchBufferSizeInBytes;
+        return ma_offset_ptr(pConverter->pScratchBuffer, index * pConverter->scratchBufferSizeInBytes);
+    } else {
+        *pSizeInBytes = MA_DATA_CONVERTER_STACK_BUFFER_SIZE;
+        return pStackBuffer;
+    }
+}
+
 static ma_result ma_data_converter_process_pcm_frames__passthrough(ma_data_converter* pConverter, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
 {
     ma_uint64 frameCountIn;
@@ -54288,7 +59911,9 @@ static ma_result ma_data_converter_process_pcm_frames__passthrough(ma_data_conve
 
     if (pFramesOut != NULL) {
         if (pFramesIn != NULL) {
-            ma_copy_memory_64(pFramesOut, pFramesIn, frameCount * ma_get_bytes_per_frame(pConverter->formatOut, pConverter->channelsOut));
+            if (pFramesOut != pFramesIn) {
+                ma_copy_memory_64(pFramesOut, pFramesIn, frameCount * ma_get_bytes_per_frame(pConverter->formatOut, pConverter->channelsOut));
+            }
         } else {
             ma_zero_memory_64(pFramesOut,            frameCount * ma_get_bytes_per_frame(pConverter->formatOut, pConverter->channelsOut));
         }
@@ -54326,7 +59951,34 @@ static ma_result ma_data_converter_process_pcm_frames__format_only(ma_data_conve
 
     if (pFramesOut != NULL) {
         if (pFramesIn != NULL) {
-            ma_convert_pcm_frames_format(pFramesOut, pConverter->formatOut, pFramesIn, pConverter->formatIn, frameCount, pConverter->channelsIn, pConverter->ditherMode);
+            if (pFramesOut == pFramesIn && ma_get_bytes_per_sample(pConverter->formatOut) > ma_get_bytes_per_sample(pConverter->formatIn)) {
+                /*
+                In-place conversion to a wider format. Converting front to back would overwrite input
+                samples before they've been read, so instead go back to front a block at a time via a
+                temporary buffer. Each block's output only overlaps with input that's already been
+                consumed.
+                */
+                ma_uint8 pStackBuffer[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+                size_t tempBufferSizeInBytes;
+                void* pTempBuffer = ma_data_converter_get_temp_buffer(pConverter, 0, pStackBuffer, &tempBufferSizeInBytes);
+                ma_uint32 bpfIn  = ma_get_bytes_per_frame(pConverter->formatIn,  pConverter->channelsIn);
+                ma_uint32 bpfOut = ma_get_bytes_per_frame(pConverter->formatOut, pConverter->channelsOut);
+                ma_uint64 tempBufferCap = tempBufferSizeInBytes / bpfOut;
+                ma_uint64 framesRemaining = frameCount;
+
+                while (framesRemaining > 0) {
+                    ma_uint64 framesToProcessNow = ma_min(framesRemaining, tempBufferCap);
+                    ma_uint64 firstFrame = framesRemaining - framesToProcessNow;
+
+                    ma_convert_pcm_frames_format(pTempBuffer, pConverter->formatOut, ma_offset_ptr(pFramesIn, firstFrame * bpfIn), pConverter->formatIn, framesToProcessNow, pConverter->channelsIn, pConverter->ditherMode);
+                    MA_COPY_MEMORY(ma_offset_ptr(pFramesOut, firstFrame * bpfOut), pTempBuffer, (size_t)(framesToProcessNow * bpfOut));
+
+                    framesRemaining = firstFrame;
+                }
+            } else {
+                /* Narrowing or same-width conversions are safe to do in place because each sample is read before it is overwritten. */
+                ma_convert_pcm_frames_format(pFramesOut, pConverter->formatOut, pFramesIn, pConverter->formatIn, frameCount, pConverter->channelsIn, pConverter->ditherMode);
+            }
         } else {
             ma_zero_memory_64(pFramesOut, frameCount * ma_get_bytes_per_frame(pConverter->formatOut, pConverter->channelsOut));
         }
@@ -54367,8 +60019,10 @@ static ma_result ma_data_converter_process_pcm_frames__resample_with_format_conv
     framesProcessedOut = 0;
 
     while (framesProcessedOut < frameCountOut) {
-        ma_uint8 pTempBufferOut[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
-        const ma_uint32 tempBufferOutCap = sizeof(pTempBufferOut) / ma_get_bytes_per_frame(pConverter->resampler.format, pConverter->resampler.channels);
+        ma_uint8 pStackBufferOut[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+        size_t tempBufferOutSizeInBytes;
+        void* pTempBufferOut = ma_data_converter_get_temp_buffer(pConverter, 2, pStackBufferOut, &tempBufferOutSizeInBytes);
+        const ma_uint32 tempBufferOutCap = (ma_uint32)(tempBufferOutSizeInBytes / ma_get_bytes_per_frame(pConverter->resampler.format, pConverter->resampler.channels));
         const void* pFramesInThisIteration;
         /* */ void* pFramesOutThisIteration;
         ma_uint64 frameCountInThisIteration;
@@ -54388,8 +60042,10 @@ static ma_result ma_data_converter_process_pcm_frames__resample_with_format_conv
 
         /* Do a pre format conversion if necessary. */
         if (pConverter->hasPreFormatConversion) {
-            ma_uint8 pTempBufferIn[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
-            const ma_uint32 tempBufferInCap = sizeof(pTempBufferIn) / ma_get_bytes_per_frame(pConverter->resampler.format, pConverter->resampler.channels);
+            ma_uint8 pStackBufferIn[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+            size_t tempBufferInSizeInBytes;
+            void* pTempBufferIn = ma_data_converter_get_temp_buffer(pConverter, 0, pStackBufferIn, &tempBufferInSizeInBytes);
+            const ma_uint32 tempBufferInCap = (ma_uint32)(tempBufferInSizeInBytes / ma_get_bytes_per_frame(pConverter->resampler.format, pConverter->resampler.channels));
 
             frameCountInThisIteration  = (frameCountIn - framesProcessedIn);
             if (frameCountInThisIteration > tempBufferInCap) {
@@ -54405,7 +60061,7 @@ static ma_result ma_data_converter_process_pcm_frames__resample_with_format_conv
             if (pFramesInThisIteration != NULL) {
                 ma_convert_pcm_frames_format(pTempBufferIn, pConverter->resampler.format, pFramesInThisIteration, pConverter->formatIn, frameCountInThisIteration, pConverter->channelsIn, pConverter->ditherMode);
             } else {
-                MA_ZERO_MEMORY(pTempBufferIn, sizeof(pTempBufferIn));
+                MA_ZERO_MEMORY(pTempBufferIn, tempBufferInSizeInBytes);
             }
 
             frameCountOutThisIteration = (frameCountOut - framesProcessedOut);
@@ -54514,8 +60170,10 @@ static ma_result ma_data_converter_process_pcm_frames__channels_only(ma_data_con
         ma_uint64 framesProcessed = 0;
 
         while (framesProcessed < frameCount) {
-            ma_uint8 pTempBufferOut[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
-            const ma_uint32 tempBufferOutCap = sizeof(pTempBufferOut) / ma_get_bytes_per_frame(pConverter->channelConverter.format, pConverter->channelConverter.channelsOut);
+            ma_uint8 pStackBufferOut[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+            size_t tempBufferOutSizeInBytes;
+            void* pTempBufferOut = ma_data_converter_get_temp_buffer(pConverter, 2, pStackBufferOut, &tempBufferOutSizeInBytes);
+            const ma_uint32 tempBufferOutCap = (ma_uint32)(tempBufferOutSizeInBytes / ma_get_bytes_per_frame(pConverter->channelConverter.format, pConverter->channelConverter.channelsOut));
             const void* pFramesInThisIteration;
             /* */ void* pFramesOutThisIteration;
             ma_uint64 frameCountThisIteration;
@@ -54534,8 +60192,10 @@ static ma_result ma_data_converter_process_pcm_frames__channels_only(ma_data_con
 
             /* Do a pre format conversion if necessary. */
             if (pConverter->hasPreFormatConversion) {
-                ma_uint8 pTempBufferIn[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
-                const ma_uint32 tempBufferInCap = sizeof(pTempBufferIn) / ma_get_bytes_per_frame(pConverter->channelConverter.format, pConverter->channelConverter.channelsIn);
+                ma_uint8 pStackBufferIn[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+                size_t tempBufferInSizeInBytes;
+                void* pTempBufferIn = ma_data_converter_get_temp_buffer(pConverter, 0, pStackBufferIn, &tempBufferInSizeInBytes);
+                const ma_uint32 tempBufferInCap = (ma_uint32)(tempBufferInSizeInBytes / ma_get_bytes_per_frame(pConverter->channelConverter.format, pConverter->channelConverter.channelsIn));
 
                 frameCountThisIteration = (frameCount - framesProcessed);
                 if (frameCountThisIteration > tempBufferInCap) {
@@ -54551,7 +60211,7 @@ static ma_result ma_data_converter_process_pcm_frames__channels_only(ma_data_con
                 if (pFramesInThisIteration != NULL) {
                     ma_convert_pcm_frames_format(pTempBufferIn, pConverter->channelConverter.format, pFramesInThisIteration, pConverter->formatIn, frameCountThisIteration, pConverter->channelsIn, pConverter->ditherMode);
                 } else {
-                    MA_ZERO_MEMORY(pTempBufferIn, sizeof(pTempBufferIn));
+                    MA_ZERO_MEMORY(pTempBufferIn, tempBufferInSizeInBytes);
                 }
 
                 if (pConverter->hasPostFormatConversion) {
@@ -54608,11 +60268,17 @@ static ma_result ma_data_converter_process_pcm_frames__resample_first(ma_data_co
     ma_uint64 frameCountOut;
     ma_uint64 framesProcessedIn;
     ma_uint64 framesProcessedOut;
-    ma_uint8  pTempBufferIn[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];   /* In resampler format. */
+    ma_uint8  pStackBufferIn[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+    ma_uint8  pStackBufferMid[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+    ma_uint8  pStackBufferOut[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+    void*     pTempBufferIn;    /* In resampler format. */
+    size_t    tempBufferInSizeInBytes;
     ma_uint64 tempBufferInCap;
-    ma_uint8  pTempBufferMid[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];  /* In resampler format, channel converter input format. */
+    void*     pTempBufferMid;   /* In resampler format, channel converter input format. */
+    size_t    tempBufferMidSizeInBytes;
     ma_uint64 tempBufferMidCap;
-    ma_uint8  pTempBufferOut[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];  /* In channel converter output format. */
+    void*     pTempBufferOut;   /* In channel converter output format. */
+    size_t    tempBufferOutSizeInBytes;
     ma_uint64 tempBufferOutCap;
 
     MA_ASSERT(pConverter != NULL);
@@ -54633,9 +60299,13 @@ static ma_result ma_data_converter_process_pcm_frames__resample_first(ma_data_co
     framesProcessedIn  = 0;
     framesProcessedOut = 0;
 
-    tempBufferInCap  = sizeof(pTempBufferIn)  / ma_get_bytes_per_frame(pConverter->resampler.format, pConverter->resampler.channels);
-    tempBufferMidCap = sizeof(pTempBufferIn)  / ma_get_bytes_per_frame(pConverter->resampler.format, pConverter->resampler.channels);
-    tempBufferOutCap = sizeof(pTempBufferOut) / ma_get_bytes_per_frame(pConverter->channelConverter.format, pConverter->channelConverter.channelsOut);
+    pTempBufferIn  = ma_data_converter_get_temp_buffer(pConverter, 0, pStackBufferIn,  &tempBufferInSizeInBytes);
+    pTempBufferMid = ma_data_converter_get_temp_buffer(pConverter, 1, pStackBufferMid, &tempBufferMidSizeInBytes);
+    pTempBufferOut = ma_data_converter_get_temp_buffer(pConverter, 2, pStackBufferOut, &tempBufferOutSizeInBytes);
+
+    tempBufferInCap  = tempBufferInSizeInBytes  / ma_get_bytes_per_frame(pConverter->resampler.format, pConverter->resampler.channels);
+    tempBufferMidCap = tempBufferMidSizeInBytes / ma_get_bytes_per_frame(pConverter->resampler.format, pConverter->resampler.channels);
+    tempBufferOutCap = tempBufferOutSizeInBytes / ma_get_bytes_per_frame(pConverter->channelConverter.format, pConverter->channelConverter.channelsOut);
 
     while (framesProcessedOut < frameCountOut) {
         ma_uint64 frameCountInThisIteration;
@@ -54764,11 +60434,17 @@ static ma_result ma_data_converter_process_pcm_frames__channels_first(ma_data_co
     ma_uint64 frameCountOut;
     ma_uint64 framesProcessedIn;
     ma_uint64 framesProcessedOut;
-    ma_uint8  pTempBufferIn[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];   /* In resampler format. */
+    ma_uint8  pStackBufferIn[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+    ma_uint8  pStackBufferMid[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+    ma_uint8  pStackBufferOut[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
+    void*     pTempBufferIn;    /* In resampler format. */
+    size_t    tempBufferInSizeInBytes;
     ma_uint64 tempBufferInCap;
-    ma_uint8  pTempBufferMid[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];  /* In resampler format, channel converter input format. */
+    void*     pTempBufferMid;   /* In resampler format, channel converter input format. */
+    size_t    tempBufferMidSizeInBytes;
     ma_uint64 tempBufferMidCap;
-    ma_uint8  pTempBufferOut[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];  /* In channel converter output format. */
+    void*     pTempBufferOut;   /* In channel converter output format. */
+    size_t    tempBufferOutSizeInBytes;
     ma_uint64 tempBufferOutCap;
 
     MA_ASSERT(pConverter != NULL);
@@ -54789,9 +60465,13 @@ static ma_result ma_data_converter_process_pcm_frames__channels_first(ma_data_co
     framesProcessedIn  = 0;
     framesProcessedOut = 0;
 
-    tempBufferInCap  = sizeof(pTempBufferIn)  / ma_get_bytes_per_frame(pConverter->channelConverter.format, pConverter->channelConverter.channelsIn);
-    tempBufferMidCap = sizeof(pTempBufferIn)  / ma_get_bytes_per_frame(pConverter->channelConverter.format, pConverter->channelConverter.channelsOut);
-    tempBufferOutCap = sizeof(pTempBufferOut) / ma_get_bytes_per_frame(pConverter->resampler.format, pConverter->resampler.channels);
+    pTempBufferIn  = ma_data_converter_get_temp_buffer(pConverter, 0, pStackBufferIn,  &tempBufferInSizeInBytes);
+    pTempBufferMid = ma_data_converter_get_temp_buffer(pConverter, 1, pStackBufferMid, &tempBufferMidSizeInBytes);
+    pTempBufferOut = ma_data_converter_get_temp_buffer(pConverter, 2, pStackBufferOut, &tempBufferOutSizeInBytes);
+
+    tempBufferInCap  = tempBufferInSizeInBytes  / ma_get_bytes_per_frame(pConverter->channelConverter.format, pConverter->channelConverter.channelsIn);
+    tempBufferMidCap = tempBufferMidSizeInBytes / ma_get_bytes_per_frame(pConverter->channelConverter.format, pConverter->channelConverter.channelsOut);
+    tempBufferOutCap = tempBufferOutSizeInBytes / ma_get_bytes_per_frame(pConverter->resampler.format, pConverter->resampler.channels);
 
     while (framesProcessedOut < frameCountOut) {
         ma_uint64 frameCountInThisIteration;
@@ -54921,6 +60601,177 @@ static ma_result ma_data_converter_process_pcm_frames__channels_first(ma_data_co
     return MA_SUCCESS;
 }
 
+#define MA_DATA_CONVERTER_FUSED_BATCH_SIZE  128
+
+static ma_result ma_data_converter_process_pcm_frames__s16_to_f32_fused(ma_data_converter* pConverter, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+{
+    ma_linear_resampler* pResampler;
+    ma_uint64 frameCountIn;
+    ma_uint64 frameCountOut;
+    ma_uint64 framesProcessedIn;
+    ma_uint64 framesProcessedOut;
+    ma_uint32 channelsIn;
+    ma_uint32 channelsOut;
+    ma_uint32 sampleRateOut;
+    ma_bool32 isFiltering;
+    ma_bool32 isDownsampling;
+    float pFramesInF32[(MA_DATA_CONVERTER_FUSED_BATCH_SIZE*2 + 2) * 2];  /* The two cached frames followed by up to two input frames per output frame. */
+    float pFramesMidF32[MA_DATA_CONVERTER_FUSED_BATCH_SIZE * 2];
+    size_t indices[MA_DATA_CONVERTER_FUSED_BATCH_SIZE];
+    float alphas[MA_DATA_CONVERTER_FUSED_BATCH_SIZE];
+
+    MA_ASSERT(pConverter != NULL);
+    MA_ASSERT(pConverter->resampler.format == ma_format_f32);
+    MA_ASSERT(pConverter->channelsIn <= 2 && pConverter->channelsOut <= 2);
+
+    /*
+    This produces exactly the same output as the separate format conversion, resampling and channel
+    conversion steps, but instead of each step making a pass over a 4KB buffer, each batch of output
+    frames is done start to finish while the data is still in the cache. The positions and weights
+    of a batch are worked out first so we know exactly how many input frames to convert. Those are
+    converted into a small buffer after the two frames cached by the resampler, and from there the
+    same code as the resampler's batched path is used for interpolation.
+    */
+    pResampler     = &pConverter->resampler.state.linear;
+    channelsIn     = pConverter->channelsIn;
+    channelsOut    = pConverter->channelsOut;
+    sampleRateOut  = pResampler->config.sampleRateOut;
+    isFiltering    = pResampler->config.sampleRateIn != sampleRateOut && (pResampler->lpf.lpf1Count + pResampler->lpf.lpf2Count) > 0;
+    isDownsampling = pResampler->config.sampleRateIn > sampleRateOut;
+
+    frameCountIn = 0;
+    if (pFrameCountIn != NULL) {
+        frameCountIn = *pFrameCountIn;
+    }
+
+    frameCountOut = 0;
+    if (pFrameCountOut != NULL) {
+        frameCountOut = *pFrameCountOut;
+    }
+
+    framesProcessedIn  = 0;
+    framesProcessedOut = 0;
+
+    while (framesProcessedOut < frameCountOut) {
+        ma_uint64 frameCountInThisIteration = ma_min(frameCountIn - framesProcessedIn, MA_DATA_CONVERTER_FUSED_BATCH_SIZE*2);
+        ma_uint32 framesConsumed = 0;
+        ma_uint32 batchCount = 0;
+        ma_bool32 isOutOfInput = MA_FALSE;
+
+        /* Plan the batch. Index i of the batch interpolates between frames indices[i] and indices[i]+1 of pFramesInF32. */
+        while (batchCount < MA_DATA_CONVERTER_FUSED_BATCH_SIZE && framesProcessedOut + batchCount < frameCountOut) {
+            if (framesConsumed + pResampler->inTimeInt > frameCountInThisIteration) {
+                isOutOfInput = MA_TRUE;
+                break;
+            }
+
+            framesConsumed += pResampler->inTimeInt;
+            pResampler->inTimeInt = 0;
+
+            indices[batchCount] = framesConsumed;
+            if (pResampler->isFixedRatio) {
+                alphas[batchCount] = pResampler->pPhases[pResampler->inTimeFrac].alpha.f32;
+            } else {
+                alphas[batchCount] = (float)pResampler->inTimeFrac / sampleRateOut;
+            }
+            batchCount += 1;
+
+            /* Advance time forward. */
+            pResampler->inTimeInt  += pResampler->inAdvanceInt;
+            pResampler->inTimeFrac += pResampler->inAdvanceFrac;
+            if (pResampler->inTimeFrac >= sampleRateOut) {
+                pResampler->inTimeFrac -= sampleRateOut;
+                pResampler->inTimeInt  += 1;
+            }
+        }
+
+        /* If we ran out of input, whatever is left is loaded now so it's cached for the next output frame. */
+        if (isOutOfInput) {
+            pResampler->inTimeInt -= (ma_uint32)(frameCountInThisIteration - framesConsumed);
+            framesConsumed = (ma_uint32)frameCountInThisIteration;
+        }
+
+        /* Format conversion, with the downsampling filter run on input frames as they're loaded. */
+        MA_COPY_MEMORY(pFramesInF32 + 0,          pResampler->x0.f32, sizeof(float) * channelsIn);
+        MA_COPY_MEMORY(pFramesInF32 + channelsIn, pResampler->x1.f32, sizeof(float) * channelsIn);
+
+        if (pFramesIn != NULL) {
+            ma_pcm_s16_to_f32(pFramesInF32 + (2 * channelsIn), (const ma_int16*)pFramesIn + (framesProcessedIn * channelsIn), framesConsumed * channelsIn, ma_dither_mode_none);
+        } else {
+            MA_ZERO_MEMORY(pFramesInF32 + (2 * channelsIn), framesConsumed * channelsIn * sizeof(float));
+        }
+
+        if (isFiltering && isDownsampling) {
+            ma_lpf_process_pcm_frames(&pResampler->lpf, pFramesInF32 + (2 * channelsIn), pFramesInF32 + (2 * channelsIn), framesConsumed);
+        }
+
+        /* The last two frames are cached for next time. */
+        MA_COPY_MEMORY(pResampler->x0.f32, pFramesInF32 + (framesConsumed + 0) * channelsIn, sizeof(float) * channelsIn);
+        MA_COPY_MEMORY(pResampler->x1.f32, pFramesInF32 + (framesConsumed + 1) * channelsIn, sizeof(float) * channelsIn);
+
+        /* Interpolation, then the upsampling filter and channel conversion. */
+        if (pFramesOut != NULL && batchCount > 0) {
+            float* pRunningFramesOut = (float*)pFramesOut + (framesProcessedOut * channelsOut);
+
+            if (channelsIn == channelsOut && !(isFiltering && !isDownsampling)) {
+                ma_linear_resampler_interpolate_frames_f32(pFramesInF32, channelsIn, indices, alphas, batchCount, pRunningFramesOut);
+            } else {
+                ma_linear_resampler_interpolate_frames_f32(pFramesInF32, channelsIn, indices, alphas, batchCount, pFramesMidF32);
+
+                if (isFiltering && !isDownsampling) {
+                    ma_lpf_process_pcm_frames(&pResampler->lpf, pFramesMidF32, pFramesMidF32, batchCount);
+                }
+
+                if (channelsIn == channelsOut) {
+                    MA_COPY_MEMORY(pRunningFramesOut, pFramesMidF32, batchCount * channelsIn * sizeof(float));
+                } else {
+                    ma_uint32 iFrame = 0;
+
+                #if defined(MA_SUPPORT_SSE2)
+                    if (ma_has_sse2()) {
+                        for (; iFrame + 4 <= batchCount; iFrame += 4) {
+                            __m128 x = _mm_loadu_ps(pFramesMidF32 + iFrame);
+                            _mm_storeu_ps(pRunningFramesOut + iFrame*2 + 0, _mm_unpacklo_ps(x, x));
+                            _mm_storeu_ps(pRunningFramesOut + iFrame*2 + 4, _mm_unpackhi_ps(x, x));
+                        }
+                    }
+                #elif defined(MA_SUPPORT_NEON)
+                    if (ma_has_neon()) {
+                        for (; iFrame + 4 <= batchCount; iFrame += 4) {
+                            float32x4x2_t x;
+                            x.val[0] = vld1q_f32(pFramesMidF32 + iFrame);
+                            x.val[1] = x.val[0];
+                            vst2q_f32(pRunningFramesOut + iFrame*2, x);
+                        }
+                    }
+                #endif
+
+                    for (; iFrame < batchCount; iFrame += 1) {
+                        pRunningFramesOut[iFrame*2 + 0] = pFramesMidF32[iFrame];
+                        pRunningFramesOut[iFrame*2 + 1] = pFramesMidF32[iFrame];
+                    }
+                }
+            }
+        }
+
+        framesProcessedIn  += framesConsumed;
+        framesProcessedOut += batchCount;
+
+        if (batchCount == 0 && framesConsumed == 0) {
+            break;  /* Consumed all of our input data. */
+        }
+    }
+
+    if (pFrameCountIn != NULL) {
+        *pFrameCountIn = framesProcessedIn;
+    }
+    if (pFrameCountOut != NULL) {
+        *pFrameCountOut = framesProcessedOut;
+    }
+
+    return MA_SUCCESS;
+}
+
 MA_API ma_result ma_data_converter_process_pcm_frames(ma_data_converter* pConverter, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
 {
     if (pConverter == NULL) {
@@ -54935,6 +60786,7 @@ MA_API ma_result ma_data_converter_process_pcm_frames(ma_data_converter* pConver
         case ma_data_converter_execution_path_resample_only:  return ma_data_converter_process_pcm_frames__resample_only(pConverter, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
         case ma_data_converter_execution_path_resample_first: return ma_data_converter_process_pcm_frames__resample_first(pConverter, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
         case ma_data_converter_execution_path_channels_first: return ma_data_converter_process_pcm_frames__channels_first(pConverter, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+        case ma_data_converter_execution_path_s16_to_f32_fused: return ma_data_converter_process_pcm_frames__s16_to_f32_fused(pConverter, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
         default: return MA_INVALID_OPERATION;   /* Should never hit this. */
     }
 }
@@ -71080,8 +76932,24 @@ static ma_result ma_job_process__resource_manager__seek_data_stream(ma_job* pJob
 #define MA_DEFAULT_NODE_CACHE_CAP_IN_FRAMES_PER_BUS 480
 #endif
 
+/*
+The maximum number of attachments on an input bus that will be read before being mixed into the
+output in a single pass. Each one needs a temp buffer of MA_DATA_CONVERTER_STACK_BUFFER_SIZE bytes
+on the stack of the audio thread. Set this to 1 to mix each attachment as soon as it's been read.
+*/
+#ifndef MA_NODE_INPUT_BUS_MIX_BATCH_SIZE
+#define MA_NODE_INPUT_BUS_MIX_BATCH_SIZE    4
+#endif
 
-static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusIndex, float* pFramesOut, ma_uint32 frameCount, ma_uint32* pFramesRead, ma_uint64 globalTime);
+
+static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusIndex, float* pFramesOut, ma_uint32 planarStride, ma_uint32 frameCount, ma_uint32* pFramesRead, ma_uint64 globalTime);
+static ma_bool32 ma_node_output_bus_is_silent(const ma_node_output_bus* pOutputBus);
+static void ma_node_graph_render_plan_free(ma_node_graph_render_plan* pPlan, const ma_allocation_callbacks* pAllocationCallbacks);
+static void ma_node_graph_update_render_plan(ma_node_graph* pNodeGraph);
+static ma_uint32 ma_node_graph_render_plan_enter(ma_node_graph* pNodeGraph);
+static void ma_node_graph_render_plan_leave(ma_node_graph* pNodeGraph, ma_uint32 epoch);
+static ma_bool32 ma_node_graph_render_plan_prepare(ma_node_graph_render_plan* pPlan, ma_uint32 frameCount, ma_uint64 globalTime);
+static void ma_node_graph_render_plan_execute(ma_node_graph* pNodeGraph, ma_node_graph_render_plan* pPlan, ma_uint32 frameCount, ma_uint64 globalTime);
 
 MA_API void ma_debug_fill_pcm_frames_with_sine_wave(float* pFramesOut, ma_uint32 frameCount, ma_format format, ma_uint32 channels, ma_uint32 sampleRate)
 {
@@ -71121,6 +76989,11 @@ MA_API ma_node_graph_config ma_node_graph_config_init(ma_uint32 channels)
     MA_ZERO_OBJECT(&config);
     config.channels             = channels;
     config.nodeCacheCapInFrames = MA_DEFAULT_NODE_CACHE_CAP_IN_FRAMES_PER_BUS;
+    config.jobThreadCount       = 0;    /* Single threaded by default. */
+    config.jobCapacity          = MA_DEFAULT_NODE_GRAPH_JOB_CAPACITY;
+#ifndef MA_NO_THREADING
+    config.jobThreadPriority    = ma_thread_priority_highest;
+#endif
 
     return config;
 }
@@ -71141,6 +77014,327 @@ static ma_bool32 ma_node_graph_is_reading(ma_node_graph* pNodeGraph)
 #endif
 
 
+static ma_bool32 ma_node_graph_is_multi_threaded(const ma_node_graph* pNodeGraph)
+{
+    MA_ASSERT(pNodeGraph != NULL);
+
+    #ifndef MA_NO_THREADING
+    {
+        return pNodeGraph->jobThreadCount > 0;
+    }
+    #else
+    {
+        (void)pNodeGraph;
+        return MA_FALSE;
+    }
+    #endif
+}
+
+#ifndef MA_NO_THREADING
+static void ma_node_graph_process_jobs(ma_node_graph* pNodeGraph)
+{
+    ma_uint32 channels;
+
+    MA_ASSERT(pNodeGraph != NULL);
+
+    channels = ma_node_get_input_channels(&pNodeGraph->endpoint, 0);
+
+    /*
+    Jobs are claimed by incrementing the lower 16 bits of jobRange. Since the job count lives in the
+    same variable, a thread that turns up late and sees the range of a previous round will always
+    find that every job has already been claimed. It can never claim a job from the next round with
+    a stale count.
+    */
+    for (;;) {
+        ma_uint32 jobRange = ma_atomic_load_32(&pNodeGraph->jobRange);
+        ma_uint32 jobCount = jobRange >> 16;
+        ma_uint32 iJob     = jobRange & 0xFFFF;
+        ma_node_graph_job* pJob;
+        ma_uint32 framesProcessed = 0;
+
+        if (iJob >= jobCount) {
+            break;  /* Nothing left to claim. */
+        }
+
+        if (ma_atomic_compare_and_swap_32(&pNodeGraph->jobRange, jobRange, jobRange + 1) != jobRange) {
+            continue;   /* Someone else claimed it. Try the next one. */
+        }
+
+        pJob = &pNodeGraph->pJobs[iJob];
+        pJob->isSilent = MA_TRUE;
+
+        while (framesProcessed < pNodeGraph->jobFrameCount) {
+            ma_result result;
+            ma_uint32 framesJustRead;
+
+            result = ma_node_read_pcm_frames(pJob->pOutputBus->pNode, pJob->pOutputBus->outputBusIndex, ma_offset_pcm_frames_ptr_f32(pJob->pFrames, framesProcessed, channels), 0, pNodeGraph->jobFrameCount - framesProcessed, &framesJustRead, pNodeGraph->jobGlobalTime + framesProcessed);
+            if (result != MA_SUCCESS && result != MA_AT_END) {
+                break;
+            }
+
+            if (ma_node_output_bus_is_silent(pJob->pOutputBus) == MA_FALSE) {
+                pJob->isSilent = MA_FALSE;
+            }
+
+            framesProcessed += framesJustRead;
+
+            if (result != MA_SUCCESS || framesJustRead == 0) {
+                break;
+            }
+        }
+
+        /* Anything we didn't read needs to be silenced so it doesn't contribute to the mix. */
+        if (framesProcessed < pNodeGraph->jobFrameCount) {
+            ma_silence_pcm_frames(ma_offset_pcm_frames_ptr_f32(pJob->pFrames, framesProcessed, channels), (pNodeGraph->jobFrameCount - framesProcessed), ma_format_f32, channels);
+        }
+
+        ma_atomic_fetch_add_32(&pNodeGraph->jobsCompleted, 1);
+    }
+}
+
+static ma_bool32 ma_node_graph_job_thread_has_work(ma_node_graph* pNodeGraph)
+{
+    ma_uint32 jobRange = ma_atomic_load_32(&pNodeGraph->jobRange);
+    return (jobRange & 0xFFFF) < (jobRange >> 16) || ma_atomic_load_32(&pNodeGraph->isJobThreadShuttingDown);
+}
+
+/*
+Worker threads park on a futex on Linux and a Mach semaphore on Apple platforms, neither of which take
+a lock to wake a thread. This is also true of ma_semaphore on Windows. Everywhere else ma_semaphore is
+built on a mutex and condition variable.
+*/
+static ma_result ma_node_graph_init_job_parking(ma_node_graph* pNodeGraph)
+{
+#if defined(MA_HAS_FUTEX)
+    (void)pNodeGraph;
+    return MA_SUCCESS;  /* The futex word is jobSignal so there's nothing to initialize. */
+#elif defined(MA_HAS_MACH_SEMAPHORE)
+    semaphore_t semaphore;
+
+    if (semaphore_create(mach_task_self(), &semaphore, SYNC_POLICY_FIFO, 0) != KERN_SUCCESS) {
+        return MA_ERROR;
+    }
+
+    pNodeGraph->jobMachSemaphore = (ma_uint32)semaphore;
+    return MA_SUCCESS;
+#else
+    return ma_semaphore_init(0, &pNodeGraph->jobSemaphore);
+#endif
+}
+
+static void ma_node_graph_uninit_job_parking(ma_node_graph* pNodeGraph)
+{
+#if defined(MA_HAS_FUTEX)
+    (void)pNodeGraph;
+#elif defined(MA_HAS_MACH_SEMAPHORE)
+    semaphore_destroy(mach_task_self(), (semaphore_t)pNodeGraph->jobMachSemaphore);
+#else
+    ma_semaphore_uninit(&pNodeGraph->jobSemaphore);
+#endif
+}
+
+static void ma_node_graph_wait_for_job_signal(ma_node_graph* pNodeGraph, ma_uint32 signal)
+{
+#if defined(MA_HAS_FUTEX)
+    /* Returns straight away if the signal has been incremented since it was loaded. */
+    syscall(SYS_futex, &pNodeGraph->jobSignal, FUTEX_WAIT_PRIVATE, signal, NULL, NULL, 0);
+#elif defined(MA_HAS_MACH_SEMAPHORE)
+    (void)signal;
+    semaphore_wait((semaphore_t)pNodeGraph->jobMachSemaphore);
+#else
+    (void)signal;
+    ma_semaphore_wait(&pNodeGraph->jobSemaphore);
+#endif
+}
+
+static void ma_node_graph_signal_job_threads(ma_node_graph* pNodeGraph, ma_uint32 threadCount)
+{
+#if !defined(MA_HAS_FUTEX)
+    ma_uint32 iThread;
+#endif
+
+    ma_atomic_fetch_add_32(&pNodeGraph->jobSignal, 1);
+
+#if defined(MA_HAS_FUTEX)
+    syscall(SYS_futex, &pNodeGraph->jobSignal, FUTEX_WAKE_PRIVATE, (int)threadCount, NULL, NULL, 0);
+#elif defined(MA_HAS_MACH_SEMAPHORE)
+    for (iThread = 0; iThread < threadCount; iThread += 1) {
+        semaphore_signal((semaphore_t)pNodeGraph->jobMachSemaphore);
+    }
+#else
+    for (iThread = 0; iThread < threadCount; iThread += 1) {
+        ma_semaphore_release(&pNodeGraph->jobSemaphore);
+    }
+#endif
+}
+
+static void ma_node_graph_park_job_thread(ma_node_graph* pNodeGraph)
+{
+    ma_uint32 signal = ma_atomic_load_32(&pNodeGraph->jobSignal);
+
+    /*
+    The parked count needs to be incremented before checking for work. The calling thread publishes
+    the round before checking the count, so at least one of us is guaranteed to see the other.
+    */
+    ma_atomic_fetch_add_32(&pNodeGraph->jobParkedThreadCount, 1);
+    {
+        if (ma_node_graph_job_thread_has_work(pNodeGraph) == MA_FALSE) {
+            ma_node_graph_wait_for_job_signal(pNodeGraph, signal);
+        }
+    }
+    ma_atomic_fetch_sub_32(&pNodeGraph->jobParkedThreadCount, 1);
+}
+
+static void ma_node_graph_wake_job_threads(ma_node_graph* pNodeGraph, ma_uint32 threadCount)
+{
+    ma_uint32 parkedThreadCount;
+
+    /* Threads that are still spinning will pick up the round without any help. */
+    parkedThreadCount = ma_atomic_load_32(&pNodeGraph->jobParkedThreadCount);
+    if (parkedThreadCount == 0) {
+        return;
+    }
+
+    if (threadCount > parkedThreadCount) {
+        threadCount = parkedThreadCount;
+    }
+
+    ma_node_graph_signal_job_threads(pNodeGraph, threadCount);
+}
+
+static void ma_node_graph_yield_job_wait(ma_uint32 iteration)
+{
+    /*
+    When waiting on a worker thread, spin for a bit and then start giving up the time slice. On a
+    single core, or if the worker has been preempted, spinning forever would just stop it from
+    getting the time it needs to finish.
+    */
+    if (iteration < MA_NODE_GRAPH_JOB_SPIN_COUNT) {
+        ma_yield();
+    } else {
+    #if defined(MA_WIN32)
+        SwitchToThread();
+    #else
+        sched_yield();
+    #endif
+    }
+}
+
+static ma_thread_result MA_THREADCALL ma_node_graph_job_thread(void* pUserData)
+{
+    ma_node_graph* pNodeGraph = (ma_node_graph*)pUserData;
+    MA_ASSERT(pNodeGraph != NULL);
+
+    for (;;) {
+        ma_uint32 iSpin;
+
+        /* Spin for a bit before parking. When rounds come in quick succession this avoids going through the OS at all. */
+        for (iSpin = 0; iSpin < MA_NODE_GRAPH_JOB_SPIN_COUNT; iSpin += 1) {
+            if (ma_node_graph_job_thread_has_work(pNodeGraph)) {
+                break;
+            }
+
+            ma_yield();
+        }
+
+        if (iSpin == MA_NODE_GRAPH_JOB_SPIN_COUNT) {
+            ma_node_graph_park_job_thread(pNodeGraph);
+        }
+
+        if (ma_atomic_load_32(&pNodeGraph->isJobThreadShuttingDown)) {
+            break;
+        }
+
+        ma_node_graph_process_jobs(pNodeGraph);
+    }
+
+    return (ma_thread_result)0;
+}
+
+static void ma_node_graph_uninit_job_threads(ma_node_graph* pNodeGraph, ma_uint32 jobThreadCount, const ma_allocation_callbacks* pAllocationCallbacks)
+{
+    ma_uint32 iJobThread;
+
+    MA_ASSERT(pNodeGraph != NULL);
+
+    ma_atomic_exchange_32(&pNodeGraph->isJobThreadShuttingDown, MA_TRUE);
+
+    /* Wake everything. Any thread that hasn't parked yet will see the flag before it does. */
+    ma_node_graph_signal_job_threads(pNodeGraph, jobThreadCount);
+
+    for (iJobThread = 0; iJobThread < jobThreadCount; iJobThread += 1) {
+        ma_thread_wait(&pNodeGraph->jobThreads[iJobThread]);
+    }
+
+    ma_node_graph_uninit_job_parking(pNodeGraph);
+
+    ma_free(pNodeGraph->pJobs, pAllocationCallbacks);
+    pNodeGraph->pJobs      = NULL;
+    pNodeGraph->pJobFrames = NULL;
+    pNodeGraph->jobThreadCount = 0;
+}
+
+static ma_result ma_node_graph_init_job_threads(ma_node_graph* pNodeGraph, const ma_node_graph_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks)
+{
+    ma_result result;
+    size_t jobsSizeInBytes;
+    size_t framesSizeInBytes;
+    ma_uint32 iJob;
+    ma_uint32 iJobThread;
+
+    MA_ASSERT(pNodeGraph != NULL);
+    MA_ASSERT(pConfig    != NULL);
+
+    if (pConfig->jobThreadCount > MA_NODE_GRAPH_MAX_JOB_THREAD_COUNT) {
+        return MA_INVALID_ARGS;
+    }
+
+    pNodeGraph->jobCapacity = pConfig->jobCapacity;
+    if (pNodeGraph->jobCapacity == 0) {
+        pNodeGraph->jobCapacity = MA_DEFAULT_NODE_GRAPH_JOB_CAPACITY;
+    }
+    if (pNodeGraph->jobCapacity > 0xFFFF) {
+        pNodeGraph->jobCapacity = 0xFFFF;   /* The job count needs to fit in 16 bits. See ma_node_graph_process_jobs(). */
+    }
+
+    /* The jobs and the buffers they output to are all in one allocation. */
+    jobsSizeInBytes   = ma_align_64(sizeof(*pNodeGraph->pJobs) * pNodeGraph->jobCapacity);
+    framesSizeInBytes = sizeof(float) * pNodeGraph->nodeCacheCapInFrames * pConfig->channels * pNodeGraph->jobCapacity;
+
+    pNodeGraph->pJobs = (ma_node_graph_job*)ma_malloc(jobsSizeInBytes + framesSizeInBytes, pAllocationCallbacks);
+    if (pNodeGraph->pJobs == NULL) {
+        return MA_OUT_OF_MEMORY;
+    }
+
+    pNodeGraph->pJobFrames = (float*)ma_offset_ptr(pNodeGraph->pJobs, jobsSizeInBytes);
+
+    for (iJob = 0; iJob < pNodeGraph->jobCapacity; iJob += 1) {
+        pNodeGraph->pJobs[iJob].pOutputBus = NULL;
+        pNodeGraph->pJobs[iJob].pFrames    = pNodeGraph->pJobFrames + (iJob * pNodeGraph->nodeCacheCapInFrames * pConfig->channels);
+    }
+
+    result = ma_node_graph_init_job_parking(pNodeGraph);
+    if (result != MA_SUCCESS) {
+        ma_free(pNodeGraph->pJobs, pAllocationCallbacks);
+        pNodeGraph->pJobs = NULL;
+        return result;
+    }
+
+    /* Create the job threads last to ensure the threads have access to valid data. */
+    for (iJobThread = 0; iJobThread < pConfig->jobThreadCount; iJobThread += 1) {
+        result = ma_thread_create(&pNodeGraph->jobThreads[iJobThread], pConfig->jobThreadPriority, pConfig->jobThreadStackSize, ma_node_graph_job_thread, pNodeGraph, pAllocationCallbacks);
+        if (result != MA_SUCCESS) {
+            ma_node_graph_uninit_job_threads(pNodeGraph, iJobThread, pAllocationCallbacks);
+            return result;
+        }
+    }
+
+    pNodeGraph->jobThreadCount = pConfig->jobThreadCount;
+
+    return MA_SUCCESS;
+}
+#endif
+
 static void ma_node_graph_node_process_pcm_frames(ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut)
 {
     ma_node_graph* pNodeGraph = (ma_node_graph*)pNode;
@@ -71212,6 +77406,8 @@ MA_API ma_result ma_node_graph_init(const ma_node_graph_config* pConfig, const m
         pNodeGraph->nodeCacheCapInFrames = MA_DEFAULT_NODE_CACHE_CAP_IN_FRAMES_PER_BUS;
     }
 
+    ma_allocation_callbacks_init_copy(&pNodeGraph->allocationCallbacks, pAllocationCallbacks);
+
 
     /* Base node so we can use the node graph as a node into another graph. */
     baseConfig = ma_node_config_init();
@@ -71230,12 +77426,40 @@ MA_API ma_result ma_node_graph_init(const ma_node_graph_config* pConfig, const m
     endpointConfig.pInputChannels  = &pConfig->channels;
     endpointConfig.pOutputChannels = &pConfig->channels;
 
-    result = ma_node_init(pNodeGraph, &endpointConfig, pAllocationCallbacks, &pNodeGraph->endpoint);
-    if (result != MA_SUCCESS) {
-        ma_node_uninit(&pNodeGraph->base, pAllocationCallbacks);
-        return result;
+    result = ma_node_init(pNodeGraph, &endpointConfig, pAllocationCallbacks, &pNodeGraph->endpoint);
+    if (result != MA_SUCCESS) {
+        ma_node_uninit(&pNodeGraph->base, pAllocationCallbacks);
+        return result;
+    }
+
+
+    /* Worker threads for multi-threaded processing. */
+    if (pConfig->jobThreadCount > 0) {
+        #ifndef MA_NO_THREADING
+        {
+            result = ma_node_graph_init_job_threads(pNodeGraph, pConfig, pAllocationCallbacks);
+            if (result != MA_SUCCESS) {
+                ma_node_uninit(&pNodeGraph->endpoint, pAllocationCallbacks);
+                ma_node_uninit(&pNodeGraph->base, pAllocationCallbacks);
+                return result;
+            }
+        }
+        #else
+        {
+            /* Threading is disabled at compile time. Everything will be processed on the calling thread. */
+        }
+        #endif
+    }
+
+
+    /* Render plan. The graph is processed one attachment at a time when using worker threads so it's not used in that case. */
+    if (pConfig->useRenderPlan && ma_node_graph_is_multi_threaded(pNodeGraph) == MA_FALSE) {
+        pNodeGraph->useRenderPlan = MA_TRUE;
+        ma_node_graph_update_render_plan(pNodeGraph);
     }
 
+    ma_node_graph_set_profiling_enabled(pNodeGraph, pConfig->enableProfiling);
+
     return MA_SUCCESS;
 }
 
@@ -71245,7 +77469,18 @@ MA_API void ma_node_graph_uninit(ma_node_graph* pNodeGraph, const ma_allocation_
         return;
     }
 
+    #ifndef MA_NO_THREADING
+    {
+        if (pNodeGraph->jobThreadCount > 0) {
+            ma_node_graph_uninit_job_threads(pNodeGraph, pNodeGraph->jobThreadCount, pAllocationCallbacks);
+        }
+    }
+    #endif
+
     ma_node_uninit(&pNodeGraph->endpoint, pAllocationCallbacks);
+
+    ma_node_graph_render_plan_free((ma_node_graph_render_plan*)ma_atomic_load_ptr(&pNodeGraph->pRenderPlan), &pNodeGraph->allocationCallbacks);
+    pNodeGraph->pRenderPlan = NULL;
 }
 
 MA_API ma_node* ma_node_graph_get_endpoint(ma_node_graph* pNodeGraph)
@@ -71286,7 +77521,43 @@ MA_API ma_result ma_node_graph_read_pcm_frames(ma_node_graph* pNodeGraph, void*
 
         ma_node_graph_set_is_reading(pNodeGraph, MA_TRUE);
         {
-            result = ma_node_read_pcm_frames(&pNodeGraph->endpoint, 0, (float*)ma_offset_pcm_frames_ptr(pFramesOut, totalFramesRead, ma_format_f32, channels), (ma_uint32)framesToRead, &framesJustRead, ma_node_get_time(&pNodeGraph->endpoint));
+            ma_node_graph_render_plan* pPlan = NULL;
+            ma_uint64 globalTime = ma_node_get_time(&pNodeGraph->endpoint);
+            ma_uint32 renderPlanEpoch = 0;
+
+            /* We must be registered as a reader before loading the plan or else it could be freed from under us. */
+            if (pNodeGraph->useRenderPlan) {
+                renderPlanEpoch = ma_node_graph_render_plan_enter(pNodeGraph);
+                pPlan = (ma_node_graph_render_plan*)ma_atomic_load_ptr(&pNodeGraph->pRenderPlan);
+
+                /* The plan processes one block at a time. Each block can be no bigger than the size of a slot. */
+                if (pPlan != NULL && framesToRead > pNodeGraph->nodeCacheCapInFrames) {
+                    framesToRead = pNodeGraph->nodeCacheCapInFrames;
+                }
+
+                if (pPlan != NULL && ma_node_graph_render_plan_prepare(pPlan, (ma_uint32)framesToRead, globalTime) == MA_FALSE) {
+                    pPlan = NULL;   /* Fall back to pulling from the endpoint for this block. */
+                }
+            }
+
+            if (pPlan != NULL) {
+                pNodeGraph->pRenderPlanInUse = pPlan;   /* The plan could be swapped at any time so everything in this block needs to use the one we loaded. */
+                ma_node_graph_render_plan_execute(pNodeGraph, pPlan, (ma_uint32)framesToRead, globalTime);
+
+                /* The endpoint is always the last step. Reading from it will mix the slots of the links feeding into it. */
+                pNodeGraph->pRenderPlanStep = &pPlan->pSteps[pPlan->stepCount - 1];
+                {
+                    result = ma_node_read_pcm_frames(&pNodeGraph->endpoint, 0, (float*)ma_offset_pcm_frames_ptr(pFramesOut, totalFramesRead, ma_format_f32, channels), 0, (ma_uint32)framesToRead, &framesJustRead, globalTime);
+                }
+                pNodeGraph->pRenderPlanStep  = NULL;
+                pNodeGraph->pRenderPlanInUse = NULL;
+            } else {
+                result = ma_node_read_pcm_frames(&pNodeGraph->endpoint, 0, (float*)ma_offset_pcm_frames_ptr(pFramesOut, totalFramesRead, ma_format_f32, channels), 0, (ma_uint32)framesToRead, &framesJustRead, globalTime);
+            }
+
+            if (pNodeGraph->useRenderPlan) {
+                ma_node_graph_render_plan_leave(pNodeGraph, renderPlanEpoch);
+            }
         }
         ma_node_graph_set_is_reading(pNodeGraph, MA_FALSE);
 
@@ -71332,6 +77603,26 @@ MA_API ma_uint64 ma_node_graph_get_time(const ma_node_graph* pNodeGraph)
     return ma_node_get_time(&pNodeGraph->endpoint); /* Global time is just the local time of the endpoint. */
 }
 
+MA_API ma_result ma_node_graph_set_profiling_enabled(ma_node_graph* pNodeGraph, ma_bool32 isEnabled)
+{
+    if (pNodeGraph == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    ma_atomic_exchange_32(&pNodeGraph->isProfilingEnabled, isEnabled);
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_bool32 ma_node_graph_is_profiling_enabled(const ma_node_graph* pNodeGraph)
+{
+    if (pNodeGraph == NULL) {
+        return MA_FALSE;
+    }
+
+    return ma_atomic_load_32(&((ma_node_graph*)pNodeGraph)->isProfilingEnabled);
+}
+
 MA_API ma_result ma_node_graph_set_time(ma_node_graph* pNodeGraph, ma_uint64 globalTime)
 {
     if (pNodeGraph == NULL) {
@@ -71343,6 +77634,7 @@ MA_API ma_result ma_node_graph_set_time(ma_node_graph* pNodeGraph, ma_uint64 glo
 
 
 #define MA_NODE_OUTPUT_BUS_FLAG_HAS_READ    0x01    /* Whether or not this bus ready to read more data. Only used on nodes with multiple output buses. */
+#define MA_NODE_OUTPUT_BUS_FLAG_IS_SILENT   0x02    /* Whether or not the last read from this bus was entirely silent. Consumers use this to skip mixing and processing. */
 
 static ma_result ma_node_output_bus_init(ma_node* pNode, ma_uint32 outputBusIndex, ma_uint32 channels, ma_node_output_bus* pOutputBus)
 {
@@ -71397,6 +77689,20 @@ static ma_bool32 ma_node_output_bus_has_read(ma_node_output_bus* pOutputBus)
     return (ma_atomic_load_32(&pOutputBus->flags) & MA_NODE_OUTPUT_BUS_FLAG_HAS_READ) != 0;
 }
 
+static void ma_node_output_bus_set_is_silent(ma_node_output_bus* pOutputBus, ma_bool32 isSilent)
+{
+    if (isSilent) {
+        ma_atomic_fetch_or_32(&pOutputBus->flags, MA_NODE_OUTPUT_BUS_FLAG_IS_SILENT);
+    } else {
+        ma_atomic_fetch_and_32(&pOutputBus->flags, (ma_uint32)~MA_NODE_OUTPUT_BUS_FLAG_IS_SILENT);
+    }
+}
+
+static ma_bool32 ma_node_output_bus_is_silent(const ma_node_output_bus* pOutputBus)
+{
+    return (ma_atomic_load_32(&((ma_node_output_bus*)pOutputBus)->flags) & MA_NODE_OUTPUT_BUS_FLAG_IS_SILENT) != 0;
+}
+
 
 static void ma_node_output_bus_set_is_attached(ma_node_output_bus* pOutputBus, ma_bool32 isAttached)
 {
@@ -71521,7 +77827,7 @@ static void ma_node_input_bus_detach__no_output_bus_lock(ma_node_input_bus* pInp
     /* At this point the output bus is detached and the linked list is completely unaware of it. Reset some data for safety. */
     ma_atomic_exchange_ptr(&pOutputBus->pNext, NULL);   /* Using atomic exchanges here, mainly for the benefit of analysis tools which don't always recognize spinlocks. */
     ma_atomic_exchange_ptr(&pOutputBus->pPrev, NULL);   /* As above. */
-    pOutputBus->pInputNode             = NULL;
+    ma_atomic_exchange_ptr(&pOutputBus->pInputNode, NULL);  /* Atomic because ma_engine_get_node_sample_rate_from() reads this while holding a reference. */
     pOutputBus->inputNodeInputBusIndex = 0;
 
 
@@ -71586,7 +77892,7 @@ static void ma_node_input_bus_attach(ma_node_input_bus* pInputBus, ma_node_outpu
         At this point we can be sure the output bus is not attached to anything. The linked list in the
         old input bus has been updated so that pOutputBus will not get iterated again.
         */
-        pOutputBus->pInputNode             = pNewInputNode;                     /* No need for an atomic assignment here because modification of this variable always happens within a lock. */
+        ma_atomic_exchange_ptr(&pOutputBus->pInputNode, pNewInputNode);         /* Modification of this variable always happens within a lock, but it's read without one while finding the sample rate of engine nodes. */
         pOutputBus->inputNodeInputBusIndex = (ma_uint8)inputNodeInputBusIndex;
 
         /*
@@ -71676,16 +77982,943 @@ static ma_node_output_bus* ma_node_input_bus_first(ma_node_input_bus* pInputBus)
 }
 
 
+/*
+Render plans.
+
+When enabled, the graph is compiled into a topologically sorted list of nodes whenever an
+attachment changes. Each attachment between two nodes in the plan is a link with a buffer slot
+assigned to it. Processing then becomes a flat loop over the list where each node writes its
+output into the slots of the links it produces, and reads its input by mixing the slots of the
+links feeding into it. There's no iteration of input bus linked lists and no recursion.
+
+Nodes that consume input at a different rate to their output (resamplers, for example) cannot have
+their input produced ahead of time because they need to decide how much input they need. These
+are not expanded. They're still in the plan, but they'll pull from their inputs like normal.
+
+Compilation happens on whichever thread changes the attachment, without holding any locks. The new
+plan is swapped in with an atomic exchange. The old plan can't be freed until the audio thread is
+finished with it. Readers register against an epoch before loading the plan, and the old plan is
+freed once every reader registered against the epoch at the time of the swap, or an earlier one,
+has finished. Readers that start after the swap register against a later epoch and see the new plan
+so they are never waited on. The wait is therefore bounded by the length of one block, even when
+the graph is being read continuously.
+*/
+#define MA_NODE_GRAPH_RENDER_PLAN_INVALID_INDEX    0xFFFFFFFF
+
+static ma_bool32 ma_node_graph_render_plan_can_expand(ma_node_base* pNodeBase)
+{
+    MA_ASSERT(pNodeBase != NULL);
+
+    if (pNodeBase->vtable->onGetRequiredInputFrameCount != NULL) {
+        return MA_FALSE;
+    }
+
+    if ((pNodeBase->vtable->flags & MA_NODE_FLAG_DIFFERENT_PROCESSING_RATES) != 0) {
+        return MA_FALSE;
+    }
+
+    /* The slots are interleaved. Planar nodes pull from their inputs themselves so that planar data can be passed straight through from other planar nodes. */
+    if ((pNodeBase->vtable->flags & MA_NODE_FLAG_PLANAR) != 0) {
+        return MA_FALSE;
+    }
+
+    return MA_TRUE;
+}
+
+static void ma_node_graph_render_plan_free(ma_node_graph_render_plan* pPlan, const ma_allocation_callbacks* pAllocationCallbacks)
+{
+    if (pPlan == NULL) {
+        return;
+    }
+
+    ma_free(pPlan->pSteps, pAllocationCallbacks);
+    ma_free(pPlan->pLinks, pAllocationCallbacks);
+    ma_free(pPlan->pOutputLinkIndices, pAllocationCallbacks);
+    ma_free(pPlan->pSlots, pAllocationCallbacks);
+    ma_free(pPlan, pAllocationCallbacks);
+}
+
+/*
+The nodes visited while walking the graph, along with an index for each one. This is kept separate
+from the nodes themselves so that the graph can be walked from more than one thread at a time. It's
+an open addressing hash table keyed on the address of the node.
+*/
+typedef struct
+{
+    ma_node_base* pNode;
+    ma_uint32 index;
+} ma_node_graph_visited_node;
+
+typedef struct
+{
+    ma_node_graph_visited_node* pNodes; /* A NULL node is an empty bucket. */
+    ma_uint32 cap;                      /* Always a power of two. */
+    ma_uint32 count;
+    const ma_allocation_callbacks* pAllocationCallbacks;
+} ma_node_graph_visited_set;
+
+static void ma_node_graph_visited_set_init(const ma_allocation_callbacks* pAllocationCallbacks, ma_node_graph_visited_set* pSet)
+{
+    MA_ZERO_OBJECT(pSet);
+    pSet->pAllocationCallbacks = pAllocationCallbacks;
+}
+
+static void ma_node_graph_visited_set_uninit(ma_node_graph_visited_set* pSet)
+{
+    ma_free(pSet->pNodes, pSet->pAllocationCallbacks);
+}
+
+static ma_uint32 ma_node_graph_visited_set_hash(const ma_node_base* pNode)
+{
+    ma_uint64 address = (ma_uint64)(ma_uintptr)pNode;
+    ma_uint32 hash = (ma_uint32)(address >> 4) ^ (ma_uint32)(address >> 32);
+
+    hash *= 0x9E3779B1;
+    return hash ^ (hash >> 16);
+}
+
+static ma_node_graph_visited_node* ma_node_graph_visited_set_find(ma_node_graph_visited_set* pSet, const ma_node_base* pNode)
+{
+    ma_uint32 iBucket;
+
+    if (pSet->cap == 0) {
+        return NULL;
+    }
+
+    for (iBucket = ma_node_graph_visited_set_hash(pNode) & (pSet->cap - 1); pSet->pNodes[iBucket].pNode != NULL; iBucket = (iBucket + 1) & (pSet->cap - 1)) {
+        if (pSet->pNodes[iBucket].pNode == pNode) {
+            return &pSet->pNodes[iBucket];
+        }
+    }
+
+    return NULL;
+}
+
+static ma_result ma_node_graph_visited_set_insert(ma_node_graph_visited_set* pSet, ma_node_base* pNode, ma_uint32 index)
+{
+    ma_uint32 iBucket;
+
+    /* Keep the load factor at or below a half. */
+    if ((pSet->count + 1) * 2 > pSet->cap) {
+        ma_node_graph_visited_set newSet;
+        ma_uint32 iOldBucket;
+
+        ma_node_graph_visited_set_init(pSet->pAllocationCallbacks, &newSet);
+        newSet.cap    = (pSet->cap == 0) ? 64 : pSet->cap * 2;
+        newSet.pNodes = (ma_node_graph_visited_node*)ma_calloc(sizeof(*newSet.pNodes) * newSet.cap, pSet->pAllocationCallbacks);
+        if (newSet.pNodes == NULL) {
+            return MA_OUT_OF_MEMORY;
+        }
+
+        for (iOldBucket = 0; iOldBucket < pSet->cap; iOldBucket += 1) {
+            if (pSet->pNodes[iOldBucket].pNode != NULL) {
+                ma_node_graph_visited_set_insert(&newSet, pSet->pNodes[iOldBucket].pNode, pSet->pNodes[iOldBucket].index);   /* Can't fail because there's enough room. */
+            }
+        }
+
+        ma_node_graph_visited_set_uninit(pSet);
+        *pSet = newSet;
+    }
+
+    for (iBucket = ma_node_graph_visited_set_hash(pNode) & (pSet->cap - 1); pSet->pNodes[iBucket].pNode != NULL; iBucket = (iBucket + 1) & (pSet->cap - 1)) {
+    }
+
+    pSet->pNodes[iBucket].pNode = pNode;
+    pSet->pNodes[iBucket].index = index;
+    pSet->count += 1;
+
+    return MA_SUCCESS;
+}
+
+
+typedef struct
+{
+    ma_node_graph_render_plan* pPlan;
+    ma_uint32 stepCap;
+    ma_uint32 linkCap;
+    ma_node_graph_visited_set visited;  /* The index of each node is the index of its step, or MA_NODE_GRAPH_RENDER_PLAN_INVALID_INDEX while its inputs are still being visited. */
+    ma_result result;
+    const ma_allocation_callbacks* pAllocationCallbacks;
+} ma_node_graph_render_plan_compiler;
+
+static ma_uint32 ma_node_graph_render_plan_compiler_append_step(ma_node_graph_render_plan_compiler* pCompiler, ma_node_base* pNodeBase, ma_bool32 isExpanded)
+{
+    ma_node_graph_render_plan_step* pStep;
+
+    if (pCompiler->pPlan->stepCount == pCompiler->stepCap) {
+        ma_uint32 newCap = (pCompiler->stepCap == 0) ? 32 : pCompiler->stepCap * 2;
+        ma_node_graph_render_plan_step* pNewSteps = (ma_node_graph_render_plan_step*)ma_realloc(pCompiler->pPlan->pSteps, sizeof(*pNewSteps) * newCap, pCompiler->pAllocationCallbacks);
+        if (pNewSteps == NULL) {
+            pCompiler->result = MA_OUT_OF_MEMORY;
+            return MA_NODE_GRAPH_RENDER_PLAN_INVALID_INDEX;
+        }
+
+        pCompiler->pPlan->pSteps = pNewSteps;
+        pCompiler->stepCap = newCap;
+    }
+
+    pStep = &pCompiler->pPlan->pSteps[pCompiler->pPlan->stepCount];
+    MA_ZERO_OBJECT(pStep);
+    pStep->pNode      = pNodeBase;
+    pStep->isExpanded = isExpanded;
+
+    pCompiler->pPlan->stepCount += 1;
+    return pCompiler->pPlan->stepCount - 1;
+}
+
+static void ma_node_graph_render_plan_compiler_append_link(ma_node_graph_render_plan_compiler* pCompiler, ma_node_output_bus* pOutputBus, ma_uint32 producerStepIndex, ma_uint32 consumerStepIndex, ma_uint32 consumerInputBusIndex)
+{
+    ma_node_graph_render_plan_link* pLink;
+
+    if (pCompiler->pPlan->linkCount == pCompiler->linkCap) {
+        ma_uint32 newCap = (pCompiler->linkCap == 0) ? 32 : pCompiler->linkCap * 2;
+        ma_node_graph_render_plan_link* pNewLinks = (ma_node_graph_render_plan_link*)ma_realloc(pCompiler->pPlan->pLinks, sizeof(*pNewLinks) * newCap, pCompiler->pAllocationCallbacks);
+        if (pNewLinks == NULL) {
+            pCompiler->result = MA_OUT_OF_MEMORY;
+            return;
+        }
+
+        pCompiler->pPlan->pLinks = pNewLinks;
+        pCompiler->linkCap = newCap;
+    }
+
+    pLink = &pCompiler->pPlan->pLinks[pCompiler->pPlan->linkCount];
+    MA_ZERO_OBJECT(pLink);
+    pLink->pOutputBus            = pOutputBus;
+    pLink->producerStepIndex     = producerStepIndex;
+    pLink->consumerStepIndex     = consumerStepIndex;
+    pLink->consumerInputBusIndex = consumerInputBusIndex;
+
+    pCompiler->pPlan->linkCount += 1;
+}
+
+static ma_uint32 ma_node_graph_render_plan_compiler_visit(ma_node_graph_render_plan_compiler* pCompiler, ma_node_base* pNodeBase)
+{
+    ma_node_graph_visited_node* pVisited;
+    ma_uint32 stepIndex;
+    ma_uint32 iInputBus;
+    ma_bool32 isExpanded;
+
+    MA_ASSERT(pCompiler != NULL);
+    MA_ASSERT(pNodeBase != NULL);
+
+    /* If the node has already been visited we just return the existing step. If it's still being visited this will return an invalid index and the link will be skipped. */
+    pVisited = ma_node_graph_visited_set_find(&pCompiler->visited, pNodeBase);
+    if (pVisited != NULL) {
+        return pVisited->index;
+    }
+
+    pCompiler->result = ma_node_graph_visited_set_insert(&pCompiler->visited, pNodeBase, MA_NODE_GRAPH_RENDER_PLAN_INVALID_INDEX);
+    if (pCompiler->result != MA_SUCCESS) {
+        return MA_NODE_GRAPH_RENDER_PLAN_INVALID_INDEX;
+    }
+
+    isExpanded = ma_node_graph_render_plan_can_expand(pNodeBase);
+
+    /*
+    The inputs need to come first in the list. Note that we're iterating over the attachments in the
+    same way as the audio thread so that we don't need to worry about concurrent detachment.
+
+    This is done for nodes that aren't expanded as well, even though they pull from their inputs
+    themselves. An input node may also be feeding an expanded node through another output bus, in
+    which case it needs to be processed by its own step before this node reads from its cache.
+    Otherwise it would be processed twice in the same block. Input steps that end up only being
+    read by unexpanded nodes won't have any demanded links and will be skipped.
+    */
+    for (iInputBus = 0; iInputBus < pNodeBase->inputBusCount; iInputBus += 1) {
+        ma_node_output_bus* pOutputBus;
+
+        for (pOutputBus = ma_node_input_bus_first(&pNodeBase->pInputBuses[iInputBus]); pOutputBus != NULL; pOutputBus = ma_node_input_bus_next(&pNodeBase->pInputBuses[iInputBus], pOutputBus)) {
+            if (pCompiler->result == MA_SUCCESS) {
+                ma_node_graph_render_plan_compiler_visit(pCompiler, (ma_node_base*)pOutputBus->pNode);
+            }
+        }
+    }
+
+    if (pCompiler->result != MA_SUCCESS) {
+        return MA_NODE_GRAPH_RENDER_PLAN_INVALID_INDEX;
+    }
+
+    stepIndex = ma_node_graph_render_plan_compiler_append_step(pCompiler, pNodeBase, isExpanded);
+    if (stepIndex == MA_NODE_GRAPH_RENDER_PLAN_INVALID_INDEX) {
+        return MA_NODE_GRAPH_RENDER_PLAN_INVALID_INDEX;
+    }
+
+    /* Now that we have our step index we can add the links. Anything attached since the loop above will not have a step yet and will be skipped. It'll be picked up by the next compile. */
+    if (isExpanded) {
+        pCompiler->pPlan->pSteps[stepIndex].firstLink = pCompiler->pPlan->linkCount;
+
+        for (iInputBus = 0; iInputBus < pNodeBase->inputBusCount; iInputBus += 1) {
+            ma_node_output_bus* pOutputBus;
+
+            for (pOutputBus = ma_node_input_bus_first(&pNodeBase->pInputBuses[iInputBus]); pOutputBus != NULL; pOutputBus = ma_node_input_bus_next(&pNodeBase->pInputBuses[iInputBus], pOutputBus)) {
+                ma_node_graph_visited_node* pProducer;
+
+                if (pCompiler->result != MA_SUCCESS) {
+                    continue;   /* Keep iterating so the reference to the output bus is released. */
+                }
+
+                pProducer = ma_node_graph_visited_set_find(&pCompiler->visited, (ma_node_base*)pOutputBus->pNode);
+                if (pProducer == NULL || pProducer->index == MA_NODE_GRAPH_RENDER_PLAN_INVALID_INDEX) {
+                    continue;
+                }
+
+                ma_node_graph_render_plan_compiler_append_link(pCompiler, pOutputBus, pProducer->index, stepIndex, iInputBus);
+            }
+        }
+
+        pCompiler->pPlan->pSteps[stepIndex].linkCount = pCompiler->pPlan->linkCount - pCompiler->pPlan->pSteps[stepIndex].firstLink;
+    }
+
+    /* The set may have been reallocated while visiting our inputs so we need to look ourselves up again. */
+    ma_node_graph_visited_set_find(&pCompiler->visited, pNodeBase)->index = stepIndex;
+
+    return stepIndex;
+}
+
+static ma_result ma_node_graph_render_plan_assign_slots(ma_node_graph* pNodeGraph, ma_node_graph_render_plan* pPlan, const ma_allocation_callbacks* pAllocationCallbacks)
+{
+    ma_uint32* pFreeSlots;
+    ma_uint32 freeSlotCount = 0;
+    ma_uint32 maxChannels = 1;
+    ma_uint32 iStep;
+    ma_uint32 iLink;
+
+    /* Each step needs to know which links it's producing. We do this with a counting sort. */
+    if (pPlan->linkCount > 0) {
+        pPlan->pOutputLinkIndices = (ma_uint32*)ma_malloc(sizeof(*pPlan->pOutputLinkIndices) * pPlan->linkCount, pAllocationCallbacks);
+        if (pPlan->pOutputLinkIndices == NULL) {
+            return MA_OUT_OF_MEMORY;
+        }
+    }
+
+    for (iLink = 0; iLink < pPlan->linkCount; iLink += 1) {
+        pPlan->pSteps[pPlan->pLinks[iLink].producerStepIndex].outputLinkCount += 1;
+        maxChannels = ma_max(maxChannels, ma_node_output_bus_get_channels(pPlan->pLinks[iLink].pOutputBus));
+    }
+
+    for (iStep = 1; iStep < pPlan->stepCount; iStep += 1) {
+        pPlan->pSteps[iStep].firstOutputLink = pPlan->pSteps[iStep - 1].firstOutputLink + pPlan->pSteps[iStep - 1].outputLinkCount;
+    }
+
+    for (iStep = 0; iStep < pPlan->stepCount; iStep += 1) {
+        pPlan->pSteps[iStep].outputLinkCount = 0;
+    }
+
+    for (iLink = 0; iLink < pPlan->linkCount; iLink += 1) {
+        ma_node_graph_render_plan_step* pProducer = &pPlan->pSteps[pPlan->pLinks[iLink].producerStepIndex];
+        pPlan->pOutputLinkIndices[pProducer->firstOutputLink + pProducer->outputLinkCount] = iLink;
+        pProducer->outputLinkCount += 1;
+    }
+
+    /*
+    Now assign slots. A link needs its slot from the moment its producer runs until its consumer has
+    run. Since steps are run in order, we can just walk the list and recycle the slots of the links
+    feeding into each step once that step is done. The outputs of a step must be assigned before its
+    inputs are released since both are used at the same time.
+    */
+    pFreeSlots = (ma_uint32*)ma_malloc(sizeof(*pFreeSlots) * (pPlan->linkCount + 1), pAllocationCallbacks);
+    if (pFreeSlots == NULL) {
+        return MA_OUT_OF_MEMORY;
+    }
+
+    for (iStep = 0; iStep < pPlan->stepCount; iStep += 1) {
+        ma_node_graph_render_plan_step* pStep = &pPlan->pSteps[iStep];
+        ma_uint32 iOutputLink;
+
+        for (iOutputLink = 0; iOutputLink < pStep->outputLinkCount; iOutputLink += 1) {
+            ma_node_graph_render_plan_link* pLink = &pPlan->pLinks[pPlan->pOutputLinkIndices[pStep->firstOutputLink + iOutputLink]];
+
+            if (freeSlotCount > 0) {
+                freeSlotCount -= 1;
+                pLink->slotIndex = pFreeSlots[freeSlotCount];
+            } else {
+                pLink->slotIndex = pPlan->slotCount;
+                pPlan->slotCount += 1;
+            }
+        }
+
+        for (iLink = pStep->firstLink; iLink < pStep->firstLink + pStep->linkCount; iLink += 1) {
+            pFreeSlots[freeSlotCount] = pPlan->pLinks[iLink].slotIndex;
+            freeSlotCount += 1;
+        }
+    }
+
+    ma_free(pFreeSlots, pAllocationCallbacks);
+
+    pPlan->slotSizeInSamples = pNodeGraph->nodeCacheCapInFrames * maxChannels;
+
+    if (pPlan->slotCount > 0) {
+        pPlan->pSlots = (float*)ma_malloc(sizeof(float) * pPlan->slotSizeInSamples * pPlan->slotCount, pAllocationCallbacks);
+        if (pPlan->pSlots == NULL) {
+            return MA_OUT_OF_MEMORY;
+        }
+    }
+
+    return MA_SUCCESS;
+}
+
+static ma_result ma_node_graph_render_plan_compile(ma_node_graph* pNodeGraph, ma_node_graph_render_plan** ppPlan)
+{
+    ma_node_graph_render_plan_compiler compiler;
+    ma_result result;
+
+    MA_ASSERT(pNodeGraph != NULL);
+    MA_ASSERT(ppPlan     != NULL);
+
+    *ppPlan = NULL;
+
+    MA_ZERO_OBJECT(&compiler);
+    compiler.pAllocationCallbacks = &pNodeGraph->allocationCallbacks;
+    compiler.result = MA_SUCCESS;
+    ma_node_graph_visited_set_init(&pNodeGraph->allocationCallbacks, &compiler.visited);
+
+    compiler.pPlan = (ma_node_graph_render_plan*)ma_calloc(sizeof(*compiler.pPlan), &pNodeGraph->allocationCallbacks);
+    if (compiler.pPlan == NULL) {
+        return MA_OUT_OF_MEMORY;
+    }
+
+    /* The endpoint is visited first, but since steps are added after their inputs, it'll always end up last. */
+    ma_node_graph_render_plan_compiler_visit(&compiler, &pNodeGraph->endpoint);
+    ma_node_graph_visited_set_uninit(&compiler.visited);
+
+    result = compiler.result;
+    if (result == MA_SUCCESS) {
+        MA_ASSERT(compiler.pPlan->stepCount > 0);
+        MA_ASSERT(compiler.pPlan->pSteps[compiler.pPlan->stepCount - 1].pNode == &pNodeGraph->endpoint);
+
+        result = ma_node_graph_render_plan_assign_slots(pNodeGraph, compiler.pPlan, &pNodeGraph->allocationCallbacks);
+    }
+
+    if (result != MA_SUCCESS) {
+        ma_node_graph_render_plan_free(compiler.pPlan, &pNodeGraph->allocationCallbacks);
+        return result;
+    }
+
+    *ppPlan = compiler.pPlan;
+    return MA_SUCCESS;
+}
+
+static ma_uint32 ma_node_graph_render_plan_enter(ma_node_graph* pNodeGraph)
+{
+    /*
+    If the epoch moves on between loading it and registering against it we need to try again or else
+    we could end up registered against an epoch that a writer has already finished waiting on. This
+    can only happen while a plan is being swapped so it'll rarely need more than one iteration.
+    */
+    for (;;) {
+        ma_uint32 epoch = ma_atomic_load_32(&pNodeGraph->renderPlanEpoch);
+
+        ma_atomic_fetch_add_32(&pNodeGraph->renderPlanReaderCounts[epoch & 1], 1);
+        if (ma_atomic_load_32(&pNodeGraph->renderPlanEpoch) == epoch) {
+            return epoch;
+        }
+
+        ma_atomic_fetch_sub_32(&pNodeGraph->renderPlanReaderCounts[epoch & 1], 1);
+    }
+}
+
+static void ma_node_graph_render_plan_leave(ma_node_graph* pNodeGraph, ma_uint32 epoch)
+{
+    ma_atomic_fetch_sub_32(&pNodeGraph->renderPlanReaderCounts[epoch & 1], 1);
+}
+
+static void ma_node_graph_render_plan_wait_for_readers(ma_node_graph* pNodeGraph)
+{
+    /*
+    Waits for every reader that was registered when this was called to finish. The epoch can only be
+    moved from E to E+1 once the readers registered against E-1 are gone, which share a counter with
+    E+1. Once it's moved on twice, everything registered against the original epoch has finished.
+    New readers keep registering against the latest epoch so they never hold this up.
+    */
+    ma_uint32 targetEpoch = ma_atomic_load_32(&pNodeGraph->renderPlanEpoch) + 2;
+
+    for (;;) {
+        ma_uint32 epoch = ma_atomic_load_32(&pNodeGraph->renderPlanEpoch);
+
+        if ((ma_int32)(epoch - targetEpoch) >= 0) {
+            break;
+        }
+
+        if (ma_atomic_load_32(&pNodeGraph->renderPlanReaderCounts[(epoch + 1) & 1]) == 0) {
+            ma_atomic_compare_and_swap_32(&pNodeGraph->renderPlanEpoch, epoch, epoch + 1);  /* Another thread may have beaten us to it which is fine. */
+        } else {
+            ma_yield();
+        }
+    }
+}
+
+static void ma_node_graph_update_render_plan(ma_node_graph* pNodeGraph)
+{
+    ma_node_graph_render_plan* pNewPlan;
+    ma_node_graph_render_plan* pOldPlan;
+    ma_uint32 generation;
+
+    if (pNodeGraph == NULL || pNodeGraph->useRenderPlan == MA_FALSE) {
+        return;
+    }
+
+    /*
+    The generation is taken after our change to the graph has been made, so any compile with a later
+    generation will include it. That means the plan with the latest generation always wins, even if
+    compiles running on different threads finish out of order.
+    */
+    generation = ma_atomic_fetch_add_32(&pNodeGraph->renderPlanGeneration, 1) + 1;
+
+    /* If this fails the plan will be set to NULL and the graph will fall back to pulling from the endpoint. */
+    ma_node_graph_render_plan_compile(pNodeGraph, &pNewPlan);
+    if (pNewPlan != NULL) {
+        pNewPlan->generation = generation;
+    }
+
+    ma_spinlock_lock(&pNodeGraph->renderPlanLock);
+    {
+        if ((ma_int32)(generation - pNodeGraph->renderPlanPublishedGeneration) > 0) {
+            pNodeGraph->renderPlanPublishedGeneration = generation;
+            pOldPlan = (ma_node_graph_render_plan*)ma_atomic_exchange_ptr(&pNodeGraph->pRenderPlan, pNewPlan);
+        } else {
+            pOldPlan = pNewPlan;    /* A newer plan has already been swapped in. Ours was never visible to the audio thread. */
+        }
+    }
+    ma_spinlock_unlock(&pNodeGraph->renderPlanLock);
+
+    /*
+    The audio thread may still be using the old plan. The caller may be about to uninitialize a node
+    referenced by it so we can't return until it's done with it. It'll pick up the new plan at the
+    start of the next block. This applies even when our plan was discarded because the plan that was
+    replaced by the newer one may still be referencing whatever we changed.
+    */
+    ma_node_graph_render_plan_wait_for_readers(pNodeGraph);
+
+    ma_node_graph_render_plan_free(pOldPlan, &pNodeGraph->allocationCallbacks);
+}
+
+static ma_bool32 ma_node_graph_render_plan_prepare(ma_node_graph_render_plan* pPlan, ma_uint32 frameCount, ma_uint64 globalTime)
+{
+    ma_uint32 iStep;
+    ma_uint32 iLink;
+
+    MA_ASSERT(pPlan != NULL);
+    MA_ASSERT(pPlan->stepCount > 0);
+
+    /*
+    A node that isn't started does not read from its inputs which means they won't be advanced. We
+    need to replicate that which means we need to work out which links will actually be read from
+    before running anything. Steps are visited in reverse so that each step is visited after all of
+    the steps consuming its output.
+    */
+    for (iLink = 0; iLink < pPlan->linkCount; iLink += 1) {
+        pPlan->pLinks[iLink].isDemanded = MA_FALSE;
+    }
+
+    for (iStep = pPlan->stepCount; iStep > 0; iStep -= 1) {
+        ma_node_graph_render_plan_step* pStep = &pPlan->pSteps[iStep - 1];
+        ma_node_base* pNodeBase = (ma_node_base*)pStep->pNode;
+
+        pStep->hasReadInputs = MA_FALSE;
+
+        if (iStep == pPlan->stepCount) {
+            pStep->isDemanded = MA_TRUE;    /* The endpoint is always read. */
+        } else {
+            ma_uint32 iOutputLink;
+
+            pStep->isDemanded = MA_FALSE;
+            for (iOutputLink = 0; iOutputLink < pStep->outputLinkCount; iOutputLink += 1) {
+                if (pPlan->pLinks[pPlan->pOutputLinkIndices[pStep->firstOutputLink + iOutputLink]].isDemanded) {
+                    pStep->isDemanded = MA_TRUE;
+                    break;
+                }
+            }
+        }
+
+        if (pStep->isDemanded == MA_FALSE || pStep->linkCount == 0) {
+            continue;
+        }
+
+        if (ma_node_get_state_by_time_range(pNodeBase, globalTime, globalTime + frameCount) != ma_node_state_started) {
+            continue;   /* The node won't read from its inputs. */
+        }
+
+        /*
+        A node that still has some input data cached from a previous block will not be reading from its
+        inputs. This shouldn't happen with nodes that process input and output at the same rate, but
+        if it does we just let the node pull from its inputs for this block.
+        */
+        if ((pNodeBase->vtable->flags & MA_NODE_FLAG_PASSTHROUGH) == 0 && pNodeBase->cachedFrameCountIn > 0) {
+            return MA_FALSE;
+        }
+
+        for (iLink = pStep->firstLink; iLink < pStep->firstLink + pStep->linkCount; iLink += 1) {
+            pPlan->pLinks[iLink].isDemanded = MA_TRUE;
+        }
+    }
+
+    return MA_TRUE;
+}
+
+static void ma_node_graph_render_plan_execute(ma_node_graph* pNodeGraph, ma_node_graph_render_plan* pPlan, ma_uint32 frameCount, ma_uint64 globalTime)
+{
+    ma_uint32 iStep;
+
+    MA_ASSERT(pNodeGraph != NULL);
+    MA_ASSERT(pPlan      != NULL);
+    MA_ASSERT(frameCount <= pNodeGraph->nodeCacheCapInFrames);
+
+    /* Everything except the endpoint. That's done by the caller which reads straight into the output buffer. */
+    for (iStep = 0; iStep + 1 < pPlan->stepCount; iStep += 1) {
+        ma_node_graph_render_plan_step* pStep = &pPlan->pSteps[iStep];
+        ma_uint32 iOutputLink;
+
+        if (pStep->isDemanded == MA_FALSE) {
+            continue;
+        }
+
+        pNodeGraph->pRenderPlanStep = pStep;
+
+        for (iOutputLink = 0; iOutputLink < pStep->outputLinkCount; iOutputLink += 1) {
+            ma_node_graph_render_plan_link* pLink = &pPlan->pLinks[pPlan->pOutputLinkIndices[pStep->firstOutputLink + iOutputLink]];
+            float* pSlot = pPlan->pSlots + (pLink->slotIndex * pPlan->slotSizeInSamples);
+            ma_uint32 channels = ma_node_output_bus_get_channels(pLink->pOutputBus);
+            ma_uint32 framesProcessed = 0;
+
+            if (pLink->isDemanded == MA_FALSE) {
+                continue;
+            }
+
+            pLink->isSilent = MA_TRUE;
+
+            while (framesProcessed < frameCount) {
+                ma_result result;
+                ma_uint32 framesJustRead;
+
+                result = ma_node_read_pcm_frames(pStep->pNode, pLink->pOutputBus->outputBusIndex, ma_offset_pcm_frames_ptr_f32(pSlot, framesProcessed, channels), 0, frameCount - framesProcessed, &framesJustRead, globalTime + framesProcessed);
+                if (result != MA_SUCCESS && result != MA_AT_END) {
+                    break;
+                }
+
+                if (ma_node_output_bus_is_silent(pLink->pOutputBus) == MA_FALSE) {
+                    pLink->isSilent = MA_FALSE;
+                }
+
+                framesProcessed += framesJustRead;
+
+                if (result != MA_SUCCESS || framesJustRead == 0) {
+                    break;
+                }
+            }
+
+            if (framesProcessed < frameCount) {
+                ma_silence_pcm_frames(ma_offset_pcm_frames_ptr_f32(pSlot, framesProcessed, channels), (frameCount - framesProcessed), ma_format_f32, channels);
+            }
+        }
+    }
+
+    pNodeGraph->pRenderPlanStep = NULL;
+}
+
+static ma_result ma_node_input_bus_read_pcm_frames__render_plan(ma_node_graph* pNodeGraph, ma_node_base* pInputNodeBase, ma_node_input_bus* pInputBus, float* pFramesOut, ma_uint32 frameCount)
+{
+    ma_node_graph_render_plan* pPlan;
+    ma_node_graph_render_plan_step* pStep;
+    ma_uint32 inputBusIndex;
+    ma_uint32 channels;
+    ma_uint32 iLink;
+
+    MA_ASSERT(pNodeGraph != NULL);
+    MA_ASSERT(pNodeGraph->pRenderPlanStep != NULL);
+
+    pPlan = pNodeGraph->pRenderPlanInUse;
+    pStep = pNodeGraph->pRenderPlanStep;
+    inputBusIndex = (ma_uint32)(pInputBus - pInputNodeBase->pInputBuses);
+    channels = ma_node_input_bus_get_channels(pInputBus);
+
+    ma_silence_pcm_frames(pFramesOut, frameCount, ma_format_f32, channels);
+    pInputBus->isSilent = MA_TRUE;
+
+    /*
+    The slots only hold one block of data. If the node asks for its input more than once in the same
+    block there's nothing more to give it.
+    */
+    if (pStep->hasReadInputs) {
+        return MA_SUCCESS;
+    }
+
+    if (inputBusIndex + 1 == pInputNodeBase->inputBusCount) {
+        pStep->hasReadInputs = MA_TRUE;
+    }
+
+    /* The links are ordered by input bus and then by attachment order so we mix in the same order as the regular path. */
+    iLink = pStep->firstLink;
+    while (iLink < pStep->firstLink + pStep->linkCount) {
+        const float* ppMixFrames[MA_NODE_INPUT_BUS_MIX_BATCH_SIZE];
+        ma_uint32 mixCount = 0;
+
+        for (; iLink < pStep->firstLink + pStep->linkCount && mixCount < MA_NODE_INPUT_BUS_MIX_BATCH_SIZE; iLink += 1) {
+            ma_node_graph_render_plan_link* pLink = &pPlan->pLinks[iLink];
+
+            if (pLink->consumerInputBusIndex != inputBusIndex) {
+                continue;
+            }
+
+            if ((((ma_node_base*)pLink->pOutputBus->pNode)->vtable->flags & MA_NODE_FLAG_SILENT_OUTPUT) != 0 || pLink->isSilent) {
+                continue;   /* Don't mix if the node outputs silence. */
+            }
+
+            ppMixFrames[mixCount] = pPlan->pSlots + (pLink->slotIndex * pPlan->slotSizeInSamples);
+            mixCount += 1;
+            pInputBus->isSilent = MA_FALSE;
+        }
+
+        ma_mix_pcm_frames_multi_f32(pFramesOut, ppMixFrames, NULL, mixCount, frameCount, channels);
+    }
+
+    return MA_SUCCESS;
+}
+
+
+
+#ifndef MA_NO_THREADING
+static ma_result ma_node_input_bus_read_pcm_frames__multi_threaded(ma_node_graph* pNodeGraph, ma_node_input_bus* pInputBus, float* pFramesOut, ma_uint32 frameCount, ma_uint64 globalTime)
+{
+    ma_node_output_bus* pOutputBus;
+    ma_uint32 channels;
+
+    /*
+    This is only used for the endpoint's input bus when the graph has worker threads. Each attachment
+    on the input bus is treated as an independent job. An output bus can only ever be attached to one
+    input bus which means the subgraphs feeding into each attachment are disjoint. The exception is
+    nodes with multiple output buses which may have their output buses read from different threads.
+    These are protected by a spinlock in ma_node_read_pcm_frames().
+
+    Attachments are processed in rounds of up to jobCapacity jobs. Each round is processed in chunks
+    of nodeCacheCapInFrames which is the size of each job's output buffer. The calling thread takes
+    part in processing and then waits for the worker threads to finish whatever they've claimed. The
+    results are mixed in attachment order so the output is the same as single threaded processing.
+    */
+    MA_ASSERT(pNodeGraph != NULL);
+    MA_ASSERT(pInputBus  != NULL);
+    MA_ASSERT(pFramesOut != NULL);
+
+    channels = ma_node_input_bus_get_channels(pInputBus);
+
+    ma_silence_pcm_frames(pFramesOut, frameCount, ma_format_f32, channels);
+    pInputBus->isSilent = MA_TRUE;
+
+    pOutputBus = ma_node_input_bus_first(pInputBus);
+    while (pOutputBus != NULL) {
+        ma_uint32 jobCount = 0;
+        ma_uint32 framesProcessed = 0;
+        ma_uint32 iJob;
+
+        /*
+        Gather the jobs for this round. ma_node_input_bus_next() will release the reference to the
+        output bus it's moving away from so we need to hold on to our own until the round is done.
+        Without this, detaching could complete while a worker thread is still reading from it.
+        */
+        while (pOutputBus != NULL && jobCount < pNodeGraph->jobCapacity) {
+            ma_atomic_fetch_add_32(&pOutputBus->refCount, 1);
+            pNodeGraph->pJobs[jobCount].pOutputBus = pOutputBus;
+            jobCount += 1;
+
+            pOutputBus = ma_node_input_bus_next(pInputBus, pOutputBus);
+        }
+
+        while (framesProcessed < frameCount) {
+            ma_uint32 framesToProcess;
+            ma_uint32 iSpin;
+
+            framesToProcess = frameCount - framesProcessed;
+            if (framesToProcess > pNodeGraph->nodeCacheCapInFrames) {
+                framesToProcess = pNodeGraph->nodeCacheCapInFrames;
+            }
+
+            pNodeGraph->jobFrameCount = framesToProcess;
+            pNodeGraph->jobGlobalTime = globalTime + framesProcessed;
+            ma_atomic_exchange_32(&pNodeGraph->jobsCompleted, 0);
+            ma_atomic_exchange_32(&pNodeGraph->jobRange, jobCount << 16);  /* <-- This is what makes the round visible to the worker threads. */
+
+            /* The calling thread will be processing jobs as well so there's no need to wake a thread for every job. */
+            ma_node_graph_wake_job_threads(pNodeGraph, ma_min(jobCount - 1, pNodeGraph->jobThreadCount));
+
+            /* Claim jobs alongside the worker threads until there's none left rather than just waiting on them. */
+            ma_node_graph_process_jobs(pNodeGraph);
+
+            /* There's nothing left to claim, but the worker threads could still be processing something. */
+            for (iSpin = 0; ma_atomic_load_32(&pNodeGraph->jobsCompleted) < jobCount; iSpin += 1) {
+                ma_node_graph_yield_job_wait(iSpin);
+            }
+
+            for (iJob = 0; iJob < jobCount; ) {
+                const float* ppMixFrames[MA_NODE_INPUT_BUS_MIX_BATCH_SIZE];
+                ma_uint32 mixCount = 0;
+
+                for (; iJob < jobCount && mixCount < MA_NODE_INPUT_BUS_MIX_BATCH_SIZE; iJob += 1) {
+                    const ma_node_graph_job* pJob = &pNodeGraph->pJobs[iJob];
+
+                    if ((((ma_node_base*)pJob->pOutputBus->pNode)->vtable->flags & MA_NODE_FLAG_SILENT_OUTPUT) == 0 && pJob->isSilent == MA_FALSE) {    /* Don't mix if the node outputs silence. */
+                        ppMixFrames[mixCount] = pNodeGraph->pJobs[iJob].pFrames;
+                        mixCount += 1;
+                        pInputBus->isSilent = MA_FALSE;
+                    }
+                }
+
+                ma_mix_pcm_frames_multi_f32(ma_offset_pcm_frames_ptr_f32(pFramesOut, framesProcessed, channels), ppMixFrames, NULL, mixCount, framesToProcess, channels);
+            }
+
+            framesProcessed += framesToProcess;
+        }
+
+        for (iJob = 0; iJob < jobCount; iJob += 1) {
+            ma_atomic_fetch_sub_32(&pNodeGraph->pJobs[iJob].pOutputBus->refCount, 1);
+        }
+    }
+
+    return MA_SUCCESS;
+}
+#endif
+
+/*
+Audio data is passed between nodes in one of two layouts. When the planar stride is 0 the data is
+interleaved. Otherwise each channel is stored one after the other and the planar stride is the
+number of samples between the start of each channel. Nodes with MA_NODE_FLAG_PLANAR use their
+cache capacity as the stride so that a planar node can write straight into the cache of another.
+*/
+static float* ma_node_offset_frames_ptr_f32(float* p, ma_uint32 offsetInFrames, ma_uint32 channels, ma_uint32 planarStride)
+{
+    if (planarStride == 0) {
+        return p + (offsetInFrames * channels);
+    } else {
+        return p + offsetInFrames;
+    }
+}
+
+static void ma_node_silence_frames_f32(float* p, ma_uint32 frameCount, ma_uint32 channels, ma_uint32 planarStride)
+{
+    ma_uint32 iChannel;
+
+    if (p == NULL) {
+        return;
+    }
+
+    if (planarStride == 0) {
+        ma_silence_pcm_frames(p, frameCount, ma_format_f32, channels);
+        return;
+    }
+
+    for (iChannel = 0; iChannel < channels; iChannel += 1) {
+        ma_silence_pcm_frames(p + (iChannel * planarStride), frameCount, ma_format_f32, 1);
+    }
+}
+
+static void ma_node_copy_frames_f32(float* pDst, ma_uint32 dstPlanarStride, const float* pSrc, ma_uint32 srcPlanarStride, ma_uint32 frameCount, ma_uint32 channels)
+{
+    ma_uint32 iChannel;
+
+    if (dstPlanarStride == 0 && srcPlanarStride == 0) {
+        ma_copy_pcm_frames(pDst, pSrc, frameCount, ma_format_f32, channels);
+    } else if (dstPlanarStride != 0 && srcPlanarStride != 0) {
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            ma_copy_pcm_frames(pDst + (iChannel * dstPlanarStride), pSrc + (iChannel * srcPlanarStride), frameCount, ma_format_f32, 1);
+        }
+    } else if (dstPlanarStride != 0) {
+        /* Interleaved to planar. This is the boundary between an interleaved node and a planar one. */
+        void* ppChannelsOut[MA_MAX_CHANNELS];
+
+        MA_ASSERT(channels <= MA_MAX_CHANNELS);
+
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            ppChannelsOut[iChannel] = pDst + (iChannel * dstPlanarStride);
+        }
+
+        ma_deinterleave_pcm_frames(ma_format_f32, channels, frameCount, pSrc, ppChannelsOut);
+    } else {
+        /* Planar to interleaved. */
+        const void* ppChannelsIn[MA_MAX_CHANNELS];
+
+        MA_ASSERT(channels <= MA_MAX_CHANNELS);
+
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            ppChannelsIn[iChannel] = pSrc + (iChannel * srcPlanarStride);
+        }
+
+        ma_interleave_pcm_frames(ma_format_f32, channels, frameCount, ppChannelsIn, pDst);
+    }
+}
+
+static void ma_node_mix_frames_f32(float* pDst, ma_uint32 dstPlanarStride, const float* pSrc, ma_uint32 srcPlanarStride, ma_uint32 frameCount, ma_uint32 channels)
+{
+    ma_uint32 iChannel;
+
+    /* Mixing is only ever done between buffers of the same layout. */
+    MA_ASSERT((dstPlanarStride == 0) == (srcPlanarStride == 0));
+
+    if (dstPlanarStride == 0) {
+        ma_mix_pcm_frames_f32(pDst, pSrc, frameCount, channels, /*volume*/1);
+        return;
+    }
+
+    for (iChannel = 0; iChannel < channels; iChannel += 1) {
+        ma_mix_pcm_frames_f32(pDst + (iChannel * dstPlanarStride), pSrc + (iChannel * srcPlanarStride), frameCount, 1, /*volume*/1);
+    }
+}
+
+static void ma_node_mix_frames_multi_f32(float* pDst, ma_uint32 dstPlanarStride, const float** ppSrc, ma_uint32 srcPlanarStride, ma_uint32 srcCount, ma_uint32 frameCount, ma_uint32 channels)
+{
+    ma_uint32 iChannel;
+    ma_uint32 iSrc;
+
+    MA_ASSERT((dstPlanarStride == 0) == (srcPlanarStride == 0));
+    MA_ASSERT(srcCount <= MA_NODE_INPUT_BUS_MIX_BATCH_SIZE);
+
+    if (dstPlanarStride == 0) {
+        ma_mix_pcm_frames_multi_f32(pDst, ppSrc, NULL, srcCount, frameCount, channels);
+        return;
+    }
+
+    for (iChannel = 0; iChannel < channels; iChannel += 1) {
+        const float* ppChannelsSrc[MA_NODE_INPUT_BUS_MIX_BATCH_SIZE];
+
+        for (iSrc = 0; iSrc < srcCount; iSrc += 1) {
+            ppChannelsSrc[iSrc] = ppSrc[iSrc] + (iChannel * srcPlanarStride);
+        }
+
+        ma_mix_pcm_frames_multi_f32(pDst + (iChannel * dstPlanarStride), ppChannelsSrc, NULL, srcCount, frameCount, 1);
+    }
+}
+
+static void ma_node_apply_volume_factor_f32(float* p, ma_uint32 frameCount, ma_uint32 channels, ma_uint32 planarStride, float volume)
+{
+    ma_uint32 iChannel;
+
+    if (planarStride == 0) {
+        ma_apply_volume_factor_f32(p, frameCount * channels, volume);
+        return;
+    }
+
+    if (p == NULL || volume == 1) {
+        return;
+    }
+
+    for (iChannel = 0; iChannel < channels; iChannel += 1) {
+        ma_apply_volume_factor_f32(p + (iChannel * planarStride), frameCount, volume);
+    }
+}
 
-static ma_result ma_node_input_bus_read_pcm_frames(ma_node* pInputNode, ma_node_input_bus* pInputBus, float* pFramesOut, ma_uint32 frameCount, ma_uint32* pFramesRead, ma_uint64 globalTime)
+static ma_result ma_node_input_bus_read_pcm_frames(ma_node* pInputNode, ma_node_input_bus* pInputBus, float* pFramesOut, ma_uint32 planarStride, ma_uint32 frameCount, ma_uint32* pFramesRead, ma_uint64 globalTime)
 {
     ma_result result = MA_SUCCESS;
     ma_node_output_bus* pOutputBus;
     ma_node_output_bus* pFirst;
     ma_uint32 inputChannels;
     ma_bool32 doesOutputBufferHaveContent = MA_FALSE;
-
-    (void)pInputNode;   /* Not currently used. */
+    float temp[MA_DATA_CONVERTER_STACK_BUFFER_SIZE / sizeof(float)];
+    const float* ppBatchFrames[MA_NODE_INPUT_BUS_MIX_BATCH_SIZE];
+    ma_uint32 batchCount = 0;
+    ma_uint32 batchCapInFrames;
+    ma_uint32 batchPlanarStride;
+    ma_uint32 tempCapInFrames;
+    ma_uint32 tempPlanarStride;
+    ma_bool32 isSilent = MA_TRUE;
 
     /*
     This will be called from the audio thread which means we can't be doing any locking. Basically,
@@ -71710,6 +78943,54 @@ static ma_result ma_node_input_bus_read_pcm_frames(ma_node* pInputNode, ma_node_
     *pFramesRead = 0;   /* Safety. */
 
     inputChannels = ma_node_input_bus_get_channels(pInputBus);
+    tempCapInFrames = ma_countof(temp) / inputChannels;
+
+    /* The batch buffers are on the node's heap. Each one has room for a full cache's worth of frames. */
+    if (((ma_node_base*)pInputNode)->pMixBatchData != NULL) {
+        batchCapInFrames = ((ma_node_base*)pInputNode)->cachedDataCapInFramesPerBus;
+    } else {
+        batchCapInFrames = 0;
+    }
+
+    /*
+    When reading planar data the temp and batch buffers are planar as well. If it'll fit, we use the
+    same stride as the output buffer so that planar attachments can write straight into them.
+    */
+    if (planarStride != 0) {
+        if (tempCapInFrames > planarStride) {
+            tempCapInFrames = planarStride;
+        }
+
+        tempPlanarStride  = tempCapInFrames;
+        batchPlanarStride = batchCapInFrames;
+    } else {
+        tempPlanarStride  = 0;
+        batchPlanarStride = 0;
+    }
+
+    /* If a render plan is being executed and this node's inputs are part of it, the input has already been processed. */
+    if (pFramesOut != NULL) {
+        ma_node_graph* pNodeGraph = ((ma_node_base*)pInputNode)->pNodeGraph;
+
+        if (pNodeGraph->pRenderPlanStep != NULL && pNodeGraph->pRenderPlanStep->pNode == pInputNode && pNodeGraph->pRenderPlanStep->isExpanded) {
+            MA_ASSERT(planarStride == 0);   /* Planar nodes are never expanded so this is only ever reached with interleaved data. */
+            *pFramesRead = frameCount;  /* In this path we always "process" the entire amount. */
+            return ma_node_input_bus_read_pcm_frames__render_plan(pNodeGraph, (ma_node_base*)pInputNode, pInputBus, pFramesOut, frameCount);
+        }
+    }
+
+    /* The endpoint's attachments are processed in parallel if the graph has worker threads. */
+    #ifndef MA_NO_THREADING
+    {
+        ma_node_graph* pNodeGraph = ((ma_node_base*)pInputNode)->pNodeGraph;
+
+        if (pFramesOut != NULL && pInputNode == &pNodeGraph->endpoint && ma_node_graph_is_multi_threaded(pNodeGraph)) {
+            MA_ASSERT(planarStride == 0);   /* The endpoint is always read as interleaved. */
+            *pFramesRead = frameCount;  /* In this path we always "process" the entire amount. */
+            return ma_node_input_bus_read_pcm_frames__multi_threaded(pNodeGraph, pInputBus, pFramesOut, frameCount, globalTime);
+        }
+    }
+    #endif
 
     /*
     We need to be careful with how we call ma_node_input_bus_first() and ma_node_input_bus_next(). They
@@ -71721,12 +79002,14 @@ static ma_result ma_node_input_bus_read_pcm_frames(ma_node* pInputNode, ma_node_
     */
     pFirst = ma_node_input_bus_first(pInputBus);
     if (pFirst == NULL) {
+        pInputBus->isSilent = MA_TRUE;
         return MA_SUCCESS;  /* No attachments. Read nothing. */
     }
 
     for (pOutputBus = pFirst; pOutputBus != NULL; pOutputBus = ma_node_input_bus_next(pInputBus, pOutputBus)) {
         ma_uint32 framesProcessed = 0;
         ma_bool32 isSilentOutput = MA_FALSE;
+        ma_bool32 isAttachmentSilent = MA_TRUE;    /* Set to false as soon as the attachment outputs something that isn't silence. */
 
         MA_ASSERT(pOutputBus->pNode != NULL);
         MA_ASSERT(((ma_node_base*)pOutputBus->pNode)->vtable != NULL);
@@ -71734,67 +79017,127 @@ static ma_result ma_node_input_bus_read_pcm_frames(ma_node* pInputNode, ma_node_
         isSilentOutput = (((ma_node_base*)pOutputBus->pNode)->vtable->flags & MA_NODE_FLAG_SILENT_OUTPUT) != 0;
 
         if (pFramesOut != NULL) {
-            /* Read. */
-            float temp[MA_DATA_CONVERTER_STACK_BUFFER_SIZE / sizeof(float)];
-            ma_uint32 tempCapInFrames = ma_countof(temp) / inputChannels;
+            if (doesOutputBufferHaveContent == MA_TRUE && isSilentOutput == MA_FALSE && frameCount <= batchCapInFrames) {
+                /*
+                Batched path. Not the first attachment, but the whole range fits in one of our batch
+                buffers. Rather than mixing straight away we read the entire range into a free batch
+                buffer and only mix once enough attachments have been read. This way the output buffer
+                is only read and written once per batch instead of once per attachment.
+                */
+                float* pBatchFrames = ((ma_node_base*)pInputNode)->pMixBatchData + (batchCount * batchCapInFrames * inputChannels);
 
-            while (framesProcessed < frameCount) {
-                float* pRunningFramesOut;
-                ma_uint32 framesToRead;
-                ma_uint32 framesJustRead;
+                while (framesProcessed < frameCount) {
+                    ma_uint32 framesJustRead;
+
+                    result = ma_node_read_pcm_frames(pOutputBus->pNode, pOutputBus->outputBusIndex, ma_node_offset_frames_ptr_f32(pBatchFrames, framesProcessed, inputChannels, batchPlanarStride), batchPlanarStride, frameCount - framesProcessed, &framesJustRead, globalTime + framesProcessed);
+                    if (result != MA_SUCCESS && result != MA_AT_END) {
+                        break;  /* Don't mix anything from a failed read. */
+                    }
+
+                    if (ma_node_output_bus_is_silent(pOutputBus) == MA_FALSE) {
+                        isAttachmentSilent = MA_FALSE;
+                    }
+
+                    framesProcessed += framesJustRead;
+
+                    if (result != MA_SUCCESS || framesJustRead == 0) {
+                        break;
+                    }
+                }
 
-                framesToRead = frameCount - framesProcessed;
-                if (framesToRead > tempCapInFrames) {
-                    framesToRead = tempCapInFrames;
+                /* Anything we didn't read needs to be silenced so it doesn't contribute to the mix. */
+                if (framesProcessed < frameCount) {
+                    ma_node_silence_frames_f32(ma_node_offset_frames_ptr_f32(pBatchFrames, framesProcessed, inputChannels, batchPlanarStride), (frameCount - framesProcessed), inputChannels, batchPlanarStride);
                 }
 
-                pRunningFramesOut = ma_offset_pcm_frames_ptr_f32(pFramesOut, framesProcessed, inputChannels);
+                /* Silent attachments don't need to be mixed. */
+                if (framesProcessed > 0 && isAttachmentSilent == MA_FALSE) {
+                    ppBatchFrames[batchCount] = pBatchFrames;
+                    batchCount += 1;
 
-                if (doesOutputBufferHaveContent == MA_FALSE) {
-                    /* Fast path. First attachment. We just read straight into the output buffer (no mixing required). */
-                    result = ma_node_read_pcm_frames(pOutputBus->pNode, pOutputBus->outputBusIndex, pRunningFramesOut, framesToRead, &framesJustRead, globalTime + framesProcessed);
-                } else {
-                    /* Slow path. Not the first attachment. Mixing required. */
-                    result = ma_node_read_pcm_frames(pOutputBus->pNode, pOutputBus->outputBusIndex, temp, framesToRead, &framesJustRead, globalTime + framesProcessed);
-                    if (result == MA_SUCCESS || result == MA_AT_END) {
-                        if (isSilentOutput == MA_FALSE) {   /* Don't mix if the node outputs silence. */
-                            ma_mix_pcm_frames_f32(pRunningFramesOut, temp, framesJustRead, inputChannels, /*volume*/1);
-                        }
+                    if (batchCount == MA_NODE_INPUT_BUS_MIX_BATCH_SIZE) {
+                        ma_node_mix_frames_multi_f32(pFramesOut, planarStride, ppBatchFrames, batchPlanarStride, batchCount, frameCount, inputChannels);
+                        batchCount = 0;
                     }
                 }
+            } else {
+                /* Read. */
+                float* pTemp = temp;
 
-                framesProcessed += framesJustRead;
+                while (framesProcessed < frameCount) {
+                    float* pRunningFramesOut;
+                    ma_uint32 framesToRead;
+                    ma_uint32 framesJustRead;
 
-                /* If we reached the end or otherwise failed to read any data we need to finish up with this output node. */
-                if (result != MA_SUCCESS) {
-                    break;
+                    framesToRead = frameCount - framesProcessed;
+                    if (framesToRead > tempCapInFrames) {
+                        framesToRead = tempCapInFrames;
+                    }
+
+                    pRunningFramesOut = ma_node_offset_frames_ptr_f32(pFramesOut, framesProcessed, inputChannels, planarStride);
+
+                    if (doesOutputBufferHaveContent == MA_FALSE) {
+                        /* Fast path. First attachment. We just read straight into the output buffer (no mixing required). */
+                        result = ma_node_read_pcm_frames(pOutputBus->pNode, pOutputBus->outputBusIndex, pRunningFramesOut, planarStride, framesToRead, &framesJustRead, globalTime + framesProcessed);
+                    } else {
+                        /* Slow path. Not the first attachment. Mixing required. */
+                        result = ma_node_read_pcm_frames(pOutputBus->pNode, pOutputBus->outputBusIndex, pTemp, tempPlanarStride, framesToRead, &framesJustRead, globalTime + framesProcessed);
+                        if (result == MA_SUCCESS || result == MA_AT_END) {
+                            if (isSilentOutput == MA_FALSE && ma_node_output_bus_is_silent(pOutputBus) == MA_FALSE) {   /* Don't mix if the node outputs silence. */
+                                ma_node_mix_frames_f32(pRunningFramesOut, planarStride, pTemp, tempPlanarStride, framesJustRead, inputChannels);
+                            }
+                        }
+                    }
+
+                    if (ma_node_output_bus_is_silent(pOutputBus) == MA_FALSE) {
+                        isAttachmentSilent = MA_FALSE;
+                    }
+
+                    framesProcessed += framesJustRead;
+
+                    /* If we reached the end or otherwise failed to read any data we need to finish up with this output node. */
+                    if (result != MA_SUCCESS) {
+                        break;
+                    }
+
+                    /* If we didn't read anything, abort so we don't get stuck in a loop. */
+                    if (framesJustRead == 0) {
+                        break;
+                    }
                 }
 
-                /* If we didn't read anything, abort so we don't get stuck in a loop. */
-                if (framesJustRead == 0) {
-                    break;
+                /* If it's the first attachment we didn't do any mixing. Any leftover samples need to be silenced. */
+                if (pOutputBus == pFirst && framesProcessed < frameCount) {
+                    ma_node_silence_frames_f32(ma_node_offset_frames_ptr_f32(pFramesOut, framesProcessed, inputChannels, planarStride), (frameCount - framesProcessed), inputChannels, planarStride);
                 }
-            }
 
-            /* If it's the first attachment we didn't do any mixing. Any leftover samples need to be silenced. */
-            if (pOutputBus == pFirst && framesProcessed < frameCount) {
-                ma_silence_pcm_frames(ma_offset_pcm_frames_ptr(pFramesOut, framesProcessed, ma_format_f32, inputChannels), (frameCount - framesProcessed), ma_format_f32, inputChannels);
+                if (isSilentOutput == MA_FALSE) {
+                    doesOutputBufferHaveContent = MA_TRUE;
+                }
             }
 
-            if (isSilentOutput == MA_FALSE) {
-                doesOutputBufferHaveContent = MA_TRUE;
+            if (isSilentOutput == MA_FALSE && isAttachmentSilent == MA_FALSE) {
+                isSilent = MA_FALSE;
             }
         } else {
             /* Seek. */
-            ma_node_read_pcm_frames(pOutputBus->pNode, pOutputBus->outputBusIndex, NULL, frameCount, &framesProcessed, globalTime);
+            ma_node_read_pcm_frames(pOutputBus->pNode, pOutputBus->outputBusIndex, NULL, planarStride, frameCount, &framesProcessed, globalTime);
+            isSilent = MA_FALSE;    /* Nothing was output so we can't say for sure that it's silent. */
         }
     }
 
+    /* Mix in anything left over from the last batch. */
+    if (batchCount > 0) {
+        ma_node_mix_frames_multi_f32(pFramesOut, planarStride, ppBatchFrames, batchPlanarStride, batchCount, frameCount, inputChannels);
+    }
+
     /* If we didn't output anything, output silence. */
     if (doesOutputBufferHaveContent == MA_FALSE && pFramesOut != NULL) {
-        ma_silence_pcm_frames(pFramesOut, frameCount, ma_format_f32, inputChannels);
+        ma_node_silence_frames_f32(pFramesOut, frameCount, inputChannels, planarStride);
     }
 
+    pInputBus->isSilent = (ma_bool8)isSilent;
+
     /* In this path we always "process" the entire amount. */
     *pFramesRead = frameCount;
 
@@ -71810,6 +79153,7 @@ MA_API ma_node_config ma_node_config_init(void)
     config.initialState   = ma_node_state_started;    /* Nodes are started by default. */
     config.inputBusCount  = MA_NODE_BUS_COUNT_UNKNOWN;
     config.outputBusCount = MA_NODE_BUS_COUNT_UNKNOWN;
+    config.tailLengthInFrames = MA_NODE_TAIL_LENGTH_INFINITE;
 
     return config;
 }
@@ -71864,6 +79208,7 @@ typedef struct
     size_t inputBusOffset;
     size_t outputBusOffset;
     size_t cachedDataOffset;
+    size_t mixBatchDataOffset;
     ma_uint32 inputBusCount;    /* So it doesn't have to be calculated twice. */
     ma_uint32 outputBusCount;   /* So it doesn't have to be calculated twice. */
 } ma_node_heap_layout;
@@ -71919,6 +79264,27 @@ static ma_result ma_node_translate_bus_counts(const ma_node_config* pConfig, ma_
         if (pConfig->pInputChannels[0] != pConfig->pOutputChannels[0]) {
             return MA_INVALID_ARGS; /* Passthrough nodes must have the same number of channels between input and output nodes. */
         }
+
+        if ((pConfig->vtable->flags & MA_NODE_FLAG_PLANAR) != 0) {
+            return MA_INVALID_ARGS; /* Passthrough nodes read straight into the output buffer of whatever they're attached to so they can't have a layout of their own. */
+        }
+    }
+
+    /* Planar nodes are converted to and from interleaved with the standard deinterleaving routines which are limited to MA_MAX_CHANNELS. */
+    if ((pConfig->vtable->flags & MA_NODE_FLAG_PLANAR) != 0) {
+        ma_uint32 iBus;
+
+        for (iBus = 0; iBus < inputBusCount; iBus += 1) {
+            if (pConfig->pInputChannels[iBus] > MA_MAX_CHANNELS) {
+                return MA_INVALID_ARGS;
+            }
+        }
+
+        for (iBus = 0; iBus < outputBusCount; iBus += 1) {
+            if (pConfig->pOutputChannels[iBus] > MA_MAX_CHANNELS) {
+                return MA_INVALID_ARGS;
+            }
+        }
     }
 
 
@@ -71973,7 +79339,8 @@ static ma_result ma_node_get_heap_layout(ma_node_graph* pNodeGraph, const ma_nod
 
         - The node has 0 inputs and 1 output.
 
-    When a node meets the above conditions, no cache is allocated.
+    When a node meets the above conditions, no cache is allocated. Planar nodes always get a cache
+    because it's used as the stride of their buffers.
 
     The size choice for this buffer is a little bit finicky. We don't want to be too wasteful by
     allocating too much, but at the same time we want it be large enough so that enough frames can
@@ -71981,7 +79348,7 @@ static ma_result ma_node_get_heap_layout(ma_node_graph* pNodeGraph, const ma_nod
     now I'm going with 10ms @ 48K which is 480 frames per bus. This is configurable at compile
     time. It might also be worth investigating whether or not this can be configured at run time.
     */
-    if (inputBusCount == 0 && outputBusCount == 1) {
+    if (inputBusCount == 0 && outputBusCount == 1 && (pConfig->vtable->flags & MA_NODE_FLAG_PLANAR) == 0) {
         /* Fast path. No cache needed. */
         pHeapLayout->cachedDataOffset = MA_SIZE_MAX;
     } else {
@@ -72001,6 +79368,26 @@ static ma_result ma_node_get_heap_layout(ma_node_graph* pNodeGraph, const ma_nod
         pHeapLayout->sizeInBytes += ma_align_64(cachedDataSizeInBytes);
     }
 
+    /*
+    Mix batches. When an input bus has several attachments, each one is read into its own buffer and
+    they're mixed into the input bus in groups of MA_NODE_INPUT_BUS_MIX_BATCH_SIZE. Input buses are
+    read one at a time so the buffers are shared between them. These live on the heap rather than the
+    stack because reading input buses is recursive.
+    */
+    if (inputBusCount > 0) {
+        ma_uint32 maxInputChannels = 0;
+        ma_uint32 iBus;
+
+        for (iBus = 0; iBus < inputBusCount; iBus += 1) {
+            maxInputChannels = ma_max(maxInputChannels, pConfig->pInputChannels[iBus]);
+        }
+
+        pHeapLayout->mixBatchDataOffset = pHeapLayout->sizeInBytes;
+        pHeapLayout->sizeInBytes += ma_align_64(MA_NODE_INPUT_BUS_MIX_BATCH_SIZE * pNodeGraph->nodeCacheCapInFrames * ma_get_bytes_per_frame(ma_format_f32, maxInputChannels));
+    } else {
+        pHeapLayout->mixBatchDataOffset = MA_SIZE_MAX;
+    }
+
 
     /*
     Not technically part of the heap, but we can output the input and output bus counts so we can
@@ -72065,6 +79452,7 @@ MA_API ma_result ma_node_init_preallocated(ma_node_graph* pNodeGraph, const ma_n
     pNodeBase->stateTimes[ma_node_state_stopped] = (ma_uint64)(ma_int64)-1; /* Weird casting for VC6 compatibility. */
     pNodeBase->inputBusCount  = heapLayout.inputBusCount;
     pNodeBase->outputBusCount = heapLayout.outputBusCount;
+    pNodeBase->tailLengthInFrames = pConfig->tailLengthInFrames;
 
     if (heapLayout.inputBusOffset != MA_SIZE_MAX) {
         pNodeBase->pInputBuses = (ma_node_input_bus*)ma_offset_ptr(pHeap, heapLayout.inputBusOffset);
@@ -72085,6 +79473,12 @@ MA_API ma_result ma_node_init_preallocated(ma_node_graph* pNodeGraph, const ma_n
         pNodeBase->pCachedData = NULL;
     }
 
+    if (heapLayout.mixBatchDataOffset != MA_SIZE_MAX) {
+        pNodeBase->pMixBatchData = (float*)ma_offset_ptr(pHeap, heapLayout.mixBatchDataOffset);
+    } else {
+        pNodeBase->pMixBatchData = NULL;
+    }
+
 
 
     /* We need to run an initialization step for each input and output bus. */
@@ -72242,6 +79636,22 @@ MA_API ma_uint32 ma_node_get_output_channels(const ma_node* pNode, ma_uint32 out
     return ma_node_output_bus_get_channels(&pNodeBase->pOutputBuses[outputBusIndex]);
 }
 
+MA_API ma_uint32 ma_node_get_planar_stride(const ma_node* pNode)
+{
+    const ma_node_base* pNodeBase = (const ma_node_base*)pNode;
+
+    if (pNodeBase == NULL) {
+        return 0;
+    }
+
+    if ((pNodeBase->vtable->flags & MA_NODE_FLAG_PLANAR) == 0) {
+        return 0;   /* Interleaved. */
+    }
+
+    /* Planar nodes always have a cache, and the stride is its capacity. */
+    return pNodeBase->cachedDataCapInFramesPerBus;
+}
+
 
 static ma_result ma_node_detach_full(ma_node* pNode)
 {
@@ -72307,6 +79717,11 @@ MA_API ma_result ma_node_detach_output_bus(ma_node* pNode, ma_uint32 outputBusIn
     }
     ma_node_output_bus_unlock(&pNodeBase->pOutputBuses[outputBusIndex]);
 
+    /* The render plan may be referencing the output bus. This will not return until the audio thread has stopped using the old plan. */
+    if (pInputNodeBase != NULL) {
+        ma_node_graph_update_render_plan(pNodeBase->pNodeGraph);
+    }
+
     return result;
 }
 
@@ -72325,6 +79740,57 @@ MA_API ma_result ma_node_detach_all_output_buses(ma_node* pNode)
     return MA_SUCCESS;
 }
 
+static ma_result ma_node_find_upstream_node(ma_node_graph_visited_set* pVisited, ma_node_base* pNodeBase, const ma_node_base* pUpstreamNodeBase, ma_bool32* pFound)
+{
+    ma_result result;
+    ma_uint32 iInputBus;
+
+    MA_ASSERT(pVisited != NULL);
+    MA_ASSERT(pNodeBase != NULL);
+    MA_ASSERT(pFound != NULL);
+
+    if (pNodeBase == pUpstreamNodeBase) {
+        *pFound = MA_TRUE;
+        return MA_SUCCESS;
+    }
+
+    if (ma_node_graph_visited_set_find(pVisited, pNodeBase) != NULL) {
+        return MA_SUCCESS;
+    }
+
+    result = ma_node_graph_visited_set_insert(pVisited, pNodeBase, 0);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    for (iInputBus = 0; iInputBus < pNodeBase->inputBusCount; iInputBus += 1) {
+        ma_node_output_bus* pOutputBus;
+
+        for (pOutputBus = ma_node_input_bus_first(&pNodeBase->pInputBuses[iInputBus]); pOutputBus != NULL; pOutputBus = ma_node_input_bus_next(&pNodeBase->pInputBuses[iInputBus], pOutputBus)) {
+            if (result == MA_SUCCESS && *pFound == MA_FALSE) {
+                result = ma_node_find_upstream_node(pVisited, (ma_node_base*)pOutputBus->pNode, pUpstreamNodeBase, pFound);
+            }
+        }
+    }
+
+    return result;
+}
+
+static ma_result ma_node_would_create_loop(ma_node_base* pNodeBase, ma_node_base* pOtherNodeBase, ma_bool32* pWouldCreateLoop)
+{
+    ma_result result;
+    ma_node_graph_visited_set visited;
+
+    *pWouldCreateLoop = MA_FALSE;
+
+    /* Attaching the output of a node to the input of another will create a loop if the other node is already one of its inputs. */
+    ma_node_graph_visited_set_init(&pNodeBase->pNodeGraph->allocationCallbacks, &visited);
+    result = ma_node_find_upstream_node(&visited, pNodeBase, pOtherNodeBase, pWouldCreateLoop);
+    ma_node_graph_visited_set_uninit(&visited);
+
+    return result;
+}
+
 MA_API ma_result ma_node_attach_output_bus(ma_node* pNode, ma_uint32 outputBusIndex, ma_node* pOtherNode, ma_uint32 otherNodeInputBusIndex)
 {
     ma_node_base* pNodeBase  = (ma_node_base*)pNode;
@@ -72347,9 +79813,31 @@ MA_API ma_result ma_node_attach_output_bus(ma_node* pNode, ma_uint32 outputBusIn
         return MA_INVALID_OPERATION;    /* Channel count is incompatible. */
     }
 
+    /*
+    Loops are fine when the graph is processed on a single thread because the second time a node is
+    reached in the same time period it'll just read from its cache. When processing on multiple threads,
+    nodes with more than one output bus are locked while being read which means a loop would have a
+    thread waiting on a lock that it's already holding. We therefore don't allow them in this case.
+    */
+    if (ma_node_graph_is_multi_threaded(pNodeBase->pNodeGraph)) {
+        ma_bool32 wouldCreateLoop;
+        ma_result result;
+
+        result = ma_node_would_create_loop(pNodeBase, pOtherNodeBase, &wouldCreateLoop);
+        if (result != MA_SUCCESS) {
+            return result;
+        }
+
+        if (wouldCreateLoop) {
+            return MA_INVALID_OPERATION;    /* Loops are not supported when processing on multiple threads. */
+        }
+    }
+
     /* This will deal with detaching if the output bus is already attached to something. */
     ma_node_input_bus_attach(&pOtherNodeBase->pInputBuses[otherNodeInputBusIndex], &pNodeBase->pOutputBuses[outputBusIndex], pOtherNode, otherNodeInputBusIndex);
 
+    ma_node_graph_update_render_plan(pNodeBase->pNodeGraph);
+
     return MA_SUCCESS;
 }
 
@@ -72498,6 +79986,109 @@ MA_API ma_result ma_node_set_time(ma_node* pNode, ma_uint64 localTime)
     return MA_SUCCESS;
 }
 
+MA_API ma_result ma_node_set_tail_length(ma_node* pNode, ma_uint32 tailLengthInFrames)
+{
+    if (pNode == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    ma_atomic_exchange_32(&((ma_node_base*)pNode)->tailLengthInFrames, tailLengthInFrames);
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_uint32 ma_node_get_tail_length(const ma_node* pNode)
+{
+    if (pNode == NULL) {
+        return MA_NODE_TAIL_LENGTH_INFINITE;
+    }
+
+    return ma_atomic_load_32(&((ma_node_base*)pNode)->tailLengthInFrames);
+}
+
+MA_API ma_bool32 ma_node_is_output_silent(const ma_node* pNode, ma_uint32 outputBusIndex)
+{
+    const ma_node_base* pNodeBase = (const ma_node_base*)pNode;
+
+    if (pNodeBase == NULL || outputBusIndex >= ma_node_get_output_bus_count(pNodeBase)) {
+        return MA_FALSE;
+    }
+
+    return ma_node_output_bus_is_silent(&pNodeBase->pOutputBuses[outputBusIndex]);
+}
+
+MA_API ma_result ma_node_get_profile(const ma_node* pNode, ma_node_profile* pProfile)
+{
+    ma_node_base* pNodeBase = (ma_node_base*)pNode;
+
+    if (pProfile == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    MA_ZERO_OBJECT(pProfile);
+
+    if (pNodeBase == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    /*
+    The audio thread never waits on us. Instead it bumps the sequence before and after updating the
+    counters and we just try again if it changed while we were reading.
+    */
+    for (;;) {
+        ma_uint32 sequence = ma_atomic_load_32(&pNodeBase->profileSequence);
+        if ((sequence & 1) != 0) {
+            ma_yield();
+            continue;
+        }
+
+        pProfile->processCallCount            = ma_atomic_load_64(&pNodeBase->profileProcessCallCount);
+        pProfile->framesProcessedIn           = ma_atomic_load_64(&pNodeBase->profileFramesProcessedIn);
+        pProfile->framesProcessedOut          = ma_atomic_load_64(&pNodeBase->profileFramesProcessedOut);
+        pProfile->processTimeInNanoseconds    = ma_atomic_load_64(&pNodeBase->profileProcessTimeInNanoseconds);
+        pProfile->maxProcessTimeInNanoseconds = ma_atomic_load_64(&pNodeBase->profileMaxProcessTimeInNanoseconds);
+
+        if (ma_atomic_load_32(&pNodeBase->profileSequence) == sequence) {
+            break;
+        }
+    }
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_node_get_output_bus_profile(const ma_node* pNode, ma_uint32 outputBusIndex, ma_node_output_bus_profile* pProfile)
+{
+    ma_node_base* pNodeBase = (ma_node_base*)pNode;
+
+    if (pProfile == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    MA_ZERO_OBJECT(pProfile);
+
+    if (pNodeBase == NULL || outputBusIndex >= ma_node_get_output_bus_count(pNodeBase)) {
+        return MA_INVALID_ARGS;
+    }
+
+    /* The output bus counters are covered by the node's sequence. See ma_node_get_profile(). */
+    for (;;) {
+        ma_uint32 sequence = ma_atomic_load_32(&pNodeBase->profileSequence);
+        if ((sequence & 1) != 0) {
+            ma_yield();
+            continue;
+        }
+
+        pProfile->readCount  = ma_atomic_load_64(&pNodeBase->pOutputBuses[outputBusIndex].profileReadCount);
+        pProfile->framesRead = ma_atomic_load_64(&pNodeBase->pOutputBuses[outputBusIndex].profileFramesRead);
+
+        if (ma_atomic_load_32(&pNodeBase->profileSequence) == sequence) {
+            break;
+        }
+    }
+
+    return MA_SUCCESS;
+}
+
 
 
 static void ma_node_process_pcm_frames_internal(ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut)
@@ -72507,11 +80098,71 @@ static void ma_node_process_pcm_frames_internal(ma_node* pNode, const float** pp
     MA_ASSERT(pNode != NULL);
 
     if (pNodeBase->vtable->onProcess) {
-        pNodeBase->vtable->onProcess(pNode, ppFramesIn, pFrameCountIn, ppFramesOut, pFrameCountOut);
+        if (ma_node_graph_is_profiling_enabled(pNodeBase->pNodeGraph)) {
+            ma_timer timer;
+            ma_uint64 timeInNanoseconds;
+
+            ma_timer_init(&timer);
+            pNodeBase->vtable->onProcess(pNode, ppFramesIn, pFrameCountIn, ppFramesOut, pFrameCountOut);
+            timeInNanoseconds = (ma_uint64)(ma_timer_get_time_in_seconds(&timer) * 1000000000.0);
+
+            ma_atomic_fetch_add_32(&pNodeBase->profileSequence, 1);   /* Odd. Readers will wait. */
+            {
+                ma_atomic_fetch_add_64(&pNodeBase->profileProcessCallCount, 1);
+                ma_atomic_fetch_add_64(&pNodeBase->profileFramesProcessedIn, *pFrameCountIn);
+                ma_atomic_fetch_add_64(&pNodeBase->profileFramesProcessedOut, *pFrameCountOut);
+                ma_atomic_fetch_add_64(&pNodeBase->profileProcessTimeInNanoseconds, timeInNanoseconds);
+
+                if (timeInNanoseconds > ma_atomic_load_64(&pNodeBase->profileMaxProcessTimeInNanoseconds)) {
+                    ma_atomic_exchange_64(&pNodeBase->profileMaxProcessTimeInNanoseconds, timeInNanoseconds);
+                }
+            }
+            ma_atomic_fetch_add_32(&pNodeBase->profileSequence, 1);   /* Even. */
+        } else {
+            pNodeBase->vtable->onProcess(pNode, ppFramesIn, pFrameCountIn, ppFramesOut, pFrameCountOut);
+        }
+    }
+}
+
+static ma_result ma_node_read_pcm_frames__no_lock(ma_node* pNode, ma_uint32 outputBusIndex, float* pFramesOut, ma_uint32 planarStride, ma_uint32 frameCount, ma_uint32* pFramesRead, ma_uint64 globalTime);
+
+static MA_NO_INLINE ma_result ma_node_read_pcm_frames__deinterleave(ma_node* pNode, ma_uint32 outputBusIndex, float* pFramesOut, ma_uint32 planarStride, ma_uint32 frameCount, ma_uint32* pFramesRead, ma_uint64 globalTime)
+{
+    ma_result result;
+    float temp[MA_DATA_CONVERTER_STACK_BUFFER_SIZE / sizeof(float)];
+    ma_uint32 channels;
+    ma_uint32 tempCapInFrames;
+
+    /*
+    This is used when planar data is being read from an interleaved node that can't process into its
+    cache. This is the case for nodes without a cache, and for passthrough nodes which need to see the
+    data in the same layout as their input. The data is read into a temp buffer and deinterleaved
+    from there. We only do a single read here which is fine because callers need to handle reads
+    that come up short anyway.
+
+    This must not be inlined. It's called from ma_node_read_pcm_frames__no_lock() which is recursive,
+    and the temp buffer would otherwise be added to its stack frame at every level of the graph.
+    */
+    MA_ASSERT(planarStride != 0);
+
+    if (pFramesOut == NULL) {
+        return ma_node_read_pcm_frames__no_lock(pNode, outputBusIndex, NULL, 0, frameCount, pFramesRead, globalTime);
+    }
+
+    channels = ma_node_get_output_channels(pNode, outputBusIndex);
+    tempCapInFrames = ma_countof(temp) / channels;
+
+    if (frameCount > tempCapInFrames) {
+        frameCount = tempCapInFrames;
     }
+
+    result = ma_node_read_pcm_frames__no_lock(pNode, outputBusIndex, temp, 0, frameCount, pFramesRead, globalTime);
+    ma_node_copy_frames_f32(pFramesOut, planarStride, temp, 0, *pFramesRead, channels);
+
+    return result;
 }
 
-static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusIndex, float* pFramesOut, ma_uint32 frameCount, ma_uint32* pFramesRead, ma_uint64 globalTime)
+static ma_result ma_node_read_pcm_frames__no_lock(ma_node* pNode, ma_uint32 outputBusIndex, float* pFramesOut, ma_uint32 planarStride, ma_uint32 frameCount, ma_uint32* pFramesRead, ma_uint64 globalTime)
 {
     ma_node_base* pNodeBase = (ma_node_base*)pNode;
     ma_result result = MA_SUCCESS;
@@ -72530,6 +80181,10 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
     ma_uint32 timeOffsetEnd;
     ma_uint32 frameCountIn;
     ma_uint32 frameCountOut;
+    ma_bool32 isOutputSilent = MA_FALSE;
+    ma_uint32 nodePlanarStride;
+    ma_bool32 isDirect;
+    float volume;
 
     /*
     pFramesRead is mandatory. It must be used to determine how many frames were read. It's normal and
@@ -72551,8 +80206,21 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
         return MA_INVALID_ARGS; /* Invalid output bus index. */
     }
 
+    /*
+    The node always processes data in its own layout. When the caller wants the same layout we can
+    have the node output straight into the caller's buffer. Otherwise the node will output into its
+    cache and we convert it when copying it into the caller's buffer.
+    */
+    nodePlanarStride = ma_node_get_planar_stride(pNodeBase);
+    isDirect = (planarStride == nodePlanarStride);
+
+    if (isDirect == MA_FALSE && (pNodeBase->pCachedData == NULL || (pNodeBase->vtable->flags & MA_NODE_FLAG_PASSTHROUGH) != 0)) {
+        return ma_node_read_pcm_frames__deinterleave(pNode, outputBusIndex, pFramesOut, planarStride, frameCount, pFramesRead, globalTime);
+    }
+
     /* Don't do anything if we're in a stopped state. */
     if (ma_node_get_state_by_time_range(pNode, globalTime, globalTime + frameCount) != ma_node_state_started) {
+        ma_node_output_bus_set_is_silent(&pNodeBase->pOutputBuses[outputBusIndex], MA_TRUE);
         return MA_SUCCESS;  /* We're in a stopped state. This is not an error - we just need to not read anything. */
     }
 
@@ -72576,8 +80244,8 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
 
     /* Trim based on the start offset. We need to silence the start of the buffer. */
     if (timeOffsetBeg > 0) {
-        ma_silence_pcm_frames(pFramesOut, timeOffsetBeg, ma_format_f32, ma_node_get_output_channels(pNode, outputBusIndex));
-        pFramesOut += timeOffsetBeg * ma_node_get_output_channels(pNode, outputBusIndex);
+        ma_node_silence_frames_f32(pFramesOut, timeOffsetBeg, ma_node_get_output_channels(pNode, outputBusIndex), planarStride);
+        pFramesOut = ma_node_offset_frames_ptr_f32(pFramesOut, timeOffsetBeg, ma_node_get_output_channels(pNode, outputBusIndex), planarStride);
         frameCount -= timeOffsetBeg;
     }
 
@@ -72601,18 +80269,31 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
         frameCountIn  = 0;
         frameCountOut = frameCount;    /* Just read as much as we can. The callback will return what was actually read. */
 
-        ppFramesOut[0] = pFramesOut;
+        if (isDirect) {
+            ppFramesOut[0] = pFramesOut;
+        } else {
+            /* Only planar nodes have a cache in this path. They process into that and then get converted. */
+            ppFramesOut[0] = ma_node_get_cached_output_ptr(pNode, 0);
+
+            if (frameCountOut > pNodeBase->cachedDataCapInFramesPerBus) {
+                frameCountOut = pNodeBase->cachedDataCapInFramesPerBus;
+            }
+        }
 
         /*
         If it's a passthrough we won't be expecting the callback to output anything, so we'll
         need to pre-silence the output buffer.
         */
         if ((pNodeBase->vtable->flags & MA_NODE_FLAG_PASSTHROUGH) != 0) {
-            ma_silence_pcm_frames(pFramesOut, frameCount, ma_format_f32, ma_node_get_output_channels(pNode, outputBusIndex));
+            ma_node_silence_frames_f32(ppFramesOut[0], frameCountOut, ma_node_get_output_channels(pNode, outputBusIndex), nodePlanarStride);
         }
 
         ma_node_process_pcm_frames_internal(pNode, NULL, &frameCountIn, ppFramesOut, &frameCountOut);
         totalFramesRead = frameCountOut;
+
+        if (isDirect == MA_FALSE && pFramesOut != NULL) {
+            ma_node_copy_frames_f32(pFramesOut, planarStride, ppFramesOut[0], nodePlanarStride, totalFramesRead, ma_node_get_output_channels(pNode, outputBusIndex));
+        }
     } else {
         /* Slow path. Need to read input data. */
         if ((pNodeBase->vtable->flags & MA_NODE_FLAG_PASSTHROUGH) != 0) {
@@ -72629,7 +80310,7 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
             ppFramesOut[0] = pFramesOut;
             ppFramesIn[0] = ppFramesOut[0];
 
-            result = ma_node_input_bus_read_pcm_frames(pNodeBase, &pNodeBase->pInputBuses[0], ppFramesIn[0], frameCount, &totalFramesRead, globalTime);
+            result = ma_node_input_bus_read_pcm_frames(pNodeBase, &pNodeBase->pInputBuses[0], ppFramesIn[0], planarStride, frameCount, &totalFramesRead, globalTime);
             if (result == MA_SUCCESS) {
                 /* Even though it's a passthrough, we still need to fire the callback. */
                 frameCountIn  = totalFramesRead;
@@ -72645,12 +80326,15 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
                 */
                 MA_ASSERT(frameCountIn  == totalFramesRead);
                 MA_ASSERT(frameCountOut == totalFramesRead);
+
+                isOutputSilent = pNodeBase->pInputBuses[0].isSilent;
             }
         } else {
             /* Slow path. Need to do caching. */
             ma_uint32 framesToProcessIn;
             ma_uint32 framesToProcessOut;
             ma_bool32 consumeNullInput = MA_FALSE;
+            ma_bool32 isProcessingSkipped = MA_FALSE;
 
             /*
             We use frameCount as a basis for the number of frames to read since that's what's being
@@ -72702,12 +80386,13 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
                     */
                     for (iOutputBus = 0; iOutputBus < outputBusCount; iOutputBus += 1) {
                         ma_node_output_bus_set_has_read(&pNodeBase->pOutputBuses[iOutputBus], MA_FALSE); /* <-- This is what tells the next calls to this function for other output buses for this time period to read from cache instead of pulling in more data. */
-                        ppFramesOut[iOutputBus] = ma_node_get_cached_output_ptr(pNode, iOutputBus);
+                        ppFramesOut[iOutputBus] = ma_node_offset_frames_ptr_f32(ma_node_get_cached_output_ptr(pNode, iOutputBus), pNodeBase->cachedFrameCountOut, ma_node_get_output_channels(pNodeBase, iOutputBus), nodePlanarStride);
                     }
 
                     /* We only need to read from input buses if there isn't already some data in the cache. */
                     if (pNodeBase->cachedFrameCountIn == 0) {
                         ma_uint32 maxFramesReadIn = 0;
+                        ma_bool32 isInputSilent = MA_TRUE;
 
                         /* Here is where we pull in data from the input buses. This is what will trigger an advance in time. */
                         for (iInputBus = 0; iInputBus < inputBusCount; iInputBus += 1) {
@@ -72717,7 +80402,7 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
                             ppFramesIn[iInputBus] = ma_node_get_cached_input_ptr(pNode, iInputBus);
 
                             /* Once we've determined our destination pointer we can read. Note that we must inspect the number of frames read and fill any leftovers with silence for safety. */
-                            result = ma_node_input_bus_read_pcm_frames(pNodeBase, &pNodeBase->pInputBuses[iInputBus], ppFramesIn[iInputBus], framesToProcessIn, &framesRead, globalTime);
+                            result = ma_node_input_bus_read_pcm_frames(pNodeBase, &pNodeBase->pInputBuses[iInputBus], ppFramesIn[iInputBus], nodePlanarStride, framesToProcessIn, &framesRead, globalTime);
                             if (result != MA_SUCCESS) {
                                 /* It doesn't really matter if we fail because we'll just fill with silence. */
                                 framesRead = 0; /* Just for safety, but I don't think it's really needed. */
@@ -72726,10 +80411,38 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
                             /* TODO: Minor optimization opportunity here. If no frames were read and the buffer is already filled with silence, no need to re-silence it. */
                             /* Any leftover frames need to silenced for safety. */
                             if (framesRead < framesToProcessIn) {
-                                ma_silence_pcm_frames(ppFramesIn[iInputBus] + (framesRead * ma_node_get_input_channels(pNodeBase, iInputBus)), (framesToProcessIn - framesRead), ma_format_f32, ma_node_get_input_channels(pNodeBase, iInputBus));
+                                ma_node_silence_frames_f32(ma_node_offset_frames_ptr_f32(ppFramesIn[iInputBus], framesRead, ma_node_get_input_channels(pNodeBase, iInputBus), nodePlanarStride), (framesToProcessIn - framesRead), ma_node_get_input_channels(pNodeBase, iInputBus), nodePlanarStride);
                             }
 
                             maxFramesReadIn = ma_max(maxFramesReadIn, framesRead);
+
+                            if (pNodeBase->pInputBuses[iInputBus].isSilent == MA_FALSE) {
+                                isInputSilent = MA_FALSE;
+                            }
+                        }
+
+                        /*
+                        If every input bus was silent and has been for at least as long as the node's tail,
+                        we know the output is going to be silent and we can skip the processing callback
+                        entirely. Note that we're comparing against the count from before this read.
+                        */
+                        if (isInputSilent) {
+                            ma_uint32 tailLengthInFrames = ma_atomic_load_32(&pNodeBase->tailLengthInFrames);
+
+                            isProcessingSkipped = (tailLengthInFrames != MA_NODE_TAIL_LENGTH_INFINITE && pNodeBase->silentFrameCountIn >= tailLengthInFrames);
+
+                            /*
+                            This needs to count time rather than what was read. A node with nothing attached reads
+                            nothing, but if it's using continuous processing it'll still be producing output.
+                            */
+                            if (pNodeBase->silentFrameCountIn < 0xFFFFFFFF - framesToProcessIn) {
+                                pNodeBase->silentFrameCountIn += framesToProcessIn;
+                            } else {
+                                pNodeBase->silentFrameCountIn = 0xFFFFFFFF;
+                            }
+                        } else {
+                            isProcessingSkipped = MA_FALSE;
+                            pNodeBase->silentFrameCountIn = 0;
                         }
 
                         /* This was a fresh load of input data so reset our consumption counter. */
@@ -72747,7 +80460,7 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
                     } else {
                         /* We don't need to read anything, but we do need to prepare our input frame pointers. */
                         for (iInputBus = 0; iInputBus < inputBusCount; iInputBus += 1) {
-                            ppFramesIn[iInputBus] = ma_node_get_cached_input_ptr(pNode, iInputBus) + (pNodeBase->consumedFrameCountIn * ma_node_get_input_channels(pNodeBase, iInputBus));
+                            ppFramesIn[iInputBus] = ma_node_offset_frames_ptr_f32(ma_node_get_cached_input_ptr(pNode, iInputBus), pNodeBase->consumedFrameCountIn, ma_node_get_input_channels(pNodeBase, iInputBus), nodePlanarStride);
                         }
                     }
 
@@ -72756,8 +80469,8 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
                     optimization here - we can set the pointer to the output buffer for this output bus so
                     that the final copy into the output buffer is done directly by onProcess().
                     */
-                    if (pFramesOut != NULL) {
-                        ppFramesOut[outputBusIndex] = ma_offset_pcm_frames_ptr_f32(pFramesOut, pNodeBase->cachedFrameCountOut, ma_node_get_output_channels(pNode, outputBusIndex));
+                    if (pFramesOut != NULL && isDirect) {
+                        ppFramesOut[outputBusIndex] = ma_node_offset_frames_ptr_f32(pFramesOut, pNodeBase->cachedFrameCountOut, ma_node_get_output_channels(pNode, outputBusIndex), planarStride);
                     }
 
 
@@ -72770,7 +80483,16 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
                     pNodeBase->cachedFrameCountIn, which could be 0. Also, we want to check if we can pass
                     in NULL for the input buffer to the callback.
                     */
-                    if ((pNodeBase->vtable->flags & MA_NODE_FLAG_CONTINUOUS_PROCESSING) != 0) {
+                    if (isProcessingSkipped) {
+                        /* The output is known to be silent. We just consume everything we've got. */
+                        frameCountIn = pNodeBase->cachedFrameCountIn;
+                        consumeNullInput = MA_FALSE;
+
+                        /* Without continuous processing there would have been no output without any input, so skipping shouldn't produce any either. */
+                        if (frameCountIn == 0 && (pNodeBase->vtable->flags & MA_NODE_FLAG_CONTINUOUS_PROCESSING) == 0) {
+                            frameCountOut = 0;
+                        }
+                    } else if ((pNodeBase->vtable->flags & MA_NODE_FLAG_CONTINUOUS_PROCESSING) != 0) {
                         /* We're using continuous processing. Make sure we specify the whole frame count at all times. */
                         frameCountIn = framesToProcessIn;    /* Give the processing function as much input data as we've got in the buffer, including any silenced padding from short reads. */
 
@@ -72804,7 +80526,12 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
                     Process data slightly differently depending on whether or not we're consuming NULL
                     input (checked just above).
                     */
-                    if (consumeNullInput) {
+                    if (isProcessingSkipped) {
+                        /* Skipping processing. Output silence in place of the processing callback and fill up the output buffer entirely. */
+                        for (iOutputBus = 0; iOutputBus < outputBusCount; iOutputBus += 1) {
+                            ma_node_silence_frames_f32(ppFramesOut[iOutputBus], frameCountOut, ma_node_get_output_channels(pNodeBase, iOutputBus), nodePlanarStride);
+                        }
+                    } else if (consumeNullInput) {
                         ma_node_process_pcm_frames_internal(pNode, NULL, &frameCountIn, ppFramesOut, &frameCountOut);
                     } else {
                         /*
@@ -72846,14 +80573,28 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
                         break;
                     }
                 }
+
+                /* If the node's layout is different to what was asked for, the data is sitting in the cache and needs to be converted. */
+                if (pFramesOut != NULL && isDirect == MA_FALSE) {
+                    ma_node_copy_frames_f32(pFramesOut, planarStride, ma_node_get_cached_output_ptr(pNodeBase, outputBusIndex), nodePlanarStride, pNodeBase->cachedFrameCountOut, ma_node_get_output_channels(pNodeBase, outputBusIndex));
+                }
+
+                /* The other output buses will be reading from the cache so they need to know whether or not it's silent. */
+                for (iOutputBus = 0; iOutputBus < outputBusCount; iOutputBus += 1) {
+                    ma_node_output_bus_set_is_silent(&pNodeBase->pOutputBuses[iOutputBus], isProcessingSkipped);
+                }
+
+                isOutputSilent = isProcessingSkipped;
             } else {
                 /*
                 We're not needing to read anything from the input buffer so just read directly from our
                 already-processed data.
                 */
                 if (pFramesOut != NULL) {
-                    ma_copy_pcm_frames(pFramesOut, ma_node_get_cached_output_ptr(pNodeBase, outputBusIndex), pNodeBase->cachedFrameCountOut, ma_format_f32, ma_node_get_output_channels(pNodeBase, outputBusIndex));
+                    ma_node_copy_frames_f32(pFramesOut, planarStride, ma_node_get_cached_output_ptr(pNodeBase, outputBusIndex), nodePlanarStride, pNodeBase->cachedFrameCountOut, ma_node_get_output_channels(pNodeBase, outputBusIndex));
                 }
+
+                isOutputSilent = ma_node_output_bus_is_silent(&pNodeBase->pOutputBuses[outputBusIndex]);
             }
 
             /* The number of frames read is always equal to the number of cached output frames. */
@@ -72865,7 +80606,15 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
     }
 
     /* Apply volume, if necessary. */
-    ma_apply_volume_factor_f32(pFramesOut, totalFramesRead * ma_node_get_output_channels(pNodeBase, outputBusIndex), ma_node_output_bus_get_volume(&pNodeBase->pOutputBuses[outputBusIndex]));
+    volume = ma_node_output_bus_get_volume(&pNodeBase->pOutputBuses[outputBusIndex]);
+    ma_node_apply_volume_factor_f32(pFramesOut, totalFramesRead, ma_node_get_output_channels(pNodeBase, outputBusIndex), planarStride, volume);
+
+    /* Let the consumer know whether or not there's anything worth mixing. */
+    if (totalFramesRead == 0 || volume == 0) {
+        isOutputSilent = MA_TRUE;
+    }
+
+    ma_node_output_bus_set_is_silent(&pNodeBase->pOutputBuses[outputBusIndex], isOutputSilent);
 
     /* Advance our local time forward. */
     ma_atomic_fetch_add_64(&pNodeBase->localTime, (ma_uint64)totalFramesRead);
@@ -72874,6 +80623,554 @@ static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusInde
     return result;
 }
 
+static void ma_node_profile_output_bus_read(ma_node_base* pNodeBase, ma_uint32 outputBusIndex, ma_result result, const ma_uint32* pFramesRead)
+{
+    /* This must be called from the thread that's reading from the node, and while holding the node's read lock if it needs one. The sequence must only ever be updated by one thread at a time. */
+    if (result == MA_INVALID_ARGS || ma_node_graph_is_profiling_enabled(pNodeBase->pNodeGraph) == MA_FALSE) {
+        return; /* Invalid arguments means nothing was read, and the node and frame count may be NULL. */
+    }
+
+    ma_atomic_fetch_add_32(&pNodeBase->profileSequence, 1);
+    {
+        ma_atomic_fetch_add_64(&pNodeBase->pOutputBuses[outputBusIndex].profileReadCount, 1);
+        ma_atomic_fetch_add_64(&pNodeBase->pOutputBuses[outputBusIndex].profileFramesRead, *pFramesRead);
+    }
+    ma_atomic_fetch_add_32(&pNodeBase->profileSequence, 1);
+}
+
+static ma_result ma_node_read_pcm_frames(ma_node* pNode, ma_uint32 outputBusIndex, float* pFramesOut, ma_uint32 planarStride, ma_uint32 frameCount, ma_uint32* pFramesRead, ma_uint64 globalTime)
+{
+    ma_node_base* pNodeBase = (ma_node_base*)pNode;
+    ma_result result;
+
+    /*
+    When the graph is processed on multiple threads, the output buses of a node with more than one
+    output bus can end up being read from different threads at the same time. The output buses share
+    the node's cache so we need to lock. Nodes with one output bus can only ever be reached from one
+    thread at a time so they don't need to worry about this. Note that locks are always acquired from
+    the endpoint side of the graph towards the data sources, and ma_node_attach_output_bus() refuses to
+    create loops when the graph is multi-threaded, so there's no way for this to deadlock.
+    */
+    if (pNodeBase != NULL && pNodeBase->outputBusCount > 1 && ma_node_graph_is_multi_threaded(pNodeBase->pNodeGraph)) {
+        ma_spinlock_lock(&pNodeBase->readLock);
+        {
+            result = ma_node_read_pcm_frames__no_lock(pNode, outputBusIndex, pFramesOut, planarStride, frameCount, pFramesRead, globalTime);
+            ma_node_profile_output_bus_read(pNodeBase, outputBusIndex, result, pFramesRead);
+        }
+        ma_spinlock_unlock(&pNodeBase->readLock);
+    } else {
+        result = ma_node_read_pcm_frames__no_lock(pNode, outputBusIndex, pFramesOut, planarStride, frameCount, pFramesRead, globalTime);
+        ma_node_profile_output_bus_read(pNodeBase, outputBusIndex, result, pFramesRead);
+    }
+
+    return result;
+}
+
+
+
+typedef struct
+{
+    char* pJSON;
+    size_t jsonCap;
+    size_t jsonLength;  /* Keeps counting past the capacity so we know how much space is needed. */
+    ma_node_graph_visited_set visited;  /* The index of each node is the index it's written at, or MA_NODE_GRAPH_RENDER_PLAN_INVALID_INDEX while its inputs are still being visited. */
+    ma_result result;
+} ma_node_graph_profile_json_writer;
+
+static void ma_node_graph_profile_json_write(ma_node_graph_profile_json_writer* pWriter, const char* pString)
+{
+    for (; *pString != '\0'; pString += 1) {
+        if (pWriter->jsonLength + 1 < pWriter->jsonCap) {
+            pWriter->pJSON[pWriter->jsonLength] = *pString;
+        }
+
+        pWriter->jsonLength += 1;
+    }
+}
+
+static void ma_node_graph_profile_json_write_uint64(ma_node_graph_profile_json_writer* pWriter, ma_uint64 value)
+{
+    char digits[24];
+    size_t digitCount = 0;
+
+    /* We can't rely on snprintf() being available in C89 so we just do it ourselves. */
+    digits[sizeof(digits) - 1] = '\0';
+    do {
+        digitCount += 1;
+        digits[sizeof(digits) - 1 - digitCount] = (char)('0' + (value % 10));
+        value /= 10;
+    } while (value > 0);
+
+    ma_node_graph_profile_json_write(pWriter, digits + sizeof(digits) - 1 - digitCount);
+}
+
+static void ma_node_graph_profile_json_write_address(ma_node_graph_profile_json_writer* pWriter, const void* p)
+{
+    char digits[2 + sizeof(ma_uintptr)*2 + 1];
+    ma_uintptr address = (ma_uintptr)p;
+    size_t iDigit;
+
+    digits[0] = '0';
+    digits[1] = 'x';
+    for (iDigit = 0; iDigit < sizeof(ma_uintptr)*2; iDigit += 1) {
+        digits[2 + iDigit] = "0123456789abcdef"[(address >> ((sizeof(ma_uintptr)*2 - 1 - iDigit) * 4)) & 0xF];
+    }
+    digits[sizeof(digits) - 1] = '\0';
+
+    ma_node_graph_profile_json_write(pWriter, digits);
+}
+
+static void ma_node_graph_profile_json_write_member(ma_node_graph_profile_json_writer* pWriter, const char* pName, ma_uint64 value)
+{
+    ma_node_graph_profile_json_write(pWriter, ", \"");
+    ma_node_graph_profile_json_write(pWriter, pName);
+    ma_node_graph_profile_json_write(pWriter, "\": ");
+    ma_node_graph_profile_json_write_uint64(pWriter, value);
+}
+
+static void ma_node_graph_profile_json_visit(ma_node_graph_profile_json_writer* pWriter, ma_node_base* pNodeBase, ma_uint32* pNodeCount)
+{
+    ma_node_profile profile;
+    ma_uint32 nodeIndex;
+    ma_uint32 iInputBus;
+    ma_uint32 iOutputBus;
+    ma_uint32 inputCount = 0;
+
+    /* This walks the graph the same way as the render plan compiler. Each node is written after everything feeding into it so they can be referenced by index. */
+    if (pWriter->result != MA_SUCCESS || ma_node_graph_visited_set_find(&pWriter->visited, pNodeBase) != NULL) {
+        return;
+    }
+
+    pWriter->result = ma_node_graph_visited_set_insert(&pWriter->visited, pNodeBase, MA_NODE_GRAPH_RENDER_PLAN_INVALID_INDEX);
+    if (pWriter->result != MA_SUCCESS) {
+        return;
+    }
+
+    for (iInputBus = 0; iInputBus < pNodeBase->inputBusCount; iInputBus += 1) {
+        ma_node_output_bus* pOutputBus;
+
+        for (pOutputBus = ma_node_input_bus_first(&pNodeBase->pInputBuses[iInputBus]); pOutputBus != NULL; pOutputBus = ma_node_input_bus_next(&pNodeBase->pInputBuses[iInputBus], pOutputBus)) {
+            ma_node_graph_profile_json_visit(pWriter, (ma_node_base*)pOutputBus->pNode, pNodeCount);
+        }
+    }
+
+    if (pWriter->result != MA_SUCCESS) {
+        return;
+    }
+
+    nodeIndex = *pNodeCount;
+    *pNodeCount += 1;
+
+    /* The set may have been reallocated while visiting our inputs so we need to look ourselves up again. */
+    ma_node_graph_visited_set_find(&pWriter->visited, pNodeBase)->index = nodeIndex;
+
+    ma_node_get_profile(pNodeBase, &profile);
+
+    ma_node_graph_profile_json_write(pWriter, (nodeIndex > 0) ? ",\n        {" : "\n        {");
+    ma_node_graph_profile_json_write(pWriter, "\"id\": ");
+    ma_node_graph_profile_json_write_uint64(pWriter, nodeIndex);
+    ma_node_graph_profile_json_write(pWriter, ", \"address\": \"");
+    ma_node_graph_profile_json_write_address(pWriter, pNodeBase);
+    ma_node_graph_profile_json_write(pWriter, (ma_node_get_state(pNodeBase) == ma_node_state_started) ? "\", \"state\": \"started\"" : "\", \"state\": \"stopped\"");
+    ma_node_graph_profile_json_write_member(pWriter, "processCallCount",            profile.processCallCount);
+    ma_node_graph_profile_json_write_member(pWriter, "framesProcessedIn",           profile.framesProcessedIn);
+    ma_node_graph_profile_json_write_member(pWriter, "framesProcessedOut",          profile.framesProcessedOut);
+    ma_node_graph_profile_json_write_member(pWriter, "processTimeInNanoseconds",    profile.processTimeInNanoseconds);
+    ma_node_graph_profile_json_write_member(pWriter, "maxProcessTimeInNanoseconds", profile.maxProcessTimeInNanoseconds);
+
+    /* Inputs. These reference the nodes written above. */
+    ma_node_graph_profile_json_write(pWriter, ", \"inputs\": [");
+    for (iInputBus = 0; iInputBus < pNodeBase->inputBusCount; iInputBus += 1) {
+        ma_node_output_bus* pOutputBus;
+
+        for (pOutputBus = ma_node_input_bus_first(&pNodeBase->pInputBuses[iInputBus]); pOutputBus != NULL; pOutputBus = ma_node_input_bus_next(&pNodeBase->pInputBuses[iInputBus], pOutputBus)) {
+            ma_node_graph_visited_node* pInputNode = ma_node_graph_visited_set_find(&pWriter->visited, (ma_node_base*)pOutputBus->pNode);
+
+            /* Anything attached since we visited our inputs won't have an index yet. */
+            if (pInputNode == NULL || pInputNode->index == MA_NODE_GRAPH_RENDER_PLAN_INVALID_INDEX) {
+                continue;
+            }
+
+            ma_node_graph_profile_json_write(pWriter, (inputCount > 0) ? ", {\"inputBus\": " : "{\"inputBus\": ");
+            ma_node_graph_profile_json_write_uint64(pWriter, iInputBus);
+            ma_node_graph_profile_json_write_member(pWriter, "node", pInputNode->index);
+            ma_node_graph_profile_json_write_member(pWriter, "outputBus", pOutputBus->outputBusIndex);
+            ma_node_graph_profile_json_write(pWriter, "}");
+            inputCount += 1;
+        }
+    }
+    ma_node_graph_profile_json_write(pWriter, "]");
+
+    /* Output buses. */
+    ma_node_graph_profile_json_write(pWriter, ", \"outputBuses\": [");
+    for (iOutputBus = 0; iOutputBus < pNodeBase->outputBusCount; iOutputBus += 1) {
+        ma_node_output_bus_profile outputBusProfile;
+
+        ma_node_get_output_bus_profile(pNodeBase, iOutputBus, &outputBusProfile);
+
+        ma_node_graph_profile_json_write(pWriter, (iOutputBus > 0) ? ", {\"readCount\": " : "{\"readCount\": ");
+        ma_node_graph_profile_json_write_uint64(pWriter, outputBusProfile.readCount);
+        ma_node_graph_profile_json_write_member(pWriter, "framesRead", outputBusProfile.framesRead);
+        ma_node_graph_profile_json_write(pWriter, "}");
+    }
+    ma_node_graph_profile_json_write(pWriter, "]}");
+}
+
+MA_API ma_result ma_node_graph_get_profile_json(ma_node_graph* pNodeGraph, char* pJSON, size_t jsonCap, size_t* pJSONLength)
+{
+    ma_node_graph_profile_json_writer writer;
+    ma_uint32 nodeCount = 0;
+
+    if (pJSONLength != NULL) {
+        *pJSONLength = 0;
+    }
+
+    if (pJSON != NULL && jsonCap > 0) {
+        pJSON[0] = '\0';
+    }
+
+    if (pNodeGraph == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    writer.pJSON      = pJSON;
+    writer.jsonCap    = (pJSON != NULL) ? jsonCap : 0;
+    writer.jsonLength = 0;
+    writer.result     = MA_SUCCESS;
+    ma_node_graph_visited_set_init(&pNodeGraph->allocationCallbacks, &writer.visited);
+
+    ma_node_graph_profile_json_write(&writer, "{\n    \"nodes\": [");
+    ma_node_graph_profile_json_visit(&writer, &pNodeGraph->endpoint, &nodeCount);
+    ma_node_graph_profile_json_write(&writer, "\n    ],\n    \"endpoint\": ");
+    ma_node_graph_profile_json_write_uint64(&writer, nodeCount - 1); /* The endpoint is always written last. */
+    ma_node_graph_profile_json_write(&writer, "\n}\n");
+
+    ma_node_graph_visited_set_uninit(&writer.visited);
+
+    if (writer.result != MA_SUCCESS) {
+        if (writer.jsonCap > 0) {
+            writer.pJSON[0] = '\0';
+        }
+
+        return writer.result;
+    }
+
+    if (pJSONLength != NULL) {
+        *pJSONLength = writer.jsonLength;
+    }
+
+    if (writer.jsonCap > 0) {
+        writer.pJSON[ma_min(writer.jsonLength, writer.jsonCap - 1)] = '\0';
+    }
+
+    /* The output is truncated if the buffer isn't big enough. Call with pJSON set to NULL to retrieve the required length. */
+    if (pJSON != NULL && writer.jsonLength >= jsonCap) {
+        return MA_NO_SPACE;
+    }
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_offline_render_config ma_offline_render_config_init(ma_uint64 frameCount)
+{
+    ma_offline_render_config config;
+
+    MA_ZERO_OBJECT(&config);
+    config.frameCount = frameCount;
+
+    return config;
+}
+
+
+typedef ma_result (* ma_offline_render_read_proc)(void* pSource, float* pFramesOut, ma_uint64 frameCount);
+
+typedef struct
+{
+    const ma_offline_render_config* pConfig;
+    ma_uint32 channels;
+    void* pConvertedFrames;                 /* Only used when the encoder's format is not f32. Only accessed by whichever thread is writing the output. */
+#ifndef MA_NO_THREADING
+    float* pBlocks[2];                      /* Rendering alternates between these while pipelining. */
+    ma_uint32 blockFrameCounts[2];          /* A frame count of 0 tells the output thread to finish. */
+    ma_semaphore freeSemaphore;             /* Released by the output thread when a block can be rendered into again. */
+    ma_semaphore filledSemaphore;           /* Released by the rendering thread when a block is ready for the output. */
+    MA_ATOMIC(4, ma_result) outputResult;   /* Set by the output thread if writing fails so rendering can stop early. */
+    ma_uint64 framesWritten;                /* Only accessed by the output thread until it's been waited on. */
+#endif
+} ma_offline_renderer;
+
+static ma_result ma_offline_renderer_write(ma_offline_renderer* pRenderer, const float* pFrames, ma_uint32 frameCount)
+{
+    ma_result result;
+    const ma_offline_render_config* pConfig = pRenderer->pConfig;
+
+#ifndef MA_NO_ENCODING
+    if (pConfig->pEncoder != NULL) {
+        ma_uint64 framesWritten;
+        const void* pFramesToWrite = pFrames;
+
+        if (pConfig->pEncoder->config.format != ma_format_f32) {
+            ma_convert_pcm_frames_format(pRenderer->pConvertedFrames, pConfig->pEncoder->config.format, pFrames, ma_format_f32, frameCount, pRenderer->channels, ma_dither_mode_none);
+            pFramesToWrite = pRenderer->pConvertedFrames;
+        }
+
+        result = ma_encoder_write_pcm_frames(pConfig->pEncoder, pFramesToWrite, frameCount, &framesWritten);
+        if (result != MA_SUCCESS) {
+            return result;
+        }
+
+        if (framesWritten != frameCount) {
+            return MA_IO_ERROR;
+        }
+    }
+#endif
+
+    if (pConfig->onOutput != NULL) {
+        result = pConfig->onOutput(pConfig->pOutputUserData, pFrames, frameCount);
+        if (result != MA_SUCCESS) {
+            return result;
+        }
+    }
+
+    return MA_SUCCESS;
+}
+
+#ifndef MA_NO_THREADING
+static ma_thread_result MA_THREADCALL ma_offline_renderer_output_thread(void* pUserData)
+{
+    ma_offline_renderer* pRenderer = (ma_offline_renderer*)pUserData;
+    ma_uint32 iBlock = 0;
+
+    MA_ASSERT(pRenderer != NULL);
+
+    for (;;) {
+        ma_uint32 frameCount;
+
+        ma_semaphore_wait(&pRenderer->filledSemaphore);
+
+        frameCount = pRenderer->blockFrameCounts[iBlock];
+        if (frameCount == 0) {
+            break;
+        }
+
+        /* After an error we keep draining blocks without writing them so the rendering thread never gets stuck waiting for a free block. */
+        if ((ma_result)ma_atomic_load_i32(&pRenderer->outputResult) == MA_SUCCESS) {
+            ma_result result = ma_offline_renderer_write(pRenderer, pRenderer->pBlocks[iBlock], frameCount);
+            if (result != MA_SUCCESS) {
+                ma_atomic_exchange_i32(&pRenderer->outputResult, result);
+            } else {
+                pRenderer->framesWritten += frameCount;
+            }
+        }
+
+        ma_semaphore_release(&pRenderer->freeSemaphore);
+        iBlock ^= 1;
+    }
+
+    return (ma_thread_result)0;
+}
+
+static ma_result ma_offline_renderer_run_pipelined(ma_offline_renderer* pRenderer, void* pSource, ma_offline_render_read_proc onRead, ma_uint32 blockSizeInFrames, const ma_allocation_callbacks* pAllocationCallbacks, ma_uint64* pFramesRendered)
+{
+    ma_result result = MA_SUCCESS;
+    ma_result outputResult;
+    ma_thread outputThread;
+    ma_uint64 framesRemaining = pRenderer->pConfig->frameCount;
+    ma_uint32 iBlock = 0;
+
+    result = ma_semaphore_init(2, &pRenderer->freeSemaphore);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_semaphore_init(0, &pRenderer->filledSemaphore);
+    if (result != MA_SUCCESS) {
+        ma_semaphore_uninit(&pRenderer->freeSemaphore);
+        return result;
+    }
+
+    ma_atomic_exchange_i32(&pRenderer->outputResult, MA_SUCCESS);
+    pRenderer->framesWritten = 0;
+
+    result = ma_thread_create(&outputThread, ma_thread_priority_default, pRenderer->pConfig->outputThreadStackSize, ma_offline_renderer_output_thread, pRenderer, pAllocationCallbacks);
+    if (result != MA_SUCCESS) {
+        ma_semaphore_uninit(&pRenderer->filledSemaphore);
+        ma_semaphore_uninit(&pRenderer->freeSemaphore);
+        return result;
+    }
+
+    while (framesRemaining > 0) {
+        ma_uint32 framesToRender = (ma_uint32)ma_min(framesRemaining, blockSizeInFrames);
+
+        ma_semaphore_wait(&pRenderer->freeSemaphore);
+
+        if ((ma_result)ma_atomic_load_i32(&pRenderer->outputResult) != MA_SUCCESS) {
+            ma_semaphore_release(&pRenderer->freeSemaphore);   /* Give the block back so the end of stream marker below can use it. */
+            break;
+        }
+
+        result = onRead(pSource, pRenderer->pBlocks[iBlock], framesToRender);
+        if (result != MA_SUCCESS) {
+            ma_semaphore_release(&pRenderer->freeSemaphore);
+            break;
+        }
+
+        pRenderer->blockFrameCounts[iBlock] = framesToRender;
+        ma_semaphore_release(&pRenderer->filledSemaphore);
+
+        framesRemaining -= framesToRender;
+        iBlock ^= 1;
+    }
+
+    /* Tell the output thread to finish once it's written everything that's been rendered so far. */
+    ma_semaphore_wait(&pRenderer->freeSemaphore);
+    pRenderer->blockFrameCounts[iBlock] = 0;
+    ma_semaphore_release(&pRenderer->filledSemaphore);
+
+    ma_thread_wait(&outputThread);
+
+    ma_semaphore_uninit(&pRenderer->filledSemaphore);
+    ma_semaphore_uninit(&pRenderer->freeSemaphore);
+
+    outputResult = (ma_result)ma_atomic_load_i32(&pRenderer->outputResult);
+    if (result == MA_SUCCESS) {
+        result = outputResult;
+    }
+
+    /*
+    Blocks can be rendered ahead of the output thread, so if something failed the number of frames that were
+    rendered is not the same as the number that made it to the output. Only the latter is reported.
+    */
+    *pFramesRendered = pRenderer->framesWritten;
+
+    return result;
+}
+#endif
+
+static ma_result ma_offline_render(void* pSource, ma_offline_render_read_proc onRead, ma_uint32 channels, ma_uint32 sampleRate, const ma_offline_render_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_offline_render_stats* pStats)
+{
+    ma_result result = MA_SUCCESS;
+    ma_offline_renderer renderer;
+    ma_uint32 blockSizeInFrames;
+    ma_uint32 blockCount;
+    size_t blockSizeInBytes;
+    size_t convertedSizeInBytes = 0;
+    void* pHeap;
+    ma_uint64 framesRendered = 0;
+    ma_timer timer;
+    double timeInSeconds;
+
+    MA_ASSERT(pSource != NULL);
+    MA_ASSERT(onRead  != NULL);
+
+    if (pStats != NULL) {
+        MA_ZERO_OBJECT(pStats);
+    }
+
+    if (pConfig == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    blockSizeInFrames = pConfig->blockSizeInFrames;
+    if (blockSizeInFrames == 0) {
+        blockSizeInFrames = MA_DEFAULT_OFFLINE_RENDER_BLOCK_SIZE_IN_FRAMES;
+    }
+
+    blockSizeInBytes = (size_t)blockSizeInFrames * channels * sizeof(float);
+
+#ifndef MA_NO_ENCODING
+    if (pConfig->pEncoder != NULL) {
+        if (pConfig->pEncoder->config.channels != channels) {
+            return MA_INVALID_ARGS;
+        }
+
+        if (pConfig->pEncoder->config.format != ma_format_f32) {
+            convertedSizeInBytes = (size_t)blockSizeInFrames * ma_get_bytes_per_frame(pConfig->pEncoder->config.format, channels);
+        }
+    }
+#endif
+
+    MA_ZERO_OBJECT(&renderer);
+    renderer.pConfig  = pConfig;
+    renderer.channels = channels;
+
+#ifndef MA_NO_THREADING
+    blockCount = (pConfig->noPipelining) ? 1 : 2;
+#else
+    blockCount = 1;
+#endif
+
+    pHeap = ma_malloc(blockSizeInBytes*blockCount + convertedSizeInBytes, pAllocationCallbacks);
+    if (pHeap == NULL) {
+        return MA_OUT_OF_MEMORY;
+    }
+
+    if (convertedSizeInBytes > 0) {
+        renderer.pConvertedFrames = ma_offset_ptr(pHeap, blockSizeInBytes*blockCount);
+    }
+
+    ma_timer_init(&timer);
+
+#ifndef MA_NO_THREADING
+    if (blockCount == 2) {
+        renderer.pBlocks[0] = (float*)pHeap;
+        renderer.pBlocks[1] = (float*)ma_offset_ptr(pHeap, blockSizeInBytes);
+
+        result = ma_offline_renderer_run_pipelined(&renderer, pSource, onRead, blockSizeInFrames, pAllocationCallbacks, &framesRendered);
+    } else
+#endif
+    {
+        while (framesRendered < pConfig->frameCount) {
+            ma_uint32 framesToRender = (ma_uint32)ma_min(pConfig->frameCount - framesRendered, blockSizeInFrames);
+
+            result = onRead(pSource, (float*)pHeap, framesToRender);
+            if (result != MA_SUCCESS) {
+                break;
+            }
+
+            result = ma_offline_renderer_write(&renderer, (float*)pHeap, framesToRender);
+            if (result != MA_SUCCESS) {
+                break;
+            }
+
+            framesRendered += framesToRender;
+        }
+    }
+
+    timeInSeconds = ma_timer_get_time_in_seconds(&timer);
+
+    ma_free(pHeap, pAllocationCallbacks);
+
+    if (pStats != NULL) {
+        pStats->framesRendered = framesRendered;
+        pStats->timeInSeconds  = timeInSeconds;
+
+        if (sampleRate > 0 && timeInSeconds > 0) {
+            pStats->realtimeMultiple = ((double)framesRendered / sampleRate) / timeInSeconds;
+        }
+    }
+
+    return result;
+}
+
+static ma_result ma_node_graph_render_offline__on_read(void* pSource, float* pFramesOut, ma_uint64 frameCount)
+{
+    return ma_node_graph_read_pcm_frames((ma_node_graph*)pSource, pFramesOut, frameCount, NULL);
+}
+
+MA_API ma_result ma_node_graph_render_offline(ma_node_graph* pNodeGraph, const ma_offline_render_config* pConfig, ma_offline_render_stats* pStats)
+{
+    if (pNodeGraph == NULL) {
+        if (pStats != NULL) {
+            MA_ZERO_OBJECT(pStats);
+        }
+
+        return MA_INVALID_ARGS;
+    }
+
+    return ma_offline_render(pNodeGraph, ma_node_graph_render_offline__on_read, ma_node_graph_get_channels(pNodeGraph), (pConfig != NULL) ? pConfig->sampleRate : 0, pConfig, &pNodeGraph->allocationCallbacks, pStats);
+}
+
 
 
 
@@ -73088,6 +81385,7 @@ MA_API ma_result ma_splitter_node_init(ma_node_graph* pNodeGraph, const ma_split
     baseConfig.pInputChannels  = pInputChannels;
     baseConfig.pOutputChannels = pOutputChannels;
     baseConfig.outputBusCount  = pConfig->outputBusCount;
+    baseConfig.tailLengthInFrames = 0;  /* Splitters just copy their input so they have no tail. */
 
     result = ma_node_init(pNodeGraph, &baseConfig, pAllocationCallbacks, &pSplitterNode->base);
     if (result != MA_SUCCESS) {
@@ -73103,6 +81401,138 @@ MA_API void ma_splitter_node_uninit(ma_splitter_node* pSplitterNode, const ma_al
 }
 
 
+/*
+Default tail lengths for the built-in effect nodes. IIR filters never strictly reach silence, so the
+tail is the time it takes for the slowest pole to decay by 120dB. This is well below anything audible.
+*/
+#define MA_NODE_TAIL_DECAY_LOG  13.815510557964274  /* ln(10^6) */
+
+static ma_uint32 ma_node_tail_length_add(ma_uint32 tailLengthA, ma_uint32 tailLengthB)
+{
+    if (tailLengthA == MA_NODE_TAIL_LENGTH_INFINITE || tailLengthB >= MA_NODE_TAIL_LENGTH_INFINITE - tailLengthA) {
+        return MA_NODE_TAIL_LENGTH_INFINITE;
+    }
+
+    return tailLengthA + tailLengthB;
+}
+
+static ma_uint32 ma_node_tail_length_from_pole_radius(double radius)
+{
+    double tailLength;
+
+    if (radius >= 1) {
+        return MA_NODE_TAIL_LENGTH_INFINITE;    /* Never decays. */
+    }
+
+    /* The extra couple of frames are for flushing the filter's own state. */
+    tailLength = 2;
+    if (radius > 0) {
+        tailLength += -MA_NODE_TAIL_DECAY_LOG / ma_logd(radius);
+    }
+
+    if (tailLength >= MA_NODE_TAIL_LENGTH_INFINITE - 1) {
+        return MA_NODE_TAIL_LENGTH_INFINITE;
+    }
+
+    return (ma_uint32)tailLength + 1;
+}
+
+static ma_uint32 ma_biquad_get_tail_length_in_frames(const ma_biquad* pBQ)
+{
+    double a1;
+    double a2;
+    double discriminant;
+    double radius;
+
+    MA_ASSERT(pBQ->format == ma_format_f32);  /* Filter nodes are always f32. */
+
+    a1 = pBQ->a1.f32;
+    a2 = pBQ->a2.f32;
+
+    /* The poles are the roots of z^2 + a1*z + a2. */
+    discriminant = a1*a1 - 4*a2;
+    if (discriminant < 0) {
+        radius = ma_sqrtd(a2);  /* Complex conjugate poles. */
+    } else {
+        radius = (ma_abs(a1) + ma_sqrtd(discriminant)) / 2;
+    }
+
+    return ma_node_tail_length_from_pole_radius(radius);
+}
+
+static ma_uint32 ma_lpf_get_tail_length_in_frames(const ma_lpf* pLPF)
+{
+    ma_uint32 tailLength = 0;
+    ma_uint32 ilpf;
+
+    for (ilpf = 0; ilpf < pLPF->lpf1Count; ilpf += 1) {
+        tailLength = ma_node_tail_length_add(tailLength, ma_node_tail_length_from_pole_radius(pLPF->pLPF1[ilpf].a.f32));
+    }
+
+    for (ilpf = 0; ilpf < pLPF->lpf2Count; ilpf += 1) {
+        tailLength = ma_node_tail_length_add(tailLength, ma_biquad_get_tail_length_in_frames(&pLPF->pLPF2[ilpf].bq));
+    }
+
+    return tailLength;
+}
+
+static ma_uint32 ma_hpf_get_tail_length_in_frames(const ma_hpf* pHPF)
+{
+    ma_uint32 tailLength = 0;
+    ma_uint32 ihpf;
+
+    for (ihpf = 0; ihpf < pHPF->hpf1Count; ihpf += 1) {
+        tailLength = ma_node_tail_length_add(tailLength, ma_node_tail_length_from_pole_radius(ma_abs(1 - pHPF->pHPF1[ihpf].a.f32)));  /* See ma_hpf1_process_pcm_frame_f32(). */
+    }
+
+    for (ihpf = 0; ihpf < pHPF->hpf2Count; ihpf += 1) {
+        tailLength = ma_node_tail_length_add(tailLength, ma_biquad_get_tail_length_in_frames(&pHPF->pHPF2[ihpf].bq));
+    }
+
+    return tailLength;
+}
+
+static ma_uint32 ma_bpf_get_tail_length_in_frames(const ma_bpf* pBPF)
+{
+    ma_uint32 tailLength = 0;
+    ma_uint32 ibpf;
+
+    for (ibpf = 0; ibpf < pBPF->bpf2Count; ibpf += 1) {
+        tailLength = ma_node_tail_length_add(tailLength, ma_biquad_get_tail_length_in_frames(&pBPF->pBPF2[ibpf].bq));
+    }
+
+    return tailLength;
+}
+
+static ma_uint32 ma_delay_get_tail_length_in_frames(const ma_delay* pDelay)
+{
+    float decay = ma_delay_get_decay(pDelay);
+    double echoCount;
+
+    if (decay >= 1) {
+        return MA_NODE_TAIL_LENGTH_INFINITE;
+    }
+
+    /* Each echo is quieter than the last by the decay. Without any decay there's only the one. */
+    echoCount = 1;
+    if (decay > 0) {
+        echoCount += -MA_NODE_TAIL_DECAY_LOG / ma_logd(decay);
+    }
+
+    if ((echoCount + 1) * pDelay->config.delayInFrames >= MA_NODE_TAIL_LENGTH_INFINITE) {
+        return MA_NODE_TAIL_LENGTH_INFINITE;
+    }
+
+    return ((ma_uint32)echoCount + 1) * pDelay->config.delayInFrames;
+}
+
+static void ma_node_update_default_tail_length(ma_node* pNode, ma_uint32 oldTailLength, ma_uint32 newTailLength)
+{
+    /* A tail that was set with ma_node_set_tail_length() is left alone. */
+    ma_atomic_compare_and_swap_32(&((ma_node_base*)pNode)->tailLengthInFrames, oldTailLength, newTailLength);
+}
+
+
 /*
 Biquad Node
 */
@@ -73160,9 +81590,10 @@ MA_API ma_result ma_biquad_node_init(ma_node_graph* pNodeGraph, const ma_biquad_
     }
 
     baseNodeConfig = ma_node_config_init();
-    baseNodeConfig.vtable          = &g_ma_biquad_node_vtable;
-    baseNodeConfig.pInputChannels  = &pConfig->biquad.channels;
-    baseNodeConfig.pOutputChannels = &pConfig->biquad.channels;
+    baseNodeConfig.vtable             = &g_ma_biquad_node_vtable;
+    baseNodeConfig.pInputChannels     = &pConfig->biquad.channels;
+    baseNodeConfig.pOutputChannels    = &pConfig->biquad.channels;
+    baseNodeConfig.tailLengthInFrames = ma_biquad_get_tail_length_in_frames(&pNode->biquad);
 
     result = ma_node_init(pNodeGraph, &baseNodeConfig, pAllocationCallbacks, pNode);
     if (result != MA_SUCCESS) {
@@ -73175,10 +81606,21 @@ MA_API ma_result ma_biquad_node_init(ma_node_graph* pNodeGraph, const ma_biquad_
 MA_API ma_result ma_biquad_node_reinit(const ma_biquad_config* pConfig, ma_biquad_node* pNode)
 {
     ma_biquad_node* pLPFNode = (ma_biquad_node*)pNode;
+    ma_result result;
+    ma_uint32 oldTailLength;
 
     MA_ASSERT(pNode != NULL);
 
-    return ma_biquad_reinit(pConfig, &pLPFNode->biquad);
+    oldTailLength = ma_biquad_get_tail_length_in_frames(&pLPFNode->biquad);
+
+    result = ma_biquad_reinit(pConfig, &pLPFNode->biquad);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    ma_node_update_default_tail_length(pNode, oldTailLength, ma_biquad_get_tail_length_in_frames(&pLPFNode->biquad));
+
+    return MA_SUCCESS;
 }
 
 MA_API void ma_biquad_node_uninit(ma_biquad_node* pNode, const ma_allocation_callbacks* pAllocationCallbacks)
@@ -73252,9 +81694,10 @@ MA_API ma_result ma_lpf_node_init(ma_node_graph* pNodeGraph, const ma_lpf_node_c
     }
 
     baseNodeConfig = ma_node_config_init();
-    baseNodeConfig.vtable          = &g_ma_lpf_node_vtable;
-    baseNodeConfig.pInputChannels  = &pConfig->lpf.channels;
-    baseNodeConfig.pOutputChannels = &pConfig->lpf.channels;
+    baseNodeConfig.vtable             = &g_ma_lpf_node_vtable;
+    baseNodeConfig.pInputChannels     = &pConfig->lpf.channels;
+    baseNodeConfig.pOutputChannels    = &pConfig->lpf.channels;
+    baseNodeConfig.tailLengthInFrames = ma_lpf_get_tail_length_in_frames(&pNode->lpf);
 
     result = ma_node_init(pNodeGraph, &baseNodeConfig, pAllocationCallbacks, pNode);
     if (result != MA_SUCCESS) {
@@ -73267,12 +81710,23 @@ MA_API ma_result ma_lpf_node_init(ma_node_graph* pNodeGraph, const ma_lpf_node_c
 MA_API ma_result ma_lpf_node_reinit(const ma_lpf_config* pConfig, ma_lpf_node* pNode)
 {
     ma_lpf_node* pLPFNode = (ma_lpf_node*)pNode;
+    ma_result result;
+    ma_uint32 oldTailLength;
 
     if (pNode == NULL) {
         return MA_INVALID_ARGS;
     }
 
-    return ma_lpf_reinit(pConfig, &pLPFNode->lpf);
+    oldTailLength = ma_lpf_get_tail_length_in_frames(&pLPFNode->lpf);
+
+    result = ma_lpf_reinit(pConfig, &pLPFNode->lpf);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    ma_node_update_default_tail_length(pNode, oldTailLength, ma_lpf_get_tail_length_in_frames(&pLPFNode->lpf));
+
+    return MA_SUCCESS;
 }
 
 MA_API void ma_lpf_node_uninit(ma_lpf_node* pNode, const ma_allocation_callbacks* pAllocationCallbacks)
@@ -73346,9 +81800,10 @@ MA_API ma_result ma_hpf_node_init(ma_node_graph* pNodeGraph, const ma_hpf_node_c
     }
 
     baseNodeConfig = ma_node_config_init();
-    baseNodeConfig.vtable          = &g_ma_hpf_node_vtable;
-    baseNodeConfig.pInputChannels  = &pConfig->hpf.channels;
-    baseNodeConfig.pOutputChannels = &pConfig->hpf.channels;
+    baseNodeConfig.vtable             = &g_ma_hpf_node_vtable;
+    baseNodeConfig.pInputChannels     = &pConfig->hpf.channels;
+    baseNodeConfig.pOutputChannels    = &pConfig->hpf.channels;
+    baseNodeConfig.tailLengthInFrames = ma_hpf_get_tail_length_in_frames(&pNode->hpf);
 
     result = ma_node_init(pNodeGraph, &baseNodeConfig, pAllocationCallbacks, pNode);
     if (result != MA_SUCCESS) {
@@ -73361,12 +81816,23 @@ MA_API ma_result ma_hpf_node_init(ma_node_graph* pNodeGraph, const ma_hpf_node_c
 MA_API ma_result ma_hpf_node_reinit(const ma_hpf_config* pConfig, ma_hpf_node* pNode)
 {
     ma_hpf_node* pHPFNode = (ma_hpf_node*)pNode;
+    ma_result result;
+    ma_uint32 oldTailLength;
 
     if (pNode == NULL) {
         return MA_INVALID_ARGS;
     }
 
-    return ma_hpf_reinit(pConfig, &pHPFNode->hpf);
+    oldTailLength = ma_hpf_get_tail_length_in_frames(&pHPFNode->hpf);
+
+    result = ma_hpf_reinit(pConfig, &pHPFNode->hpf);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    ma_node_update_default_tail_length(pNode, oldTailLength, ma_hpf_get_tail_length_in_frames(&pHPFNode->hpf));
+
+    return MA_SUCCESS;
 }
 
 MA_API void ma_hpf_node_uninit(ma_hpf_node* pNode, const ma_allocation_callbacks* pAllocationCallbacks)
@@ -73441,9 +81907,10 @@ MA_API ma_result ma_bpf_node_init(ma_node_graph* pNodeGraph, const ma_bpf_node_c
     }
 
     baseNodeConfig = ma_node_config_init();
-    baseNodeConfig.vtable          = &g_ma_bpf_node_vtable;
-    baseNodeConfig.pInputChannels  = &pConfig->bpf.channels;
-    baseNodeConfig.pOutputChannels = &pConfig->bpf.channels;
+    baseNodeConfig.vtable             = &g_ma_bpf_node_vtable;
+    baseNodeConfig.pInputChannels     = &pConfig->bpf.channels;
+    baseNodeConfig.pOutputChannels    = &pConfig->bpf.channels;
+    baseNodeConfig.tailLengthInFrames = ma_bpf_get_tail_length_in_frames(&pNode->bpf);
 
     result = ma_node_init(pNodeGraph, &baseNodeConfig, pAllocationCallbacks, pNode);
     if (result != MA_SUCCESS) {
@@ -73456,12 +81923,23 @@ MA_API ma_result ma_bpf_node_init(ma_node_graph* pNodeGraph, const ma_bpf_node_c
 MA_API ma_result ma_bpf_node_reinit(const ma_bpf_config* pConfig, ma_bpf_node* pNode)
 {
     ma_bpf_node* pBPFNode = (ma_bpf_node*)pNode;
+    ma_result result;
+    ma_uint32 oldTailLength;
 
     if (pNode == NULL) {
         return MA_INVALID_ARGS;
     }
 
-    return ma_bpf_reinit(pConfig, &pBPFNode->bpf);
+    oldTailLength = ma_bpf_get_tail_length_in_frames(&pBPFNode->bpf);
+
+    result = ma_bpf_reinit(pConfig, &pBPFNode->bpf);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    ma_node_update_default_tail_length(pNode, oldTailLength, ma_bpf_get_tail_length_in_frames(&pBPFNode->bpf));
+
+    return MA_SUCCESS;
 }
 
 MA_API void ma_bpf_node_uninit(ma_bpf_node* pNode, const ma_allocation_callbacks* pAllocationCallbacks)
@@ -73535,9 +82013,10 @@ MA_API ma_result ma_notch_node_init(ma_node_graph* pNodeGraph, const ma_notch_no
     }
 
     baseNodeConfig = ma_node_config_init();
-    baseNodeConfig.vtable          = &g_ma_notch_node_vtable;
-    baseNodeConfig.pInputChannels  = &pConfig->notch.channels;
-    baseNodeConfig.pOutputChannels = &pConfig->notch.channels;
+    baseNodeConfig.vtable             = &g_ma_notch_node_vtable;
+    baseNodeConfig.pInputChannels     = &pConfig->notch.channels;
+    baseNodeConfig.pOutputChannels    = &pConfig->notch.channels;
+    baseNodeConfig.tailLengthInFrames = ma_biquad_get_tail_length_in_frames(&pNode->notch.bq);
 
     result = ma_node_init(pNodeGraph, &baseNodeConfig, pAllocationCallbacks, pNode);
     if (result != MA_SUCCESS) {
@@ -73550,12 +82029,23 @@ MA_API ma_result ma_notch_node_init(ma_node_graph* pNodeGraph, const ma_notch_no
 MA_API ma_result ma_notch_node_reinit(const ma_notch_config* pConfig, ma_notch_node* pNode)
 {
     ma_notch_node* pNotchNode = (ma_notch_node*)pNode;
+    ma_result result;
+    ma_uint32 oldTailLength;
 
     if (pNode == NULL) {
         return MA_INVALID_ARGS;
     }
 
-    return ma_notch2_reinit(pConfig, &pNotchNode->notch);
+    oldTailLength = ma_biquad_get_tail_length_in_frames(&pNotchNode->notch.bq);
+
+    result = ma_notch2_reinit(pConfig, &pNotchNode->notch);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    ma_node_update_default_tail_length(pNode, oldTailLength, ma_biquad_get_tail_length_in_frames(&pNotchNode->notch.bq));
+
+    return MA_SUCCESS;
 }
 
 MA_API void ma_notch_node_uninit(ma_notch_node* pNode, const ma_allocation_callbacks* pAllocationCallbacks)
@@ -73630,9 +82120,10 @@ MA_API ma_result ma_peak_node_init(ma_node_graph* pNodeGraph, const ma_peak_node
     }
 
     baseNodeConfig = ma_node_config_init();
-    baseNodeConfig.vtable          = &g_ma_peak_node_vtable;
-    baseNodeConfig.pInputChannels  = &pConfig->peak.channels;
-    baseNodeConfig.pOutputChannels = &pConfig->peak.channels;
+    baseNodeConfig.vtable             = &g_ma_peak_node_vtable;
+    baseNodeConfig.pInputChannels     = &pConfig->peak.channels;
+    baseNodeConfig.pOutputChannels    = &pConfig->peak.channels;
+    baseNodeConfig.tailLengthInFrames = ma_biquad_get_tail_length_in_frames(&pNode->peak.bq);
 
     result = ma_node_init(pNodeGraph, &baseNodeConfig, pAllocationCallbacks, pNode);
     if (result != MA_SUCCESS) {
@@ -73645,12 +82136,23 @@ MA_API ma_result ma_peak_node_init(ma_node_graph* pNodeGraph, const ma_peak_node
 MA_API ma_result ma_peak_node_reinit(const ma_peak_config* pConfig, ma_peak_node* pNode)
 {
     ma_peak_node* pPeakNode = (ma_peak_node*)pNode;
+    ma_result result;
+    ma_uint32 oldTailLength;
 
     if (pNode == NULL) {
         return MA_INVALID_ARGS;
     }
 
-    return ma_peak2_reinit(pConfig, &pPeakNode->peak);
+    oldTailLength = ma_biquad_get_tail_length_in_frames(&pPeakNode->peak.bq);
+
+    result = ma_peak2_reinit(pConfig, &pPeakNode->peak);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    ma_node_update_default_tail_length(pNode, oldTailLength, ma_biquad_get_tail_length_in_frames(&pPeakNode->peak.bq));
+
+    return MA_SUCCESS;
 }
 
 MA_API void ma_peak_node_uninit(ma_peak_node* pNode, const ma_allocation_callbacks* pAllocationCallbacks)
@@ -73724,9 +82226,10 @@ MA_API ma_result ma_loshelf_node_init(ma_node_graph* pNodeGraph, const ma_loshel
     }
 
     baseNodeConfig = ma_node_config_init();
-    baseNodeConfig.vtable          = &g_ma_loshelf_node_vtable;
-    baseNodeConfig.pInputChannels  = &pConfig->loshelf.channels;
-    baseNodeConfig.pOutputChannels = &pConfig->loshelf.channels;
+    baseNodeConfig.vtable             = &g_ma_loshelf_node_vtable;
+    baseNodeConfig.pInputChannels     = &pConfig->loshelf.channels;
+    baseNodeConfig.pOutputChannels    = &pConfig->loshelf.channels;
+    baseNodeConfig.tailLengthInFrames = ma_biquad_get_tail_length_in_frames(&pNode->loshelf.bq);
 
     result = ma_node_init(pNodeGraph, &baseNodeConfig, pAllocationCallbacks, pNode);
     if (result != MA_SUCCESS) {
@@ -73739,12 +82242,23 @@ MA_API ma_result ma_loshelf_node_init(ma_node_graph* pNodeGraph, const ma_loshel
 MA_API ma_result ma_loshelf_node_reinit(const ma_loshelf_config* pConfig, ma_loshelf_node* pNode)
 {
     ma_loshelf_node* pLoshelfNode = (ma_loshelf_node*)pNode;
+    ma_result result;
+    ma_uint32 oldTailLength;
 
     if (pNode == NULL) {
         return MA_INVALID_ARGS;
     }
 
-    return ma_loshelf2_reinit(pConfig, &pLoshelfNode->loshelf);
+    oldTailLength = ma_biquad_get_tail_length_in_frames(&pLoshelfNode->loshelf.bq);
+
+    result = ma_loshelf2_reinit(pConfig, &pLoshelfNode->loshelf);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    ma_node_update_default_tail_length(pNode, oldTailLength, ma_biquad_get_tail_length_in_frames(&pLoshelfNode->loshelf.bq));
+
+    return MA_SUCCESS;
 }
 
 MA_API void ma_loshelf_node_uninit(ma_loshelf_node* pNode, const ma_allocation_callbacks* pAllocationCallbacks)
@@ -73818,9 +82332,10 @@ MA_API ma_result ma_hishelf_node_init(ma_node_graph* pNodeGraph, const ma_hishel
     }
 
     baseNodeConfig = ma_node_config_init();
-    baseNodeConfig.vtable          = &g_ma_hishelf_node_vtable;
-    baseNodeConfig.pInputChannels  = &pConfig->hishelf.channels;
-    baseNodeConfig.pOutputChannels = &pConfig->hishelf.channels;
+    baseNodeConfig.vtable             = &g_ma_hishelf_node_vtable;
+    baseNodeConfig.pInputChannels     = &pConfig->hishelf.channels;
+    baseNodeConfig.pOutputChannels    = &pConfig->hishelf.channels;
+    baseNodeConfig.tailLengthInFrames = ma_biquad_get_tail_length_in_frames(&pNode->hishelf.bq);
 
     result = ma_node_init(pNodeGraph, &baseNodeConfig, pAllocationCallbacks, pNode);
     if (result != MA_SUCCESS) {
@@ -73833,12 +82348,23 @@ MA_API ma_result ma_hishelf_node_init(ma_node_graph* pNodeGraph, const ma_hishel
 MA_API ma_result ma_hishelf_node_reinit(const ma_hishelf_config* pConfig, ma_hishelf_node* pNode)
 {
     ma_hishelf_node* pHishelfNode = (ma_hishelf_node*)pNode;
+    ma_result result;
+    ma_uint32 oldTailLength;
 
     if (pNode == NULL) {
         return MA_INVALID_ARGS;
     }
 
-    return ma_hishelf2_reinit(pConfig, &pHishelfNode->hishelf);
+    oldTailLength = ma_biquad_get_tail_length_in_frames(&pHishelfNode->hishelf.bq);
+
+    result = ma_hishelf2_reinit(pConfig, &pHishelfNode->hishelf);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    ma_node_update_default_tail_length(pNode, oldTailLength, ma_biquad_get_tail_length_in_frames(&pHishelfNode->hishelf.bq));
+
+    return MA_SUCCESS;
 }
 
 MA_API void ma_hishelf_node_uninit(ma_hishelf_node* pNode, const ma_allocation_callbacks* pAllocationCallbacks)
@@ -73906,6 +82432,11 @@ MA_API ma_result ma_delay_node_init(ma_node_graph* pNodeGraph, const ma_delay_no
     baseConfig.pInputChannels  = &pConfig->delay.channels;
     baseConfig.pOutputChannels = &pConfig->delay.channels;
 
+    /* Unless told otherwise, the tail lasts until the echoes have died away. */
+    if (baseConfig.tailLengthInFrames == MA_NODE_TAIL_LENGTH_INFINITE) {
+        baseConfig.tailLengthInFrames = ma_delay_get_tail_length_in_frames(&pDelayNode->delay);
+    }
+
     result = ma_node_init(pNodeGraph, &baseConfig, pAllocationCallbacks, &pDelayNode->baseNode);
     if (result != MA_SUCCESS) {
         ma_delay_uninit(&pDelayNode->delay, pAllocationCallbacks);
@@ -73964,11 +82495,15 @@ MA_API float ma_delay_node_get_dry(const ma_delay_node* pDelayNode)
 
 MA_API void ma_delay_node_set_decay(ma_delay_node* pDelayNode, float value)
 {
+    ma_uint32 oldTailLength;
+
     if (pDelayNode == NULL) {
         return;
     }
 
+    oldTailLength = ma_delay_get_tail_length_in_frames(&pDelayNode->delay);
     ma_delay_set_decay(&pDelayNode->delay, value);
+    ma_node_update_default_tail_length(pDelayNode, oldTailLength, ma_delay_get_tail_length_in_frames(&pDelayNode->delay));
 }
 
 MA_API float ma_delay_node_get_decay(const ma_delay_node* pDelayNode)
@@ -73979,6 +82514,81 @@ MA_API float ma_delay_node_get_decay(const ma_delay_node* pDelayNode)
 
     return ma_delay_get_decay(&pDelayNode->delay);
 }
+
+
+MA_API ma_ambisonic_decoder_node_config ma_ambisonic_decoder_node_config_init(ma_uint32 order, ma_uint32 channelsOut, const ma_channel* pChannelMapOut)
+{
+    ma_ambisonic_decoder_node_config config;
+
+    config.nodeConfig = ma_node_config_init();
+    config.decoder = ma_ambisonic_decoder_config_init(order, channelsOut, pChannelMapOut);
+
+    return config;
+}
+
+
+static void ma_ambisonic_decoder_node_process_pcm_frames(ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut)
+{
+    ma_ambisonic_decoder_node* pDecoderNode = (ma_ambisonic_decoder_node*)pNode;
+
+    (void)pFrameCountIn;
+
+    ma_ambisonic_decoder_process_pcm_frames(&pDecoderNode->decoder, ppFramesOut[0], ppFramesIn[0], *pFrameCountOut);
+}
+
+static ma_node_vtable g_ma_ambisonic_decoder_node_vtable =
+{
+    ma_ambisonic_decoder_node_process_pcm_frames,
+    NULL,
+    1,  /* 1 input bus. */
+    1,  /* 1 output bus. */
+    0
+};
+
+MA_API ma_result ma_ambisonic_decoder_node_init(ma_node_graph* pNodeGraph, const ma_ambisonic_decoder_node_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_ambisonic_decoder_node* pDecoderNode)
+{
+    ma_result result;
+    ma_node_config baseConfig;
+
+    if (pDecoderNode == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    MA_ZERO_OBJECT(pDecoderNode);
+
+    if (pConfig == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    result = ma_ambisonic_decoder_init(&pConfig->decoder, pAllocationCallbacks, &pDecoderNode->decoder);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    baseConfig = pConfig->nodeConfig;
+    baseConfig.vtable          = &g_ma_ambisonic_decoder_node_vtable;
+    baseConfig.pInputChannels  = &pDecoderNode->decoder.channelsIn;
+    baseConfig.pOutputChannels = &pDecoderNode->decoder.channelsOut;
+
+    result = ma_node_init(pNodeGraph, &baseConfig, pAllocationCallbacks, &pDecoderNode->baseNode);
+    if (result != MA_SUCCESS) {
+        ma_ambisonic_decoder_uninit(&pDecoderNode->decoder, pAllocationCallbacks);
+        return result;
+    }
+
+    return result;
+}
+
+MA_API void ma_ambisonic_decoder_node_uninit(ma_ambisonic_decoder_node* pDecoderNode, const ma_allocation_callbacks* pAllocationCallbacks)
+{
+    if (pDecoderNode == NULL) {
+        return;
+    }
+
+    /* The base node is always uninitialized first. */
+    ma_node_uninit(pDecoderNode, pAllocationCallbacks);
+    ma_ambisonic_decoder_uninit(&pDecoderNode->decoder, pAllocationCallbacks);
+}
 #endif  /* MA_NO_NODE_GRAPH */
 
 
@@ -74012,6 +82622,8 @@ static ma_bool32 ma_sound_get_at_end(const ma_sound* pSound)
 }
 
 
+#define MA_ENGINE_VIRTUALIZATION_KEY_COUNT  (256 * 16)   /* One key for each combination of priority and 6dB audibility step. */
+
 MA_API ma_engine_node_config ma_engine_node_config_init(ma_engine* pEngine, ma_engine_node_type type, ma_uint32 flags)
 {
     ma_engine_node_config config;
@@ -74022,32 +82634,149 @@ MA_API ma_engine_node_config ma_engine_node_config_init(ma_engine* pEngine, ma_e
     config.isPitchDisabled          = (flags & MA_SOUND_FLAG_NO_PITCH) != 0;
     config.isSpatializationDisabled = (flags & MA_SOUND_FLAG_NO_SPATIALIZATION) != 0;
     config.monoExpansionMode        = pEngine->monoExpansionMode;
+    config.priority                 = MA_SOUND_PRIORITY_DEFAULT;
 
     return config;
 }
 
 
+static void ma_engine_node_process_pcm_frames__group(ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut);
+
+#define MA_ENGINE_MAX_SAMPLE_RATE_SEARCH_DEPTH  16
+
+static ma_uint32 ma_engine_get_node_sample_rate_from(const ma_engine* pEngine, const ma_node* pNode, ma_bool32 followFirst)
+{
+    ma_node_output_bus* pReferencedBuses[MA_ENGINE_MAX_SAMPLE_RATE_SEARCH_DEPTH];
+    ma_uint32 referencedBusCount = 0;
+    ma_uint32 sampleRate = ma_engine_get_sample_rate(pEngine);
+    ma_uint32 depth;
+
+    /*
+    Groups mix their input at their own sample rate. Nodes that don't do any resampling of their own, such as effects,
+    run at the rate of whatever they're attached to, so we follow them along until we find a group. Everything else
+    runs at the engine's sample rate. The depth is limited because the graph is allowed to have feedback loops when
+    it's processed on a single thread.
+
+    This is called from the audio thread so the walk needs to be safe against nodes being detached and uninitialized
+    at the same time. We use the same protocol as input bus iteration: a reference is taken on each output bus before
+    looking at what it's attached to, and detaching waits for that reference to be released. Since uninitializing a
+    node detaches everything attached to it, holding a reference on the output bus keeps the node it points to alive.
+    */
+    for (depth = 0; pNode != NULL && depth < MA_ENGINE_MAX_SAMPLE_RATE_SEARCH_DEPTH; depth += 1) {
+        const ma_node_base* pNodeBase = (const ma_node_base*)pNode;
+        ma_node_output_bus* pOutputBus;
+
+        if (!followFirst || depth > 0) {
+            if (pNodeBase->vtable->onProcess == ma_engine_node_process_pcm_frames__group) {
+                sampleRate = ((const ma_engine_node*)pNode)->sampleRate;
+                break;
+            }
+
+            if ((pNodeBase->vtable->flags & MA_NODE_FLAG_DIFFERENT_PROCESSING_RATES) != 0) {
+                break;
+            }
+        }
+
+        if (pNodeBase->outputBusCount == 0) {
+            break;
+        }
+
+        pOutputBus = &pNodeBase->pOutputBuses[0];
+        ma_atomic_fetch_add_32(&pOutputBus->refCount, 1);
+        pReferencedBuses[referencedBusCount++] = pOutputBus;
+
+        if (ma_node_output_bus_is_attached(pOutputBus) == MA_FALSE) {
+            break;
+        }
+
+        pNode = (const ma_node*)ma_atomic_load_ptr(&pOutputBus->pInputNode);
+    }
+
+    while (referencedBusCount > 0) {
+        referencedBusCount -= 1;
+        ma_atomic_fetch_sub_32(&pReferencedBuses[referencedBusCount]->refCount, 1);
+    }
+
+    return sampleRate;
+}
+
+static ma_uint32 ma_engine_get_node_input_sample_rate(const ma_engine* pEngine, const ma_node* pNode)
+{
+    return ma_engine_get_node_sample_rate_from(pEngine, pNode, MA_FALSE);
+}
+
+#define MA_ENGINE_LOD_DOPPLER_FADE_TIME_IN_MILLISECONDS  100  /* Longer than the gain smoothing time because the resampler's rate only changes between blocks. */
+
+static void ma_engine_node_update_doppler_weight(ma_engine_node* pEngineNode)
+{
+    ma_uint64 time;
+    ma_uint64 elapsedTimeInFrames;
+    ma_uint32 fadeTimeInFrames;
+    float weightTarget;
+
+    /* This is based on time rather than calls so that it's safe to call this more than once for the same block. */
+    time = ma_node_get_time(pEngineNode);
+    fadeTimeInFrames = ma_max(1, (MA_ENGINE_LOD_DOPPLER_FADE_TIME_IN_MILLISECONDS * ma_engine_get_sample_rate(pEngineNode->pEngine)) / 1000);
+
+    if (time >= pEngineNode->dopplerWeightTime) {
+        elapsedTimeInFrames = time - pEngineNode->dopplerWeightTime;
+    } else {
+        elapsedTimeInFrames = fadeTimeInFrames; /* Seeking can move time backwards. Just jump to the target. */
+    }
+
+    pEngineNode->dopplerWeightTime = time;
+
+    weightTarget = (ma_atomic_load_32(&pEngineNode->lod) >= ma_sound_lod_reduced) ? 0.0f : 1.0f;
+    if (elapsedTimeInFrames >= fadeTimeInFrames) {
+        pEngineNode->dopplerWeight = weightTarget;
+    } else if (pEngineNode->dopplerWeight < weightTarget) {
+        pEngineNode->dopplerWeight = ma_min(pEngineNode->dopplerWeight + (float)elapsedTimeInFrames / fadeTimeInFrames, weightTarget);
+    } else if (pEngineNode->dopplerWeight > weightTarget) {
+        pEngineNode->dopplerWeight = ma_max(pEngineNode->dopplerWeight - (float)elapsedTimeInFrames / fadeTimeInFrames, weightTarget);
+    }
+}
+
 static void ma_engine_node_update_pitch_if_required(ma_engine_node* pEngineNode)
 {
     ma_bool32 isUpdateRequired = MA_FALSE;
     float newPitch;
+    float newDopplerPitch;
+    ma_uint32 newSampleRateOut;
 
     MA_ASSERT(pEngineNode != NULL);
 
     newPitch = ma_atomic_load_explicit_f32(&pEngineNode->pitch, ma_atomic_memory_order_acquire);
 
+    /*
+    The node may have been attached to a group running at a different sample rate since it was initialized, in
+    which case the output rate of the resampler needs to follow it.
+    */
+    if (ma_node_output_bus_is_attached(&pEngineNode->baseNode.pOutputBuses[0])) {
+        newSampleRateOut = ma_engine_get_node_sample_rate_from(pEngineNode->pEngine, pEngineNode, MA_TRUE);
+        if (pEngineNode->sampleRateOut != newSampleRateOut) {
+            pEngineNode->sampleRateOut = newSampleRateOut;
+            isUpdateRequired = MA_TRUE;
+        }
+    }
+
     if (pEngineNode->oldPitch != newPitch) {
         pEngineNode->oldPitch  = newPitch;
         isUpdateRequired = MA_TRUE;
     }
 
-    if (pEngineNode->oldDopplerPitch != pEngineNode->spatializer.dopplerPitch) {
-        pEngineNode->oldDopplerPitch  = pEngineNode->spatializer.dopplerPitch;
+    /*
+    Doppler is dropped at reduced levels of detail. Changing the rate of the resampler doesn't cause a
+    discontinuity, but the pitch would audibly jump so it's faded in and out.
+    */
+    ma_engine_node_update_doppler_weight(pEngineNode);
+    newDopplerPitch = 1 + (pEngineNode->spatializer.dopplerPitch - 1) * pEngineNode->dopplerWeight;
+    if (pEngineNode->oldDopplerPitch != newDopplerPitch) {
+        pEngineNode->oldDopplerPitch  = newDopplerPitch;
         isUpdateRequired = MA_TRUE;
     }
 
     if (isUpdateRequired) {
-        float basePitch = (float)pEngineNode->sampleRate / ma_engine_get_sample_rate(pEngineNode->pEngine);
+        float basePitch = (float)pEngineNode->sampleRate / pEngineNode->sampleRateOut;
         ma_linear_resampler_set_rate_ratio(&pEngineNode->resampler, basePitch * pEngineNode->oldPitch * pEngineNode->oldDopplerPitch);
     }
 }
@@ -74057,7 +82786,7 @@ static ma_bool32 ma_engine_node_is_pitching_enabled(const ma_engine_node* pEngin
     MA_ASSERT(pEngineNode != NULL);
 
     /* Don't try to be clever by skiping resampling in the pitch=1 case or else you'll glitch when moving away from 1. */
-    return !ma_atomic_load_explicit_32(&pEngineNode->isPitchDisabled, ma_atomic_memory_order_acquire);
+    return !ma_atomic_load_explicit_32(&pEngineNode->isPitchDisabled, ma_atomic_memory_order_acquire) || pEngineNode->sampleRate != pEngineNode->sampleRateOut;
 }
 
 static ma_bool32 ma_engine_node_is_spatialization_enabled(const ma_engine_node* pEngineNode)
@@ -74121,6 +82850,458 @@ static ma_result ma_engine_node_get_volume(const ma_engine_node* pEngineNode, fl
 }
 
 
+static void ma_engine_node_update_fade_if_required(ma_engine_node* pEngineNode)
+{
+    ma_uint64 fadeLengthInFrames = ma_atomic_uint64_get(&pEngineNode->fadeSettings.fadeLengthInFrames);
+    if (fadeLengthInFrames != ~(ma_uint64)0) {
+        float fadeVolumeBeg = ma_atomic_float_get(&pEngineNode->fadeSettings.volumeBeg);
+        float fadeVolumeEnd = ma_atomic_float_get(&pEngineNode->fadeSettings.volumeEnd);
+        ma_int64 fadeStartOffsetInFrames = (ma_int64)ma_atomic_uint64_get(&pEngineNode->fadeSettings.absoluteGlobalTimeInFrames);
+        if (fadeStartOffsetInFrames == (ma_int64)(~(ma_uint64)0)) {
+            fadeStartOffsetInFrames = 0;
+        } else {
+            fadeStartOffsetInFrames -= ma_engine_get_time_in_pcm_frames(pEngineNode->pEngine);
+        }
+
+        ma_fader_set_fade_ex(&pEngineNode->fader, fadeVolumeBeg, fadeVolumeEnd, fadeLengthInFrames, fadeStartOffsetInFrames);
+
+        /* Reset the fade length so we don't erroneously apply it again. */
+        ma_atomic_uint64_set(&pEngineNode->fadeSettings.fadeLengthInFrames, ~(ma_uint64)0);
+    }
+}
+
+static ma_uint32 ma_engine_node_get_listener_index(ma_engine_node* pEngineNode)
+{
+    /*
+    When determining the listener to use, we first check to see if the sound is pinned to a
+    specific listener. If so, we use that. Otherwise we just use the closest listener.
+    */
+    if (pEngineNode->pinnedListenerIndex != MA_LISTENER_INDEX_CLOSEST && pEngineNode->pinnedListenerIndex < ma_engine_get_listener_count(pEngineNode->pEngine)) {
+        return pEngineNode->pinnedListenerIndex;
+    } else {
+        ma_vec3f spatializerPosition = ma_spatializer_get_position(&pEngineNode->spatializer);
+        return ma_engine_find_closest_listener(pEngineNode->pEngine, spatializerPosition.x, spatializerPosition.y, spatializerPosition.z);
+    }
+}
+
+static void ma_spatializer_batch_copy_slot(ma_spatializer_batch* pBatch, ma_uint32 dst, ma_uint32 src)
+{
+    pBatch->pPositionX[dst]          = pBatch->pPositionX[src];
+    pBatch->pPositionY[dst]          = pBatch->pPositionY[src];
+    pBatch->pPositionZ[dst]          = pBatch->pPositionZ[src];
+    pBatch->pDirectionX[dst]         = pBatch->pDirectionX[src];
+    pBatch->pDirectionY[dst]         = pBatch->pDirectionY[src];
+    pBatch->pDirectionZ[dst]         = pBatch->pDirectionZ[src];
+    pBatch->pVelocityX[dst]          = pBatch->pVelocityX[src];
+    pBatch->pVelocityY[dst]          = pBatch->pVelocityY[src];
+    pBatch->pVelocityZ[dst]          = pBatch->pVelocityZ[src];
+    pBatch->pMinDistance[dst]        = pBatch->pMinDistance[src];
+    pBatch->pMaxDistance[dst]        = pBatch->pMaxDistance[src];
+    pBatch->pRolloff[dst]            = pBatch->pRolloff[src];
+    pBatch->pMinGain[dst]            = pBatch->pMinGain[src];
+    pBatch->pMaxGain[dst]            = pBatch->pMaxGain[src];
+    pBatch->pConeInnerCos[dst]       = pBatch->pConeInnerCos[src];
+    pBatch->pConeOuterCos[dst]       = pBatch->pConeOuterCos[src];
+    pBatch->pConeOuterGain[dst]      = pBatch->pConeOuterGain[src];
+    pBatch->pDopplerFactor[dst]      = pBatch->pDopplerFactor[src];
+    pBatch->pAttenuationModel[dst]   = pBatch->pAttenuationModel[src];
+    pBatch->pPositioning[dst]        = pBatch->pPositioning[src];
+    pBatch->pListenerIndex[dst]      = pBatch->pListenerIndex[src];
+    pBatch->pGain[dst]               = pBatch->pGain[src];
+    pBatch->pDistance[dst]           = pBatch->pDistance[src];
+    pBatch->pRelativeDirectionX[dst] = pBatch->pRelativeDirectionX[src];
+    pBatch->pRelativeDirectionY[dst] = pBatch->pRelativeDirectionY[src];
+    pBatch->pRelativeDirectionZ[dst] = pBatch->pRelativeDirectionZ[src];
+    pBatch->pDopplerPitch[dst]       = pBatch->pDopplerPitch[src];
+}
+
+/*
+The spatializer batch is only ever changed by the thread that owns it, which is normally the audio
+thread. Sounds don't touch it directly. Instead they push themselves onto a lock-free stack with the
+change they want and the owner applies everything in the stack before gathering the batch.
+
+The audio thread takes ownership at the start of ma_engine_read_pcm_frames() by setting READING and
+gives it up at the end. It never waits. If another thread has set LOCKED, the batch is left alone
+for that call and every sound is spatialized on its own. LOCKED is only taken by ma_sound_uninit()
+when the audio thread isn't reading, so that removals still go through when nothing is reading.
+*/
+#define MA_SPATIALIZER_BATCH_STATE_READING      0x1
+#define MA_SPATIALIZER_BATCH_STATE_LOCKED       0x2
+
+#define MA_SPATIALIZER_BATCH_REQUEST_ADD        0x1
+#define MA_SPATIALIZER_BATCH_REQUEST_REMOVE     0x2
+#define MA_SPATIALIZER_BATCH_REQUEST_QUEUED     0x4
+
+static void ma_engine_push_spatializer_batch_request(ma_engine* pEngine, ma_engine_node* pEngineNode, ma_uint32 request)
+{
+    ma_uint32 oldRequest;
+
+    /* If the node is already in the stack, changing the request is enough. The owner applies whatever the request is when it gets to it. */
+    oldRequest = ma_atomic_exchange_32(&pEngineNode->spatializerBatchRequest, request | MA_SPATIALIZER_BATCH_REQUEST_QUEUED);
+    if ((oldRequest & MA_SPATIALIZER_BATCH_REQUEST_QUEUED) != 0) {
+        return;
+    }
+
+    for (;;) {
+        void* pHead = ma_atomic_load_ptr(&pEngine->pSpatializerBatchRequests);
+        pEngineNode->pNextSpatializerBatchRequest = pHead;
+
+        if (ma_atomic_compare_and_swap_ptr((volatile void**)&pEngine->pSpatializerBatchRequests, pHead, pEngineNode) == pHead) {
+            break;
+        }
+    }
+}
+
+static void ma_engine_apply_spatializer_batch_request(ma_engine* pEngine, ma_engine_node* pEngineNode, ma_uint32 request)
+{
+    ma_uint32 index = ma_atomic_load_32(&pEngineNode->spatializerBatchIndex);
+
+    if ((request & MA_SPATIALIZER_BATCH_REQUEST_ADD) != 0) {
+        /* If the batch is full the node is just spatialized on its own. */
+        if (index == MA_SPATIALIZER_BATCH_INDEX_NONE && pEngine->spatializerBatch.count < pEngine->spatializerBatch.capacity) {
+            index = pEngine->spatializerBatch.count;
+
+            pEngine->ppSpatializerBatchNodes[index] = pEngineNode;
+            pEngine->spatializerBatch.count = index + 1;
+            ma_atomic_exchange_32(&pEngineNode->spatializerBatchIndex, index);
+        }
+    }
+
+    if ((request & MA_SPATIALIZER_BATCH_REQUEST_REMOVE) != 0) {
+        if (index != MA_SPATIALIZER_BATCH_INDEX_NONE) {
+            ma_uint32 lastIndex = pEngine->spatializerBatch.count - 1;
+
+            /*
+            The last slot is moved into the one being removed to keep the batch tightly packed. The results are moved
+            with it so that the moved node sees the same values whichever slot it reads from.
+            */
+            if (index != lastIndex) {
+                ma_spatializer_batch_copy_slot(&pEngine->spatializerBatch, index, lastIndex);
+                pEngine->ppSpatializerBatchNodes[index] = pEngine->ppSpatializerBatchNodes[lastIndex];
+                ma_atomic_exchange_32(&pEngine->ppSpatializerBatchNodes[index]->spatializerBatchIndex, index);
+            }
+
+            pEngine->spatializerBatch.count = lastIndex;
+            ma_atomic_exchange_32(&pEngineNode->spatializerBatchIndex, MA_SPATIALIZER_BATCH_INDEX_NONE);
+        }
+    }
+}
+
+static void ma_engine_apply_spatializer_batch_requests(ma_engine* pEngine)
+{
+    /* Must only be called by the thread that owns the batch. */
+    ma_engine_node* pEngineNode = (ma_engine_node*)ma_atomic_exchange_ptr(&pEngine->pSpatializerBatchRequests, NULL);
+    ma_engine_node* pReversed = NULL;
+
+    /* The stack is in reverse order. Put it back in the order the requests were made so sounds fill the batch in the order they were initialized. */
+    while (pEngineNode != NULL) {
+        ma_engine_node* pNext = (ma_engine_node*)pEngineNode->pNextSpatializerBatchRequest;
+        pEngineNode->pNextSpatializerBatchRequest = pReversed;
+        pReversed   = pEngineNode;
+        pEngineNode = pNext;
+    }
+
+    pEngineNode = pReversed;
+    while (pEngineNode != NULL) {
+        ma_engine_node* pNext = (ma_engine_node*)pEngineNode->pNextSpatializerBatchRequest;
+
+        /*
+        The request is only cleared once it's been applied because ma_sound_uninit() waits on it. If the request
+        was changed while we were applying it, the new one needs to be applied as well.
+        */
+        for (;;) {
+            ma_uint32 request = ma_atomic_load_32(&pEngineNode->spatializerBatchRequest);
+
+            ma_engine_apply_spatializer_batch_request(pEngine, pEngineNode, request);
+
+            if (ma_atomic_compare_and_swap_32(&pEngineNode->spatializerBatchRequest, request, 0) == request) {
+                break;
+            }
+        }
+
+        pEngineNode = pNext;    /* Can't touch pEngineNode after clearing its request because it might have been uninitialized. */
+    }
+}
+
+static void ma_engine_add_to_spatializer_batch(ma_engine* pEngine, ma_engine_node* pEngineNode)
+{
+    if (pEngine->ppSpatializerBatchNodes == NULL) {
+        return; /* Batching is disabled. */
+    }
+
+    /* The node is spatialized on its own until the audio thread gets to the request. */
+    ma_engine_push_spatializer_batch_request(pEngine, pEngineNode, MA_SPATIALIZER_BATCH_REQUEST_ADD);
+}
+
+static void ma_engine_remove_from_spatializer_batch(ma_engine* pEngine, ma_engine_node* pEngineNode)
+{
+    if (pEngine->ppSpatializerBatchNodes == NULL) {
+        return; /* Batching is disabled. */
+    }
+
+    if (ma_atomic_load_32(&pEngineNode->spatializerBatchRequest) == 0 && ma_atomic_load_32(&pEngineNode->spatializerBatchIndex) == MA_SPATIALIZER_BATCH_INDEX_NONE) {
+        return; /* Not in the batch and not about to be. Only the uninitializing thread can add it, so this can't change. */
+    }
+
+    ma_engine_push_spatializer_batch_request(pEngine, pEngineNode, MA_SPATIALIZER_BATCH_REQUEST_REMOVE);
+
+    /*
+    The node is about to be freed so we can't return until the request has been applied. The audio thread
+    applies it at the start of its next read. If it's not reading we apply it ourselves.
+    */
+    while (ma_atomic_load_32(&pEngineNode->spatializerBatchRequest) != 0) {
+        ma_uint32 state = ma_atomic_load_32(&pEngine->spatializerBatchState);
+
+        if (state == 0 && ma_atomic_compare_and_swap_32(&pEngine->spatializerBatchState, 0, MA_SPATIALIZER_BATCH_STATE_LOCKED) == 0) {
+            ma_engine_apply_spatializer_batch_requests(pEngine);
+            ma_atomic_fetch_and_32(&pEngine->spatializerBatchState, ~MA_SPATIALIZER_BATCH_STATE_LOCKED);
+        } else {
+            ma_yield();
+        }
+    }
+}
+
+static void ma_engine_begin_spatializer_batch(ma_engine* pEngine)
+{
+    ma_uint32 iNode;
+    ma_uint32 iListener;
+
+    pEngine->isSpatializerBatchInUse = MA_FALSE;
+
+    if (pEngine->ppSpatializerBatchNodes == NULL) {
+        return; /* Batching is disabled. */
+    }
+
+    /* Another thread has the batch. Leave it for this call and let every sound spatialize itself. */
+    if ((ma_atomic_fetch_or_32(&pEngine->spatializerBatchState, MA_SPATIALIZER_BATCH_STATE_READING) & MA_SPATIALIZER_BATCH_STATE_LOCKED) != 0) {
+        ma_atomic_fetch_and_32(&pEngine->spatializerBatchState, ~MA_SPATIALIZER_BATCH_STATE_READING);
+        return;
+    }
+
+    pEngine->isSpatializerBatchInUse = MA_TRUE;
+
+    ma_engine_apply_spatializer_batch_requests(pEngine);
+
+    /* Gather the current state of each sound into the batch, and then calculate everything in one pass for each listener. */
+    for (iNode = 0; iNode < pEngine->spatializerBatch.count; iNode += 1) {
+        ma_engine_node* pEngineNode = pEngine->ppSpatializerBatchNodes[iNode];
+        ma_spatializer_batch_set_source(&pEngine->spatializerBatch, iNode, &pEngineNode->spatializer, ma_engine_node_get_listener_index(pEngineNode));
+    }
+
+    for (iListener = 0; iListener < pEngine->listenerCount; iListener += 1) {
+        ma_spatializer_batch_process(&pEngine->spatializerBatch, &pEngine->listeners[iListener], iListener);
+    }
+}
+
+static void ma_engine_end_spatializer_batch(ma_engine* pEngine)
+{
+    if (pEngine->isSpatializerBatchInUse) {
+        pEngine->isSpatializerBatchInUse = MA_FALSE;
+        ma_atomic_fetch_and_32(&pEngine->spatializerBatchState, ~MA_SPATIALIZER_BATCH_STATE_READING);
+    }
+}
+
+static ma_uint32 ma_engine_node_get_spatializer_batch_index(const ma_engine_node* pEngineNode)
+{
+    /* The batch can only be used while the thread that's processing the node owns it. */
+    if (pEngineNode->pEngine->isSpatializerBatchInUse == MA_FALSE) {
+        return MA_SPATIALIZER_BATCH_INDEX_NONE;
+    }
+
+    return ma_atomic_load_32(&pEngineNode->spatializerBatchIndex);
+}
+
+/*
+Fused kernels for the final stage of a sound that isn't being spatialized. The generic path does
+channel expansion, volume and panning as separate passes over the output buffer. For the common
+stereo output case these are instead done together in a single pass. These produce exactly the
+same result as the generic path.
+*/
+static void ma_engine_node_apply_volume_and_pan_f32__mono_to_stereo(float* pFramesOut, const float* pFramesIn, ma_uint32 frameCount, float volume, float factor0, float factor1, ma_pan_mode panMode, float pan)
+{
+    ma_uint32 iFrame;
+
+    if (pan == 0) {
+        for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+            float x = pFramesIn[iFrame] * volume;
+            pFramesOut[iFrame*2 + 0] = x;
+            pFramesOut[iFrame*2 + 1] = x;
+        }
+    } else if (panMode == ma_pan_mode_balance) {
+        if (pan > 0) {
+            for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+                float x = pFramesIn[iFrame] * volume;
+                pFramesOut[iFrame*2 + 0] = x * factor0;
+                pFramesOut[iFrame*2 + 1] = x;
+            }
+        } else {
+            for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+                float x = pFramesIn[iFrame] * volume;
+                pFramesOut[iFrame*2 + 0] = x;
+                pFramesOut[iFrame*2 + 1] = x * factor0;
+            }
+        }
+    } else {
+        if (pan > 0) {
+            for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+                float x = pFramesIn[iFrame] * volume;
+                pFramesOut[iFrame*2 + 0] = x * factor0;
+                pFramesOut[iFrame*2 + 1] = (x * factor1) + x;
+            }
+        } else {
+            for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+                float x = pFramesIn[iFrame] * volume;
+                pFramesOut[iFrame*2 + 0] = x + (x * factor0);
+                pFramesOut[iFrame*2 + 1] = (x * factor1);
+            }
+        }
+    }
+}
+
+static void ma_engine_node_apply_volume_and_pan_f32__stereo(float* pFramesOut, const float* pFramesIn, ma_uint32 frameCount, float volume, float factor0, float factor1, ma_pan_mode panMode, float pan)
+{
+    /* This supports in-place processing. */
+    ma_uint32 iFrame;
+
+    if (pan == 0) {
+        for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+            pFramesOut[iFrame*2 + 0] = pFramesIn[iFrame*2 + 0] * volume;
+            pFramesOut[iFrame*2 + 1] = pFramesIn[iFrame*2 + 1] * volume;
+        }
+    } else if (panMode == ma_pan_mode_balance) {
+        if (pan > 0) {
+            for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+                pFramesOut[iFrame*2 + 0] = (pFramesIn[iFrame*2 + 0] * volume) * factor0;
+                pFramesOut[iFrame*2 + 1] =  pFramesIn[iFrame*2 + 1] * volume;
+            }
+        } else {
+            for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+                pFramesOut[iFrame*2 + 0] =  pFramesIn[iFrame*2 + 0] * volume;
+                pFramesOut[iFrame*2 + 1] = (pFramesIn[iFrame*2 + 1] * volume) * factor0;
+            }
+        }
+    } else {
+        if (pan > 0) {
+            for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+                float x0 = pFramesIn[iFrame*2 + 0] * volume;
+                float x1 = pFramesIn[iFrame*2 + 1] * volume;
+                pFramesOut[iFrame*2 + 0] = x0 * factor0;
+                pFramesOut[iFrame*2 + 1] = (x0 * factor1) + x1;
+            }
+        } else {
+            for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+                float x0 = pFramesIn[iFrame*2 + 0] * volume;
+                float x1 = pFramesIn[iFrame*2 + 1] * volume;
+                pFramesOut[iFrame*2 + 0] = x0 + (x1 * factor0);
+                pFramesOut[iFrame*2 + 1] = (x1 * factor1);
+            }
+        }
+    }
+}
+
+static ma_bool32 ma_engine_node_can_apply_volume_and_pan_fused(const ma_engine_node* pEngineNode, ma_uint32 channelsIn, ma_uint32 channelsOut)
+{
+    if (channelsOut != 2) {
+        return MA_FALSE;
+    }
+
+    if (channelsIn == 2) {
+        return MA_TRUE;
+    }
+
+    if (channelsIn == 1 && pEngineNode->monoExpansionMode == ma_mono_expansion_mode_duplicate) {
+        return MA_TRUE;
+    }
+
+    return MA_FALSE;
+}
+
+static void ma_engine_node_apply_volume_and_pan_fused(ma_engine_node* pEngineNode, float* pFramesOut, const float* pFramesIn, ma_uint32 frameCount, ma_uint32 channelsIn, float volume, ma_bool32 isPanningEnabled)
+{
+    float pan = (isPanningEnabled) ? pEngineNode->panner.pan : 0;
+    ma_pan_mode panMode = pEngineNode->panner.mode;
+    float factor0;
+    float factor1;
+
+    /* The factors are the same as what ma_stereo_balance_pcm_frames_f32() and ma_stereo_pan_pcm_frames_f32() use. */
+    if (panMode == ma_pan_mode_balance) {
+        factor0 = (pan > 0) ? 1.0f - pan : 1.0f + pan;
+        factor1 = 0;
+    } else {
+        factor0 = (pan > 0) ? 1.0f - pan : 0.0f - pan;
+        factor1 = (pan > 0) ? 0.0f + pan : 1.0f + pan;
+    }
+
+    if (channelsIn == 1) {
+        ma_engine_node_apply_volume_and_pan_f32__mono_to_stereo(pFramesOut, pFramesIn, frameCount, volume, factor0, factor1, panMode, pan);
+    } else {
+        ma_engine_node_apply_volume_and_pan_f32__stereo(pFramesOut, pFramesIn, frameCount, volume, factor0, factor1, panMode, pan);
+    }
+}
+
+static void ma_engine_node_mix_down_to_mono_f32(float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount, ma_uint32 channels)
+{
+    ma_uint64 iFrame;
+    ma_uint32 iChannel;
+    float scale = 1.0f / channels;
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        float x = 0;
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            x += pFramesIn[iFrame*channels + iChannel];
+        }
+
+        pFramesOut[iFrame] = x * scale;
+    }
+}
+
+static void ma_engine_node_expand_from_mono_f32(float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount, ma_uint32 channels)
+{
+    ma_uint64 iFrame;
+    ma_uint32 iChannel;
+
+    /* This is done backwards so that it can be done in place, with the input at the start of the output buffer. */
+    for (iFrame = frameCount; iFrame > 0; iFrame -= 1) {
+        float x = pFramesIn[iFrame - 1];
+
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            pFramesOut[(iFrame - 1)*channels + iChannel] = x;
+        }
+    }
+}
+
+static float ma_engine_node_apply_mono_width_f32(float* pFrames, ma_uint32 frameCount, ma_uint32 channels, float width, float widthTarget, float widthStep)
+{
+    /* Moves each channel towards the mix down of all channels. A width of 0 results in every channel being the same. */
+    ma_uint32 iFrame;
+    ma_uint32 iChannel;
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        float mean = 0;
+
+        if (width < widthTarget) {
+            width = ma_min(width + widthStep, widthTarget);
+        } else if (width > widthTarget) {
+            width = ma_max(width - widthStep, widthTarget);
+        }
+
+        if (width == 1) {
+            break;  /* Full width. Nothing more to do. */
+        }
+
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            mean += pFrames[iFrame*channels + iChannel];
+        }
+        mean /= channels;
+
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            pFrames[iFrame*channels + iChannel] = mean + (pFrames[iFrame*channels + iChannel] - mean) * width;
+        }
+    }
+
+    return width;
+}
+
 static void ma_engine_node_process_pcm_frames__general(ma_engine_node* pEngineNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut)
 {
     ma_uint32 frameCountIn;
@@ -74134,6 +83315,9 @@ static void ma_engine_node_process_pcm_frames__general(ma_engine_node* pEngineNo
     ma_bool32 isSpatializationEnabled;
     ma_bool32 isPanningEnabled;
     ma_bool32 isVolumeSmoothingEnabled;
+    ma_bool32 isFusedVolumeAndPanEnabled;
+    ma_bool32 isMonoResamplingRequested;
+    float monoWidthStep;
 
     frameCountIn  = *pFrameCountIn;
     frameCountOut = *pFrameCountOut;
@@ -74145,31 +83329,25 @@ static void ma_engine_node_process_pcm_frames__general(ma_engine_node* pEngineNo
     totalFramesProcessedOut = 0;
 
     /* Update the fader if applicable. */
-    {
-        ma_uint64 fadeLengthInFrames = ma_atomic_uint64_get(&pEngineNode->fadeSettings.fadeLengthInFrames);
-        if (fadeLengthInFrames != ~(ma_uint64)0) {
-            float fadeVolumeBeg = ma_atomic_float_get(&pEngineNode->fadeSettings.volumeBeg);
-            float fadeVolumeEnd = ma_atomic_float_get(&pEngineNode->fadeSettings.volumeEnd);
-            ma_int64 fadeStartOffsetInFrames = (ma_int64)ma_atomic_uint64_get(&pEngineNode->fadeSettings.absoluteGlobalTimeInFrames);
-            if (fadeStartOffsetInFrames == (ma_int64)(~(ma_uint64)0)) {
-                fadeStartOffsetInFrames = 0;
-            } else {
-                fadeStartOffsetInFrames -= ma_engine_get_time_in_pcm_frames(pEngineNode->pEngine);
-            }
-
-            ma_fader_set_fade_ex(&pEngineNode->fader, fadeVolumeBeg, fadeVolumeEnd, fadeLengthInFrames, fadeStartOffsetInFrames);
-
-            /* Reset the fade length so we don't erroneously apply it again. */
-            ma_atomic_uint64_set(&pEngineNode->fadeSettings.fadeLengthInFrames, ~(ma_uint64)0);
-        }
-    }
+    ma_engine_node_update_fade_if_required(pEngineNode);
 
     isPitchingEnabled        = ma_engine_node_is_pitching_enabled(pEngineNode);
     isFadingEnabled          = pEngineNode->fader.volumeBeg != 1 || pEngineNode->fader.volumeEnd != 1;
     isSpatializationEnabled  = ma_engine_node_is_spatialization_enabled(pEngineNode);
-    isPanningEnabled         = pEngineNode->panner.pan != 0 && channelsOut != 1;
+    isPanningEnabled         = pEngineNode->panner.pan != 0 && channelsOut != 1 && pEngineNode->ambisonicOrder == 0;  /* Panning doesn't apply to an ambisonic sound field. */
     isVolumeSmoothingEnabled = pEngineNode->volumeSmoothTimeInPCMFrames > 0;
 
+    /* When we're not spatializing we can usually do channel conversion, volume and panning in one go. */
+    isFusedVolumeAndPanEnabled = !isSpatializationEnabled && ma_engine_node_can_apply_volume_and_pan_fused(pEngineNode, channelsIn, channelsOut);
+
+    /*
+    At the minimal level of detail, sounds with more than one channel are resampled in mono. So this is seamless, the
+    image is narrowed down to mono over the gain smoothing time before the resampler is switched over. Switching back
+    works the other way around.
+    */
+    isMonoResamplingRequested = isPitchingEnabled && isSpatializationEnabled && channelsIn > 1 && ma_atomic_load_32(&pEngineNode->lod) == ma_sound_lod_minimal;
+    monoWidthStep = 1.0f / ma_max(1, pEngineNode->pEngine->gainSmoothTimeInFrames);
+
     /* Keep going while we've still got data available for processing. */
     while (totalFramesProcessedOut < frameCountOut) {
         /*
@@ -74205,6 +83383,14 @@ static void ma_engine_node_process_pcm_frames__general(ma_engine_node* pEngineNo
         framesAvailableIn  = frameCountIn  - totalFramesProcessedIn;
         framesAvailableOut = frameCountOut - totalFramesProcessedOut;
 
+        if (pEngineNode->isMonoResampling && !isMonoResamplingRequested) {
+            ma_linear_resampler_set_channels_f32(&pEngineNode->resampler, channelsIn);
+            pEngineNode->isMonoResampling = MA_FALSE;   /* The width will be zero at this point. It'll be widened back out below. */
+        } else if (!pEngineNode->isMonoResampling && isMonoResamplingRequested && pEngineNode->monoWidth == 0) {
+            ma_linear_resampler_set_channels_f32(&pEngineNode->resampler, 1);
+            pEngineNode->isMonoResampling = MA_TRUE;
+        }
+
         pRunningFramesIn  = ma_offset_pcm_frames_const_ptr_f32(ppFramesIn[0], totalFramesProcessedIn, channelsIn);
         pRunningFramesOut = ma_offset_pcm_frames_ptr_f32(ppFramesOut[0], totalFramesProcessedOut, channelsOut);
 
@@ -74220,7 +83406,25 @@ static void ma_engine_node_process_pcm_frames__general(ma_engine_node* pEngineNo
         }
 
         /* First is resampler. */
-        if (isPitchingEnabled) {
+        if (isPitchingEnabled && pEngineNode->isMonoResampling) {
+            /*
+            The mono data is resampled inside the working buffer. It has room for framesAvailableOut
+            frames of at least two channels. The mono output goes at the start, and the mono input goes
+            in the space after it. The output is then expanded in place.
+            */
+            float* pMonoOut = pWorkingBuffer;
+            float* pMonoIn  = pWorkingBuffer + framesAvailableOut;
+            ma_uint64 resampleFrameCountIn  = ma_min(framesAvailableIn, framesAvailableOut * (channelsIn - 1));
+            ma_uint64 resampleFrameCountOut = framesAvailableOut;
+
+            ma_engine_node_mix_down_to_mono_f32(pMonoIn, pRunningFramesIn, resampleFrameCountIn, channelsIn);
+            ma_linear_resampler_process_pcm_frames(&pEngineNode->resampler, pMonoIn, &resampleFrameCountIn, pMonoOut, &resampleFrameCountOut);
+            ma_engine_node_expand_from_mono_f32(pWorkingBuffer, pMonoOut, resampleFrameCountOut, channelsIn);
+            isWorkingBufferValid = MA_TRUE;
+
+            framesJustProcessedIn  = (ma_uint32)resampleFrameCountIn;
+            framesJustProcessedOut = (ma_uint32)resampleFrameCountOut;
+        } else if (isPitchingEnabled) {
             ma_uint64 resampleFrameCountIn  = framesAvailableIn;
             ma_uint64 resampleFrameCountOut = framesAvailableOut;
 
@@ -74257,6 +83461,16 @@ static void ma_engine_node_process_pcm_frames__general(ma_engine_node* pEngineNo
             }
         }
 
+        /* Narrowing or widening the image for switching between mono and multi-channel resampling. */
+        if (!pEngineNode->isMonoResampling && channelsIn > 1 && (pEngineNode->monoWidth < 1 || isMonoResamplingRequested)) {
+            if (isWorkingBufferValid == MA_FALSE) {
+                ma_copy_pcm_frames(pWorkingBuffer, pRunningFramesIn, framesJustProcessedOut, ma_format_f32, channelsIn);
+                isWorkingBufferValid = MA_TRUE;
+            }
+
+            pEngineNode->monoWidth = ma_engine_node_apply_mono_width_f32(pWorkingBuffer, framesJustProcessedOut, channelsIn, pEngineNode->monoWidth, (isMonoResamplingRequested) ? 0.0f : 1.0f, monoWidthStep);
+        }
+
         /*
         If at this point we still haven't actually done anything with the working buffer we need
         to just read straight from the input buffer.
@@ -74267,20 +83481,32 @@ static void ma_engine_node_process_pcm_frames__general(ma_engine_node* pEngineNo
 
         /* Spatialization. */
         if (isSpatializationEnabled) {
-            ma_uint32 iListener;
+            ma_uint32 batchIndex = ma_engine_node_get_spatializer_batch_index(pEngineNode);
 
-            /*
-            When determining the listener to use, we first check to see if the sound is pinned to a
-            specific listener. If so, we use that. Otherwise we just use the closest listener.
-            */
-            if (pEngineNode->pinnedListenerIndex != MA_LISTENER_INDEX_CLOSEST && pEngineNode->pinnedListenerIndex < ma_engine_get_listener_count(pEngineNode->pEngine)) {
-                iListener = pEngineNode->pinnedListenerIndex;
+            if (batchIndex != MA_SPATIALIZER_BATCH_INDEX_NONE) {
+                /* The spatial parameters have already been calculated by the engine. All that's left to do is apply them. */
+                const ma_spatializer_batch* pBatch = &pEngineNode->pEngine->spatializerBatch;
+                ma_spatializer_process_pcm_frames_batched(&pEngineNode->spatializer, &pEngineNode->pEngine->listeners[pBatch->pListenerIndex[batchIndex]], pBatch, batchIndex, pRunningFramesOut, pWorkingBuffer, framesJustProcessedOut);
             } else {
-                ma_vec3f spatializerPosition = ma_spatializer_get_position(&pEngineNode->spatializer);
-                iListener = ma_engine_find_closest_listener(pEngineNode->pEngine, spatializerPosition.x, spatializerPosition.y, spatializerPosition.z);
+                ma_uint32 iListener = ma_engine_node_get_listener_index(pEngineNode);
+                ma_spatializer_process_pcm_frames(&pEngineNode->spatializer, &pEngineNode->pEngine->listeners[iListener], pRunningFramesOut, pWorkingBuffer, framesJustProcessedOut);
+            }
+        } else if (isFusedVolumeAndPanEnabled) {
+            /* Fast path. If we're using smoothing, the volume will have already been applied. */
+            float volume = 1;
+            if (!isVolumeSmoothingEnabled) {
+                ma_engine_node_get_volume(pEngineNode, &volume);    /* Should never fail. */
+            }
+
+            ma_engine_node_apply_volume_and_pan_fused(pEngineNode, pRunningFramesOut, pWorkingBuffer, framesJustProcessedOut, channelsIn, volume, isPanningEnabled);
+        } else if (pEngineNode->ambisonicOrder > 0) {
+            /* Not spatializing, but we're outputting to an ambisonic bus. The sound has no direction so it's encoded as omnidirectional. */
+            float volume = 1;
+            if (!isVolumeSmoothingEnabled) {
+                ma_engine_node_get_volume(pEngineNode, &volume);    /* Should never fail. */
             }
 
-            ma_spatializer_process_pcm_frames(&pEngineNode->spatializer, &pEngineNode->pEngine->listeners[iListener], pRunningFramesOut, pWorkingBuffer, framesJustProcessedOut);
+            ma_ambisonic_encode_omni_f32(pRunningFramesOut, channelsOut, pWorkingBuffer, channelsIn, framesJustProcessedOut, volume, MA_TRUE);
         } else {
             /* No spatialization, but we still need to do channel conversion and master volume. */
             float volume;
@@ -74290,7 +83516,7 @@ static void ma_engine_node_process_pcm_frames__general(ma_engine_node* pEngineNo
                 /* No channel conversion required. Just copy straight to the output buffer. */
                 if (isVolumeSmoothingEnabled) {
                     /* Volume has already been applied. Just copy straight to the output buffer. */
-                    ma_copy_pcm_frames(pRunningFramesOut, pWorkingBuffer, framesJustProcessedOut * channelsOut, ma_format_f32, channelsOut);
+                    ma_copy_pcm_frames(pRunningFramesOut, pWorkingBuffer, framesJustProcessedOut, ma_format_f32, channelsOut);
                 } else {
                     /* Volume has not been applied yet. Copy and apply volume in the same pass. */
                     ma_copy_and_apply_volume_factor_f32(pRunningFramesOut, pWorkingBuffer, framesJustProcessedOut * channelsOut, volume);
@@ -74308,8 +83534,8 @@ static void ma_engine_node_process_pcm_frames__general(ma_engine_node* pEngineNo
 
         /* At this point we can guarantee that the output buffer contains valid data. We can process everything in place now. */
 
-        /* Panning. */
-        if (isPanningEnabled) {
+        /* Panning. This will have already been done by the fused path. */
+        if (isPanningEnabled && !isFusedVolumeAndPanEnabled) {
             ma_panner_process_pcm_frames(&pEngineNode->panner, pRunningFramesOut, pRunningFramesOut, framesJustProcessedOut);   /* In-place processing. */
         }
 
@@ -74328,6 +83554,269 @@ static void ma_engine_node_process_pcm_frames__general(ma_engine_node* pEngineNo
     *pFrameCountOut = totalFramesProcessedOut;
 }
 
+static float ma_engine_node_estimate_audibility(ma_engine_node* pEngineNode, float* pDistance)
+{
+    /*
+    This is a cheap estimate of how loud the sound will be at the listener. It ignores the content
+    of the sound itself and just looks at the gain stages it'll be going through. The distance to
+    the listener is output as well for sounds that are spatialized. Otherwise it's set to 0.
+    */
+    float gain;
+
+    if (pDistance != NULL) {
+        *pDistance = 0;
+    }
+
+    gain  = ma_atomic_float_get(&pEngineNode->volume);
+    gain *= ma_fader_get_current_volume(&pEngineNode->fader);
+    gain *= ma_node_get_output_bus_volume(pEngineNode, 0);
+
+    if (gain > 0 && ma_engine_node_is_spatialization_enabled(pEngineNode)) {
+        ma_spatializer_listener* pListener;
+        ma_vec3f relativePos;
+        ma_vec3f relativeDir;
+        ma_uint32 batchIndex = ma_engine_node_get_spatializer_batch_index(pEngineNode);
+
+        /* When the sound is batched the gain will have already been calculated. */
+        if (batchIndex != MA_SPATIALIZER_BATCH_INDEX_NONE) {
+            const ma_spatializer_batch* pBatch = &pEngineNode->pEngine->spatializerBatch;
+
+            if (pDistance != NULL) {
+                *pDistance = pBatch->pDistance[batchIndex];
+            }
+
+            if (ma_spatializer_listener_is_enabled(&pEngineNode->pEngine->listeners[pBatch->pListenerIndex[batchIndex]]) == MA_FALSE) {
+                return 0;
+            }
+
+            return gain * pBatch->pGain[batchIndex];
+        }
+
+        pListener = &pEngineNode->pEngine->listeners[ma_engine_node_get_listener_index(pEngineNode)];
+
+        if (ma_spatializer_listener_is_enabled(pListener) == MA_FALSE) {
+            return 0;   /* The spatializer outputs silence when the listener is disabled. */
+        }
+
+        if (ma_spatializer_get_positioning(&pEngineNode->spatializer) == ma_positioning_relative) {
+            relativePos = ma_spatializer_get_position(&pEngineNode->spatializer);
+            relativeDir = ma_spatializer_get_direction(&pEngineNode->spatializer);
+        } else {
+            ma_spatializer_get_relative_position_and_direction(&pEngineNode->spatializer, pListener, &relativePos, &relativeDir);
+        }
+
+        if (pDistance != NULL) {
+            *pDistance = ma_vec3f_len(relativePos);
+        }
+
+        gain *= ma_spatializer_calculate_gain(&pEngineNode->spatializer, pListener, relativePos, relativeDir);
+    }
+
+    return gain;
+}
+
+static ma_uint32 ma_engine_node_get_virtualization_key(ma_engine_node* pEngineNode, float audibility)
+{
+    /* The key is made up of the priority in the high bits and the audibility in 6dB steps in the low 4 bits. */
+    ma_int32 audibilityBucket = 15 + (ma_int32)(ma_volume_linear_to_db(audibility) / 6);
+    if (audibilityBucket < 0) {
+        audibilityBucket = 0;
+    }
+    if (audibilityBucket > 15) {
+        audibilityBucket = 15;
+    }
+
+    return (ma_atomic_load_32(&pEngineNode->priority) << 4) | (ma_uint32)audibilityBucket;
+}
+
+static ma_bool32 ma_engine_node_update_virtualization(ma_engine_node* pEngineNode)
+{
+    ma_engine* pEngine = pEngineNode->pEngine;
+    ma_uint32 epoch;
+    ma_bool32 isVirtual;
+    float audibility;
+
+    if (pEngine->maxRealSoundCount == 0 && pEngine->virtualizationThreshold <= 0) {
+        return MA_FALSE;    /* Virtualization is disabled. */
+    }
+
+    /* The decision is only made once per epoch. A sound can be processed several times in a single call to ma_engine_read_pcm_frames(). */
+    epoch = ma_atomic_load_32(&pEngine->virtualizationEpoch);
+    if (pEngineNode->virtualizationEpoch == epoch) {
+        return ma_atomic_load_32(&pEngineNode->isVirtual);
+    }
+
+    pEngineNode->virtualizationEpoch = epoch;
+
+    audibility = ma_engine_node_estimate_audibility(pEngineNode, NULL);
+    if (audibility < pEngine->virtualizationThreshold || audibility <= 0) {
+        /* Inaudible sounds are always virtual and don't take up any of the real sound budget. */
+        isVirtual = MA_TRUE;
+    } else if (pEngine->maxRealSoundCount == 0) {
+        isVirtual = MA_FALSE;
+    } else {
+        ma_uint32 key = ma_engine_node_get_virtualization_key(pEngineNode, audibility);
+        ma_uint32 thresholdKey = ma_atomic_load_32(&pEngine->virtualizationThresholdKey);
+
+        /* Register ourselves so the engine can work out the threshold for the next epoch. */
+        ma_atomic_fetch_add_32(&pEngine->pVirtualizationHistogram[key], 1);
+
+        if (key > thresholdKey) {
+            isVirtual = MA_FALSE;
+        } else if (key == thresholdKey) {
+            isVirtual = ma_atomic_fetch_sub_i32(&pEngine->virtualizationTieBudget, 1) <= 0;
+        } else {
+            isVirtual = MA_TRUE;
+        }
+    }
+
+    if (isVirtual) {
+        ma_atomic_fetch_add_32(&pEngine->virtualSoundCount, 1);
+    } else {
+        ma_atomic_fetch_add_32(&pEngine->realSoundCount, 1);
+    }
+
+    ma_atomic_exchange_32(&pEngineNode->isVirtual, isVirtual);
+
+    return isVirtual;
+}
+
+#define MA_ENGINE_LOD_HYSTERESIS        0.9f    /* Sounds need to come back inside their LOD threshold by this factor before going back up a level. Stops them flipping between levels. */
+#define MA_ENGINE_LOD_GAIN_TOLERANCE    0.06f   /* About 0.5dB. Changes in spatialization gain smaller than this are ignored at reduced levels of detail. */
+
+static ma_bool32 ma_engine_is_lod_enabled(const ma_engine* pEngine)
+{
+    return pEngine->lodReducedDistance > 0 || pEngine->lodMinimalDistance > 0 || pEngine->lodReducedGain > 0 || pEngine->lodMinimalGain > 0;
+}
+
+static ma_bool32 ma_engine_node_is_past_lod_threshold(float distance, float audibility, float distanceThreshold, float gainThreshold, ma_bool32 isAtLevel)
+{
+    float margin = (isAtLevel) ? MA_ENGINE_LOD_HYSTERESIS : 1;
+
+    if (distanceThreshold > 0 && distance > distanceThreshold * margin) {
+        return MA_TRUE;
+    }
+
+    if (gainThreshold > 0 && audibility < gainThreshold / margin) {
+        return MA_TRUE;
+    }
+
+    return MA_FALSE;
+}
+
+static ma_sound_lod ma_engine_node_update_lod(ma_engine_node* pEngineNode)
+{
+    ma_engine* pEngine = pEngineNode->pEngine;
+    ma_sound_lod oldLOD;
+    ma_sound_lod newLOD;
+    ma_uint32 epoch;
+    float audibility;
+    float distance;
+
+    if (ma_engine_is_lod_enabled(pEngine) == MA_FALSE) {
+        return ma_sound_lod_full;
+    }
+
+    /* Like virtualization, the decision is only made once per epoch. */
+    oldLOD = (ma_sound_lod)ma_atomic_load_32(&pEngineNode->lod);
+
+    epoch = ma_atomic_load_32(&pEngine->lodEpoch);
+    if (pEngineNode->lodEpoch == epoch) {
+        return oldLOD;
+    }
+
+    pEngineNode->lodEpoch = epoch;
+
+    /* Only spatialized sounds have a notion of distance. Dropping detail on anything else would be audible. */
+    newLOD = ma_sound_lod_full;
+    if (ma_engine_node_is_spatialization_enabled(pEngineNode)) {
+        audibility = ma_engine_node_estimate_audibility(pEngineNode, &distance);
+
+        if (ma_engine_node_is_past_lod_threshold(distance, audibility, pEngine->lodMinimalDistance, pEngine->lodMinimalGain, oldLOD >= ma_sound_lod_minimal)) {
+            newLOD = ma_sound_lod_minimal;
+        } else if (ma_engine_node_is_past_lod_threshold(distance, audibility, pEngine->lodReducedDistance, pEngine->lodReducedGain, oldLOD >= ma_sound_lod_reduced)) {
+            newLOD = ma_sound_lod_reduced;
+        }
+    }
+
+    if (newLOD != oldLOD) {
+        pEngineNode->spatializer.gainTolerance = (newLOD >= ma_sound_lod_reduced) ? MA_ENGINE_LOD_GAIN_TOLERANCE : 0;
+        ma_atomic_exchange_32(&pEngineNode->lod, newLOD);
+    }
+
+    return newLOD;
+}
+
+static ma_uint32 ma_engine_get_virtualization_fade_time_in_frames(const ma_engine* pEngine)
+{
+    /* Volume smoothing can be disabled, but a hard cut would click so fall back to the spatialization smoothing time. */
+    if (pEngine->defaultVolumeSmoothTimeInPCMFrames > 0) {
+        return pEngine->defaultVolumeSmoothTimeInPCMFrames;
+    }
+
+    return ma_max(1, pEngine->gainSmoothTimeInFrames);
+}
+
+static float ma_engine_node_apply_virtualization_fade_f32(float* pFrames, ma_uint32 frameCount, ma_uint32 channels, float gain, float gainTarget, float gainStep)
+{
+    ma_uint32 iFrame;
+    ma_uint32 iChannel;
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        if (gain < gainTarget) {
+            gain = ma_min(gain + gainStep, gainTarget);
+        } else if (gain > gainTarget) {
+            gain = ma_max(gain - gainStep, gainTarget);
+        } else if (gain == 1) {
+            break;  /* Fully faded in. Nothing more to do. */
+        }
+
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            pFrames[iFrame*channels + iChannel] *= gain;
+        }
+    }
+
+    return gain;
+}
+
+static void ma_engine_node_process_pcm_frames__sound_virtual(ma_sound* pSound, float* pFramesOut, ma_uint32* pFrameCountOut)
+{
+    /*
+    A virtual sound does no processing other than moving the cursor forward by however much it would
+    have consumed had it been real. This way it picks up from the correct position when it becomes
+    real again. The output is silence.
+    */
+    ma_engine_node* pEngineNode = &pSound->engineNode;
+    ma_uint32 frameCount = *pFrameCountOut;
+    ma_uint64 framesToSeek;
+    ma_uint64 framesSeeked = 0;
+    ma_result result;
+
+    ma_engine_node_update_fade_if_required(pEngineNode);
+
+    framesToSeek = ma_engine_node_get_required_input_frame_count(pEngineNode, frameCount);
+
+    result = ma_data_source_seek_pcm_frames(pSound->pDataSource, framesToSeek, &framesSeeked);
+    if (result == MA_AT_END) {
+        ma_sound_set_at_end(pSound, MA_TRUE);   /* This will be set to false in ma_sound_start(). */
+
+        /* We only want to output as many frames as would have been produced from the input we had available. */
+        if (framesToSeek > 0) {
+            frameCount = (ma_uint32)((framesSeeked * frameCount) / framesToSeek);
+        }
+    }
+
+    /* The fader needs to keep moving or else fades would stall while the sound is virtual. */
+    pEngineNode->fader.cursorInFrames += frameCount;
+    if (pEngineNode->fader.cursorInFrames > 0 && (ma_uint64)pEngineNode->fader.cursorInFrames > pEngineNode->fader.lengthInFrames) {
+        pEngineNode->fader.cursorInFrames = (ma_int64)pEngineNode->fader.lengthInFrames;
+    }
+
+    ma_silence_pcm_frames(pFramesOut, frameCount, ma_format_f32, ma_node_get_output_channels(pSound, 0));
+
+    *pFrameCountOut = frameCount;
+}
+
 static void ma_engine_node_process_pcm_frames__sound(ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut)
 {
     /* For sounds, we need to first read from the data source. Then we need to apply the engine effects (pan, pitch, fades, etc.). */
@@ -74340,6 +83829,7 @@ static void ma_engine_node_process_pcm_frames__sound(ma_node* pNode, const float
     ma_uint8 temp[MA_DATA_CONVERTER_STACK_BUFFER_SIZE];
     ma_uint32 tempCapInFrames;
     ma_uint64 seekTarget;
+    ma_bool32 isVirtual;
 
     /* This is a data source node which means no input buses. */
     (void)ppFramesIn;
@@ -74370,10 +83860,31 @@ static void ma_engine_node_process_pcm_frames__sound(ma_node* pNode, const float
     What could happen is that the required input frame count is calculated, the pitch is update,
     and then this processing function is called resulting in a different number of input frames
     being processed. Do not call this in ma_engine_node_process_pcm_frames__general() or else
-    you'll hit the aforementioned bug.
+    you'll hit the aforementioned bug. The level of detail needs to be decided first since it
+    affects doppler.
     */
+    ma_engine_node_update_lod(&pSound->engineNode);
     ma_engine_node_update_pitch_if_required(&pSound->engineNode);
 
+    /*
+    Virtual sounds just advance the cursor, but only once they've been faded out. Until then they're
+    processed like normal so there's no click when they go silent.
+    */
+    isVirtual = ma_engine_node_update_virtualization(&pSound->engineNode);
+    if (pSound->engineNode.virtualizationGain == 0) {
+        if (isVirtual) {
+            ma_engine_node_process_pcm_frames__sound_virtual(pSound, ppFramesOut[0], pFrameCountOut);
+            return;
+        }
+
+        /*
+        We're becoming real again. Whatever the pitch resampler had buffered from before going virtual
+        is now out of place so it needs to be cleared. The fade in will cover the resampler starting
+        back up from silence.
+        */
+        ma_linear_resampler_reset(&pSound->engineNode.resampler);
+    }
+
     /*
     For the convenience of the caller, we're doing to allow data sources to use non-floating-point formats and channel counts that differ
     from the main engine.
@@ -74438,6 +83949,11 @@ static void ma_engine_node_process_pcm_frames__sound(ma_node* pNode, const float
         }
     }
 
+    if (isVirtual || pSound->engineNode.virtualizationGain < 1) {
+        float gainStep = 1.0f / ma_engine_get_virtualization_fade_time_in_frames(pSound->engineNode.pEngine);
+        pSound->engineNode.virtualizationGain = ma_engine_node_apply_virtualization_fade_f32(ppFramesOut[0], totalFramesRead, ma_node_get_output_channels(pSound, 0), pSound->engineNode.virtualizationGain, (isVirtual) ? 0.0f : 1.0f, gainStep);
+    }
+
     *pFrameCountOut = totalFramesRead;
 }
 
@@ -74450,6 +83966,7 @@ static void ma_engine_node_process_pcm_frames__group(ma_node* pNode, const float
     and if another thread modifies the pitch just after that call it can result in a glitch due to
     the input rate changing.
     */
+    ma_engine_node_update_lod((ma_engine_node*)pNode);
     ma_engine_node_update_pitch_if_required((ma_engine_node*)pNode);
 
     /* For groups, the input data has already been read and we just need to apply the effect. */
@@ -74463,6 +83980,7 @@ static ma_result ma_engine_node_get_required_input_frame_count__group(ma_node* p
     MA_ASSERT(pInputFrameCount != NULL);
 
     /* Our pitch will affect this calculation. We need to update it. */
+    ma_engine_node_update_lod((ma_engine_node*)pNode);
     ma_engine_node_update_pitch_if_required((ma_engine_node*)pNode);
 
     inputFrameCount = ma_engine_node_get_required_input_frame_count((ma_engine_node*)pNode, outputFrameCount);
@@ -74574,7 +84092,8 @@ static ma_result ma_engine_node_get_heap_layout(const ma_engine_node_config* pCo
 
 
     /* Resmapler. */
-    resamplerConfig = ma_linear_resampler_config_init(ma_format_f32, channelsIn, 1, 1); /* Input and output sample rates don't affect the calculation of the heap size. */
+    /* The sample rates need to match those used at initialization time because they determine the size of the fixed-ratio phase table. */
+    resamplerConfig = ma_linear_resampler_config_init(ma_format_f32, channelsIn, (pConfig->sampleRate > 0) ? pConfig->sampleRate : ma_engine_get_sample_rate(pConfig->pEngine), (pConfig->sampleRateOut > 0) ? pConfig->sampleRateOut : ma_engine_get_sample_rate(pConfig->pEngine));
     resamplerConfig.lpfOrder = 0;
 
     result = ma_linear_resampler_get_heap_size(&resamplerConfig, &tempHeapSize);
@@ -74588,6 +84107,7 @@ static ma_result ma_engine_node_get_heap_layout(const ma_engine_node_config* pCo
 
     /* Spatializer. */
     spatializerConfig = ma_engine_node_spatializer_config_init(&baseNodeConfig);
+    spatializerConfig.ambisonicOrder = pConfig->ambisonicOrder;
 
     if (spatializerConfig.channelsIn == 2) {
         spatializerConfig.pChannelMapIn = defaultStereoChannelMap;
@@ -74674,15 +84194,24 @@ MA_API ma_result ma_engine_node_init_preallocated(const ma_engine_node_config* p
 
     pEngineNode->pEngine                     = pConfig->pEngine;
     pEngineNode->sampleRate                  = (pConfig->sampleRate > 0) ? pConfig->sampleRate : ma_engine_get_sample_rate(pEngineNode->pEngine);
+    pEngineNode->sampleRateOut               = (pConfig->sampleRateOut > 0) ? pConfig->sampleRateOut : ma_engine_get_sample_rate(pEngineNode->pEngine);
     pEngineNode->volumeSmoothTimeInPCMFrames = pConfig->volumeSmoothTimeInPCMFrames;
     pEngineNode->monoExpansionMode           = pConfig->monoExpansionMode;
     ma_atomic_float_set(&pEngineNode->volume, 1);
     pEngineNode->pitch                       = 1;
     pEngineNode->oldPitch                    = 1;
     pEngineNode->oldDopplerPitch             = 1;
+    pEngineNode->dopplerWeight               = 1;
     pEngineNode->isPitchDisabled             = pConfig->isPitchDisabled;
     pEngineNode->isSpatializationDisabled    = pConfig->isSpatializationDisabled;
+    pEngineNode->ambisonicOrder              = pConfig->ambisonicOrder;
+    pEngineNode->spatializerBatchIndex       = MA_SPATIALIZER_BATCH_INDEX_NONE;
+    pEngineNode->spatializerBatchRequest     = 0;
+    pEngineNode->lod                         = ma_sound_lod_full;
+    pEngineNode->monoWidth                   = 1;
+    pEngineNode->virtualizationGain          = 1;
     pEngineNode->pinnedListenerIndex         = pConfig->pinnedListenerIndex;
+    pEngineNode->priority                    = pConfig->priority;
     ma_atomic_float_set(&pEngineNode->fadeSettings.volumeBeg, 1);
     ma_atomic_float_set(&pEngineNode->fadeSettings.volumeEnd, 1);
     ma_atomic_uint64_set(&pEngineNode->fadeSettings.fadeLengthInFrames, (~(ma_uint64)0));
@@ -74692,10 +84221,11 @@ MA_API ma_result ma_engine_node_init_preallocated(const ma_engine_node_config* p
     channelsOut = (pConfig->channelsOut != 0) ? pConfig->channelsOut : ma_engine_get_channels(pConfig->pEngine);
 
     /*
-    If the sample rate of the sound is different to the engine, make sure pitching is enabled so that the resampler
-    is activated. Not doing this will result in the sound not being resampled if MA_SOUND_FLAG_NO_PITCH is used.
+    If the sample rate of the sound is different to the rate it's being mixed at, make sure pitching is enabled so
+    that the resampler is activated. Not doing this will result in the sound not being resampled if
+    MA_SOUND_FLAG_NO_PITCH is used.
     */
-    if (pEngineNode->sampleRate != ma_engine_get_sample_rate(pEngineNode->pEngine)) {
+    if (pEngineNode->sampleRate != pEngineNode->sampleRateOut) {
         pEngineNode->isPitchDisabled = MA_FALSE;
     }
 
@@ -74720,7 +84250,7 @@ MA_API ma_result ma_engine_node_init_preallocated(const ma_engine_node_config* p
     */
 
     /* We'll always do resampling first. */
-    resamplerConfig = ma_linear_resampler_config_init(ma_format_f32, baseNodeConfig.pInputChannels[0], pEngineNode->sampleRate, ma_engine_get_sample_rate(pEngineNode->pEngine));
+    resamplerConfig = ma_linear_resampler_config_init(ma_format_f32, baseNodeConfig.pInputChannels[0], pEngineNode->sampleRate, pEngineNode->sampleRateOut);
     resamplerConfig.lpfOrder = 0;    /* <-- Need to disable low-pass filtering for pitch shifting for now because there's cases where the biquads are becoming unstable. Need to figure out a better fix for this. */
 
     result = ma_linear_resampler_init_preallocated(&resamplerConfig, ma_offset_ptr(pHeap, heapLayout.resamplerOffset), &pEngineNode->resampler);
@@ -74730,7 +84260,7 @@ MA_API ma_result ma_engine_node_init_preallocated(const ma_engine_node_config* p
 
 
     /* After resampling will come the fader. */
-    faderConfig = ma_fader_config_init(ma_format_f32, baseNodeConfig.pInputChannels[0], ma_engine_get_sample_rate(pEngineNode->pEngine));
+    faderConfig = ma_fader_config_init(ma_format_f32, baseNodeConfig.pInputChannels[0], pEngineNode->sampleRateOut);
 
     result = ma_fader_init(&faderConfig, &pEngineNode->fader);
     if (result != MA_SUCCESS) {
@@ -74744,6 +84274,7 @@ MA_API ma_result ma_engine_node_init_preallocated(const ma_engine_node_config* p
     */
     spatializerConfig = ma_engine_node_spatializer_config_init(&baseNodeConfig);
     spatializerConfig.gainSmoothTimeInFrames = pEngineNode->pEngine->gainSmoothTimeInFrames;
+    spatializerConfig.ambisonicOrder         = pConfig->ambisonicOrder;
 
     if (spatializerConfig.channelsIn == 2) {
         spatializerConfig.pChannelMapIn = defaultStereoChannelMap;
@@ -74778,6 +84309,12 @@ MA_API ma_result ma_engine_node_init_preallocated(const ma_engine_node_config* p
     }
 
 
+    /* Sounds that are spatialized from the start have their spatial parameters calculated in the engine's batch if there's room. */
+    if (!pEngineNode->isSpatializationDisabled) {
+        ma_engine_add_to_spatializer_batch(pEngineNode->pEngine, pEngineNode);
+    }
+
+
     return MA_SUCCESS;
 
     /* No need for allocation callbacks here because we use a preallocated heap. */
@@ -74826,6 +84363,8 @@ MA_API void ma_engine_node_uninit(ma_engine_node* pEngineNode, const ma_allocati
     ma_node_uninit(&pEngineNode->baseNode, pAllocationCallbacks);
 
     /* Now that the node has been uninitialized we can safely uninitialize the rest. */
+    ma_engine_remove_from_spatializer_batch(pEngineNode->pEngine, pEngineNode);
+
     if (pEngineNode->volumeSmoothTimeInPCMFrames > 0) {
         ma_gainer_uninit(&pEngineNode->volumeGainer, pAllocationCallbacks);
     }
@@ -74859,6 +84398,7 @@ MA_API ma_sound_config ma_sound_config_init_2(ma_engine* pEngine)
 
     config.rangeEndInPCMFrames     = ~((ma_uint64)0);
     config.loopPointEndInPCMFrames = ~((ma_uint64)0);
+    config.priority                = MA_SOUND_PRIORITY_DEFAULT;
 
     return config;
 }
@@ -75051,6 +84591,16 @@ MA_API ma_result ma_engine_init(const ma_engine_config* pConfig, ma_engine* pEng
     /* The engine is a node graph. This needs to be initialized after we have the device so we can can determine the channel count. */
     nodeGraphConfig = ma_node_graph_config_init(engineConfig.channels);
     nodeGraphConfig.nodeCacheCapInFrames = (engineConfig.periodSizeInFrames > 0xFFFF) ? 0xFFFF : (ma_uint16)engineConfig.periodSizeInFrames;
+    nodeGraphConfig.jobThreadCount       = engineConfig.nodeGraphJobThreadCount;
+
+    #if !defined(MA_NO_DEVICE_IO)
+    {
+        /* The worker threads need to run at the same priority as the audio thread. */
+        if (pEngine->pDevice != NULL) {
+            nodeGraphConfig.jobThreadPriority = pEngine->pDevice->pContext->threadPriority;
+        }
+    }
+    #endif
 
     result = ma_node_graph_init(&nodeGraphConfig, &pEngine->allocationCallbacks, &pEngine->nodeGraph);
     if (result != MA_SUCCESS) {
@@ -75110,6 +84660,36 @@ MA_API ma_result ma_engine_init(const ma_engine_config* pConfig, ma_engine* pEng
     }
 
 
+    /*
+    The ambisonic bus is where spatialized sounds are mixed in B-format. It's decoded to the channel map of the first
+    listener in a single pass, which means the cost of spatializing each sound does not depend on the number of
+    speakers.
+    */
+    if (engineConfig.ambisonicOrder > 0) {
+        ma_ambisonic_decoder_node_config ambisonicBusConfig;
+
+        if (engineConfig.ambisonicOrder > MA_AMBISONIC_MAX_ORDER) {
+            result = MA_INVALID_ARGS;
+            goto on_error_2;
+        }
+
+        ambisonicBusConfig = ma_ambisonic_decoder_node_config_init(engineConfig.ambisonicOrder, ma_node_graph_get_channels(&pEngine->nodeGraph), pEngine->listeners[0].config.pChannelMapOut);
+
+        result = ma_ambisonic_decoder_node_init(&pEngine->nodeGraph, &ambisonicBusConfig, &pEngine->allocationCallbacks, &pEngine->ambisonicBus);
+        if (result != MA_SUCCESS) {
+            goto on_error_2;
+        }
+
+        result = ma_node_attach_output_bus(&pEngine->ambisonicBus, 0, ma_node_graph_get_endpoint(&pEngine->nodeGraph), 0);
+        if (result != MA_SUCCESS) {
+            ma_ambisonic_decoder_node_uninit(&pEngine->ambisonicBus, &pEngine->allocationCallbacks);
+            goto on_error_2;
+        }
+
+        pEngine->ambisonicOrder = engineConfig.ambisonicOrder;
+    }
+
+
     /* We need a resource manager. */
     #ifndef MA_NO_RESOURCE_MANAGER
     {
@@ -75152,13 +84732,100 @@ MA_API ma_result ma_engine_init(const ma_engine_config* pConfig, ma_engine* pEng
     pEngine->inlinedSoundLock  = 0;
     pEngine->pInlinedSoundHead = NULL;
 
+    /* The inlined sound pool is optional. When it's enabled, every slot is allocated up front so playing a sound never needs to allocate a new one. */
+    if (engineConfig.inlinedSoundPoolCapacity > 0) {
+        pEngine->pInlinedSoundPool = (ma_sound_inlined*)ma_calloc(sizeof(*pEngine->pInlinedSoundPool) * engineConfig.inlinedSoundPoolCapacity, &pEngine->allocationCallbacks);
+        if (pEngine->pInlinedSoundPool == NULL) {
+            result = MA_OUT_OF_MEMORY;
+            goto on_error_4;
+        }
+
+        pEngine->inlinedSoundPoolCapacity = engineConfig.inlinedSoundPoolCapacity;
+    }
+
+    pEngine->inlinedSoundStealPolicy = engineConfig.inlinedSoundStealPolicy;
+
+    /* The histogram for voice virtualization is only needed when there's a limit on the number of real sounds. */
+    if (engineConfig.maxRealSoundCount > 0) {
+        pEngine->pVirtualizationHistogram = (ma_uint32*)ma_calloc(sizeof(*pEngine->pVirtualizationHistogram) * MA_ENGINE_VIRTUALIZATION_KEY_COUNT, &pEngine->allocationCallbacks);
+        if (pEngine->pVirtualizationHistogram == NULL) {
+            ma_free(pEngine->pInlinedSoundPool, &pEngine->allocationCallbacks);
+            result = MA_OUT_OF_MEMORY;
+            goto on_error_4;
+        }
+
+        pEngine->maxRealSoundCount = engineConfig.maxRealSoundCount;
+    }
+
+    pEngine->virtualizationThreshold = engineConfig.virtualizationThreshold;
+
+    pEngine->lodReducedDistance = engineConfig.lodReducedDistance;
+    pEngine->lodMinimalDistance = engineConfig.lodMinimalDistance;
+    pEngine->lodReducedGain     = engineConfig.lodReducedGain;
+    pEngine->lodMinimalGain     = engineConfig.lodMinimalGain;
+
+    /* The groups themselves are initialized on demand, but the memory for them is allocated up front so that pointers to them remain stable. */
+    if (engineConfig.groupSoundsBySampleRate) {
+        pEngine->pSampleRateGroups = (ma_sound_group*)ma_calloc(sizeof(*pEngine->pSampleRateGroups) * MA_ENGINE_MAX_SAMPLE_RATE_GROUPS, &pEngine->allocationCallbacks);
+        if (pEngine->pSampleRateGroups == NULL) {
+            ma_free(pEngine->pVirtualizationHistogram, &pEngine->allocationCallbacks);
+            ma_free(pEngine->pInlinedSoundPool, &pEngine->allocationCallbacks);
+            result = MA_OUT_OF_MEMORY;
+            goto on_error_4;
+        }
+
+        pEngine->groupSoundsBySampleRate = MA_TRUE;
+    }
+
+    /* The spatializer batch. Sounds add themselves to this when they're initialized. */
+    if (engineConfig.spatializerBatchCapacity > 0) {
+        ma_spatializer_batch_config spatializerBatchConfig = ma_spatializer_batch_config_init(engineConfig.spatializerBatchCapacity);
+
+        result = ma_spatializer_batch_init(&spatializerBatchConfig, &pEngine->allocationCallbacks, &pEngine->spatializerBatch);
+        if (result == MA_SUCCESS) {
+            pEngine->ppSpatializerBatchNodes = (ma_engine_node**)ma_malloc(sizeof(*pEngine->ppSpatializerBatchNodes) * engineConfig.spatializerBatchCapacity, &pEngine->allocationCallbacks);
+            if (pEngine->ppSpatializerBatchNodes == NULL) {
+                ma_spatializer_batch_uninit(&pEngine->spatializerBatch, &pEngine->allocationCallbacks);
+                result = MA_OUT_OF_MEMORY;
+            }
+        }
+
+        if (result != MA_SUCCESS) {
+            ma_free(pEngine->pSampleRateGroups, &pEngine->allocationCallbacks);
+            ma_free(pEngine->pVirtualizationHistogram, &pEngine->allocationCallbacks);
+            ma_free(pEngine->pInlinedSoundPool, &pEngine->allocationCallbacks);
+            goto on_error_4;
+        }
+    }
+
+    /* Bulk transform updates. */
+    if (engineConfig.soundTransformCapacity > 0) {
+        pEngine->pSoundTransforms = (ma_sound_transform*)ma_malloc(sizeof(*pEngine->pSoundTransforms) * engineConfig.soundTransformCapacity * 3, &pEngine->allocationCallbacks);
+        if (pEngine->pSoundTransforms == NULL) {
+            if (pEngine->ppSpatializerBatchNodes != NULL) {
+                ma_free(pEngine->ppSpatializerBatchNodes, &pEngine->allocationCallbacks);
+                ma_spatializer_batch_uninit(&pEngine->spatializerBatch, &pEngine->allocationCallbacks);
+            }
+            ma_free(pEngine->pSampleRateGroups, &pEngine->allocationCallbacks);
+            ma_free(pEngine->pVirtualizationHistogram, &pEngine->allocationCallbacks);
+            ma_free(pEngine->pInlinedSoundPool, &pEngine->allocationCallbacks);
+            result = MA_OUT_OF_MEMORY;
+            goto on_error_4;
+        }
+
+        pEngine->soundTransformCapacity   = engineConfig.soundTransformCapacity;
+        pEngine->soundTransformWriteBlock = 0;
+        pEngine->soundTransformReadBlock  = 2;
+        ma_atomic_exchange_32(&pEngine->soundTransformState, 1);   /* Block 1 starts off empty in the middle. */
+    }
+
     /* Start the engine if required. This should always be the last step. */
     #if !defined(MA_NO_DEVICE_IO)
     {
         if (engineConfig.noAutoStart == MA_FALSE && pEngine->pDevice != NULL) {
             result = ma_engine_start(pEngine);
             if (result != MA_SUCCESS) {
-                goto on_error_4;    /* Failed to start the engine. */
+                goto on_error_5;    /* Failed to start the engine. */
             }
         }
     }
@@ -75167,15 +84834,31 @@ MA_API ma_result ma_engine_init(const ma_engine_config* pConfig, ma_engine* pEng
     return MA_SUCCESS;
 
 #if !defined(MA_NO_DEVICE_IO)
-on_error_4:
+on_error_5:
+    ma_free(pEngine->pSoundTransforms, &pEngine->allocationCallbacks);
+    if (pEngine->ppSpatializerBatchNodes != NULL) {
+        ma_free(pEngine->ppSpatializerBatchNodes, &pEngine->allocationCallbacks);
+        ma_spatializer_batch_uninit(&pEngine->spatializerBatch, &pEngine->allocationCallbacks);
+    }
+    ma_free(pEngine->pSampleRateGroups, &pEngine->allocationCallbacks);
+    ma_free(pEngine->pVirtualizationHistogram, &pEngine->allocationCallbacks);
+    ma_free(pEngine->pInlinedSoundPool, &pEngine->allocationCallbacks);
 #endif
+on_error_4:
 #if !defined(MA_NO_RESOURCE_MANAGER)
+    if (pEngine->ownsResourceManager) {
+        ma_resource_manager_uninit(pEngine->pResourceManager);
+    }
 on_error_3:
     if (pEngine->ownsResourceManager) {
         ma_free(pEngine->pResourceManager, &pEngine->allocationCallbacks);
     }
 #endif  /* MA_NO_RESOURCE_MANAGER */
 on_error_2:
+    if (pEngine->ambisonicOrder > 0) {
+        ma_ambisonic_decoder_node_uninit(&pEngine->ambisonicBus, &pEngine->allocationCallbacks);
+    }
+
     for (iListener = 0; iListener < pEngine->listenerCount; iListener += 1) {
         ma_spatializer_listener_uninit(&pEngine->listeners[iListener], &pEngine->allocationCallbacks);
     }
@@ -75236,6 +84919,50 @@ MA_API void ma_engine_uninit(ma_engine* pEngine)
     }
     ma_spinlock_unlock(&pEngine->inlinedSoundLock);
 
+    if (pEngine->pInlinedSoundPool != NULL) {
+        ma_uint32 iSound;
+        for (iSound = 0; iSound < pEngine->inlinedSoundPoolCapacity; iSound += 1) {
+            if (pEngine->pInlinedSoundPool[iSound].isPoolSoundInitialized) {
+                ma_sound_uninit(&pEngine->pInlinedSoundPool[iSound].sound);
+            }
+
+            ma_free(pEngine->pInlinedSoundPool[iSound].pPoolFilePath, &pEngine->allocationCallbacks);
+        }
+
+        ma_free(pEngine->pInlinedSoundPool, &pEngine->allocationCallbacks);
+        pEngine->pInlinedSoundPool = NULL;
+    }
+
+    ma_free(pEngine->pVirtualizationHistogram, &pEngine->allocationCallbacks);
+    pEngine->pVirtualizationHistogram = NULL;
+
+    /* Sample rate groups need to be uninitialized after the inlined sounds since they can be attached to them. */
+    if (pEngine->pSampleRateGroups != NULL) {
+        ma_uint32 iGroup;
+        for (iGroup = 0; iGroup < MA_ENGINE_MAX_SAMPLE_RATE_GROUPS; iGroup += 1) {
+            if (pEngine->sampleRateGroupStates[iGroup] == MA_SAMPLE_RATE_GROUP_STATE_READY) {
+                ma_sound_group_uninit(&pEngine->pSampleRateGroups[iGroup]);
+            }
+        }
+
+        ma_free(pEngine->pSampleRateGroups, &pEngine->allocationCallbacks);
+        pEngine->pSampleRateGroups = NULL;
+    }
+
+    /* The ambisonic bus needs to be uninitialized after every sound that could be attached to it. */
+    if (pEngine->ambisonicOrder > 0) {
+        ma_ambisonic_decoder_node_uninit(&pEngine->ambisonicBus, &pEngine->allocationCallbacks);
+    }
+
+    if (pEngine->ppSpatializerBatchNodes != NULL) {
+        ma_free(pEngine->ppSpatializerBatchNodes, &pEngine->allocationCallbacks);
+        pEngine->ppSpatializerBatchNodes = NULL;
+        ma_spatializer_batch_uninit(&pEngine->spatializerBatch, &pEngine->allocationCallbacks);
+    }
+
+    ma_free(pEngine->pSoundTransforms, &pEngine->allocationCallbacks);
+    pEngine->pSoundTransforms = NULL;
+
     for (iListener = 0; iListener < pEngine->listenerCount; iListener += 1) {
         ma_spatializer_listener_uninit(&pEngine->listeners[iListener], &pEngine->allocationCallbacks);
     }
@@ -75252,6 +84979,164 @@ MA_API void ma_engine_uninit(ma_engine* pEngine)
 #endif
 }
 
+static void ma_engine_begin_virtualization_epoch(ma_engine* pEngine)
+{
+    MA_ASSERT(pEngine != NULL);
+
+    if (pEngine->maxRealSoundCount == 0 && pEngine->virtualizationThreshold <= 0) {
+        return; /* Virtualization is disabled. */
+    }
+
+    /* Sounds make their decision once per epoch. Moving to a new epoch is what triggers them to re-evaluate. */
+    ma_atomic_fetch_add_32(&pEngine->virtualizationEpoch, 1);
+
+    ma_atomic_exchange_32(&pEngine->lastRealSoundCount,    ma_atomic_exchange_32(&pEngine->realSoundCount,    0));
+    ma_atomic_exchange_32(&pEngine->lastVirtualSoundCount, ma_atomic_exchange_32(&pEngine->virtualSoundCount, 0));
+
+    /*
+    Each sound added itself to the histogram during the previous epoch. By walking it from the
+    highest key down we can find the key at which the real sound budget runs out. Everything above
+    that key is real, everything below is virtual, and sounds with that exact key share whatever
+    budget is left over. The histogram is cleared as we go so it's ready for this epoch.
+    */
+    if (pEngine->maxRealSoundCount > 0) {
+        ma_uint32 remaining = pEngine->maxRealSoundCount;
+        ma_uint32 thresholdKey = 0;
+        ma_int32 tieBudget = 0x7FFFFFFF;    /* Unlimited unless we run out of room below. */
+        ma_bool32 isThresholdFound = MA_FALSE;
+        ma_uint32 iKey;
+
+        for (iKey = MA_ENGINE_VIRTUALIZATION_KEY_COUNT; iKey > 0; iKey -= 1) {
+            ma_uint32 count = ma_atomic_exchange_32(&pEngine->pVirtualizationHistogram[iKey - 1], 0);
+            if (isThresholdFound == MA_FALSE && count > 0) {
+                if (count >= remaining) {
+                    thresholdKey = iKey - 1;
+                    tieBudget = (ma_int32)remaining;
+                    isThresholdFound = MA_TRUE;
+                } else {
+                    remaining -= count;
+                }
+            }
+        }
+
+        ma_atomic_exchange_32(&pEngine->virtualizationThresholdKey, thresholdKey);
+        ma_atomic_exchange_i32(&pEngine->virtualizationTieBudget, tieBudget);
+    }
+}
+
+static void ma_engine_apply_sound_transforms(ma_sound_transform* pTransforms, ma_uint32 count)
+{
+    ma_uint32 iTransform;
+
+    for (iTransform = 0; iTransform < count; iTransform += 1) {
+        ma_sound* pSound = pTransforms[iTransform].pSound;
+
+        /* Sounds that were uninitialized after being submitted are cleared by ma_sound_uninit(). */
+        if (pSound == NULL) {
+            continue;
+        }
+
+        ma_spatializer_set_position( &pSound->engineNode.spatializer, pTransforms[iTransform].position.x,  pTransforms[iTransform].position.y,  pTransforms[iTransform].position.z);
+        ma_spatializer_set_direction(&pSound->engineNode.spatializer, pTransforms[iTransform].direction.x, pTransforms[iTransform].direction.y, pTransforms[iTransform].direction.z);
+        ma_spatializer_set_velocity( &pSound->engineNode.spatializer, pTransforms[iTransform].velocity.x,  pTransforms[iTransform].velocity.y,  pTransforms[iTransform].velocity.z);
+    }
+}
+
+/*
+Transform blocks are handed from the updating thread to the audio thread through a single atomic
+state. It holds the index of the block in the middle, whether or not that block is waiting to be
+applied (PENDING), and whether or not a thread other than the audio thread is currently working on
+it (LOCKED). The audio thread takes the middle block by swapping its own block in with a single
+compare-and-swap and never waits. If LOCKED is set it just picks the block up on the next period.
+*/
+#define MA_SOUND_TRANSFORM_STATE_INDEX_MASK 0x3
+#define MA_SOUND_TRANSFORM_STATE_PENDING    0x4
+#define MA_SOUND_TRANSFORM_STATE_LOCKED     0x8
+
+static void ma_engine_apply_pending_sound_transforms(ma_engine* pEngine)
+{
+    ma_uint32 state;
+
+    MA_ASSERT(pEngine != NULL);
+
+    if (pEngine->pSoundTransforms == NULL) {
+        return;
+    }
+
+    state = ma_atomic_load_32(&pEngine->soundTransformState);
+    if ((state & (MA_SOUND_TRANSFORM_STATE_PENDING | MA_SOUND_TRANSFORM_STATE_LOCKED)) != MA_SOUND_TRANSFORM_STATE_PENDING) {
+        return;
+    }
+
+    /* The generation needs to be odd before the block is taken so other threads know to wait for us. */
+    ma_atomic_fetch_add_32(&pEngine->soundTransformReadGeneration, 1);
+    {
+        if (ma_atomic_compare_and_swap_32(&pEngine->soundTransformState, state, pEngine->soundTransformReadBlock) == state) {
+            pEngine->soundTransformReadBlock = state & MA_SOUND_TRANSFORM_STATE_INDEX_MASK;
+            ma_engine_apply_sound_transforms(pEngine->pSoundTransforms + (pEngine->soundTransformCapacity * pEngine->soundTransformReadBlock), pEngine->soundTransformCounts[pEngine->soundTransformReadBlock]);
+        }
+    }
+    ma_atomic_fetch_add_32(&pEngine->soundTransformReadGeneration, 1);
+}
+
+static ma_uint32 ma_engine_lock_pending_sound_transforms(ma_engine* pEngine)
+{
+    ma_uint32 state;
+    ma_uint32 generation;
+
+    MA_ASSERT(pEngine != NULL);
+
+    /* This only ever contends with the updating thread and ma_sound_uninit(). The audio thread never sets LOCKED. */
+    for (;;) {
+        state = ma_atomic_load_32(&pEngine->soundTransformState);
+        if ((state & MA_SOUND_TRANSFORM_STATE_LOCKED) == 0 && ma_atomic_compare_and_swap_32(&pEngine->soundTransformState, state, state | MA_SOUND_TRANSFORM_STATE_LOCKED) == state) {
+            break;
+        }
+
+        ma_yield();
+    }
+
+    /*
+    The audio thread can't take the middle block while it's locked, but it might still be applying the
+    block it took before. Wait for the generation to move on so nothing it applies can land after us.
+    */
+    generation = ma_atomic_load_32(&pEngine->soundTransformReadGeneration);
+    if ((generation & 1) != 0) {
+        while (ma_atomic_load_32(&pEngine->soundTransformReadGeneration) == generation) {
+            ma_yield();
+        }
+    }
+
+    return state;
+}
+
+static void ma_engine_remove_pending_sound_transforms(ma_engine* pEngine, const ma_sound* pSound)
+{
+    ma_uint32 state;
+
+    MA_ASSERT(pEngine != NULL);
+
+    if (pEngine->pSoundTransforms == NULL) {
+        return;
+    }
+
+    state = ma_engine_lock_pending_sound_transforms(pEngine);
+    {
+        if ((state & MA_SOUND_TRANSFORM_STATE_PENDING) != 0) {
+            ma_uint32 pendingBlock = state & MA_SOUND_TRANSFORM_STATE_INDEX_MASK;
+            ma_sound_transform* pPendingTransforms = pEngine->pSoundTransforms + (pEngine->soundTransformCapacity * pendingBlock);
+            ma_uint32 iTransform;
+
+            for (iTransform = 0; iTransform < pEngine->soundTransformCounts[pendingBlock]; iTransform += 1) {
+                if (pPendingTransforms[iTransform].pSound == pSound) {
+                    pPendingTransforms[iTransform].pSound = NULL;
+                }
+            }
+        }
+    }
+    ma_atomic_exchange_32(&pEngine->soundTransformState, state);    /* Nothing else can change the state while it's locked. */
+}
+
 MA_API ma_result ma_engine_read_pcm_frames(ma_engine* pEngine, void* pFramesOut, ma_uint64 frameCount, ma_uint64* pFramesRead)
 {
     ma_result result;
@@ -75261,7 +85146,18 @@ MA_API ma_result ma_engine_read_pcm_frames(ma_engine* pEngine, void* pFramesOut,
         *pFramesRead = 0;
     }
 
+    ma_engine_apply_pending_sound_transforms(pEngine);
+    ma_engine_begin_virtualization_epoch(pEngine);
+    ma_engine_begin_spatializer_batch(pEngine);
+
+    if (ma_engine_is_lod_enabled(pEngine)) {
+        ma_atomic_fetch_add_32(&pEngine->lodEpoch, 1);
+    }
+
     result = ma_node_graph_read_pcm_frames(&pEngine->nodeGraph, pFramesOut, frameCount, &framesRead);
+
+    ma_engine_end_spatializer_batch(pEngine);
+
     if (result != MA_SUCCESS) {
         return result;
     }
@@ -75277,6 +85173,33 @@ MA_API ma_result ma_engine_read_pcm_frames(ma_engine* pEngine, void* pFramesOut,
     return MA_SUCCESS;
 }
 
+static ma_result ma_engine_render_offline__on_read(void* pSource, float* pFramesOut, ma_uint64 frameCount)
+{
+    return ma_engine_read_pcm_frames((ma_engine*)pSource, pFramesOut, frameCount, NULL);
+}
+
+MA_API ma_result ma_engine_render_offline(ma_engine* pEngine, const ma_offline_render_config* pConfig, ma_offline_render_stats* pStats)
+{
+    if (pStats != NULL) {
+        MA_ZERO_OBJECT(pStats);
+    }
+
+    if (pEngine == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    #if !defined(MA_NO_DEVICE_IO)
+    {
+        /* The device would be reading from the engine at the same time as us. */
+        if (pEngine->pDevice != NULL && ma_device_is_started(pEngine->pDevice)) {
+            return MA_INVALID_OPERATION;
+        }
+    }
+    #endif
+
+    return ma_offline_render(pEngine, ma_engine_render_offline__on_read, ma_engine_get_channels(pEngine), ma_engine_get_sample_rate(pEngine), pConfig, &pEngine->allocationCallbacks, pStats);
+}
+
 MA_API ma_node_graph* ma_engine_get_node_graph(ma_engine* pEngine)
 {
     if (pEngine == NULL) {
@@ -75636,7 +85559,225 @@ MA_API ma_bool32 ma_engine_listener_is_enabled(const ma_engine* pEngine, ma_uint
 
 
 #ifndef MA_NO_RESOURCE_MANAGER
-MA_API ma_result ma_engine_play_sound_ex(ma_engine* pEngine, const char* pFilePath, ma_node* pNode, ma_uint32 nodeInputBusIndex)
+#define MA_INLINED_SOUND_POOL_STATE_FREE    0   /* Available. The slot may still hold an initialized sound that has finished playing. */
+#define MA_INLINED_SOUND_POOL_STATE_BUSY    1   /* Owned by a thread that is in the middle of (re)initializing or restarting the sound. */
+#define MA_INLINED_SOUND_POOL_STATE_PLAYING 2
+
+static void ma_engine_inlined_sound_pool_on_end(void* pUserData, ma_sound* pSound)
+{
+    ma_sound_inlined* pInlinedSound = (ma_sound_inlined*)pUserData;
+    ma_engine* pEngine = ma_sound_get_engine(pSound);
+
+    /*
+    This is fired from the audio thread. If the slot is being stolen at the same time the stealer
+    already owns it and will take care of everything so we just leave it alone.
+    */
+    if (ma_atomic_compare_and_swap_32(&pInlinedSound->poolState, MA_INLINED_SOUND_POOL_STATE_PLAYING, MA_INLINED_SOUND_POOL_STATE_FREE) == MA_INLINED_SOUND_POOL_STATE_PLAYING) {
+        ma_atomic_fetch_sub_32(&pEngine->inlinedSoundPoolActiveCount, 1);
+    }
+}
+
+static ma_sound_inlined* ma_engine_acquire_pooled_inlined_sound(ma_engine* pEngine, ma_uint32 nameHash, ma_bool32* pWasStolen)
+{
+    ma_uint32 iAttempt;
+
+    MA_ASSERT(pEngine    != NULL);
+    MA_ASSERT(pWasStolen != NULL);
+
+    *pWasStolen = MA_FALSE;
+
+    /*
+    Slots are claimed by moving them into the busy state with a compare-and-swap. If another thread
+    beats us to the slot we chose we just run the search again. The number of attempts is bounded
+    so we can never get stuck here.
+    */
+    for (iAttempt = 0; iAttempt < pEngine->inlinedSoundPoolCapacity; iAttempt += 1) {
+        ma_sound_inlined* pFree   = NULL;
+        ma_sound_inlined* pVictim = NULL;
+        ma_uint64 victimPlayOrder = 0;
+        float victimVolume = 0;
+        ma_uint32 iSound;
+
+        for (iSound = 0; iSound < pEngine->inlinedSoundPoolCapacity; iSound += 1) {
+            ma_sound_inlined* pInlinedSound = &pEngine->pInlinedSoundPool[iSound];
+            ma_uint32 state = ma_atomic_load_32(&pInlinedSound->poolState);
+
+            if (state == MA_INLINED_SOUND_POOL_STATE_FREE) {
+                /*
+                A free slot that already has this sound loaded is the best choice because it can be restarted
+                without being reinitialized. The hash is only a hint. We don't own the slot yet so we can't
+                look at the path here. That is checked once the slot has been claimed.
+                */
+                if (ma_atomic_load_32(&pInlinedSound->poolNameHash) == nameHash) {
+                    pFree = pInlinedSound;
+                    break;
+                }
+
+                if (pFree == NULL) {
+                    pFree = pInlinedSound;
+                }
+            } else if (state == MA_INLINED_SOUND_POOL_STATE_PLAYING && pFree == NULL) {
+                ma_uint64 playOrder = ma_atomic_load_64(&pInlinedSound->poolPlayOrder);
+
+                if (pEngine->inlinedSoundStealPolicy == ma_inlined_sound_steal_policy_oldest) {
+                    if (pVictim == NULL || playOrder < victimPlayOrder) {
+                        pVictim         = pInlinedSound;
+                        victimPlayOrder = playOrder;
+                    }
+                } else if (pEngine->inlinedSoundStealPolicy == ma_inlined_sound_steal_policy_quietest) {
+                    float volume = ma_sound_get_volume(&pInlinedSound->sound);
+                    if (pVictim == NULL || volume < victimVolume || (volume == victimVolume && playOrder < victimPlayOrder)) {
+                        pVictim         = pInlinedSound;
+                        victimPlayOrder = playOrder;
+                        victimVolume    = volume;
+                    }
+                }
+            }
+        }
+
+        if (pFree != NULL) {
+            if (ma_atomic_compare_and_swap_32(&pFree->poolState, MA_INLINED_SOUND_POOL_STATE_FREE, MA_INLINED_SOUND_POOL_STATE_BUSY) == MA_INLINED_SOUND_POOL_STATE_FREE) {
+                return pFree;
+            }
+        } else if (pVictim != NULL) {
+            if (ma_atomic_compare_and_swap_32(&pVictim->poolState, MA_INLINED_SOUND_POOL_STATE_PLAYING, MA_INLINED_SOUND_POOL_STATE_BUSY) == MA_INLINED_SOUND_POOL_STATE_PLAYING) {
+                *pWasStolen = MA_TRUE;
+                return pVictim;
+            }
+        } else {
+            break;  /* Everything is playing and stealing is disabled. */
+        }
+    }
+
+    return NULL;
+}
+
+static ma_result ma_engine_play_sound_pooled(ma_engine* pEngine, const char* pFilePath, ma_node* pNode, ma_uint32 nodeInputBusIndex, float volume)
+{
+    ma_result result;
+    ma_sound_inlined* pInlinedSound;
+    ma_uint32 nameHash;
+    ma_bool32 wasStolen;
+    ma_uint32 activeCount;
+    ma_uint32 peakActiveCount;
+
+    nameHash = ma_hash_string_32(pFilePath);
+
+    pInlinedSound = ma_engine_acquire_pooled_inlined_sound(pEngine, nameHash, &wasStolen);
+    if (pInlinedSound == NULL) {
+        ma_atomic_fetch_add_64(&pEngine->inlinedSoundPoolRejectCount, 1);
+        return MA_NO_SPACE;
+    }
+
+    /* From here on we own the slot. */
+    if (wasStolen) {
+        ma_atomic_fetch_add_64(&pEngine->inlinedSoundPoolStealCount, 1);
+    }
+
+    if (pInlinedSound->isPoolSoundInitialized && ma_atomic_load_32(&pInlinedSound->poolNameHash) == nameHash && ma_strcmp(pInlinedSound->pPoolFilePath, pFilePath) == 0) {
+        /*
+        The slot already has this sound loaded so we can just rewind it. This is the path that makes
+        repeatedly playing the same sounds allocation free. Detaching first guarantees the audio
+        thread is no longer touching the sound which means we can safely seek the data source
+        directly. It'll be reattached below.
+        */
+        ma_node_detach_output_bus(&pInlinedSound->sound, 0);
+        ma_node_set_state(&pInlinedSound->sound, ma_node_state_stopped);
+
+        result = ma_data_source_seek_to_pcm_frame(pInlinedSound->sound.pDataSource, 0);
+        if (result != MA_SUCCESS && result != MA_NOT_IMPLEMENTED) {
+            ma_atomic_exchange_32(&pInlinedSound->poolState, MA_INLINED_SOUND_POOL_STATE_FREE);
+            goto done;
+        }
+
+        ma_atomic_exchange_64(&pInlinedSound->sound.seekTarget, MA_SEEK_TARGET_NONE);
+        ma_atomic_exchange_32(&pInlinedSound->sound.atEnd, MA_FALSE);
+        ma_atomic_fetch_add_64(&pEngine->inlinedSoundPoolReuseCount, 1);
+    } else {
+        ma_sound_config soundConfig;
+
+        if (pInlinedSound->isPoolSoundInitialized) {
+            ma_sound_uninit(&pInlinedSound->sound);
+            pInlinedSound->isPoolSoundInitialized = MA_FALSE;
+            ma_atomic_exchange_32(&pInlinedSound->poolNameHash, 0);
+        }
+
+        ma_free(pInlinedSound->pPoolFilePath, &pEngine->allocationCallbacks);
+        pInlinedSound->pPoolFilePath = ma_copy_string(pFilePath, &pEngine->allocationCallbacks);
+        if (pInlinedSound->pPoolFilePath == NULL) {
+            ma_atomic_exchange_32(&pInlinedSound->poolState, MA_INLINED_SOUND_POOL_STATE_FREE);
+            result = MA_OUT_OF_MEMORY;
+            goto done;
+        }
+
+        soundConfig = ma_sound_config_init_2(pEngine);
+        soundConfig.pFilePath            = pFilePath;
+        soundConfig.flags                = MA_SOUND_FLAG_ASYNC | MA_SOUND_FLAG_NO_DEFAULT_ATTACHMENT | MA_SOUND_FLAG_NO_PITCH | MA_SOUND_FLAG_NO_SPATIALIZATION;   /* Same as non-pooled inlined sounds. */
+        soundConfig.endCallback          = ma_engine_inlined_sound_pool_on_end;
+        soundConfig.pEndCallbackUserData = pInlinedSound;
+
+        result = ma_sound_init_ex(pEngine, &soundConfig, &pInlinedSound->sound);
+        if (result != MA_SUCCESS) {
+            ma_atomic_exchange_32(&pInlinedSound->poolState, MA_INLINED_SOUND_POOL_STATE_FREE);
+            goto done;
+        }
+
+        pInlinedSound->isPoolSoundInitialized = MA_TRUE;
+        ma_atomic_exchange_32(&pInlinedSound->poolNameHash, nameHash);
+    }
+
+    ma_sound_set_volume(&pInlinedSound->sound, volume);
+
+    result = ma_node_attach_output_bus(&pInlinedSound->sound, 0, pNode, nodeInputBusIndex);
+    if (result != MA_SUCCESS) {
+        ma_atomic_exchange_32(&pInlinedSound->poolState, MA_INLINED_SOUND_POOL_STATE_FREE);
+        goto done;
+    }
+
+    result = ma_sound_start(&pInlinedSound->sound);
+    if (result != MA_SUCCESS) {
+        ma_atomic_exchange_32(&pInlinedSound->poolState, MA_INLINED_SOUND_POOL_STATE_FREE);
+        goto done;
+    }
+
+    ma_atomic_exchange_64(&pInlinedSound->poolPlayOrder, ma_atomic_fetch_add_64(&pEngine->inlinedSoundPoolPlayCount, 1));
+
+    if (!wasStolen) {
+        activeCount = ma_atomic_fetch_add_32(&pEngine->inlinedSoundPoolActiveCount, 1) + 1;
+
+        peakActiveCount = ma_atomic_load_32(&pEngine->inlinedSoundPoolPeakActiveCount);
+        while (activeCount > peakActiveCount) {
+            if (ma_atomic_compare_and_swap_32(&pEngine->inlinedSoundPoolPeakActiveCount, peakActiveCount, activeCount) == peakActiveCount) {
+                break;
+            }
+
+            peakActiveCount = ma_atomic_load_32(&pEngine->inlinedSoundPoolPeakActiveCount);
+        }
+    }
+
+    /*
+    The slot is only handed over to the audio thread after the sound has been started so that nobody
+    can steal it from under us while we're still setting it up. If the sound already reached the end
+    before this point, the end callback will have seen the busy state and done nothing, so we need to
+    release the slot ourselves.
+    */
+    ma_atomic_exchange_32(&pInlinedSound->poolState, MA_INLINED_SOUND_POOL_STATE_PLAYING);
+    if (ma_sound_at_end(&pInlinedSound->sound)) {
+        ma_engine_inlined_sound_pool_on_end(pInlinedSound, &pInlinedSound->sound);
+    }
+
+    result = MA_SUCCESS;
+
+done:
+    /* A stolen slot that failed to restart is no longer playing so it needs to come off the active count. */
+    if (result != MA_SUCCESS && wasStolen) {
+        ma_atomic_fetch_sub_32(&pEngine->inlinedSoundPoolActiveCount, 1);
+    }
+
+    return result;
+}
+
+MA_API ma_result ma_engine_play_sound_with_volume(ma_engine* pEngine, const char* pFilePath, ma_node* pNode, ma_uint32 nodeInputBusIndex, float volume)
 {
     ma_result result = MA_SUCCESS;
     ma_sound_inlined* pSound = NULL;
@@ -75652,6 +85793,10 @@ MA_API ma_result ma_engine_play_sound_ex(ma_engine* pEngine, const char* pFilePa
         nodeInputBusIndex = 0;
     }
 
+    if (pEngine->pInlinedSoundPool != NULL) {
+        return ma_engine_play_sound_pooled(pEngine, pFilePath, pNode, nodeInputBusIndex, volume);
+    }
+
     /*
     We want to check if we can recycle an already-allocated inlined sound. Since this is just a
     helper I'm not *too* concerned about performance here and I'm happy to use a lock to keep
@@ -75715,6 +85860,8 @@ MA_API ma_result ma_engine_play_sound_ex(ma_engine* pEngine, const char* pFilePa
 
             result = ma_sound_init_from_file(pEngine, pFilePath, soundFlags, NULL, NULL, &pSound->sound);
             if (result == MA_SUCCESS) {
+                ma_sound_set_volume(&pSound->sound, volume);
+
                 /* Now attach the sound to the graph. */
                 result = ma_node_attach_output_bus(pSound, 0, pNode, nodeInputBusIndex);
                 if (result == MA_SUCCESS) {
@@ -75754,12 +85901,157 @@ MA_API ma_result ma_engine_play_sound_ex(ma_engine* pEngine, const char* pFilePa
     return result;
 }
 
+MA_API ma_result ma_engine_play_sound_ex(ma_engine* pEngine, const char* pFilePath, ma_node* pNode, ma_uint32 nodeInputBusIndex)
+{
+    return ma_engine_play_sound_with_volume(pEngine, pFilePath, pNode, nodeInputBusIndex, 1);
+}
+
 MA_API ma_result ma_engine_play_sound(ma_engine* pEngine, const char* pFilePath, ma_sound_group* pGroup)
 {
     return ma_engine_play_sound_ex(pEngine, pFilePath, pGroup, 0);
 }
 #endif
 
+MA_API ma_result ma_engine_get_inlined_sound_pool_stats(const ma_engine* pEngine, ma_inlined_sound_pool_stats* pStats)
+{
+    ma_engine* pEngineNonConst = (ma_engine*)pEngine;   /* For the atomic loads. */
+
+    if (pStats == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    MA_ZERO_OBJECT(pStats);
+
+    if (pEngine == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    pStats->capacity        = pEngine->inlinedSoundPoolCapacity;
+    pStats->activeCount     = ma_atomic_load_32(&pEngineNonConst->inlinedSoundPoolActiveCount);
+    pStats->peakActiveCount = ma_atomic_load_32(&pEngineNonConst->inlinedSoundPoolPeakActiveCount);
+    pStats->playCount       = ma_atomic_load_64(&pEngineNonConst->inlinedSoundPoolPlayCount);
+    pStats->reuseCount      = ma_atomic_load_64(&pEngineNonConst->inlinedSoundPoolReuseCount);
+    pStats->stealCount      = ma_atomic_load_64(&pEngineNonConst->inlinedSoundPoolStealCount);
+    pStats->rejectCount     = ma_atomic_load_64(&pEngineNonConst->inlinedSoundPoolRejectCount);
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_uint32 ma_engine_get_real_sound_count(const ma_engine* pEngine)
+{
+    if (pEngine == NULL) {
+        return 0;
+    }
+
+    return ma_atomic_load_32(&((ma_engine*)pEngine)->lastRealSoundCount);
+}
+
+MA_API ma_uint32 ma_engine_get_virtual_sound_count(const ma_engine* pEngine)
+{
+    if (pEngine == NULL) {
+        return 0;
+    }
+
+    return ma_atomic_load_32(&((ma_engine*)pEngine)->lastVirtualSoundCount);
+}
+
+MA_API ma_sound_group* ma_engine_get_sample_rate_group(ma_engine* pEngine, ma_uint32 sampleRate)
+{
+    ma_sound_group* pGroup = NULL;
+    ma_uint32 iGroup;
+
+    if (pEngine == NULL || pEngine->pSampleRateGroups == NULL) {
+        return NULL;
+    }
+
+    ma_spinlock_lock(&pEngine->sampleRateGroupLock);
+    {
+        for (iGroup = 0; iGroup < MA_ENGINE_MAX_SAMPLE_RATE_GROUPS; iGroup += 1) {
+            if (pEngine->sampleRateGroupStates[iGroup] == MA_SAMPLE_RATE_GROUP_STATE_READY && pEngine->sampleRateGroupRates[iGroup] == sampleRate) {
+                pGroup = &pEngine->pSampleRateGroups[iGroup];
+                break;
+            }
+        }
+    }
+    ma_spinlock_unlock(&pEngine->sampleRateGroupLock);
+
+    return pGroup;
+}
+
+MA_API ma_node* ma_engine_get_ambisonic_bus(ma_engine* pEngine)
+{
+    if (pEngine == NULL || pEngine->ambisonicOrder == 0) {
+        return NULL;
+    }
+
+    return &pEngine->ambisonicBus;
+}
+
+MA_API ma_result ma_engine_acquire_sound_transforms(ma_engine* pEngine, ma_sound_transform** ppTransforms, ma_uint32* pCapacity)
+{
+    if (ppTransforms != NULL) {
+        *ppTransforms = NULL;
+    }
+
+    if (pCapacity != NULL) {
+        *pCapacity = 0;
+    }
+
+    if (pEngine == NULL || ppTransforms == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (pEngine->pSoundTransforms == NULL) {
+        return MA_INVALID_OPERATION;    /* soundTransformCapacity was not set in the engine config. */
+    }
+
+    /* The write block is only ever touched by the updating thread so there's no need to lock here. */
+    *ppTransforms = pEngine->pSoundTransforms + (pEngine->soundTransformCapacity * pEngine->soundTransformWriteBlock);
+
+    if (pCapacity != NULL) {
+        *pCapacity = pEngine->soundTransformCapacity;
+    }
+
+    return MA_SUCCESS;
+}
+
+MA_API ma_result ma_engine_commit_sound_transforms(ma_engine* pEngine, ma_uint32 count)
+{
+    ma_uint32 state;
+
+    if (pEngine == NULL) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (pEngine->pSoundTransforms == NULL) {
+        return MA_INVALID_OPERATION;
+    }
+
+    if (count > pEngine->soundTransformCapacity) {
+        return MA_INVALID_ARGS;
+    }
+
+    pEngine->soundTransformCounts[pEngine->soundTransformWriteBlock] = count;
+
+    state = ma_engine_lock_pending_sound_transforms(pEngine);
+    {
+        /*
+        If the audio thread hasn't got to the previous block yet it needs to be applied now. Otherwise it'll be
+        overwritten by the next acquire and any sound that isn't in the new block would miss its update. It's
+        done before the new block is published so the two can't be applied out of order.
+        */
+        ma_uint32 middleBlock = state & MA_SOUND_TRANSFORM_STATE_INDEX_MASK;
+        if ((state & MA_SOUND_TRANSFORM_STATE_PENDING) != 0) {
+            ma_engine_apply_sound_transforms(pEngine->pSoundTransforms + (pEngine->soundTransformCapacity * middleBlock), pEngine->soundTransformCounts[middleBlock]);
+        }
+
+        ma_atomic_exchange_32(&pEngine->soundTransformState, pEngine->soundTransformWriteBlock | MA_SOUND_TRANSFORM_STATE_PENDING);
+        pEngine->soundTransformWriteBlock = middleBlock;
+    }
+
+    return MA_SUCCESS;
+}
+
 
 static ma_result ma_sound_preinit(ma_engine* pEngine, ma_sound* pSound)
 {
@@ -75777,11 +86069,82 @@ static ma_result ma_sound_preinit(ma_engine* pEngine, ma_sound* pSound)
     return MA_SUCCESS;
 }
 
+static ma_sound_group* ma_engine_acquire_sample_rate_group(ma_engine* pEngine, ma_uint32 sampleRate)
+{
+    ma_sound_group* pGroup = NULL;
+    ma_uint32 iGroup;
+    ma_uint32 iEmptyGroup = MA_ENGINE_MAX_SAMPLE_RATE_GROUPS;
+    ma_sound_group_config groupConfig;
+    ma_result result;
+
+    MA_ASSERT(pEngine != NULL);
+
+    if (pEngine->pSampleRateGroups == NULL) {
+        return NULL;
+    }
+
+    /*
+    Initializing a group allocates and attaches a node so it's done outside of the lock. The slot is
+    reserved under the lock first so no other thread can initialize a group for the same rate. Sounds
+    that turn up while the group for their rate is still being initialized just do their own resampling.
+    */
+    ma_spinlock_lock(&pEngine->sampleRateGroupLock);
+    {
+        for (iGroup = 0; iGroup < MA_ENGINE_MAX_SAMPLE_RATE_GROUPS; iGroup += 1) {
+            if (pEngine->sampleRateGroupStates[iGroup] == MA_SAMPLE_RATE_GROUP_STATE_EMPTY) {
+                if (iEmptyGroup == MA_ENGINE_MAX_SAMPLE_RATE_GROUPS) {
+                    iEmptyGroup = iGroup;
+                }
+            } else if (pEngine->sampleRateGroupRates[iGroup] == sampleRate) {
+                if (pEngine->sampleRateGroupStates[iGroup] == MA_SAMPLE_RATE_GROUP_STATE_READY) {
+                    pGroup = &pEngine->pSampleRateGroups[iGroup];
+                }
+
+                iEmptyGroup = MA_ENGINE_MAX_SAMPLE_RATE_GROUPS;    /* Don't initialize another one. */
+                break;
+            }
+        }
+
+        if (pGroup == NULL && iEmptyGroup < MA_ENGINE_MAX_SAMPLE_RATE_GROUPS) {
+            pEngine->sampleRateGroupRates[iEmptyGroup]  = sampleRate;
+            pEngine->sampleRateGroupStates[iEmptyGroup] = MA_SAMPLE_RATE_GROUP_STATE_INITIALIZING;
+        }
+    }
+    ma_spinlock_unlock(&pEngine->sampleRateGroupLock);
+
+    /* If there's no group for this rate and we couldn't reserve a slot, the sound will just do its own resampling. */
+    if (pGroup != NULL || iEmptyGroup == MA_ENGINE_MAX_SAMPLE_RATE_GROUPS) {
+        return pGroup;
+    }
+
+    groupConfig = ma_sound_group_config_init_2(pEngine);
+    groupConfig.sampleRate = sampleRate;
+    groupConfig.flags      = MA_SOUND_FLAG_NO_SPATIALIZATION;  /* The sounds in the group are spatialized individually. */
+
+    result = ma_sound_group_init_ex(pEngine, &groupConfig, &pEngine->pSampleRateGroups[iEmptyGroup]);
+
+    /* Publish the group, or give the slot back if it failed so a later sound can try again. */
+    ma_spinlock_lock(&pEngine->sampleRateGroupLock);
+    {
+        if (result == MA_SUCCESS) {
+            pEngine->sampleRateGroupStates[iEmptyGroup] = MA_SAMPLE_RATE_GROUP_STATE_READY;
+            pGroup = &pEngine->pSampleRateGroups[iEmptyGroup];
+        } else {
+            pEngine->sampleRateGroupStates[iEmptyGroup] = MA_SAMPLE_RATE_GROUP_STATE_EMPTY;
+        }
+    }
+    ma_spinlock_unlock(&pEngine->sampleRateGroupLock);
+
+    return pGroup;
+}
+
 static ma_result ma_sound_init_from_data_source_internal(ma_engine* pEngine, const ma_sound_config* pConfig, ma_sound* pSound)
 {
     ma_result result;
     ma_engine_node_config engineNodeConfig;
     ma_engine_node_type type;   /* Will be set to ma_engine_node_type_group if no data source is specified. */
+    ma_node* pInitialAttachment;
+    ma_uint32 initialAttachmentInputBusIndex;
 
     /* Do not clear pSound to zero here - that's done at a higher level with ma_sound_preinit(). */
     MA_ASSERT(pEngine != NULL);
@@ -75809,6 +86172,7 @@ static ma_result ma_sound_init_from_data_source_internal(ma_engine* pEngine, con
     engineNodeConfig.channelsOut                 = pConfig->channelsOut;
     engineNodeConfig.volumeSmoothTimeInPCMFrames = pConfig->volumeSmoothTimeInPCMFrames;
     engineNodeConfig.monoExpansionMode           = pConfig->monoExpansionMode;
+    engineNodeConfig.priority                    = pConfig->priority;
 
     if (engineNodeConfig.volumeSmoothTimeInPCMFrames == 0) {
         engineNodeConfig.volumeSmoothTimeInPCMFrames = pEngine->defaultVolumeSmoothTimeInPCMFrames;
@@ -75828,8 +86192,47 @@ static ma_result ma_sound_init_from_data_source_internal(ma_engine* pEngine, con
         if (engineNodeConfig.channelsOut == MA_SOUND_SOURCE_CHANNEL_COUNT) {
             engineNodeConfig.channelsOut = engineNodeConfig.channelsIn;
         }
+    } else {
+        /*
+        For groups, the sample rate is the rate that attached sounds are mixed at. If it's not specified, it's the rate
+        of whatever the group is attached to so that a group nested inside a group running at a lower rate runs at the
+        lower rate as well.
+        */
+        engineNodeConfig.sampleRate = pConfig->sampleRate;
+        if (engineNodeConfig.sampleRate == 0) {
+            engineNodeConfig.sampleRate = ma_engine_get_node_input_sample_rate(pEngine, pConfig->pInitialAttachment);
+        }
     }
 
+    pInitialAttachment             = pConfig->pInitialAttachment;
+    initialAttachmentInputBusIndex = pConfig->initialAttachmentInputBusIndex;
+
+    /*
+    Sounds that would otherwise be attached to the endpoint can be attached to a group running at their sample rate
+    so that sample rate conversion is done once for the whole group instead of once for each sound.
+    */
+    if (type == ma_engine_node_type_sound && pInitialAttachment == NULL && (pConfig->flags & MA_SOUND_FLAG_NO_DEFAULT_ATTACHMENT) == 0 && pEngine->groupSoundsBySampleRate) {
+        if (engineNodeConfig.sampleRate != 0 && engineNodeConfig.sampleRate != ma_engine_get_sample_rate(pEngine)) {
+            pInitialAttachment = ma_engine_acquire_sample_rate_group(pEngine, engineNodeConfig.sampleRate);
+            initialAttachmentInputBusIndex = 0;
+        }
+    }
+
+    /*
+    Spatialized sounds that would otherwise be attached to the endpoint are encoded to the ambisonic bus when it's
+    enabled. The output channel count of the sound is the number of ambisonic channels rather than the number of
+    speakers. Sounds with an explicit output channel count are left alone.
+    */
+    if (pInitialAttachment == NULL && (pConfig->flags & MA_SOUND_FLAG_NO_DEFAULT_ATTACHMENT) == 0 && (pConfig->flags & MA_SOUND_FLAG_NO_SPATIALIZATION) == 0 && pConfig->channelsOut == 0 && pEngine->ambisonicOrder > 0) {
+        engineNodeConfig.ambisonicOrder = pEngine->ambisonicOrder;
+        engineNodeConfig.channelsOut    = ma_ambisonic_get_channel_count(pEngine->ambisonicOrder);
+        pInitialAttachment              = &pEngine->ambisonicBus;
+        initialAttachmentInputBusIndex  = 0;
+    }
+
+    /* The output needs to be at whatever rate the node we're attaching to is mixing at. */
+    engineNodeConfig.sampleRateOut = ma_engine_get_node_input_sample_rate(pEngine, pInitialAttachment);
+
 
     /* Getting here means we should have a valid channel count and we can initialize the engine node. */
     result = ma_engine_node_init(&engineNodeConfig, &pEngine->allocationCallbacks, &pSound->engineNode);
@@ -75838,14 +86241,14 @@ static ma_result ma_sound_init_from_data_source_internal(ma_engine* pEngine, con
     }
 
     /* If no attachment is specified, attach the sound straight to the endpoint. */
-    if (pConfig->pInitialAttachment == NULL) {
+    if (pInitialAttachment == NULL) {
         /* No group. Attach straight to the endpoint by default, unless the caller has requested that it not. */
         if ((pConfig->flags & MA_SOUND_FLAG_NO_DEFAULT_ATTACHMENT) == 0) {
             result = ma_node_attach_output_bus(pSound, 0, ma_node_graph_get_endpoint(&pEngine->nodeGraph), 0);
         }
     } else {
         /* An attachment is specified. Attach to it by default. The sound has only a single output bus, and the config will specify which input bus to attach to. */
-        result = ma_node_attach_output_bus(pSound, 0, pConfig->pInitialAttachment, pConfig->initialAttachmentInputBusIndex);
+        result = ma_node_attach_output_bus(pSound, 0, pInitialAttachment, initialAttachmentInputBusIndex);
     }
 
     if (result != MA_SUCCESS) {
@@ -76017,6 +86420,7 @@ MA_API ma_result ma_sound_init_copy(ma_engine* pEngine, const ma_sound* pExistin
     config.pInitialAttachment          = pGroup;
     config.monoExpansionMode           = pExistingSound->engineNode.monoExpansionMode;
     config.volumeSmoothTimeInPCMFrames = pExistingSound->engineNode.volumeSmoothTimeInPCMFrames;
+    config.priority                    = ma_sound_get_priority(pExistingSound);
 
     result = ma_sound_init_from_data_source_internal(pEngine, &config, pSound);
     if (result != MA_SUCCESS) {
@@ -76081,6 +86485,9 @@ MA_API void ma_sound_uninit(ma_sound* pSound)
         return;
     }
 
+    /* Make sure the audio thread doesn't try applying a transform to this sound after it's been uninitialized. */
+    ma_engine_remove_pending_sound_transforms(pSound->engineNode.pEngine, pSound);
+
     /*
     Always uninitialize the node first. This ensures it's detached from the graph and does not return until it has done
     so which makes thread safety beyond this point trivial.
@@ -76334,6 +86741,42 @@ MA_API ma_vec3f ma_sound_get_direction_to_listener(const ma_sound* pSound)
     return ma_vec3f_normalize(ma_vec3f_neg(relativePos));
 }
 
+MA_API void ma_sound_set_priority(ma_sound* pSound, ma_uint8 priority)
+{
+    if (pSound == NULL) {
+        return;
+    }
+
+    ma_atomic_exchange_32(&pSound->engineNode.priority, priority);
+}
+
+MA_API ma_uint8 ma_sound_get_priority(const ma_sound* pSound)
+{
+    if (pSound == NULL) {
+        return 0;
+    }
+
+    return (ma_uint8)ma_atomic_load_32(&pSound->engineNode.priority);
+}
+
+MA_API ma_bool32 ma_sound_is_virtual(const ma_sound* pSound)
+{
+    if (pSound == NULL) {
+        return MA_FALSE;
+    }
+
+    return ma_atomic_load_32(&pSound->engineNode.isVirtual);
+}
+
+MA_API ma_sound_lod ma_sound_get_lod(const ma_sound* pSound)
+{
+    if (pSound == NULL) {
+        return ma_sound_lod_full;
+    }
+
+    return (ma_sound_lod)ma_atomic_load_32(&pSound->engineNode.lod);
+}
+
 MA_API void ma_sound_set_position(ma_sound* pSound, float x, float y, float z)
 {
     if (pSound == NULL) {
@@ -76807,7 +87250,7 @@ MA_API ma_result ma_sound_get_data_format(ma_sound* pSound, ma_format* pFormat,
         }
 
         if (pSampleRate != NULL) {
-            *pSampleRate = pSound->engineNode.resampler.config.sampleRateIn;
+            *pSampleRate = pSound->engineNode.sampleRate;  /* Not the resampler's input rate because that's been reduced by the greatest common factor. */
         }
 
         if (pChannelMap != NULL) {
@@ -76963,6 +87406,15 @@ MA_API ma_engine* ma_sound_group_get_engine(const ma_sound_group* pGroup)
     return ma_sound_get_engine(pGroup);
 }
 
+MA_API ma_uint32 ma_sound_group_get_sample_rate(const ma_sound_group* pGroup)
+{
+    if (pGroup == NULL) {
+        return 0;
+    }
+
+    return pGroup->engineNode.sampleRate;
+}
+
 MA_API ma_result ma_sound_group_start(ma_sound_group* pGroup)
 {
     return ma_sound_start(pGroup);
@@ -1,6 +1,12 @@
 
 #include "../test_common/ma_test_common.c"
+#include "../../extras/nodes/ma_convolution_node/ma_convolution_node.c"
 #include "ma_test_automated_data_converter.c"
+#include "ma_test_automated_format_conversion.c"
+#include "ma_test_automated_mixing.c"
+#include "ma_test_automated_node_graph.c"
+#include "ma_test_automated_engine.c"
+#include "ma_test_automated_convolution.c"
 
 int main(int argc, char** argv)
 {
@@ -16,6 +22,31 @@ int main(int argc, char** argv)
         return result;
     }
 
+    result = ma_register_test("Format Conversion", test_entry__format_conversion);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Mixing", test_entry__mixing);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Node Graph", test_entry__node_graph);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Engine", test_entry__engine);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Convolution", test_entry__convolution);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
     for (iTest = 0; iTest < g_Tests.count; iTest += 1) {
         printf("=== BEGIN %s ===\n", g_Tests.pTests[iTest].pName);
         result = g_Tests.pTests[iTest].onEntry(argc, argv);
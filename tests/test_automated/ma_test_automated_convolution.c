@@ -0,0 +1,164 @@
+#define MA_CONVOLUTION_TEST_FRAME_COUNT     4096
+#define MA_CONVOLUTION_TEST_IR_LENGTH       700     /* Not a multiple of any block size so the last partition is partially filled. */
+#define MA_CONVOLUTION_TEST_MAX_CHANNELS    3
+
+static float g_convolutionTestInput[MA_CONVOLUTION_TEST_FRAME_COUNT * MA_CONVOLUTION_TEST_MAX_CHANNELS];
+static float g_convolutionTestOutput[MA_CONVOLUTION_TEST_FRAME_COUNT * MA_CONVOLUTION_TEST_MAX_CHANNELS];
+static float g_convolutionTestImpulseResponse[MA_CONVOLUTION_TEST_IR_LENGTH * MA_CONVOLUTION_TEST_MAX_CHANNELS];
+
+static float test_convolution__direct(ma_uint32 channels, ma_uint32 impulseResponseChannels, ma_uint32 iChannel, ma_int32 iFrame)
+{
+    ma_uint32 iChannelIR = (impulseResponseChannels == 1) ? 0 : iChannel;
+    ma_int32 iTap;
+    float sum = 0;
+
+    for (iTap = 0; iTap < MA_CONVOLUTION_TEST_IR_LENGTH && iTap <= iFrame; iTap += 1) {
+        sum += g_convolutionTestImpulseResponse[iTap*impulseResponseChannels + iChannelIR] * g_convolutionTestInput[(iFrame - iTap)*channels + iChannel];
+    }
+
+    return sum;
+}
+
+static ma_result test_convolution__by_config(ma_uint32 channels, ma_uint32 impulseResponseChannels, ma_uint32 blockSize, ma_uint32 readSize)
+{
+    ma_result result;
+    ma_convolver_config config;
+    ma_convolver convolver;
+    ma_uint32 latency;
+    ma_uint32 iFrame;
+    ma_uint32 iChannel;
+    ma_lcg lcg;
+
+    printf("    %d channels, %d impulse response channels, block %d, read %d... ", (int)channels, (int)impulseResponseChannels, (int)blockSize, (int)readSize);
+
+    ma_lcg_seed(&lcg, 4321);
+
+    for (iFrame = 0; iFrame < MA_CONVOLUTION_TEST_FRAME_COUNT * channels; iFrame += 1) {
+        g_convolutionTestInput[iFrame] = ma_lcg_rand_range_f32(&lcg, -1, 1);
+    }
+
+    for (iFrame = 0; iFrame < MA_CONVOLUTION_TEST_IR_LENGTH * impulseResponseChannels; iFrame += 1) {
+        g_convolutionTestImpulseResponse[iFrame] = ma_lcg_rand_range_f32(&lcg, -1, 1) * 0.05f;
+    }
+
+    config = ma_convolver_config_init(channels, g_convolutionTestImpulseResponse, MA_CONVOLUTION_TEST_IR_LENGTH, impulseResponseChannels);
+    config.blockSizeInFrames = blockSize;
+    config.dry               = 0.5f;
+
+    result = ma_convolver_init(&config, NULL, &convolver);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_convolver_init)\n");
+        return result;
+    }
+
+    latency = ma_convolver_get_latency(&convolver);
+
+    /* The read size is not a multiple of the block size so blocks get filled across several calls. */
+    for (iFrame = 0; iFrame < MA_CONVOLUTION_TEST_FRAME_COUNT; iFrame += readSize) {
+        ma_uint32 frameCount = ma_min(readSize, MA_CONVOLUTION_TEST_FRAME_COUNT - iFrame);
+        ma_convolver_process_pcm_frames(&convolver, g_convolutionTestOutput + iFrame*channels, g_convolutionTestInput + iFrame*channels, frameCount);
+    }
+
+    ma_convolver_uninit(&convolver, NULL);
+
+    /* The wet and dry signals are both delayed by the latency. */
+    for (iFrame = 0; iFrame < MA_CONVOLUTION_TEST_FRAME_COUNT; iFrame += 1) {
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            float expected = 0;
+            float actual = g_convolutionTestOutput[iFrame*channels + iChannel];
+
+            if (iFrame >= latency) {
+                expected = test_convolution__direct(channels, impulseResponseChannels, iChannel, (ma_int32)(iFrame - latency)) + g_convolutionTestInput[(iFrame - latency)*channels + iChannel] * 0.5f;
+            }
+
+            if (ma_abs(actual - expected) > 0.0001f) {
+                printf("FAILED (frame %d, channel %d: %f != %f)\n", (int)iFrame, (int)iChannel, actual, expected);
+                return MA_ERROR;
+            }
+        }
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+static ma_result test_convolution__node_block_size(ma_uint16 nodeCacheCapInFrames, ma_uint32 expectedBlockSize)
+{
+    ma_result result;
+    ma_node_graph_config nodeGraphConfig;
+    ma_node_graph nodeGraph;
+    ma_convolution_node_config nodeConfig;
+    ma_convolution_node node;
+    ma_uint32 latency;
+
+    printf("    node cache %d... ", (int)nodeCacheCapInFrames);
+
+    nodeGraphConfig = ma_node_graph_config_init(1);
+    nodeGraphConfig.nodeCacheCapInFrames = nodeCacheCapInFrames;
+
+    result = ma_node_graph_init(&nodeGraphConfig, NULL, &nodeGraph);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_node_graph_init)\n");
+        return result;
+    }
+
+    nodeConfig = ma_convolution_node_config_init(1, g_convolutionTestImpulseResponse, MA_CONVOLUTION_TEST_IR_LENGTH, 1);
+    result = ma_convolution_node_init(&nodeGraph, &nodeConfig, NULL, &node);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_convolution_node_init)\n");
+        ma_node_graph_uninit(&nodeGraph, NULL);
+        return result;
+    }
+
+    latency = ma_convolver_get_latency(&node.convolver);
+
+    ma_convolution_node_uninit(&node, NULL);
+    ma_node_graph_uninit(&nodeGraph, NULL);
+
+    if (latency != expectedBlockSize) {
+        printf("FAILED (block size %d != %d)\n", (int)latency, (int)expectedBlockSize);
+        return MA_ERROR;
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+int test_entry__convolution(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+
+    (void)argc;
+    (void)argv;
+
+    printf("Partitioned vs direct\n");
+    if (test_convolution__by_config(1, 1, 256, 333) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_convolution__by_config(2, 1, 64, 333) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_convolution__by_config(2, 2, 128, 77) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_convolution__by_config(3, 3, 16, 1000) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("Node block size\n");
+    if (test_convolution__node_block_size(480, 256) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_convolution__node_block_size(1024, 1024) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_convolution__node_block_size(100, 64) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    } else {
+        return 0;
+    }
+}
@@ -170,6 +170,12 @@ ma_result test_data_converter__resampling_expected_output()
         hasError = MA_TRUE;
     }
 
+    printf("Polyphase\n");
+    result = test_data_converter__resampling_expected_output_by_algorithm(ma_resample_algorithm_polyphase);
+    if (result != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
     if (hasError) {
         return MA_ERROR;
     } else {
@@ -317,6 +323,895 @@ ma_result test_data_converter__resampling_required_input()
         hasError = MA_TRUE;
     }
 
+    printf("Polyphase\n");
+    result = test_data_converter__resampling_required_input_by_algorithm(ma_resample_algorithm_polyphase);
+    if (result != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return MA_ERROR;
+    } else {
+        return MA_SUCCESS;
+    }
+}
+
+
+
+
+#define MA_POLYPHASE_TEST_FRAME_COUNT   4096
+#define MA_POLYPHASE_TEST_FREQUENCY     1000.0
+
+ma_result test_data_converter__resampling_polyphase_accuracy_by_rate_and_quality(ma_uint32 rateIn, ma_uint32 rateOut, ma_polyphase_resampler_quality quality, float tolerance)
+{
+    ma_result result;
+    ma_polyphase_resampler_config config;
+    ma_polyphase_resampler resampler;
+    float input[MA_POLYPHASE_TEST_FRAME_COUNT];
+    float output[MA_POLYPHASE_TEST_FRAME_COUNT * 3];
+    ma_uint64 frameCountIn;
+    ma_uint64 frameCountOut;
+    ma_uint64 expectedFrameCountOut;
+    ma_uint64 latency;
+    ma_uint64 iFrame;
+    float maxError = 0;
+
+    printf("    %d -> %d, quality %d... ", (int)rateIn, (int)rateOut, (int)quality);
+
+    config = ma_polyphase_resampler_config_init(ma_format_f32, 1, rateIn, rateOut);
+    config.quality = quality;
+
+    result = ma_polyphase_resampler_init(&config, NULL, &resampler);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_polyphase_resampler_init)\n");
+        return result;
+    }
+
+    for (iFrame = 0; iFrame < MA_POLYPHASE_TEST_FRAME_COUNT; iFrame += 1) {
+        input[iFrame] = (float)ma_sind(2 * MA_PI_D * MA_POLYPHASE_TEST_FREQUENCY * iFrame / rateIn);
+    }
+
+    latency = ma_polyphase_resampler_get_input_latency(&resampler);
+    ma_polyphase_resampler_get_expected_output_frame_count(&resampler, MA_POLYPHASE_TEST_FRAME_COUNT, &expectedFrameCountOut);
+
+    frameCountIn  = MA_POLYPHASE_TEST_FRAME_COUNT;
+    frameCountOut = ma_countof(output);
+    ma_polyphase_resampler_process_pcm_frames(&resampler, input, &frameCountIn, output, &frameCountOut);
+    ma_polyphase_resampler_uninit(&resampler, NULL);
+
+    if (frameCountIn != MA_POLYPHASE_TEST_FRAME_COUNT || frameCountOut != expectedFrameCountOut) {
+        printf("FAILED (frameCountIn=%d, frameCountOut=%d, expected=%d)\n", (int)frameCountIn, (int)frameCountOut, (int)expectedFrameCountOut);
+        return MA_ERROR;
+    }
+
+    /* Output frame N sits at input position N*rateIn/rateOut - latency. Skip anything that overlaps the edges of the input. */
+    for (iFrame = 0; iFrame < frameCountOut; iFrame += 1) {
+        double position = (double)iFrame * rateIn / rateOut - (double)latency;
+        float expected;
+        float error;
+
+        if (position < (double)latency || position + latency >= MA_POLYPHASE_TEST_FRAME_COUNT) {
+            continue;
+        }
+
+        expected = (float)ma_sind(2 * MA_PI_D * MA_POLYPHASE_TEST_FREQUENCY * position / rateIn);
+        error    = output[iFrame] - expected;
+        if (error < 0) {
+            error = -error;
+        }
+
+        if (maxError < error) {
+            maxError = error;
+        }
+    }
+
+    if (maxError > tolerance) {
+        printf("FAILED (maxError=%f)\n", maxError);
+        return MA_ERROR;
+    }
+
+    printf("PASSED (maxError=%f)\n", maxError);
+    return MA_SUCCESS;
+}
+
+/*
+A tone above the output Nyquist frequency should be removed by the low pass filter rather than folding back into
+the passband. The attenuation is measured against the peak of the input, in decibels.
+*/
+ma_result test_data_converter__resampling_polyphase_stopband_by_rate_and_quality(ma_uint32 rateIn, ma_uint32 rateOut, double frequency, ma_polyphase_resampler_quality quality, float minAttenuationInDB)
+{
+    ma_result result;
+    ma_polyphase_resampler_config config;
+    ma_polyphase_resampler resampler;
+    float input[MA_POLYPHASE_TEST_FRAME_COUNT];
+    float output[MA_POLYPHASE_TEST_FRAME_COUNT * 3];
+    ma_uint64 frameCountIn;
+    ma_uint64 frameCountOut;
+    ma_uint64 latency;
+    ma_uint64 iFrame;
+    float maxOutput = 0;
+    float attenuationInDB;
+
+    printf("    %d -> %d, %d Hz, quality %d... ", (int)rateIn, (int)rateOut, (int)frequency, (int)quality);
+
+    config = ma_polyphase_resampler_config_init(ma_format_f32, 1, rateIn, rateOut);
+    config.quality = quality;
+
+    result = ma_polyphase_resampler_init(&config, NULL, &resampler);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_polyphase_resampler_init)\n");
+        return result;
+    }
+
+    for (iFrame = 0; iFrame < MA_POLYPHASE_TEST_FRAME_COUNT; iFrame += 1) {
+        input[iFrame] = (float)ma_sind(2 * MA_PI_D * frequency * iFrame / rateIn);
+    }
+
+    latency = ma_polyphase_resampler_get_input_latency(&resampler);
+
+    frameCountIn  = MA_POLYPHASE_TEST_FRAME_COUNT;
+    frameCountOut = ma_countof(output);
+    ma_polyphase_resampler_process_pcm_frames(&resampler, input, &frameCountIn, output, &frameCountOut);
+    ma_polyphase_resampler_uninit(&resampler, NULL);
+
+    /* The edges are skipped for the same reason as the accuracy test. The start and end of the tone aren't band limited. */
+    for (iFrame = 0; iFrame < frameCountOut; iFrame += 1) {
+        double position = (double)iFrame * rateIn / rateOut - (double)latency;
+        float sample;
+
+        if (position < (double)latency || position + latency >= MA_POLYPHASE_TEST_FRAME_COUNT) {
+            continue;
+        }
+
+        sample = output[iFrame];
+        if (sample < 0) {
+            sample = -sample;
+        }
+
+        if (maxOutput < sample) {
+            maxOutput = sample;
+        }
+    }
+
+    attenuationInDB = (maxOutput > 0) ? (float)(-20 * log10(maxOutput)) : 1000.0f;
+    if (attenuationInDB < minAttenuationInDB) {
+        printf("FAILED (attenuation=%fdB)\n", attenuationInDB);
+        return MA_ERROR;
+    }
+
+    printf("PASSED (attenuation=%fdB)\n", attenuationInDB);
+    return MA_SUCCESS;
+}
+
+/*
+The SIMD kernels sum in a different order to the scalar kernel so they won't be bit exact, but they should be
+within a few rounding errors of each other. The tolerance is relative to the sum of the magnitudes of the
+products which is what the rounding error is bounded by.
+*/
+static ma_result test_data_converter__resampling_polyphase_kernel(const char* pName, ma_polyphase_resampler_filter_proc onFilter)
+{
+    float coefficients[128];
+    float windows[3 * 128 * 2];
+    float outputScalar[3];
+    float output[3];
+    ma_uint32 windowStride = 128 * 2;
+    ma_uint32 tapCounts[] = {16, 32, 64, 128};
+    ma_uint32 iTapCount;
+    ma_uint32 channels;
+    ma_uint32 iChannel;
+    ma_uint32 iTap;
+    ma_lcg lcg;
+
+    printf("    %s... ", pName);
+
+    ma_lcg_seed(&lcg, 4321);
+
+    for (iTap = 0; iTap < ma_countof(coefficients); iTap += 1) {
+        coefficients[iTap] = ma_lcg_rand_f32(&lcg) * 2 - 1;
+    }
+
+    for (iTap = 0; iTap < ma_countof(windows); iTap += 1) {
+        windows[iTap] = ma_lcg_rand_f32(&lcg) * 2 - 1;
+    }
+
+    for (iTapCount = 0; iTapCount < ma_countof(tapCounts); iTapCount += 1) {
+        for (channels = 1; channels <= 3; channels += 1) {
+            ma_polyphase_resampler_filter_frame__scalar(coefficients, windows, windowStride, tapCounts[iTapCount], channels, outputScalar);
+            onFilter(coefficients, windows, windowStride, tapCounts[iTapCount], channels, output);
+
+            for (iChannel = 0; iChannel < channels; iChannel += 1) {
+                float magnitude = 0;
+                float error;
+
+                for (iTap = 0; iTap < tapCounts[iTapCount]; iTap += 1) {
+                    magnitude += (float)fabs(coefficients[iTap] * windows[iChannel*windowStride + iTap]);
+                }
+
+                error = (float)fabs(output[iChannel] - outputScalar[iChannel]);
+                if (error > magnitude * 1e-5f) {
+                    printf("FAILED (%d taps, %d channels, channel %d: %f != %f)\n", (int)tapCounts[iTapCount], (int)channels, (int)iChannel, output[iChannel], outputScalar[iChannel]);
+                    return MA_ERROR;
+                }
+            }
+        }
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+ma_result test_data_converter__resampling_polyphase_kernels()
+{
+    ma_bool32 hasError = MA_FALSE;
+
+#if defined(MA_SUPPORT_SSE2)
+    if (ma_has_sse2()) {
+        if (test_data_converter__resampling_polyphase_kernel("SSE2", ma_polyphase_resampler_filter_frame__sse2) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+#endif
+#if defined(MA_SUPPORT_AVX2)
+    if (ma_has_avx2()) {
+        if (test_data_converter__resampling_polyphase_kernel("AVX2", ma_polyphase_resampler_filter_frame__avx2) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+#endif
+#if defined(MA_SUPPORT_NEON)
+    if (ma_has_neon()) {
+        if (test_data_converter__resampling_polyphase_kernel("NEON", ma_polyphase_resampler_filter_frame__neon) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+#endif
+
+    if (hasError) {
+        return MA_ERROR;
+    } else {
+        return MA_SUCCESS;
+    }
+}
+
+ma_result test_data_converter__resampling_polyphase_accuracy()
+{
+    ma_bool32 hasError = MA_FALSE;
+    ma_uint32 rates[][2] = {{44100, 48000}, {48000, 44100}, {44100, 96000}, {48000, 16000}};
+    float tolerances[] = {0.005f, 0.001f, 0.0001f, 0.00002f};  /* Indexed by quality. */
+    float attenuations[] = {30, 50, 70, 90};                    /* Indexed by quality. In decibels. */
+    ma_uint32 iRate;
+    ma_uint32 iQuality;
+
+    printf("Polyphase accuracy\n");
+
+    for (iRate = 0; iRate < ma_countof(rates); iRate += 1) {
+        for (iQuality = 0; iQuality < ma_countof(tolerances); iQuality += 1) {
+            if (test_data_converter__resampling_polyphase_accuracy_by_rate_and_quality(rates[iRate][0], rates[iRate][1], (ma_polyphase_resampler_quality)iQuality, tolerances[iQuality]) != MA_SUCCESS) {
+                hasError = MA_TRUE;
+            }
+        }
+    }
+
+    printf("Polyphase stopband\n");
+
+    for (iQuality = 0; iQuality < ma_countof(attenuations); iQuality += 1) {
+        if (test_data_converter__resampling_polyphase_stopband_by_rate_and_quality(48000, 16000, 20000, (ma_polyphase_resampler_quality)iQuality, attenuations[iQuality]) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+        if (test_data_converter__resampling_polyphase_stopband_by_rate_and_quality(48000, 44100, 23000, (ma_polyphase_resampler_quality)iQuality, attenuations[iQuality]) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    printf("Polyphase kernels\n");
+
+    if (test_data_converter__resampling_polyphase_kernels() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return MA_ERROR;
+    } else {
+        return MA_SUCCESS;
+    }
+}
+
+#define MA_LINEAR_BATCHED_TEST_FRAME_COUNT  2000
+#define MA_LINEAR_BATCHED_TEST_MAX_CHANNELS 8
+
+static ma_result test_data_converter__linear_resampler_process_per_frame(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+{
+    /* These are the original per-frame implementations which the batched path needs to match exactly. */
+    if (pResampler->config.format == ma_format_s16) {
+        if (pResampler->config.sampleRateIn > pResampler->config.sampleRateOut) {
+            return ma_linear_resampler_process_pcm_frames_s16_downsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+        } else {
+            return ma_linear_resampler_process_pcm_frames_s16_upsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+        }
+    } else {
+        if (pResampler->config.sampleRateIn > pResampler->config.sampleRateOut) {
+            return ma_linear_resampler_process_pcm_frames_f32_downsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+        } else {
+            return ma_linear_resampler_process_pcm_frames_f32_upsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+        }
+    }
+}
+
+ma_result test_data_converter__resampling_linear_batched_by_config(ma_format format, ma_uint32 channels, ma_uint32 rateIn, ma_uint32 rateOut, ma_uint32 lpfOrder)
+{
+    ma_result result;
+    ma_linear_resampler_config config;
+    ma_linear_resampler resamplerBatched;
+    ma_linear_resampler resamplerPerFrame;
+    static float inputF32[MA_LINEAR_BATCHED_TEST_FRAME_COUNT * MA_LINEAR_BATCHED_TEST_MAX_CHANNELS];
+    static ma_int16 inputS16[MA_LINEAR_BATCHED_TEST_FRAME_COUNT * MA_LINEAR_BATCHED_TEST_MAX_CHANNELS];
+    static float outputBatched[MA_LINEAR_BATCHED_TEST_FRAME_COUNT * MA_LINEAR_BATCHED_TEST_MAX_CHANNELS];
+    static float outputPerFrame[MA_LINEAR_BATCHED_TEST_FRAME_COUNT * MA_LINEAR_BATCHED_TEST_MAX_CHANNELS];
+    const void* pInput;
+    ma_uint32 bpf;
+    ma_uint64 iSample;
+    ma_uint64 framesProcessedIn = 0;
+    ma_uint32 iteration = 0;
+
+    printf("    %s, %d channels, %d -> %d, lpf order %d... ", ma_get_format_name(format), (int)channels, (int)rateIn, (int)rateOut, (int)lpfOrder);
+
+    for (iSample = 0; iSample < MA_LINEAR_BATCHED_TEST_FRAME_COUNT * channels; iSample += 1) {
+        inputF32[iSample] = (float)ma_sind((double)iSample * 0.0123) * 0.9f;
+        inputS16[iSample] = (ma_int16)(inputF32[iSample] * 32767);
+    }
+
+    pInput = (format == ma_format_s16) ? (const void*)inputS16 : (const void*)inputF32;
+    bpf    = ma_get_bytes_per_frame(format, channels);
+
+    config = ma_linear_resampler_config_init(format, channels, rateIn, rateOut);
+    config.lpfOrder = lpfOrder;
+
+    result = ma_linear_resampler_init(&config, NULL, &resamplerBatched);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_linear_resampler_init)\n");
+        return result;
+    }
+
+    result = ma_linear_resampler_init(&config, NULL, &resamplerPerFrame);
+    if (result != MA_SUCCESS) {
+        ma_linear_resampler_uninit(&resamplerBatched, NULL);
+        printf("FAILED (ma_linear_resampler_init)\n");
+        return result;
+    }
+
+    /* Process in uneven chunks so we hit both running out of input and running out of output part way through. */
+    while (framesProcessedIn < MA_LINEAR_BATCHED_TEST_FRAME_COUNT) {
+        ma_uint64 frameCountInBatched;
+        ma_uint64 frameCountInPerFrame;
+        ma_uint64 frameCountOutBatched;
+        ma_uint64 frameCountOutPerFrame;
+
+        frameCountInBatched  = ma_min(MA_LINEAR_BATCHED_TEST_FRAME_COUNT - framesProcessedIn, 1 + (iteration * 37) % 300);
+        frameCountOutBatched = 1 + (iteration * 53) % 250;
+        frameCountInPerFrame  = frameCountInBatched;
+        frameCountOutPerFrame = frameCountOutBatched;
+
+        ma_linear_resampler_process_pcm_frames(&resamplerBatched, ma_offset_ptr(pInput, framesProcessedIn * bpf), &frameCountInBatched, outputBatched, &frameCountOutBatched);
+        test_data_converter__linear_resampler_process_per_frame(&resamplerPerFrame, ma_offset_ptr(pInput, framesProcessedIn * bpf), &frameCountInPerFrame, outputPerFrame, &frameCountOutPerFrame);
+
+        if (frameCountInBatched != frameCountInPerFrame || frameCountOutBatched != frameCountOutPerFrame) {
+            printf("FAILED (frame counts differ: in %d/%d, out %d/%d)\n", (int)frameCountInBatched, (int)frameCountInPerFrame, (int)frameCountOutBatched, (int)frameCountOutPerFrame);
+            result = MA_ERROR;
+            break;
+        }
+
+        if (memcmp(outputBatched, outputPerFrame, (size_t)(frameCountOutBatched * bpf)) != 0) {
+            printf("FAILED (output differs on iteration %d)\n", (int)iteration);
+            result = MA_ERROR;
+            break;
+        }
+
+        framesProcessedIn += frameCountInBatched;
+        iteration += 1;
+    }
+
+    ma_linear_resampler_uninit(&resamplerBatched, NULL);
+    ma_linear_resampler_uninit(&resamplerPerFrame, NULL);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+ma_result test_data_converter__resampling_linear_batched()
+{
+    ma_bool32 hasError = MA_FALSE;
+    ma_format formats[] = {ma_format_s16, ma_format_f32};
+    ma_uint32 channels[] = {1, 2, 3, 6, 8};
+    ma_uint32 rates[][2] = {{44100, 48000}, {48000, 44100}, {44100, 44100}, {48000, 16000}, {22050, 48000}};
+    ma_uint32 lpfOrders[] = {0, 4};
+    ma_uint32 iFormat;
+    ma_uint32 iChannels;
+    ma_uint32 iRate;
+    ma_uint32 iLPFOrder;
+
+    printf("Linear batched\n");
+
+    for (iFormat = 0; iFormat < ma_countof(formats); iFormat += 1) {
+        for (iChannels = 0; iChannels < ma_countof(channels); iChannels += 1) {
+            for (iRate = 0; iRate < ma_countof(rates); iRate += 1) {
+                for (iLPFOrder = 0; iLPFOrder < ma_countof(lpfOrders); iLPFOrder += 1) {
+                    if (test_data_converter__resampling_linear_batched_by_config(formats[iFormat], channels[iChannels], rates[iRate][0], rates[iRate][1], lpfOrders[iLPFOrder]) != MA_SUCCESS) {
+                        hasError = MA_TRUE;
+                    }
+                }
+            }
+        }
+    }
+
+    if (hasError) {
+        return MA_ERROR;
+    } else {
+        return MA_SUCCESS;
+    }
+}
+
+ma_result test_data_converter__resampling_linear_fixed_ratio_by_config(ma_format format, ma_uint32 rateIn, ma_uint32 rateOut, ma_uint32 lpfOrder)
+{
+    ma_result result;
+    ma_linear_resampler_config config;
+    ma_linear_resampler resamplerTable;
+    ma_linear_resampler resamplerGeneric;
+    static float inputF32[MA_LINEAR_BATCHED_TEST_FRAME_COUNT * 2];
+    static ma_int16 inputS16[MA_LINEAR_BATCHED_TEST_FRAME_COUNT * 2];
+    static float outputTable[MA_LINEAR_BATCHED_TEST_FRAME_COUNT * 2];
+    static float outputGeneric[MA_LINEAR_BATCHED_TEST_FRAME_COUNT * 2];
+    const void* pInput;
+    ma_uint32 bpf;
+    ma_uint64 iSample;
+    ma_uint64 framesProcessedIn = 0;
+    ma_uint32 iteration = 0;
+
+    printf("    %s, %d -> %d, lpf order %d... ", ma_get_format_name(format), (int)rateIn, (int)rateOut, (int)lpfOrder);
+
+    for (iSample = 0; iSample < MA_LINEAR_BATCHED_TEST_FRAME_COUNT * 2; iSample += 1) {
+        inputF32[iSample] = (float)ma_sind((double)iSample * 0.0321) * 0.9f;
+        inputS16[iSample] = (ma_int16)(inputF32[iSample] * 32767);
+    }
+
+    pInput = (format == ma_format_s16) ? (const void*)inputS16 : (const void*)inputF32;
+    bpf    = ma_get_bytes_per_frame(format, 2);
+
+    config = ma_linear_resampler_config_init(format, 2, rateIn, rateOut);
+    config.lpfOrder = lpfOrder;
+
+    result = ma_linear_resampler_init(&config, NULL, &resamplerTable);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_linear_resampler_init)\n");
+        return result;
+    }
+
+    result = ma_linear_resampler_init(&config, NULL, &resamplerGeneric);
+    if (result != MA_SUCCESS) {
+        ma_linear_resampler_uninit(&resamplerTable, NULL);
+        printf("FAILED (ma_linear_resampler_init)\n");
+        return result;
+    }
+
+    if (!ma_linear_resampler_is_fixed_ratio(&resamplerTable)) {
+        printf("FAILED (expecting a fixed ratio)\n");
+        result = MA_ERROR;
+    }
+
+    /* The generic path is the reference. The table must give exactly the same output. */
+    resamplerGeneric.isFixedRatio = MA_FALSE;
+
+    while (result == MA_SUCCESS && framesProcessedIn < MA_LINEAR_BATCHED_TEST_FRAME_COUNT) {
+        ma_uint64 frameCountInTable;
+        ma_uint64 frameCountInGeneric;
+        ma_uint64 frameCountOutTable;
+        ma_uint64 frameCountOutGeneric;
+
+        frameCountInTable    = ma_min(MA_LINEAR_BATCHED_TEST_FRAME_COUNT - framesProcessedIn, 1 + (iteration * 41) % 300);
+        frameCountOutTable   = 1 + (iteration * 29) % 250;
+        frameCountInGeneric  = frameCountInTable;
+        frameCountOutGeneric = frameCountOutTable;
+
+        ma_linear_resampler_process_pcm_frames(&resamplerTable,   ma_offset_ptr(pInput, framesProcessedIn * bpf), &frameCountInTable,   outputTable,   &frameCountOutTable);
+        ma_linear_resampler_process_pcm_frames(&resamplerGeneric, ma_offset_ptr(pInput, framesProcessedIn * bpf), &frameCountInGeneric, outputGeneric, &frameCountOutGeneric);
+
+        if (frameCountInTable != frameCountInGeneric || frameCountOutTable != frameCountOutGeneric) {
+            printf("FAILED (frame counts differ: in %d/%d, out %d/%d)\n", (int)frameCountInTable, (int)frameCountInGeneric, (int)frameCountOutTable, (int)frameCountOutGeneric);
+            result = MA_ERROR;
+            break;
+        }
+
+        if (memcmp(outputTable, outputGeneric, (size_t)(frameCountOutTable * bpf)) != 0) {
+            printf("FAILED (output differs on iteration %d)\n", (int)iteration);
+            result = MA_ERROR;
+            break;
+        }
+
+        framesProcessedIn += frameCountInTable;
+        iteration += 1;
+    }
+
+    ma_linear_resampler_uninit(&resamplerTable, NULL);
+    ma_linear_resampler_uninit(&resamplerGeneric, NULL);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+ma_result test_data_converter__resampling_linear_fixed_ratio_rate_change()
+{
+    ma_result result;
+    ma_linear_resampler_config config;
+    ma_linear_resampler resampler;
+    ma_bool32 hasError = MA_FALSE;
+
+    printf("    Rate change... ");
+
+    config = ma_linear_resampler_config_init(ma_format_f32, 2, 44100, 48000);
+    result = ma_linear_resampler_init(&config, NULL, &resampler);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_linear_resampler_init)\n");
+        return result;
+    }
+
+    /* A ratio that doesn't simplify must fall back to the generic path, and switching back must re-enable the table. */
+    ma_linear_resampler_set_rate(&resampler, 44100, 48001);
+    if (ma_linear_resampler_is_fixed_ratio(&resampler)) {
+        hasError = MA_TRUE;
+    }
+
+    ma_linear_resampler_set_rate(&resampler, 44100, 48000);
+    if (!ma_linear_resampler_is_fixed_ratio(&resampler)) {
+        hasError = MA_TRUE;
+    }
+
+    /* The table is sized for the initial ratio so a ratio needing more phases must not use it. */
+    ma_linear_resampler_set_rate(&resampler, 22050, 48000);
+    if (ma_linear_resampler_is_fixed_ratio(&resampler)) {
+        hasError = MA_TRUE;
+    }
+
+    ma_linear_resampler_uninit(&resampler, NULL);
+
+    if (hasError) {
+        printf("FAILED\n");
+        return MA_ERROR;
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+ma_result test_data_converter__resampling_linear_fixed_ratio()
+{
+    ma_bool32 hasError = MA_FALSE;
+    ma_format formats[] = {ma_format_s16, ma_format_f32};
+    ma_uint32 rates[][2] = {{44100, 48000}, {48000, 44100}, {22050, 48000}, {48000, 16000}, {44100, 96000}};
+    ma_uint32 lpfOrders[] = {0, 4};
+    ma_uint32 iFormat;
+    ma_uint32 iRate;
+    ma_uint32 iLPFOrder;
+
+    printf("Linear fixed ratio\n");
+
+    for (iFormat = 0; iFormat < ma_countof(formats); iFormat += 1) {
+        for (iRate = 0; iRate < ma_countof(rates); iRate += 1) {
+            for (iLPFOrder = 0; iLPFOrder < ma_countof(lpfOrders); iLPFOrder += 1) {
+                if (test_data_converter__resampling_linear_fixed_ratio_by_config(formats[iFormat], rates[iRate][0], rates[iRate][1], lpfOrders[iLPFOrder]) != MA_SUCCESS) {
+                    hasError = MA_TRUE;
+                }
+            }
+        }
+    }
+
+    if (test_data_converter__resampling_linear_fixed_ratio_rate_change() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return MA_ERROR;
+    } else {
+        return MA_SUCCESS;
+    }
+}
+
+#define MA_SCRATCH_TEST_FRAME_COUNT   10000
+#define MA_SCRATCH_TEST_MAX_CHANNELS  8
+
+static ma_uint64 test_data_converter__scratch_buffer_run(ma_data_converter* pConverter, const void* pInput, ma_uint64 frameCountIn, void* pOutput, ma_uint64 frameCountOut)
+{
+    ma_uint32 bpfIn  = ma_get_bytes_per_frame(pConverter->formatIn,  pConverter->channelsIn);
+    ma_uint32 bpfOut = ma_get_bytes_per_frame(pConverter->formatOut, pConverter->channelsOut);
+    ma_uint64 framesProcessedIn  = 0;
+    ma_uint64 framesProcessedOut = 0;
+
+    /* Large, uneven chunks so the stack path has to split them up internally. */
+    for (;;) {
+        ma_uint64 frameCountInThisIteration  = ma_min(frameCountIn  - framesProcessedIn,  3001);
+        ma_uint64 frameCountOutThisIteration = ma_min(frameCountOut - framesProcessedOut, 2999);
+
+        ma_data_converter_process_pcm_frames(pConverter, ma_offset_ptr(pInput, framesProcessedIn * bpfIn), &frameCountInThisIteration, ma_offset_ptr(pOutput, framesProcessedOut * bpfOut), &frameCountOutThisIteration);
+
+        framesProcessedIn  += frameCountInThisIteration;
+        framesProcessedOut += frameCountOutThisIteration;
+
+        if (frameCountOutThisIteration == 0) {
+            break;
+        }
+    }
+
+    return framesProcessedOut;
+}
+
+ma_result test_data_converter__scratch_buffer_by_config(ma_format formatIn, ma_format formatOut, ma_uint32 channelsIn, ma_uint32 channelsOut, ma_uint32 rateIn, ma_uint32 rateOut)
+{
+    ma_result result;
+    ma_data_converter_config config;
+    ma_data_converter converterStack;
+    ma_data_converter converterScratch;
+    static float inputF32[MA_SCRATCH_TEST_FRAME_COUNT * MA_SCRATCH_TEST_MAX_CHANNELS];
+    static ma_uint8 input[MA_SCRATCH_TEST_FRAME_COUNT * MA_SCRATCH_TEST_MAX_CHANNELS * 4];
+    static ma_uint8 outputStack[MA_SCRATCH_TEST_FRAME_COUNT * 4 * MA_SCRATCH_TEST_MAX_CHANNELS * 4];
+    static ma_uint8 outputScratch[MA_SCRATCH_TEST_FRAME_COUNT * 4 * MA_SCRATCH_TEST_MAX_CHANNELS * 4];
+    ma_uint64 outputCap = MA_SCRATCH_TEST_FRAME_COUNT * 4;
+    ma_uint64 framesOutStack;
+    ma_uint64 framesOutScratch;
+    ma_uint64 iSample;
+
+    printf("    %s %d -> %s %d, %d -> %d... ", ma_get_format_name(formatIn), (int)channelsIn, ma_get_format_name(formatOut), (int)channelsOut, (int)rateIn, (int)rateOut);
+
+    for (iSample = 0; iSample < MA_SCRATCH_TEST_FRAME_COUNT * channelsIn; iSample += 1) {
+        inputF32[iSample] = (float)ma_sind((double)iSample * 0.0123) * 0.9f;
+    }
+    ma_convert_pcm_frames_format(input, formatIn, inputF32, ma_format_f32, MA_SCRATCH_TEST_FRAME_COUNT, channelsIn, ma_dither_mode_none);
+
+    config = ma_data_converter_config_init(formatIn, formatOut, channelsIn, channelsOut, rateIn, rateOut);
+
+    result = ma_data_converter_init(&config, NULL, &converterStack);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_data_converter_init)\n");
+        return result;
+    }
+
+    config.scratchBufferSizeInFrames = 4096;
+
+    result = ma_data_converter_init(&config, NULL, &converterScratch);
+    if (result != MA_SUCCESS) {
+        ma_data_converter_uninit(&converterStack, NULL);
+        printf("FAILED (ma_data_converter_init)\n");
+        return result;
+    }
+
+    framesOutStack   = test_data_converter__scratch_buffer_run(&converterStack,   input, MA_SCRATCH_TEST_FRAME_COUNT, outputStack,   outputCap);
+    framesOutScratch = test_data_converter__scratch_buffer_run(&converterScratch, input, MA_SCRATCH_TEST_FRAME_COUNT, outputScratch, outputCap);
+
+    if (framesOutStack != framesOutScratch) {
+        printf("FAILED (frame counts differ: %d/%d)\n", (int)framesOutStack, (int)framesOutScratch);
+        result = MA_ERROR;
+    } else if (memcmp(outputStack, outputScratch, (size_t)(framesOutStack * ma_get_bytes_per_frame(formatOut, channelsOut))) != 0) {
+        printf("FAILED (output differs)\n");
+        result = MA_ERROR;
+    }
+
+    ma_data_converter_uninit(&converterStack,   NULL);
+    ma_data_converter_uninit(&converterScratch, NULL);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+ma_result test_data_converter__in_place_by_format(ma_format formatIn, ma_format formatOut, ma_uint32 channels)
+{
+    ma_result result;
+    ma_data_converter_config config;
+    ma_data_converter converter;
+    static float inputF32[MA_SCRATCH_TEST_FRAME_COUNT * MA_SCRATCH_TEST_MAX_CHANNELS];
+    static ma_uint8 buffer[MA_SCRATCH_TEST_FRAME_COUNT * MA_SCRATCH_TEST_MAX_CHANNELS * 4];
+    static ma_uint8 expected[MA_SCRATCH_TEST_FRAME_COUNT * MA_SCRATCH_TEST_MAX_CHANNELS * 4];
+    ma_uint64 frameCountIn  = MA_SCRATCH_TEST_FRAME_COUNT;
+    ma_uint64 frameCountOut = MA_SCRATCH_TEST_FRAME_COUNT;
+    ma_uint64 iSample;
+
+    printf("    In place %s -> %s... ", ma_get_format_name(formatIn), ma_get_format_name(formatOut));
+
+    for (iSample = 0; iSample < MA_SCRATCH_TEST_FRAME_COUNT * channels; iSample += 1) {
+        inputF32[iSample] = (float)ma_sind((double)iSample * 0.0123) * 0.9f;
+    }
+    ma_convert_pcm_frames_format(buffer, formatIn, inputF32, ma_format_f32, MA_SCRATCH_TEST_FRAME_COUNT, channels, ma_dither_mode_none);
+    ma_convert_pcm_frames_format(expected, formatOut, buffer, formatIn, MA_SCRATCH_TEST_FRAME_COUNT, channels, ma_dither_mode_none);
+
+    config = ma_data_converter_config_init(formatIn, formatOut, channels, channels, 48000, 48000);
+
+    result = ma_data_converter_init(&config, NULL, &converter);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_data_converter_init)\n");
+        return result;
+    }
+
+    ma_data_converter_process_pcm_frames(&converter, buffer, &frameCountIn, buffer, &frameCountOut);
+    ma_data_converter_uninit(&converter, NULL);
+
+    if (frameCountOut != MA_SCRATCH_TEST_FRAME_COUNT || memcmp(buffer, expected, (size_t)(frameCountOut * ma_get_bytes_per_frame(formatOut, channels))) != 0) {
+        printf("FAILED\n");
+        return MA_ERROR;
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+ma_result test_data_converter__scratch_buffer()
+{
+    ma_bool32 hasError = MA_FALSE;
+
+    printf("Scratch buffers\n");
+
+    /* Channels only. */
+    if (test_data_converter__scratch_buffer_by_config(ma_format_s24, ma_format_f32, 8, 2, 48000, 48000) != MA_SUCCESS) { hasError = MA_TRUE; }
+    if (test_data_converter__scratch_buffer_by_config(ma_format_s16, ma_format_s32, 2, 8, 48000, 48000) != MA_SUCCESS) { hasError = MA_TRUE; }
+
+    /* Resampling only. */
+    if (test_data_converter__scratch_buffer_by_config(ma_format_s32, ma_format_u8,  6, 6, 44100, 48000) != MA_SUCCESS) { hasError = MA_TRUE; }
+    if (test_data_converter__scratch_buffer_by_config(ma_format_f32, ma_format_f32, 8, 8, 48000, 44100) != MA_SUCCESS) { hasError = MA_TRUE; }
+
+    /* Resampling first. */
+    if (test_data_converter__scratch_buffer_by_config(ma_format_s16, ma_format_s32, 2, 8, 44100, 48000) != MA_SUCCESS) { hasError = MA_TRUE; }
+    if (test_data_converter__scratch_buffer_by_config(ma_format_u8,  ma_format_f32, 1, 6, 48000, 22050) != MA_SUCCESS) { hasError = MA_TRUE; }
+
+    /* Channels first. */
+    if (test_data_converter__scratch_buffer_by_config(ma_format_f32, ma_format_s16, 8, 2, 48000, 44100) != MA_SUCCESS) { hasError = MA_TRUE; }
+    if (test_data_converter__scratch_buffer_by_config(ma_format_s24, ma_format_u8,  6, 1, 22050, 48000) != MA_SUCCESS) { hasError = MA_TRUE; }
+
+    /* In place. */
+    if (test_data_converter__in_place_by_format(ma_format_f32, ma_format_s16, 2) != MA_SUCCESS) { hasError = MA_TRUE; }
+    if (test_data_converter__in_place_by_format(ma_format_s16, ma_format_f32, 2) != MA_SUCCESS) { hasError = MA_TRUE; }
+    if (test_data_converter__in_place_by_format(ma_format_u8,  ma_format_s24, 6) != MA_SUCCESS) { hasError = MA_TRUE; }
+    if (test_data_converter__in_place_by_format(ma_format_s32, ma_format_f32, 8) != MA_SUCCESS) { hasError = MA_TRUE; }
+
+    if (hasError) {
+        return MA_ERROR;
+    } else {
+        return MA_SUCCESS;
+    }
+}
+
+ma_result test_data_converter__fused_by_config(ma_uint32 channelsIn, ma_uint32 channelsOut, ma_uint32 rateIn, ma_uint32 rateOut, ma_uint32 lpfOrder)
+{
+    ma_result result;
+    ma_data_converter_config config;
+    ma_data_converter converterFused;
+    ma_data_converter converterSeparate;
+    static float inputF32[MA_SCRATCH_TEST_FRAME_COUNT * 2];
+    static ma_int16 input[MA_SCRATCH_TEST_FRAME_COUNT * 2];
+    static float outputFused[MA_SCRATCH_TEST_FRAME_COUNT * 4 * 2];
+    static float outputSeparate[MA_SCRATCH_TEST_FRAME_COUNT * 4 * 2];
+    ma_uint64 framesProcessedIn = 0;
+    ma_uint64 framesProcessedOut = 0;
+    ma_uint32 iteration = 0;
+
+    printf("    %d -> %d, %d -> %d, lpf order %d... ", (int)channelsIn, (int)channelsOut, (int)rateIn, (int)rateOut, (int)lpfOrder);
+
+    for (iteration = 0; iteration < MA_SCRATCH_TEST_FRAME_COUNT * channelsIn; iteration += 1) {
+        inputF32[iteration] = (float)ma_sind((double)iteration * 0.0123) * 0.9f;
+    }
+    ma_pcm_f32_to_s16(input, inputF32, MA_SCRATCH_TEST_FRAME_COUNT * channelsIn, ma_dither_mode_none);
+
+    config = ma_data_converter_config_init(ma_format_s16, ma_format_f32, channelsIn, channelsOut, rateIn, rateOut);
+    config.resampling.linear.lpfOrder = lpfOrder;
+
+    result = ma_data_converter_init(&config, NULL, &converterFused);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_data_converter_init)\n");
+        return result;
+    }
+
+    if (converterFused.executionPath != ma_data_converter_execution_path_s16_to_f32_fused) {
+        ma_data_converter_uninit(&converterFused, NULL);
+        printf("FAILED (fused path not selected)\n");
+        return MA_ERROR;
+    }
+
+    result = ma_data_converter_init(&config, NULL, &converterSeparate);
+    if (result != MA_SUCCESS) {
+        ma_data_converter_uninit(&converterFused, NULL);
+        printf("FAILED (ma_data_converter_init)\n");
+        return result;
+    }
+
+    /* Force the separate passes so there's something to compare against. */
+    if (channelsIn < channelsOut) {
+        converterSeparate.executionPath = ma_data_converter_execution_path_resample_first;
+    } else {
+        converterSeparate.executionPath = ma_data_converter_execution_path_resample_only;
+    }
+
+    /* Uneven chunks, with a stretch of NULL input at the end to check silence is handled the same way. */
+    iteration = 0;
+    for (;;) {
+        ma_uint64 frameCountInFused;
+        ma_uint64 frameCountInSeparate;
+        ma_uint64 frameCountOutFused;
+        ma_uint64 frameCountOutSeparate;
+        const void* pRunningInput = NULL;
+
+        if (framesProcessedIn < MA_SCRATCH_TEST_FRAME_COUNT) {
+            pRunningInput = input + (framesProcessedIn * channelsIn);
+            frameCountInFused = ma_min(MA_SCRATCH_TEST_FRAME_COUNT - framesProcessedIn, 1 + (iteration * 37) % 700);
+        } else {
+            frameCountInFused = 100;
+        }
+
+        frameCountOutFused = ma_min(MA_SCRATCH_TEST_FRAME_COUNT * 4 - framesProcessedOut, 1 + (iteration * 53) % 650);
+        if (frameCountOutFused == 0) {
+            break;
+        }
+
+        frameCountInSeparate  = frameCountInFused;
+        frameCountOutSeparate = frameCountOutFused;
+
+        ma_data_converter_process_pcm_frames(&converterFused,    pRunningInput, &frameCountInFused,    outputFused    + (framesProcessedOut * channelsOut), &frameCountOutFused);
+        ma_data_converter_process_pcm_frames(&converterSeparate, pRunningInput, &frameCountInSeparate, outputSeparate + (framesProcessedOut * channelsOut), &frameCountOutSeparate);
+
+        if (frameCountInFused != frameCountInSeparate || frameCountOutFused != frameCountOutSeparate) {
+            printf("FAILED (frame counts differ: in %d/%d, out %d/%d)\n", (int)frameCountInFused, (int)frameCountInSeparate, (int)frameCountOutFused, (int)frameCountOutSeparate);
+            result = MA_ERROR;
+            break;
+        }
+
+        framesProcessedIn  += frameCountInFused;
+        framesProcessedOut += frameCountOutFused;
+        iteration += 1;
+
+        if (framesProcessedIn > MA_SCRATCH_TEST_FRAME_COUNT + 2000) {
+            break;
+        }
+    }
+
+    if (result == MA_SUCCESS && memcmp(outputFused, outputSeparate, (size_t)(framesProcessedOut * channelsOut * sizeof(float))) != 0) {
+        printf("FAILED (output differs)\n");
+        result = MA_ERROR;
+    }
+
+    ma_data_converter_uninit(&converterFused,    NULL);
+    ma_data_converter_uninit(&converterSeparate, NULL);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+ma_result test_data_converter__fused()
+{
+    ma_bool32 hasError = MA_FALSE;
+    ma_uint32 channels[][2] = {{1, 1}, {2, 2}, {1, 2}};
+    ma_uint32 rates[][2] = {{44100, 48000}, {48000, 44100}, {22050, 48000}, {44100, 47999}};
+    ma_uint32 lpfOrders[] = {0, 1, 4};
+    ma_uint32 iChannels;
+    ma_uint32 iRate;
+    ma_uint32 iLPFOrder;
+
+    printf("Fused s16 to f32\n");
+
+    for (iChannels = 0; iChannels < ma_countof(channels); iChannels += 1) {
+        for (iRate = 0; iRate < ma_countof(rates); iRate += 1) {
+            for (iLPFOrder = 0; iLPFOrder < ma_countof(lpfOrders); iLPFOrder += 1) {
+                if (test_data_converter__fused_by_config(channels[iChannels][0], channels[iChannels][1], rates[iRate][0], rates[iRate][1], lpfOrders[iLPFOrder]) != MA_SUCCESS) {
+                    hasError = MA_TRUE;
+                }
+            }
+        }
+    }
+
     if (hasError) {
         return MA_ERROR;
     } else {
@@ -324,8 +1219,194 @@ ma_result test_data_converter__resampling_required_input()
     }
 }
 
+#define MA_CHANNEL_CONVERTER_TEST_FRAME_COUNT   1001    /* Odd so the leftovers after the SIMD paths are tested. */
+
+static ma_int64 test_channel_converter__read_sample(ma_format format, const void* pFrames, ma_uint64 iSample)
+{
+    switch (format)
+    {
+        case ma_format_s16: return ((const ma_int16*)pFrames)[iSample];
+        case ma_format_s24: return ma_pcm_sample_s24_to_s32_no_scale((const ma_uint8*)pFrames + iSample*3);
+        case ma_format_s32: return ((const ma_int32*)pFrames)[iSample];
+        default: return 0;
+    }
+}
+
+static void test_channel_converter__write_sample(ma_format format, void* pFrames, ma_uint64 iSample, ma_int64 value)
+{
+    switch (format)
+    {
+        case ma_format_s16: ((ma_int16*)pFrames)[iSample] = (ma_int16)value; break;
+        case ma_format_s24: ma_pcm_sample_s32_to_s24_no_scale(value, (ma_uint8*)pFrames + iSample*3); break;
+        case ma_format_s32: ((ma_int32*)pFrames)[iSample] = (ma_int32)value; break;
+        default: break;
+    }
+}
+
+/* A straightforward version of each conversion path that walks the whole weight table. */
+static void test_channel_converter__reference(const ma_channel_converter* pConverter, void* pFramesOut, const void* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint32 channelsIn  = pConverter->channelsIn;
+    ma_uint32 channelsOut = pConverter->channelsOut;
+    ma_format format = pConverter->format;
+    ma_uint64 iFrame;
+    ma_uint32 iChannelIn;
+    ma_uint32 iChannelOut;
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        for (iChannelOut = 0; iChannelOut < channelsOut; iChannelOut += 1) {
+            ma_uint64 iSampleOut = iFrame*channelsOut + iChannelOut;
+
+            if (format == ma_format_f32) {
+                const float* pIn = (const float*)pFramesIn + iFrame*channelsIn;
+                float t = 0;
+
+                if (pConverter->conversionPath == ma_channel_conversion_path_mono_in) {
+                    t = pIn[0];
+                } else if (pConverter->conversionPath == ma_channel_conversion_path_mono_out) {
+                    for (iChannelIn = 0; iChannelIn < channelsIn; iChannelIn += 1) {
+                        t += pIn[iChannelIn];
+                    }
+                    t = t / channelsIn;
+                } else if (pConverter->conversionPath == ma_channel_conversion_path_shuffle) {
+                    t = (pConverter->pShuffleTable[iChannelOut] < channelsIn) ? pIn[pConverter->pShuffleTable[iChannelOut]] : 0;
+                } else {
+                    for (iChannelIn = 0; iChannelIn < channelsIn; iChannelIn += 1) {
+                        t += pIn[iChannelIn] * pConverter->weights.f32[iChannelIn][iChannelOut];
+                    }
+                }
+
+                ((float*)pFramesOut)[iSampleOut] = t;
+            } else {
+                ma_int64 t = 0;
+
+                if (pConverter->conversionPath == ma_channel_conversion_path_mono_in) {
+                    t = test_channel_converter__read_sample(format, pFramesIn, iFrame);
+                } else if (pConverter->conversionPath == ma_channel_conversion_path_mono_out) {
+                    for (iChannelIn = 0; iChannelIn < channelsIn; iChannelIn += 1) {
+                        t += test_channel_converter__read_sample(format, pFramesIn, iFrame*channelsIn + iChannelIn);
+                    }
+                    t = t / (ma_int64)channelsIn;
+                } else if (pConverter->conversionPath == ma_channel_conversion_path_shuffle) {
+                    if (pConverter->pShuffleTable[iChannelOut] < channelsIn) {
+                        t = test_channel_converter__read_sample(format, pFramesIn, iFrame*channelsIn + pConverter->pShuffleTable[iChannelOut]);
+                    }
+                } else {
+                    ma_int64 minValue = (format == ma_format_s16) ? -32768 : ((format == ma_format_s24) ? -8388608 : -2147483647 - 1);
+                    ma_int64 maxValue = (format == ma_format_s16) ?  32767 : ((format == ma_format_s24) ?  8388607 :  2147483647);
+
+                    for (iChannelIn = 0; iChannelIn < channelsIn; iChannelIn += 1) {
+                        t += (test_channel_converter__read_sample(format, pFramesIn, iFrame*channelsIn + iChannelIn) * pConverter->weights.s16[iChannelIn][iChannelOut]) >> MA_CHANNEL_CONVERTER_FIXED_POINT_SHIFT;
+                        t  = ma_clamp(t, minValue, maxValue);
+                    }
+                }
+
+                test_channel_converter__write_sample(format, pFramesOut, iSampleOut, t);
+            }
+        }
+    }
+}
+
+ma_result test_data_converter__channel_converter_by_config(ma_format format, ma_uint32 channelsIn, const ma_channel* pChannelMapIn, ma_uint32 channelsOut, const ma_channel* pChannelMapOut, ma_channel_conversion_path expectedPath)
+{
+    ma_result result;
+    ma_channel_converter_config config;
+    ma_channel_converter converter;
+    static float inputF32[MA_CHANNEL_CONVERTER_TEST_FRAME_COUNT * MA_SCRATCH_TEST_MAX_CHANNELS];
+    static ma_int32 input[MA_CHANNEL_CONVERTER_TEST_FRAME_COUNT * MA_SCRATCH_TEST_MAX_CHANNELS];
+    static ma_int32 output[MA_CHANNEL_CONVERTER_TEST_FRAME_COUNT * MA_SCRATCH_TEST_MAX_CHANNELS];
+    static ma_int32 outputReference[MA_CHANNEL_CONVERTER_TEST_FRAME_COUNT * MA_SCRATCH_TEST_MAX_CHANNELS];
+    ma_uint32 bpf = ma_get_bytes_per_frame(format, channelsOut);
+    ma_uint32 iSample;
+    ma_uint64 frameOffset;
+    ma_uint64 frameCount;
+
+    printf("    %s, %d -> %d... ", ma_get_format_name(format), (int)channelsIn, (int)channelsOut);
+
+    /* Negative and positive values on every channel, and a few that will clip when mixed. */
+    for (iSample = 0; iSample < MA_CHANNEL_CONVERTER_TEST_FRAME_COUNT * channelsIn; iSample += 1) {
+        inputF32[iSample] = (float)ma_sind((double)iSample * 0.0173 + (iSample % channelsIn)) * ((iSample % 7 == 0) ? 1.0f : 0.7f);
+    }
+    ma_pcm_convert(input, format, inputF32, ma_format_f32, MA_CHANNEL_CONVERTER_TEST_FRAME_COUNT * channelsIn, ma_dither_mode_none);
+
+    config = ma_channel_converter_config_init(format, channelsIn, pChannelMapIn, channelsOut, pChannelMapOut, ma_channel_mix_mode_default);
+
+    result = ma_channel_converter_init(&config, NULL, &converter);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_channel_converter_init)\n");
+        return result;
+    }
+
+    if (converter.conversionPath != expectedPath) {
+        ma_channel_converter_uninit(&converter, NULL);
+        printf("FAILED (unexpected conversion path %d)\n", (int)converter.conversionPath);
+        return MA_ERROR;
+    }
+
+    /* Uneven chunks so the SIMD paths get a mix of full vectors and leftovers. */
+    MA_ZERO_MEMORY(output, sizeof(output));
+    for (frameOffset = 0; frameOffset < MA_CHANNEL_CONVERTER_TEST_FRAME_COUNT; frameOffset += frameCount) {
+        frameCount = ma_min(MA_CHANNEL_CONVERTER_TEST_FRAME_COUNT - frameOffset, 1 + (frameOffset * 7) % 61);
+        ma_channel_converter_process_pcm_frames(&converter, ma_offset_ptr(output, frameOffset * bpf), ma_offset_ptr(input, frameOffset * ma_get_bytes_per_frame(format, channelsIn)), frameCount);
+    }
+
+    MA_ZERO_MEMORY(outputReference, sizeof(outputReference));
+    test_channel_converter__reference(&converter, outputReference, input, MA_CHANNEL_CONVERTER_TEST_FRAME_COUNT);
+
+    ma_channel_converter_uninit(&converter, NULL);
+
+    if (memcmp(output, outputReference, (size_t)MA_CHANNEL_CONVERTER_TEST_FRAME_COUNT * bpf) != 0) {
+        printf("FAILED (output differs)\n");
+        return MA_ERROR;
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
 
+ma_result test_data_converter__channel_converter()
+{
+    ma_bool32 hasError = MA_FALSE;
+    ma_format formats[] = {ma_format_f32, ma_format_s16, ma_format_s24, ma_format_s32};
+    ma_channel mapFC[1]     = {MA_CHANNEL_FRONT_CENTER};
+    ma_channel mapSwap[2]   = {MA_CHANNEL_FRONT_RIGHT, MA_CHANNEL_FRONT_LEFT};
+    ma_channel mapQuad[4]   = {MA_CHANNEL_BACK_LEFT, MA_CHANNEL_FRONT_RIGHT, MA_CHANNEL_BACK_RIGHT, MA_CHANNEL_FRONT_LEFT};
+    ma_channel map71In[8]   = {MA_CHANNEL_FRONT_LEFT, MA_CHANNEL_FRONT_RIGHT, MA_CHANNEL_FRONT_CENTER, MA_CHANNEL_LFE, MA_CHANNEL_BACK_LEFT, MA_CHANNEL_BACK_RIGHT, MA_CHANNEL_SIDE_LEFT, MA_CHANNEL_SIDE_RIGHT};
+    ma_channel map71Out[8]  = {MA_CHANNEL_SIDE_RIGHT, MA_CHANNEL_SIDE_LEFT, MA_CHANNEL_BACK_RIGHT, MA_CHANNEL_BACK_LEFT, MA_CHANNEL_LFE, MA_CHANNEL_FRONT_CENTER, MA_CHANNEL_FRONT_RIGHT, MA_CHANNEL_FRONT_LEFT};
+    ma_uint32 iFormat;
+
+    printf("Channel conversion\n");
+
+    for (iFormat = 0; iFormat < ma_countof(formats); iFormat += 1) {
+        ma_format format = formats[iFormat];
+
+        /* Weights. */
+        if (test_data_converter__channel_converter_by_config(format, 8, NULL,  2, NULL, ma_channel_conversion_path_weights) != MA_SUCCESS) { hasError = MA_TRUE; }
+        if (test_data_converter__channel_converter_by_config(format, 6, NULL,  2, NULL, ma_channel_conversion_path_weights) != MA_SUCCESS) { hasError = MA_TRUE; }
+        if (test_data_converter__channel_converter_by_config(format, 1, mapFC, 6, NULL, ma_channel_conversion_path_weights) != MA_SUCCESS) { hasError = MA_TRUE; }
+        if (test_data_converter__channel_converter_by_config(format, 1, mapFC, 8, NULL, ma_channel_conversion_path_weights) != MA_SUCCESS) { hasError = MA_TRUE; }
+        if (test_data_converter__channel_converter_by_config(format, 2, NULL,  8, NULL, ma_channel_conversion_path_weights) != MA_SUCCESS) { hasError = MA_TRUE; }
+        if (test_data_converter__channel_converter_by_config(format, 6, NULL,  8, NULL, ma_channel_conversion_path_weights) != MA_SUCCESS) { hasError = MA_TRUE; }
+
+        /* Mono in and out. */
+        if (test_data_converter__channel_converter_by_config(format, 1, NULL,  2, NULL, ma_channel_conversion_path_mono_in ) != MA_SUCCESS) { hasError = MA_TRUE; }
+        if (test_data_converter__channel_converter_by_config(format, 1, NULL,  6, NULL, ma_channel_conversion_path_mono_in ) != MA_SUCCESS) { hasError = MA_TRUE; }
+        if (test_data_converter__channel_converter_by_config(format, 1, NULL,  8, NULL, ma_channel_conversion_path_mono_in ) != MA_SUCCESS) { hasError = MA_TRUE; }
+        if (test_data_converter__channel_converter_by_config(format, 2, NULL,  1, NULL, ma_channel_conversion_path_mono_out) != MA_SUCCESS) { hasError = MA_TRUE; }
+        if (test_data_converter__channel_converter_by_config(format, 6, NULL,  1, NULL, ma_channel_conversion_path_mono_out) != MA_SUCCESS) { hasError = MA_TRUE; }
+
+        /* Shuffles. */
+        if (test_data_converter__channel_converter_by_config(format, 2, NULL,   2, mapSwap,  ma_channel_conversion_path_shuffle) != MA_SUCCESS) { hasError = MA_TRUE; }
+        if (test_data_converter__channel_converter_by_config(format, 4, NULL,   4, mapQuad,  ma_channel_conversion_path_shuffle) != MA_SUCCESS) { hasError = MA_TRUE; }
+        if (test_data_converter__channel_converter_by_config(format, 8, map71In, 8, map71Out, ma_channel_conversion_path_shuffle) != MA_SUCCESS) { hasError = MA_TRUE; }
+    }
 
+    if (hasError) {
+        return MA_ERROR;
+    } else {
+        return MA_SUCCESS;
+    }
+}
 
 ma_result test_data_converter__resampling()
 {
@@ -342,6 +1423,21 @@ ma_result test_data_converter__resampling()
         hasError = MA_TRUE;
     }
 
+    result = test_data_converter__resampling_polyphase_accuracy();
+    if (result != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    result = test_data_converter__resampling_linear_batched();
+    if (result != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    result = test_data_converter__resampling_linear_fixed_ratio();
+    if (result != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
     if (hasError) {
         return MA_ERROR;
     } else {
@@ -370,6 +1466,21 @@ int test_entry__data_converter(int argc, char** argv)
         hasError = MA_TRUE;
     }
 
+    result = test_data_converter__scratch_buffer();
+    if (result != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    result = test_data_converter__fused();
+    if (result != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    result = test_data_converter__channel_converter();
+    if (result != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
 
     if (hasError) {
         return -1;
@@ -0,0 +1,1790 @@
+#define MA_ENGINE_TEST_SOUND_FRAME_COUNT    1000
+
+static ma_result test_engine__inlined_sound_pool(ma_inlined_sound_steal_policy stealPolicy)
+{
+    ma_result result = MA_SUCCESS;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    ma_inlined_sound_pool_stats stats;
+    float soundData[MA_ENGINE_TEST_SOUND_FRAME_COUNT];
+    float output[480 * 2];
+    ma_uint32 iFrame;
+    ma_uint32 iRead;
+    ma_uint32 stolenSlot;
+    const char* pPolicyName = "none";
+
+    if (stealPolicy == ma_inlined_sound_steal_policy_oldest) {
+        pPolicyName = "oldest";
+    } else if (stealPolicy == ma_inlined_sound_steal_policy_quietest) {
+        pPolicyName = "quietest";
+    }
+
+    printf("    steal policy %s... ", pPolicyName);
+
+    for (iFrame = 0; iFrame < MA_ENGINE_TEST_SOUND_FRAME_COUNT; iFrame += 1) {
+        soundData[iFrame] = 0.5f;
+    }
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice                 = MA_TRUE;
+    engineConfig.channels                 = 2;
+    engineConfig.sampleRate               = 48000;
+    engineConfig.periodSizeInFrames       = 480;
+    engineConfig.inlinedSoundPoolCapacity = 2;
+    engineConfig.inlinedSoundStealPolicy  = stealPolicy;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    ma_resource_manager_register_decoded_data(ma_engine_get_resource_manager(&engine), "a", soundData, MA_ENGINE_TEST_SOUND_FRAME_COUNT, ma_format_f32, 1, 48000);
+    ma_resource_manager_register_decoded_data(ma_engine_get_resource_manager(&engine), "b", soundData, MA_ENGINE_TEST_SOUND_FRAME_COUNT, ma_format_f32, 1, 48000);
+
+    /* Fill the pool. The third sound needs to either steal a slot or be rejected. */
+    ma_engine_play_sound_with_volume(&engine, "a", NULL, 0, 1);
+    ma_engine_play_sound_with_volume(&engine, "a", NULL, 0, 0.25f);
+
+    result = ma_engine_play_sound_with_volume(&engine, "b", NULL, 0, 1);
+    ma_engine_get_inlined_sound_pool_stats(&engine, &stats);
+
+    if (stealPolicy == ma_inlined_sound_steal_policy_none) {
+        if (result != MA_NO_SPACE || stats.rejectCount != 1 || stats.stealCount != 0 || stats.playCount != 2) {
+            printf("FAILED (sound was not rejected)\n");
+            result = MA_ERROR;
+        } else {
+            result = MA_SUCCESS;
+        }
+    } else {
+        /* The oldest sound is in the first slot and the quietest is in the second. */
+        stolenSlot = (stealPolicy == ma_inlined_sound_steal_policy_oldest) ? 0 : 1;
+
+        if (result != MA_SUCCESS || stats.stealCount != 1 || stats.rejectCount != 0 || stats.playCount != 3 || ma_atomic_load_32(&engine.pInlinedSoundPool[stolenSlot].poolNameHash) != ma_hash_string_32("b")) {
+            printf("FAILED (incorrect sound stolen)\n");
+            result = MA_ERROR;
+        }
+    }
+
+    if (result == MA_SUCCESS && (stats.activeCount != 2 || stats.peakActiveCount != 2)) {
+        printf("FAILED (incorrect active count)\n");
+        result = MA_ERROR;
+    }
+
+    /* Let everything finish. Slots should be given back to the pool as each sound reaches the end. */
+    if (result == MA_SUCCESS) {
+        for (iRead = 0; iRead < 10; iRead += 1) {
+            ma_engine_read_pcm_frames(&engine, output, 480, NULL);
+        }
+
+        ma_engine_get_inlined_sound_pool_stats(&engine, &stats);
+        if (stats.activeCount != 0) {
+            printf("FAILED (slots were not released)\n");
+            result = MA_ERROR;
+        }
+    }
+
+    /* Playing the same sound again should restart a finished slot rather than reinitialize it. */
+    if (result == MA_SUCCESS) {
+        ma_uint64 reuseCount = stats.reuseCount;
+
+        result = ma_engine_play_sound(&engine, "a", NULL);
+        ma_engine_get_inlined_sound_pool_stats(&engine, &stats);
+
+        if (result != MA_SUCCESS || stats.reuseCount != reuseCount + 1 || stats.activeCount != 1) {
+            printf("FAILED (finished slot was not reused)\n");
+            result = MA_ERROR;
+        }
+    }
+
+    if (result == MA_SUCCESS) {
+        ma_engine_read_pcm_frames(&engine, output, 480, NULL);
+        if (output[0] != 0.5f || output[1] != 0.5f) {
+            printf("FAILED (reused sound did not play from the start)\n");
+            result = MA_ERROR;
+        }
+    }
+
+    ma_engine_uninit(&engine);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+static ma_result test_engine__inlined_sound_pool_hash_collision(void)
+{
+    ma_result result = MA_SUCCESS;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    ma_inlined_sound_pool_stats stats;
+    float soundDataA[MA_ENGINE_TEST_SOUND_FRAME_COUNT];
+    float soundDataB[MA_ENGINE_TEST_SOUND_FRAME_COUNT];
+    float output[480 * 2];
+    ma_uint32 iFrame;
+    ma_uint32 iRead;
+
+    printf("    hash collision... ");
+
+    for (iFrame = 0; iFrame < MA_ENGINE_TEST_SOUND_FRAME_COUNT; iFrame += 1) {
+        soundDataA[iFrame] = 0.5f;
+        soundDataB[iFrame] = 0.25f;
+    }
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice                 = MA_TRUE;
+    engineConfig.channels                 = 2;
+    engineConfig.sampleRate               = 48000;
+    engineConfig.periodSizeInFrames       = 480;
+    engineConfig.inlinedSoundPoolCapacity = 1;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    ma_resource_manager_register_decoded_data(ma_engine_get_resource_manager(&engine), "a", soundDataA, MA_ENGINE_TEST_SOUND_FRAME_COUNT, ma_format_f32, 1, 48000);
+    ma_resource_manager_register_decoded_data(ma_engine_get_resource_manager(&engine), "b", soundDataB, MA_ENGINE_TEST_SOUND_FRAME_COUNT, ma_format_f32, 1, 48000);
+
+    ma_engine_play_sound(&engine, "a", NULL);
+    for (iRead = 0; iRead < 10; iRead += 1) {
+        ma_engine_read_pcm_frames(&engine, output, 480, NULL);
+    }
+
+    /* Pretend "a" and "b" have the same hash. The finished slot must not be restarted with the wrong sound. */
+    ma_atomic_exchange_32(&engine.pInlinedSoundPool[0].poolNameHash, ma_hash_string_32("b"));
+
+    result = ma_engine_play_sound(&engine, "b", NULL);
+    ma_engine_get_inlined_sound_pool_stats(&engine, &stats);
+
+    if (result != MA_SUCCESS || stats.reuseCount != 0) {
+        printf("FAILED (slot was reused for a different file)\n");
+        result = MA_ERROR;
+    }
+
+    if (result == MA_SUCCESS) {
+        ma_engine_read_pcm_frames(&engine, output, 480, NULL);
+        if (output[0] != 0.25f || output[1] != 0.25f) {
+            printf("FAILED (wrong sound played)\n");
+            result = MA_ERROR;
+        }
+    }
+
+    ma_engine_uninit(&engine);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+#define MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT   48000
+#define MA_ENGINE_TEST_BLOCK_SIZE                   480
+
+static float g_engineTestVirtualizationData[MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT];
+
+static ma_bool32 test_engine__virtualization_check_output(const float* pOutput, ma_uint32 blockIndex)
+{
+    ma_uint32 iFrame;
+
+    for (iFrame = 0; iFrame < MA_ENGINE_TEST_BLOCK_SIZE; iFrame += 1) {
+        if (pOutput[iFrame] != g_engineTestVirtualizationData[blockIndex*MA_ENGINE_TEST_BLOCK_SIZE + iFrame]) {
+            return MA_FALSE;
+        }
+    }
+
+    return MA_TRUE;
+}
+
+static ma_result test_engine__virtualization(void)
+{
+    ma_result result = MA_SUCCESS;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    ma_audio_buffer buffers[3];
+    ma_sound sounds[3];
+    float output[MA_ENGINE_TEST_BLOCK_SIZE];
+    ma_uint32 iFrame;
+    ma_uint32 iSound;
+
+    printf("    priority and audibility... ");
+
+    /* The data is a ramp so we can tell exactly where each sound's cursor is from the output. */
+    for (iFrame = 0; iFrame < MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT; iFrame += 1) {
+        g_engineTestVirtualizationData[iFrame] = (float)iFrame / 65536;
+    }
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice                = MA_TRUE;
+    engineConfig.channels                = 1;
+    engineConfig.sampleRate              = 48000;
+    engineConfig.periodSizeInFrames      = MA_ENGINE_TEST_BLOCK_SIZE;
+    engineConfig.maxRealSoundCount       = 1;
+    engineConfig.virtualizationThreshold = 0.01f;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    for (iSound = 0; iSound < 3; iSound += 1) {
+        ma_audio_buffer_config bufferConfig = ma_audio_buffer_config_init(ma_format_f32, 1, MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT, g_engineTestVirtualizationData, NULL);
+        ma_audio_buffer_init(&bufferConfig, &buffers[iSound]);
+        ma_sound_init_from_data_source(&engine, &buffers[iSound], MA_SOUND_FLAG_NO_SPATIALIZATION | MA_SOUND_FLAG_NO_PITCH, NULL, &sounds[iSound]);
+    }
+
+    /* The third sound has the highest priority, but is too quiet to be heard and should never become real. */
+    ma_sound_set_priority(&sounds[0], 200);
+    ma_sound_set_priority(&sounds[1], 100);
+    ma_sound_set_priority(&sounds[2], 255);
+    ma_sound_set_volume(&sounds[2], 0.001f);
+
+    for (iSound = 0; iSound < 3; iSound += 1) {
+        ma_sound_start(&sounds[iSound]);
+    }
+
+    /* Decisions lag by a block. The first block has nothing to go by so every audible sound is real. */
+    ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+    ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+    ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+
+    if (ma_sound_is_virtual(&sounds[0]) || !ma_sound_is_virtual(&sounds[1]) || !ma_sound_is_virtual(&sounds[2])) {
+        printf("FAILED (wrong sounds virtualized)\n");
+        result = MA_ERROR;
+    } else if (ma_engine_get_real_sound_count(&engine) != 1 || ma_engine_get_virtual_sound_count(&engine) != 2) {
+        printf("FAILED (incorrect counts)\n");
+        result = MA_ERROR;
+    } else if (!test_engine__virtualization_check_output(output, 2)) {
+        printf("FAILED (incorrect output while virtualized)\n");
+        result = MA_ERROR;
+    }
+
+    /*
+    Raising the priority of the second sound should swap it with the first, and it should pick up from where it would have been. The
+    two sounds are at the same position so the output should carry on smoothly while one fades out and the other fades in.
+    */
+    if (result == MA_SUCCESS) {
+        float prevSample = output[MA_ENGINE_TEST_BLOCK_SIZE - 1];
+        ma_uint32 iBlock;
+
+        ma_sound_set_priority(&sounds[1], 255);
+
+        for (iBlock = 3; iBlock < 7 && result == MA_SUCCESS; iBlock += 1) {
+            ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+
+            for (iFrame = 0; iFrame < MA_ENGINE_TEST_BLOCK_SIZE; iFrame += 1) {
+                if (!(ma_abs(output[iFrame] - prevSample) < 0.001f)) {
+                    printf("FAILED (discontinuity while swapping real and virtual sounds)\n");
+                    result = MA_ERROR;
+                    break;
+                }
+
+                prevSample = output[iFrame];
+            }
+        }
+
+        if (result == MA_SUCCESS) {
+            if (!ma_sound_is_virtual(&sounds[0]) || ma_sound_is_virtual(&sounds[1])) {
+                printf("FAILED (priority change was not applied)\n");
+                result = MA_ERROR;
+            } else if (!test_engine__virtualization_check_output(output, 6) || ma_sound_get_time_in_pcm_frames(&sounds[0]) != ma_sound_get_time_in_pcm_frames(&sounds[1])) {
+                printf("FAILED (virtual sound did not advance)\n");
+                result = MA_ERROR;
+            }
+        }
+    }
+
+    for (iSound = 0; iSound < 3; iSound += 1) {
+        ma_sound_uninit(&sounds[iSound]);
+        ma_audio_buffer_uninit(&buffers[iSound]);
+    }
+
+    ma_engine_uninit(&engine);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+static ma_result test_engine__virtualization_channels_out(void)
+{
+    ma_result result = MA_SUCCESS;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    ma_audio_buffer buffer;
+    ma_audio_buffer_config bufferConfig;
+    ma_sound sound;
+    ma_sound_config soundConfig;
+    float output[MA_ENGINE_TEST_BLOCK_SIZE * 4];
+    float* ppFramesOut[1];
+    ma_uint32 frameCountIn = 0;
+    ma_uint32 frameCountOut = MA_ENGINE_TEST_BLOCK_SIZE;
+    ma_uint32 iSample;
+
+    printf("    output channels different to the engine... ");
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice                = MA_TRUE;
+    engineConfig.channels                = 2;
+    engineConfig.sampleRate              = 48000;
+    engineConfig.periodSizeInFrames      = MA_ENGINE_TEST_BLOCK_SIZE;
+    engineConfig.virtualizationThreshold = 0.01f;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    bufferConfig = ma_audio_buffer_config_init(ma_format_f32, 1, MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT, g_engineTestVirtualizationData, NULL);
+    ma_audio_buffer_init(&bufferConfig, &buffer);
+
+    /* The sound can't be attached to the endpoint because the channel counts differ, so it's processed directly. */
+    soundConfig = ma_sound_config_init_2(&engine);
+    soundConfig.pDataSource = &buffer;
+    soundConfig.channelsOut = 4;
+    soundConfig.flags       = MA_SOUND_FLAG_NO_SPATIALIZATION | MA_SOUND_FLAG_NO_PITCH | MA_SOUND_FLAG_NO_DEFAULT_ATTACHMENT;
+
+    result = ma_sound_init_ex(&engine, &soundConfig, &sound);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_sound_init_ex)\n");
+        ma_audio_buffer_uninit(&buffer);
+        ma_engine_uninit(&engine);
+        return result;
+    }
+
+    /* A silent sound is inaudible and therefore virtual. The whole output buffer needs to be silenced. Reading from the engine starts a new virtualization epoch. */
+    ma_sound_set_volume(&sound, 0);
+    ma_sound_start(&sound);
+    ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+
+    for (iSample = 0; iSample < ma_countof(output); iSample += 1) {
+        output[iSample] = 1;
+    }
+
+    ppFramesOut[0] = output;
+    sound.engineNode.baseNode.vtable->onProcess(&sound, NULL, &frameCountIn, ppFramesOut, &frameCountOut);
+
+    if (!ma_sound_is_virtual(&sound) || frameCountOut != MA_ENGINE_TEST_BLOCK_SIZE) {
+        printf("FAILED (sound was not virtualized)\n");
+        result = MA_ERROR;
+    } else {
+        for (iSample = 0; iSample < frameCountOut * 4; iSample += 1) {
+            if (output[iSample] != 0) {
+                printf("FAILED (sample %d was not silenced)\n", (int)iSample);
+                result = MA_ERROR;
+                break;
+            }
+        }
+    }
+
+    ma_sound_uninit(&sound);
+    ma_audio_buffer_uninit(&buffer);
+    ma_engine_uninit(&engine);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+static ma_result test_engine__volume_and_pan(ma_uint32 channelsIn, ma_pan_mode panMode, float pan)
+{
+    ma_result result = MA_SUCCESS;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    ma_audio_buffer buffer;
+    ma_audio_buffer_config bufferConfig;
+    ma_sound sound;
+    float input[MA_ENGINE_TEST_BLOCK_SIZE * 2];
+    float output[MA_ENGINE_TEST_BLOCK_SIZE * 2];
+    float volume = 0.75f;
+    ma_uint32 iFrame;
+    ma_lcg lcg;
+
+    printf("    %d channel%s, %s, pan %f... ", (int)channelsIn, (channelsIn == 1) ? "" : "s", (panMode == ma_pan_mode_balance) ? "balance" : "pan", pan);
+
+    ma_lcg_seed(&lcg, 4321);
+    for (iFrame = 0; iFrame < MA_ENGINE_TEST_BLOCK_SIZE * channelsIn; iFrame += 1) {
+        input[iFrame] = ma_lcg_rand_range_f32(&lcg, -1, 1);
+    }
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice           = MA_TRUE;
+    engineConfig.channels           = 2;
+    engineConfig.sampleRate         = 48000;
+    engineConfig.periodSizeInFrames = MA_ENGINE_TEST_BLOCK_SIZE;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    bufferConfig = ma_audio_buffer_config_init(ma_format_f32, channelsIn, MA_ENGINE_TEST_BLOCK_SIZE, input, NULL);
+    ma_audio_buffer_init(&bufferConfig, &buffer);
+    ma_sound_init_from_data_source(&engine, &buffer, MA_SOUND_FLAG_NO_SPATIALIZATION | MA_SOUND_FLAG_NO_PITCH, NULL, &sound);
+    ma_sound_set_volume(&sound, volume);
+    ma_sound_set_pan_mode(&sound, panMode);
+    ma_sound_set_pan(&sound, pan);
+    ma_sound_start(&sound);
+
+    ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+
+    /* Compare against the volume and panning math done one step at a time. */
+    for (iFrame = 0; iFrame < MA_ENGINE_TEST_BLOCK_SIZE; iFrame += 1) {
+        float l = input[iFrame*channelsIn + 0] * volume;
+        float r = input[iFrame*channelsIn + (channelsIn - 1)] * volume;
+        float expected[2];
+
+        if (panMode == ma_pan_mode_balance) {
+            expected[0] = (pan > 0) ? l * (1 - pan) : l;
+            expected[1] = (pan < 0) ? r * (1 + pan) : r;
+        } else {
+            if (pan > 0) {
+                expected[0] = l * (1 - pan);
+                expected[1] = l * pan + r;
+            } else {
+                expected[0] = l + r * -pan;
+                expected[1] = r * (1 + pan);
+            }
+        }
+
+        if (ma_abs(output[iFrame*2 + 0] - expected[0]) > 0.000001f || ma_abs(output[iFrame*2 + 1] - expected[1]) > 0.000001f) {
+            printf("FAILED (frame %d)\n", (int)iFrame);
+            result = MA_ERROR;
+            break;
+        }
+    }
+
+    ma_sound_uninit(&sound);
+    ma_audio_buffer_uninit(&buffer);
+    ma_engine_uninit(&engine);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+static ma_result test_engine__sample_rate_groups_render(ma_bool32 groupSoundsBySampleRate, const float* pInput, float* pOutput, ma_uint32 blockCount)
+{
+    ma_result result;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    ma_audio_buffer buffers[3];
+    ma_sound sounds[3];
+    ma_uint32 sampleRates[3] = {44100, 44100, 48000};
+    ma_uint32 iSound;
+    ma_uint32 iBlock;
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice                = MA_TRUE;
+    engineConfig.channels                = 1;
+    engineConfig.sampleRate              = 48000;
+    engineConfig.periodSizeInFrames      = MA_ENGINE_TEST_BLOCK_SIZE;
+    engineConfig.groupSoundsBySampleRate = groupSoundsBySampleRate;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    for (iSound = 0; iSound < 3; iSound += 1) {
+        ma_audio_buffer_config bufferConfig = ma_audio_buffer_config_init(ma_format_f32, 1, MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT, pInput + iSound, NULL);
+        bufferConfig.sizeInFrames -= 2;
+        bufferConfig.sampleRate    = sampleRates[iSound];
+        ma_audio_buffer_init(&bufferConfig, &buffers[iSound]);
+        ma_sound_init_from_data_source(&engine, &buffers[iSound], MA_SOUND_FLAG_NO_SPATIALIZATION | MA_SOUND_FLAG_NO_PITCH, NULL, &sounds[iSound]);
+        ma_sound_start(&sounds[iSound]);
+    }
+
+    if (groupSoundsBySampleRate) {
+        ma_sound_group* pGroup = ma_engine_get_sample_rate_group(&engine, 44100);
+
+        /* The two 44100 sounds should share a group. The 48000 one should go straight to the endpoint. */
+        if (pGroup == NULL || ma_engine_get_sample_rate_group(&engine, 48000) != NULL) {
+            printf("FAILED (incorrect groups)\n");
+            result = MA_ERROR;
+        } else if (sounds[0].engineNode.baseNode.pOutputBuses[0].pInputNode != pGroup || sounds[1].engineNode.baseNode.pOutputBuses[0].pInputNode != pGroup || sounds[2].engineNode.baseNode.pOutputBuses[0].pInputNode != ma_engine_get_endpoint(&engine)) {
+            printf("FAILED (incorrect attachments)\n");
+            result = MA_ERROR;
+        } else if (ma_engine_node_is_pitching_enabled(&sounds[0].engineNode)) {
+            printf("FAILED (sounds in a group at their own rate should not need resampling)\n");
+            result = MA_ERROR;
+        }
+    }
+
+    for (iBlock = 0; iBlock < blockCount; iBlock += 1) {
+        ma_engine_read_pcm_frames(&engine, pOutput + iBlock*MA_ENGINE_TEST_BLOCK_SIZE, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+    }
+
+    for (iSound = 0; iSound < 3; iSound += 1) {
+        ma_sound_uninit(&sounds[iSound]);
+        ma_audio_buffer_uninit(&buffers[iSound]);
+    }
+
+    ma_engine_uninit(&engine);
+
+    return result;
+}
+
+static ma_result test_engine__sample_rate_groups(void)
+{
+    ma_result result;
+    static float input[MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT];
+    static float outputGrouped[MA_ENGINE_TEST_BLOCK_SIZE * 16];
+    static float outputSeparate[MA_ENGINE_TEST_BLOCK_SIZE * 16];
+    ma_uint32 iFrame;
+    ma_lcg lcg;
+
+    printf("    grouped vs separate... ");
+
+    ma_lcg_seed(&lcg, 1234);
+    for (iFrame = 0; iFrame < MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT; iFrame += 1) {
+        input[iFrame] = ma_lcg_rand_range_f32(&lcg, -0.3f, 0.3f);
+    }
+
+    result = test_engine__sample_rate_groups_render(MA_TRUE, input, outputGrouped, 16);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = test_engine__sample_rate_groups_render(MA_FALSE, input, outputSeparate, 16);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    /* Linear interpolation is linear, so resampling the mix should give the same result as mixing the resampled sounds. */
+    for (iFrame = 0; iFrame < MA_ENGINE_TEST_BLOCK_SIZE * 16; iFrame += 1) {
+        if (ma_abs(outputGrouped[iFrame] - outputSeparate[iFrame]) > 0.00001f) {
+            printf("FAILED (frame %d: %f != %f)\n", (int)iFrame, outputGrouped[iFrame], outputSeparate[iFrame]);
+            return MA_ERROR;
+        }
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+static ma_result test_engine__sample_rate_groups_nested(void)
+{
+    ma_result result;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    ma_sound_group_config groupConfig;
+    ma_sound_group parentGroup;
+    ma_sound_group childGroup;
+    ma_lpf_node_config lpfNodeConfig;
+    ma_lpf_node lpfNode;
+    ma_audio_buffer_config bufferConfig;
+    ma_audio_buffer buffer;
+    ma_sound_config soundConfig;
+    ma_sound sound;
+    ma_uint32 sampleRate;
+    static float input[4800];
+    static float output[MA_ENGINE_TEST_BLOCK_SIZE * 10];
+    ma_uint32 iFrame;
+    ma_uint32 iBlock;
+    ma_uint32 crossingCount;
+
+    printf("    nested... ");
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice           = MA_TRUE;
+    engineConfig.channels           = 1;
+    engineConfig.sampleRate         = 48000;
+    engineConfig.periodSizeInFrames = MA_ENGINE_TEST_BLOCK_SIZE;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    groupConfig = ma_sound_group_config_init_2(&engine);
+    groupConfig.sampleRate = 24000;
+    ma_sound_group_init_ex(&engine, &groupConfig, &parentGroup);
+
+    /* A group without a rate of its own should run at the rate of the group it's attached to. */
+    groupConfig = ma_sound_group_config_init_2(&engine);
+    groupConfig.pInitialAttachment = &parentGroup;
+    ma_sound_group_init_ex(&engine, &groupConfig, &childGroup);
+
+    ma_sound_get_data_format(&childGroup, NULL, NULL, &sampleRate, NULL, 0);
+    if (ma_sound_group_get_sample_rate(&childGroup) != 24000 || sampleRate != 24000) {
+        printf("FAILED (nested group not running at the parent's rate)\n");
+        result = MA_ERROR;
+        goto done_groups;
+    }
+
+    /* A sound that goes through an effect on the way into the group needs to output at the group's rate. */
+    lpfNodeConfig = ma_lpf_node_config_init(1, ma_sound_group_get_sample_rate(&parentGroup), 8000, 2);
+    ma_lpf_node_init(ma_engine_get_node_graph(&engine), &lpfNodeConfig, NULL, &lpfNode);
+    ma_node_attach_output_bus(&lpfNode, 0, &parentGroup, 0);
+
+    for (iFrame = 0; iFrame < ma_countof(input); iFrame += 1) {
+        input[iFrame] = 0.5f * (float)ma_sind(MA_TAU_D * iFrame / 48);   /* 1kHz. */
+    }
+
+    bufferConfig = ma_audio_buffer_config_init(ma_format_f32, 1, ma_countof(input), input, NULL);
+    bufferConfig.sampleRate = 48000;
+    ma_audio_buffer_init(&bufferConfig, &buffer);
+
+    soundConfig = ma_sound_config_init_2(&engine);
+    soundConfig.pDataSource        = &buffer;
+    soundConfig.pInitialAttachment = &lpfNode;
+    soundConfig.flags              = MA_SOUND_FLAG_NO_SPATIALIZATION;
+    ma_sound_init_ex(&engine, &soundConfig, &sound);
+    ma_sound_set_looping(&sound, MA_TRUE);
+    ma_sound_start(&sound);
+
+    if (sound.engineNode.sampleRateOut != 24000) {
+        printf("FAILED (sound not outputting at the group's rate)\n");
+        result = MA_ERROR;
+        goto done_sound;
+    }
+
+    for (iBlock = 0; iBlock < 10; iBlock += 1) {
+        ma_engine_read_pcm_frames(&engine, output + iBlock*MA_ENGINE_TEST_BLOCK_SIZE, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+    }
+
+    /* The tone should come out at the same pitch it went in at. 2400 frames is 50ms which is 100 zero crossings at 1kHz. */
+    crossingCount = 0;
+    for (iFrame = ma_countof(output) - 2400; iFrame < ma_countof(output); iFrame += 1) {
+        if ((output[iFrame - 1] < 0) != (output[iFrame] < 0)) {
+            crossingCount += 1;
+        }
+    }
+
+    if (crossingCount < 98 || crossingCount > 102) {
+        printf("FAILED (%d zero crossings)\n", (int)crossingCount);
+        result = MA_ERROR;
+        goto done_sound;
+    }
+
+    printf("PASSED\n");
+
+done_sound:
+    ma_sound_uninit(&sound);
+    ma_audio_buffer_uninit(&buffer);
+    ma_lpf_node_uninit(&lpfNode, NULL);
+done_groups:
+    ma_sound_group_uninit(&childGroup);
+    ma_sound_group_uninit(&parentGroup);
+    ma_engine_uninit(&engine);
+
+    return result;
+}
+
+static ma_result test_engine__ambisonic_decoder(ma_uint32 order)
+{
+    ma_result result;
+    ma_ambisonic_decoder_config decoderConfig;
+    ma_ambisonic_decoder decoder;
+    ma_channel channelMap[4] = {MA_CHANNEL_FRONT_LEFT, MA_CHANNEL_FRONT_RIGHT, MA_CHANNEL_LFE, MA_CHANNEL_BACK_LEFT};
+    ma_vec3f directions[3];
+    float weights[MA_AMBISONIC_MAX_ORDER + 1];
+    float normalization = 0;
+    float rE;
+    ma_uint32 iOrder;
+    ma_uint32 iDirection;
+    ma_uint32 iChannel;
+
+    printf("    order %d... ", (int)order);
+
+    decoderConfig = ma_ambisonic_decoder_config_init(order, 4, channelMap);
+
+    result = ma_ambisonic_decoder_init(&decoderConfig, NULL, &decoder);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_ambisonic_decoder_init)\n");
+        return result;
+    }
+
+    /* A source positioned exactly on a speaker should come out of that speaker at unity gain, and from the opposite side when mirrored. */
+    directions[0] = ma_vec3f_normalize(ma_get_channel_direction(MA_CHANNEL_FRONT_RIGHT));
+    directions[1] = ma_vec3f_normalize(ma_vec3f_init_3f( 1, 0, 0));
+    directions[2] = ma_vec3f_normalize(ma_vec3f_init_3f(-1, 2, 0.5f));
+
+    /*
+    With SN3D normalization the sum of the products of the encoding coefficients of two directions within an order is
+    the Legendre polynomial of the angle between them. This lets us check every coefficient of the encoder without
+    having to duplicate it.
+    */
+    rE = (float)ma_cosd((137.9 * MA_PI_D / 180.0) / (order + 1.51));
+    for (iOrder = 0; iOrder <= order; iOrder += 1) {
+        weights[iOrder] = (2*iOrder + 1) * ma_legendre_f32(iOrder, rE);
+        normalization += weights[iOrder];
+    }
+
+    for (iDirection = 0; iDirection < ma_countof(directions); iDirection += 1) {
+        float encoded[MA_AMBISONIC_MAX_CHANNELS];
+        float decoded[4];
+
+        ma_ambisonic_encode(order, directions[iDirection], encoded);
+        ma_ambisonic_decoder_process_pcm_frames(&decoder, decoded, encoded, 1);
+
+        for (iChannel = 0; iChannel < 4; iChannel += 1) {
+            float expected = 0;
+
+            if (ma_is_spatial_channel_position(channelMap[iChannel])) {
+                float cosAngle = ma_vec3f_dot(directions[iDirection], ma_vec3f_normalize(ma_get_channel_direction(channelMap[iChannel])));
+                for (iOrder = 0; iOrder <= order; iOrder += 1) {
+                    expected += weights[iOrder] * ma_legendre_f32(iOrder, cosAngle);
+                }
+                expected /= normalization;
+            }
+
+            if (ma_abs(decoded[iChannel] - expected) > 0.001f) {    /* Channel directions are only approximately normalized. */
+                printf("FAILED (direction %d, channel %d: %f != %f)\n", (int)iDirection, (int)iChannel, decoded[iChannel], expected);
+                ma_ambisonic_decoder_uninit(&decoder, NULL);
+                return MA_ERROR;
+            }
+        }
+
+        if (iDirection == 0 && ma_abs(decoded[1] - 1) > 0.001f) {
+            printf("FAILED (gain of a source on a speaker is %f)\n", decoded[1]);
+            ma_ambisonic_decoder_uninit(&decoder, NULL);
+            return MA_ERROR;
+        }
+
+        if (iDirection == 1 && decoded[1] <= decoded[0]) {
+            printf("FAILED (source on the right is louder on the left)\n");
+            ma_ambisonic_decoder_uninit(&decoder, NULL);
+            return MA_ERROR;
+        }
+    }
+
+    ma_ambisonic_decoder_uninit(&decoder, NULL);
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+static ma_result test_engine__ambisonic_bus(void)
+{
+    ma_result result;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    ma_audio_buffer buffer;
+    ma_audio_buffer_config bufferConfig;
+    ma_sound sound;
+    static float input[MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT];
+    float output[MA_ENGINE_TEST_BLOCK_SIZE * 2];
+    float side;
+    ma_uint32 iFrame;
+    ma_uint32 iBlock;
+
+    printf("    engine bus... ");
+
+    for (iFrame = 0; iFrame < MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT; iFrame += 1) {
+        input[iFrame] = 0.5f;
+    }
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice           = MA_TRUE;
+    engineConfig.channels           = 2;
+    engineConfig.sampleRate         = 48000;
+    engineConfig.periodSizeInFrames = MA_ENGINE_TEST_BLOCK_SIZE;
+    engineConfig.ambisonicOrder     = 1;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    bufferConfig = ma_audio_buffer_config_init(ma_format_f32, 1, MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT, input, NULL);
+    bufferConfig.sampleRate = 48000;
+    ma_audio_buffer_init(&bufferConfig, &buffer);
+
+    result = ma_sound_init_from_data_source(&engine, &buffer, MA_SOUND_FLAG_NO_PITCH, NULL, &sound);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_sound_init_from_data_source)\n");
+        goto done;
+    }
+
+    if (ma_node_get_output_channels(&sound, 0) != 4 || sound.engineNode.baseNode.pOutputBuses[0].pInputNode != ma_engine_get_ambisonic_bus(&engine)) {
+        printf("FAILED (sound is not encoded to the bus)\n");
+        result = MA_ERROR;
+        goto done_sound;
+    }
+
+    ma_sound_start(&sound);
+
+    /* Move the sound from one side to the other and make sure the louder channel follows it. Several blocks are rendered so the gains settle. */
+    for (side = -1; side <= 1; side += 2) {
+        ma_sound_set_position(&sound, side * 2, 0, 0);
+
+        for (iBlock = 0; iBlock < 4; iBlock += 1) {
+            ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+        }
+
+        if ((output[(MA_ENGINE_TEST_BLOCK_SIZE - 1)*2 + 1] - output[(MA_ENGINE_TEST_BLOCK_SIZE - 1)*2 + 0]) * side <= 0) {
+            printf("FAILED (side %d: left=%f, right=%f)\n", (int)side, output[(MA_ENGINE_TEST_BLOCK_SIZE - 1)*2 + 0], output[(MA_ENGINE_TEST_BLOCK_SIZE - 1)*2 + 1]);
+            result = MA_ERROR;
+            goto done_sound;
+        }
+    }
+
+    printf("PASSED\n");
+
+done_sound:
+    ma_sound_uninit(&sound);
+done:
+    ma_audio_buffer_uninit(&buffer);
+    ma_engine_uninit(&engine);
+
+    return result;
+}
+
+static ma_bool32 test_engine__spatializer_batch_compare(float a, float b)
+{
+    return ma_abs(a - b) <= 0.0001f * ma_max(1, ma_abs(b));
+}
+
+static ma_result test_engine__spatializer_batch(ma_bool32 hasListenerCone)
+{
+    ma_result result;
+    ma_spatializer_listener_config listenerConfig;
+    ma_spatializer_listener listener;
+    ma_spatializer_batch_config batchConfig;
+    ma_spatializer_batch batch;
+    static ma_spatializer spatializers[37];  /* Not a multiple of the SIMD width so the leftovers are tested. */
+    ma_uint32 iSource;
+    ma_lcg lcg;
+
+    printf("    batch vs individual%s... ", (hasListenerCone) ? " (listener cone)" : "");
+
+    listenerConfig = ma_spatializer_listener_config_init(2);
+    result = ma_spatializer_listener_init(&listenerConfig, NULL, &listener);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_spatializer_listener_init)\n");
+        return result;
+    }
+
+    ma_spatializer_listener_set_position(&listener, 1, 2, 3);
+    ma_spatializer_listener_set_direction(&listener, 0.3f, -0.2f, -1);
+    ma_spatializer_listener_set_velocity(&listener, 2, 0, -3);
+    if (hasListenerCone) {
+        ma_spatializer_listener_set_cone(&listener, 1.5f, 3.0f, 0.25f);
+    }
+
+    batchConfig = ma_spatializer_batch_config_init(ma_countof(spatializers));
+    result = ma_spatializer_batch_init(&batchConfig, NULL, &batch);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_spatializer_batch_init)\n");
+        ma_spatializer_listener_uninit(&listener, NULL);
+        return result;
+    }
+
+    ma_lcg_seed(&lcg, 4321);
+
+    for (iSource = 0; iSource < ma_countof(spatializers); iSource += 1) {
+        ma_spatializer_config spatializerConfig = ma_spatializer_config_init(1, 2);
+        ma_spatializer_init(&spatializerConfig, NULL, &spatializers[iSource]);
+
+        ma_spatializer_set_attenuation_model(&spatializers[iSource], (ma_attenuation_model)(iSource % 4));
+        ma_spatializer_set_positioning(&spatializers[iSource], ((iSource % 5) == 0) ? ma_positioning_relative : ma_positioning_absolute);
+        ma_spatializer_set_position(&spatializers[iSource], ma_lcg_rand_range_f32(&lcg, -20, 20), ma_lcg_rand_range_f32(&lcg, -20, 20), ma_lcg_rand_range_f32(&lcg, -20, 20));
+        ma_spatializer_set_direction(&spatializers[iSource], ma_lcg_rand_range_f32(&lcg, -1, 1), ma_lcg_rand_range_f32(&lcg, -1, 1), ma_lcg_rand_range_f32(&lcg, -1, 1));
+        ma_spatializer_set_velocity(&spatializers[iSource], ma_lcg_rand_range_f32(&lcg, -10, 10), ma_lcg_rand_range_f32(&lcg, -10, 10), ma_lcg_rand_range_f32(&lcg, -10, 10));
+        ma_spatializer_set_min_distance(&spatializers[iSource], ma_lcg_rand_range_f32(&lcg, 0.5f, 2));
+        ma_spatializer_set_max_distance(&spatializers[iSource], ma_lcg_rand_range_f32(&lcg, 5, 30));
+        ma_spatializer_set_rolloff(&spatializers[iSource], ma_lcg_rand_range_f32(&lcg, 0.5f, 2));
+        ma_spatializer_set_min_gain(&spatializers[iSource], 0.01f);
+        ma_spatializer_set_doppler_factor(&spatializers[iSource], ((iSource % 3) == 0) ? 0 : 1);
+        if ((iSource % 2) == 0) {
+            ma_spatializer_set_cone(&spatializers[iSource], 1.0f, 2.5f, 0.1f);
+        }
+
+        /* One source right on top of the listener. */
+        if (iSource == 7) {
+            ma_spatializer_set_position(&spatializers[iSource], 1, 2, 3);
+        }
+
+        ma_spatializer_batch_set_source(&batch, iSource, &spatializers[iSource], 0);
+    }
+
+    batch.count = ma_countof(spatializers);
+    ma_spatializer_batch_process(&batch, &listener, 0);
+
+    for (iSource = 0; iSource < ma_countof(spatializers); iSource += 1) {
+        ma_spatializer* pSpatializer = &spatializers[iSource];
+        ma_vec3f relativePos;
+        ma_vec3f relativeDir;
+        float expectedGain;
+        float expectedDistance;
+        float expectedDopplerPitch = 1;
+
+        ma_spatializer_get_relative_position_and_direction(pSpatializer, &listener, &relativePos, &relativeDir);
+        expectedGain     = ma_clamp(ma_spatializer_calculate_gain(pSpatializer, &listener, relativePos, relativeDir), ma_spatializer_get_min_gain(pSpatializer), ma_spatializer_get_max_gain(pSpatializer));
+        expectedDistance = ma_vec3f_len(relativePos);
+        if (expectedDistance <= 0.001f) {
+            expectedDistance = 0;
+        }
+
+        if (ma_spatializer_get_doppler_factor(pSpatializer) > 0) {
+            expectedDopplerPitch = ma_doppler_pitch(ma_vec3f_sub(ma_spatializer_listener_get_position(&listener), ma_spatializer_get_position(pSpatializer)), ma_spatializer_get_velocity(pSpatializer), ma_spatializer_listener_get_velocity(&listener), listener.config.speedOfSound, ma_spatializer_get_doppler_factor(pSpatializer));
+        }
+
+        if (!test_engine__spatializer_batch_compare(batch.pGain[iSource], expectedGain) ||
+            !test_engine__spatializer_batch_compare(batch.pDistance[iSource], expectedDistance) ||
+            !test_engine__spatializer_batch_compare(batch.pDopplerPitch[iSource], expectedDopplerPitch)) {
+            printf("FAILED (source %d: gain %f != %f, distance %f != %f, doppler %f != %f)\n", (int)iSource, batch.pGain[iSource], expectedGain, batch.pDistance[iSource], expectedDistance, batch.pDopplerPitch[iSource], expectedDopplerPitch);
+            result = MA_ERROR;
+            break;
+        }
+
+        if (expectedDistance > 0) {
+            if (!test_engine__spatializer_batch_compare(batch.pRelativeDirectionX[iSource], relativePos.x / expectedDistance) ||
+                !test_engine__spatializer_batch_compare(batch.pRelativeDirectionY[iSource], relativePos.y / expectedDistance) ||
+                !test_engine__spatializer_batch_compare(batch.pRelativeDirectionZ[iSource], relativePos.z / expectedDistance)) {
+                printf("FAILED (source %d: incorrect direction)\n", (int)iSource);
+                result = MA_ERROR;
+                break;
+            }
+        }
+    }
+
+    for (iSource = 0; iSource < ma_countof(spatializers); iSource += 1) {
+        ma_spatializer_uninit(&spatializers[iSource], NULL);
+    }
+
+    ma_spatializer_batch_uninit(&batch, NULL);
+    ma_spatializer_listener_uninit(&listener, NULL);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+static ma_result test_engine__spatializer_batch_render(ma_uint32 spatializerBatchCapacity, const float* pInput, float* pOutput, ma_uint32 blockCount)
+{
+    ma_result result;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    ma_audio_buffer buffers[6];
+    ma_sound sounds[6];
+    ma_bool32 isSoundInitialized[6];
+    ma_uint32 iSound;
+    ma_uint32 iBlock;
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice                 = MA_TRUE;
+    engineConfig.channels                 = 2;
+    engineConfig.sampleRate               = 48000;
+    engineConfig.periodSizeInFrames       = MA_ENGINE_TEST_BLOCK_SIZE;
+    engineConfig.spatializerBatchCapacity = spatializerBatchCapacity;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    for (iSound = 0; iSound < ma_countof(sounds); iSound += 1) {
+        ma_audio_buffer_config bufferConfig = ma_audio_buffer_config_init(ma_format_f32, 1, MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT - iSound, pInput + iSound, NULL);
+        bufferConfig.sampleRate = 48000;
+        ma_audio_buffer_init(&bufferConfig, &buffers[iSound]);
+        ma_sound_init_from_data_source(&engine, &buffers[iSound], 0, NULL, &sounds[iSound]);
+        ma_sound_set_position(&sounds[iSound], (float)iSound - 2.5f, 0, -(float)iSound);
+        ma_sound_set_velocity(&sounds[iSound], 0, 0, (float)iSound);
+        ma_sound_start(&sounds[iSound]);
+        isSoundInitialized[iSound] = MA_TRUE;
+    }
+
+    for (iBlock = 0; iBlock < blockCount; iBlock += 1) {
+        /* Move one sound and remove another part way through to make sure the batch keeps up. */
+        ma_sound_set_position(&sounds[0], (float)iBlock, 1, -2);
+        if (iBlock == blockCount/2) {
+            ma_sound_uninit(&sounds[1]);
+            isSoundInitialized[1] = MA_FALSE;
+
+            /* Removals are applied straight away when nothing is reading. */
+            if (spatializerBatchCapacity > 0 && engine.spatializerBatch.count != ma_min(spatializerBatchCapacity, ma_countof(sounds)) - 1) {
+                printf("FAILED (incorrect batch count after removal)\n");
+                result = MA_ERROR;
+            }
+        }
+
+        ma_engine_read_pcm_frames(&engine, pOutput + iBlock*MA_ENGINE_TEST_BLOCK_SIZE*2, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+
+        /* Sounds are added to the batch by the audio thread at the start of the first read. */
+        if (iBlock == 0 && spatializerBatchCapacity > 0 && engine.spatializerBatch.count != ma_min(spatializerBatchCapacity, ma_countof(sounds))) {
+            printf("FAILED (incorrect batch count)\n");
+            result = MA_ERROR;
+        }
+    }
+
+    for (iSound = 0; iSound < ma_countof(sounds); iSound += 1) {
+        if (isSoundInitialized[iSound]) {
+            ma_sound_uninit(&sounds[iSound]);
+        }
+        ma_audio_buffer_uninit(&buffers[iSound]);
+    }
+
+    ma_engine_uninit(&engine);
+
+    return result;
+}
+
+static ma_result test_engine__spatializer_batch_engine(ma_uint32 spatializerBatchCapacity)
+{
+    ma_result result;
+    static float input[MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT];
+    static float outputBatched[MA_ENGINE_TEST_BLOCK_SIZE * 2 * 16];
+    static float outputIndividual[MA_ENGINE_TEST_BLOCK_SIZE * 2 * 16];
+    ma_uint32 iSample;
+    ma_lcg lcg;
+
+    printf("    engine (capacity %d)... ", (int)spatializerBatchCapacity);
+
+    ma_lcg_seed(&lcg, 1234);
+    for (iSample = 0; iSample < MA_ENGINE_TEST_VIRTUALIZATION_FRAME_COUNT; iSample += 1) {
+        input[iSample] = ma_lcg_rand_range_f32(&lcg, -0.3f, 0.3f);
+    }
+
+    result = test_engine__spatializer_batch_render(spatializerBatchCapacity, input, outputBatched, 16);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = test_engine__spatializer_batch_render(0, input, outputIndividual, 16);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    for (iSample = 0; iSample < ma_countof(outputBatched); iSample += 1) {
+        if (ma_abs(outputBatched[iSample] - outputIndividual[iSample]) > 0.0001f) {
+            printf("FAILED (sample %d: %f != %f)\n", (int)iSample, outputBatched[iSample], outputIndividual[iSample]);
+            return MA_ERROR;
+        }
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+static ma_bool32 test_engine__vec3f_equal(ma_vec3f a, float x, float y, float z)
+{
+    return a.x == x && a.y == y && a.z == z;
+}
+
+#define MA_ENGINE_TEST_SPATIALIZER_BATCH_CHURN_COUNT    100
+
+typedef struct
+{
+    ma_engine* pEngine;
+    MA_ATOMIC(4, ma_bool32) isStopping;
+    MA_ATOMIC(4, ma_uint32) readCount;
+} ma_engine_test_reader;
+
+static ma_thread_result MA_THREADCALL test_engine__reader_thread(void* pUserData)
+{
+    ma_engine_test_reader* pReader = (ma_engine_test_reader*)pUserData;
+    static float output[MA_ENGINE_TEST_BLOCK_SIZE * 2];
+
+    while (ma_atomic_load_32(&pReader->isStopping) == MA_FALSE) {
+        ma_engine_read_pcm_frames(pReader->pEngine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+        ma_atomic_fetch_add_32(&pReader->readCount, 1);
+    }
+
+    return (ma_thread_result)0;
+}
+
+static ma_result test_engine__spatializer_batch_threaded(void)
+{
+    ma_result result;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    static float silence[MA_ENGINE_TEST_BLOCK_SIZE];
+    ma_audio_buffer buffers[3];
+    ma_sound sounds[3];
+    ma_engine_test_reader reader;
+    ma_thread thread;
+    ma_uint32 iSound;
+    ma_uint32 iChurn;
+
+    printf("    engine (initializing while reading)... ");
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice                 = MA_TRUE;
+    engineConfig.channels                 = 2;
+    engineConfig.sampleRate               = 48000;
+    engineConfig.spatializerBatchCapacity = 2;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    for (iSound = 0; iSound < ma_countof(sounds); iSound += 1) {
+        ma_audio_buffer_config bufferConfig = ma_audio_buffer_config_init(ma_format_f32, 1, ma_countof(silence), silence, NULL);
+        ma_audio_buffer_init(&bufferConfig, &buffers[iSound]);
+    }
+
+    /* This one stays in the batch the whole time and gets moved around as the others are removed in front of it. */
+    ma_sound_init_from_data_source(&engine, &buffers[0], 0, NULL, &sounds[0]);
+    ma_sound_set_looping(&sounds[0], MA_TRUE);
+    ma_sound_start(&sounds[0]);
+
+    reader.pEngine    = &engine;
+    reader.isStopping = MA_FALSE;
+    reader.readCount  = 0;
+
+    result = ma_thread_create(&thread, ma_thread_priority_default, 0, test_engine__reader_thread, &reader, NULL);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_thread_create)\n");
+        ma_sound_uninit(&sounds[0]);
+        ma_engine_uninit(&engine);
+        return result;
+    }
+
+    for (iChurn = 0; iChurn < MA_ENGINE_TEST_SPATIALIZER_BATCH_CHURN_COUNT; iChurn += 1) {
+        ma_uint32 readCount;
+
+        for (iSound = 1; iSound < ma_countof(sounds); iSound += 1) {
+            ma_sound_init_from_data_source(&engine, &buffers[iSound], 0, NULL, &sounds[iSound]);
+            ma_sound_set_position(&sounds[iSound], (float)iSound, 0, -1);
+            ma_sound_set_looping(&sounds[iSound], MA_TRUE);
+            ma_sound_start(&sounds[iSound]);
+        }
+
+        /* Alternate between removing before and after the audio thread has picked up the additions. */
+        if ((iChurn & 1) == 0) {
+            readCount = ma_atomic_load_32(&reader.readCount);
+            while (ma_atomic_load_32(&reader.readCount) - readCount < 2) {
+                ma_yield();
+            }
+        }
+
+        for (iSound = 1; iSound < ma_countof(sounds); iSound += 1) {
+            ma_sound_uninit(&sounds[iSound]);
+            MA_ZERO_OBJECT(&sounds[iSound]);    /* Anything still referencing the sound should trip up. */
+        }
+    }
+
+    ma_atomic_exchange_32(&reader.isStopping, MA_TRUE);
+    ma_thread_wait(&thread);
+
+    /* Pick up anything that was still pending. */
+    ma_engine_read_pcm_frames(&engine, NULL, 0, NULL);
+
+    if (engine.spatializerBatch.count != 1 || ma_atomic_load_32(&sounds[0].engineNode.spatializerBatchIndex) != 0) {
+        printf("FAILED (batch count %d)\n", (int)engine.spatializerBatch.count);
+        result = MA_ERROR;
+    } else {
+        printf("PASSED\n");
+    }
+
+    ma_sound_uninit(&sounds[0]);
+    for (iSound = 0; iSound < ma_countof(sounds); iSound += 1) {
+        ma_audio_buffer_uninit(&buffers[iSound]);
+    }
+
+    ma_engine_uninit(&engine);
+
+    return result;
+}
+
+static ma_result test_engine__sound_transforms(void)
+{
+    ma_result result;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    static float silence[MA_ENGINE_TEST_BLOCK_SIZE];
+    static float output[MA_ENGINE_TEST_BLOCK_SIZE * 2];
+    ma_audio_buffer buffers[3];
+    ma_sound sounds[3];
+    ma_sound_transform* pTransforms;
+    ma_uint32 capacity;
+    ma_uint32 iSound;
+
+    printf("    transforms... ");
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice               = MA_TRUE;
+    engineConfig.channels               = 2;
+    engineConfig.sampleRate             = 48000;
+    engineConfig.soundTransformCapacity = 4;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    for (iSound = 0; iSound < ma_countof(sounds); iSound += 1) {
+        ma_audio_buffer_config bufferConfig = ma_audio_buffer_config_init(ma_format_f32, 1, ma_countof(silence), silence, NULL);
+        ma_audio_buffer_init(&bufferConfig, &buffers[iSound]);
+        ma_sound_init_from_data_source(&engine, &buffers[iSound], 0, NULL, &sounds[iSound]);
+    }
+
+    result = ma_engine_acquire_sound_transforms(&engine, &pTransforms, &capacity);
+    if (result != MA_SUCCESS || capacity != 4) {
+        printf("FAILED (ma_engine_acquire_sound_transforms)\n");
+        result = MA_ERROR;
+        goto done;
+    }
+
+    for (iSound = 0; iSound < 2; iSound += 1) {
+        pTransforms[iSound].pSound    = &sounds[iSound];
+        pTransforms[iSound].position  = ma_vec3f_init_3f((float)iSound + 1, 2, 3);
+        pTransforms[iSound].direction = ma_vec3f_init_3f(0, 0, 1);
+        pTransforms[iSound].velocity  = ma_vec3f_init_3f(0, (float)iSound + 1, 0);
+    }
+
+    ma_engine_commit_sound_transforms(&engine, 2);
+
+    /* Nothing should change until the audio thread picks up the block. */
+    if (!test_engine__vec3f_equal(ma_sound_get_position(&sounds[0]), 0, 0, 0)) {
+        printf("FAILED (transform applied before reading)\n");
+        result = MA_ERROR;
+        goto done;
+    }
+
+    ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+
+    if (!test_engine__vec3f_equal(ma_sound_get_position(&sounds[0]), 1, 2, 3) || !test_engine__vec3f_equal(ma_sound_get_velocity(&sounds[0]), 0, 1, 0) ||
+        !test_engine__vec3f_equal(ma_sound_get_position(&sounds[1]), 2, 2, 3) || !test_engine__vec3f_equal(ma_sound_get_direction(&sounds[1]), 0, 0, 1)) {
+        printf("FAILED (transforms not applied)\n");
+        result = MA_ERROR;
+        goto done;
+    }
+
+    /* Committing twice without a read in between should not lose the first block. */
+    ma_engine_acquire_sound_transforms(&engine, &pTransforms, &capacity);
+    pTransforms[0].pSound    = &sounds[0];
+    pTransforms[0].position  = ma_vec3f_init_3f(10, 0, 0);
+    pTransforms[0].direction = ma_vec3f_init_3f(0, 0, -1);
+    pTransforms[0].velocity  = ma_vec3f_init_3f(0, 0, 0);
+    ma_engine_commit_sound_transforms(&engine, 1);
+
+    ma_engine_acquire_sound_transforms(&engine, &pTransforms, &capacity);
+    pTransforms[0].pSound    = &sounds[1];
+    pTransforms[0].position  = ma_vec3f_init_3f(20, 0, 0);
+    pTransforms[0].direction = ma_vec3f_init_3f(0, 0, -1);
+    pTransforms[0].velocity  = ma_vec3f_init_3f(0, 0, 0);
+    pTransforms[1].pSound    = &sounds[2];
+    pTransforms[1].position  = ma_vec3f_init_3f(30, 0, 0);
+    pTransforms[1].direction = ma_vec3f_init_3f(0, 0, -1);
+    pTransforms[1].velocity  = ma_vec3f_init_3f(0, 0, 0);
+    ma_engine_commit_sound_transforms(&engine, 2);
+
+    /* A sound that's uninitialized while its transform is pending must not be touched. */
+    ma_sound_uninit(&sounds[2]);
+    ma_audio_buffer_uninit(&buffers[2]);
+    MA_ZERO_OBJECT(&sounds[2]);
+
+    ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+
+    if (!test_engine__vec3f_equal(ma_sound_get_position(&sounds[0]), 10, 0, 0) || !test_engine__vec3f_equal(ma_sound_get_position(&sounds[1]), 20, 0, 0)) {
+        printf("FAILED (a block was lost)\n");
+        result = MA_ERROR;
+        goto done;
+    }
+
+    if (!test_engine__vec3f_equal(ma_sound_get_position(&sounds[2]), 0, 0, 0)) {
+        printf("FAILED (transform applied to an uninitialized sound)\n");
+        result = MA_ERROR;
+        goto done;
+    }
+
+    if (ma_engine_commit_sound_transforms(&engine, capacity + 1) != MA_INVALID_ARGS) {
+        printf("FAILED (commit larger than the capacity)\n");
+        result = MA_ERROR;
+        goto done;
+    }
+
+    printf("PASSED\n");
+
+done:
+    for (iSound = 0; iSound < 2; iSound += 1) {
+        ma_sound_uninit(&sounds[iSound]);
+        ma_audio_buffer_uninit(&buffers[iSound]);
+    }
+
+    ma_engine_uninit(&engine);
+
+    return result;
+}
+
+#define MA_ENGINE_TEST_TRANSFORM_COMMIT_COUNT   2000
+
+typedef struct
+{
+    ma_engine* pEngine;
+    ma_sound* pSound;
+    MA_ATOMIC(4, ma_bool32) isStopping;
+    MA_ATOMIC(4, ma_bool32) wentBackwards;
+} ma_engine_sound_transform_reader;
+
+static ma_thread_result MA_THREADCALL test_engine__sound_transform_reader_thread(void* pUserData)
+{
+    ma_engine_sound_transform_reader* pReader = (ma_engine_sound_transform_reader*)pUserData;
+    static float output[MA_ENGINE_TEST_BLOCK_SIZE * 2];
+    float prevX = 0;
+
+    while (ma_atomic_load_32(&pReader->isStopping) == MA_FALSE) {
+        float x;
+
+        ma_engine_read_pcm_frames(pReader->pEngine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+
+        x = ma_sound_get_position(pReader->pSound).x;
+        if (x < prevX) {
+            ma_atomic_exchange_32(&pReader->wentBackwards, MA_TRUE);
+        }
+
+        prevX = x;
+    }
+
+    return (ma_thread_result)0;
+}
+
+static ma_result test_engine__sound_transforms_threaded(void)
+{
+    ma_result result;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    static float silence[MA_ENGINE_TEST_BLOCK_SIZE];
+    ma_audio_buffer buffer;
+    ma_audio_buffer_config bufferConfig;
+    ma_sound sound;
+    ma_sound_transform* pTransforms;
+    ma_engine_sound_transform_reader reader;
+    ma_thread thread;
+    ma_uint32 iCommit;
+
+    printf("    transforms while reading... ");
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice               = MA_TRUE;
+    engineConfig.channels               = 2;
+    engineConfig.sampleRate             = 48000;
+    engineConfig.soundTransformCapacity = 1;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    bufferConfig = ma_audio_buffer_config_init(ma_format_f32, 1, ma_countof(silence), silence, NULL);
+    ma_audio_buffer_init(&bufferConfig, &buffer);
+    ma_sound_init_from_data_source(&engine, &buffer, 0, NULL, &sound);
+
+    reader.pEngine       = &engine;
+    reader.pSound        = &sound;
+    reader.isStopping    = MA_FALSE;
+    reader.wentBackwards = MA_FALSE;
+
+    result = ma_thread_create(&thread, ma_thread_priority_default, 0, test_engine__sound_transform_reader_thread, &reader, NULL);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_thread_create)\n");
+        goto done;
+    }
+
+    /* Blocks that are applied by the committing thread must never land after a newer block applied by the audio thread. */
+    for (iCommit = 1; iCommit <= MA_ENGINE_TEST_TRANSFORM_COMMIT_COUNT; iCommit += 1) {
+        ma_engine_acquire_sound_transforms(&engine, &pTransforms, NULL);
+        pTransforms[0].pSound    = &sound;
+        pTransforms[0].position  = ma_vec3f_init_3f((float)iCommit, 0, 0);
+        pTransforms[0].direction = ma_vec3f_init_3f(0, 0, -1);
+        pTransforms[0].velocity  = ma_vec3f_init_3f(0, 0, 0);
+        ma_engine_commit_sound_transforms(&engine, 1);
+
+        if ((iCommit & 63) == 0) {
+            ma_yield();
+        }
+    }
+
+    /* The last block must still get picked up by the audio thread. */
+    while (ma_sound_get_position(&sound).x != (float)MA_ENGINE_TEST_TRANSFORM_COMMIT_COUNT) {
+        ma_yield();
+    }
+
+    ma_atomic_exchange_32(&reader.isStopping, MA_TRUE);
+    ma_thread_wait(&thread);
+
+    if (ma_atomic_load_32(&reader.wentBackwards)) {
+        printf("FAILED (blocks applied out of order)\n");
+        result = MA_ERROR;
+        goto done;
+    }
+
+    printf("PASSED\n");
+
+done:
+    ma_sound_uninit(&sound);
+    ma_audio_buffer_uninit(&buffer);
+    ma_engine_uninit(&engine);
+
+    return result;
+}
+
+static ma_result test_engine__lod(void)
+{
+    ma_result result;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    static float input[1500 * 2];  /* Not a multiple of the block size so the level switches happen part way through the tones. */
+    static float output[MA_ENGINE_TEST_BLOCK_SIZE * 2];
+    ma_audio_buffer buffer;
+    ma_audio_buffer_config bufferConfig;
+    ma_sound sound;
+    float positions[]   = {5,                 15,                   30,                   19,                   17,                   1};
+    ma_sound_lod lods[] = {ma_sound_lod_full, ma_sound_lod_reduced, ma_sound_lod_minimal, ma_sound_lod_minimal, ma_sound_lod_reduced, ma_sound_lod_full};
+    float prevSample[2] = {0, 0};
+    ma_uint64 cursorBeg;
+    ma_uint64 cursorEnd;
+    ma_uint32 iPosition;
+    ma_uint32 iBlock;
+    ma_uint32 iFrame;
+    ma_uint32 iChannel;
+
+    printf("    distance... ");
+
+    /* Different tones in each channel so the switch to mono resampling is actually audible if it's done wrong. */
+    for (iFrame = 0; iFrame < ma_countof(input) / 2; iFrame += 1) {
+        input[iFrame*2 + 0] = 0.5f * (float)ma_sind(MA_TAU_D * iFrame * 4 / (ma_countof(input) / 2));
+        input[iFrame*2 + 1] = 0.5f * (float)ma_sind(MA_TAU_D * iFrame * 8 / (ma_countof(input) / 2));
+    }
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice           = MA_TRUE;
+    engineConfig.channels           = 2;
+    engineConfig.sampleRate         = 48000;
+    engineConfig.periodSizeInFrames = MA_ENGINE_TEST_BLOCK_SIZE;
+    engineConfig.lodReducedDistance = 10;
+    engineConfig.lodMinimalDistance = 20;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    bufferConfig = ma_audio_buffer_config_init(ma_format_f32, 2, ma_countof(input) / 2, input, NULL);
+    bufferConfig.sampleRate = 48000;
+    ma_audio_buffer_init(&bufferConfig, &buffer);
+
+    result = ma_sound_init_from_data_source(&engine, &buffer, 0, NULL, &sound);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_sound_init_from_data_source)\n");
+        goto done;
+    }
+
+    ma_sound_set_attenuation_model(&sound, ma_attenuation_model_none);
+    ma_sound_set_looping(&sound, MA_TRUE);
+    ma_sound_start(&sound);
+
+    for (iPosition = 0; iPosition < ma_countof(positions); iPosition += 1) {
+        ma_sound_set_position(&sound, 0, 0, -positions[iPosition]);
+
+        for (iBlock = 0; iBlock < 4; iBlock += 1) {
+            ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+
+            /* The input is smooth so the output should be too, including across the switches between levels. */
+            for (iFrame = 0; iFrame < MA_ENGINE_TEST_BLOCK_SIZE; iFrame += 1) {
+                for (iChannel = 0; iChannel < 2; iChannel += 1) {
+                    float sample = output[iFrame*2 + iChannel];
+                    if (!(ma_abs(sample - prevSample[iChannel]) < 0.05f)) {
+                        printf("FAILED (discontinuity at distance %f)\n", positions[iPosition]);
+                        result = MA_ERROR;
+                        goto done_sound;
+                    }
+
+                    prevSample[iChannel] = sample;
+                }
+            }
+        }
+
+        if (ma_sound_get_lod(&sound) != lods[iPosition]) {
+            printf("FAILED (distance %f: level %d != %d)\n", positions[iPosition], (int)ma_sound_get_lod(&sound), (int)lods[iPosition]);
+            result = MA_ERROR;
+            goto done_sound;
+        }
+
+        if (lods[iPosition] == ma_sound_lod_minimal && sound.engineNode.isMonoResampling == MA_FALSE) {
+            printf("FAILED (not resampling in mono)\n");
+            result = MA_ERROR;
+            goto done_sound;
+        }
+    }
+
+    /* The pitch needs to be applied while resampling in mono. */
+    ma_sound_set_position(&sound, 0, 0, -30);
+    for (iBlock = 0; iBlock < 4; iBlock += 1) {
+        ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+    }
+
+    ma_sound_set_pitch(&sound, 1.5f);
+    ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);    /* The cursor is a block ahead because of the resampler's latency. */
+    ma_sound_get_cursor_in_pcm_frames(&sound, &cursorBeg);
+
+    for (iBlock = 0; iBlock < 4; iBlock += 1) {
+        ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+    }
+
+    ma_sound_get_cursor_in_pcm_frames(&sound, &cursorEnd);
+
+    /* The sound is looping so the cursor wraps around. */
+    if (sound.engineNode.isMonoResampling == MA_FALSE || (cursorEnd + ma_countof(input) / 2 - cursorBeg) % (ma_countof(input) / 2) != (MA_ENGINE_TEST_BLOCK_SIZE * 4 * 3 / 2) % (ma_countof(input) / 2)) {
+        printf("FAILED (pitch was not applied while resampling in mono)\n");
+        result = MA_ERROR;
+        goto done_sound;
+    }
+
+    printf("PASSED\n");
+
+done_sound:
+    ma_sound_uninit(&sound);
+done:
+    ma_audio_buffer_uninit(&buffer);
+    ma_engine_uninit(&engine);
+
+    return result;
+}
+
+static ma_result test_engine__lod_doppler(void)
+{
+    ma_result result;
+    ma_engine engine;
+    ma_engine_config engineConfig;
+    static float input[1500 * 2];
+    static float output[MA_ENGINE_TEST_BLOCK_SIZE * 2];
+    ma_audio_buffer buffer;
+    ma_audio_buffer_config bufferConfig;
+    ma_sound sound;
+    float positions[]   = {5,                 15,                   5};
+    ma_sound_lod lods[] = {ma_sound_lod_full, ma_sound_lod_reduced, ma_sound_lod_full};
+    float prevSample[2] = {0, 0};
+    float fullDopplerPitch = 1;
+    float prevDopplerPitch = 1;
+    float maxDopplerPitchStep;
+    ma_uint32 iPosition;
+    ma_uint32 iBlock;
+    ma_uint32 iFrame;
+    ma_uint32 iChannel;
+
+    printf("    doppler... ");
+
+    for (iFrame = 0; iFrame < ma_countof(input) / 2; iFrame += 1) {
+        input[iFrame*2 + 0] = 0.5f * (float)ma_sind(MA_TAU_D * iFrame * 4 / (ma_countof(input) / 2));
+        input[iFrame*2 + 1] = 0.5f * (float)ma_sind(MA_TAU_D * iFrame * 8 / (ma_countof(input) / 2));
+    }
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice           = MA_TRUE;
+    engineConfig.channels           = 2;
+    engineConfig.sampleRate         = 48000;
+    engineConfig.periodSizeInFrames = MA_ENGINE_TEST_BLOCK_SIZE;
+    engineConfig.lodReducedDistance = 10;
+
+    result = ma_engine_init(&engineConfig, &engine);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_engine_init)\n");
+        return result;
+    }
+
+    bufferConfig = ma_audio_buffer_config_init(ma_format_f32, 2, ma_countof(input) / 2, input, NULL);
+    bufferConfig.sampleRate = 48000;
+    ma_audio_buffer_init(&bufferConfig, &buffer);
+
+    result = ma_sound_init_from_data_source(&engine, &buffer, 0, NULL, &sound);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_sound_init_from_data_source)\n");
+        goto done;
+    }
+
+    /* The sound is heading towards the listener so there's always some doppler at full detail. */
+    ma_sound_set_attenuation_model(&sound, ma_attenuation_model_inverse);
+    ma_sound_set_min_distance(&sound, 1);
+    ma_sound_set_velocity(&sound, 0, 0, 30);
+    ma_sound_set_looping(&sound, MA_TRUE);
+    ma_sound_start(&sound);
+
+    for (iPosition = 0; iPosition < ma_countof(positions); iPosition += 1) {
+        ma_sound_set_position(&sound, 0, 0, -positions[iPosition]);
+
+        for (iBlock = 0; iBlock < 20; iBlock += 1) {
+            float dopplerPitch;
+
+            ma_engine_read_pcm_frames(&engine, output, MA_ENGINE_TEST_BLOCK_SIZE, NULL);
+
+            for (iFrame = 0; iFrame < MA_ENGINE_TEST_BLOCK_SIZE; iFrame += 1) {
+                for (iChannel = 0; iChannel < 2; iChannel += 1) {
+                    float sample = output[iFrame*2 + iChannel];
+                    if (!(ma_abs(sample - prevSample[iChannel]) < 0.05f)) {
+                        printf("FAILED (discontinuity at distance %f)\n", positions[iPosition]);
+                        result = MA_ERROR;
+                        goto done_sound;
+                    }
+
+                    prevSample[iChannel] = sample;
+                }
+            }
+
+            /* The first position is only for finding out what the doppler pitch is at full detail. After that it should only ever ramp. */
+            dopplerPitch = sound.engineNode.oldDopplerPitch;
+            if (iPosition == 0) {
+                fullDopplerPitch = dopplerPitch;
+            } else {
+                maxDopplerPitchStep = ma_abs(fullDopplerPitch - 1) * 0.25f;
+                if (!(ma_abs(dopplerPitch - prevDopplerPitch) <= maxDopplerPitchStep)) {
+                    printf("FAILED (doppler pitch jumped from %f to %f at distance %f)\n", prevDopplerPitch, dopplerPitch, positions[iPosition]);
+                    result = MA_ERROR;
+                    goto done_sound;
+                }
+            }
+
+            prevDopplerPitch = dopplerPitch;
+        }
+
+        if (ma_sound_get_lod(&sound) != lods[iPosition]) {
+            printf("FAILED (distance %f: level %d != %d)\n", positions[iPosition], (int)ma_sound_get_lod(&sound), (int)lods[iPosition]);
+            result = MA_ERROR;
+            goto done_sound;
+        }
+
+        if (iPosition == 0 && !(ma_abs(fullDopplerPitch - 1) > 0.01f)) {
+            printf("FAILED (no doppler at full detail)\n");
+            result = MA_ERROR;
+            goto done_sound;
+        }
+
+        /* By now the ramp should have finished. */
+        if (prevDopplerPitch != ((lods[iPosition] == ma_sound_lod_full) ? fullDopplerPitch : 1)) {
+            printf("FAILED (doppler pitch of %f at distance %f)\n", prevDopplerPitch, positions[iPosition]);
+            result = MA_ERROR;
+            goto done_sound;
+        }
+    }
+
+    printf("PASSED\n");
+
+done_sound:
+    ma_sound_uninit(&sound);
+done:
+    ma_audio_buffer_uninit(&buffer);
+    ma_engine_uninit(&engine);
+
+    return result;
+}
+
+int test_entry__engine(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+    float pans[] = {-0.5f, 0, 0.25f};
+    ma_uint32 channelsIn;
+    ma_uint32 iPan;
+    ma_uint32 order;
+
+    (void)argc;
+    (void)argv;
+
+    printf("Inlined sound pool\n");
+    if (test_engine__inlined_sound_pool(ma_inlined_sound_steal_policy_none) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_engine__inlined_sound_pool(ma_inlined_sound_steal_policy_oldest) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_engine__inlined_sound_pool(ma_inlined_sound_steal_policy_quietest) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_engine__inlined_sound_pool_hash_collision() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("Virtualization\n");
+    if (test_engine__virtualization() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_engine__virtualization_channels_out() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("Sample rate groups\n");
+    if (test_engine__sample_rate_groups() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_engine__sample_rate_groups_nested() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("Ambisonics\n");
+    for (order = 1; order <= MA_AMBISONIC_MAX_ORDER; order += 1) {
+        if (test_engine__ambisonic_decoder(order) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+    if (test_engine__ambisonic_bus() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("Spatializer batch\n");
+    if (test_engine__spatializer_batch(MA_FALSE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_engine__spatializer_batch(MA_TRUE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_engine__spatializer_batch_engine(64) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_engine__spatializer_batch_engine(3) != MA_SUCCESS) {  /* Some sounds don't fit in the batch. */
+        hasError = MA_TRUE;
+    }
+    if (test_engine__spatializer_batch_threaded() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("Sound transforms\n");
+    if (test_engine__sound_transforms() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_engine__sound_transforms_threaded() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("Level of detail\n");
+    if (test_engine__lod() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_engine__lod_doppler() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("Volume and panning\n");
+    for (channelsIn = 1; channelsIn <= 2; channelsIn += 1) {
+        for (iPan = 0; iPan < ma_countof(pans); iPan += 1) {
+            if (test_engine__volume_and_pan(channelsIn, ma_pan_mode_balance, pans[iPan]) != MA_SUCCESS) {
+                hasError = MA_TRUE;
+            }
+            if (test_engine__volume_and_pan(channelsIn, ma_pan_mode_pan, pans[iPan]) != MA_SUCCESS) {
+                hasError = MA_TRUE;
+            }
+        }
+    }
+
+    if (hasError) {
+        return -1;
+    } else {
+        return 0;
+    }
+}
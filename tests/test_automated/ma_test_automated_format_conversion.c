@@ -0,0 +1,242 @@
+typedef void (* ma_pcm_convert_proc)(void* dst, const void* src, ma_uint64 count, ma_dither_mode ditherMode);
+
+typedef struct
+{
+    const char* pName;
+    ma_format formatIn;
+    ma_format formatOut;
+    ma_pcm_convert_proc onConvert;
+    ma_pcm_convert_proc onConvertReference;
+} ma_format_conversion_test;
+
+static ma_format_conversion_test g_FormatConversionTests[] =
+{
+    {"u8 -> s16",  ma_format_u8,  ma_format_s16, ma_pcm_u8_to_s16,  ma_pcm_u8_to_s16__reference },
+    {"u8 -> s24",  ma_format_u8,  ma_format_s24, ma_pcm_u8_to_s24,  ma_pcm_u8_to_s24__reference },
+    {"u8 -> s32",  ma_format_u8,  ma_format_s32, ma_pcm_u8_to_s32,  ma_pcm_u8_to_s32__reference },
+    {"u8 -> f32",  ma_format_u8,  ma_format_f32, ma_pcm_u8_to_f32,  ma_pcm_u8_to_f32__reference },
+    {"s16 -> u8",  ma_format_s16, ma_format_u8,  ma_pcm_s16_to_u8,  ma_pcm_s16_to_u8__reference },
+    {"s16 -> s24", ma_format_s16, ma_format_s24, ma_pcm_s16_to_s24, ma_pcm_s16_to_s24__reference},
+    {"s16 -> s32", ma_format_s16, ma_format_s32, ma_pcm_s16_to_s32, ma_pcm_s16_to_s32__reference},
+    {"s16 -> f32", ma_format_s16, ma_format_f32, ma_pcm_s16_to_f32, ma_pcm_s16_to_f32__reference},
+    {"s24 -> u8",  ma_format_s24, ma_format_u8,  ma_pcm_s24_to_u8,  ma_pcm_s24_to_u8__reference },
+    {"s24 -> s16", ma_format_s24, ma_format_s16, ma_pcm_s24_to_s16, ma_pcm_s24_to_s16__reference},
+    {"s24 -> s32", ma_format_s24, ma_format_s32, ma_pcm_s24_to_s32, ma_pcm_s24_to_s32__reference},
+    {"s24 -> f32", ma_format_s24, ma_format_f32, ma_pcm_s24_to_f32, ma_pcm_s24_to_f32__reference},
+    {"s32 -> u8",  ma_format_s32, ma_format_u8,  ma_pcm_s32_to_u8,  ma_pcm_s32_to_u8__reference },
+    {"s32 -> s16", ma_format_s32, ma_format_s16, ma_pcm_s32_to_s16, ma_pcm_s32_to_s16__reference},
+    {"s32 -> s24", ma_format_s32, ma_format_s24, ma_pcm_s32_to_s24, ma_pcm_s32_to_s24__reference},
+    {"s32 -> f32", ma_format_s32, ma_format_f32, ma_pcm_s32_to_f32, ma_pcm_s32_to_f32__reference},
+    {"f32 -> u8",  ma_format_f32, ma_format_u8,  ma_pcm_f32_to_u8,  ma_pcm_f32_to_u8__reference },
+    {"f32 -> s16", ma_format_f32, ma_format_s16, ma_pcm_f32_to_s16, ma_pcm_f32_to_s16__reference},
+    {"f32 -> s24", ma_format_f32, ma_format_s24, ma_pcm_f32_to_s24, ma_pcm_f32_to_s24__reference},
+    {"f32 -> s32", ma_format_f32, ma_format_s32, ma_pcm_f32_to_s32, ma_pcm_f32_to_s32__reference}
+};
+
+#define MA_FORMAT_CONVERSION_TEST_SAMPLE_COUNT  1031    /* Odd on purpose so the leftover paths get exercised. */
+
+static void test_format_conversion__generate_input(ma_format format, void* pSamples, ma_uint32 sampleCount, ma_lcg* pLCG)
+{
+    ma_uint32 iSample;
+
+    if (format == ma_format_f32) {
+        float* pSamplesF32 = (float*)pSamples;
+        for (iSample = 0; iSample < sampleCount; iSample += 1) {
+            /* Go slightly out of range so clipping gets tested. Throw in some exact boundary values as well. */
+            switch (iSample % 16) {
+                case 0:  pSamplesF32[iSample] = -1; break;
+                case 1:  pSamplesF32[iSample] =  1; break;
+                case 2:  pSamplesF32[iSample] =  0; break;
+                default: pSamplesF32[iSample] = ma_lcg_rand_range_f32(pLCG, -1.25f, 1.25f); break;
+            }
+        }
+    } else {
+        ma_uint8* pBytes = (ma_uint8*)pSamples;
+        ma_uint32 byteCount = sampleCount * ma_get_bytes_per_sample(format);
+        ma_uint32 iByte;
+        for (iByte = 0; iByte < byteCount; iByte += 1) {
+            pBytes[iByte] = (ma_uint8)(ma_lcg_rand_u32(pLCG) >> 7);
+        }
+    }
+}
+
+static ma_result test_format_conversion__by_test(const ma_format_conversion_test* pTest)
+{
+    ma_uint8 input[MA_FORMAT_CONVERSION_TEST_SAMPLE_COUNT*4 + 16];
+    ma_uint8 output[MA_FORMAT_CONVERSION_TEST_SAMPLE_COUNT*4 + 16];
+    ma_uint8 outputReference[MA_FORMAT_CONVERSION_TEST_SAMPLE_COUNT*4 + 16];
+    ma_uint32 bpfOut = ma_get_bytes_per_sample(pTest->formatOut);
+    ma_dither_mode ditherModes[] = {ma_dither_mode_none, ma_dither_mode_rectangle, ma_dither_mode_triangle};
+    ma_uint32 iDitherMode;
+    ma_uint32 offset;
+    ma_lcg lcg;
+
+    printf("    %s... ", pTest->pName);
+
+    ma_lcg_seed(&lcg, 1234);
+
+    for (iDitherMode = 0; iDitherMode < ma_countof(ditherModes); iDitherMode += 1) {
+        /* The offset is used to test unaligned buffers. It needs to keep the samples themselves naturally aligned. */
+        for (offset = 0; offset < 16; offset += 4) {
+            ma_uint32 sampleCount;
+            void* pInput  = input  + offset;
+            void* pOutput = output + offset;
+            void* pOutputReference = outputReference + offset;
+
+            test_format_conversion__generate_input(pTest->formatIn, pInput, MA_FORMAT_CONVERSION_TEST_SAMPLE_COUNT, &lcg);
+
+            for (sampleCount = 0; sampleCount <= MA_FORMAT_CONVERSION_TEST_SAMPLE_COUNT; sampleCount += (sampleCount < 64) ? 1 : 241) {
+                /* Dithering uses the global random number generator so it needs to be reset to get the same dither for each. */
+                MA_ZERO_MEMORY(pOutput, MA_FORMAT_CONVERSION_TEST_SAMPLE_COUNT * bpfOut);
+                ma_seed(sampleCount + 1);
+                pTest->onConvert(pOutput, pInput, sampleCount, ditherModes[iDitherMode]);
+
+                MA_ZERO_MEMORY(pOutputReference, MA_FORMAT_CONVERSION_TEST_SAMPLE_COUNT * bpfOut);
+                ma_seed(sampleCount + 1);
+                pTest->onConvertReference(pOutputReference, pInput, sampleCount, ditherModes[iDitherMode]);
+
+                if (memcmp(pOutput, pOutputReference, MA_FORMAT_CONVERSION_TEST_SAMPLE_COUNT * bpfOut) != 0) {
+                    printf("FAILED (dither=%d, offset=%d, count=%d)\n", (int)ditherModes[iDitherMode], (int)offset, (int)sampleCount);
+                    return MA_ERROR;
+                }
+            }
+        }
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+#define MA_INTERLEAVE_TEST_MAX_CHANNELS     8
+#define MA_INTERLEAVE_TEST_MAX_FRAME_COUNT  263
+
+static ma_result test_format_conversion__interleave_by_format(ma_format formatIn, ma_format formatOut)
+{
+    static ma_uint8 interleaved[MA_INTERLEAVE_TEST_MAX_FRAME_COUNT * MA_INTERLEAVE_TEST_MAX_CHANNELS * 4];
+    static ma_uint8 interleavedReference[MA_INTERLEAVE_TEST_MAX_FRAME_COUNT * MA_INTERLEAVE_TEST_MAX_CHANNELS * 4];
+    static ma_uint8 deinterleaved[MA_INTERLEAVE_TEST_MAX_CHANNELS][MA_INTERLEAVE_TEST_MAX_FRAME_COUNT * 4];
+    static ma_uint8 deinterleavedReference[MA_INTERLEAVE_TEST_MAX_CHANNELS][MA_INTERLEAVE_TEST_MAX_FRAME_COUNT * 4];
+    static ma_uint8 input[MA_INTERLEAVE_TEST_MAX_FRAME_COUNT * MA_INTERLEAVE_TEST_MAX_CHANNELS * 4];
+    ma_uint32 channelCounts[] = {1, 2, 3, 4, 5, 6, 8};
+    ma_uint32 frameCounts[] = {0, 1, 3, 4, 5, 7, 8, 64, 263};
+    ma_uint32 bpsIn  = ma_get_bytes_per_sample(formatIn);
+    ma_uint32 bpsOut = ma_get_bytes_per_sample(formatOut);
+    ma_uint32 iChannelCount;
+    ma_uint32 iFrameCount;
+    ma_lcg lcg;
+
+    printf("    %s -> %s... ", ma_get_format_name(formatIn), ma_get_format_name(formatOut));
+
+    ma_lcg_seed(&lcg, 4321);
+    test_format_conversion__generate_input(formatIn, input, MA_INTERLEAVE_TEST_MAX_FRAME_COUNT * MA_INTERLEAVE_TEST_MAX_CHANNELS, &lcg);
+
+    for (iChannelCount = 0; iChannelCount < ma_countof(channelCounts); iChannelCount += 1) {
+        for (iFrameCount = 0; iFrameCount < ma_countof(frameCounts); iFrameCount += 1) {
+            ma_uint32 channels   = channelCounts[iChannelCount];
+            ma_uint32 frameCount = frameCounts[iFrameCount];
+            const void* ppPlanarIn[MA_INTERLEAVE_TEST_MAX_CHANNELS];
+            void* ppPlanarOut[MA_INTERLEAVE_TEST_MAX_CHANNELS];
+            ma_uint32 iChannel;
+            ma_uint32 iFrame;
+
+            /* Deinterleave. The reference converts one sample at a time. */
+            for (iChannel = 0; iChannel < channels; iChannel += 1) {
+                ppPlanarOut[iChannel] = deinterleaved[iChannel];
+                MA_ZERO_MEMORY(deinterleaved[iChannel], sizeof(deinterleaved[iChannel]));
+                MA_ZERO_MEMORY(deinterleavedReference[iChannel], sizeof(deinterleavedReference[iChannel]));
+
+                for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+                    ma_pcm_convert(deinterleavedReference[iChannel] + iFrame*bpsOut, formatOut, input + (iFrame*channels + iChannel)*bpsIn, formatIn, 1, ma_dither_mode_none);
+                }
+            }
+
+            ma_deinterleave_pcm_frames_ex(formatOut, formatIn, channels, frameCount, input, ppPlanarOut, ma_dither_mode_none);
+
+            for (iChannel = 0; iChannel < channels; iChannel += 1) {
+                if (memcmp(deinterleaved[iChannel], deinterleavedReference[iChannel], sizeof(deinterleaved[iChannel])) != 0) {
+                    printf("FAILED (deinterleave, channels=%d, frames=%d)\n", (int)channels, (int)frameCount);
+                    return MA_ERROR;
+                }
+            }
+
+            /* Interleave, with the input treated as planar. */
+            MA_ZERO_MEMORY(interleaved, sizeof(interleaved));
+            MA_ZERO_MEMORY(interleavedReference, sizeof(interleavedReference));
+
+            for (iChannel = 0; iChannel < channels; iChannel += 1) {
+                ppPlanarIn[iChannel] = input + (iChannel * frameCount * bpsIn);
+
+                for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+                    ma_pcm_convert(interleavedReference + (iFrame*channels + iChannel)*bpsOut, formatOut, (const ma_uint8*)ppPlanarIn[iChannel] + iFrame*bpsIn, formatIn, 1, ma_dither_mode_none);
+                }
+            }
+
+            ma_interleave_pcm_frames_ex(formatOut, formatIn, channels, frameCount, ppPlanarIn, interleaved, ma_dither_mode_none);
+
+            if (memcmp(interleaved, interleavedReference, sizeof(interleaved)) != 0) {
+                printf("FAILED (interleave, channels=%d, frames=%d)\n", (int)channels, (int)frameCount);
+                return MA_ERROR;
+            }
+        }
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+static ma_result test_format_conversion__interleave()
+{
+    ma_bool32 hasError = MA_FALSE;
+    ma_format formats[][2] = {
+        {ma_format_f32, ma_format_f32},
+        {ma_format_s16, ma_format_s16},
+        {ma_format_s32, ma_format_s32},
+        {ma_format_s24, ma_format_s24},
+        {ma_format_u8,  ma_format_u8 },
+        {ma_format_s16, ma_format_f32},
+        {ma_format_f32, ma_format_s16},
+        {ma_format_s24, ma_format_f32},
+        {ma_format_f32, ma_format_u8 },
+        {ma_format_s32, ma_format_s16}
+    };
+    ma_uint32 iFormat;
+
+    printf("Interleaving\n");
+    for (iFormat = 0; iFormat < ma_countof(formats); iFormat += 1) {
+        if (test_format_conversion__interleave_by_format(formats[iFormat][0], formats[iFormat][1]) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    if (hasError) {
+        return MA_ERROR;
+    } else {
+        return MA_SUCCESS;
+    }
+}
+
+int test_entry__format_conversion(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+    size_t iTest;
+
+    (void)argc;
+    (void)argv;
+
+    printf("Bit-exactness against reference\n");
+    for (iTest = 0; iTest < ma_countof(g_FormatConversionTests); iTest += 1) {
+        if (test_format_conversion__by_test(&g_FormatConversionTests[iTest]) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    if (test_format_conversion__interleave() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    } else {
+        return 0;
+    }
+}
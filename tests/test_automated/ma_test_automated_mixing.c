@@ -0,0 +1,201 @@
+#define MA_MIXING_TEST_MAX_SOURCES  7
+#define MA_MIXING_TEST_FRAME_COUNT  263     /* Odd on purpose so the leftover paths get exercised. */
+
+static ma_result test_mixing__multi_by_channels(ma_uint32 channels, ma_bool32 useVolumes)
+{
+    float src[MA_MIXING_TEST_MAX_SOURCES][MA_MIXING_TEST_FRAME_COUNT * 8];
+    float dst[MA_MIXING_TEST_FRAME_COUNT * 8];
+    float dstReference[MA_MIXING_TEST_FRAME_COUNT * 8];
+    const float* ppSrc[MA_MIXING_TEST_MAX_SOURCES];
+    float volumes[MA_MIXING_TEST_MAX_SOURCES];
+    ma_uint32 sampleCount = MA_MIXING_TEST_FRAME_COUNT * channels;
+    ma_uint32 sourceCount;
+    ma_uint32 iSource;
+    ma_uint32 iSample;
+    ma_lcg lcg;
+
+    printf("    %d channels, %s... ", (int)channels, (useVolumes) ? "with volume" : "without volume");
+
+    ma_lcg_seed(&lcg, 4321);
+
+    for (iSource = 0; iSource < MA_MIXING_TEST_MAX_SOURCES; iSource += 1) {
+        for (iSample = 0; iSample < sampleCount; iSample += 1) {
+            src[iSource][iSample] = ma_lcg_rand_range_f32(&lcg, -1, 1);
+        }
+
+        ppSrc[iSource]   = src[iSource];
+        volumes[iSource] = (iSource == 0) ? 1 : ma_lcg_rand_range_f32(&lcg, 0, 1);
+    }
+
+    for (sourceCount = 0; sourceCount <= MA_MIXING_TEST_MAX_SOURCES; sourceCount += 1) {
+        for (iSample = 0; iSample < sampleCount; iSample += 1) {
+            dst[iSample] = dstReference[iSample] = ma_lcg_rand_range_f32(&lcg, -1, 1);
+        }
+
+        /* The multi-source version must give exactly the same result as mixing each source one after the other. */
+        for (iSource = 0; iSource < sourceCount; iSource += 1) {
+            ma_mix_pcm_frames_f32(dstReference, ppSrc[iSource], MA_MIXING_TEST_FRAME_COUNT, channels, (useVolumes) ? volumes[iSource] : 1);
+        }
+
+        ma_mix_pcm_frames_multi_f32(dst, ppSrc, (useVolumes) ? volumes : NULL, sourceCount, MA_MIXING_TEST_FRAME_COUNT, channels);
+
+        if (memcmp(dst, dstReference, sampleCount * sizeof(float)) != 0) {
+            printf("FAILED (sourceCount=%d)\n", (int)sourceCount);
+            return MA_ERROR;
+        }
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+static ma_result test_mixing__single_by_channels(ma_uint32 channels, float volume)
+{
+    float src[MA_MIXING_TEST_FRAME_COUNT * 8];
+    float dst[MA_MIXING_TEST_FRAME_COUNT * 8];
+    float dstReference[MA_MIXING_TEST_FRAME_COUNT * 8];
+    ma_uint32 sampleCount = MA_MIXING_TEST_FRAME_COUNT * channels;
+    ma_uint32 iSample;
+    ma_lcg lcg;
+
+    printf("    %d channels, volume %f... ", (int)channels, volume);
+
+    /* Only the first sampleCount samples are used, but clear the rest so the compiler can see everything is initialized. */
+    MA_ZERO_MEMORY(src, sizeof(src));
+    MA_ZERO_MEMORY(dst, sizeof(dst));
+
+    ma_lcg_seed(&lcg, 1234);
+
+    for (iSample = 0; iSample < sampleCount; iSample += 1) {
+        src[iSample] = ma_lcg_rand_range_f32(&lcg, -1, 1);
+        dst[iSample] = dstReference[iSample] = ma_lcg_rand_range_f32(&lcg, -1, 1);
+        dstReference[iSample] += src[iSample] * volume;
+    }
+
+    ma_mix_pcm_frames_f32(dst, src, MA_MIXING_TEST_FRAME_COUNT, channels, volume);
+
+    if (memcmp(dst, dstReference, sampleCount * sizeof(float)) != 0) {
+        printf("FAILED\n");
+        return MA_ERROR;
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+#define MA_MIXING_TEST_NODE_COUNT   11
+
+static ma_result test_mixing__node_graph(ma_uint32 channels)
+{
+    ma_result result;
+    ma_node_graph nodeGraph;
+    ma_node_graph_config nodeGraphConfig;
+    ma_waveform waveforms[MA_MIXING_TEST_NODE_COUNT];
+    ma_waveform waveformsReference[MA_MIXING_TEST_NODE_COUNT];
+    ma_data_source_node nodes[MA_MIXING_TEST_NODE_COUNT];
+    float output[MA_MIXING_TEST_FRAME_COUNT * 8];
+    float outputReference[MA_MIXING_TEST_FRAME_COUNT * 8];
+    float temp[MA_MIXING_TEST_FRAME_COUNT * 8];
+    ma_uint64 framesRead;
+    ma_uint32 iNode;
+    ma_uint32 iSample;
+
+    printf("    node graph, %d channels... ", (int)channels);
+
+    nodeGraphConfig = ma_node_graph_config_init(channels);
+    nodeGraphConfig.nodeCacheCapInFrames = MA_MIXING_TEST_FRAME_COUNT;
+
+    result = ma_node_graph_init(&nodeGraphConfig, NULL, &nodeGraph);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_node_graph_init)\n");
+        return result;
+    }
+
+    MA_ZERO_MEMORY(outputReference, sizeof(outputReference));
+
+    for (iNode = 0; iNode < MA_MIXING_TEST_NODE_COUNT; iNode += 1) {
+        ma_waveform_config waveformConfig = ma_waveform_config_init(ma_format_f32, channels, 48000, ma_waveform_type_sine, 0.05, 110.0 * (iNode + 1));
+        ma_data_source_node_config nodeConfig;
+
+        ma_waveform_init(&waveformConfig, &waveforms[iNode]);
+        ma_waveform_init(&waveformConfig, &waveformsReference[iNode]);
+
+        nodeConfig = ma_data_source_node_config_init(&waveforms[iNode]);
+        result = ma_data_source_node_init(&nodeGraph, &nodeConfig, NULL, &nodes[iNode]);
+        if (result != MA_SUCCESS) {
+            printf("FAILED (ma_data_source_node_init)\n");
+            return result;
+        }
+
+        ma_node_attach_output_bus(&nodes[iNode], 0, ma_node_graph_get_endpoint(&nodeGraph), 0);
+
+        ma_waveform_read_pcm_frames(&waveformsReference[iNode], temp, MA_MIXING_TEST_FRAME_COUNT, NULL);
+        ma_mix_pcm_frames_f32(outputReference, temp, MA_MIXING_TEST_FRAME_COUNT, channels, 1);
+    }
+
+    ma_node_graph_read_pcm_frames(&nodeGraph, output, MA_MIXING_TEST_FRAME_COUNT, &framesRead);
+
+    for (iNode = 0; iNode < MA_MIXING_TEST_NODE_COUNT; iNode += 1) {
+        ma_data_source_node_uninit(&nodes[iNode], NULL);
+    }
+    ma_node_graph_uninit(&nodeGraph, NULL);
+
+    if (framesRead != MA_MIXING_TEST_FRAME_COUNT) {
+        printf("FAILED (framesRead=%d)\n", (int)framesRead);
+        return MA_ERROR;
+    }
+
+    /* The order of accumulation can differ from the reference so allow for some rounding error. */
+    for (iSample = 0; iSample < MA_MIXING_TEST_FRAME_COUNT * channels; iSample += 1) {
+        float d = output[iSample] - outputReference[iSample];
+        if (d < -0.00001f || d > 0.00001f) {
+            printf("FAILED (sample %d: %f != %f)\n", (int)iSample, output[iSample], outputReference[iSample]);
+            return MA_ERROR;
+        }
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+int test_entry__mixing(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+    ma_uint32 channels;
+
+    (void)argc;
+    (void)argv;
+
+    printf("Single source\n");
+    for (channels = 1; channels <= 8; channels += 1) {
+        if (test_mixing__single_by_channels(channels, 1) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+        if (test_mixing__single_by_channels(channels, 0.5f) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    printf("Multiple sources\n");
+    for (channels = 1; channels <= 8; channels += 1) {
+        if (test_mixing__multi_by_channels(channels, MA_FALSE) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+        if (test_mixing__multi_by_channels(channels, MA_TRUE) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    printf("Node graph\n");
+    for (channels = 1; channels <= 8; channels += 1) {
+        if (test_mixing__node_graph(channels) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    if (hasError) {
+        return -1;
+    } else {
+        return 0;
+    }
+}
@@ -0,0 +1,1379 @@
+#define MA_NODE_GRAPH_TEST_SOURCE_COUNT     13
+#define MA_NODE_GRAPH_TEST_CHANNELS         2
+#define MA_NODE_GRAPH_TEST_FRAME_COUNT      480
+#define MA_NODE_GRAPH_TEST_ITERATIONS       8
+
+typedef struct
+{
+    ma_node_graph nodeGraph;
+    ma_waveform waveforms[MA_NODE_GRAPH_TEST_SOURCE_COUNT];
+    ma_data_source_node sourceNodes[MA_NODE_GRAPH_TEST_SOURCE_COUNT];
+    ma_splitter_node splitterNode;
+} ma_node_graph_test;
+
+static ma_result test_node_graph__init(ma_node_graph_test* pTest, ma_uint32 jobThreadCount, ma_uint32 jobCapacity, ma_bool32 useSplitter)
+{
+    ma_result result;
+    ma_node_graph_config nodeGraphConfig;
+    ma_splitter_node_config splitterConfig;
+    ma_uint32 iSource;
+
+    nodeGraphConfig = ma_node_graph_config_init(MA_NODE_GRAPH_TEST_CHANNELS);
+
+    /*
+    The output buses of a splitter need to be read in lockstep which is only the case when each read
+    fits in the node cache. Without a splitter we use a small cache so reads get split into chunks.
+    */
+    nodeGraphConfig.nodeCacheCapInFrames = (useSplitter) ? MA_NODE_GRAPH_TEST_FRAME_COUNT : 100;
+    nodeGraphConfig.jobThreadCount       = jobThreadCount;
+    nodeGraphConfig.jobCapacity          = jobCapacity;
+
+    result = ma_node_graph_init(&nodeGraphConfig, NULL, &pTest->nodeGraph);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    /* The splitter has both of its outputs attached to the endpoint so it'll be read from two different jobs. */
+    splitterConfig = ma_splitter_node_config_init(MA_NODE_GRAPH_TEST_CHANNELS);
+    result = ma_splitter_node_init(&pTest->nodeGraph, &splitterConfig, NULL, &pTest->splitterNode);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    ma_node_attach_output_bus(&pTest->splitterNode, 0, ma_node_graph_get_endpoint(&pTest->nodeGraph), 0);
+    ma_node_attach_output_bus(&pTest->splitterNode, 1, ma_node_graph_get_endpoint(&pTest->nodeGraph), 0);
+    ma_node_set_output_bus_volume(&pTest->splitterNode, 1, 0.5f);
+
+    for (iSource = 0; iSource < MA_NODE_GRAPH_TEST_SOURCE_COUNT; iSource += 1) {
+        ma_waveform_config waveformConfig;
+        ma_data_source_node_config sourceNodeConfig;
+
+        waveformConfig = ma_waveform_config_init(ma_format_f32, MA_NODE_GRAPH_TEST_CHANNELS, 48000, (ma_waveform_type)(iSource % 4), 0.05, 55.0 * (iSource + 1));
+        result = ma_waveform_init(&waveformConfig, &pTest->waveforms[iSource]);
+        if (result != MA_SUCCESS) {
+            return result;
+        }
+
+        sourceNodeConfig = ma_data_source_node_config_init(&pTest->waveforms[iSource]);
+        result = ma_data_source_node_init(&pTest->nodeGraph, &sourceNodeConfig, NULL, &pTest->sourceNodes[iSource]);
+        if (result != MA_SUCCESS) {
+            return result;
+        }
+
+        /* Every third source goes through the splitter. The rest go straight to the endpoint. */
+        if (useSplitter && (iSource % 3) == 0) {
+            ma_node_attach_output_bus(&pTest->sourceNodes[iSource], 0, &pTest->splitterNode, 0);
+        } else {
+            ma_node_attach_output_bus(&pTest->sourceNodes[iSource], 0, ma_node_graph_get_endpoint(&pTest->nodeGraph), 0);
+        }
+    }
+
+    return MA_SUCCESS;
+}
+
+static void test_node_graph__uninit(ma_node_graph_test* pTest)
+{
+    ma_uint32 iSource;
+
+    for (iSource = 0; iSource < MA_NODE_GRAPH_TEST_SOURCE_COUNT; iSource += 1) {
+        ma_data_source_node_uninit(&pTest->sourceNodes[iSource], NULL);
+        ma_waveform_uninit(&pTest->waveforms[iSource]);
+    }
+
+    ma_splitter_node_uninit(&pTest->splitterNode, NULL);
+    ma_node_graph_uninit(&pTest->nodeGraph, NULL);
+}
+
+static ma_node_graph_test g_NodeGraphTestReference;
+static ma_node_graph_test g_NodeGraphTest;
+
+static ma_result test_node_graph__multi_threaded(ma_uint32 jobThreadCount, ma_uint32 jobCapacity, ma_bool32 useSplitter)
+{
+    ma_result result;
+    float output[MA_NODE_GRAPH_TEST_FRAME_COUNT * MA_NODE_GRAPH_TEST_CHANNELS];
+    float outputReference[MA_NODE_GRAPH_TEST_FRAME_COUNT * MA_NODE_GRAPH_TEST_CHANNELS];
+    ma_uint32 iIteration;
+    ma_uint32 iSample;
+
+    printf("    %d threads, job capacity %d, %s... ", (int)jobThreadCount, (int)jobCapacity, (useSplitter) ? "with splitter" : "without splitter");
+
+    result = test_node_graph__init(&g_NodeGraphTestReference, 0, 0, useSplitter);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (failed to initialize reference graph)\n");
+        return result;
+    }
+
+    result = test_node_graph__init(&g_NodeGraphTest, jobThreadCount, jobCapacity, useSplitter);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (failed to initialize graph)\n");
+        test_node_graph__uninit(&g_NodeGraphTestReference);
+        return result;
+    }
+
+    for (iIteration = 0; iIteration < MA_NODE_GRAPH_TEST_ITERATIONS; iIteration += 1) {
+        ma_node_graph_read_pcm_frames(&g_NodeGraphTestReference.nodeGraph, outputReference, MA_NODE_GRAPH_TEST_FRAME_COUNT, NULL);
+        ma_node_graph_read_pcm_frames(&g_NodeGraphTest.nodeGraph, output, MA_NODE_GRAPH_TEST_FRAME_COUNT, NULL);
+
+        /* Mixing is done in the same order regardless of threading so the output should be identical. */
+        for (iSample = 0; iSample < MA_NODE_GRAPH_TEST_FRAME_COUNT * MA_NODE_GRAPH_TEST_CHANNELS; iSample += 1) {
+            if (output[iSample] != outputReference[iSample]) {
+                printf("FAILED (iteration %d, sample %d: %f != %f)\n", (int)iIteration, (int)iSample, output[iSample], outputReference[iSample]);
+                result = MA_ERROR;
+                break;
+            }
+        }
+
+        if (result != MA_SUCCESS) {
+            break;
+        }
+    }
+
+    test_node_graph__uninit(&g_NodeGraphTest);
+    test_node_graph__uninit(&g_NodeGraphTestReference);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+/*
+A splitter with its second output fed back into its input through a low pass filter and a delay. This
+is fine on a single thread, but when processing on multiple threads it would have the job reading
+the splitter waiting on its own lock so the attachment that closes the loop needs to be rejected.
+*/
+static ma_result test_node_graph__loop(ma_uint32 jobThreadCount)
+{
+    ma_result result;
+    ma_node_graph_config nodeGraphConfig;
+    ma_node_graph nodeGraph;
+    ma_splitter_node_config splitterConfig;
+    ma_splitter_node splitterNode;
+    ma_lpf_node_config lpfConfig;
+    ma_lpf_node lpfNode;
+    ma_delay_node_config delayConfig;
+    ma_delay_node delayNode;
+    float output[MA_NODE_GRAPH_TEST_FRAME_COUNT * MA_NODE_GRAPH_TEST_CHANNELS];
+    ma_uint64 framesRead;
+
+    printf("    %d threads... ", (int)jobThreadCount);
+
+    nodeGraphConfig = ma_node_graph_config_init(MA_NODE_GRAPH_TEST_CHANNELS);
+    nodeGraphConfig.jobThreadCount = jobThreadCount;
+
+    result = ma_node_graph_init(&nodeGraphConfig, NULL, &nodeGraph);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (failed to initialize graph)\n");
+        return result;
+    }
+
+    splitterConfig = ma_splitter_node_config_init(MA_NODE_GRAPH_TEST_CHANNELS);
+    ma_splitter_node_init(&nodeGraph, &splitterConfig, NULL, &splitterNode);
+
+    lpfConfig = ma_lpf_node_config_init(MA_NODE_GRAPH_TEST_CHANNELS, 48000, 1000, 2);
+    ma_lpf_node_init(&nodeGraph, &lpfConfig, NULL, &lpfNode);
+
+    delayConfig = ma_delay_node_config_init(MA_NODE_GRAPH_TEST_CHANNELS, 48000, 100, 0.5f);
+    ma_delay_node_init(&nodeGraph, &delayConfig, NULL, &delayNode);
+
+    ma_node_attach_output_bus(&splitterNode, 0, ma_node_graph_get_endpoint(&nodeGraph), 0);
+    ma_node_attach_output_bus(&splitterNode, 1, &lpfNode, 0);
+    ma_node_attach_output_bus(&lpfNode, 0, &delayNode, 0);
+
+    result = ma_node_attach_output_bus(&delayNode, 0, &splitterNode, 0);
+    if (jobThreadCount > 0) {
+        if (result != MA_INVALID_OPERATION) {
+            printf("FAILED (loop was not rejected)\n");
+            result = MA_ERROR;
+        } else {
+            result = MA_SUCCESS;
+        }
+    } else {
+        if (result != MA_SUCCESS) {
+            printf("FAILED (loop was rejected)\n");
+        }
+    }
+
+    /* With the loop rejected the delay is left unattached. Either way this should not deadlock. */
+    if (result == MA_SUCCESS) {
+        result = ma_node_graph_read_pcm_frames(&nodeGraph, output, MA_NODE_GRAPH_TEST_FRAME_COUNT, &framesRead);
+        if (result != MA_SUCCESS || framesRead != MA_NODE_GRAPH_TEST_FRAME_COUNT) {
+            printf("FAILED (failed to read from graph)\n");
+            result = MA_ERROR;
+        }
+    }
+
+    ma_delay_node_uninit(&delayNode, NULL);
+    ma_lpf_node_uninit(&lpfNode, NULL);
+    ma_splitter_node_uninit(&splitterNode, NULL);
+    ma_node_graph_uninit(&nodeGraph, NULL);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+/*
+A node that halves the volume of its input. It's flagged as processing at different rates, even
+though it doesn't, so that render plans won't expand it and it'll pull from its inputs itself.
+*/
+static void test_node_graph__half_volume_node_process_pcm_frames(ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut)
+{
+    ma_uint32 frameCount = ma_min(*pFrameCountIn, *pFrameCountOut);
+    ma_uint32 channels = ma_node_get_output_channels(pNode, 0);
+    ma_uint32 iSample;
+
+    for (iSample = 0; iSample < frameCount * channels; iSample += 1) {
+        ppFramesOut[0][iSample] = ppFramesIn[0][iSample] * 0.5f;
+    }
+
+    *pFrameCountIn  = frameCount;
+    *pFrameCountOut = frameCount;
+}
+
+static ma_node_vtable g_test_node_graph__half_volume_node_vtable =
+{
+    test_node_graph__half_volume_node_process_pcm_frames,
+    NULL,
+    1,
+    1,
+    MA_NODE_FLAG_DIFFERENT_PROCESSING_RATES
+};
+
+typedef struct
+{
+    ma_node_graph nodeGraph;
+    ma_waveform waveforms[MA_NODE_GRAPH_TEST_SOURCE_COUNT];
+    ma_data_source_node sourceNodes[MA_NODE_GRAPH_TEST_SOURCE_COUNT];
+    ma_splitter_node splitterNode;
+    ma_lpf_node lpfNode;
+    ma_node_base halfVolumeNode;
+} ma_node_graph_render_plan_test;
+
+static ma_result test_node_graph__render_plan_init(ma_node_graph_render_plan_test* pTest, ma_bool32 useRenderPlan)
+{
+    ma_result result;
+    ma_node_graph_config nodeGraphConfig;
+    ma_splitter_node_config splitterConfig;
+    ma_lpf_node_config lpfConfig;
+    ma_node_config halfVolumeConfig;
+    ma_uint32 channels = MA_NODE_GRAPH_TEST_CHANNELS;
+    ma_uint32 iSource;
+
+    nodeGraphConfig = ma_node_graph_config_init(MA_NODE_GRAPH_TEST_CHANNELS);
+    nodeGraphConfig.nodeCacheCapInFrames = MA_NODE_GRAPH_TEST_FRAME_COUNT;
+    nodeGraphConfig.useRenderPlan        = useRenderPlan;
+
+    result = ma_node_graph_init(&nodeGraphConfig, NULL, &pTest->nodeGraph);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    lpfConfig = ma_lpf_node_config_init(MA_NODE_GRAPH_TEST_CHANNELS, 48000, 1000, 2);
+    result = ma_lpf_node_init(&pTest->nodeGraph, &lpfConfig, NULL, &pTest->lpfNode);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    splitterConfig = ma_splitter_node_config_init(MA_NODE_GRAPH_TEST_CHANNELS);
+    result = ma_splitter_node_init(&pTest->nodeGraph, &splitterConfig, NULL, &pTest->splitterNode);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    halfVolumeConfig = ma_node_config_init();
+    halfVolumeConfig.vtable          = &g_test_node_graph__half_volume_node_vtable;
+    halfVolumeConfig.pInputChannels  = &channels;
+    halfVolumeConfig.pOutputChannels = &channels;
+    result = ma_node_init(&pTest->nodeGraph, &halfVolumeConfig, NULL, &pTest->halfVolumeNode);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    /*
+    Sources 0-3 go through the low pass filter. Sources 4-5 go into the splitter which is attached to
+    both the half volume node and the endpoint. Sources 6-7 go through the half volume node, and the
+    remainder are attached to the endpoint directly.
+    */
+    ma_node_attach_output_bus(&pTest->lpfNode, 0, ma_node_graph_get_endpoint(&pTest->nodeGraph), 0);
+    ma_node_attach_output_bus(&pTest->halfVolumeNode, 0, ma_node_graph_get_endpoint(&pTest->nodeGraph), 0);
+    ma_node_attach_output_bus(&pTest->splitterNode, 0, ma_node_graph_get_endpoint(&pTest->nodeGraph), 0);
+    ma_node_attach_output_bus(&pTest->splitterNode, 1, &pTest->halfVolumeNode, 0);
+
+    for (iSource = 0; iSource < MA_NODE_GRAPH_TEST_SOURCE_COUNT; iSource += 1) {
+        ma_waveform_config waveformConfig;
+        ma_data_source_node_config sourceNodeConfig;
+        ma_node* pTarget;
+
+        waveformConfig = ma_waveform_config_init(ma_format_f32, MA_NODE_GRAPH_TEST_CHANNELS, 48000, (ma_waveform_type)(iSource % 4), 0.05, 55.0 * (iSource + 1));
+        result = ma_waveform_init(&waveformConfig, &pTest->waveforms[iSource]);
+        if (result != MA_SUCCESS) {
+            return result;
+        }
+
+        sourceNodeConfig = ma_data_source_node_config_init(&pTest->waveforms[iSource]);
+        result = ma_data_source_node_init(&pTest->nodeGraph, &sourceNodeConfig, NULL, &pTest->sourceNodes[iSource]);
+        if (result != MA_SUCCESS) {
+            return result;
+        }
+
+        if (iSource < 4) {
+            pTarget = &pTest->lpfNode;
+        } else if (iSource < 6) {
+            pTarget = &pTest->splitterNode;
+        } else if (iSource < 8) {
+            pTarget = &pTest->halfVolumeNode;
+        } else {
+            pTarget = ma_node_graph_get_endpoint(&pTest->nodeGraph);
+        }
+
+        ma_node_attach_output_bus(&pTest->sourceNodes[iSource], 0, pTarget, 0);
+    }
+
+    /* A source that starts part way through. */
+    ma_node_set_state_time(&pTest->sourceNodes[9], ma_node_state_started, MA_NODE_GRAPH_TEST_FRAME_COUNT * 3 + 17);
+
+    return MA_SUCCESS;
+}
+
+static void test_node_graph__render_plan_uninit(ma_node_graph_render_plan_test* pTest)
+{
+    ma_uint32 iSource;
+
+    for (iSource = 0; iSource < MA_NODE_GRAPH_TEST_SOURCE_COUNT; iSource += 1) {
+        ma_data_source_node_uninit(&pTest->sourceNodes[iSource], NULL);
+        ma_waveform_uninit(&pTest->waveforms[iSource]);
+    }
+
+    ma_node_uninit(&pTest->halfVolumeNode, NULL);
+    ma_splitter_node_uninit(&pTest->splitterNode, NULL);
+    ma_lpf_node_uninit(&pTest->lpfNode, NULL);
+    ma_node_graph_uninit(&pTest->nodeGraph, NULL);
+}
+
+static void test_node_graph__render_plan_step(ma_node_graph_render_plan_test* pTest, ma_uint32 iIteration)
+{
+    /* Change things up between reads so we can test that the plan is updated correctly. */
+    switch (iIteration)
+    {
+        case 2:
+        {
+            /* A stopped node shouldn't be advancing its inputs. */
+            ma_node_set_state(&pTest->lpfNode, ma_node_state_stopped);
+        } break;
+
+        case 4:
+        {
+            ma_node_set_state(&pTest->lpfNode, ma_node_state_started);
+        } break;
+
+        case 5:
+        {
+            ma_node_detach_output_bus(&pTest->sourceNodes[10], 0);
+            ma_node_attach_output_bus(&pTest->sourceNodes[11], 0, &pTest->lpfNode, 0);
+        } break;
+
+        case 6:
+        {
+            ma_node_detach_output_bus(&pTest->lpfNode, 0);
+            ma_node_set_output_bus_volume(&pTest->sourceNodes[12], 0, 0.25f);
+        } break;
+
+        default: break;
+    }
+}
+
+static ma_node_graph_render_plan_test g_NodeGraphRenderPlanTestReference;
+static ma_node_graph_render_plan_test g_NodeGraphRenderPlanTest;
+
+static ma_result test_node_graph__render_plan(void)
+{
+    ma_result result;
+    float output[MA_NODE_GRAPH_TEST_FRAME_COUNT * MA_NODE_GRAPH_TEST_CHANNELS];
+    float outputReference[MA_NODE_GRAPH_TEST_FRAME_COUNT * MA_NODE_GRAPH_TEST_CHANNELS];
+    ma_uint32 iIteration;
+    ma_uint32 iSample;
+
+    printf("    render plan... ");
+
+    result = test_node_graph__render_plan_init(&g_NodeGraphRenderPlanTestReference, MA_FALSE);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (failed to initialize reference graph)\n");
+        return result;
+    }
+
+    result = test_node_graph__render_plan_init(&g_NodeGraphRenderPlanTest, MA_TRUE);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (failed to initialize graph)\n");
+        test_node_graph__render_plan_uninit(&g_NodeGraphRenderPlanTestReference);
+        return result;
+    }
+
+    for (iIteration = 0; iIteration < MA_NODE_GRAPH_TEST_ITERATIONS; iIteration += 1) {
+        /* Odd frame counts so blocks don't always line up with the node cache. */
+        ma_uint32 frameCount = MA_NODE_GRAPH_TEST_FRAME_COUNT - (iIteration * 37);
+
+        test_node_graph__render_plan_step(&g_NodeGraphRenderPlanTestReference, iIteration);
+        test_node_graph__render_plan_step(&g_NodeGraphRenderPlanTest, iIteration);
+
+        ma_node_graph_read_pcm_frames(&g_NodeGraphRenderPlanTestReference.nodeGraph, outputReference, frameCount, NULL);
+        ma_node_graph_read_pcm_frames(&g_NodeGraphRenderPlanTest.nodeGraph, output, frameCount, NULL);
+
+        for (iSample = 0; iSample < frameCount * MA_NODE_GRAPH_TEST_CHANNELS; iSample += 1) {
+            if (output[iSample] != outputReference[iSample]) {
+                printf("FAILED (iteration %d, sample %d: %f != %f)\n", (int)iIteration, (int)iSample, output[iSample], outputReference[iSample]);
+                result = MA_ERROR;
+                break;
+            }
+        }
+
+        if (result != MA_SUCCESS) {
+            break;
+        }
+    }
+
+    test_node_graph__render_plan_uninit(&g_NodeGraphRenderPlanTest);
+    test_node_graph__render_plan_uninit(&g_NodeGraphRenderPlanTestReference);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+/*
+Attachments are changed and nodes uninitialized while another thread reads from the graph without
+pausing. Each change needs to wait for the reader to be done with the old render plan, but it must
+not have to wait for a moment where nobody is reading.
+*/
+#define MA_NODE_GRAPH_TEST_RENDER_PLAN_SWAP_COUNT   50
+
+typedef struct
+{
+    ma_node_graph* pNodeGraph;
+    MA_ATOMIC(4, ma_bool32) isStopping;
+    MA_ATOMIC(4, ma_uint32) readCount;
+} ma_node_graph_render_plan_reader;
+
+static ma_thread_result MA_THREADCALL test_node_graph__render_plan_reader_thread(void* pUserData)
+{
+    ma_node_graph_render_plan_reader* pReader = (ma_node_graph_render_plan_reader*)pUserData;
+    float output[MA_NODE_GRAPH_TEST_FRAME_COUNT * MA_NODE_GRAPH_TEST_CHANNELS];
+
+    while (ma_atomic_load_32(&pReader->isStopping) == MA_FALSE) {
+        ma_node_graph_read_pcm_frames(pReader->pNodeGraph, output, MA_NODE_GRAPH_TEST_FRAME_COUNT, NULL);
+        ma_atomic_fetch_add_32(&pReader->readCount, 1);
+    }
+
+    return (ma_thread_result)0;
+}
+
+static ma_result test_node_graph__render_plan_swap(void)
+{
+    ma_result result;
+    ma_node_graph_config nodeGraphConfig;
+    ma_node_graph nodeGraph;
+    ma_node_graph_render_plan_reader reader;
+    ma_thread thread;
+    ma_waveform waveform;
+    ma_waveform_config waveformConfig;
+    ma_data_source_node sourceNode;
+    ma_data_source_node_config sourceNodeConfig;
+    ma_lpf_node lpfNode;
+    ma_lpf_node_config lpfNodeConfig;
+    ma_uint32 iSwap;
+
+    printf("    swapping while reading... ");
+
+    nodeGraphConfig = ma_node_graph_config_init(MA_NODE_GRAPH_TEST_CHANNELS);
+    nodeGraphConfig.nodeCacheCapInFrames = MA_NODE_GRAPH_TEST_FRAME_COUNT;
+    nodeGraphConfig.useRenderPlan        = MA_TRUE;
+
+    result = ma_node_graph_init(&nodeGraphConfig, NULL, &nodeGraph);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_node_graph_init)\n");
+        return result;
+    }
+
+    waveformConfig = ma_waveform_config_init(ma_format_f32, MA_NODE_GRAPH_TEST_CHANNELS, 48000, ma_waveform_type_sine, 0.1, 440);
+    ma_waveform_init(&waveformConfig, &waveform);
+
+    reader.pNodeGraph = &nodeGraph;
+    reader.isStopping = MA_FALSE;
+    reader.readCount  = 0;
+
+    result = ma_thread_create(&thread, ma_thread_priority_default, 0, test_node_graph__render_plan_reader_thread, &reader, NULL);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_thread_create)\n");
+        ma_node_graph_uninit(&nodeGraph, NULL);
+        return result;
+    }
+
+    for (iSwap = 0; iSwap < MA_NODE_GRAPH_TEST_RENDER_PLAN_SWAP_COUNT && result == MA_SUCCESS; iSwap += 1) {
+        ma_uint32 readCount;
+
+        sourceNodeConfig = ma_data_source_node_config_init(&waveform);
+        result = ma_data_source_node_init(&nodeGraph, &sourceNodeConfig, NULL, &sourceNode);
+        if (result != MA_SUCCESS) {
+            break;
+        }
+
+        lpfNodeConfig = ma_lpf_node_config_init(MA_NODE_GRAPH_TEST_CHANNELS, 48000, 1000, 2);
+        result = ma_lpf_node_init(&nodeGraph, &lpfNodeConfig, NULL, &lpfNode);
+        if (result != MA_SUCCESS) {
+            ma_data_source_node_uninit(&sourceNode, NULL);
+            break;
+        }
+
+        ma_node_attach_output_bus(&lpfNode, 0, ma_node_graph_get_endpoint(&nodeGraph), 0);
+        ma_node_attach_output_bus(&sourceNode, 0, &lpfNode, 0);
+
+        /* Make sure the new plan has been used before tearing it down again. */
+        readCount = ma_atomic_load_32(&reader.readCount);
+        while (ma_atomic_load_32(&reader.readCount) - readCount < 2) {
+            ma_yield();
+        }
+
+        ma_data_source_node_uninit(&sourceNode, NULL);
+        ma_lpf_node_uninit(&lpfNode, NULL);
+
+        /* Anything still referencing the uninitialized nodes should trip up. */
+        MA_ZERO_OBJECT(&sourceNode);
+        MA_ZERO_OBJECT(&lpfNode);
+    }
+
+    ma_atomic_exchange_32(&reader.isStopping, MA_TRUE);
+    ma_thread_wait(&thread);
+
+    ma_node_graph_uninit(&nodeGraph, NULL);
+
+    if (result != MA_SUCCESS) {
+        printf("FAILED (failed to initialize nodes)\n");
+        return result;
+    }
+
+    printf("PASSED\n");
+    return MA_SUCCESS;
+}
+
+/*
+Nodes for testing planar processing. The same callbacks are used by the planar and interleaved
+versions of each node so that the output of a graph can be compared against the same graph with
+everything interleaved. The gain depends on the channel so that mixed up channels will be noticed.
+*/
+#define MA_NODE_GRAPH_TEST_PLANAR_MAX_CHANNELS  8
+#define MA_NODE_GRAPH_TEST_PLANAR_FRAME_COUNT   320
+
+static ma_uint32 test_node_graph__planar_sample_index(const ma_node* pNode, ma_uint32 iFrame, ma_uint32 iChannel)
+{
+    ma_uint32 planarStride = ma_node_get_planar_stride(pNode);
+
+    if (planarStride == 0) {
+        return (iFrame * ma_node_get_output_channels(pNode, 0)) + iChannel;
+    } else {
+        return (iChannel * planarStride) + iFrame;
+    }
+}
+
+static void test_node_graph__gain_node_process_pcm_frames(ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut)
+{
+    ma_uint32 frameCount = ma_min(*pFrameCountIn, *pFrameCountOut);
+    ma_uint32 channels = ma_node_get_output_channels(pNode, 0);
+    ma_uint32 iFrame;
+    ma_uint32 iChannel;
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            ma_uint32 iSample = test_node_graph__planar_sample_index(pNode, iFrame, iChannel);
+            ppFramesOut[0][iSample] = ppFramesIn[0][iSample] * (0.25f * (iChannel + 1));
+        }
+    }
+
+    *pFrameCountIn  = frameCount;
+    *pFrameCountOut = frameCount;
+}
+
+/* A node with no inputs that outputs a different ramp on each channel. */
+typedef struct
+{
+    ma_node_base base;
+    ma_uint32 cursor;
+} ma_node_graph_test_ramp_node;
+
+static void test_node_graph__ramp_node_process_pcm_frames(ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut)
+{
+    ma_node_graph_test_ramp_node* pRampNode = (ma_node_graph_test_ramp_node*)pNode;
+    ma_uint32 channels = ma_node_get_output_channels(pNode, 0);
+    ma_uint32 iFrame;
+    ma_uint32 iChannel;
+
+    (void)ppFramesIn;
+    (void)pFrameCountIn;
+
+    for (iFrame = 0; iFrame < *pFrameCountOut; iFrame += 1) {
+        for (iChannel = 0; iChannel < channels; iChannel += 1) {
+            ppFramesOut[0][test_node_graph__planar_sample_index(pNode, iFrame, iChannel)] = (float)((pRampNode->cursor + iFrame) % 100) * 0.001f * (iChannel + 1);
+        }
+    }
+
+    pRampNode->cursor += *pFrameCountOut;
+}
+
+static ma_node_vtable g_test_node_graph__gain_node_vtable =
+{
+    test_node_graph__gain_node_process_pcm_frames,
+    NULL,
+    1,
+    1,
+    0
+};
+
+static ma_node_vtable g_test_node_graph__gain_node_vtable_planar =
+{
+    test_node_graph__gain_node_process_pcm_frames,
+    NULL,
+    1,
+    1,
+    MA_NODE_FLAG_PLANAR
+};
+
+static ma_node_vtable g_test_node_graph__ramp_node_vtable =
+{
+    test_node_graph__ramp_node_process_pcm_frames,
+    NULL,
+    0,
+    1,
+    0
+};
+
+static ma_node_vtable g_test_node_graph__ramp_node_vtable_planar =
+{
+    test_node_graph__ramp_node_process_pcm_frames,
+    NULL,
+    0,
+    1,
+    MA_NODE_FLAG_PLANAR
+};
+
+typedef struct
+{
+    ma_node_graph nodeGraph;
+    ma_waveform waveforms[4];
+    ma_data_source_node sourceNodes[4];
+    ma_node_graph_test_ramp_node rampNode;
+    ma_node_base gainNodes[3];
+    ma_splitter_node splitterNode;
+} ma_node_graph_planar_test;
+
+static ma_result test_node_graph__planar_init(ma_node_graph_planar_test* pTest, ma_uint32 channels, ma_bool32 isPlanar, ma_bool32 useRenderPlan)
+{
+    ma_result result;
+    ma_node_graph_config nodeGraphConfig;
+    ma_splitter_node_config splitterConfig;
+    ma_node_config nodeConfig;
+    ma_uint32 iNode;
+
+    nodeGraphConfig = ma_node_graph_config_init(channels);
+    nodeGraphConfig.nodeCacheCapInFrames = MA_NODE_GRAPH_TEST_PLANAR_FRAME_COUNT;
+    nodeGraphConfig.useRenderPlan        = useRenderPlan;
+
+    result = ma_node_graph_init(&nodeGraphConfig, NULL, &pTest->nodeGraph);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    nodeConfig = ma_node_config_init();
+    nodeConfig.vtable          = (isPlanar) ? &g_test_node_graph__gain_node_vtable_planar : &g_test_node_graph__gain_node_vtable;
+    nodeConfig.pInputChannels  = &channels;
+    nodeConfig.pOutputChannels = &channels;
+
+    for (iNode = 0; iNode < ma_countof(pTest->gainNodes); iNode += 1) {
+        result = ma_node_init(&pTest->nodeGraph, &nodeConfig, NULL, &pTest->gainNodes[iNode]);
+        if (result != MA_SUCCESS) {
+            return result;
+        }
+    }
+
+    nodeConfig.vtable = (isPlanar) ? &g_test_node_graph__ramp_node_vtable_planar : &g_test_node_graph__ramp_node_vtable;
+    pTest->rampNode.cursor = 0;
+    result = ma_node_init(&pTest->nodeGraph, &nodeConfig, NULL, &pTest->rampNode);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    splitterConfig = ma_splitter_node_config_init(channels);
+    result = ma_splitter_node_init(&pTest->nodeGraph, &splitterConfig, NULL, &pTest->splitterNode);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    /*
+    Sources 0-2 and the ramp go into gain node 0 which goes into gain node 1, along with source 3.
+    Gain node 1 goes into the splitter which is attached to both the endpoint and gain node 2, which
+    is attached to the endpoint. With planar gain nodes this covers planar to planar, interleaved to
+    planar and planar to interleaved links.
+    */
+    for (iNode = 0; iNode < ma_countof(pTest->sourceNodes); iNode += 1) {
+        ma_waveform_config waveformConfig;
+        ma_data_source_node_config sourceNodeConfig;
+
+        waveformConfig = ma_waveform_config_init(ma_format_f32, channels, 48000, (ma_waveform_type)(iNode % 4), 0.1, 110.0 * (iNode + 1));
+        result = ma_waveform_init(&waveformConfig, &pTest->waveforms[iNode]);
+        if (result != MA_SUCCESS) {
+            return result;
+        }
+
+        sourceNodeConfig = ma_data_source_node_config_init(&pTest->waveforms[iNode]);
+        result = ma_data_source_node_init(&pTest->nodeGraph, &sourceNodeConfig, NULL, &pTest->sourceNodes[iNode]);
+        if (result != MA_SUCCESS) {
+            return result;
+        }
+
+        ma_node_attach_output_bus(&pTest->sourceNodes[iNode], 0, (iNode < 3) ? &pTest->gainNodes[0] : &pTest->gainNodes[1], 0);
+    }
+
+    ma_node_attach_output_bus(&pTest->rampNode, 0, &pTest->gainNodes[0], 0);
+    ma_node_attach_output_bus(&pTest->gainNodes[0], 0, &pTest->gainNodes[1], 0);
+    ma_node_attach_output_bus(&pTest->gainNodes[1], 0, &pTest->splitterNode, 0);
+    ma_node_attach_output_bus(&pTest->splitterNode, 0, ma_node_graph_get_endpoint(&pTest->nodeGraph), 0);
+    ma_node_attach_output_bus(&pTest->splitterNode, 1, &pTest->gainNodes[2], 0);
+    ma_node_attach_output_bus(&pTest->gainNodes[2], 0, ma_node_graph_get_endpoint(&pTest->nodeGraph), 0);
+
+    /* Volume needs to be applied to planar output, and a node that starts part way through needs the start of its planar output silenced. */
+    ma_node_set_output_bus_volume(&pTest->gainNodes[0], 0, 0.75f);
+    ma_node_set_state_time(&pTest->rampNode, ma_node_state_started, MA_NODE_GRAPH_TEST_PLANAR_FRAME_COUNT * 2 + 29);
+
+    return MA_SUCCESS;
+}
+
+static void test_node_graph__planar_uninit(ma_node_graph_planar_test* pTest)
+{
+    ma_uint32 iNode;
+
+    for (iNode = 0; iNode < ma_countof(pTest->sourceNodes); iNode += 1) {
+        ma_data_source_node_uninit(&pTest->sourceNodes[iNode], NULL);
+        ma_waveform_uninit(&pTest->waveforms[iNode]);
+    }
+
+    for (iNode = 0; iNode < ma_countof(pTest->gainNodes); iNode += 1) {
+        ma_node_uninit(&pTest->gainNodes[iNode], NULL);
+    }
+
+    ma_node_uninit(&pTest->rampNode, NULL);
+    ma_splitter_node_uninit(&pTest->splitterNode, NULL);
+    ma_node_graph_uninit(&pTest->nodeGraph, NULL);
+}
+
+static ma_node_graph_planar_test g_NodeGraphPlanarTestReference;
+static ma_node_graph_planar_test g_NodeGraphPlanarTest;
+
+static ma_result test_node_graph__planar(ma_uint32 channels, ma_bool32 useRenderPlan)
+{
+    ma_result result;
+    float output[MA_NODE_GRAPH_TEST_PLANAR_FRAME_COUNT * MA_NODE_GRAPH_TEST_PLANAR_MAX_CHANNELS];
+    float outputReference[MA_NODE_GRAPH_TEST_PLANAR_FRAME_COUNT * MA_NODE_GRAPH_TEST_PLANAR_MAX_CHANNELS];
+    ma_uint32 iIteration;
+    ma_uint32 iSample;
+
+    MA_ASSERT(channels <= MA_NODE_GRAPH_TEST_PLANAR_MAX_CHANNELS);
+
+    printf("    %d channels, %s... ", (int)channels, (useRenderPlan) ? "with render plan" : "without render plan");
+
+    result = test_node_graph__planar_init(&g_NodeGraphPlanarTestReference, channels, MA_FALSE, useRenderPlan);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (failed to initialize reference graph)\n");
+        return result;
+    }
+
+    result = test_node_graph__planar_init(&g_NodeGraphPlanarTest, channels, MA_TRUE, useRenderPlan);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (failed to initialize graph)\n");
+        test_node_graph__planar_uninit(&g_NodeGraphPlanarTestReference);
+        return result;
+    }
+
+    for (iIteration = 0; iIteration < MA_NODE_GRAPH_TEST_ITERATIONS; iIteration += 1) {
+        /* Odd frame counts so blocks don't always line up with the node cache. */
+        ma_uint32 frameCount = MA_NODE_GRAPH_TEST_PLANAR_FRAME_COUNT - (iIteration * 37);
+
+        ma_node_graph_read_pcm_frames(&g_NodeGraphPlanarTestReference.nodeGraph, outputReference, frameCount, NULL);
+        ma_node_graph_read_pcm_frames(&g_NodeGraphPlanarTest.nodeGraph, output, frameCount, NULL);
+
+        for (iSample = 0; iSample < frameCount * channels; iSample += 1) {
+            if (output[iSample] != outputReference[iSample]) {
+                printf("FAILED (iteration %d, sample %d: %f != %f)\n", (int)iIteration, (int)iSample, output[iSample], outputReference[iSample]);
+                result = MA_ERROR;
+                break;
+            }
+        }
+
+        if (result != MA_SUCCESS) {
+            break;
+        }
+    }
+
+    test_node_graph__planar_uninit(&g_NodeGraphPlanarTest);
+    test_node_graph__planar_uninit(&g_NodeGraphPlanarTestReference);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+/* A node that counts the number of times its processing callback is fired. */
+typedef struct
+{
+    ma_node_base base;
+    ma_uint32 processCount;
+} ma_node_graph_test_counting_node;
+
+static void test_node_graph__counting_node_process_pcm_frames(ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut)
+{
+    ((ma_node_graph_test_counting_node*)pNode)->processCount += 1;
+    test_node_graph__half_volume_node_process_pcm_frames(pNode, ppFramesIn, pFrameCountIn, ppFramesOut, pFrameCountOut);
+}
+
+static ma_node_vtable g_test_node_graph__counting_node_vtable =
+{
+    test_node_graph__counting_node_process_pcm_frames,
+    NULL,
+    1,
+    1,
+    0
+};
+
+static ma_bool32 test_node_graph__is_silent(const float* pFrames, ma_uint32 frameCount)
+{
+    ma_uint32 iSample;
+
+    for (iSample = 0; iSample < frameCount * MA_NODE_GRAPH_TEST_CHANNELS; iSample += 1) {
+        if (pFrames[iSample] != 0) {
+            return MA_FALSE;
+        }
+    }
+
+    return MA_TRUE;
+}
+
+static ma_result test_node_graph__silence(ma_bool32 useRenderPlan)
+{
+    ma_result result;
+    ma_node_graph nodeGraph;
+    ma_node_graph_config nodeGraphConfig;
+    ma_waveform waveform;
+    ma_waveform_config waveformConfig;
+    ma_data_source_node sourceNode;
+    ma_data_source_node_config sourceNodeConfig;
+    ma_node_graph_test_counting_node countingNode;
+    ma_node_config countingNodeConfig;
+    ma_uint32 channels = MA_NODE_GRAPH_TEST_CHANNELS;
+    float output[MA_NODE_GRAPH_TEST_FRAME_COUNT * MA_NODE_GRAPH_TEST_CHANNELS];
+    ma_uint32 iIteration;
+
+    /* The expected state after each read. The source is stopped before iteration 1 and started again before iteration 4. */
+    const ma_uint32 expectedProcessCounts[] = {1, 2, 3, 3, 4, 5};
+    const ma_bool32 expectedSilence[]       = {MA_FALSE, MA_TRUE, MA_TRUE, MA_TRUE, MA_FALSE, MA_FALSE};
+
+    printf("    %s... ", (useRenderPlan) ? "with render plan" : "without render plan");
+
+    nodeGraphConfig = ma_node_graph_config_init(MA_NODE_GRAPH_TEST_CHANNELS);
+    nodeGraphConfig.nodeCacheCapInFrames = MA_NODE_GRAPH_TEST_FRAME_COUNT;
+    nodeGraphConfig.useRenderPlan        = useRenderPlan;
+
+    result = ma_node_graph_init(&nodeGraphConfig, NULL, &nodeGraph);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_node_graph_init)\n");
+        return result;
+    }
+
+    waveformConfig = ma_waveform_config_init(ma_format_f32, MA_NODE_GRAPH_TEST_CHANNELS, 48000, ma_waveform_type_sine, 0.5, 440);
+    ma_waveform_init(&waveformConfig, &waveform);
+
+    sourceNodeConfig = ma_data_source_node_config_init(&waveform);
+    ma_data_source_node_init(&nodeGraph, &sourceNodeConfig, NULL, &sourceNode);
+
+    /* The output of the node should become silent two reads after its input becomes silent. */
+    countingNodeConfig = ma_node_config_init();
+    countingNodeConfig.vtable             = &g_test_node_graph__counting_node_vtable;
+    countingNodeConfig.pInputChannels     = &channels;
+    countingNodeConfig.pOutputChannels    = &channels;
+    countingNodeConfig.tailLengthInFrames = MA_NODE_GRAPH_TEST_FRAME_COUNT * 2;
+    countingNode.processCount = 0;
+    ma_node_init(&nodeGraph, &countingNodeConfig, NULL, &countingNode);
+
+    ma_node_attach_output_bus(&sourceNode, 0, &countingNode, 0);
+    ma_node_attach_output_bus(&countingNode, 0, ma_node_graph_get_endpoint(&nodeGraph), 0);
+
+    for (iIteration = 0; iIteration < ma_countof(expectedProcessCounts); iIteration += 1) {
+        if (iIteration == 1) {
+            ma_node_set_state(&sourceNode, ma_node_state_stopped);
+        }
+        if (iIteration == 4) {
+            ma_node_set_state(&sourceNode, ma_node_state_started);
+        }
+
+        ma_node_graph_read_pcm_frames(&nodeGraph, output, MA_NODE_GRAPH_TEST_FRAME_COUNT, NULL);
+
+        if (countingNode.processCount != expectedProcessCounts[iIteration]) {
+            printf("FAILED (iteration %d: processed %d times, expecting %d)\n", (int)iIteration, (int)countingNode.processCount, (int)expectedProcessCounts[iIteration]);
+            result = MA_ERROR;
+            break;
+        }
+
+        if (test_node_graph__is_silent(output, MA_NODE_GRAPH_TEST_FRAME_COUNT) != expectedSilence[iIteration]) {
+            printf("FAILED (iteration %d: unexpected output)\n", (int)iIteration);
+            result = MA_ERROR;
+            break;
+        }
+
+        /* The node is only flagged as silent when it's known to be silent, which is only the case once processing has been skipped. */
+        if (ma_node_is_output_silent(&countingNode, 0) != (iIteration == 3)) {
+            printf("FAILED (iteration %d: incorrect silence flag)\n", (int)iIteration);
+            result = MA_ERROR;
+            break;
+        }
+    }
+
+    /* With an infinite tail, processing should never be skipped. */
+    if (result == MA_SUCCESS) {
+        ma_node_set_tail_length(&countingNode, MA_NODE_TAIL_LENGTH_INFINITE);
+        ma_node_set_state(&sourceNode, ma_node_state_stopped);
+
+        for (iIteration = 0; iIteration < 4; iIteration += 1) {
+            ma_node_graph_read_pcm_frames(&nodeGraph, output, MA_NODE_GRAPH_TEST_FRAME_COUNT, NULL);
+        }
+
+        if (countingNode.processCount != expectedProcessCounts[ma_countof(expectedProcessCounts) - 1] + 4) {
+            printf("FAILED (node was skipped with an infinite tail)\n");
+            result = MA_ERROR;
+        }
+    }
+
+    ma_data_source_node_uninit(&sourceNode, NULL);
+    ma_node_uninit(&countingNode, NULL);
+    ma_waveform_uninit(&waveform);
+    ma_node_graph_uninit(&nodeGraph, NULL);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+static ma_result test_node_graph__silence_default_tails(void)
+{
+    ma_result result = MA_SUCCESS;
+    ma_node_graph nodeGraph;
+    ma_node_graph_config nodeGraphConfig;
+    ma_delay_node delayNode;
+    ma_delay_node_config delayNodeConfig;
+    ma_lpf_node lpfNode;
+    ma_lpf_node_config lpfNodeConfig;
+    ma_uint32 tailLength;
+    float output[MA_NODE_GRAPH_TEST_FRAME_COUNT * MA_NODE_GRAPH_TEST_CHANNELS];
+    ma_uint32 iIteration;
+
+    printf("    default tails... ");
+
+    nodeGraphConfig = ma_node_graph_config_init(MA_NODE_GRAPH_TEST_CHANNELS);
+    nodeGraphConfig.nodeCacheCapInFrames = MA_NODE_GRAPH_TEST_FRAME_COUNT;
+
+    result = ma_node_graph_init(&nodeGraphConfig, NULL, &nodeGraph);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_node_graph_init)\n");
+        return result;
+    }
+
+    /* The delay node uses continuous processing. With nothing attached it should still be skipped once the echoes have died away. */
+    delayNodeConfig = ma_delay_node_config_init(MA_NODE_GRAPH_TEST_CHANNELS, 48000, 64, 0.5f);
+    ma_delay_node_init(&nodeGraph, &delayNodeConfig, NULL, &delayNode);
+    ma_node_attach_output_bus(&delayNode, 0, ma_node_graph_get_endpoint(&nodeGraph), 0);
+
+    tailLength = ma_node_get_tail_length(&delayNode);
+    if (tailLength == MA_NODE_TAIL_LENGTH_INFINITE || tailLength < 64 * 20) {
+        printf("FAILED (delay tail of %u frames)\n", (unsigned int)tailLength);
+        result = MA_ERROR;
+    }
+
+    for (iIteration = 0; result == MA_SUCCESS && iIteration < tailLength / MA_NODE_GRAPH_TEST_FRAME_COUNT + 2; iIteration += 1) {
+        ma_node_graph_read_pcm_frames(&nodeGraph, output, MA_NODE_GRAPH_TEST_FRAME_COUNT, NULL);
+    }
+
+    if (result == MA_SUCCESS && ma_node_is_output_silent(&delayNode, 0) == MA_FALSE) {
+        printf("FAILED (delay node with nothing attached was never skipped)\n");
+        result = MA_ERROR;
+    }
+
+    /* More feedback means a longer tail. */
+    if (result == MA_SUCCESS) {
+        ma_delay_node_set_decay(&delayNode, 0.9f);
+        if (ma_node_get_tail_length(&delayNode) <= tailLength) {
+            printf("FAILED (delay tail was not updated with the decay)\n");
+            result = MA_ERROR;
+        }
+    }
+
+    /* A lower cutoff rings for longer, but a tail that's been set explicitly should be left alone. */
+    if (result == MA_SUCCESS) {
+        lpfNodeConfig = ma_lpf_node_config_init(MA_NODE_GRAPH_TEST_CHANNELS, 48000, 1000, 4);
+        ma_lpf_node_init(&nodeGraph, &lpfNodeConfig, NULL, &lpfNode);
+
+        tailLength = ma_node_get_tail_length(&lpfNode);
+        if (tailLength == MA_NODE_TAIL_LENGTH_INFINITE || tailLength == 0 || tailLength > 48000) {
+            printf("FAILED (low-pass tail of %u frames)\n", (unsigned int)tailLength);
+            result = MA_ERROR;
+        }
+
+        if (result == MA_SUCCESS) {
+            lpfNodeConfig.lpf.cutoffFrequency = 100;
+            ma_lpf_node_reinit(&lpfNodeConfig.lpf, &lpfNode);
+            if (ma_node_get_tail_length(&lpfNode) <= tailLength) {
+                printf("FAILED (low-pass tail was not updated after reinitializing)\n");
+                result = MA_ERROR;
+            }
+        }
+
+        if (result == MA_SUCCESS) {
+            ma_node_set_tail_length(&lpfNode, 1234);
+            lpfNodeConfig.lpf.cutoffFrequency = 2000;
+            ma_lpf_node_reinit(&lpfNodeConfig.lpf, &lpfNode);
+            if (ma_node_get_tail_length(&lpfNode) != 1234) {
+                printf("FAILED (explicit tail was overwritten)\n");
+                result = MA_ERROR;
+            }
+        }
+
+        ma_lpf_node_uninit(&lpfNode, NULL);
+    }
+
+    ma_delay_node_uninit(&delayNode, NULL);
+    ma_node_graph_uninit(&nodeGraph, NULL);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+static ma_result test_node_graph__profiling(void)
+{
+    ma_result result = MA_SUCCESS;
+    ma_node_graph nodeGraph;
+    ma_node_graph_config nodeGraphConfig;
+    ma_waveform waveform;
+    ma_waveform_config waveformConfig;
+    ma_data_source_node sourceNode;
+    ma_data_source_node_config sourceNodeConfig;
+    ma_node_graph_test_counting_node countingNode;
+    ma_node_config countingNodeConfig;
+    ma_uint32 channels = MA_NODE_GRAPH_TEST_CHANNELS;
+    float output[MA_NODE_GRAPH_TEST_FRAME_COUNT * MA_NODE_GRAPH_TEST_CHANNELS];
+    ma_node_profile profile;
+    ma_node_output_bus_profile outputBusProfile;
+    char smallJSON[16];
+    char* pJSON;
+    size_t jsonLength;
+    ma_uint32 iIteration;
+
+    printf("    profiling... ");
+
+    nodeGraphConfig = ma_node_graph_config_init(MA_NODE_GRAPH_TEST_CHANNELS);
+    nodeGraphConfig.nodeCacheCapInFrames = MA_NODE_GRAPH_TEST_FRAME_COUNT;
+
+    result = ma_node_graph_init(&nodeGraphConfig, NULL, &nodeGraph);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_node_graph_init)\n");
+        return result;
+    }
+
+    waveformConfig = ma_waveform_config_init(ma_format_f32, MA_NODE_GRAPH_TEST_CHANNELS, 48000, ma_waveform_type_sine, 0.5, 440);
+    ma_waveform_init(&waveformConfig, &waveform);
+
+    sourceNodeConfig = ma_data_source_node_config_init(&waveform);
+    ma_data_source_node_init(&nodeGraph, &sourceNodeConfig, NULL, &sourceNode);
+
+    countingNodeConfig = ma_node_config_init();
+    countingNodeConfig.vtable          = &g_test_node_graph__counting_node_vtable;
+    countingNodeConfig.pInputChannels  = &channels;
+    countingNodeConfig.pOutputChannels = &channels;
+    countingNode.processCount = 0;
+    ma_node_init(&nodeGraph, &countingNodeConfig, NULL, &countingNode);
+
+    ma_node_attach_output_bus(&sourceNode, 0, &countingNode, 0);
+    ma_node_attach_output_bus(&countingNode, 0, ma_node_graph_get_endpoint(&nodeGraph), 0);
+
+    /* Nothing should be recorded until profiling is enabled. */
+    ma_node_graph_read_pcm_frames(&nodeGraph, output, MA_NODE_GRAPH_TEST_FRAME_COUNT, NULL);
+
+    ma_node_get_profile(&countingNode, &profile);
+    if (profile.processCallCount != 0) {
+        printf("FAILED (profile recorded while disabled)\n");
+        result = MA_ERROR;
+    }
+
+    if (result == MA_SUCCESS) {
+        ma_node_graph_set_profiling_enabled(&nodeGraph, MA_TRUE);
+
+        for (iIteration = 0; iIteration < MA_NODE_GRAPH_TEST_ITERATIONS; iIteration += 1) {
+            ma_node_graph_read_pcm_frames(&nodeGraph, output, MA_NODE_GRAPH_TEST_FRAME_COUNT, NULL);
+        }
+
+        ma_node_get_profile(&countingNode, &profile);
+        if (profile.processCallCount != countingNode.processCount - 1 || profile.framesProcessedIn != MA_NODE_GRAPH_TEST_ITERATIONS * MA_NODE_GRAPH_TEST_FRAME_COUNT || profile.framesProcessedOut != MA_NODE_GRAPH_TEST_ITERATIONS * MA_NODE_GRAPH_TEST_FRAME_COUNT) {
+            printf("FAILED (incorrect node profile)\n");
+            result = MA_ERROR;
+        }
+
+        if (profile.maxProcessTimeInNanoseconds > profile.processTimeInNanoseconds) {
+            printf("FAILED (incorrect processing time)\n");
+            result = MA_ERROR;
+        }
+    }
+
+    if (result == MA_SUCCESS) {
+        ma_node_get_output_bus_profile(&sourceNode, 0, &outputBusProfile);
+        if (outputBusProfile.readCount != MA_NODE_GRAPH_TEST_ITERATIONS || outputBusProfile.framesRead != MA_NODE_GRAPH_TEST_ITERATIONS * MA_NODE_GRAPH_TEST_FRAME_COUNT) {
+            printf("FAILED (incorrect output bus profile)\n");
+            result = MA_ERROR;
+        }
+    }
+
+    /* JSON. The source, the counting node and the endpoint should be written in that order. */
+    if (result == MA_SUCCESS) {
+        ma_node_graph_get_profile_json(&nodeGraph, NULL, 0, &jsonLength);
+
+        if (ma_node_graph_get_profile_json(&nodeGraph, smallJSON, sizeof(smallJSON), NULL) != MA_NO_SPACE || strlen(smallJSON) != sizeof(smallJSON) - 1) {
+            printf("FAILED (JSON was not truncated)\n");
+            result = MA_ERROR;
+        }
+
+        pJSON = (char*)ma_malloc(jsonLength + 1, NULL);
+        if (pJSON != NULL) {
+            if (ma_node_graph_get_profile_json(&nodeGraph, pJSON, jsonLength + 1, NULL) != MA_SUCCESS || strlen(pJSON) != jsonLength) {
+                printf("FAILED (failed to retrieve JSON)\n");
+                result = MA_ERROR;
+            } else if (strstr(pJSON, "{\"id\": 2,") == NULL || strstr(pJSON, "\"id\": 3") != NULL || strstr(pJSON, "\"endpoint\": 2") == NULL || strstr(pJSON, "{\"inputBus\": 0, \"node\": 0, \"outputBus\": 0}") == NULL) {
+                printf("FAILED (unexpected JSON)\n%s\n", pJSON);
+                result = MA_ERROR;
+            }
+
+            ma_free(pJSON, NULL);
+        }
+    }
+
+    ma_data_source_node_uninit(&sourceNode, NULL);
+    ma_node_uninit(&countingNode, NULL);
+    ma_waveform_uninit(&waveform);
+    ma_node_graph_uninit(&nodeGraph, NULL);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+#define MA_NODE_GRAPH_TEST_OFFLINE_FRAME_COUNT  10007   /* Odd on purpose so the last block is partial. */
+
+typedef struct
+{
+    ma_waveform waveform;       /* For generating the expected output. */
+    ma_uint64 framesReceived;
+    ma_uint64 abortAfterFrameCount;
+    ma_bool32 isMismatched;
+} ma_node_graph_test_offline_output;
+
+static ma_result test_node_graph__offline_on_output(void* pUserData, const float* pFrames, ma_uint64 frameCount)
+{
+    ma_node_graph_test_offline_output* pOutput = (ma_node_graph_test_offline_output*)pUserData;
+    float expected[1000 * MA_NODE_GRAPH_TEST_CHANNELS];
+
+    if (frameCount > 1000) {
+        pOutput->isMismatched = MA_TRUE;
+        return MA_ERROR;
+    }
+
+    ma_waveform_read_pcm_frames(&pOutput->waveform, expected, frameCount, NULL);
+    if (memcmp(pFrames, expected, (size_t)frameCount * MA_NODE_GRAPH_TEST_CHANNELS * sizeof(float)) != 0) {
+        pOutput->isMismatched = MA_TRUE;
+    }
+
+    pOutput->framesReceived += frameCount;
+
+    if (pOutput->abortAfterFrameCount > 0 && pOutput->framesReceived >= pOutput->abortAfterFrameCount) {
+        return MA_CANCELLED;
+    }
+
+    return MA_SUCCESS;
+}
+
+static ma_result test_node_graph__render_offline(ma_bool32 noPipelining)
+{
+    ma_result result = MA_SUCCESS;
+    ma_node_graph nodeGraph;
+    ma_node_graph_config nodeGraphConfig;
+    ma_waveform waveform;
+    ma_waveform_config waveformConfig;
+    ma_data_source_node sourceNode;
+    ma_data_source_node_config sourceNodeConfig;
+    ma_node_graph_test_offline_output output;
+    ma_offline_render_config renderConfig;
+    ma_offline_render_stats renderStats;
+
+    printf("    %s... ", (noPipelining) ? "without pipelining" : "with pipelining");
+
+    nodeGraphConfig = ma_node_graph_config_init(MA_NODE_GRAPH_TEST_CHANNELS);
+    nodeGraphConfig.nodeCacheCapInFrames = MA_NODE_GRAPH_TEST_FRAME_COUNT;
+
+    result = ma_node_graph_init(&nodeGraphConfig, NULL, &nodeGraph);
+    if (result != MA_SUCCESS) {
+        printf("FAILED (ma_node_graph_init)\n");
+        return result;
+    }
+
+    waveformConfig = ma_waveform_config_init(ma_format_f32, MA_NODE_GRAPH_TEST_CHANNELS, 48000, ma_waveform_type_sine, 0.5, 440);
+    ma_waveform_init(&waveformConfig, &waveform);
+    ma_waveform_init(&waveformConfig, &output.waveform);
+    output.framesReceived       = 0;
+    output.abortAfterFrameCount = 0;
+    output.isMismatched         = MA_FALSE;
+
+    sourceNodeConfig = ma_data_source_node_config_init(&waveform);
+    ma_data_source_node_init(&nodeGraph, &sourceNodeConfig, NULL, &sourceNode);
+    ma_node_attach_output_bus(&sourceNode, 0, ma_node_graph_get_endpoint(&nodeGraph), 0);
+
+    renderConfig = ma_offline_render_config_init(MA_NODE_GRAPH_TEST_OFFLINE_FRAME_COUNT);
+    renderConfig.sampleRate        = 48000;
+    renderConfig.blockSizeInFrames = 1000;
+    renderConfig.onOutput          = test_node_graph__offline_on_output;
+    renderConfig.pOutputUserData   = &output;
+    renderConfig.noPipelining      = noPipelining;
+
+    result = ma_node_graph_render_offline(&nodeGraph, &renderConfig, &renderStats);
+    if (result != MA_SUCCESS || output.isMismatched || output.framesReceived != MA_NODE_GRAPH_TEST_OFFLINE_FRAME_COUNT || renderStats.framesRendered != MA_NODE_GRAPH_TEST_OFFLINE_FRAME_COUNT) {
+        printf("FAILED (incorrect output)\n");
+        result = MA_ERROR;
+    }
+
+    /* An error from the output should stop rendering. The block that failed, and anything rendered after it, shouldn't be counted. */
+    if (result == MA_SUCCESS) {
+        output.framesReceived       = 0;
+        output.abortAfterFrameCount = 3000;
+        ma_waveform_seek_to_pcm_frame(&waveform, 0);
+        ma_waveform_seek_to_pcm_frame(&output.waveform, 0);
+
+        result = ma_node_graph_render_offline(&nodeGraph, &renderConfig, &renderStats);
+        if (result != MA_CANCELLED || output.isMismatched || output.framesReceived != 3000 || renderStats.framesRendered != 2000) {
+            printf("FAILED (rendering was not aborted)\n");
+            result = MA_ERROR;
+        } else {
+            result = MA_SUCCESS;
+        }
+    }
+
+    ma_data_source_node_uninit(&sourceNode, NULL);
+    ma_waveform_uninit(&output.waveform);
+    ma_waveform_uninit(&waveform);
+    ma_node_graph_uninit(&nodeGraph, NULL);
+
+    if (result == MA_SUCCESS) {
+        printf("PASSED\n");
+    }
+
+    return result;
+}
+
+int test_entry__node_graph(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+    ma_bool32 useSplitter;
+
+    (void)argc;
+    (void)argv;
+
+    printf("Multi-threaded processing\n");
+    for (useSplitter = 0; useSplitter <= 1; useSplitter += 1) {
+        if (test_node_graph__multi_threaded(1, 0, useSplitter) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+        if (test_node_graph__multi_threaded(3, 0, useSplitter) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+        if (test_node_graph__multi_threaded(3, 4, useSplitter) != MA_SUCCESS) {  /* Fewer jobs than attachments so processing is done over multiple rounds. */
+            hasError = MA_TRUE;
+        }
+        if (test_node_graph__multi_threaded(MA_NODE_GRAPH_MAX_JOB_THREAD_COUNT, 1, useSplitter) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    printf("Loops\n");
+    if (test_node_graph__loop(0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_node_graph__loop(3) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("Render plan\n");
+    if (test_node_graph__render_plan() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_node_graph__render_plan_swap() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /*
+    The render plan is only tested with 3 channels. With 8 channels the splitter is read in chunks
+    smaller than a block which makes it process more than once per block with or without planar
+    nodes, so there's no reference to compare against.
+    */
+    printf("Planar processing\n");
+    if (test_node_graph__planar(3, MA_FALSE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_node_graph__planar(3, MA_TRUE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_node_graph__planar(8, MA_FALSE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("Silence\n");
+    if (test_node_graph__silence(MA_FALSE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_node_graph__silence(MA_TRUE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_node_graph__silence_default_tails() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("Profiling\n");
+    if (test_node_graph__profiling() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("Offline rendering\n");
+    if (test_node_graph__render_offline(MA_FALSE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+    if (test_node_graph__render_offline(MA_TRUE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    } else {
+        return 0;
+    }
+}
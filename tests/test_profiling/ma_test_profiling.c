@@ -0,0 +1,527 @@
+/*
+Throughput benchmarks for the hot paths in the data conversion pipeline. Build with optimizations
+enabled or else the numbers are meaningless. Example:
+
+    gcc ../test_profiling/ma_test_profiling.c -o bin/test_profiling -ldl -lm -lpthread -O2 -mavx2
+    ./bin/test_profiling
+*/
+#define MINIAUDIO_IMPLEMENTATION
+#include "../../miniaudio.h"
+#include "../../extras/nodes/ma_convolution_node/ma_convolution_node.c"
+
+#include <stdio.h>
+
+#define PROFILING_FRAME_COUNT   48000
+#define PROFILING_ITERATIONS    50
+#define PROFILING_MAX_CHANNELS  8
+
+static float    g_profilingInputF32 [PROFILING_FRAME_COUNT * PROFILING_MAX_CHANNELS];
+static float    g_profilingOutputF32[PROFILING_FRAME_COUNT * PROFILING_MAX_CHANNELS * 2];
+static ma_int16 g_profilingInputS16 [PROFILING_FRAME_COUNT * PROFILING_MAX_CHANNELS];
+static ma_int16 g_profilingOutputS16[PROFILING_FRAME_COUNT * PROFILING_MAX_CHANNELS * 2];
+
+
+typedef ma_result (* profiling_linear_resampler_proc)(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut);
+
+static ma_result profiling_linear_resampler_process_per_frame(ma_linear_resampler* pResampler, const void* pFramesIn, ma_uint64* pFrameCountIn, void* pFramesOut, ma_uint64* pFrameCountOut)
+{
+    /* This is the original path which steps one frame at a time. */
+    if (pResampler->config.format == ma_format_s16) {
+        if (pResampler->config.sampleRateIn > pResampler->config.sampleRateOut) {
+            return ma_linear_resampler_process_pcm_frames_s16_downsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+        } else {
+            return ma_linear_resampler_process_pcm_frames_s16_upsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+        }
+    } else {
+        if (pResampler->config.sampleRateIn > pResampler->config.sampleRateOut) {
+            return ma_linear_resampler_process_pcm_frames_f32_downsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+        } else {
+            return ma_linear_resampler_process_pcm_frames_f32_upsample(pResampler, pFramesIn, pFrameCountIn, pFramesOut, pFrameCountOut);
+        }
+    }
+}
+
+static double profiling_linear_resampler_run(profiling_linear_resampler_proc onProcess, ma_format format, ma_uint32 channels, ma_uint32 rateIn, ma_uint32 rateOut, ma_uint32 lpfOrder)
+{
+    ma_linear_resampler_config config;
+    ma_linear_resampler resampler;
+    ma_timer timer;
+    double startTime;
+    ma_uint32 iIteration;
+
+    config = ma_linear_resampler_config_init(format, channels, rateIn, rateOut);
+    config.lpfOrder = lpfOrder;
+
+    if (ma_linear_resampler_init(&config, NULL, &resampler) != MA_SUCCESS) {
+        return 0;
+    }
+
+    ma_timer_init(&timer);
+    startTime = ma_timer_get_time_in_seconds(&timer);
+
+    for (iIteration = 0; iIteration < PROFILING_ITERATIONS; iIteration += 1) {
+        ma_uint64 frameCountIn  = PROFILING_FRAME_COUNT;
+        ma_uint64 frameCountOut = PROFILING_FRAME_COUNT * 2;
+
+        if (format == ma_format_s16) {
+            onProcess(&resampler, g_profilingInputS16, &frameCountIn, g_profilingOutputS16, &frameCountOut);
+        } else {
+            onProcess(&resampler, g_profilingInputF32, &frameCountIn, g_profilingOutputF32, &frameCountOut);
+        }
+    }
+
+    ma_linear_resampler_uninit(&resampler, NULL);
+
+    /* Input frames per second. */
+    return (PROFILING_FRAME_COUNT * (double)PROFILING_ITERATIONS) / (ma_timer_get_time_in_seconds(&timer) - startTime);
+}
+
+static void profiling_linear_resampler(void)
+{
+    ma_format formats[] = {ma_format_f32, ma_format_s16};
+    ma_uint32 channels[] = {1, 2, 8};
+    ma_uint32 rates[][3] = {{44100, 48000, 0}, {48000, 44100, 0}, {48000, 44100, 4}}; /* Rate in, rate out, filter order. */
+    ma_uint32 iFormat;
+    ma_uint32 iChannels;
+    ma_uint32 iRate;
+
+    printf("Linear resampler (input frames per second)\n");
+    printf("    %-6s %-8s %-14s %-6s %12s %12s %8s\n", "Format", "Channels", "Rates", "Filter", "Per-frame", "Batched", "Speedup");
+
+    for (iFormat = 0; iFormat < ma_countof(formats); iFormat += 1) {
+        for (iChannels = 0; iChannels < ma_countof(channels); iChannels += 1) {
+            for (iRate = 0; iRate < ma_countof(rates); iRate += 1) {
+                double perFrame = profiling_linear_resampler_run(profiling_linear_resampler_process_per_frame, formats[iFormat], channels[iChannels], rates[iRate][0], rates[iRate][1], rates[iRate][2]);
+                double batched  = profiling_linear_resampler_run(ma_linear_resampler_process_pcm_frames,      formats[iFormat], channels[iChannels], rates[iRate][0], rates[iRate][1], rates[iRate][2]);
+
+                printf("    %-6s %-8d %5d -> %-5d %-6d %11.1fM %11.1fM %7.2fx\n",
+                    (formats[iFormat] == ma_format_s16) ? "s16" : "f32", (int)channels[iChannels], (int)rates[iRate][0], (int)rates[iRate][1], (int)rates[iRate][2],
+                    perFrame / 1000000, batched / 1000000, (perFrame > 0) ? batched / perFrame : 0);
+            }
+        }
+    }
+}
+
+
+static double profiling_data_converter_run(ma_format formatIn, ma_format formatOut, ma_uint32 channelsIn, ma_uint32 channelsOut, ma_uint32 rateIn, ma_uint32 rateOut, ma_uint32 scratchBufferSizeInFrames)
+{
+    ma_data_converter_config config;
+    ma_data_converter converter;
+    ma_timer timer;
+    double startTime;
+    ma_uint32 iIteration;
+    const void* pInput = (formatIn == ma_format_s16) ? (const void*)g_profilingInputS16 : (const void*)g_profilingInputF32;
+
+    config = ma_data_converter_config_init(formatIn, formatOut, channelsIn, channelsOut, rateIn, rateOut);
+    config.scratchBufferSizeInFrames = scratchBufferSizeInFrames;
+
+    if (ma_data_converter_init(&config, NULL, &converter) != MA_SUCCESS) {
+        return 0;
+    }
+
+    ma_timer_init(&timer);
+    startTime = ma_timer_get_time_in_seconds(&timer);
+
+    for (iIteration = 0; iIteration < PROFILING_ITERATIONS; iIteration += 1) {
+        ma_uint64 frameCountIn  = PROFILING_FRAME_COUNT;
+        ma_uint64 frameCountOut = PROFILING_FRAME_COUNT * 2;
+
+        ma_data_converter_process_pcm_frames(&converter, pInput, &frameCountIn, g_profilingOutputF32, &frameCountOut);
+    }
+
+    ma_data_converter_uninit(&converter, NULL);
+
+    /* Input frames per second. */
+    return (PROFILING_FRAME_COUNT * (double)PROFILING_ITERATIONS) / (ma_timer_get_time_in_seconds(&timer) - startTime);
+}
+
+static void profiling_data_converter(void)
+{
+    /* Format in, format out, channels in, channels out, rate in, rate out. */
+    ma_uint32 configs[][6] = {
+        {ma_format_s16, ma_format_f32, 8, 2, 48000, 48000},
+        {ma_format_f32, ma_format_s16, 8, 8, 44100, 48000},
+        {ma_format_s16, ma_format_f32, 2, 8, 44100, 48000},
+        {ma_format_f32, ma_format_s16, 8, 2, 48000, 44100}
+    };
+    ma_uint32 iConfig;
+
+    printf("Data converter (input frames per second)\n");
+    printf("    %-10s %-8s %-14s %12s %12s %8s\n", "Format", "Channels", "Rates", "Stack", "Scratch", "Speedup");
+
+    for (iConfig = 0; iConfig < ma_countof(configs); iConfig += 1) {
+        double stack   = profiling_data_converter_run((ma_format)configs[iConfig][0], (ma_format)configs[iConfig][1], configs[iConfig][2], configs[iConfig][3], configs[iConfig][4], configs[iConfig][5], 0);
+        double scratch = profiling_data_converter_run((ma_format)configs[iConfig][0], (ma_format)configs[iConfig][1], configs[iConfig][2], configs[iConfig][3], configs[iConfig][4], configs[iConfig][5], 4096);
+
+        printf("    %-3s -> %-3s %d -> %-3d %5d -> %-5d %11.1fM %11.1fM %7.2fx\n",
+            (configs[iConfig][0] == ma_format_s16) ? "s16" : "f32", (configs[iConfig][1] == ma_format_s16) ? "s16" : "f32", (int)configs[iConfig][2], (int)configs[iConfig][3], (int)configs[iConfig][4], (int)configs[iConfig][5],
+            stack / 1000000, scratch / 1000000, (stack > 0) ? scratch / stack : 0);
+    }
+}
+
+
+static double profiling_data_converter_fused_run(ma_uint32 channelsIn, ma_uint32 channelsOut, ma_uint32 rateIn, ma_uint32 rateOut, ma_uint32 lpfOrder, ma_bool32 isFused)
+{
+    ma_data_converter_config config;
+    ma_data_converter converter;
+    ma_timer timer;
+    double startTime;
+    ma_uint32 iIteration;
+
+    config = ma_data_converter_config_init(ma_format_s16, ma_format_f32, channelsIn, channelsOut, rateIn, rateOut);
+    config.resampling.linear.lpfOrder = lpfOrder;
+
+    if (ma_data_converter_init(&config, NULL, &converter) != MA_SUCCESS) {
+        return 0;
+    }
+
+    /* This is what would be used without the fused path. */
+    if (!isFused) {
+        if (channelsIn < channelsOut) {
+            converter.executionPath = ma_data_converter_execution_path_resample_first;
+        } else {
+            converter.executionPath = ma_data_converter_execution_path_resample_only;
+        }
+    }
+
+    ma_timer_init(&timer);
+    startTime = ma_timer_get_time_in_seconds(&timer);
+
+    for (iIteration = 0; iIteration < PROFILING_ITERATIONS; iIteration += 1) {
+        ma_uint64 frameCountIn  = PROFILING_FRAME_COUNT;
+        ma_uint64 frameCountOut = PROFILING_FRAME_COUNT * 2;
+
+        ma_data_converter_process_pcm_frames(&converter, g_profilingInputS16, &frameCountIn, g_profilingOutputF32, &frameCountOut);
+    }
+
+    ma_data_converter_uninit(&converter, NULL);
+
+    /* Input frames per second. */
+    return (PROFILING_FRAME_COUNT * (double)PROFILING_ITERATIONS) / (ma_timer_get_time_in_seconds(&timer) - startTime);
+}
+
+static void profiling_data_converter_fused(void)
+{
+    ma_uint32 configs[][5] = {  /* Channels in, channels out, rate in, rate out, filter order. */
+        {2, 2, 44100, 48000, 0},
+        {2, 2, 44100, 48000, 1},
+        {1, 2, 44100, 48000, 0},
+        {1, 2, 44100, 48000, 1},
+        {2, 2, 48000, 44100, 4}
+    };
+    ma_uint32 iConfig;
+
+    printf("Fused s16 to f32 data conversion (input frames per second)\n");
+    printf("    %-8s %-14s %-6s %12s %12s %8s\n", "Channels", "Rates", "Filter", "Separate", "Fused", "Speedup");
+
+    for (iConfig = 0; iConfig < ma_countof(configs); iConfig += 1) {
+        double separate = profiling_data_converter_fused_run(configs[iConfig][0], configs[iConfig][1], configs[iConfig][2], configs[iConfig][3], configs[iConfig][4], MA_FALSE);
+        double fused    = profiling_data_converter_fused_run(configs[iConfig][0], configs[iConfig][1], configs[iConfig][2], configs[iConfig][3], configs[iConfig][4], MA_TRUE);
+
+        printf("    %d -> %-3d %5d -> %-5d %-6d %11.1fM %11.1fM %7.2fx\n",
+            (int)configs[iConfig][0], (int)configs[iConfig][1], (int)configs[iConfig][2], (int)configs[iConfig][3], (int)configs[iConfig][4],
+            separate / 1000000, fused / 1000000, (separate > 0) ? fused / separate : 0);
+    }
+}
+
+
+/* The scalar loops the channel converter used before it had a sparse weight list and SIMD paths. */
+static void profiling_channel_converter_reference_f32(const ma_channel_converter* pConverter, float* pFramesOut, const float* pFramesIn, ma_uint64 frameCount)
+{
+    ma_uint32 channelsIn  = pConverter->channelsIn;
+    ma_uint32 channelsOut = pConverter->channelsOut;
+    ma_uint64 iFrame;
+    ma_uint32 iChannelIn;
+    ma_uint32 iChannelOut;
+
+    if (pConverter->conversionPath == ma_channel_conversion_path_weights) {
+        MA_ZERO_MEMORY(pFramesOut, (size_t)(frameCount * channelsOut * sizeof(float)));
+    }
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        if (pConverter->conversionPath == ma_channel_conversion_path_mono_in) {
+            for (iChannelOut = 0; iChannelOut < channelsOut; iChannelOut += 1) {
+                pFramesOut[iFrame*channelsOut + iChannelOut] = pFramesIn[iFrame];
+            }
+        } else if (pConverter->conversionPath == ma_channel_conversion_path_mono_out) {
+            float t = 0;
+            for (iChannelIn = 0; iChannelIn < channelsIn; iChannelIn += 1) {
+                t += pFramesIn[iFrame*channelsIn + iChannelIn];
+            }
+            pFramesOut[iFrame] = t / channelsIn;
+        } else if (pConverter->conversionPath == ma_channel_conversion_path_shuffle) {
+            for (iChannelOut = 0; iChannelOut < channelsOut; iChannelOut += 1) {
+                ma_uint8 iShuffle = pConverter->pShuffleTable[iChannelOut];
+                pFramesOut[iFrame*channelsOut + iChannelOut] = (iShuffle < channelsIn) ? pFramesIn[iFrame*channelsIn + iShuffle] : 0;
+            }
+        } else {
+            for (iChannelIn = 0; iChannelIn < channelsIn; iChannelIn += 1) {
+                for (iChannelOut = 0; iChannelOut < channelsOut; iChannelOut += 1) {
+                    pFramesOut[iFrame*channelsOut + iChannelOut] += pFramesIn[iFrame*channelsIn + iChannelIn] * pConverter->weights.f32[iChannelIn][iChannelOut];
+                }
+            }
+        }
+    }
+}
+
+static double profiling_channel_converter_run(ma_uint32 channelsIn, const ma_channel* pChannelMapIn, ma_uint32 channelsOut, const ma_channel* pChannelMapOut, ma_bool32 isReference)
+{
+    ma_channel_converter_config config;
+    ma_channel_converter converter;
+    ma_timer timer;
+    double startTime;
+    ma_uint32 iIteration;
+
+    config = ma_channel_converter_config_init(ma_format_f32, channelsIn, pChannelMapIn, channelsOut, pChannelMapOut, ma_channel_mix_mode_default);
+    if (ma_channel_converter_init(&config, NULL, &converter) != MA_SUCCESS) {
+        return 0;
+    }
+
+    ma_timer_init(&timer);
+    startTime = ma_timer_get_time_in_seconds(&timer);
+
+    for (iIteration = 0; iIteration < PROFILING_ITERATIONS; iIteration += 1) {
+        if (isReference) {
+            profiling_channel_converter_reference_f32(&converter, g_profilingOutputF32, g_profilingInputF32, PROFILING_FRAME_COUNT);
+        } else {
+            ma_channel_converter_process_pcm_frames(&converter, g_profilingOutputF32, g_profilingInputF32, PROFILING_FRAME_COUNT);
+        }
+    }
+
+    ma_channel_converter_uninit(&converter, NULL);
+
+    return (PROFILING_FRAME_COUNT * (double)PROFILING_ITERATIONS) / (ma_timer_get_time_in_seconds(&timer) - startTime);
+}
+
+static void profiling_channel_converter(void)
+{
+    static const ma_channel mapFC[1]    = {MA_CHANNEL_FRONT_CENTER};
+    static const ma_channel mapSwap[2]  = {MA_CHANNEL_FRONT_RIGHT, MA_CHANNEL_FRONT_LEFT};
+    static const ma_channel map71In[8]  = {MA_CHANNEL_FRONT_LEFT, MA_CHANNEL_FRONT_RIGHT, MA_CHANNEL_FRONT_CENTER, MA_CHANNEL_LFE, MA_CHANNEL_BACK_LEFT, MA_CHANNEL_BACK_RIGHT, MA_CHANNEL_SIDE_LEFT, MA_CHANNEL_SIDE_RIGHT};
+    static const ma_channel map71Out[8] = {MA_CHANNEL_SIDE_RIGHT, MA_CHANNEL_SIDE_LEFT, MA_CHANNEL_BACK_RIGHT, MA_CHANNEL_BACK_LEFT, MA_CHANNEL_LFE, MA_CHANNEL_FRONT_CENTER, MA_CHANNEL_FRONT_RIGHT, MA_CHANNEL_FRONT_LEFT};
+    struct
+    {
+        const char* pName;
+        ma_uint32 channelsIn;
+        const ma_channel* pChannelMapIn;
+        ma_uint32 channelsOut;
+        const ma_channel* pChannelMapOut;
+    } configs[] = {
+        {"7.1 -> stereo",    8, NULL,    2, NULL},
+        {"5.1 -> stereo",    6, NULL,    2, NULL},
+        {"center -> 5.1",    1, mapFC,   6, NULL},
+        {"stereo -> 7.1",    2, NULL,    8, NULL},
+        {"mono -> stereo",   1, NULL,    2, NULL},
+        {"mono -> 7.1",      1, NULL,    8, NULL},
+        {"stereo -> mono",   2, NULL,    1, NULL},
+        {"stereo swap",      2, NULL,    2, mapSwap},
+        {"7.1 reorder",      8, map71In, 8, map71Out}
+    };
+    ma_uint32 iConfig;
+
+    printf("f32 channel conversion (frames per second)\n");
+    printf("    %-16s %12s %12s %8s\n", "Layout", "Reference", "Converter", "Speedup");
+
+    for (iConfig = 0; iConfig < ma_countof(configs); iConfig += 1) {
+        double reference = profiling_channel_converter_run(configs[iConfig].channelsIn, configs[iConfig].pChannelMapIn, configs[iConfig].channelsOut, configs[iConfig].pChannelMapOut, MA_TRUE);
+        double converter = profiling_channel_converter_run(configs[iConfig].channelsIn, configs[iConfig].pChannelMapIn, configs[iConfig].channelsOut, configs[iConfig].pChannelMapOut, MA_FALSE);
+
+        printf("    %-16s %11.1fM %11.1fM %7.2fx\n", configs[iConfig].pName, reference / 1000000, converter / 1000000, (reference > 0) ? converter / reference : 0);
+    }
+}
+
+
+static double profiling_interleave_run(ma_format formatOut, ma_format formatIn, ma_uint32 channels, ma_bool32 isDeinterleave, ma_bool32 isSeparate)
+{
+    void* ppPlanar[PROFILING_MAX_CHANNELS];
+    ma_timer timer;
+    double startTime;
+    ma_uint32 iIteration;
+    ma_uint32 iChannel;
+    void* pInterleaved = isDeinterleave ? (void*)g_profilingInputF32 : (void*)g_profilingOutputF32;
+
+    /* The planar side uses whichever buffer the interleaved side isn't using. The temp buffer for the separate path is at the end of the output buffer. */
+    for (iChannel = 0; iChannel < channels; iChannel += 1) {
+        if (isDeinterleave) {
+            ppPlanar[iChannel] = g_profilingOutputF32 + (iChannel * PROFILING_FRAME_COUNT);
+        } else {
+            ppPlanar[iChannel] = g_profilingInputF32  + (iChannel * PROFILING_FRAME_COUNT);
+        }
+    }
+
+    ma_timer_init(&timer);
+    startTime = ma_timer_get_time_in_seconds(&timer);
+
+    for (iIteration = 0; iIteration < PROFILING_ITERATIONS; iIteration += 1) {
+        if (isSeparate) {
+            /* What would be done without the fused path: a scalar transpose plus a separate conversion pass. */
+            void* pTemp = g_profilingOutputF32 + (PROFILING_FRAME_COUNT * PROFILING_MAX_CHANNELS);
+
+            if (isDeinterleave) {
+                ma_pcm_convert(pTemp, formatOut, pInterleaved, formatIn, PROFILING_FRAME_COUNT * channels, ma_dither_mode_none);
+                ma_deinterleave_pcm_frames__scalar(formatOut, channels, 0, PROFILING_FRAME_COUNT, pTemp, ppPlanar);
+            } else {
+                ma_interleave_pcm_frames__scalar(formatIn, channels, 0, PROFILING_FRAME_COUNT, (const void**)ppPlanar, pTemp);
+                ma_pcm_convert(pInterleaved, formatOut, pTemp, formatIn, PROFILING_FRAME_COUNT * channels, ma_dither_mode_none);
+            }
+        } else {
+            if (isDeinterleave) {
+                ma_deinterleave_pcm_frames_ex(formatOut, formatIn, channels, PROFILING_FRAME_COUNT, pInterleaved, ppPlanar, ma_dither_mode_none);
+            } else {
+                ma_interleave_pcm_frames_ex(formatOut, formatIn, channels, PROFILING_FRAME_COUNT, (const void**)ppPlanar, pInterleaved, ma_dither_mode_none);
+            }
+        }
+    }
+
+    return (PROFILING_FRAME_COUNT * (double)PROFILING_ITERATIONS) / (ma_timer_get_time_in_seconds(&timer) - startTime);
+}
+
+static void profiling_interleave(void)
+{
+    ma_format formats[][2] = {  /* In, out. */
+        {ma_format_f32, ma_format_f32},
+        {ma_format_f32, ma_format_s16},
+        {ma_format_s16, ma_format_f32}
+    };
+    ma_uint32 channelCounts[] = {2, 4, 6, 8};
+    ma_uint32 iFormat;
+    ma_uint32 iChannelCount;
+    ma_uint32 iDirection;
+
+    printf("Interleaving with format conversion (frames per second)\n");
+    printf("    %-12s %-10s %-8s %12s %12s %8s\n", "Direction", "Formats", "Channels", "Separate", "Fused", "Speedup");
+
+    for (iDirection = 0; iDirection < 2; iDirection += 1) {
+        for (iFormat = 0; iFormat < ma_countof(formats); iFormat += 1) {
+            for (iChannelCount = 0; iChannelCount < ma_countof(channelCounts); iChannelCount += 1) {
+                double separate = profiling_interleave_run(formats[iFormat][1], formats[iFormat][0], channelCounts[iChannelCount], iDirection == 1, MA_TRUE);
+                double fused    = profiling_interleave_run(formats[iFormat][1], formats[iFormat][0], channelCounts[iChannelCount], iDirection == 1, MA_FALSE);
+
+                printf("    %-12s %-3s -> %-3s %-8d %11.1fM %11.1fM %7.2fx\n", (iDirection == 1) ? "deinterleave" : "interleave",
+                    (formats[iFormat][0] == ma_format_f32) ? "f32" : "s16", (formats[iFormat][1] == ma_format_f32) ? "f32" : "s16", (int)channelCounts[iChannelCount],
+                    separate / 1000000, fused / 1000000, (separate > 0) ? fused / separate : 0);
+            }
+        }
+    }
+}
+
+
+static void profiling_convolution_direct(const float* pImpulseResponse, ma_uint32 impulseResponseLength, const float* pFramesIn, float* pFramesOut, ma_uint32 frameCount)
+{
+    /* pFramesIn needs to have impulseResponseLength-1 frames of history before it. */
+    ma_uint32 iFrame;
+    ma_uint32 iTap;
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        float sum = 0;
+
+        for (iTap = 0; iTap < impulseResponseLength; iTap += 1) {
+            sum += pImpulseResponse[iTap] * pFramesIn[(ma_int32)iFrame - (ma_int32)iTap];
+        }
+
+        pFramesOut[iFrame] = sum;
+    }
+}
+
+static void profiling_convolution(void)
+{
+    static float impulseResponse[96000];
+    ma_uint32 lengths[] = {1024, 16384, 96000};
+    ma_uint32 blockSizes[] = {128, 256, 1024};
+    float* pDirectOutput = g_profilingOutputF32;
+    float* pFFTOutput    = g_profilingOutputF32 + PROFILING_FRAME_COUNT;
+    ma_uint32 iLength;
+    ma_uint32 iBlockSize;
+    ma_uint32 iTap;
+    ma_lcg lcg;
+
+    /* Decaying noise, which is roughly what a room sounds like. */
+    ma_lcg_seed(&lcg, 4321);
+    for (iTap = 0; iTap < ma_countof(impulseResponse); iTap += 1) {
+        impulseResponse[iTap] = ma_lcg_rand_f32(&lcg) * (float)ma_expd(-6.9 * iTap / ma_countof(impulseResponse));
+    }
+
+    printf("Convolution (mono, input frames per second)\n");
+    printf("    %-8s %-6s %12s %12s %8s %10s\n", "Length", "Block", "Direct", "FFT", "Speedup", "Max error");
+
+    for (iLength = 0; iLength < ma_countof(lengths); iLength += 1) {
+        ma_uint32 length = lengths[iLength];
+        ma_timer timer;
+        double startTime;
+        double direct;
+
+        /* The direct form is slow so it's only run once. It starts far enough in for every tap to be used. */
+        ma_timer_init(&timer);
+        startTime = ma_timer_get_time_in_seconds(&timer);
+        profiling_convolution_direct(impulseResponse, length, g_profilingInputF32 + length, pDirectOutput, PROFILING_FRAME_COUNT);
+        direct = PROFILING_FRAME_COUNT / (ma_timer_get_time_in_seconds(&timer) - startTime);
+
+        for (iBlockSize = 0; iBlockSize < ma_countof(blockSizes); iBlockSize += 1) {
+            ma_convolver_config config;
+            ma_convolver convolver;
+            ma_uint32 latency;
+            ma_uint32 iIteration;
+            ma_uint32 iFrame;
+            ma_uint32 frameCount;
+            double fft;
+            float maxError = 0;
+
+            config = ma_convolver_config_init(1, impulseResponse, length, 1);
+            config.blockSizeInFrames = blockSizes[iBlockSize];
+
+            if (ma_convolver_init(&config, NULL, &convolver) != MA_SUCCESS) {
+                continue;
+            }
+
+            latency = ma_convolver_get_latency(&convolver);
+
+            /* Check against the direct form first. The FFT output is delayed by the latency. */
+            frameCount = length + PROFILING_FRAME_COUNT + latency;
+            for (iFrame = 0; iFrame < frameCount; iFrame += 480) {
+                ma_convolver_process_pcm_frames(&convolver, pFFTOutput + iFrame, g_profilingInputF32 + iFrame, ma_min(480, frameCount - iFrame));
+            }
+
+            for (iFrame = 0; iFrame < PROFILING_FRAME_COUNT; iFrame += 1) {
+                maxError = ma_max(maxError, (float)ma_abs(pFFTOutput[length + latency + iFrame] - pDirectOutput[iFrame]));
+            }
+
+            /* Processed in chunks the size of a node graph's cache like it would be in practice. */
+            ma_timer_init(&timer);
+            startTime = ma_timer_get_time_in_seconds(&timer);
+
+            for (iIteration = 0; iIteration < PROFILING_ITERATIONS; iIteration += 1) {
+                for (iFrame = 0; iFrame < PROFILING_FRAME_COUNT; iFrame += 480) {
+                    ma_convolver_process_pcm_frames(&convolver, pFFTOutput + iFrame, g_profilingInputF32 + iFrame, ma_min(480, PROFILING_FRAME_COUNT - iFrame));
+                }
+            }
+
+            fft = (PROFILING_FRAME_COUNT * (double)PROFILING_ITERATIONS) / (ma_timer_get_time_in_seconds(&timer) - startTime);
+
+            ma_convolver_uninit(&convolver, NULL);
+
+            printf("    %-8d %-6d %11.2fM %11.2fM %7.1fx %10.2e\n", (int)length, (int)blockSizes[iBlockSize], direct / 1000000, fft / 1000000, (direct > 0) ? fft / direct : 0, maxError);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ma_uint32 iSample;
+
+    (void)argc;
+    (void)argv;
+
+    for (iSample = 0; iSample < ma_countof(g_profilingInputF32); iSample += 1) {
+        g_profilingInputF32[iSample] = (float)ma_sind(iSample * 0.01) * 0.5f;
+        g_profilingInputS16[iSample] = (ma_int16)(g_profilingInputF32[iSample] * 32767);
+    }
+
+    profiling_linear_resampler();
+    profiling_data_converter();
+    profiling_data_converter_fused();
+    profiling_channel_converter();
+    profiling_interleave();
+    profiling_convolution();
+
+    return 0;
+}
@@ -4,6 +4,7 @@ USAGE: audioconverter [input file] [output file] [format] [channels] [rate]
 EXAMPLES:
     audioconverter my_file.flac my_file.wav
     audioconverter my_file.flac my_file.wav f32 44100 linear --linear-order 8
+    audioconverter my_file.flac my_file.wav f32 48000 polyphase --polyphase-quality best
 */
 #define _CRT_SECURE_NO_WARNINGS /* For stb_vorbis' usage of fopen() instead of fopen_s(). */
 
@@ -31,6 +32,7 @@ void print_usage()
     printf("\n");
     printf("PARAMETERS:\n");
     printf("  --linear-order [0..%d]\n", MA_MAX_FILTER_ORDER);
+    printf("  --polyphase-quality [low|medium|high|best]\n");
 }
 
 ma_result do_conversion(ma_decoder* pDecoder, ma_encoder* pEncoder)
@@ -145,6 +147,8 @@ ma_bool32 try_parse_resample_algorithm(const char* str, ma_resample_algorithm* p
 
     /*  */ if (strcmp(str, "linear") == 0) {
         algorithm = ma_resample_algorithm_linear;
+    } else if (strcmp(str, "polyphase") == 0) {
+        algorithm = ma_resample_algorithm_polyphase;
     } else {
         return MA_FALSE;    /* Not a valid algorithm */
     }
@@ -156,6 +160,29 @@ ma_bool32 try_parse_resample_algorithm(const char* str, ma_resample_algorithm* p
     return MA_TRUE;
 }
 
+ma_bool32 try_parse_polyphase_quality(const char* str, ma_polyphase_resampler_quality* pValue)
+{
+    ma_polyphase_resampler_quality quality;
+
+    /*  */ if (strcmp(str, "low") == 0) {
+        quality = ma_polyphase_resampler_quality_low;
+    } else if (strcmp(str, "medium") == 0) {
+        quality = ma_polyphase_resampler_quality_medium;
+    } else if (strcmp(str, "high") == 0) {
+        quality = ma_polyphase_resampler_quality_high;
+    } else if (strcmp(str, "best") == 0) {
+        quality = ma_polyphase_resampler_quality_best;
+    } else {
+        return MA_FALSE;    /* Not a valid quality. */
+    }
+
+    if (pValue != NULL) {
+        *pValue = quality;
+    }
+
+    return MA_TRUE;
+}
+
 int main(int argc, char** argv)
 {
     ma_result result;
@@ -169,6 +196,7 @@ int main(int argc, char** argv)
     ma_uint32 rate = 0;
     ma_resample_algorithm resampleAlgorithm;
     ma_uint32 linearOrder = 8;
+    ma_polyphase_resampler_quality polyphaseQuality = ma_polyphase_resampler_quality_best;
     int iarg;
     const char* pOutputFilePath;
 
@@ -208,6 +236,20 @@ int main(int argc, char** argv)
             continue;
         }
 
+        if (strcmp(argv[iarg], "--polyphase-quality") == 0) {
+            iarg += 1;
+            if (iarg >= argc) {
+                break;
+            }
+
+            if (!try_parse_polyphase_quality(argv[iarg], &polyphaseQuality)) {
+                printf("Expecting low, medium, high or best for --polyphase-quality.\n");
+                return -1;
+            }
+
+            continue;
+        }
+
         if (try_parse_resample_algorithm(argv[iarg], &resampleAlgorithm)) {
             continue;
         }
@@ -232,6 +274,7 @@ int main(int argc, char** argv)
     decoderConfig = ma_decoder_config_init(format, channels, rate);
     decoderConfig.resampling.algorithm = resampleAlgorithm;
     decoderConfig.resampling.linear.lpfOrder = linearOrder;
+    decoderConfig.resampling.polyphase.quality = polyphaseQuality;
 
     result = ma_decoder_init_file(argv[1], &decoderConfig, &decoder);
     if (result != MA_SUCCESS) {